@@ -48,6 +48,11 @@
 * 2.5 hk      08/16/19   Add a memory barrier before DMASEV as per specification.
 * 2.6 hk      02/14/20   Correct boundary check for Channel.
 * 2.7 aj      12/07/23   Fixed changes to support system device tree flow
+* 2.8 pt      10/19/26   Skip cache maintenance for DMA pool buffers.
+*                        Issue a dsb before a channel is started.
+* 2.10 pt     10/19/26   Added scatter-gather lists and 2D strided blocks,
+*                        XDmaPs_SgCompile() and XDmaPs_SgStart().
+*       pt    10/19/26   Added XDmaPs_GenFillProg() for fill transfers.
 *
 * </pre>
 *
@@ -61,9 +66,17 @@
 #include "xdmaps.h"
 #include "xil_io.h"
 #include "xil_cache.h"
+#include "xpseudo_asm.h"
 
 #include "xil_printf.h"
 
+#if defined (PLATFORM_ZYNQ) && !defined (__aarch64__)
+#include "xil_dmapool.h"
+#define XDMAPS_BUF_IS_COHERENT(Addr)	Xil_DmaPoolIsCoherent((UINTPTR)(Addr))
+#else
+#define XDMAPS_BUF_IS_COHERENT(Addr)	0U
+#endif
+
 
 /************************** Constant Definitions ****************************/
 
@@ -91,6 +104,13 @@ static void XDmaPs_DoneISR_n(XDmaPs *InstPtr, unsigned Channel);
 static void *XDmaPs_BufPool_Allocate(XDmaPs_ProgBuf *Pool);
 static int XDmaPs_BuildDmaProg(unsigned Channel, XDmaPs_Cmd *Cmd,
 			       unsigned CacheLength);
+static int XDmaPs_BuildBdProg(unsigned Channel, XDmaPs_ChanCtrl *ChanCtrlIn,
+			      XDmaPs_BD *Bd, char *DmaProgStart,
+			      char *DmaProgBuf, unsigned CacheLength);
+static int XDmaPs_Build2DProg(XDmaPs_ChanCtrl *ChanCtrlIn, XDmaPs_SgBd *Bd,
+			      char *DmaProgBuf, char *DmaProgEnd);
+static u16 XDmaPs_SgAlign(XDmaPs_ChanCtrl *ChanCtrl, XDmaPs_SgBd *Bd);
+static int XDmaPs_BuildFillProg(unsigned Channel, XDmaPs_Cmd *Cmd);
 
 static void XDmaPs_Print_DmaProgBuf(char *Buf, int Length);
 
@@ -721,6 +741,44 @@ static INLINE int XDmaPs_Instr_DMAST(char *DmaProg)
 	return 1;
 }
 
+/*
+ * Register number for the DMAADDH instruction
+ */
+#define XDMAPS_ADDH_SAR 0x0
+#define XDMAPS_ADDH_DAR 0x1
+
+/****************************************************************************/
+/**
+*
+* Construction function for DMAADDH instruction. This function fills the
+* program buffer with the constructed instruction.
+*
+* @param	DmaProg is the DMA program buffer, it's the starting address
+*		for the instruction being constructed
+* @param	Ra is the register id, 0 for SAR and 1 for DAR
+* @param	Imm is the 16-bit unsigned number added to the register
+*
+* @return 	The number of bytes for this instruction which is 3.
+*
+* @note		None.
+*
+*****************************************************************************/
+static INLINE int XDmaPs_Instr_DMAADDH(char *DmaProg, unsigned Ra, u16 Imm)
+{
+	/*
+	 * DMAADDH encoding
+	 * 23 ... 8 7 6 5 4 3 2 1  0
+	 * imm[15:0] 0 1 0 1 0 1 ra 0
+	 *
+	 * ra: b0 for SAR, b1 for DAR
+	 */
+	*DmaProg = (u8)(0x54 | ((Ra & 1) << 1));
+	*(DmaProg + 1) = (u8)(Imm & 0xFF);
+	*(DmaProg + 2) = (u8)(Imm >> 8);
+
+	return 3;
+}
+
 
 /****************************************************************************/
 /**
@@ -1088,20 +1146,66 @@ int XDmaPs_ConstructNestedLoop(char *DmaProgStart,
 *****************************************************************************/
 static int XDmaPs_BuildDmaProg(unsigned Channel, XDmaPs_Cmd *Cmd,
 			       unsigned CacheLength)
+{
+	char *DmaProgBuf = (char *)Cmd->GeneratedDmaProg;
+	char *DmaProgStart = DmaProgBuf;
+	int DmaProgBytes;
+
+	DmaProgBytes = XDmaPs_BuildBdProg(Channel, &Cmd->ChanCtrl, &Cmd->BD,
+					  DmaProgStart, DmaProgBuf,
+					  CacheLength);
+	if (DmaProgBytes <= 0) {
+		return 0;
+	}
+	DmaProgBuf += DmaProgBytes;
+
+	/* Add a memory barrier before DMASSEV as recommended by spec */
+	DmaProgBuf += XDmaPs_Instr_DMAWMB(DmaProgBuf);
+	DmaProgBuf += XDmaPs_Instr_DMASEV(DmaProgBuf, Channel);
+	DmaProgBuf += XDmaPs_Instr_DMAEND(DmaProgBuf);
+
+	DmaProgBytes = DmaProgBuf - DmaProgStart;
+
+	Xil_DCacheFlushRange((u32)DmaProgStart, DmaProgBytes);
+
+	return DmaProgBytes;
+
+}
+
+/****************************************************************************/
+/**
+*
+* Construct the part of a DMA program that transfers one block, without the
+* DMASEV and DMAEND. The program starts with the DMAMOV of SAR and DAR.
+*
+* @param	Channel DMA channel number
+* @param	ChanCtrlIn is the channel control of the transfer.
+* @param	Bd is the block descriptor.
+* @param	DmaProgStart is the very start address of the DMA program.
+* @param	DmaProgBuf is where the block program is constructed.
+* @param	CacheLength is the icache line length, in terms of bytes.
+*		If it's zero, the performance enhancement feature will be
+*		turned off.
+*
+* @returns	The number of bytes for the block program, 0 on error.
+*
+* @note		None.
+*
+*****************************************************************************/
+static int XDmaPs_BuildBdProg(unsigned Channel, XDmaPs_ChanCtrl *ChanCtrlIn,
+			      XDmaPs_BD *Bd, char *DmaProgStart,
+			      char *DmaProgBuf, unsigned CacheLength)
 {
 	/*
 	 * unpack arguments
 	 */
-	char *DmaProgBuf = (char *)Cmd->GeneratedDmaProg;
-	unsigned DevChan = Channel;
-	unsigned long DmaLength = Cmd->BD.Length;
-	u32 SrcAddr = Cmd->BD.SrcAddr;
+	char *DmaProgBdStart = DmaProgBuf;
+	unsigned long DmaLength = Bd->Length;
+	u32 SrcAddr = Bd->SrcAddr;
 
-	unsigned SrcInc = Cmd->ChanCtrl.SrcInc;
-	u32 DstAddr = Cmd->BD.DstAddr;
-	unsigned DstInc = Cmd->ChanCtrl.DstInc;
-
-	char *DmaProgStart = DmaProgBuf;
+	unsigned SrcInc = ChanCtrlIn->SrcInc;
+	u32 DstAddr = Bd->DstAddr;
+	unsigned DstInc = ChanCtrlIn->DstInc;
 
 	unsigned int BurstBytes;
 	unsigned int LoopCount;
@@ -1109,7 +1213,6 @@ static int XDmaPs_BuildDmaProg(unsigned Channel, XDmaPs_Cmd *Cmd,
 	unsigned int LoopResidue = 0;
 	unsigned int TailBytes;
 	unsigned int TailWords;
-	int DmaProgBytes;
 	u32 CCRValue;
 	unsigned int Unaligned;
 	unsigned int UnalignedCount;
@@ -1135,7 +1238,7 @@ static int XDmaPs_BuildDmaProg(unsigned Channel, XDmaPs_Cmd *Cmd,
 	Mem2MemByteCC.SrcBurstSize = 1;
 	Mem2MemByteCC.SrcInc = 1;
 
-	ChanCtrl = &Cmd->ChanCtrl;
+	ChanCtrl = ChanCtrlIn;
 
 	/* insert DMAMOV for SAR and DAR */
 	DmaProgBuf += XDmaPs_Instr_DMAMOV(DmaProgBuf,
@@ -1173,6 +1276,9 @@ static int XDmaPs_BuildDmaProg(unsigned Channel, XDmaPs_Cmd *Cmd,
 	if (Unaligned) {
 		/* if head is unaligned, transfer head in bytes */
 		UnalignedCount = MemBurstSize - Unaligned;
+		if (UnalignedCount > DmaLength) {
+			UnalignedCount = DmaLength;
+		}
 		CCRValue = XDMAPS_CCR_SINGLE_BYTE
 			   | (SrcInc & 1)
 			   | ((DstInc & 1) << 14);
@@ -1304,9 +1410,126 @@ static int XDmaPs_BuildDmaProg(unsigned Channel, XDmaPs_Cmd *Cmd,
 		}
 	}
 
+	return DmaProgBuf - DmaProgBdStart;
+}
+
+
+/****************************************************************************/
+/**
+*
+* Construct the DMA program of a fill transfer. The source is a pattern of
+* one burst, SrcBurstSize * SrcBurstLen bytes, which is read again for every
+* burst written to the destination. A tail shorter than a burst is written
+* with the start of the pattern.
+*
+* @param	Channel DMA channel number
+* @param	Cmd is the DMA command.
+*
+* @returns	The number of bytes for the program, 0 on error.
+*
+* @note		None.
+*
+*****************************************************************************/
+static int XDmaPs_BuildFillProg(unsigned Channel, XDmaPs_Cmd *Cmd)
+{
+	char *DmaProgBuf = (char *)Cmd->GeneratedDmaProg;
+	char *DmaProgStart = DmaProgBuf;
+	char *OuterLoopStart;
+	char *InnerLoopStart;
+	XDmaPs_ChanCtrl *ChanCtrl = &Cmd->ChanCtrl;
+	XDmaPs_ChanCtrl WordChanCtrl;
+	u32 PatternAddr = Cmd->BD.SrcAddr;
+	unsigned int BurstBytes;
+	unsigned int LoopCount;
+	unsigned int LoopCount1;
+	unsigned int TailBytes;
+	unsigned int TailWords;
+	int DmaProgBytes;
+
+	BurstBytes = ChanCtrl->SrcBurstSize * ChanCtrl->SrcBurstLen;
+	LoopCount = Cmd->BD.Length / BurstBytes;
+	TailBytes = Cmd->BD.Length % BurstBytes;
+
+	DmaProgBuf += XDmaPs_Instr_DMAMOV(DmaProgBuf, XDMAPS_MOV_DAR,
+					  Cmd->BD.DstAddr);
+	DmaProgBuf += XDmaPs_Instr_DMAMOV(DmaProgBuf, XDMAPS_MOV_CCR,
+					  XDmaPs_ToCCRValue(ChanCtrl));
+
+	/*
+	 * each burst reloads SAR with the pattern, nested loops as in
+	 * XDmaPs_BuildBdProg() for more than 256 bursts
+	 */
+	if (LoopCount > 256) {
+		LoopCount1 = LoopCount / 256;
+		if (LoopCount1 > 256) {
+			return 0;
+		}
+
+		DmaProgBuf += XDmaPs_Instr_DMALP(DmaProgBuf, 1, LoopCount1);
+		OuterLoopStart = DmaProgBuf;
+		DmaProgBuf += XDmaPs_Instr_DMALP(DmaProgBuf, 0, 256);
+		InnerLoopStart = DmaProgBuf;
+		DmaProgBuf += XDmaPs_Instr_DMAMOV(DmaProgBuf, XDMAPS_MOV_SAR,
+						  PatternAddr);
+		DmaProgBuf += XDmaPs_Instr_DMALD(DmaProgBuf);
+		DmaProgBuf += XDmaPs_Instr_DMAST(DmaProgBuf);
+		DmaProgBuf += XDmaPs_Instr_DMALPEND(DmaProgBuf,
+						    InnerLoopStart, 0);
+		DmaProgBuf += XDmaPs_Instr_DMALPEND(DmaProgBuf,
+						    OuterLoopStart, 1);
+
+		LoopCount = LoopCount % 256;
+	}
+
+	if (LoopCount > 0) {
+		DmaProgBuf += XDmaPs_Instr_DMALP(DmaProgBuf, 0, LoopCount);
+		InnerLoopStart = DmaProgBuf;
+		DmaProgBuf += XDmaPs_Instr_DMAMOV(DmaProgBuf, XDMAPS_MOV_SAR,
+						  PatternAddr);
+		DmaProgBuf += XDmaPs_Instr_DMALD(DmaProgBuf);
+		DmaProgBuf += XDmaPs_Instr_DMAST(DmaProgBuf);
+		DmaProgBuf += XDmaPs_Instr_DMALPEND(DmaProgBuf,
+						    InnerLoopStart, 0);
+	}
+
+	if (TailBytes) {
+		TailWords = TailBytes / ChanCtrl->DstBurstSize;
+		TailBytes = TailBytes % ChanCtrl->DstBurstSize;
+
+		DmaProgBuf += XDmaPs_Instr_DMAMOV(DmaProgBuf, XDMAPS_MOV_SAR,
+						  PatternAddr);
+
+		if (TailWords) {
+			WordChanCtrl = *ChanCtrl;
+			WordChanCtrl.SrcBurstSize = ChanCtrl->DstBurstSize;
+			WordChanCtrl.SrcBurstLen = 1;
+			WordChanCtrl.DstBurstLen = 1;
+
+			DmaProgBuf +=
+				XDmaPs_Instr_DMAMOV(DmaProgBuf,
+						    XDMAPS_MOV_CCR,
+						    XDmaPs_ToCCRValue(&WordChanCtrl));
+			DmaProgBuf += XDmaPs_ConstructSingleLoop(DmaProgStart,
+								 0,
+								 DmaProgBuf,
+								 TailWords);
+		}
+
+		if (TailBytes) {
+			DmaProgBuf +=
+				XDmaPs_Instr_DMAMOV(DmaProgBuf,
+						    XDMAPS_MOV_CCR,
+						    XDMAPS_CCR_M2M_SINGLE_BYTE);
+			DmaProgBuf += XDmaPs_ConstructSingleLoop(DmaProgStart,
+								 0,
+								 DmaProgBuf,
+								 TailBytes);
+		}
+	}
+
 	/* Add a memory barrier before DMASSEV as recommended by spec */
 	DmaProgBuf += XDmaPs_Instr_DMAWMB(DmaProgBuf);
-	DmaProgBuf += XDmaPs_Instr_DMASEV(DmaProgBuf, DevChan);
+	DmaProgBuf += XDmaPs_Instr_DMASEV(DmaProgBuf, Channel);
 	DmaProgBuf += XDmaPs_Instr_DMAEND(DmaProgBuf);
 
 	DmaProgBytes = DmaProgBuf - DmaProgStart;
@@ -1314,10 +1537,8 @@ static int XDmaPs_BuildDmaProg(unsigned Channel, XDmaPs_Cmd *Cmd,
 	Xil_DCacheFlushRange((u32)DmaProgStart, DmaProgBytes);
 
 	return DmaProgBytes;
-
 }
 
-
 /****************************************************************************/
 /**
 *
@@ -1396,6 +1617,76 @@ int XDmaPs_GenDmaProg(XDmaPs *InstPtr, unsigned int Channel, XDmaPs_Cmd *Cmd)
 }
 
 
+/****************************************************************************/
+/**
+*
+* Generate a fill program for the DMA command, the buffer will be pointed
+* by the GeneratedDmaProg field of the command. BD.SrcAddr points to a
+* pattern of SrcBurstSize * SrcBurstLen bytes, which is repeated over
+* BD.Length bytes at BD.DstAddr. To fill with a byte value, the pattern holds
+* that value in all its bytes.
+*
+* @param	InstPtr is then DMA instance.
+* @param	Channel is the DMA channel number.
+* @param	Cmd is the DMA command.
+*
+* @return	- XST_SUCCESS on success.
+* 		- XST_FAILURE if it fails
+*
+* @note		Both addresses must be incrementing and aligned to their
+*		burst size. XDmaPs_Start() flushes BD.Length bytes from
+*		BD.SrcAddr, which covers the pattern; a caller that does its
+*		own cache maintenance can clear BD.Length once the program is
+*		generated.
+*
+*****************************************************************************/
+int XDmaPs_GenFillProg(XDmaPs *InstPtr, unsigned int Channel, XDmaPs_Cmd *Cmd)
+{
+	void *Buf;
+	int ProgLen;
+	XDmaPs_ChannelData *ChanData;
+	XDmaPs_ChanCtrl *ChanCtrl;
+
+	Xil_AssertNonvoid(InstPtr != NULL);
+	Xil_AssertNonvoid(Cmd != NULL);
+
+	if (Channel >= XDMAPS_CHANNELS_PER_DEV) {
+		return XST_FAILURE;
+	}
+
+	ChanData = InstPtr->Chans + Channel;
+	ChanCtrl = &Cmd->ChanCtrl;
+
+	if (ChanCtrl->SrcBurstSize * ChanCtrl->SrcBurstLen
+	    != ChanCtrl->DstBurstSize * ChanCtrl->DstBurstLen) {
+		return XST_FAILURE;
+	}
+
+	if (!ChanCtrl->SrcInc || !ChanCtrl->DstInc ||
+	    (Cmd->BD.SrcAddr % ChanCtrl->SrcBurstSize) ||
+	    (Cmd->BD.DstAddr % ChanCtrl->DstBurstSize)) {
+		return XST_FAILURE;
+	}
+
+	Buf = XDmaPs_BufPool_Allocate(ChanData->ProgBufPool);
+	if (Buf == NULL) {
+		return XST_FAILURE;
+	}
+
+	Cmd->GeneratedDmaProg = Buf;
+	ProgLen = XDmaPs_BuildFillProg(Channel, Cmd);
+	Cmd->GeneratedDmaProgLength = ProgLen;
+
+	if (ProgLen <= 0) {
+		XDmaPs_BufPool_Free(ChanData->ProgBufPool, Buf);
+		Cmd->GeneratedDmaProgLength = 0;
+		Cmd->GeneratedDmaProg = NULL;
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
 /****************************************************************************/
 /**
  * Free the DMA program buffer that is pointed by the GeneratedDmaProg field
@@ -1507,14 +1798,23 @@ int XDmaPs_Start(XDmaPs *InstPtr, unsigned int Channel,
 
 		InstPtr->Chans[Channel].DmaCmdToHw = Cmd;
 
-		if (Cmd->ChanCtrl.SrcInc) {
+		if (Cmd->ChanCtrl.SrcInc &&
+		    (XDMAPS_BUF_IS_COHERENT(Cmd->BD.SrcAddr) == 0U)) {
 			Xil_DCacheFlushRange(Cmd->BD.SrcAddr, Cmd->BD.Length);
 		}
-		if (Cmd->ChanCtrl.DstInc) {
+		if (Cmd->ChanCtrl.DstInc &&
+		    (XDMAPS_BUF_IS_COHERENT(Cmd->BD.DstAddr) == 0U)) {
 			Xil_DCacheInvalidateRange(Cmd->BD.DstAddr,
 						  Cmd->BD.Length);
 		}
 
+		/*
+		 * Complete the buffer and program writes before the channel
+		 * starts, writes to coherent pool buffers are not followed by
+		 * any cache maintenance that would order them
+		 */
+		dsb();
+
 		Status = XDmaPs_Exec_DMAGO(InstPtr->Config.BaseAddress,
 					   Channel, DmaProg);
 	} else {
@@ -1525,6 +1825,501 @@ int XDmaPs_Start(XDmaPs *InstPtr, unsigned int Channel,
 	return Status;
 }
 
+/****************************************************************************/
+/**
+*
+* Construct the part of a DMA program that transfers a 2D block, without the
+* DMASEV and DMAEND. The program starts with the DMAMOV of SAR and DAR. Each
+* row is one pass of a loop on loop counter 1, up to 256 rows per loop. At
+* the end of a row DMAADDH moves the incrementing addresses on to the start
+* of the next row.
+*
+* If an incrementing address or its row pitch is not a multiple of the
+* burst size, the block is transferred in bytes.
+*
+* @param	ChanCtrlIn is the channel control of the transfer.
+* @param	Bd is the 2D block descriptor.
+* @param	DmaProgBuf is where the block program is constructed.
+* @param	DmaProgEnd is the end of the program buffer.
+*
+* @returns	The number of bytes for the block program, 0 if the block
+*		cannot be transferred with this channel control, -1 if the
+*		program buffer is too small.
+*
+* @note		None.
+*
+*****************************************************************************/
+static int XDmaPs_Build2DProg(XDmaPs_ChanCtrl *ChanCtrlIn, XDmaPs_SgBd *Bd,
+			      char *DmaProgBuf, char *DmaProgEnd)
+{
+	char *DmaProgBdStart = DmaProgBuf;
+	char *BodyStart;
+	unsigned SrcInc = ChanCtrlIn->SrcInc;
+	unsigned DstInc = ChanCtrlIn->DstInc;
+	unsigned int SrcStride = Bd->SrcStride;
+	unsigned int DstStride = Bd->DstStride;
+	unsigned int MemBurstSize = 1;
+	unsigned int BurstBytes;
+	unsigned int Bursts;
+	unsigned int TailWords;
+	unsigned int TailBytes;
+	unsigned int RowsLeft;
+	unsigned int Rows;
+	unsigned int Left;
+	unsigned int Count;
+	unsigned int BodyLen;
+	unsigned int Unaligned = 0;
+	u32 SrcGap = 0;
+	u32 DstGap = 0;
+	u32 Gap;
+	u32 BurstCCR;
+	u32 WordCCR;
+	u32 ByteCCR;
+	XDmaPs_ChanCtrl *ChanCtrl = ChanCtrlIn;
+	XDmaPs_ChanCtrl WordChanCtrl;
+	XDmaPs_ChanCtrl ByteChanCtrl;
+
+	if (SrcStride == 0) {
+		SrcStride = Bd->Length;
+	}
+	if (DstStride == 0) {
+		DstStride = Bd->Length;
+	}
+
+	if (SrcInc) {
+		if (SrcStride < Bd->Length) {
+			return 0;
+		}
+		SrcGap = SrcStride - Bd->Length;
+		if ((Bd->SrcAddr % ChanCtrl->SrcBurstSize) ||
+		    (SrcStride % ChanCtrl->SrcBurstSize)) {
+			Unaligned = 1;
+		}
+	}
+
+	if (DstInc) {
+		if (DstStride < Bd->Length) {
+			return 0;
+		}
+		DstGap = DstStride - Bd->Length;
+		if ((Bd->DstAddr % ChanCtrl->DstBurstSize) ||
+		    (DstStride % ChanCtrl->DstBurstSize)) {
+			Unaligned = 1;
+		}
+	}
+
+	if ((SrcGap > XDMAPS_SG_MAX_GAP) || (DstGap > XDMAPS_SG_MAX_GAP)) {
+		return 0;
+	}
+
+	if (Unaligned) {
+		/*
+		 * a fixed address keeps its burst size, so only memory to
+		 * memory blocks can fall back to bytes
+		 */
+		if (!SrcInc || !DstInc) {
+			return 0;
+		}
+		ByteChanCtrl = *ChanCtrlIn;
+		ByteChanCtrl.SrcBurstSize = 1;
+		ByteChanCtrl.SrcBurstLen = 1;
+		ByteChanCtrl.DstBurstSize = 1;
+		ByteChanCtrl.DstBurstLen = 1;
+		ChanCtrl = &ByteChanCtrl;
+	}
+
+	if (ChanCtrl->SrcInc) {
+		MemBurstSize = ChanCtrl->SrcBurstSize;
+	} else if (ChanCtrl->DstInc) {
+		MemBurstSize = ChanCtrl->DstBurstSize;
+	}
+
+	BurstBytes = ChanCtrl->SrcBurstSize * ChanCtrl->SrcBurstLen;
+	Bursts = Bd->Length / BurstBytes;
+	TailBytes = Bd->Length % BurstBytes;
+	TailWords = TailBytes / MemBurstSize;
+	TailBytes = TailBytes % MemBurstSize;
+
+	BurstCCR = XDmaPs_ToCCRValue(ChanCtrl);
+	WordChanCtrl = *ChanCtrl;
+	WordChanCtrl.SrcBurstSize = MemBurstSize;
+	WordChanCtrl.SrcBurstLen = 1;
+	WordChanCtrl.DstBurstSize = MemBurstSize;
+	WordChanCtrl.DstBurstLen = 1;
+	WordCCR = XDmaPs_ToCCRValue(&WordChanCtrl);
+	ByteCCR = XDMAPS_CCR_SINGLE_BYTE
+		  | (SrcInc & 1)
+		  | ((DstInc & 1) << 14);
+
+	/*
+	 * the row loop jumps back at most 255 bytes, check that the row
+	 * fits before constructing it
+	 */
+	BodyLen = ((Bursts + 255) / 256) * 6;
+	if (TailWords || TailBytes) {
+		BodyLen += 6;
+	}
+	if (TailWords) {
+		BodyLen += 12;
+	}
+	if (TailBytes) {
+		BodyLen += 12;
+	}
+	BodyLen += ((SrcGap + 0xFFFE) / 0xFFFF) * 3;
+	BodyLen += ((DstGap + 0xFFFE) / 0xFFFF) * 3;
+	if (BodyLen > 255) {
+		return 0;
+	}
+
+	if ((DmaProgEnd - DmaProgBuf) < (int)(BodyLen + 22)) {
+		return -1;
+	}
+
+	/* insert DMAMOV for SAR and DAR */
+	DmaProgBuf += XDmaPs_Instr_DMAMOV(DmaProgBuf, XDMAPS_MOV_SAR,
+					  Bd->SrcAddr);
+	DmaProgBuf += XDmaPs_Instr_DMAMOV(DmaProgBuf, XDMAPS_MOV_DAR,
+					  Bd->DstAddr);
+
+	/* without a tail the burst CCR stays for all the rows */
+	if (!TailWords && !TailBytes) {
+		DmaProgBuf += XDmaPs_Instr_DMAMOV(DmaProgBuf, XDMAPS_MOV_CCR,
+						  BurstCCR);
+	}
+
+	for (RowsLeft = Bd->Rows; RowsLeft > 0; RowsLeft -= Rows) {
+		Rows = (RowsLeft > 256) ? 256 : RowsLeft;
+
+		if ((DmaProgEnd - DmaProgBuf) < (int)(BodyLen + 4)) {
+			return -1;
+		}
+
+		DmaProgBuf += XDmaPs_Instr_DMALP(DmaProgBuf, 1, Rows);
+		BodyStart = DmaProgBuf;
+
+		if (TailWords || TailBytes) {
+			DmaProgBuf += XDmaPs_Instr_DMAMOV(DmaProgBuf,
+							  XDMAPS_MOV_CCR,
+							  BurstCCR);
+		}
+
+		for (Left = Bursts; Left > 0; Left -= Count) {
+			Count = (Left > 256) ? 256 : Left;
+			DmaProgBuf += XDmaPs_ConstructSingleLoop(DmaProgBuf,
+								 0,
+								 DmaProgBuf,
+								 Count);
+		}
+
+		if (TailWords) {
+			DmaProgBuf += XDmaPs_Instr_DMAMOV(DmaProgBuf,
+							  XDMAPS_MOV_CCR,
+							  WordCCR);
+			DmaProgBuf += XDmaPs_ConstructSingleLoop(DmaProgBuf,
+								 0,
+								 DmaProgBuf,
+								 TailWords);
+		}
+
+		if (TailBytes) {
+			DmaProgBuf += XDmaPs_Instr_DMAMOV(DmaProgBuf,
+							  XDMAPS_MOV_CCR,
+							  ByteCCR);
+			DmaProgBuf += XDmaPs_ConstructSingleLoop(DmaProgBuf,
+								 0,
+								 DmaProgBuf,
+								 TailBytes);
+		}
+
+		/* move on to the next row */
+		for (Gap = SrcGap; Gap > 0; Gap -= Count) {
+			Count = (Gap > 0xFFFF) ? 0xFFFF : Gap;
+			DmaProgBuf += XDmaPs_Instr_DMAADDH(DmaProgBuf,
+							   XDMAPS_ADDH_SAR,
+							   (u16)Count);
+		}
+		for (Gap = DstGap; Gap > 0; Gap -= Count) {
+			Count = (Gap > 0xFFFF) ? 0xFFFF : Gap;
+			DmaProgBuf += XDmaPs_Instr_DMAADDH(DmaProgBuf,
+							   XDMAPS_ADDH_DAR,
+							   (u16)Count);
+		}
+
+		DmaProgBuf += XDmaPs_Instr_DMALPEND(DmaProgBuf, BodyStart, 1);
+	}
+
+	return DmaProgBuf - DmaProgBdStart;
+}
+
+/****************************************************************************/
+/**
+*
+* Returns the offsets of the incrementing addresses of a scatter-gather
+* block into a burst. Blocks with the same lengths and offsets have the same
+* program, only the addresses in the DMAMOV of SAR and DAR differ.
+*
+* @param	ChanCtrl is the channel control of the list.
+* @param	Bd is the block descriptor.
+*
+* @returns	Source offset in bits 7:0, destination offset in bits 15:8.
+*
+* @note		None.
+*
+*****************************************************************************/
+static u16 XDmaPs_SgAlign(XDmaPs_ChanCtrl *ChanCtrl, XDmaPs_SgBd *Bd)
+{
+	u16 Align = 0;
+
+	if (ChanCtrl->SrcInc) {
+		Align |= (u16)(Bd->SrcAddr % ChanCtrl->SrcBurstSize);
+	}
+	if (ChanCtrl->DstInc) {
+		Align |= (u16)((Bd->DstAddr % ChanCtrl->DstBurstSize) << 8);
+	}
+
+	return Align;
+}
+
+/****************************************************************************/
+/**
+*
+* Build the DMA program of a scatter-gather list in its program buffer. The
+* blocks run one after the other, and the program signals the channel event
+* once, after the last block.
+*
+* @param	InstPtr is the DMA instance.
+* @param	Channel is the DMA channel number.
+* @param	List is the scatter-gather list.
+*
+* @return
+*		- XST_SUCCESS on success
+*		- XST_BUFFER_TOO_SMALL if the program does not fit in ProgBuf
+*		- XST_INVALID_PARAM if a block cannot be transferred with the
+*		  channel control of the list
+*
+* @note		ProgBuf must not be in use by the DMAC.
+*
+*****************************************************************************/
+int XDmaPs_SgCompile(XDmaPs *InstPtr, unsigned int Channel,
+		     XDmaPs_SgList *List)
+{
+	XDmaPs_ChanCtrl *ChanCtrl;
+	XDmaPs_SgBd *Bd;
+	XDmaPs_BD LinearBd;
+	char *DmaProgStart;
+	char *DmaProgBuf;
+	char *DmaProgEnd;
+	unsigned int Index;
+	int Bytes;
+
+	Xil_AssertNonvoid(InstPtr != NULL);
+	Xil_AssertNonvoid(List != NULL);
+
+	List->ProgLen = 0;
+
+	if (Channel >= XDMAPS_CHANNELS_PER_DEV) {
+		return XST_INVALID_PARAM;
+	}
+
+	if ((List->BdList == NULL) || (List->BdCount == 0) ||
+	    (List->ProgBuf == NULL)) {
+		return XST_INVALID_PARAM;
+	}
+
+	ChanCtrl = &List->ChanCtrl;
+	if (ChanCtrl->SrcBurstSize * ChanCtrl->SrcBurstLen
+	    != ChanCtrl->DstBurstSize * ChanCtrl->DstBurstLen) {
+		return XST_INVALID_PARAM;
+	}
+
+	DmaProgStart = List->ProgBuf;
+	DmaProgBuf = DmaProgStart;
+	DmaProgEnd = DmaProgStart + List->ProgBufLen - XDMAPS_SG_END_LEN;
+
+	for (Index = 0; Index < List->BdCount; Index++) {
+		Bd = List->BdList + Index;
+
+		if (Bd->Length == 0) {
+			return XST_INVALID_PARAM;
+		}
+
+		/*
+		 * unaligned fixed address is not supported
+		 */
+		if ((!ChanCtrl->SrcInc &&
+		     (Bd->SrcAddr % ChanCtrl->SrcBurstSize)) ||
+		    (!ChanCtrl->DstInc &&
+		     (Bd->DstAddr % ChanCtrl->DstBurstSize))) {
+			return XST_INVALID_PARAM;
+		}
+
+		if (((DmaProgEnd - DmaProgBuf) < (int)XDMAPS_SG_BLOCK_LEN) ||
+		    ((DmaProgBuf - DmaProgStart) > 0xFFFF)) {
+			return XST_BUFFER_TOO_SMALL;
+		}
+
+		Bd->ProgOffset = (u16)(DmaProgBuf - DmaProgStart);
+		Bd->ProgAlign = XDmaPs_SgAlign(ChanCtrl, Bd);
+
+		if (Bd->Rows > 1) {
+			Bytes = XDmaPs_Build2DProg(ChanCtrl, Bd, DmaProgBuf,
+						   DmaProgEnd);
+		} else {
+			LinearBd.SrcAddr = Bd->SrcAddr;
+			LinearBd.DstAddr = Bd->DstAddr;
+			LinearBd.Length = Bd->Length;
+			Bytes = XDmaPs_BuildBdProg(Channel, ChanCtrl,
+						   &LinearBd, DmaProgStart,
+						   DmaProgBuf,
+						   InstPtr->CacheLength);
+		}
+
+		if (Bytes < 0) {
+			return XST_BUFFER_TOO_SMALL;
+		}
+		if (Bytes == 0) {
+			return XST_INVALID_PARAM;
+		}
+		DmaProgBuf += Bytes;
+	}
+
+	/* Add a memory barrier before DMASSEV as recommended by spec */
+	DmaProgBuf += XDmaPs_Instr_DMAWMB(DmaProgBuf);
+	DmaProgBuf += XDmaPs_Instr_DMASEV(DmaProgBuf, Channel);
+	DmaProgBuf += XDmaPs_Instr_DMAEND(DmaProgBuf);
+
+	List->ProgLen = DmaProgBuf - DmaProgStart;
+	List->Compiles++;
+
+	if (XDMAPS_BUF_IS_COHERENT(DmaProgStart) == 0U) {
+		Xil_DCacheFlushRange((UINTPTR)DmaProgStart, List->ProgLen);
+	}
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* Start a scatter-gather list. The channel must be idle. If the list was
+* compiled before and the addresses of its blocks are aligned the same way,
+* only the addresses in the program are updated, otherwise the program is
+* rebuilt by XDmaPs_SgCompile(). The done handler of the channel is called
+* once, when all blocks are transferred.
+*
+* @param	InstPtr is the DMA instance.
+* @param	Channel is the DMA channel number.
+* @param	List is the scatter-gather list.
+*
+* @return
+*		- XST_SUCCESS on success
+*		- XST_DEVICE_BUSY if DMA is busy
+*		- XST_BUFFER_TOO_SMALL or XST_INVALID_PARAM if the list
+*		  cannot be compiled
+*		- XST_FAILURE on other failures
+*
+* @note		The list, its blocks and its program buffer must stay valid
+*		until the done handler is called.
+*
+*****************************************************************************/
+int XDmaPs_SgStart(XDmaPs *InstPtr, unsigned int Channel,
+		   XDmaPs_SgList *List)
+{
+	XDmaPs_ChanCtrl *ChanCtrl;
+	XDmaPs_SgBd *Bd;
+	XDmaPs_Cmd *Cmd;
+	unsigned int Index;
+	unsigned int Stride;
+	u32 Span;
+	int Rebuild = 0;
+	int Status;
+
+	Xil_AssertNonvoid(InstPtr != NULL);
+	Xil_AssertNonvoid(List != NULL);
+
+	if (Channel >= XDMAPS_CHANNELS_PER_DEV) {
+		return XST_INVALID_PARAM;
+	}
+
+	if (XDmaPs_IsActive(InstPtr, Channel)) {
+		return XST_DEVICE_BUSY;
+	}
+
+	ChanCtrl = &List->ChanCtrl;
+
+	if (List->ProgLen == 0) {
+		Rebuild = 1;
+	} else {
+		for (Index = 0; Index < List->BdCount; Index++) {
+			Bd = List->BdList + Index;
+			if (XDmaPs_SgAlign(ChanCtrl, Bd) != Bd->ProgAlign) {
+				Rebuild = 1;
+				break;
+			}
+		}
+	}
+
+	if (Rebuild) {
+		Status = XDmaPs_SgCompile(InstPtr, Channel, List);
+		if (Status != XST_SUCCESS) {
+			return Status;
+		}
+	} else {
+		/* same program, only the DMAMOV of SAR and DAR change */
+		for (Index = 0; Index < List->BdCount; Index++) {
+			Bd = List->BdList + Index;
+			XDmaPs_Memcpy4(List->ProgBuf + Bd->ProgOffset + 2,
+				       (char *)&Bd->SrcAddr);
+			XDmaPs_Memcpy4(List->ProgBuf + Bd->ProgOffset + 8,
+				       (char *)&Bd->DstAddr);
+		}
+		if (XDMAPS_BUF_IS_COHERENT(List->ProgBuf) == 0U) {
+			Xil_DCacheFlushRange((UINTPTR)List->ProgBuf,
+					     List->ProgLen);
+		}
+		List->Reuses++;
+	}
+
+	for (Index = 0; Index < List->BdCount; Index++) {
+		Bd = List->BdList + Index;
+
+		if (ChanCtrl->SrcInc &&
+		    (XDMAPS_BUF_IS_COHERENT(Bd->SrcAddr) == 0U)) {
+			Span = Bd->Length;
+			if (Bd->Rows > 1) {
+				Stride = Bd->SrcStride ? Bd->SrcStride
+					 : Bd->Length;
+				Span += (Bd->Rows - 1) * Stride;
+			}
+			Xil_DCacheFlushRange(Bd->SrcAddr, Span);
+		}
+		if (ChanCtrl->DstInc &&
+		    (XDMAPS_BUF_IS_COHERENT(Bd->DstAddr) == 0U)) {
+			Span = Bd->Length;
+			if (Bd->Rows > 1) {
+				Stride = Bd->DstStride ? Bd->DstStride
+					 : Bd->Length;
+				Span += (Bd->Rows - 1) * Stride;
+			}
+			Xil_DCacheInvalidateRange(Bd->DstAddr, Span);
+		}
+	}
+
+	/*
+	 * the list runs as a user program, the cache maintenance is done
+	 * above so the command carries a zero length block
+	 */
+	Cmd = &List->Cmd;
+	memset(Cmd, 0, sizeof(XDmaPs_Cmd));
+	Cmd->ChanCtrl = *ChanCtrl;
+	Cmd->BD.SrcAddr = List->BdList->SrcAddr;
+	Cmd->BD.DstAddr = List->BdList->DstAddr;
+	Cmd->UserDmaProg = List->ProgBuf;
+	Cmd->UserDmaProgLength = List->ProgLen;
+
+	return XDmaPs_Start(InstPtr, Channel, Cmd, 0);
+}
+
 /****************************************************************************/
 /**
 *
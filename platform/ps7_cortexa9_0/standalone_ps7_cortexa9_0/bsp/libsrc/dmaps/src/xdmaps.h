@@ -62,6 +62,11 @@
 * 2.8	sk     05/18/21 Modify all inline functions declarations from extern inline
 *			to static inline to avoid the linkage conflict for IAR compiler.
 * 2.9   aj     11/07/23 Added support for system device tree
+* 2.10  pt     10/19/26 Added scatter-gather lists, XDmaPs_SgStart() runs a
+*			list of linear and 2D strided blocks as one DMA
+*			program with one done interrupt.
+*       pt     10/19/26 Added XDmaPs_GenFillProg() and the asynchronous copy
+*			engine in xdmaps_copy.c.
 * </pre>
 *
 *****************************************************************************/
@@ -178,6 +183,54 @@ typedef struct {
 				 */
 } XDmaPs_Cmd;
 
+/** Scatter-gather block descriptor. A block with Rows of 0 or 1 is a linear
+ * transfer of Length bytes. A block with more rows is a 2D transfer, for
+ * example an image tile: Rows rows of Length bytes, the start of each row
+ * being SrcStride and DstStride bytes after the previous one. The strides
+ * are ignored for a fixed address side.
+ */
+typedef struct {
+	u32 SrcAddr;		/**< Source starting address */
+	u32 DstAddr;		/**< Destination starting address */
+	unsigned int Length;	/**< Bytes of the block, or of one row */
+	unsigned int Rows;	/**< Number of rows of a 2D block */
+	unsigned int SrcStride;	/**< Source row pitch in bytes, 0 is
+				  *  Length */
+	unsigned int DstStride;	/**< Destination row pitch in bytes, 0 is
+				  *  Length */
+	u16 ProgOffset;		/**< Set by the driver, offset of the
+				  *  block in the list program */
+	u16 ProgAlign;		/**< Set by the driver, address alignment
+				  *  the block program was built for */
+} XDmaPs_SgBd;
+
+/**
+ * A scatter-gather list. All blocks share the channel control and run as a
+ * single DMA program, built in ProgBuf by XDmaPs_SgCompile(). The program
+ * is kept and reused by XDmaPs_SgStart() as long as only the addresses of
+ * the blocks change; it is rebuilt when the alignment of an address
+ * changes. Call XDmaPs_SgCompile() again after changing ChanCtrl, BdCount,
+ * or the length, rows or strides of a block.
+ *
+ * The done handler is called once for the whole list, with a pointer to
+ * the Cmd field, which is the first member of the list.
+ */
+typedef struct {
+	XDmaPs_Cmd Cmd;			/**< Command the list runs as, set
+					  *  by the driver */
+	XDmaPs_ChanCtrl ChanCtrl;	/**< Channel control of all blocks */
+	XDmaPs_SgBd *BdList;		/**< Array of BdCount blocks */
+	unsigned int BdCount;		/**< Number of blocks */
+	char *ProgBuf;			/**< Program buffer, refer to
+					  *  XDMAPS_SG_PROG_LEN() */
+	unsigned int ProgBufLen;	/**< Size of ProgBuf in bytes */
+	unsigned int ProgLen;		/**< Length of the compiled program,
+					  *  0 if not compiled */
+	u32 Compiles;			/**< Number of program builds */
+	u32 Reuses;			/**< Number of starts that reused
+					  *  the program */
+} XDmaPs_SgList;
+
 /**
  * It's the done handler a user can set for a channel
  */
@@ -195,6 +248,51 @@ typedef void (*XDmaPsFaultHandler) (unsigned int Channel,
 #define XDMAPS_MAX_CHAN_BUFS	2
 #define XDMAPS_CHAN_BUF_LEN	128
 
+/*
+ * Scatter-gather program sizing. A linear block and every 256 rows of a 2D
+ * block take at most XDMAPS_SG_BLOCK_LEN bytes of program, the list end
+ * takes XDMAPS_SG_END_LEN bytes.
+ */
+#define XDMAPS_SG_BLOCK_LEN	288U
+#define XDMAPS_SG_END_LEN	4U
+#define XDMAPS_SG_PROG_LEN(Blocks)	\
+	(((Blocks) * XDMAPS_SG_BLOCK_LEN) + XDMAPS_SG_END_LEN)
+
+/*
+ * The row pitch of a 2D block may be up to XDMAPS_SG_MAX_GAP bytes larger
+ * than the row length
+ */
+#define XDMAPS_SG_MAX_ADDH	8U
+#define XDMAPS_SG_MAX_GAP	(XDMAPS_SG_MAX_ADDH * 0xFFFFU)
+
+/*
+ * Copy engine settings. Requests shorter than XDMAPS_COPY_CPU_THRESHOLD
+ * are copied by the CPU. A DMA request costs about 1400 instructions for
+ * the program and its completion and 10 register accesses, where
+ * Xil_MemCpy costs about 1.25 instructions per byte. The default is the
+ * length from which the DMA path takes less CPU time for buffers in the
+ * coherent pool of xil_dmapool.h, 1.7 to 1.9 KB at one instruction per
+ * cycle in tools/host/bench_dmaps_copy.c. For cacheable buffers the
+ * engine cleans a line of the source and invalidates a line of the
+ * destination per 32 bytes, and once a line operation costs about 20
+ * instruction times the CPU copy out of the caches stays cheaper at any
+ * length, so such callers raise the threshold unless their data is not
+ * in the caches.
+ */
+#ifndef XDMAPS_COPY_QUEUE_LEN
+#define XDMAPS_COPY_QUEUE_LEN		16U
+#endif
+#ifndef XDMAPS_COPY_CPU_THRESHOLD
+#define XDMAPS_COPY_CPU_THRESHOLD	2048U
+#endif
+#ifndef XDMAPS_COPY_PIECE_LEN
+#define XDMAPS_COPY_PIECE_LEN		0x20000U
+#endif
+#define XDMAPS_COPY_BURST_SIZE		8U
+#define XDMAPS_COPY_BURST_LEN		16U
+#define XDMAPS_COPY_BURST_BYTES		\
+	(XDMAPS_COPY_BURST_SIZE * XDMAPS_COPY_BURST_LEN)
+
 /**
  * The XDmaPs_ProgBuf is the struct for a DMA program buffer.
  */
@@ -245,6 +343,59 @@ typedef struct {
 	 */
 } XDmaPs;
 
+/**
+ * Token of an asynchronous copy, 0 is never a valid token
+ */
+typedef u32 XDmaPs_CopyToken;
+
+/**
+ * A request of the copy engine. Requests longer than PieceLen are split in
+ * pieces, which run in parallel on the free channels.
+ */
+typedef struct {
+	volatile XDmaPs_CopyToken Token; /**< Token, 0 if the slot is free */
+	UINTPTR DstAddr;		/**< Destination address */
+	UINTPTR SrcAddr;		/**< Source address, unused for a fill */
+	u32 Length;			/**< Bytes of the request */
+	u32 Issued;			/**< Bytes handed to the channels */
+	u32 Pending;			/**< Pieces running on the channels */
+	u8 Value;			/**< Fill value */
+	u8 IsFill;			/**< 1 for XDmaPs_MemSetAsync() */
+} XDmaPs_CopyReq;
+
+/**
+ * The copy engine runs XDmaPs_MemCpyAsync() and XDmaPs_MemSetAsync()
+ * requests on a set of channels it owns.
+ */
+typedef struct {
+	XDmaPs *DmaInst;		/**< DMA instance */
+	u32 ChanMask;			/**< Channels owned by the engine */
+	volatile u32 BusyMask;		/**< Channels running a piece */
+	int PollMode;			/**< 1 if the done interrupts are not
+					  *  connected, XDmaPs_CopyService()
+					  *  then handles the completions */
+	u32 CpuThreshold;		/**< Shorter requests are done by the
+					  *  CPU */
+	u32 PieceLen;			/**< Largest piece run on one channel */
+	XDmaPs_CopyToken NextToken;	/**< Token of the next request */
+	XDmaPs_CopyReq Req[XDMAPS_COPY_QUEUE_LEN]; /**< Request slots */
+	XDmaPs_CopyReq *ChanReq[XDMAPS_CHANNELS_PER_DEV]; /**< Request of
+							    *  each channel */
+	XDmaPs_Cmd ChanCmd[XDMAPS_CHANNELS_PER_DEV]; /**< Piece commands */
+	u64 Pattern[XDMAPS_CHANNELS_PER_DEV][XDMAPS_COPY_BURST_BYTES / 8U];
+					/**< Fill pattern of each channel */
+	XDmaPs_CopyToken DoneQueue[XDMAPS_COPY_QUEUE_LEN]; /**< Tokens of
+							     *  finished
+							     *  requests */
+	volatile u32 DoneHead;		/**< Completions queued */
+	volatile u32 DoneTail;		/**< Completions taken */
+	u32 CpuCopies;			/**< Requests done by the CPU */
+	u32 DmaCopies;			/**< Requests done by the DMAC */
+	u32 Pieces;			/**< Pieces started */
+	u32 Errors;			/**< Pieces that failed to start */
+	u32 DoneDropped;		/**< Completions lost to a full queue */
+} XDmaPs_CopyEngine;
+
 /*
  * Functions implemented in xdmaps.c
  */
@@ -259,10 +410,17 @@ int XDmaPs_Start(XDmaPs *InstPtr, unsigned int Channel,
 int XDmaPs_IsActive(XDmaPs *InstPtr, unsigned int Channel);
 int XDmaPs_GenDmaProg(XDmaPs *InstPtr, unsigned int Channel,
 		      XDmaPs_Cmd *Cmd);
+int XDmaPs_GenFillProg(XDmaPs *InstPtr, unsigned int Channel,
+		       XDmaPs_Cmd *Cmd);
 int XDmaPs_FreeDmaProg(XDmaPs *InstPtr, unsigned int Channel,
 		       XDmaPs_Cmd *Cmd);
 void XDmaPs_Print_DmaProg(XDmaPs_Cmd *Cmd);
 
+int XDmaPs_SgCompile(XDmaPs *InstPtr, unsigned int Channel,
+		     XDmaPs_SgList *List);
+int XDmaPs_SgStart(XDmaPs *InstPtr, unsigned int Channel,
+		   XDmaPs_SgList *List);
+
 
 int XDmaPs_ResetManager(XDmaPs *InstPtr);
 int XDmaPs_ResetChannel(XDmaPs *InstPtr, unsigned int Channel);
@@ -298,6 +456,7 @@ static INLINE int XDmaPs_Instr_DMAMOV(char *DmaProg, unsigned Rd, u32 Imm);
 static INLINE int XDmaPs_Instr_DMANOP(char *DmaProg);
 static INLINE int XDmaPs_Instr_DMASEV(char *DmaProg, unsigned int EventNumber);
 static INLINE int XDmaPs_Instr_DMAST(char *DmaProg);
+static INLINE int XDmaPs_Instr_DMAADDH(char *DmaProg, unsigned Ra, u16 Imm);
 static INLINE unsigned XDmaPs_ToEndianSwapSizeBits(unsigned int EndianSwapSize);
 static INLINE unsigned XDmaPs_ToBurstSizeBits(unsigned BurstSize);
 #endif
@@ -333,6 +492,23 @@ u32 XDmaPs_GetDrvIndex(XDmaPs *InstancePtr, UINTPTR BaseAddress);
 #endif
 
 
+/*
+ * Copy engine functions in xdmaps_copy.c
+ */
+int XDmaPs_CopyInitialize(XDmaPs_CopyEngine *EngPtr, XDmaPs *InstPtr,
+			  u32 ChanMask, int PollMode);
+int XDmaPs_MemCpyAsync(XDmaPs_CopyEngine *EngPtr, void *Dst,
+		       const void *Src, u32 Length,
+		       XDmaPs_CopyToken *TokenPtr);
+int XDmaPs_MemSetAsync(XDmaPs_CopyEngine *EngPtr, void *Dst, u8 Value,
+		       u32 Length, XDmaPs_CopyToken *TokenPtr);
+int XDmaPs_CopyIsDone(XDmaPs_CopyEngine *EngPtr, XDmaPs_CopyToken Token);
+int XDmaPs_CopyWait(XDmaPs_CopyEngine *EngPtr, XDmaPs_CopyToken Token,
+		    u32 TimeoutUs);
+int XDmaPs_CopyGetDone(XDmaPs_CopyEngine *EngPtr,
+		       XDmaPs_CopyToken *TokenPtr);
+void XDmaPs_CopyService(XDmaPs_CopyEngine *EngPtr);
+
 /*
  * self-test functions in xdmaps_selftest.c
  */
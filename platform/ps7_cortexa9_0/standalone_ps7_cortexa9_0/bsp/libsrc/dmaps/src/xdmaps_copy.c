@@ -0,0 +1,643 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/****************************************************************************/
+/**
+*
+* @file xdmaps_copy.c
+* @addtogroup dmaps Overview
+* @{
+*
+* This file contains an asynchronous memory copy and fill service on top of
+* the XDmaPs driver.
+*
+* The engine owns a set of channels and runs XDmaPs_MemCpyAsync() and
+* XDmaPs_MemSetAsync() requests on them. Each request returns a token.
+* Requests shorter than XDMAPS_COPY_PIECE_LEN run on one channel, longer
+* ones are split in pieces that run in parallel on the free channels, and
+* further pieces start as channels finish. Requests below CpuThreshold, and
+* copies whose source and destination are not aligned the same way within
+* a beat, are done by the CPU before the call returns. The engine cleans
+* and invalidates the buffers by cache line, except those in the coherent
+* pool of xil_dmapool.h.
+*
+* A finished request is put in the completion queue, taken with
+* XDmaPs_CopyGetDone(). XDmaPs_CopyIsDone() and XDmaPs_CopyWait() check a
+* given token. The done interrupts of the owned channels are expected to be
+* connected to XDmaPs_DoneISR_n; in poll mode XDmaPs_CopyService() checks
+* the interrupt status register instead.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------ -------- -----------------------------------------------
+* 2.10  pt     10/19/26 First Release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+
+#include "xstatus.h"
+#include "xdmaps.h"
+#include "xil_cache.h"
+#include "xil_mem.h"
+#include "xpseudo_asm.h"
+#include "xreg_cortexa9.h"
+#include "sleep.h"
+
+#if defined (PLATFORM_ZYNQ) && !defined (__aarch64__)
+#include "xil_dmapool.h"
+#define XDMAPS_COPY_IS_COHERENT(Addr)	Xil_DmaPoolIsCoherent((UINTPTR)(Addr))
+#else
+#define XDMAPS_COPY_IS_COHERENT(Addr)	0U
+#endif
+
+/************************** Constant Definitions *****************************/
+
+
+/**************************** Type Definitions *******************************/
+
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/* Tokens are compared modulo 2^32 */
+#define XDMAPS_COPY_BEFORE(A, B)	((s32)((A) - (B)) < 0)
+
+/************************** Function Prototypes ******************************/
+
+static void XDmaPs_CopyDoneHandler(unsigned int Channel, XDmaPs_Cmd *DmaCmd,
+				   void *CallbackRef);
+static void XDmaPs_CopyDispatch(XDmaPs_CopyEngine *EngPtr);
+static void XDmaPs_CopyComplete(XDmaPs_CopyEngine *EngPtr,
+				XDmaPs_CopyToken Token);
+static int XDmaPs_CopySubmit(XDmaPs_CopyEngine *EngPtr, UINTPTR DstAddr,
+			     UINTPTR SrcAddr, u8 Value, u32 Length,
+			     u8 IsFill, XDmaPs_CopyToken *TokenPtr);
+
+/************************** Variable Definitions *****************************/
+
+static void (*const XDmaPs_CopyDoneIsr[XDMAPS_CHANNELS_PER_DEV])(XDmaPs *) = {
+	XDmaPs_DoneISR_0, XDmaPs_DoneISR_1, XDmaPs_DoneISR_2,
+	XDmaPs_DoneISR_3, XDmaPs_DoneISR_4, XDmaPs_DoneISR_5,
+	XDmaPs_DoneISR_6, XDmaPs_DoneISR_7
+};
+
+/****************************************************************************/
+/**
+*
+* Masks IRQs, the engine state is shared with the done interrupt handler.
+*
+* @return	The CPSR to restore.
+*
+*****************************************************************************/
+static INLINE u32 XDmaPs_CopyLock(void)
+{
+	u32 Cpsr = mfcpsr();
+
+	mtcpsr(Cpsr | XREG_CPSR_IRQ_ENABLE);
+
+	return Cpsr;
+}
+
+/****************************************************************************/
+/**
+*
+* Restores the IRQ mask saved by XDmaPs_CopyLock().
+*
+* @param	Cpsr is the CPSR returned by XDmaPs_CopyLock().
+*
+*****************************************************************************/
+static INLINE void XDmaPs_CopyUnlock(u32 Cpsr)
+{
+	mtcpsr(Cpsr);
+}
+
+/****************************************************************************/
+/**
+*
+* Initializes a copy engine and takes over the done handlers of the given
+* channels.
+*
+* @param	EngPtr is the copy engine.
+* @param	InstPtr is an initialized DMA instance.
+* @param	ChanMask has a bit set for each channel the engine owns. The
+*		channels must not be used for anything else.
+* @param	PollMode is 1 if the done interrupts of the channels are not
+*		connected, the completions are then handled by
+*		XDmaPs_CopyService() and XDmaPs_CopyWait().
+*
+* @return
+*		- XST_SUCCESS on success
+*		- XST_INVALID_PARAM if ChanMask has no valid channel
+*
+* @note		CpuThreshold and PieceLen can be changed after this call,
+*		PieceLen must stay a multiple of XDMAPS_COPY_BURST_BYTES.
+*
+*****************************************************************************/
+int XDmaPs_CopyInitialize(XDmaPs_CopyEngine *EngPtr, XDmaPs *InstPtr,
+			  u32 ChanMask, int PollMode)
+{
+	unsigned int Channel;
+
+	Xil_AssertNonvoid(EngPtr != NULL);
+	Xil_AssertNonvoid(InstPtr != NULL);
+	Xil_AssertNonvoid(InstPtr->IsReady == 1);
+
+	ChanMask &= (1U << XDMAPS_CHANNELS_PER_DEV) - 1U;
+	if (ChanMask == 0U) {
+		return XST_INVALID_PARAM;
+	}
+
+	memset(EngPtr, 0, sizeof(XDmaPs_CopyEngine));
+	EngPtr->DmaInst = InstPtr;
+	EngPtr->ChanMask = ChanMask;
+	EngPtr->PollMode = PollMode;
+	EngPtr->CpuThreshold = XDMAPS_COPY_CPU_THRESHOLD;
+	EngPtr->PieceLen = XDMAPS_COPY_PIECE_LEN;
+	EngPtr->NextToken = 1U;
+
+	for (Channel = 0; Channel < XDMAPS_CHANNELS_PER_DEV; Channel++) {
+		if (ChanMask & (1U << Channel)) {
+			(void)XDmaPs_SetDoneHandler(InstPtr, Channel,
+						    XDmaPs_CopyDoneHandler,
+						    EngPtr);
+		}
+	}
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* Starts an asynchronous copy of Length bytes from Src to Dst.
+*
+* @param	EngPtr is the copy engine.
+* @param	Dst is the destination buffer.
+* @param	Src is the source buffer, it must not overlap Dst.
+* @param	Length is the number of bytes to copy.
+* @param	TokenPtr returns the token of the request.
+*
+* @return
+*		- XST_SUCCESS if the request is queued or already done
+*		- XST_DEVICE_BUSY if all XDMAPS_COPY_QUEUE_LEN request slots
+*		  are in use
+*
+* @note		The buffers must not be accessed until the request is done.
+*
+*****************************************************************************/
+int XDmaPs_MemCpyAsync(XDmaPs_CopyEngine *EngPtr, void *Dst,
+		       const void *Src, u32 Length,
+		       XDmaPs_CopyToken *TokenPtr)
+{
+	Xil_AssertNonvoid(EngPtr != NULL);
+	Xil_AssertNonvoid(TokenPtr != NULL);
+
+	/*
+	 * the DMA program falls back to single byte beats when the two
+	 * addresses are not aligned the same way, the CPU is faster then
+	 */
+	if ((Length < EngPtr->CpuThreshold) ||
+	    ((((UINTPTR)Dst ^ (UINTPTR)Src) &
+	      (XDMAPS_COPY_BURST_SIZE - 1U)) != 0U)) {
+		Xil_MemCpy(Dst, Src, Length);
+		EngPtr->CpuCopies++;
+		return XDmaPs_CopySubmit(EngPtr, (UINTPTR)Dst, (UINTPTR)Src,
+					 0U, 0U, 0U, TokenPtr);
+	}
+
+	return XDmaPs_CopySubmit(EngPtr, (UINTPTR)Dst, (UINTPTR)Src, 0U,
+				 Length, 0U, TokenPtr);
+}
+
+/****************************************************************************/
+/**
+*
+* Starts an asynchronous fill of Length bytes at Dst with Value.
+*
+* @param	EngPtr is the copy engine.
+* @param	Dst is the destination buffer.
+* @param	Value is the fill value.
+* @param	Length is the number of bytes to fill.
+* @param	TokenPtr returns the token of the request.
+*
+* @return
+*		- XST_SUCCESS if the request is queued or already done
+*		- XST_DEVICE_BUSY if all XDMAPS_COPY_QUEUE_LEN request slots
+*		  are in use
+*
+* @note		The buffer must not be accessed until the request is done.
+*
+*****************************************************************************/
+int XDmaPs_MemSetAsync(XDmaPs_CopyEngine *EngPtr, void *Dst, u8 Value,
+		       u32 Length, XDmaPs_CopyToken *TokenPtr)
+{
+	u32 Head;
+
+	Xil_AssertNonvoid(EngPtr != NULL);
+	Xil_AssertNonvoid(TokenPtr != NULL);
+
+	if (Length < EngPtr->CpuThreshold) {
+		memset(Dst, Value, Length);
+		EngPtr->CpuCopies++;
+		return XDmaPs_CopySubmit(EngPtr, (UINTPTR)Dst, 0U, Value, 0U,
+					 1U, TokenPtr);
+	}
+
+	/* the fill program needs a beat aligned destination */
+	Head = (XDMAPS_COPY_BURST_SIZE -
+		((UINTPTR)Dst & (XDMAPS_COPY_BURST_SIZE - 1U))) &
+	       (XDMAPS_COPY_BURST_SIZE - 1U);
+	if (Head > Length) {
+		Head = Length;
+	}
+	if (Head != 0U) {
+		memset(Dst, Value, Head);
+	}
+
+	return XDmaPs_CopySubmit(EngPtr, (UINTPTR)Dst + Head, 0U, Value,
+				 Length - Head, 1U, TokenPtr);
+}
+
+/****************************************************************************/
+/**
+*
+* Checks whether a request is done.
+*
+* @param	EngPtr is the copy engine.
+* @param	Token is the token of the request.
+*
+* @return	1 if the request is done, 0 otherwise.
+*
+*****************************************************************************/
+int XDmaPs_CopyIsDone(XDmaPs_CopyEngine *EngPtr, XDmaPs_CopyToken Token)
+{
+	unsigned int Index;
+
+	Xil_AssertNonvoid(EngPtr != NULL);
+
+	if (Token == 0U) {
+		return 1;
+	}
+
+	for (Index = 0; Index < XDMAPS_COPY_QUEUE_LEN; Index++) {
+		if (EngPtr->Req[Index].Token == Token) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/****************************************************************************/
+/**
+*
+* Waits until a request is done.
+*
+* @param	EngPtr is the copy engine.
+* @param	Token is the token of the request.
+* @param	TimeoutUs is the longest wait in microseconds.
+*
+* @return
+*		- XST_SUCCESS if the request is done
+*		- XST_FAILURE on time out
+*
+*****************************************************************************/
+int XDmaPs_CopyWait(XDmaPs_CopyEngine *EngPtr, XDmaPs_CopyToken Token,
+		    u32 TimeoutUs)
+{
+	u32 Timeout = TimeoutUs;
+
+	Xil_AssertNonvoid(EngPtr != NULL);
+
+	while (XDmaPs_CopyIsDone(EngPtr, Token) == 0) {
+		if (EngPtr->PollMode) {
+			XDmaPs_CopyService(EngPtr);
+			if (XDmaPs_CopyIsDone(EngPtr, Token)) {
+				break;
+			}
+		}
+		if (Timeout == 0U) {
+			return XST_FAILURE;
+		}
+		usleep(1);
+		Timeout--;
+	}
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* Takes the oldest entry of the completion queue.
+*
+* @param	EngPtr is the copy engine.
+* @param	TokenPtr returns the token of a finished request.
+*
+* @return
+*		- XST_SUCCESS if a token is returned
+*		- XST_NO_DATA if the queue is empty
+*
+* @note		The queue holds XDMAPS_COPY_QUEUE_LEN entries, older
+*		completions are dropped and counted in DoneDropped when it
+*		is full. In poll mode call XDmaPs_CopyService() first.
+*
+*****************************************************************************/
+int XDmaPs_CopyGetDone(XDmaPs_CopyEngine *EngPtr,
+		       XDmaPs_CopyToken *TokenPtr)
+{
+	u32 Cpsr;
+	int Status = XST_NO_DATA;
+
+	Xil_AssertNonvoid(EngPtr != NULL);
+	Xil_AssertNonvoid(TokenPtr != NULL);
+
+	Cpsr = XDmaPs_CopyLock();
+	if (EngPtr->DoneTail != EngPtr->DoneHead) {
+		*TokenPtr = EngPtr->DoneQueue[EngPtr->DoneTail %
+						      XDMAPS_COPY_QUEUE_LEN];
+		EngPtr->DoneTail++;
+		Status = XST_SUCCESS;
+	}
+	XDmaPs_CopyUnlock(Cpsr);
+
+	return Status;
+}
+
+/****************************************************************************/
+/**
+*
+* Handles the finished pieces of the engine channels from the interrupt
+* status register, for an engine in poll mode.
+*
+* @param	EngPtr is the copy engine.
+*
+* @return	None.
+*
+*****************************************************************************/
+void XDmaPs_CopyService(XDmaPs_CopyEngine *EngPtr)
+{
+	unsigned int Channel;
+	u32 IntStatus;
+	u32 Cpsr;
+
+	Xil_AssertVoid(EngPtr != NULL);
+
+	Cpsr = XDmaPs_CopyLock();
+	IntStatus = XDmaPs_ReadReg(EngPtr->DmaInst->Config.BaseAddress,
+				   XDMAPS_INTSTATUS_OFFSET);
+	IntStatus &= EngPtr->BusyMask;
+
+	for (Channel = 0; Channel < XDMAPS_CHANNELS_PER_DEV; Channel++) {
+		if (IntStatus & (1U << Channel)) {
+			XDmaPs_CopyDoneIsr[Channel](EngPtr->DmaInst);
+		}
+	}
+	XDmaPs_CopyUnlock(Cpsr);
+}
+
+/****************************************************************************/
+/**
+*
+* Queues a request and starts it on the free channels. A request of 0 bytes
+* is completed at once.
+*
+* @param	EngPtr is the copy engine.
+* @param	DstAddr is the destination address.
+* @param	SrcAddr is the source address.
+* @param	Value is the fill value.
+* @param	Length is the number of bytes.
+* @param	IsFill is 1 for a fill.
+* @param	TokenPtr returns the token of the request.
+*
+* @return	XST_SUCCESS, or XST_DEVICE_BUSY if no slot is free.
+*
+*****************************************************************************/
+static int XDmaPs_CopySubmit(XDmaPs_CopyEngine *EngPtr, UINTPTR DstAddr,
+			     UINTPTR SrcAddr, u8 Value, u32 Length,
+			     u8 IsFill, XDmaPs_CopyToken *TokenPtr)
+{
+	XDmaPs_CopyReq *Req = NULL;
+	XDmaPs_CopyToken Token;
+	unsigned int Index;
+	u32 Cpsr;
+
+	Cpsr = XDmaPs_CopyLock();
+
+	if (Length != 0U) {
+		for (Index = 0; Index < XDMAPS_COPY_QUEUE_LEN; Index++) {
+			if (EngPtr->Req[Index].Token == 0U) {
+				Req = &EngPtr->Req[Index];
+				break;
+			}
+		}
+		if (Req == NULL) {
+			XDmaPs_CopyUnlock(Cpsr);
+			return XST_DEVICE_BUSY;
+		}
+	}
+
+	Token = EngPtr->NextToken;
+	EngPtr->NextToken++;
+	if (EngPtr->NextToken == 0U) {
+		EngPtr->NextToken = 1U;
+	}
+	*TokenPtr = Token;
+
+	if (Req == NULL) {
+		XDmaPs_CopyComplete(EngPtr, Token);
+	} else {
+		Req->DstAddr = DstAddr;
+		Req->SrcAddr = SrcAddr;
+		Req->Length = Length;
+		Req->Issued = 0U;
+		Req->Pending = 0U;
+		Req->Value = Value;
+		Req->IsFill = IsFill;
+		Req->Token = Token;
+		EngPtr->DmaCopies++;
+
+		XDmaPs_CopyDispatch(EngPtr);
+	}
+
+	XDmaPs_CopyUnlock(Cpsr);
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* Starts the next pieces of the oldest requests on the free channels. Called
+* with IRQs masked or from the done interrupt.
+*
+* @param	EngPtr is the copy engine.
+*
+* @return	None.
+*
+*****************************************************************************/
+static void XDmaPs_CopyDispatch(XDmaPs_CopyEngine *EngPtr)
+{
+	XDmaPs_CopyReq *Req;
+	XDmaPs_Cmd *Cmd;
+	unsigned int Channel;
+	unsigned int Index;
+	u32 Piece;
+	int Status;
+
+	for (Channel = 0; Channel < XDMAPS_CHANNELS_PER_DEV; Channel++) {
+		if (((EngPtr->ChanMask & (1U << Channel)) == 0U) ||
+		    (EngPtr->BusyMask & (1U << Channel))) {
+			continue;
+		}
+
+		Req = NULL;
+		for (Index = 0; Index < XDMAPS_COPY_QUEUE_LEN; Index++) {
+			if ((EngPtr->Req[Index].Token != 0U) &&
+			    (EngPtr->Req[Index].Issued <
+			     EngPtr->Req[Index].Length) &&
+			    ((Req == NULL) ||
+			     XDMAPS_COPY_BEFORE(EngPtr->Req[Index].Token,
+						Req->Token))) {
+				Req = &EngPtr->Req[Index];
+			}
+		}
+		if (Req == NULL) {
+			return;
+		}
+
+		Piece = Req->Length - Req->Issued;
+		if (Piece > EngPtr->PieceLen) {
+			Piece = EngPtr->PieceLen;
+		}
+
+		Cmd = &EngPtr->ChanCmd[Channel];
+		memset(Cmd, 0, sizeof(XDmaPs_Cmd));
+		Cmd->ChanCtrl.SrcBurstSize = XDMAPS_COPY_BURST_SIZE;
+		Cmd->ChanCtrl.SrcBurstLen = XDMAPS_COPY_BURST_LEN;
+		Cmd->ChanCtrl.SrcInc = 1;
+		Cmd->ChanCtrl.DstBurstSize = XDMAPS_COPY_BURST_SIZE;
+		Cmd->ChanCtrl.DstBurstLen = XDMAPS_COPY_BURST_LEN;
+		Cmd->ChanCtrl.DstInc = 1;
+		Cmd->BD.DstAddr = (u32)(Req->DstAddr + Req->Issued);
+		Cmd->BD.Length = Piece;
+
+		if (Req->IsFill) {
+			memset(EngPtr->Pattern[Channel], Req->Value,
+			       XDMAPS_COPY_BURST_BYTES);
+			Xil_DCacheFlushRange((UINTPTR)EngPtr->Pattern[Channel],
+					     XDMAPS_COPY_BURST_BYTES);
+			Cmd->BD.SrcAddr = (u32)(UINTPTR)EngPtr->Pattern[Channel];
+			Status = XDmaPs_GenFillProg(EngPtr->DmaInst, Channel,
+						    Cmd);
+		} else {
+			Cmd->BD.SrcAddr = (u32)(Req->SrcAddr + Req->Issued);
+			if (XDMAPS_COPY_IS_COHERENT(Cmd->BD.SrcAddr) == 0U) {
+				Xil_DCacheFlushRange(Cmd->BD.SrcAddr, Piece);
+			}
+			Status = XDmaPs_GenDmaProg(EngPtr->DmaInst, Channel,
+						   Cmd);
+		}
+
+		if (Status == XST_SUCCESS) {
+			if (XDMAPS_COPY_IS_COHERENT(Cmd->BD.DstAddr) == 0U) {
+				Xil_DCacheInvalidateRange(Cmd->BD.DstAddr,
+							  Piece);
+			}
+
+			/* the cache maintenance is done above */
+			Cmd->BD.Length = 0U;
+			Status = XDmaPs_Start(EngPtr->DmaInst, Channel, Cmd, 0);
+			if (Status != XST_SUCCESS) {
+				(void)XDmaPs_FreeDmaProg(EngPtr->DmaInst,
+							 Channel, Cmd);
+			}
+		}
+
+		Req->Issued += Piece;
+
+		if (Status != XST_SUCCESS) {
+			/* the piece is dropped, the request still completes */
+			EngPtr->Errors++;
+			if ((Req->Issued == Req->Length) &&
+			    (Req->Pending == 0U)) {
+				XDmaPs_CopyComplete(EngPtr, Req->Token);
+				Req->Token = 0U;
+			}
+			continue;
+		}
+
+		Req->Pending++;
+		EngPtr->ChanReq[Channel] = Req;
+		EngPtr->BusyMask |= 1U << Channel;
+		EngPtr->Pieces++;
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* Puts a token in the completion queue, dropping the oldest entry if the
+* queue is full.
+*
+* @param	EngPtr is the copy engine.
+* @param	Token is the token of the finished request.
+*
+* @return	None.
+*
+*****************************************************************************/
+static void XDmaPs_CopyComplete(XDmaPs_CopyEngine *EngPtr,
+				XDmaPs_CopyToken Token)
+{
+	if ((EngPtr->DoneHead - EngPtr->DoneTail) >= XDMAPS_COPY_QUEUE_LEN) {
+		EngPtr->DoneTail++;
+		EngPtr->DoneDropped++;
+	}
+
+	EngPtr->DoneQueue[EngPtr->DoneHead % XDMAPS_COPY_QUEUE_LEN] = Token;
+	EngPtr->DoneHead++;
+}
+
+/****************************************************************************/
+/**
+*
+* Done handler of the engine channels, completes the request of the piece
+* and starts the next pieces.
+*
+* @param	Channel is the channel of the finished piece.
+* @param	DmaCmd is the command of the piece.
+* @param	CallbackRef is the copy engine.
+*
+* @return	None.
+*
+*****************************************************************************/
+static void XDmaPs_CopyDoneHandler(unsigned int Channel, XDmaPs_Cmd *DmaCmd,
+				   void *CallbackRef)
+{
+	XDmaPs_CopyEngine *EngPtr = (XDmaPs_CopyEngine *)CallbackRef;
+	XDmaPs_CopyReq *Req;
+
+	(void)DmaCmd;
+
+	Req = EngPtr->ChanReq[Channel];
+	EngPtr->ChanReq[Channel] = NULL;
+	EngPtr->BusyMask &= ~(1U << Channel);
+
+	if (Req != NULL) {
+		Req->Pending--;
+		if ((Req->Issued == Req->Length) && (Req->Pending == 0U)) {
+			XDmaPs_CopyComplete(EngPtr, Req->Token);
+			Req->Token = 0U;
+		}
+	}
+
+	XDmaPs_CopyDispatch(EngPtr);
+}
+/** @} */
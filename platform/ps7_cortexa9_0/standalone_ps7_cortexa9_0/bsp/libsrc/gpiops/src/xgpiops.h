@@ -131,6 +131,8 @@
 *                     to add multi-core interrupt support.
 * 3.14  bkv  02/20/25 Changed data type of effective address from u32 to UINTPTR
 *                     to support both 32-bit and 64-bit platforms.
+* 3.15  pt   10/19/26 Added per pin interrupt handlers, XGpioPs_IntrPinHandler
+*                     and the edge time stamp ring.
 *
 * </pre>
 *
@@ -213,6 +215,33 @@ extern "C" {
  *****************************************************************************/
 typedef void (*XGpioPs_Handler) (void *CallBackRef, u32 Bank, u32 Status);
 
+/****************************************************************************/
+/**
+ * This handler data type allows the user to define a callback function for
+ * the interrupt of a single pin, called by XGpioPs_IntrPinHandler.
+ *
+ * @param	CallBackRef is the callback reference set for the pin.
+ * @param	Pin is the pin number in the GPIO device.
+ *
+ *****************************************************************************/
+typedef void (*XGpioPs_PinHandler) (void *CallBackRef, u32 Pin);
+
+/**
+ * Entry of the per pin handler table.
+ */
+typedef struct {
+	XGpioPs_PinHandler Handler;	/**< Handler of the pin, or NULL */
+	void *CallBackRef;		/**< Callback ref of the pin */
+} XGpioPs_PinEntry;
+
+/**
+ * Entry of the edge time stamp ring.
+ */
+typedef struct {
+	u64 Time;		/**< XTime_GetTime() count when handled */
+	u32 Pin;		/**< Pin number in the GPIO device */
+} XGpioPs_Edge;
+
 /**
  * This typedef contains configuration information for a device.
  */
@@ -246,6 +275,14 @@ typedef struct {
 	u8 MaxBanks;			/**< Max banks in a GPIO device */
         u32 PmcGpio;                    /**< Flag for accessing PS GPIO for versal*/
 	u32 CoreIntrMask[XGPIOPS_MAX_BANKS_CNT]; /**< Interrupt mask per core */
+	XGpioPs_PinEntry *PinTable;	/**< Per pin handlers, MaxPinNum
+					  *  entries, or NULL */
+	u8 BankPinBase[XGPIOPS_MAX_BANKS_CNT]; /**< First pin of each bank */
+	XGpioPs_Edge *EdgeRing;		/**< Edge time stamps, or NULL */
+	u32 EdgeRingMask;		/**< Ring entries - 1 */
+	volatile u32 EdgeHead;		/**< Edges written by the handler */
+	volatile u32 EdgeTail;		/**< Edges read by XGpioPs_GetEdge */
+	u32 EdgeDropped;		/**< Edges lost to a full ring */
 } XGpioPs;
 
 /************************** Variable Definitions *****************************/
@@ -297,6 +334,13 @@ void XGpioPs_GetIntrType(const XGpioPs *InstancePtr, u8 Bank, u32 *IntrType,
 void XGpioPs_SetCallbackHandler(XGpioPs *InstancePtr, void *CallBackRef,
 			     XGpioPs_Handler FuncPointer);
 void XGpioPs_IntrHandler(const XGpioPs *InstancePtr);
+void XGpioPs_IntrPinHandler(XGpioPs *InstancePtr);
+void XGpioPs_SetPinHandlerTable(XGpioPs *InstancePtr, XGpioPs_PinEntry *Table);
+void XGpioPs_SetPinHandler(XGpioPs *InstancePtr, u32 Pin,
+			   XGpioPs_PinHandler FuncPointer, void *CallBackRef);
+void XGpioPs_SetEdgeRing(XGpioPs *InstancePtr, XGpioPs_Edge *Ring,
+			 u32 NumEntries);
+s32 XGpioPs_GetEdge(XGpioPs *InstancePtr, XGpioPs_Edge *EdgePtr);
 
 /* Pin APIs in xgpiops_intr.c */
 void XGpioPs_SetIntrTypePin(const XGpioPs *InstancePtr, u32 Pin, u8 IrqType);
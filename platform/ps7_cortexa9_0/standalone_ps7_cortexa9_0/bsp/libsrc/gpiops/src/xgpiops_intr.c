@@ -36,6 +36,8 @@
 * 3.6	sne  06/12/19 Fixed IAR compiler warning.
 * 3.6   sne  08/14/19 Added interrupt handler support on versal.
 * 3.13  gm   03/15/24 Added multi-core interrupt support.
+* 3.15  pt   10/19/26 Added XGpioPs_IntrPinHandler with per pin handlers and
+*                     edge time stamps.
 *
 * </pre>
 *
@@ -44,6 +46,7 @@
 /***************************** Include Files *********************************/
 
 #include "xgpiops.h"
+#include "xtime_l.h"
 
 /************************** Constant Definitions *****************************/
 
@@ -51,6 +54,23 @@
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
+/*
+ * Highest set bit of a non zero mask
+ */
+#if defined (__GNUC__)
+#define XGpioPs_HighBit(Mask)	(31U - (u32)__builtin_clz(Mask))
+#else
+static INLINE u32 XGpioPs_HighBit(u32 Mask)
+{
+	u32 Bit = 31U;
+
+	while ((Mask & ((u32)1 << Bit)) == (u32)0) {
+		Bit--;
+	}
+	return Bit;
+}
+#endif
+
 /************************** Variable Definitions *****************************/
 
 /************************** Function Prototypes ******************************/
@@ -778,4 +798,222 @@ void XGpioPs_IntrHandler(const XGpioPs *InstancePtr)
 		}
 	}
 }
+
+/*****************************************************************************/
+/**
+*
+* This function sets the table of per pin handlers used by
+* XGpioPs_IntrPinHandler. All entries are cleared.
+*
+* @param	InstancePtr is a pointer to the XGpioPs instance.
+* @param	Table is an array of InstancePtr->MaxPinNum entries, it must
+*		stay valid while the interrupts are enabled.
+*
+* @return	None.
+*
+******************************************************************************/
+void XGpioPs_SetPinHandlerTable(XGpioPs *InstancePtr, XGpioPs_PinEntry *Table)
+{
+	u32 Pin;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(Table != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	for (Pin = 0U; Pin < InstancePtr->MaxPinNum; Pin++) {
+		Table[Pin].Handler = NULL;
+		Table[Pin].CallBackRef = NULL;
+	}
+
+	InstancePtr->PinTable = Table;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets the handler of a pin. Pins without a handler are
+* reported to the bank handler set by XGpioPs_SetCallbackHandler().
+*
+* @param	InstancePtr is a pointer to the XGpioPs instance.
+* @param	Pin is the pin number in the GPIO device.
+* @param	FuncPointer is the handler, NULL to remove it.
+* @param	CallBackRef is passed back to the handler.
+*
+* @return	None.
+*
+* @note		XGpioPs_SetPinHandlerTable() must be called first.
+*
+******************************************************************************/
+void XGpioPs_SetPinHandler(XGpioPs *InstancePtr, u32 Pin,
+			   XGpioPs_PinHandler FuncPointer, void *CallBackRef)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->PinTable != NULL);
+	Xil_AssertVoid(Pin < InstancePtr->MaxPinNum);
+
+	InstancePtr->PinTable[Pin].Handler = NULL;
+	InstancePtr->PinTable[Pin].CallBackRef = CallBackRef;
+	InstancePtr->PinTable[Pin].Handler = FuncPointer;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets the ring XGpioPs_IntrPinHandler records the edges in,
+* with the global timer count at the time they were handled.
+*
+* @param	InstancePtr is a pointer to the XGpioPs instance.
+* @param	Ring is an array of NumEntries entries, NULL to stop recording.
+* @param	NumEntries is a power of two.
+*
+* @return	None.
+*
+******************************************************************************/
+void XGpioPs_SetEdgeRing(XGpioPs *InstancePtr, XGpioPs_Edge *Ring,
+			 u32 NumEntries)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid((Ring == NULL) ||
+		       ((NumEntries != (u32)0) &&
+			((NumEntries & (NumEntries - (u32)1)) == (u32)0)));
+
+	InstancePtr->EdgeRing = NULL;
+	InstancePtr->EdgeHead = 0U;
+	InstancePtr->EdgeTail = 0U;
+	InstancePtr->EdgeDropped = 0U;
+	InstancePtr->EdgeRingMask = NumEntries - (u32)1;
+	InstancePtr->EdgeRing = Ring;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function takes the oldest edge from the edge ring.
+*
+* @param	InstancePtr is a pointer to the XGpioPs instance.
+* @param	EdgePtr returns the edge.
+*
+* @return	XST_SUCCESS if an edge is returned, XST_NO_DATA otherwise.
+*
+* @note		The ring has a single reader, edges that do not fit in the ring
+*		are counted in InstancePtr->EdgeDropped.
+*
+******************************************************************************/
+s32 XGpioPs_GetEdge(XGpioPs *InstancePtr, XGpioPs_Edge *EdgePtr)
+{
+	u32 Tail;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(EdgePtr != NULL);
+
+	Tail = InstancePtr->EdgeTail;
+	if ((InstancePtr->EdgeRing == NULL) || (Tail == InstancePtr->EdgeHead)) {
+		return (s32)XST_NO_DATA;
+	}
+
+	*EdgePtr = InstancePtr->EdgeRing[Tail & InstancePtr->EdgeRingMask];
+	InstancePtr->EdgeTail = Tail + (u32)1;
+
+	return (s32)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is an interrupt handler for GPIO interrupts that dispatches
+* to a handler per pin, to be connected instead of XGpioPs_IntrHandler.
+*
+* Banks without interrupts enabled by this core are skipped without
+* touching the hardware, and the enabled pins are taken from
+* CoreIntrMask instead of the mask register, so only the status register of
+* the active banks is read. The set status bits are walked from the highest
+* one down. Each pin with a handler in the table set by
+* XGpioPs_SetPinHandlerTable() gets its own call, the other pins of the bank
+* go to the bank handler in one call as with XGpioPs_IntrHandler. If an edge
+* ring is set, each pin is also recorded in it with one global timer count
+* taken when the first pin is found.
+*
+* @param	InstancePtr is a pointer to the XGpioPs instance.
+*
+* @return	None.
+*
+* @note		Pin interrupts must be enabled and disabled with the driver
+*		APIs, which keep CoreIntrMask up to date.
+*
+******************************************************************************/
+void XGpioPs_IntrPinHandler(XGpioPs *InstancePtr)
+{
+	u8 Bank;
+	u32 Mask;
+	u32 Rest;
+	u32 Bit;
+	u32 Pin;
+	u32 Head;
+	XTime Now = 0;
+	u32 HaveTime = 0U;
+	XGpioPs_PinEntry *Entry;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	for (Bank = 0U; Bank < InstancePtr->MaxBanks; Bank++) {
+		if (InstancePtr->CoreIntrMask[Bank] == (u32)0) {
+			continue;
+		}
+
+		Mask = XGpioPs_ReadReg(InstancePtr->GpioConfig.BaseAddr,
+				       ((u32)(Bank) * XGPIOPS_REG_MASK_OFFSET) +
+				       XGPIOPS_INTSTS_OFFSET);
+		Mask &= InstancePtr->CoreIntrMask[Bank];
+		if (Mask == (u32)0) {
+			continue;
+		}
+
+		XGpioPs_WriteReg(InstancePtr->GpioConfig.BaseAddr,
+				 ((u32)(Bank) * XGPIOPS_REG_MASK_OFFSET) +
+				 XGPIOPS_INTSTS_OFFSET, Mask);
+
+		if ((InstancePtr->EdgeRing != NULL) && (HaveTime == 0U)) {
+			XTime_GetTime(&Now);
+			HaveTime = 1U;
+		}
+
+		Rest = 0U;
+		while (Mask != (u32)0) {
+			Bit = XGpioPs_HighBit(Mask);
+			Mask &= ~((u32)1 << Bit);
+			Pin = (u32)InstancePtr->BankPinBase[Bank] + Bit;
+
+			if (InstancePtr->EdgeRing != NULL) {
+				Head = InstancePtr->EdgeHead;
+				if ((Head - InstancePtr->EdgeTail) >
+				    InstancePtr->EdgeRingMask) {
+					InstancePtr->EdgeDropped++;
+				} else {
+					InstancePtr->EdgeRing[Head &
+						InstancePtr->EdgeRingMask].Time =
+						(u64)Now;
+					InstancePtr->EdgeRing[Head &
+						InstancePtr->EdgeRingMask].Pin = Pin;
+					InstancePtr->EdgeHead = Head + (u32)1;
+				}
+			}
+
+			Entry = NULL;
+			if (InstancePtr->PinTable != NULL) {
+				Entry = &InstancePtr->PinTable[Pin];
+			}
+			if ((Entry != NULL) && (Entry->Handler != NULL)) {
+				Entry->Handler(Entry->CallBackRef, Pin);
+			} else {
+				Rest |= (u32)1 << Bit;
+			}
+		}
+
+		if (Rest != (u32)0) {
+			InstancePtr->Handler(InstancePtr->CallBackRef, Bank,
+					     Rest);
+		}
+	}
+}
 /** @} */
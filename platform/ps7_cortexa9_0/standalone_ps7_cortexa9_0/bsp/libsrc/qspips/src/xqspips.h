@@ -273,6 +273,9 @@
 * 3.8	akm 09/02/20 Updated the Makefile to support parallel make execution.
 * 3.11	akm 07/10/23 Update the driver to support for system device-tree flow.
 * 3.12	sb  02/20/24 Add missing parenthesis for macro expansions.
+* 3.13	pt  10/19/26 Added the interrupt driven flash service in
+*		     xqspips_flash.c.
+*       pt  10/19/26 Added the log structured store in xqspips_store.c.
 *
 * </pre>
 *
@@ -461,6 +464,58 @@ extern "C" {
 
 /*@}*/
 
+/** @name Flash service settings
+ * The flash service in xqspips_flash.c drives a single flash with 3 byte
+ * addresses, XQSPIPS_FLASH_PAGE_SIZE byte pages and sectors of
+ * XQSPIPS_FLASH_SECTOR_SIZE bytes erased with XQSPIPS_FLASH_OPCODE_SE.
+ * @{
+ */
+#ifndef XQSPIPS_FLASH_QUEUE_LEN
+#define XQSPIPS_FLASH_QUEUE_LEN		16U /**< Request slots */
+#endif
+#ifndef XQSPIPS_FLASH_APPEND_BUFS
+#define XQSPIPS_FLASH_APPEND_BUFS	4U  /**< Page buffers of the log
+					      *  writer, at most 32 */
+#endif
+#ifndef XQSPIPS_FLASH_SECTOR_SIZE
+#define XQSPIPS_FLASH_SECTOR_SIZE	0x10000U /**< Erase sector */
+#endif
+#define XQSPIPS_FLASH_PAGE_SIZE		256U /**< Program page */
+#define XQSPIPS_FLASH_ADDR_LIMIT	0x1000000U /**< 3 byte addresses */
+#define XQSPIPS_FLASH_CMD_LEN		4U  /**< Instruction and address */
+#define XQSPIPS_FLASH_READ_OVERHEAD	5U  /**< Instruction, address and
+					      *  the fast read dummy byte */
+#define XQSPIPS_FLASH_SR_WIP_MASK	0x01U /**< Write in progress */
+
+/*@}*/
+
+/** @name Log store settings
+ * The store in xqspips_store.c keeps up to XQSPIPS_STORE_MAX_KEYS values of
+ * up to XQSPIPS_STORE_MAX_VALUE bytes in up to XQSPIPS_STORE_MAX_SECTORS
+ * flash sectors. One sector is kept free for garbage collection. A sector
+ * that is erased XQSPIPS_STORE_WEAR_DELTA times more than the least worn
+ * one makes the store move the data of the least worn sector.
+ * @{
+ */
+#ifndef XQSPIPS_STORE_MAX_SECTORS
+#define XQSPIPS_STORE_MAX_SECTORS	64U
+#endif
+#ifndef XQSPIPS_STORE_MAX_KEYS
+#define XQSPIPS_STORE_MAX_KEYS		128U
+#endif
+#ifndef XQSPIPS_STORE_MAX_VALUE
+#define XQSPIPS_STORE_MAX_VALUE		256U
+#endif
+#ifndef XQSPIPS_STORE_WEAR_DELTA
+#define XQSPIPS_STORE_WEAR_DELTA	32U
+#endif
+#define XQSPIPS_STORE_REC_HDR		12U /**< Key, length and CRC */
+#define XQSPIPS_STORE_IO_LEN		512U /**< Bytes read per scan step,
+					       *  more than the largest
+					       *  record */
+
+/*@}*/
+
 /**************************** Type Definitions *******************************/
 /**
  * The handler data type allows the user to define a callback function to
@@ -526,6 +581,140 @@ typedef struct {
 				   */
 } XQspiPs;
 
+/**
+ * Token of a flash service request, 0 is never a valid token
+ */
+typedef u32 XQspiPs_FlashToken;
+
+/**
+ * A page program command: instruction and address followed by the data,
+ * word aligned for XQspiPs_Transfer()
+ */
+typedef struct {
+	u32 Buf[(XQSPIPS_FLASH_CMD_LEN + XQSPIPS_FLASH_PAGE_SIZE) / 4U];
+				/**< Command and data */
+	u32 Addr;		/**< Flash address of the data */
+	u32 Len;		/**< Bytes of data */
+} XQspiPs_FlashPage;
+
+/**
+ * A request of the flash service
+ */
+typedef struct {
+	volatile XQspiPs_FlashToken Token; /**< Token, 0 if the slot is free */
+	u8 Op;			/**< XQSPIPS_FLASH_OP_* in xqspips_flash.c */
+	u8 IsAhead;		/**< Erase ahead of the log writer */
+	u8 Report;		/**< 1 to queue the token when done */
+	u32 Addr;		/**< Flash address */
+	u8 *Buf;		/**< Read buffer or program data */
+	u32 Length;		/**< Bytes of the request */
+	u32 Staged;		/**< Program bytes copied to the stage */
+	u32 Done;		/**< Bytes done */
+	XQspiPs_FlashPage *Page; /**< Page of the log writer */
+	u64 SubmitTime;		/**< Global timer at submit */
+} XQspiPs_FlashReq;
+
+/**
+ * The flash service queues reads, page programs and sector erases and runs
+ * them from the QSPI interrupt, with the write in progress bit polled from
+ * XQspiPs_FlashTick().
+ */
+typedef struct {
+	XQspiPs *QspiInst;		/**< QSPI instance */
+	volatile u32 State;		/**< Step of the current request */
+	XQspiPs_FlashReq *CurReq;	/**< Request in progress */
+	u32 OpAddr;			/**< Page or sector in progress */
+	u32 OpLen;			/**< Bytes of OpAddr in progress */
+	XQspiPs_FlashPage *OpPage;	/**< Page being programmed */
+	XQspiPs_FlashPage Stage[2];	/**< Pages of a program request,
+					  *  the next one is copied while the
+					  *  current one programs */
+	u32 StageHead;			/**< Next stage page to fill */
+	u32 StageCount;			/**< Filled stage pages */
+	u32 CmdBuf;			/**< WREN, SE and RDSR commands */
+	u32 SrBuf;			/**< RDSR response */
+	XQspiPs_FlashToken NextToken;	/**< Token of the next request */
+	XQspiPs_FlashReq Req[XQSPIPS_FLASH_QUEUE_LEN]; /**< Request slots */
+	XQspiPs_FlashToken DoneQueue[XQSPIPS_FLASH_QUEUE_LEN]; /**< Tokens
+							     *  of finished
+							     *  requests */
+	volatile u32 DoneHead;		/**< Completions queued */
+	volatile u32 DoneTail;		/**< Completions taken */
+	XQspiPs_FlashPage AppendPage[XQSPIPS_FLASH_APPEND_BUFS]; /**< Pages
+							     *  of the log
+							     *  writer */
+	volatile u32 AppendBusy;	/**< Pages filling or queued */
+	XQspiPs_FlashPage *AppendOpen;	/**< Page being filled */
+	u32 AppendAddr;			/**< Next log address */
+	u32 AppendEnd;			/**< End of the log region */
+	u32 ErasedEnd;			/**< End of the erased or queued for
+					  *  erase part of the region */
+	u32 EraseAhead;			/**< Sectors erased ahead */
+	XQspiPs_FlashToken AppendToken;	/**< Last log page queued */
+	XQspiPs_FlashToken ErrorToken;	/**< Last request that failed */
+	u32 Reads;			/**< Read requests done */
+	u32 Pages;			/**< Pages programmed */
+	u32 Erases;			/**< Sectors erased */
+	u32 WipPolls;			/**< Status register reads */
+	u32 Errors;			/**< Requests that failed */
+	u32 DoneDropped;		/**< Completions lost to a full queue */
+	u64 MaxLatency;			/**< Longest submit to done time in
+					  *  global timer counts */
+} XQspiPs_Flash;
+
+/**
+ * An index entry of the log store
+ */
+typedef struct {
+	u32 Key;		/**< Key */
+	u32 Addr;		/**< Flash address of the record */
+	u32 Len;		/**< Bytes of the value */
+} XQspiPs_StoreEntry;
+
+/**
+ * A sector of the log store
+ */
+typedef struct {
+	u32 Seq;		/**< Order in which the sectors were written */
+	u32 EraseCount;		/**< Erases of the sector */
+	u32 Live;		/**< Bytes of live PUT records */
+	u32 Used;		/**< Write offset, the sector size when full */
+	u32 State;		/**< Free, dirty or used */
+} XQspiPs_StoreSector;
+
+/**
+ * The log store keeps values by key in flash sectors written as a log, with
+ * an index in RAM that is rebuilt from the records by
+ * XQspiPs_StoreMount().
+ */
+typedef struct {
+	XQspiPs_Flash *FlashPtr;	/**< Flash service */
+	u32 BaseAddr;			/**< Flash address of the first
+					  *  sector */
+	u32 SectorCount;		/**< Sectors of the store */
+	u32 Active;			/**< Sector being written */
+	u32 NextSeq;			/**< Seq of the next sector */
+	u32 IsOldest;			/**< Collected sector is the oldest */
+	u32 InGc;			/**< A collection is running */
+	XQspiPs_StoreSector Sector[XQSPIPS_STORE_MAX_SECTORS]; /**< Sectors */
+	XQspiPs_StoreEntry Index[XQSPIPS_STORE_MAX_KEYS]; /**< Index sorted
+							    *  by key */
+	u32 KeyCount;			/**< Entries in the index */
+	u32 IoBuf[(XQSPIPS_FLASH_READ_OVERHEAD + XQSPIPS_STORE_IO_LEN +
+		   3U) / 4U];		/**< Read buffer */
+	u32 RecBuf[(XQSPIPS_STORE_REC_HDR + XQSPIPS_STORE_MAX_VALUE +
+		    3U) / 4U];		/**< Record being written */
+	u32 UserBytes;			/**< Value bytes written by the user */
+	u32 FlashBytes;			/**< Bytes programmed, the write
+					  *  amplification is
+					  *  FlashBytes / UserBytes */
+	u32 Erases;			/**< Sectors erased */
+	u32 GcRuns;			/**< Sectors collected */
+	u32 WearMoves;			/**< Collections for wear leveling */
+	u64 MountCounts;		/**< Mount time in global timer
+					  *  counts */
+} XQspiPs_Store;
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /****************************************************************************/
@@ -797,6 +986,43 @@ int XQspiPs_SetDelays(XQspiPs *InstancePtr, u8 DelayNss, u8 DelayBtwn,
 		      u8 DelayAfter, u8 DelayInit);
 void XQspiPs_GetDelays(XQspiPs *InstancePtr, u8 *DelayNss, u8 *DelayBtwn,
 		       u8 *DelayAfter, u8 *DelayInit);
+
+/*
+ * Flash service functions, in xqspips_flash.c
+ */
+int XQspiPs_FlashInitialize(XQspiPs_Flash *FlashPtr, XQspiPs *InstancePtr);
+int XQspiPs_FlashRead(XQspiPs_Flash *FlashPtr, u32 Address, u8 *BufPtr,
+		      u32 ByteCount, XQspiPs_FlashToken *TokenPtr);
+int XQspiPs_FlashProgram(XQspiPs_Flash *FlashPtr, u32 Address,
+			 const u8 *DataPtr, u32 ByteCount,
+			 XQspiPs_FlashToken *TokenPtr);
+int XQspiPs_FlashErase(XQspiPs_Flash *FlashPtr, u32 Address,
+		       u32 ByteCount, XQspiPs_FlashToken *TokenPtr);
+int XQspiPs_FlashSetAppend(XQspiPs_Flash *FlashPtr, u32 StartAddr,
+			   u32 EndAddr, u32 EraseAhead);
+int XQspiPs_FlashAppend(XQspiPs_Flash *FlashPtr, const void *DataPtr,
+			u32 ByteCount);
+int XQspiPs_FlashAppendFlush(XQspiPs_Flash *FlashPtr,
+			     XQspiPs_FlashToken *TokenPtr);
+void XQspiPs_FlashTick(XQspiPs_Flash *FlashPtr);
+int XQspiPs_FlashIsDone(XQspiPs_Flash *FlashPtr, XQspiPs_FlashToken Token);
+int XQspiPs_FlashWait(XQspiPs_Flash *FlashPtr, XQspiPs_FlashToken Token,
+		      u32 TimeoutUs);
+int XQspiPs_FlashGetDone(XQspiPs_Flash *FlashPtr,
+			 XQspiPs_FlashToken *TokenPtr);
+
+/*
+ * Log store functions, in xqspips_store.c
+ */
+int XQspiPs_StoreFormat(XQspiPs_Store *StorePtr, XQspiPs_Flash *FlashPtr,
+			u32 BaseAddr, u32 SectorCount);
+int XQspiPs_StoreMount(XQspiPs_Store *StorePtr, XQspiPs_Flash *FlashPtr,
+		       u32 BaseAddr, u32 SectorCount);
+int XQspiPs_StorePut(XQspiPs_Store *StorePtr, u32 Key, const void *DataPtr,
+		     u32 ByteCount);
+int XQspiPs_StoreGet(XQspiPs_Store *StorePtr, u32 Key, void *BufPtr,
+		     u32 BufLen, u32 *ByteCountPtr);
+int XQspiPs_StoreDelete(XQspiPs_Store *StorePtr, u32 Key);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,1159 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xqspips_flash.c
+* @addtogroup qspips Overview
+* @{
+*
+* This file contains an interrupt driven flash service on top of
+* XQspiPs_Transfer() and XQspiPs_InterruptHandler().
+*
+* XQspiPs_FlashRead(), XQspiPs_FlashProgram() and XQspiPs_FlashErase()
+* queue a request and return a token. The requests run one after the other
+* from the QSPI status handler: write enable, then the page program or
+* sector erase command. While the flash is busy the service does not spin,
+* the write in progress bit is read by XQspiPs_FlashTick(), which is called
+* periodically from a timer interrupt or the main loop, and the next step
+* starts from the interrupt of that status read. While a page programs, the
+* next page of the request is copied to the second stage buffer, so it is
+* sent as soon as the flash is ready.
+*
+* For sequential logging XQspiPs_FlashAppend() copies the data to page
+* buffers of its own and queues each full page, XQspiPs_FlashAppendFlush()
+* queues a partial page. The sectors of the log are erased EraseAhead
+* sectors ahead of the data: these erases give way to later requests that
+* do not touch the sector, so they run in the idle time of the flash
+* rather than when the writer reaches the sector.
+*
+* A finished request is put in the completion queue, taken with
+* XQspiPs_FlashGetDone(). XQspiPs_FlashIsDone() and XQspiPs_FlashWait()
+* check a given token.
+*
+* The service owns the QSPI instance: the interrupt of the controller must
+* be connected to XQspiPs_InterruptHandler() and the instance must not be
+* used for anything else. Options and clock prescaler are set by the caller
+* before XQspiPs_FlashInitialize(). Only the single flash connection mode
+* is supported.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 3.13  pt  10/19/26 First release
+*       pt  10/19/26 Pad the last word of a page program with 0xFF
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+
+#include "xqspips.h"
+#include "xpseudo_asm.h"
+#include "xreg_cortexa9.h"
+#include "xtime_l.h"
+#include "sleep.h"
+
+/************************** Constant Definitions *****************************/
+
+/*
+ * Request types
+ */
+#define XQSPIPS_FLASH_OP_READ		0U
+#define XQSPIPS_FLASH_OP_PROGRAM	1U
+#define XQSPIPS_FLASH_OP_ERASE		2U
+#define XQSPIPS_FLASH_OP_APPEND		3U /* page of the log writer */
+
+/*
+ * Steps of the request in progress
+ */
+#define XQSPIPS_FLASH_IDLE		0U /* nothing sent */
+#define XQSPIPS_FLASH_WREN		1U /* write enable sent */
+#define XQSPIPS_FLASH_CMD		2U /* read, program or erase sent */
+#define XQSPIPS_FLASH_WIP		3U /* waiting for the next tick */
+#define XQSPIPS_FLASH_RDSR		4U /* status register read sent */
+
+/**************************** Type Definitions *******************************/
+
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/* Tokens are compared modulo 2^32 */
+#define XQSPIPS_FLASH_BEFORE(A, B)	((s32)((A) - (B)) < 0)
+
+/************************** Function Prototypes ******************************/
+
+static void XQspiPs_FlashStatusHandler(void *CallBackRef, u32 StatusEvent,
+				       unsigned ByteCount);
+static int XQspiPs_FlashSubmit(XQspiPs_Flash *FlashPtr, u8 Op, u32 Addr,
+			       u8 *BufPtr, u32 Length, u8 IsAhead,
+			       XQspiPs_FlashPage *Page,
+			       XQspiPs_FlashToken *TokenPtr);
+static XQspiPs_FlashReq *XQspiPs_FlashSelect(XQspiPs_Flash *FlashPtr);
+static void XQspiPs_FlashRun(XQspiPs_Flash *FlashPtr);
+static int XQspiPs_FlashStartOp(XQspiPs_Flash *FlashPtr);
+static void XQspiPs_FlashStage(XQspiPs_Flash *FlashPtr);
+static void XQspiPs_FlashComplete(XQspiPs_Flash *FlashPtr, int Status);
+static void XQspiPs_FlashQueuePage(XQspiPs_Flash *FlashPtr);
+
+/************************** Variable Definitions *****************************/
+
+
+/****************************************************************************/
+/**
+*
+* Masks IRQs, the service state is shared with the QSPI interrupt and the
+* tick.
+*
+* @return	The CPSR to restore.
+*
+*****************************************************************************/
+static INLINE u32 XQspiPs_FlashLock(void)
+{
+	u32 Cpsr = mfcpsr();
+
+	mtcpsr(Cpsr | XREG_CPSR_IRQ_ENABLE);
+
+	return Cpsr;
+}
+
+/****************************************************************************/
+/**
+*
+* Restores the IRQ mask saved by XQspiPs_FlashLock().
+*
+* @param	Cpsr is the CPSR returned by XQspiPs_FlashLock().
+*
+*****************************************************************************/
+static INLINE void XQspiPs_FlashUnlock(u32 Cpsr)
+{
+	mtcpsr(Cpsr);
+}
+
+/****************************************************************************/
+/**
+*
+* Writes an instruction with a 3 byte address.
+*
+* @param	CmdPtr is the command buffer.
+* @param	OpCode is the instruction.
+* @param	Addr is the flash address.
+*
+*****************************************************************************/
+static INLINE void XQspiPs_FlashSetCmd(u8 *CmdPtr, u8 OpCode, u32 Addr)
+{
+	CmdPtr[0] = OpCode;
+	CmdPtr[1] = (u8)(Addr >> 16);
+	CmdPtr[2] = (u8)(Addr >> 8);
+	CmdPtr[3] = (u8)Addr;
+}
+
+/****************************************************************************/
+/**
+*
+* Fills the last word of a page program with 0xFF. XQspiPs_Transfer() sends
+* whole words, so the bytes after the data are programmed too, and 0xFF
+* leaves the flash as it is.
+*
+* @param	Page is the page program command, with its Len set.
+*
+*****************************************************************************/
+static INLINE void XQspiPs_FlashPad(XQspiPs_FlashPage *Page)
+{
+	u32 End = XQSPIPS_FLASH_CMD_LEN + Page->Len;
+
+	memset((u8 *)Page->Buf + End, 0xFF, ((End + 3U) & ~3U) - End);
+}
+
+/****************************************************************************/
+/**
+*
+* Initializes a flash service and takes over the status handler of the
+* QSPI instance.
+*
+* @param	FlashPtr is the flash service.
+* @param	InstancePtr is an initialized QSPI instance, with its options
+*		and clock prescaler set.
+*
+* @return
+*		- XST_SUCCESS on success
+*		- XST_FAILURE if the flash is not in the single connection
+*		  mode
+*
+*****************************************************************************/
+int XQspiPs_FlashInitialize(XQspiPs_Flash *FlashPtr, XQspiPs *InstancePtr)
+{
+	Xil_AssertNonvoid(FlashPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (InstancePtr->Config.ConnectionMode !=
+	    XQSPIPS_CONNECTION_MODE_SINGLE) {
+		return XST_FAILURE;
+	}
+
+	memset(FlashPtr, 0, sizeof(XQspiPs_Flash));
+	FlashPtr->QspiInst = InstancePtr;
+	FlashPtr->NextToken = 1U;
+
+	XQspiPs_SetStatusHandler(InstancePtr, FlashPtr,
+				 XQspiPs_FlashStatusHandler);
+
+	return XQspiPs_SetSlaveSelect(InstancePtr);
+}
+
+/****************************************************************************/
+/**
+*
+* Queues a read of ByteCount bytes at Address.
+*
+* @param	FlashPtr is the flash service.
+* @param	Address is the flash address.
+* @param	BufPtr is a buffer of ByteCount + XQSPIPS_FLASH_READ_OVERHEAD
+*		bytes. The command is sent from its start and the data is
+*		received at BufPtr + XQSPIPS_FLASH_READ_OVERHEAD.
+* @param	ByteCount is the number of bytes to read.
+* @param	TokenPtr returns the token of the request.
+*
+* @return
+*		- XST_SUCCESS if the request is queued
+*		- XST_INVALID_PARAM if the range is empty or beyond
+*		  XQSPIPS_FLASH_ADDR_LIMIT
+*		- XST_DEVICE_BUSY if all XQSPIPS_FLASH_QUEUE_LEN request slots
+*		  are in use
+*
+* @note		The buffer must not be accessed until the request is done.
+*
+*****************************************************************************/
+int XQspiPs_FlashRead(XQspiPs_Flash *FlashPtr, u32 Address, u8 *BufPtr,
+		      u32 ByteCount, XQspiPs_FlashToken *TokenPtr)
+{
+	u32 Cpsr;
+	int Status;
+
+	Xil_AssertNonvoid(FlashPtr != NULL);
+	Xil_AssertNonvoid(BufPtr != NULL);
+	Xil_AssertNonvoid(TokenPtr != NULL);
+
+	if ((ByteCount == 0U) || (Address >= XQSPIPS_FLASH_ADDR_LIMIT) ||
+	    (ByteCount > (XQSPIPS_FLASH_ADDR_LIMIT - Address))) {
+		return XST_INVALID_PARAM;
+	}
+
+	Cpsr = XQspiPs_FlashLock();
+	Status = XQspiPs_FlashSubmit(FlashPtr, XQSPIPS_FLASH_OP_READ, Address,
+				     BufPtr, ByteCount, 0U, NULL, TokenPtr);
+	XQspiPs_FlashUnlock(Cpsr);
+
+	return Status;
+}
+
+/****************************************************************************/
+/**
+*
+* Queues a program of ByteCount bytes at Address, split in page programs.
+*
+* @param	FlashPtr is the flash service.
+* @param	Address is the flash address, it must be erased.
+* @param	DataPtr is the data.
+* @param	ByteCount is the number of bytes to program.
+* @param	TokenPtr returns the token of the request.
+*
+* @return
+*		- XST_SUCCESS if the request is queued
+*		- XST_INVALID_PARAM if the range is empty or beyond
+*		  XQSPIPS_FLASH_ADDR_LIMIT
+*		- XST_DEVICE_BUSY if all XQSPIPS_FLASH_QUEUE_LEN request slots
+*		  are in use
+*
+* @note		The data is copied page by page while the request runs, it
+*		must not change until the request is done.
+*
+*****************************************************************************/
+int XQspiPs_FlashProgram(XQspiPs_Flash *FlashPtr, u32 Address,
+			 const u8 *DataPtr, u32 ByteCount,
+			 XQspiPs_FlashToken *TokenPtr)
+{
+	u32 Cpsr;
+	int Status;
+
+	Xil_AssertNonvoid(FlashPtr != NULL);
+	Xil_AssertNonvoid(DataPtr != NULL);
+	Xil_AssertNonvoid(TokenPtr != NULL);
+
+	if ((ByteCount == 0U) || (Address >= XQSPIPS_FLASH_ADDR_LIMIT) ||
+	    (ByteCount > (XQSPIPS_FLASH_ADDR_LIMIT - Address))) {
+		return XST_INVALID_PARAM;
+	}
+
+	Cpsr = XQspiPs_FlashLock();
+	Status = XQspiPs_FlashSubmit(FlashPtr, XQSPIPS_FLASH_OP_PROGRAM,
+				     Address, (u8 *)DataPtr, ByteCount, 0U,
+				     NULL, TokenPtr);
+	XQspiPs_FlashUnlock(Cpsr);
+
+	return Status;
+}
+
+/****************************************************************************/
+/**
+*
+* Queues the erase of the sectors from Address to Address + ByteCount.
+*
+* @param	FlashPtr is the flash service.
+* @param	Address is the flash address, a multiple of
+*		XQSPIPS_FLASH_SECTOR_SIZE.
+* @param	ByteCount is a multiple of XQSPIPS_FLASH_SECTOR_SIZE.
+* @param	TokenPtr returns the token of the request.
+*
+* @return
+*		- XST_SUCCESS if the request is queued
+*		- XST_INVALID_PARAM if the range is empty, not sector aligned
+*		  or beyond XQSPIPS_FLASH_ADDR_LIMIT
+*		- XST_DEVICE_BUSY if all XQSPIPS_FLASH_QUEUE_LEN request slots
+*		  are in use
+*
+*****************************************************************************/
+int XQspiPs_FlashErase(XQspiPs_Flash *FlashPtr, u32 Address,
+		       u32 ByteCount, XQspiPs_FlashToken *TokenPtr)
+{
+	u32 Cpsr;
+	int Status;
+
+	Xil_AssertNonvoid(FlashPtr != NULL);
+	Xil_AssertNonvoid(TokenPtr != NULL);
+
+	if ((ByteCount == 0U) || (Address >= XQSPIPS_FLASH_ADDR_LIMIT) ||
+	    (ByteCount > (XQSPIPS_FLASH_ADDR_LIMIT - Address)) ||
+	    ((Address % XQSPIPS_FLASH_SECTOR_SIZE) != 0U) ||
+	    ((ByteCount % XQSPIPS_FLASH_SECTOR_SIZE) != 0U)) {
+		return XST_INVALID_PARAM;
+	}
+
+	Cpsr = XQspiPs_FlashLock();
+	Status = XQspiPs_FlashSubmit(FlashPtr, XQSPIPS_FLASH_OP_ERASE,
+				     Address, NULL, ByteCount, 0U, NULL,
+				     TokenPtr);
+	XQspiPs_FlashUnlock(Cpsr);
+
+	return Status;
+}
+
+/****************************************************************************/
+/**
+*
+* Sets the flash region of the log writer.
+*
+* @param	FlashPtr is the flash service.
+* @param	StartAddr is the next log address. If it is not at the start of
+*		a sector, the rest of its sector is taken as erased, as when
+*		an existing log is continued.
+* @param	EndAddr is the end of the region, a multiple of
+*		XQSPIPS_FLASH_SECTOR_SIZE.
+* @param	EraseAhead is the number of sectors kept erased, or queued
+*		for erase, beyond the sector being written.
+*
+* @return
+*		- XST_SUCCESS on success
+*		- XST_INVALID_PARAM if the region is not valid
+*		- XST_DEVICE_BUSY if log pages are still queued
+*
+*****************************************************************************/
+int XQspiPs_FlashSetAppend(XQspiPs_Flash *FlashPtr, u32 StartAddr,
+			   u32 EndAddr, u32 EraseAhead)
+{
+	u32 Cpsr;
+
+	Xil_AssertNonvoid(FlashPtr != NULL);
+
+	if ((StartAddr > EndAddr) || (EndAddr > XQSPIPS_FLASH_ADDR_LIMIT) ||
+	    ((EndAddr % XQSPIPS_FLASH_SECTOR_SIZE) != 0U)) {
+		return XST_INVALID_PARAM;
+	}
+
+	Cpsr = XQspiPs_FlashLock();
+	if (FlashPtr->AppendBusy != 0U) {
+		XQspiPs_FlashUnlock(Cpsr);
+		return XST_DEVICE_BUSY;
+	}
+
+	FlashPtr->AppendAddr = StartAddr;
+	FlashPtr->AppendEnd = EndAddr;
+	FlashPtr->ErasedEnd = (StartAddr + XQSPIPS_FLASH_SECTOR_SIZE - 1U) &
+			      ~(XQSPIPS_FLASH_SECTOR_SIZE - 1U);
+	FlashPtr->EraseAhead = EraseAhead;
+	XQspiPs_FlashUnlock(Cpsr);
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* Appends data to the log. The data is copied to the page buffers of the
+* log writer, full pages are queued for programming and the sectors ahead
+* are queued for erase.
+*
+* @param	FlashPtr is the flash service.
+* @param	DataPtr is the data.
+* @param	ByteCount is the number of bytes.
+*
+* @return
+*		- XST_SUCCESS if all the data is taken
+*		- XST_BUFFER_TOO_SMALL if the data does not fit in the rest
+*		  of the region
+*		- XST_DEVICE_BUSY if there are not enough free page buffers or
+*		  request slots, no data is taken then
+*
+*****************************************************************************/
+int XQspiPs_FlashAppend(XQspiPs_Flash *FlashPtr, const void *DataPtr,
+			u32 ByteCount)
+{
+	const u8 *Src = (const u8 *)DataPtr;
+	XQspiPs_FlashPage *Page;
+	XQspiPs_FlashToken Token;
+	unsigned int Index;
+	u32 Target;
+	u32 Erases;
+	u32 Closed = 0U;
+	u32 NewPages = 0U;
+	u32 FreePages = 0U;
+	u32 FreeSlots = 0U;
+	u32 IsOpen;
+	u32 Addr;
+	u32 Room;
+	u32 Len;
+	u32 Cpsr;
+
+	Xil_AssertNonvoid(FlashPtr != NULL);
+	Xil_AssertNonvoid((DataPtr != NULL) || (ByteCount == 0U));
+
+	Cpsr = XQspiPs_FlashLock();
+
+	if (ByteCount > (FlashPtr->AppendEnd - FlashPtr->AppendAddr)) {
+		XQspiPs_FlashUnlock(Cpsr);
+		return XST_BUFFER_TOO_SMALL;
+	}
+
+	/* sectors to erase, up to EraseAhead sectors beyond the data */
+	Target = ((FlashPtr->AppendAddr + ByteCount +
+		   XQSPIPS_FLASH_SECTOR_SIZE - 1U) &
+		  ~(XQSPIPS_FLASH_SECTOR_SIZE - 1U)) +
+		 (FlashPtr->EraseAhead * XQSPIPS_FLASH_SECTOR_SIZE);
+	if ((Target > FlashPtr->AppendEnd) ||
+	    (Target < FlashPtr->AppendAddr)) {
+		Target = FlashPtr->AppendEnd;
+	}
+	Erases = 0U;
+	if (Target > FlashPtr->ErasedEnd) {
+		Erases = (Target - FlashPtr->ErasedEnd) /
+			 XQSPIPS_FLASH_SECTOR_SIZE;
+	}
+
+	/* pages that are started and pages that fill up */
+	IsOpen = (FlashPtr->AppendOpen != NULL) ? 1U : 0U;
+	Addr = FlashPtr->AppendAddr;
+	Len = ByteCount;
+	while (Len != 0U) {
+		if (IsOpen == 0U) {
+			NewPages++;
+			IsOpen = 1U;
+		}
+		Room = XQSPIPS_FLASH_PAGE_SIZE -
+		       (Addr % XQSPIPS_FLASH_PAGE_SIZE);
+		if (Room > Len) {
+			Room = Len;
+		} else {
+			Closed++;
+			IsOpen = 0U;
+		}
+		Addr += Room;
+		Len -= Room;
+	}
+
+	for (Index = 0; Index < XQSPIPS_FLASH_APPEND_BUFS; Index++) {
+		if ((FlashPtr->AppendBusy & (1U << Index)) == 0U) {
+			FreePages++;
+		}
+	}
+	for (Index = 0; Index < XQSPIPS_FLASH_QUEUE_LEN; Index++) {
+		if (FlashPtr->Req[Index].Token == 0U) {
+			FreeSlots++;
+		}
+	}
+	if ((NewPages > FreePages) || ((Erases + Closed) > FreeSlots)) {
+		XQspiPs_FlashUnlock(Cpsr);
+		return XST_DEVICE_BUSY;
+	}
+
+	/* the erases go first, the pages of a sector must not pass them */
+	while (Erases != 0U) {
+		(void)XQspiPs_FlashSubmit(FlashPtr, XQSPIPS_FLASH_OP_ERASE,
+					  FlashPtr->ErasedEnd, NULL,
+					  XQSPIPS_FLASH_SECTOR_SIZE, 1U, NULL,
+					  &Token);
+		FlashPtr->ErasedEnd += XQSPIPS_FLASH_SECTOR_SIZE;
+		Erases--;
+	}
+
+	Len = ByteCount;
+	while (Len != 0U) {
+		if (FlashPtr->AppendOpen == NULL) {
+			for (Index = 0; Index < XQSPIPS_FLASH_APPEND_BUFS;
+			     Index++) {
+				if ((FlashPtr->AppendBusy & (1U << Index)) ==
+				    0U) {
+					break;
+				}
+			}
+			Page = &FlashPtr->AppendPage[Index];
+			Page->Addr = FlashPtr->AppendAddr;
+			Page->Len = 0U;
+			FlashPtr->AppendBusy |= 1U << Index;
+			FlashPtr->AppendOpen = Page;
+		}
+		Page = FlashPtr->AppendOpen;
+
+		Room = XQSPIPS_FLASH_PAGE_SIZE -
+		       (FlashPtr->AppendAddr % XQSPIPS_FLASH_PAGE_SIZE);
+		if (Room > Len) {
+			Room = Len;
+		}
+		memcpy((u8 *)Page->Buf + XQSPIPS_FLASH_CMD_LEN + Page->Len,
+		       Src, Room);
+		Page->Len += Room;
+		FlashPtr->AppendAddr += Room;
+		Src += Room;
+		Len -= Room;
+
+		if ((FlashPtr->AppendAddr % XQSPIPS_FLASH_PAGE_SIZE) == 0U) {
+			XQspiPs_FlashQueuePage(FlashPtr);
+		}
+	}
+
+	XQspiPs_FlashUnlock(Cpsr);
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* Queues the partly filled page of the log writer and returns the token of
+* the last log page, which is done when all the data appended so far is
+* programmed.
+*
+* @param	FlashPtr is the flash service.
+* @param	TokenPtr returns the token, 0 if no log page was queued yet.
+*
+* @return
+*		- XST_SUCCESS on success
+*		- XST_DEVICE_BUSY if all XQSPIPS_FLASH_QUEUE_LEN request slots
+*		  are in use
+*
+* @note		The rest of a partly programmed page is filled by the next
+*		XQspiPs_FlashAppend(), with a second page program.
+*
+*****************************************************************************/
+int XQspiPs_FlashAppendFlush(XQspiPs_Flash *FlashPtr,
+			     XQspiPs_FlashToken *TokenPtr)
+{
+	unsigned int Index;
+	u32 Cpsr;
+
+	Xil_AssertNonvoid(FlashPtr != NULL);
+	Xil_AssertNonvoid(TokenPtr != NULL);
+
+	Cpsr = XQspiPs_FlashLock();
+
+	if (FlashPtr->AppendOpen != NULL) {
+		for (Index = 0; Index < XQSPIPS_FLASH_QUEUE_LEN; Index++) {
+			if (FlashPtr->Req[Index].Token == 0U) {
+				break;
+			}
+		}
+		if (Index == XQSPIPS_FLASH_QUEUE_LEN) {
+			XQspiPs_FlashUnlock(Cpsr);
+			return XST_DEVICE_BUSY;
+		}
+		XQspiPs_FlashQueuePage(FlashPtr);
+	}
+
+	*TokenPtr = FlashPtr->AppendToken;
+	XQspiPs_FlashUnlock(Cpsr);
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* Reads the write in progress bit of the flash when a program or erase is
+* running. Call it periodically, from a timer interrupt or the main loop;
+* a page program takes a few hundred microseconds, a sector erase hundreds
+* of milliseconds. The next step of the request starts from the QSPI
+* interrupt of the status read.
+*
+* @param	FlashPtr is the flash service.
+*
+* @return	None.
+*
+*****************************************************************************/
+void XQspiPs_FlashTick(XQspiPs_Flash *FlashPtr)
+{
+	u32 Cpsr;
+	s32 Status;
+
+	Xil_AssertVoid(FlashPtr != NULL);
+
+	Cpsr = XQspiPs_FlashLock();
+	if ((FlashPtr->State == XQSPIPS_FLASH_WIP) &&
+	    (FlashPtr->QspiInst->IsBusy == FALSE)) {
+		FlashPtr->State = XQSPIPS_FLASH_RDSR;
+		FlashPtr->CmdBuf = 0U;
+		*(u8 *)&FlashPtr->CmdBuf = XQSPIPS_FLASH_OPCODE_RDSR1;
+		FlashPtr->WipPolls++;
+		Status = XQspiPs_Transfer(FlashPtr->QspiInst,
+					  (u8 *)&FlashPtr->CmdBuf,
+					  (u8 *)&FlashPtr->SrBuf, 2U);
+		if (Status != XST_SUCCESS) {
+			/* tried again on the next tick */
+			FlashPtr->State = XQSPIPS_FLASH_WIP;
+		}
+	}
+	XQspiPs_FlashUnlock(Cpsr);
+}
+
+/****************************************************************************/
+/**
+*
+* Checks whether a request is done.
+*
+* @param	FlashPtr is the flash service.
+* @param	Token is the token of the request.
+*
+* @return	1 if the request is done, 0 otherwise.
+*
+*****************************************************************************/
+int XQspiPs_FlashIsDone(XQspiPs_Flash *FlashPtr, XQspiPs_FlashToken Token)
+{
+	unsigned int Index;
+
+	Xil_AssertNonvoid(FlashPtr != NULL);
+
+	if (Token == 0U) {
+		return 1;
+	}
+
+	for (Index = 0; Index < XQSPIPS_FLASH_QUEUE_LEN; Index++) {
+		if (FlashPtr->Req[Index].Token == Token) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/****************************************************************************/
+/**
+*
+* Waits until a request is done, reading the write in progress bit every
+* microsecond.
+*
+* @param	FlashPtr is the flash service.
+* @param	Token is the token of the request.
+* @param	TimeoutUs is the longest wait in microseconds.
+*
+* @return
+*		- XST_SUCCESS if the request is done
+*		- XST_FAILURE on time out
+*
+* @note		Whether the request failed is reported by ErrorToken and
+*		Errors in the service.
+*
+*****************************************************************************/
+int XQspiPs_FlashWait(XQspiPs_Flash *FlashPtr, XQspiPs_FlashToken Token,
+		      u32 TimeoutUs)
+{
+	u32 Timeout = TimeoutUs;
+
+	Xil_AssertNonvoid(FlashPtr != NULL);
+
+	while (XQspiPs_FlashIsDone(FlashPtr, Token) == 0) {
+		if (Timeout == 0U) {
+			return XST_FAILURE;
+		}
+		XQspiPs_FlashTick(FlashPtr);
+		usleep(1);
+		Timeout--;
+	}
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* Takes the oldest entry of the completion queue.
+*
+* @param	FlashPtr is the flash service.
+* @param	TokenPtr returns the token of a finished request.
+*
+* @return
+*		- XST_SUCCESS if a token is returned
+*		- XST_NO_DATA if the queue is empty
+*
+* @note		The queue holds XQSPIPS_FLASH_QUEUE_LEN entries, older
+*		completions are dropped and counted in DoneDropped when it
+*		is full. The pages and erases of the log writer are not
+*		queued.
+*
+*****************************************************************************/
+int XQspiPs_FlashGetDone(XQspiPs_Flash *FlashPtr,
+			 XQspiPs_FlashToken *TokenPtr)
+{
+	u32 Cpsr;
+	int Status = XST_NO_DATA;
+
+	Xil_AssertNonvoid(FlashPtr != NULL);
+	Xil_AssertNonvoid(TokenPtr != NULL);
+
+	Cpsr = XQspiPs_FlashLock();
+	if (FlashPtr->DoneTail != FlashPtr->DoneHead) {
+		*TokenPtr = FlashPtr->DoneQueue[FlashPtr->DoneTail %
+						XQSPIPS_FLASH_QUEUE_LEN];
+		FlashPtr->DoneTail++;
+		Status = XST_SUCCESS;
+	}
+	XQspiPs_FlashUnlock(Cpsr);
+
+	return Status;
+}
+
+/****************************************************************************/
+/**
+*
+* Status handler of the QSPI instance, moves the request in progress to
+* its next step. Called from the QSPI interrupt.
+*
+* @param	CallBackRef is the flash service.
+* @param	StatusEvent is the event of the transfer.
+* @param	ByteCount is the number of bytes transferred.
+*
+* @return	None.
+*
+*****************************************************************************/
+static void XQspiPs_FlashStatusHandler(void *CallBackRef, u32 StatusEvent,
+				       unsigned ByteCount)
+{
+	XQspiPs_Flash *FlashPtr = (XQspiPs_Flash *)CallBackRef;
+	XQspiPs_FlashReq *Req = FlashPtr->CurReq;
+	s32 Status = XST_SUCCESS;
+
+	(void)ByteCount;
+
+	if (Req == NULL) {
+		return;
+	}
+
+	if (StatusEvent != XST_SPI_TRANSFER_DONE) {
+		XQspiPs_FlashComplete(FlashPtr, XST_FAILURE);
+		XQspiPs_FlashRun(FlashPtr);
+		return;
+	}
+
+	switch (FlashPtr->State) {
+		case XQSPIPS_FLASH_WREN:
+			FlashPtr->State = XQSPIPS_FLASH_CMD;
+			if (Req->Op == XQSPIPS_FLASH_OP_ERASE) {
+				XQspiPs_FlashSetCmd((u8 *)&FlashPtr->CmdBuf,
+						    XQSPIPS_FLASH_OPCODE_SE,
+						    FlashPtr->OpAddr);
+				Status = XQspiPs_Transfer(FlashPtr->QspiInst,
+						(u8 *)&FlashPtr->CmdBuf, NULL,
+						XQSPIPS_FLASH_CMD_LEN);
+			} else {
+				Status = XQspiPs_Transfer(FlashPtr->QspiInst,
+						(u8 *)FlashPtr->OpPage->Buf,
+						NULL, XQSPIPS_FLASH_CMD_LEN +
+						FlashPtr->OpLen);
+			}
+			break;
+
+		case XQSPIPS_FLASH_CMD:
+			if (Req->Op == XQSPIPS_FLASH_OP_READ) {
+				Req->Done = Req->Length;
+				FlashPtr->Reads++;
+				FlashPtr->State = XQSPIPS_FLASH_IDLE;
+			} else {
+				/* copy the next page while this one programs */
+				FlashPtr->State = XQSPIPS_FLASH_WIP;
+				XQspiPs_FlashStage(FlashPtr);
+			}
+			break;
+
+		case XQSPIPS_FLASH_RDSR:
+			if (((u8 *)&FlashPtr->SrBuf)[1] &
+			    XQSPIPS_FLASH_SR_WIP_MASK) {
+				FlashPtr->State = XQSPIPS_FLASH_WIP;
+				break;
+			}
+			if (Req->Op == XQSPIPS_FLASH_OP_ERASE) {
+				FlashPtr->Erases++;
+			} else {
+				FlashPtr->Pages++;
+				if (Req->Op == XQSPIPS_FLASH_OP_PROGRAM) {
+					FlashPtr->StageCount--;
+				}
+			}
+			Req->Done += FlashPtr->OpLen;
+			FlashPtr->State = XQSPIPS_FLASH_IDLE;
+			break;
+
+		default:
+			break;
+	}
+
+	if (Status != XST_SUCCESS) {
+		XQspiPs_FlashComplete(FlashPtr, XST_FAILURE);
+	}
+	XQspiPs_FlashRun(FlashPtr);
+}
+
+/****************************************************************************/
+/**
+*
+* Puts a request in a free slot and starts it if the flash is idle. Called
+* with IRQs masked.
+*
+* @param	FlashPtr is the flash service.
+* @param	Op is the request type.
+* @param	Addr is the flash address.
+* @param	BufPtr is the read buffer or the program data.
+* @param	Length is the number of bytes.
+* @param	IsAhead is 1 for an erase ahead of the log writer.
+* @param	Page is the page of a log writer request.
+* @param	TokenPtr returns the token of the request.
+*
+* @return	XST_SUCCESS, or XST_DEVICE_BUSY if no slot is free.
+*
+*****************************************************************************/
+static int XQspiPs_FlashSubmit(XQspiPs_Flash *FlashPtr, u8 Op, u32 Addr,
+			       u8 *BufPtr, u32 Length, u8 IsAhead,
+			       XQspiPs_FlashPage *Page,
+			       XQspiPs_FlashToken *TokenPtr)
+{
+	XQspiPs_FlashReq *Req = NULL;
+	XQspiPs_FlashToken Token;
+	unsigned int Index;
+	XTime Now;
+
+	for (Index = 0; Index < XQSPIPS_FLASH_QUEUE_LEN; Index++) {
+		if (FlashPtr->Req[Index].Token == 0U) {
+			Req = &FlashPtr->Req[Index];
+			break;
+		}
+	}
+	if (Req == NULL) {
+		return XST_DEVICE_BUSY;
+	}
+
+	Token = FlashPtr->NextToken;
+	FlashPtr->NextToken++;
+	if (FlashPtr->NextToken == 0U) {
+		FlashPtr->NextToken = 1U;
+	}
+	*TokenPtr = Token;
+
+	XTime_GetTime(&Now);
+	Req->Op = Op;
+	Req->IsAhead = IsAhead;
+	Req->Report = ((Page == NULL) && (IsAhead == 0U)) ? 1U : 0U;
+	Req->Addr = Addr;
+	Req->Buf = BufPtr;
+	Req->Length = Length;
+	Req->Staged = 0U;
+	Req->Done = 0U;
+	Req->Page = Page;
+	Req->SubmitTime = Now;
+	Req->Token = Token;
+
+	XQspiPs_FlashRun(FlashPtr);
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* Picks the next request: the oldest one, except that erases ahead of the
+* log writer give way to later requests outside their sector.
+*
+* @param	FlashPtr is the flash service.
+*
+* @return	The request, NULL if there is none.
+*
+*****************************************************************************/
+static XQspiPs_FlashReq *XQspiPs_FlashSelect(XQspiPs_Flash *FlashPtr)
+{
+	XQspiPs_FlashReq *Oldest = NULL;
+	XQspiPs_FlashReq *Ahead = NULL;
+	XQspiPs_FlashReq *Req;
+	unsigned int Index;
+
+	for (Index = 0; Index < XQSPIPS_FLASH_QUEUE_LEN; Index++) {
+		Req = &FlashPtr->Req[Index];
+		if (Req->Token == 0U) {
+			continue;
+		}
+		if (Req->IsAhead) {
+			if ((Ahead == NULL) ||
+			    XQSPIPS_FLASH_BEFORE(Req->Token, Ahead->Token)) {
+				Ahead = Req;
+			}
+		} else if ((Oldest == NULL) ||
+			   XQSPIPS_FLASH_BEFORE(Req->Token, Oldest->Token)) {
+			Oldest = Req;
+		}
+	}
+
+	if ((Oldest == NULL) || (Ahead == NULL)) {
+		return (Oldest != NULL) ? Oldest : Ahead;
+	}
+
+	for (Index = 0; Index < XQSPIPS_FLASH_QUEUE_LEN; Index++) {
+		Req = &FlashPtr->Req[Index];
+		if ((Req->Token != 0U) && Req->IsAhead &&
+		    XQSPIPS_FLASH_BEFORE(Req->Token, Oldest->Token) &&
+		    (Req->Addr < (Oldest->Addr + Oldest->Length)) &&
+		    (Oldest->Addr < (Req->Addr + Req->Length))) {
+			return Ahead;
+		}
+	}
+
+	return Oldest;
+}
+
+/****************************************************************************/
+/**
+*
+* Starts the next step when the flash is idle: the next page or sector of
+* the request in progress, or the next request. Completes the requests
+* that are done or fail to start.
+*
+* @param	FlashPtr is the flash service.
+*
+* @return	None.
+*
+*****************************************************************************/
+static void XQspiPs_FlashRun(XQspiPs_Flash *FlashPtr)
+{
+	XQspiPs_FlashReq *Req;
+
+	while (FlashPtr->State == XQSPIPS_FLASH_IDLE) {
+		Req = FlashPtr->CurReq;
+		if (Req == NULL) {
+			Req = XQspiPs_FlashSelect(FlashPtr);
+			if (Req == NULL) {
+				return;
+			}
+			FlashPtr->CurReq = Req;
+			FlashPtr->StageHead = 0U;
+			FlashPtr->StageCount = 0U;
+		}
+
+		if (Req->Done >= Req->Length) {
+			XQspiPs_FlashComplete(FlashPtr, XST_SUCCESS);
+		} else if (XQspiPs_FlashStartOp(FlashPtr) != XST_SUCCESS) {
+			XQspiPs_FlashComplete(FlashPtr, XST_FAILURE);
+		}
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* Sends the read command, or the write enable of the next page or sector of
+* the request in progress.
+*
+* @param	FlashPtr is the flash service.
+*
+* @return	XST_SUCCESS, or the status of XQspiPs_Transfer().
+*
+*****************************************************************************/
+static int XQspiPs_FlashStartOp(XQspiPs_Flash *FlashPtr)
+{
+	XQspiPs_FlashReq *Req = FlashPtr->CurReq;
+	s32 Status;
+
+	if (Req->Op == XQSPIPS_FLASH_OP_READ) {
+		XQspiPs_FlashSetCmd(Req->Buf, XQSPIPS_FLASH_OPCODE_FAST_READ,
+				    Req->Addr);
+		FlashPtr->OpAddr = Req->Addr;
+		FlashPtr->OpLen = Req->Length;
+		FlashPtr->State = XQSPIPS_FLASH_CMD;
+		Status = XQspiPs_Transfer(FlashPtr->QspiInst, Req->Buf,
+					  Req->Buf, Req->Length +
+					  XQSPIPS_FLASH_READ_OVERHEAD);
+		if (Status != XST_SUCCESS) {
+			FlashPtr->State = XQSPIPS_FLASH_IDLE;
+		}
+		return Status;
+	}
+
+	if (Req->Op == XQSPIPS_FLASH_OP_ERASE) {
+		FlashPtr->OpAddr = Req->Addr + Req->Done;
+		FlashPtr->OpLen = XQSPIPS_FLASH_SECTOR_SIZE;
+	} else {
+		if (Req->Op == XQSPIPS_FLASH_OP_APPEND) {
+			FlashPtr->OpPage = Req->Page;
+		} else {
+			/* later pages are copied while the previous one
+			 * programs */
+			if (FlashPtr->StageCount == 0U) {
+				XQspiPs_FlashStage(FlashPtr);
+			}
+			FlashPtr->OpPage = &FlashPtr->Stage[
+				(FlashPtr->StageHead + 2U -
+				 FlashPtr->StageCount) & 1U];
+		}
+		FlashPtr->OpAddr = FlashPtr->OpPage->Addr;
+		FlashPtr->OpLen = FlashPtr->OpPage->Len;
+	}
+
+	FlashPtr->CmdBuf = 0U;
+	*(u8 *)&FlashPtr->CmdBuf = XQSPIPS_FLASH_OPCODE_WREN;
+	FlashPtr->State = XQSPIPS_FLASH_WREN;
+	Status = XQspiPs_Transfer(FlashPtr->QspiInst, (u8 *)&FlashPtr->CmdBuf,
+				  NULL, 1U);
+	if (Status != XST_SUCCESS) {
+		FlashPtr->State = XQSPIPS_FLASH_IDLE;
+	}
+
+	return Status;
+}
+
+/****************************************************************************/
+/**
+*
+* Copies the next page of a program request to the free stage buffer.
+*
+* @param	FlashPtr is the flash service.
+*
+* @return	None.
+*
+*****************************************************************************/
+static void XQspiPs_FlashStage(XQspiPs_Flash *FlashPtr)
+{
+	XQspiPs_FlashReq *Req = FlashPtr->CurReq;
+	XQspiPs_FlashPage *Page;
+	u32 Addr;
+	u32 Len;
+
+	if (Req->Op != XQSPIPS_FLASH_OP_PROGRAM) {
+		return;
+	}
+
+	if ((FlashPtr->StageCount < 2U) && (Req->Staged < Req->Length)) {
+		Page = &FlashPtr->Stage[FlashPtr->StageHead];
+		Addr = Req->Addr + Req->Staged;
+		Len = XQSPIPS_FLASH_PAGE_SIZE -
+		      (Addr % XQSPIPS_FLASH_PAGE_SIZE);
+		if (Len > (Req->Length - Req->Staged)) {
+			Len = Req->Length - Req->Staged;
+		}
+
+		XQspiPs_FlashSetCmd((u8 *)Page->Buf, XQSPIPS_FLASH_OPCODE_PP,
+				    Addr);
+		memcpy((u8 *)Page->Buf + XQSPIPS_FLASH_CMD_LEN,
+		       Req->Buf + Req->Staged, Len);
+		Page->Addr = Addr;
+		Page->Len = Len;
+		XQspiPs_FlashPad(Page);
+
+		Req->Staged += Len;
+		FlashPtr->StageHead ^= 1U;
+		FlashPtr->StageCount++;
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* Completes the request in progress, frees its slot and its log page and
+* puts its token in the completion queue, dropping the oldest entry if the
+* queue is full.
+*
+* @param	FlashPtr is the flash service.
+* @param	Status is XST_SUCCESS, or XST_FAILURE if a transfer failed.
+*
+* @return	None.
+*
+*****************************************************************************/
+static void XQspiPs_FlashComplete(XQspiPs_Flash *FlashPtr, int Status)
+{
+	XQspiPs_FlashReq *Req = FlashPtr->CurReq;
+	XTime Now;
+
+	XTime_GetTime(&Now);
+	if ((Now - Req->SubmitTime) > FlashPtr->MaxLatency) {
+		FlashPtr->MaxLatency = Now - Req->SubmitTime;
+	}
+
+	if (Status != XST_SUCCESS) {
+		FlashPtr->Errors++;
+		FlashPtr->ErrorToken = Req->Token;
+	}
+
+	if (Req->Page != NULL) {
+		FlashPtr->AppendBusy &= ~(1U << (u32)(Req->Page -
+						      FlashPtr->AppendPage));
+	}
+
+	if (Req->Report) {
+		if ((FlashPtr->DoneHead - FlashPtr->DoneTail) >=
+		    XQSPIPS_FLASH_QUEUE_LEN) {
+			FlashPtr->DoneTail++;
+			FlashPtr->DoneDropped++;
+		}
+		FlashPtr->DoneQueue[FlashPtr->DoneHead %
+				    XQSPIPS_FLASH_QUEUE_LEN] = Req->Token;
+		FlashPtr->DoneHead++;
+	}
+
+	Req->Token = 0U;
+	FlashPtr->CurReq = NULL;
+	FlashPtr->State = XQSPIPS_FLASH_IDLE;
+}
+
+/****************************************************************************/
+/**
+*
+* Queues the page being filled by the log writer. Called with IRQs masked
+* and a free request slot.
+*
+* @param	FlashPtr is the flash service.
+*
+* @return	None.
+*
+*****************************************************************************/
+static void XQspiPs_FlashQueuePage(XQspiPs_Flash *FlashPtr)
+{
+	XQspiPs_FlashPage *Page = FlashPtr->AppendOpen;
+
+	FlashPtr->AppendOpen = NULL;
+	XQspiPs_FlashSetCmd((u8 *)Page->Buf, XQSPIPS_FLASH_OPCODE_PP,
+			    Page->Addr);
+	XQspiPs_FlashPad(Page);
+	(void)XQspiPs_FlashSubmit(FlashPtr, XQSPIPS_FLASH_OP_APPEND,
+				  Page->Addr, NULL, Page->Len, 0U, Page,
+				  &FlashPtr->AppendToken);
+}
+/** @} */
@@ -0,0 +1,1126 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xqspips_store.c
+* @addtogroup qspips Overview
+* @{
+*
+* This file contains a log structured key/value store on QSPI flash, on
+* top of the flash service in xqspips_flash.c.
+*
+* Values are never rewritten in place. XQspiPs_StorePut() and
+* XQspiPs_StoreDelete() append a record to the active sector, the newest
+* record of a key is the valid one. Each sector starts with a header:
+* <pre>
+*   0  Magic       XQSPIPS_STORE_MAGIC
+*   4  EraseCount  erases of the sector
+*   8  HdrCrc      CRC-32 of Magic and EraseCount
+*   12 Seq         order of the sector in the log, all ones while free
+*   16 SeqInv      ~Seq
+* </pre>
+* The first three words are written after the erase, Seq and SeqInv when
+* the sector becomes active, so a free sector is used without a further
+* erase. The records start at XQSPIPS_STORE_HDR_SPACE:
+* <pre>
+*   0  Key
+*   4  Info        value length in bits 15:0, record type in bits 31:16
+*   8  Crc         CRC-32 of Key, Info and the value
+*   12 Value       padded with 0xFF to a multiple of 4 bytes
+* </pre>
+* XQspiPs_StoreMount() reads the sector headers and replays the records of
+* the used sectors in Seq order to rebuild the index in RAM.
+*
+* When a sector fills up the next one is taken from the free sectors, the
+* least erased first. If only one free sector is left, the used sector
+* with the fewest live bytes, the oldest of equal ones, is collected: its
+* live records are copied to the active sector and it is erased. When the erase counts drift more
+* than XQSPIPS_STORE_WEAR_DELTA apart, the least erased used sector, which
+* holds data that does not change, is collected as well so that its
+* sector is put back in use.
+*
+* Power fail safety:
+* - a record is valid only when its CRC matches. A torn record is
+*   skipped: the scan goes on XQSPIPS_STORE_MAX_REC bytes after its start,
+*   past anything a single program can have written.
+* - the log ends at an erased header followed by XQSPIPS_STORE_MAX_REC
+*   erased bytes, other bytes behind an erased header are a torn record.
+* - a failed program closes the active sector.
+* - a sector is used only after Seq and SeqInv are both written.
+* - a collected record is copied before its sector is erased. If both
+*   copies survive, the one in the newer sector wins. If the cut leaves no
+*   free sector, the next write collects a sector first.
+* - a sector with a torn header is erased before use.
+*
+* The calls block until the flash is done, XQspiPs_FlashWait() reads the
+* write in progress bit while waiting. The flash service may be used for
+* other requests at the same time, outside the store region.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 3.13  pt  10/19/26 First release
+*       pt  10/19/26 Skip a torn record instead of closing its sector,
+*                    win back the reserve sector after a cut collection
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+
+#include "xqspips.h"
+#include "xtime_l.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XQSPIPS_STORE_MAGIC		0x314C5351U /* "QSL1" */
+#define XQSPIPS_STORE_HDR_LEN		20U
+#define XQSPIPS_STORE_HDR_SPACE		32U
+#define XQSPIPS_STORE_SEQ_OFFSET	12U
+#define XQSPIPS_STORE_CAPACITY		\
+	(XQSPIPS_FLASH_SECTOR_SIZE - XQSPIPS_STORE_HDR_SPACE)
+#define XQSPIPS_STORE_MAX_REC		\
+	((XQSPIPS_STORE_REC_HDR + XQSPIPS_STORE_MAX_VALUE + 3U) & ~3U)
+
+/*
+ * Record types
+ */
+#define XQSPIPS_STORE_REC_PUT		0x5055U
+#define XQSPIPS_STORE_REC_DEL		0x4445U
+
+/*
+ * Sector states
+ */
+#define XQSPIPS_STORE_FREE		0U /* erased, header written */
+#define XQSPIPS_STORE_DIRTY		1U /* to be erased before use */
+#define XQSPIPS_STORE_USED		2U /* part of the log */
+
+#define XQSPIPS_STORE_NONE		0xFFFFFFFFU
+#define XQSPIPS_STORE_ERASED		0xFFFFFFFFU
+
+/* One free sector is kept as the destination of a collection */
+#define XQSPIPS_STORE_GC_RESERVE	1U
+
+#define XQSPIPS_STORE_TIMEOUT_US	4000000U
+
+/* Scan modes */
+#define XQSPIPS_STORE_SCAN_MOUNT	0U
+#define XQSPIPS_STORE_SCAN_COLLECT	1U
+
+/**************************** Type Definitions *******************************/
+
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define XQSPIPS_STORE_REC_SIZE(Len)	\
+	((XQSPIPS_STORE_REC_HDR + (Len) + 3U) & ~3U)
+
+/************************** Function Prototypes ******************************/
+
+static int XQspiPs_StoreRead(XQspiPs_Store *StorePtr, u32 Addr, u32 Len);
+static int XQspiPs_StoreProgram(XQspiPs_Store *StorePtr, u32 Addr,
+				const u8 *DataPtr, u32 Len);
+static int XQspiPs_StoreErase(XQspiPs_Store *StorePtr, u32 Sector);
+static int XQspiPs_StoreScan(XQspiPs_Store *StorePtr, u32 Sector, u32 Mode);
+static void XQspiPs_StoreApply(XQspiPs_Store *StorePtr, u32 Sector,
+			       u32 Key, u32 Type, u32 Addr, u32 Len);
+static int XQspiPs_StoreWrite(XQspiPs_Store *StorePtr, u32 Key, u32 Type,
+			      const u8 *DataPtr, u32 Len);
+static int XQspiPs_StoreNewSector(XQspiPs_Store *StorePtr, u32 InGc);
+static int XQspiPs_StoreCollect(XQspiPs_Store *StorePtr, u32 Victim);
+static int XQspiPs_StoreWearLevel(XQspiPs_Store *StorePtr);
+
+/************************** Variable Definitions *****************************/
+
+static const u32 XQspiPs_StoreCrcTable[16] = {
+	0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU,
+	0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+	0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU,
+	0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+};
+
+/****************************************************************************/
+/**
+*
+* Updates a CRC-32 (IEEE 802.3) over a buffer, four bits at a time.
+*
+* @param	Crc is the CRC so far, 0 to start.
+* @param	DataPtr is the buffer.
+* @param	Len is the number of bytes.
+*
+* @return	The updated CRC.
+*
+*****************************************************************************/
+static u32 XQspiPs_StoreCrc(u32 Crc, const u8 *DataPtr, u32 Len)
+{
+	u32 Index;
+
+	Crc = ~Crc;
+	for (Index = 0U; Index < Len; Index++) {
+		Crc ^= DataPtr[Index];
+		Crc = (Crc >> 4) ^ XQspiPs_StoreCrcTable[Crc & 0xFU];
+		Crc = (Crc >> 4) ^ XQspiPs_StoreCrcTable[Crc & 0xFU];
+	}
+
+	return ~Crc;
+}
+
+/****************************************************************************/
+/**
+*
+* Reads a little endian word from a byte buffer.
+*
+*****************************************************************************/
+static INLINE u32 XQspiPs_StoreGet32(const u8 *BufPtr)
+{
+	return (u32)BufPtr[0] | ((u32)BufPtr[1] << 8) |
+	       ((u32)BufPtr[2] << 16) | ((u32)BufPtr[3] << 24);
+}
+
+/****************************************************************************/
+/**
+*
+* Writes a little endian word to a byte buffer.
+*
+*****************************************************************************/
+static INLINE void XQspiPs_StorePut32(u8 *BufPtr, u32 Value)
+{
+	BufPtr[0] = (u8)Value;
+	BufPtr[1] = (u8)(Value >> 8);
+	BufPtr[2] = (u8)(Value >> 16);
+	BufPtr[3] = (u8)(Value >> 24);
+}
+
+/****************************************************************************/
+/**
+*
+* Looks up a key in the index.
+*
+* @param	StorePtr is the store.
+* @param	Key is the key.
+* @param	PosPtr returns the entry of the key, or where to insert it.
+*
+* @return	1 if the key is found, 0 otherwise.
+*
+*****************************************************************************/
+static u32 XQspiPs_StoreFind(XQspiPs_Store *StorePtr, u32 Key, u32 *PosPtr)
+{
+	u32 Low = 0U;
+	u32 High = StorePtr->KeyCount;
+	u32 Mid;
+
+	while (Low < High) {
+		Mid = (Low + High) / 2U;
+		if (StorePtr->Index[Mid].Key < Key) {
+			Low = Mid + 1U;
+		} else {
+			High = Mid;
+		}
+	}
+	*PosPtr = Low;
+
+	return ((Low < StorePtr->KeyCount) &&
+		(StorePtr->Index[Low].Key == Key)) ? 1U : 0U;
+}
+
+/****************************************************************************/
+/**
+*
+* Returns the number of sectors that can be taken for the log.
+*
+*****************************************************************************/
+static u32 XQspiPs_StoreFreeCount(XQspiPs_Store *StorePtr)
+{
+	u32 Sector;
+	u32 Count = 0U;
+
+	for (Sector = 0U; Sector < StorePtr->SectorCount; Sector++) {
+		if (StorePtr->Sector[Sector].State != XQSPIPS_STORE_USED) {
+			Count++;
+		}
+	}
+
+	return Count;
+}
+
+/****************************************************************************/
+/**
+*
+* Erases all the sectors of a store region and mounts the empty store. The
+* erase counts of sectors with a valid header are kept.
+*
+* @param	StorePtr is the store.
+* @param	FlashPtr is an initialized flash service.
+* @param	BaseAddr is the flash address of the region, a multiple of
+*		XQSPIPS_FLASH_SECTOR_SIZE.
+* @param	SectorCount is the number of sectors, at least 2 and at most
+*		XQSPIPS_STORE_MAX_SECTORS.
+*
+* @return
+*		- XST_SUCCESS on success
+*		- XST_INVALID_PARAM if the region is not valid
+*		- XST_FAILURE if a flash request fails
+*
+*****************************************************************************/
+int XQspiPs_StoreFormat(XQspiPs_Store *StorePtr, XQspiPs_Flash *FlashPtr,
+			u32 BaseAddr, u32 SectorCount)
+{
+	u32 Sector;
+	int Status;
+
+	Status = XQspiPs_StoreMount(StorePtr, FlashPtr, BaseAddr, SectorCount);
+	if ((Status != XST_SUCCESS) && (Status != XST_BUFFER_TOO_SMALL)) {
+		return Status;
+	}
+
+	for (Sector = 0U; Sector < SectorCount; Sector++) {
+		if (StorePtr->Sector[Sector].State != XQSPIPS_STORE_FREE) {
+			Status = XQspiPs_StoreErase(StorePtr, Sector);
+			if (Status != XST_SUCCESS) {
+				return Status;
+			}
+		}
+	}
+
+	return XQspiPs_StoreMount(StorePtr, FlashPtr, BaseAddr, SectorCount);
+}
+
+/****************************************************************************/
+/**
+*
+* Mounts a store: reads the sector headers and rebuilds the index from the
+* records of the used sectors, oldest sector first.
+*
+* @param	StorePtr is the store.
+* @param	FlashPtr is an initialized flash service.
+* @param	BaseAddr is the flash address of the region, a multiple of
+*		XQSPIPS_FLASH_SECTOR_SIZE.
+* @param	SectorCount is the number of sectors, at least 2 and at most
+*		XQSPIPS_STORE_MAX_SECTORS.
+*
+* @return
+*		- XST_SUCCESS on success
+*		- XST_INVALID_PARAM if the region is not valid
+*		- XST_BUFFER_TOO_SMALL if the store has more keys than
+*		  XQSPIPS_STORE_MAX_KEYS
+*		- XST_FAILURE if a flash request fails
+*
+* @note		A region that was never formatted mounts as an empty store
+*		with all sectors dirty, they are erased as they are needed.
+*
+*****************************************************************************/
+int XQspiPs_StoreMount(XQspiPs_Store *StorePtr, XQspiPs_Flash *FlashPtr,
+		       u32 BaseAddr, u32 SectorCount)
+{
+	XQspiPs_StoreSector *SectorPtr;
+	u32 Order[XQSPIPS_STORE_MAX_SECTORS];
+	u32 UsedCount = 0U;
+	u32 MaxErase = 0U;
+	u32 Sector;
+	u32 Index;
+	u32 Pos;
+	u8 *Hdr;
+	XTime Start;
+	XTime End;
+	int Status = XST_SUCCESS;
+
+	Xil_AssertNonvoid(StorePtr != NULL);
+	Xil_AssertNonvoid(FlashPtr != NULL);
+
+	if ((SectorCount < 2U) || (SectorCount > XQSPIPS_STORE_MAX_SECTORS) ||
+	    ((BaseAddr % XQSPIPS_FLASH_SECTOR_SIZE) != 0U) ||
+	    (BaseAddr >= XQSPIPS_FLASH_ADDR_LIMIT) ||
+	    (SectorCount > ((XQSPIPS_FLASH_ADDR_LIMIT - BaseAddr) /
+			    XQSPIPS_FLASH_SECTOR_SIZE))) {
+		return XST_INVALID_PARAM;
+	}
+
+	XTime_GetTime(&Start);
+	memset(StorePtr, 0, sizeof(XQspiPs_Store));
+	StorePtr->FlashPtr = FlashPtr;
+	StorePtr->BaseAddr = BaseAddr;
+	StorePtr->SectorCount = SectorCount;
+	StorePtr->Active = XQSPIPS_STORE_NONE;
+	StorePtr->NextSeq = 1U;
+
+	Hdr = (u8 *)StorePtr->IoBuf + XQSPIPS_FLASH_READ_OVERHEAD;
+	for (Sector = 0U; Sector < SectorCount; Sector++) {
+		SectorPtr = &StorePtr->Sector[Sector];
+		SectorPtr->State = XQSPIPS_STORE_DIRTY;
+		SectorPtr->EraseCount = XQSPIPS_STORE_NONE;
+
+		Status = XQspiPs_StoreRead(StorePtr, BaseAddr + (Sector *
+					   XQSPIPS_FLASH_SECTOR_SIZE),
+					   XQSPIPS_STORE_HDR_LEN);
+		if (Status != XST_SUCCESS) {
+			return Status;
+		}
+		if ((XQspiPs_StoreGet32(Hdr) != XQSPIPS_STORE_MAGIC) ||
+		    (XQspiPs_StoreGet32(Hdr + 8) !=
+		     XQspiPs_StoreCrc(0U, Hdr, 8U))) {
+			continue;
+		}
+
+		SectorPtr->EraseCount = XQspiPs_StoreGet32(Hdr + 4);
+		if (SectorPtr->EraseCount > MaxErase) {
+			MaxErase = SectorPtr->EraseCount;
+		}
+		SectorPtr->Seq = XQspiPs_StoreGet32(Hdr + 12);
+		if ((SectorPtr->Seq == XQSPIPS_STORE_ERASED) &&
+		    (XQspiPs_StoreGet32(Hdr + 16) == XQSPIPS_STORE_ERASED)) {
+			SectorPtr->State = XQSPIPS_STORE_FREE;
+		} else if (SectorPtr->Seq ==
+			   ~XQspiPs_StoreGet32(Hdr + 16)) {
+			SectorPtr->State = XQSPIPS_STORE_USED;
+			if (SectorPtr->Seq >= StorePtr->NextSeq) {
+				StorePtr->NextSeq = SectorPtr->Seq + 1U;
+			}
+
+			/* insert in Seq order */
+			Pos = UsedCount;
+			while ((Pos > 0U) &&
+			       (StorePtr->Sector[Order[Pos - 1U]].Seq >
+				SectorPtr->Seq)) {
+				Order[Pos] = Order[Pos - 1U];
+				Pos--;
+			}
+			Order[Pos] = Sector;
+			UsedCount++;
+		}
+	}
+
+	/* a torn header leaves the erase count unknown, assume the worst */
+	for (Sector = 0U; Sector < SectorCount; Sector++) {
+		if (StorePtr->Sector[Sector].EraseCount == XQSPIPS_STORE_NONE) {
+			StorePtr->Sector[Sector].EraseCount = MaxErase;
+		}
+	}
+
+	for (Index = 0U; Index < UsedCount; Index++) {
+		Status = XQspiPs_StoreScan(StorePtr, Order[Index],
+					   XQSPIPS_STORE_SCAN_MOUNT);
+		if ((Status != XST_SUCCESS) &&
+		    (Status != XST_BUFFER_TOO_SMALL)) {
+			return Status;
+		}
+	}
+
+	/* the newest sector goes on if it has room */
+	if ((UsedCount != 0U) &&
+	    (StorePtr->Sector[Order[UsedCount - 1U]].Used <
+	     XQSPIPS_FLASH_SECTOR_SIZE)) {
+		StorePtr->Active = Order[UsedCount - 1U];
+	}
+
+	XTime_GetTime(&End);
+	StorePtr->MountCounts = End - Start;
+
+	return Status;
+}
+
+/****************************************************************************/
+/**
+*
+* Writes a value.
+*
+* @param	StorePtr is a mounted store.
+* @param	Key is the key, any value except 0xFFFFFFFF.
+* @param	DataPtr is the value.
+* @param	ByteCount is the length of the value, at most
+*		XQSPIPS_STORE_MAX_VALUE.
+*
+* @return
+*		- XST_SUCCESS if the value is written
+*		- XST_INVALID_PARAM if the key or the length is not valid
+*		- XST_BUFFER_TOO_SMALL if the store or its index is full
+*		- XST_FAILURE if a flash request fails
+*
+*****************************************************************************/
+int XQspiPs_StorePut(XQspiPs_Store *StorePtr, u32 Key, const void *DataPtr,
+		     u32 ByteCount)
+{
+	u32 Pos;
+	int Status;
+
+	Xil_AssertNonvoid(StorePtr != NULL);
+	Xil_AssertNonvoid((DataPtr != NULL) || (ByteCount == 0U));
+
+	if ((Key == XQSPIPS_STORE_ERASED) ||
+	    (ByteCount > XQSPIPS_STORE_MAX_VALUE)) {
+		return XST_INVALID_PARAM;
+	}
+	if ((XQspiPs_StoreFind(StorePtr, Key, &Pos) == 0U) &&
+	    (StorePtr->KeyCount == XQSPIPS_STORE_MAX_KEYS)) {
+		return XST_BUFFER_TOO_SMALL;
+	}
+
+	Status = XQspiPs_StoreWrite(StorePtr, Key, XQSPIPS_STORE_REC_PUT,
+				    (const u8 *)DataPtr, ByteCount);
+	if (Status == XST_SUCCESS) {
+		StorePtr->UserBytes += ByteCount;
+	}
+
+	return Status;
+}
+
+/****************************************************************************/
+/**
+*
+* Reads a value.
+*
+* @param	StorePtr is a mounted store.
+* @param	Key is the key.
+* @param	BufPtr is the buffer for the value.
+* @param	BufLen is the size of the buffer.
+* @param	ByteCountPtr returns the length of the value.
+*
+* @return
+*		- XST_SUCCESS if the value is read
+*		- XST_NO_DATA if the key is not in the store
+*		- XST_BUFFER_TOO_SMALL if the value does not fit in the buffer
+*		- XST_FAILURE if the read fails or the record is corrupted
+*
+*****************************************************************************/
+int XQspiPs_StoreGet(XQspiPs_Store *StorePtr, u32 Key, void *BufPtr,
+		     u32 BufLen, u32 *ByteCountPtr)
+{
+	XQspiPs_StoreEntry *Entry;
+	u8 *Rec;
+	u32 Pos;
+	int Status;
+
+	Xil_AssertNonvoid(StorePtr != NULL);
+	Xil_AssertNonvoid(ByteCountPtr != NULL);
+
+	if (XQspiPs_StoreFind(StorePtr, Key, &Pos) == 0U) {
+		return XST_NO_DATA;
+	}
+
+	Entry = &StorePtr->Index[Pos];
+	*ByteCountPtr = Entry->Len;
+	if (Entry->Len > BufLen) {
+		return XST_BUFFER_TOO_SMALL;
+	}
+
+	Status = XQspiPs_StoreRead(StorePtr, Entry->Addr,
+				   XQSPIPS_STORE_REC_HDR + Entry->Len);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	Rec = (u8 *)StorePtr->IoBuf + XQSPIPS_FLASH_READ_OVERHEAD;
+	if (XQspiPs_StoreGet32(Rec + 8) !=
+	    XQspiPs_StoreCrc(XQspiPs_StoreCrc(0U, Rec, 8U),
+			     Rec + XQSPIPS_STORE_REC_HDR, Entry->Len)) {
+		return XST_FAILURE;
+	}
+
+	memcpy(BufPtr, Rec + XQSPIPS_STORE_REC_HDR, Entry->Len);
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* Deletes a value.
+*
+* @param	StorePtr is a mounted store.
+* @param	Key is the key.
+*
+* @return
+*		- XST_SUCCESS if the value is deleted
+*		- XST_NO_DATA if the key is not in the store
+*		- XST_BUFFER_TOO_SMALL if the store is full
+*		- XST_FAILURE if a flash request fails
+*
+*****************************************************************************/
+int XQspiPs_StoreDelete(XQspiPs_Store *StorePtr, u32 Key)
+{
+	u32 Pos;
+
+	Xil_AssertNonvoid(StorePtr != NULL);
+
+	if (XQspiPs_StoreFind(StorePtr, Key, &Pos) == 0U) {
+		return XST_NO_DATA;
+	}
+
+	return XQspiPs_StoreWrite(StorePtr, Key, XQSPIPS_STORE_REC_DEL, NULL,
+				  0U);
+}
+
+/****************************************************************************/
+/**
+*
+* Waits for a flash request of the store.
+*
+* @param	StorePtr is the store.
+* @param	Status is the status of the submit call.
+* @param	Token is the token of the request.
+*
+* @return	XST_SUCCESS, or XST_FAILURE if the request fails.
+*
+*****************************************************************************/
+static int XQspiPs_StoreWait(XQspiPs_Store *StorePtr, int Status,
+			     XQspiPs_FlashToken Token)
+{
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = XQspiPs_FlashWait(StorePtr->FlashPtr, Token,
+				   XQSPIPS_STORE_TIMEOUT_US);
+	if ((Status != XST_SUCCESS) ||
+	    (StorePtr->FlashPtr->ErrorToken == Token)) {
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* Reads Len bytes to IoBuf, after XQSPIPS_FLASH_READ_OVERHEAD bytes.
+*
+*****************************************************************************/
+static int XQspiPs_StoreRead(XQspiPs_Store *StorePtr, u32 Addr, u32 Len)
+{
+	XQspiPs_FlashToken Token = 0U;
+	int Status;
+
+	Status = XQspiPs_FlashRead(StorePtr->FlashPtr, Addr,
+				   (u8 *)StorePtr->IoBuf, Len, &Token);
+
+	return XQspiPs_StoreWait(StorePtr, Status, Token);
+}
+
+/****************************************************************************/
+/**
+*
+* Programs Len bytes at Addr.
+*
+*****************************************************************************/
+static int XQspiPs_StoreProgram(XQspiPs_Store *StorePtr, u32 Addr,
+				const u8 *DataPtr, u32 Len)
+{
+	XQspiPs_FlashToken Token = 0U;
+	int Status;
+
+	Status = XQspiPs_FlashProgram(StorePtr->FlashPtr, Addr, DataPtr, Len,
+				      &Token);
+	StorePtr->FlashBytes += Len;
+
+	return XQspiPs_StoreWait(StorePtr, Status, Token);
+}
+
+/****************************************************************************/
+/**
+*
+* Erases a sector and writes the header of a free sector.
+*
+* @param	StorePtr is the store.
+* @param	Sector is the sector.
+*
+* @return	XST_SUCCESS, or XST_FAILURE if a flash request fails.
+*
+*****************************************************************************/
+static int XQspiPs_StoreErase(XQspiPs_Store *StorePtr, u32 Sector)
+{
+	XQspiPs_StoreSector *SectorPtr = &StorePtr->Sector[Sector];
+	XQspiPs_FlashToken Token = 0U;
+	u32 Addr = StorePtr->BaseAddr + (Sector * XQSPIPS_FLASH_SECTOR_SIZE);
+	u8 Hdr[12];
+	int Status;
+
+	SectorPtr->State = XQSPIPS_STORE_DIRTY;
+	SectorPtr->Live = 0U;
+	SectorPtr->Used = 0U;
+
+	Status = XQspiPs_FlashErase(StorePtr->FlashPtr, Addr,
+				    XQSPIPS_FLASH_SECTOR_SIZE, &Token);
+	Status = XQspiPs_StoreWait(StorePtr, Status, Token);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+	StorePtr->Erases++;
+	SectorPtr->EraseCount++;
+
+	XQspiPs_StorePut32(Hdr, XQSPIPS_STORE_MAGIC);
+	XQspiPs_StorePut32(Hdr + 4, SectorPtr->EraseCount);
+	XQspiPs_StorePut32(Hdr + 8, XQspiPs_StoreCrc(0U, Hdr, 8U));
+	Status = XQspiPs_StoreProgram(StorePtr, Addr, Hdr, sizeof(Hdr));
+	if (Status == XST_SUCCESS) {
+		SectorPtr->State = XQSPIPS_STORE_FREE;
+	}
+
+	return Status;
+}
+
+/****************************************************************************/
+/**
+*
+* Reads the records of a used sector. At mount the records are replayed
+* into the index and the write offset is found; for a collection the live
+* records are copied to the active sector.
+*
+* @param	StorePtr is the store.
+* @param	Sector is the sector.
+* @param	Mode is XQSPIPS_STORE_SCAN_MOUNT or XQSPIPS_STORE_SCAN_COLLECT.
+*
+* @return
+*		- XST_SUCCESS on success
+*		- XST_BUFFER_TOO_SMALL if the index is full at mount
+*		- XST_FAILURE if a flash request fails
+*
+*****************************************************************************/
+static int XQspiPs_StoreScan(XQspiPs_Store *StorePtr, u32 Sector, u32 Mode)
+{
+	XQspiPs_StoreSector *SectorPtr = &StorePtr->Sector[Sector];
+	u8 *Buf = (u8 *)StorePtr->IoBuf + XQSPIPS_FLASH_READ_OVERHEAD;
+	u32 Base = StorePtr->BaseAddr + (Sector * XQSPIPS_FLASH_SECTOR_SIZE);
+	u32 Pos = XQSPIPS_STORE_HDR_SPACE;
+	u32 Len;
+	u32 Off;
+	u32 Key;
+	u32 Info;
+	u32 RecLen;
+	u32 Type;
+	u32 Size;
+	u32 Found;
+	u32 Idx;
+	int Status;
+
+	while ((Pos + XQSPIPS_STORE_REC_HDR) <= XQSPIPS_FLASH_SECTOR_SIZE) {
+		Len = XQSPIPS_FLASH_SECTOR_SIZE - Pos;
+		if (Len > XQSPIPS_STORE_IO_LEN) {
+			Len = XQSPIPS_STORE_IO_LEN;
+		}
+		Status = XQspiPs_StoreRead(StorePtr, Base + Pos, Len);
+		if (Status != XST_SUCCESS) {
+			return Status;
+		}
+
+		for (Off = 0U; (Off + XQSPIPS_STORE_REC_HDR) <= Len;
+		     Off += Size) {
+			Key = XQspiPs_StoreGet32(Buf + Off);
+			Info = XQspiPs_StoreGet32(Buf + Off + 4);
+			if ((Key == XQSPIPS_STORE_ERASED) &&
+			    (Info == XQSPIPS_STORE_ERASED)) {
+				goto Erased;
+			}
+
+			RecLen = Info & 0xFFFFU;
+			Type = Info >> 16;
+			Size = XQSPIPS_STORE_REC_SIZE(RecLen);
+			if ((RecLen > XQSPIPS_STORE_MAX_VALUE) ||
+			    ((Type != XQSPIPS_STORE_REC_PUT) &&
+			     (Type != XQSPIPS_STORE_REC_DEL)) ||
+			    ((Pos + Off + Size) > XQSPIPS_FLASH_SECTOR_SIZE)) {
+				goto Torn;
+			}
+			if ((Off + Size) > Len) {
+				/* read again from the start of the record */
+				break;
+			}
+			if (XQspiPs_StoreGet32(Buf + Off + 8) !=
+			    XQspiPs_StoreCrc(XQspiPs_StoreCrc(0U, Buf + Off,
+							      8U),
+					     Buf + Off + XQSPIPS_STORE_REC_HDR,
+					     RecLen)) {
+				goto Torn;
+			}
+
+			if (Mode == XQSPIPS_STORE_SCAN_MOUNT) {
+				if ((Type == XQSPIPS_STORE_REC_PUT) &&
+				    (XQspiPs_StoreFind(StorePtr, Key,
+						       &Idx) == 0U) &&
+				    (StorePtr->KeyCount ==
+				     XQSPIPS_STORE_MAX_KEYS)) {
+					return XST_BUFFER_TOO_SMALL;
+				}
+				XQspiPs_StoreApply(StorePtr, Sector, Key, Type,
+						   Base + Pos + Off, RecLen);
+				continue;
+			}
+
+			/*
+			 * a value is live if the index points to it, a delete
+			 * as long as an older sector may hold the key
+			 */
+			Found = XQspiPs_StoreFind(StorePtr, Key, &Idx);
+			if (((Type == XQSPIPS_STORE_REC_PUT) && Found &&
+			     (StorePtr->Index[Idx].Addr == (Base + Pos + Off))) ||
+			    ((Type == XQSPIPS_STORE_REC_DEL) && !Found &&
+			     !StorePtr->IsOldest)) {
+				Status = XQspiPs_StoreWrite(StorePtr, Key, Type,
+						Buf + Off +
+						XQSPIPS_STORE_REC_HDR,
+						RecLen);
+				if (Status != XST_SUCCESS) {
+					return Status;
+				}
+			}
+		}
+		Pos += Off;
+		continue;
+
+Erased:
+		/* a torn program may leave bits behind an empty header */
+		Pos += Off;
+		Len = XQSPIPS_FLASH_SECTOR_SIZE - Pos;
+		if (Len > XQSPIPS_STORE_MAX_REC) {
+			Len = XQSPIPS_STORE_MAX_REC;
+		}
+		Status = XQspiPs_StoreRead(StorePtr, Base + Pos, Len);
+		if (Status != XST_SUCCESS) {
+			return Status;
+		}
+		for (Off = 0U; Off < Len; Off++) {
+			if (Buf[Off] != 0xFFU) {
+				break;
+			}
+		}
+		if (Off == Len) {
+			SectorPtr->Used = Pos;
+			return XST_SUCCESS;
+		}
+		Off = 0U;
+
+Torn:
+		/*
+		 * a torn program ends within XQSPIPS_STORE_MAX_REC bytes of
+		 * its start, the next record was written there
+		 */
+		Pos += Off + XQSPIPS_STORE_MAX_REC;
+	}
+
+	SectorPtr->Used = XQSPIPS_FLASH_SECTOR_SIZE;
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* Updates the index and the live bytes of the sectors for a record. The
+* record a PUT or DEL supersedes stops being live in its sector, a PUT
+* becomes live in its own sector.
+*
+* @param	StorePtr is the store.
+* @param	Sector is the sector of the record.
+* @param	Key is the key of the record.
+* @param	Type is the record type.
+* @param	Addr is the flash address of the record.
+* @param	Len is the length of the value.
+*
+* @return	None.
+*
+*****************************************************************************/
+static void XQspiPs_StoreApply(XQspiPs_Store *StorePtr, u32 Sector,
+			       u32 Key, u32 Type, u32 Addr, u32 Len)
+{
+	XQspiPs_StoreEntry *Entry;
+	u32 Old;
+	u32 Pos;
+
+	if (XQspiPs_StoreFind(StorePtr, Key, &Pos)) {
+		Entry = &StorePtr->Index[Pos];
+		Old = (Entry->Addr - StorePtr->BaseAddr) /
+		      XQSPIPS_FLASH_SECTOR_SIZE;
+		StorePtr->Sector[Old].Live -= XQSPIPS_STORE_REC_SIZE(
+						      Entry->Len);
+		if (Type == XQSPIPS_STORE_REC_DEL) {
+			memmove(Entry, Entry + 1, (StorePtr->KeyCount - Pos -
+						   1U) * sizeof(*Entry));
+			StorePtr->KeyCount--;
+			return;
+		}
+	} else {
+		if (Type == XQSPIPS_STORE_REC_DEL) {
+			return;
+		}
+		Entry = &StorePtr->Index[Pos];
+		memmove(Entry + 1, Entry, (StorePtr->KeyCount - Pos) *
+			sizeof(*Entry));
+		StorePtr->KeyCount++;
+	}
+
+	Entry->Key = Key;
+	Entry->Addr = Addr;
+	Entry->Len = Len;
+
+	/* only the value the index points to is live, a delete never is */
+	StorePtr->Sector[Sector].Live += XQSPIPS_STORE_REC_SIZE(Len);
+}
+
+/****************************************************************************/
+/**
+*
+* Appends a record to the active sector, taking a new sector if it does not
+* fit.
+*
+* @param	StorePtr is the store.
+* @param	Key is the key.
+* @param	Type is the record type.
+* @param	DataPtr is the value.
+* @param	Len is the length of the value.
+*
+* @return	XST_SUCCESS, or the error of the flash request or of
+*		XQspiPs_StoreNewSector().
+*
+*****************************************************************************/
+static int XQspiPs_StoreWrite(XQspiPs_Store *StorePtr, u32 Key, u32 Type,
+			      const u8 *DataPtr, u32 Len)
+{
+	XQspiPs_StoreSector *SectorPtr;
+	u8 *Rec = (u8 *)StorePtr->RecBuf;
+	u32 Size = XQSPIPS_STORE_REC_SIZE(Len);
+	u32 Addr;
+	int Status;
+
+	/*
+	 * a power cut in a collection can leave the reserve sector in use,
+	 * it is won back while the active sector has room for the copies
+	 */
+	if ((StorePtr->Active == XQSPIPS_STORE_NONE) ||
+	    ((StorePtr->Sector[StorePtr->Active].Used + Size) >
+	     XQSPIPS_FLASH_SECTOR_SIZE) ||
+	    ((StorePtr->InGc == 0U) && (XQspiPs_StoreFreeCount(StorePtr) <
+					XQSPIPS_STORE_GC_RESERVE))) {
+		Status = XQspiPs_StoreNewSector(StorePtr, StorePtr->InGc);
+		if (Status != XST_SUCCESS) {
+			return Status;
+		}
+	}
+
+	XQspiPs_StorePut32(Rec, Key);
+	XQspiPs_StorePut32(Rec + 4, (Type << 16) | Len);
+	memmove(Rec + XQSPIPS_STORE_REC_HDR, DataPtr, Len);
+	memset(Rec + XQSPIPS_STORE_REC_HDR + Len, 0xFF,
+	       Size - XQSPIPS_STORE_REC_HDR - Len);
+	XQspiPs_StorePut32(Rec + 8, XQspiPs_StoreCrc(
+				   XQspiPs_StoreCrc(0U, Rec, 8U),
+				   Rec + XQSPIPS_STORE_REC_HDR, Len));
+
+	SectorPtr = &StorePtr->Sector[StorePtr->Active];
+	Addr = StorePtr->BaseAddr + (StorePtr->Active *
+				     XQSPIPS_FLASH_SECTOR_SIZE) +
+	       SectorPtr->Used;
+
+	SectorPtr->Used += Size;
+	Status = XQspiPs_StoreProgram(StorePtr, Addr, Rec, Size);
+	if (Status == XST_SUCCESS) {
+		XQspiPs_StoreApply(StorePtr, StorePtr->Active, Key, Type,
+				   Addr, Len);
+	} else {
+		/* a mount would look for the next record further on */
+		SectorPtr->Used = XQSPIPS_FLASH_SECTOR_SIZE;
+	}
+
+	return Status;
+}
+
+/****************************************************************************/
+/**
+*
+* Makes the least erased free sector the active one. Collects sectors first
+* if only the reserve sector is free, and moves cold data when the erase
+* counts drift apart.
+*
+* @param	StorePtr is the store.
+* @param	InGc is 1 when called by a collection, which may use the
+*		reserve sector.
+*
+* @return
+*		- XST_SUCCESS on success
+*		- XST_BUFFER_TOO_SMALL if the store is full
+*		- XST_FAILURE if a flash request fails
+*
+*****************************************************************************/
+static int XQspiPs_StoreNewSector(XQspiPs_Store *StorePtr, u32 InGc)
+{
+	XQspiPs_StoreSector *SectorPtr;
+	u32 Victim;
+	u32 Sector;
+	u32 Pick;
+	u32 Runs = 0U;
+	u8 Seq[8];
+	int Status;
+
+	while ((InGc == 0U) && (XQspiPs_StoreFreeCount(StorePtr) <=
+				XQSPIPS_STORE_GC_RESERVE)) {
+		/* the used sector with the least live data, then the oldest,
+		 * whose deletes are not copied */
+		Victim = XQSPIPS_STORE_NONE;
+		for (Sector = 0U; Sector < StorePtr->SectorCount; Sector++) {
+			SectorPtr = &StorePtr->Sector[Sector];
+			if ((SectorPtr->State != XQSPIPS_STORE_USED) ||
+			    (Sector == StorePtr->Active)) {
+				continue;
+			}
+			if ((Victim == XQSPIPS_STORE_NONE) ||
+			    (SectorPtr->Live < StorePtr->Sector[Victim].Live) ||
+			    ((SectorPtr->Live ==
+			      StorePtr->Sector[Victim].Live) &&
+			     (SectorPtr->Seq < StorePtr->Sector[Victim].Seq))) {
+				Victim = Sector;
+			}
+		}
+		if ((Victim == XQSPIPS_STORE_NONE) ||
+		    (StorePtr->Sector[Victim].Live >= XQSPIPS_STORE_CAPACITY) ||
+		    (Runs == StorePtr->SectorCount)) {
+			return XST_BUFFER_TOO_SMALL;
+		}
+		Runs++;
+
+		Status = XQspiPs_StoreCollect(StorePtr, Victim);
+		if (Status != XST_SUCCESS) {
+			return Status;
+		}
+		if ((StorePtr->Active != XQSPIPS_STORE_NONE) &&
+		    ((StorePtr->Sector[StorePtr->Active].Used +
+		      XQSPIPS_STORE_MAX_REC) <= XQSPIPS_FLASH_SECTOR_SIZE)) {
+			/* the collection left room in the active sector */
+			return XST_SUCCESS;
+		}
+	}
+
+	Pick = XQSPIPS_STORE_NONE;
+	for (Sector = 0U; Sector < StorePtr->SectorCount; Sector++) {
+		SectorPtr = &StorePtr->Sector[Sector];
+		if ((SectorPtr->State != XQSPIPS_STORE_USED) &&
+		    ((Pick == XQSPIPS_STORE_NONE) ||
+		     (SectorPtr->EraseCount <
+		      StorePtr->Sector[Pick].EraseCount))) {
+			Pick = Sector;
+		}
+	}
+	if (Pick == XQSPIPS_STORE_NONE) {
+		return XST_BUFFER_TOO_SMALL;
+	}
+
+	SectorPtr = &StorePtr->Sector[Pick];
+	if (SectorPtr->State == XQSPIPS_STORE_DIRTY) {
+		Status = XQspiPs_StoreErase(StorePtr, Pick);
+		if (Status != XST_SUCCESS) {
+			return Status;
+		}
+	}
+
+	XQspiPs_StorePut32(Seq, StorePtr->NextSeq);
+	XQspiPs_StorePut32(Seq + 4, ~StorePtr->NextSeq);
+	Status = XQspiPs_StoreProgram(StorePtr, StorePtr->BaseAddr +
+				      (Pick * XQSPIPS_FLASH_SECTOR_SIZE) +
+				      XQSPIPS_STORE_SEQ_OFFSET, Seq,
+				      sizeof(Seq));
+	SectorPtr->State = XQSPIPS_STORE_DIRTY;
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	SectorPtr->State = XQSPIPS_STORE_USED;
+	SectorPtr->Seq = StorePtr->NextSeq;
+	SectorPtr->Used = XQSPIPS_STORE_HDR_SPACE;
+	SectorPtr->Live = 0U;
+	StorePtr->NextSeq++;
+	StorePtr->Active = Pick;
+
+	if (InGc == 0U) {
+		return XQspiPs_StoreWearLevel(StorePtr);
+	}
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* Copies the live records of a sector to the active sector and erases it.
+*
+* @param	StorePtr is the store.
+* @param	Victim is the sector to collect.
+*
+* @return	XST_SUCCESS, or the error of a flash request.
+*
+*****************************************************************************/
+static int XQspiPs_StoreCollect(XQspiPs_Store *StorePtr, u32 Victim)
+{
+	u32 Sector;
+	int Status;
+
+	StorePtr->GcRuns++;
+
+	StorePtr->IsOldest = 1U;
+	for (Sector = 0U; Sector < StorePtr->SectorCount; Sector++) {
+		if ((StorePtr->Sector[Sector].State == XQSPIPS_STORE_USED) &&
+		    (StorePtr->Sector[Sector].Seq <
+		     StorePtr->Sector[Victim].Seq)) {
+			StorePtr->IsOldest = 0U;
+			break;
+		}
+	}
+
+	StorePtr->InGc = 1U;
+	Status = XQspiPs_StoreScan(StorePtr, Victim,
+				   XQSPIPS_STORE_SCAN_COLLECT);
+	StorePtr->InGc = 0U;
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	return XQspiPs_StoreErase(StorePtr, Victim);
+}
+
+/****************************************************************************/
+/**
+*
+* Collects the least erased used sector when the erase counts are more than
+* XQSPIPS_STORE_WEAR_DELTA apart, so that its sector is written again.
+* Called right after a new active sector is taken.
+*
+* @param	StorePtr is the store.
+*
+* @return	XST_SUCCESS, or the error of a flash request.
+*
+*****************************************************************************/
+static int XQspiPs_StoreWearLevel(XQspiPs_Store *StorePtr)
+{
+	XQspiPs_StoreSector *SectorPtr;
+	u32 MaxErase = 0U;
+	u32 Cold = XQSPIPS_STORE_NONE;
+	u32 Sector;
+
+	for (Sector = 0U; Sector < StorePtr->SectorCount; Sector++) {
+		SectorPtr = &StorePtr->Sector[Sector];
+		if (SectorPtr->EraseCount > MaxErase) {
+			MaxErase = SectorPtr->EraseCount;
+		}
+		if ((SectorPtr->State == XQSPIPS_STORE_USED) &&
+		    (Sector != StorePtr->Active) &&
+		    ((Cold == XQSPIPS_STORE_NONE) ||
+		     (SectorPtr->EraseCount <
+		      StorePtr->Sector[Cold].EraseCount))) {
+			Cold = Sector;
+		}
+	}
+
+	/* the active sector was just taken, the live data fits in it */
+	if ((Cold == XQSPIPS_STORE_NONE) ||
+	    ((MaxErase - StorePtr->Sector[Cold].EraseCount) <=
+	     XQSPIPS_STORE_WEAR_DELTA)) {
+		return XST_SUCCESS;
+	}
+
+	StorePtr->WearMoves++;
+
+	return XQspiPs_StoreCollect(StorePtr, Cold);
+}
+/** @} */
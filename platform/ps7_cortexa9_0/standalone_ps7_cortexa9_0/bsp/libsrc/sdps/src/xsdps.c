@@ -92,6 +92,7 @@
 *                       for SD/eMMC.
 * 4.2   ro     06/12/23 Added support for system device-tree flow.
 * 4.3   ap     11/29/23 Add support for Sanitize feature.
+* 4.5   pt     10/19/26 Skip cache maintenance for DMA pool buffers.
 *
 * </pre>
 *
@@ -347,7 +348,8 @@ s32 XSdPs_ReadPolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff)
 		goto RETURN_PATH;
 	}
 
-	if (InstancePtr->Config.IsCacheCoherent == 0U) {
+	if ((InstancePtr->Config.IsCacheCoherent == 0U) &&
+	    (XSDPS_BUF_IS_COHERENT(Buff) == 0U)) {
 		Xil_DCacheInvalidateRange((INTPTR)Buff,
 					  ((INTPTR)BlkCnt * (INTPTR)InstancePtr->BlkSize));
 	}
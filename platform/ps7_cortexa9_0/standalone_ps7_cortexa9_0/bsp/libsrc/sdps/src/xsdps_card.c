@@ -40,6 +40,7 @@
 * 	sa     01/25/23 Use instance structure to store DMA descriptor tables.
 * 4.2   ap     08/09/23 reordered function XSdPs_Identify_UhsMode.
 * 4.3   ap     12/22/23 Add support to read custom HS400 tap delay value from design for eMMC.
+* 4.6   pt     10/19/26 Clear IsBusy when a non-blocking transfer fails.
 * </pre>
 *
 ******************************************************************************/
@@ -184,6 +185,7 @@ s32 XSdPs_CheckTransferComplete(XSdPs *InstancePtr)
 		XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
 				 XSDPS_ERR_INTR_STS_OFFSET,
 				 XSDPS_ERROR_INTR_ALL_MASK);
+		InstancePtr->IsBusy = FALSE;
 		Status = XST_FAILURE;
 		goto RETURN_PATH;
 	}
@@ -28,6 +28,7 @@
 * 4.0   sk     02/25/22 Add support for eMMC5.1.
 * 4.1   sa     01/06/23 Include xil_util.h in this file.
 * 4.2   ap     08/09/23 Add XSdPs_SetTapDelay APIs.
+* 4.5   pt     10/19/26 Add XSDPS_BUF_IS_COHERENT for DMA pool buffers.
 * </pre>
 *
 ******************************************************************************/
@@ -47,6 +48,16 @@ extern "C" {
 
 #include "xil_util.h"
 
+/*
+ * Buffers from the non-cacheable DMA pool need no cache maintenance
+ */
+#if defined (PLATFORM_ZYNQ) && !defined (__aarch64__)
+#include "xil_dmapool.h"
+#define XSDPS_BUF_IS_COHERENT(Buff)	Xil_DmaPoolIsCoherent((UINTPTR)(Buff))
+#else
+#define XSDPS_BUF_IS_COHERENT(Buff)	0U
+#endif
+
 s32 XSdPs_SdCardInitialize(XSdPs *InstancePtr);
 s32 XSdPs_MmcCardInitialize(XSdPs *InstancePtr);
 s32 XSdPs_IdentifyCard(XSdPs *InstancePtr);
@@ -64,6 +64,9 @@
 * 3.14  mn     11/28/21 Fix MISRA-C violations.
 * 4.0   sk     02/25/22 Add support for eMMC5.1.
 * 4.1   sk     11/10/22 Add SD/eMMC Tap delay support for Versal Net.
+* 4.6   pt     10/19/26 Added XSdPs_SetWrBlkEraseCount for pre-erase of
+*                       multiple block writes.
+*       pt     10/19/26 Set IsBusy only if the transfer was started.
 *
 * </pre>
 *
@@ -785,10 +788,10 @@ s32 XSdPs_StartReadTransfer(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff)
 	Status = XSdPs_Read(InstancePtr, Arg, BlkCnt, Buff);
 	if (Status != XST_SUCCESS) {
 		Status = XST_FAILURE;
+	} else {
+		InstancePtr->IsBusy = TRUE;
 	}
 
-	InstancePtr->IsBusy = TRUE;
-
 RETURN_PATH:
 	return Status;
 }
@@ -833,10 +836,10 @@ s32 XSdPs_StartWriteTransfer(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff)
 	Status = XSdPs_Write(InstancePtr, Arg, BlkCnt, Buff);
 	if (Status != XST_SUCCESS) {
 		Status = XST_FAILURE;
+	} else {
+		InstancePtr->IsBusy = TRUE;
 	}
 
-	InstancePtr->IsBusy = TRUE;
-
 RETURN_PATH:
 	return Status;
 }
@@ -891,4 +894,59 @@ s32 XSdPs_CheckWriteTransfer(XSdPs *InstancePtr)
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+* @brief
+* Sets the number of blocks to pre-erase before the next multiple block
+* write (ACMD23, SET_WR_BLK_ERASE_COUNT). The card may erase the blocks
+* before the data arrives, which shortens the busy time of the write.
+*
+* @param	InstancePtr Pointer to the instance to be worked on.
+* @param	BlkCnt Number of blocks of the next multiple block write.
+*
+* @return
+* 		- XST_SUCCESS if the count was set or the card is not an SD card
+* 		- XST_FAILURE if failure - could be because another transfer
+* 		is in progress or the card rejected the command
+*
+* @note		Call it just before XSdPs_StartWriteTransfer or
+*		XSdPs_WritePolled. The count is a hint only, the card discards it
+*		after the next write. eMMC has no pre-erase command, CMD23 is the
+*		block count there and the driver stops writes with auto CMD12.
+*
+******************************************************************************/
+s32 XSdPs_SetWrBlkEraseCount(XSdPs *InstancePtr, u32 BlkCnt)
+{
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (InstancePtr->IsBusy == TRUE) {
+		Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	if (InstancePtr->CardType != XSDPS_CARD_SD) {
+		Status = XST_SUCCESS;
+		goto RETURN_PATH;
+	}
+
+	Status = XSdPs_CmdTransfer(InstancePtr, CMD55,
+			InstancePtr->RelCardAddr, 0U);
+	if (Status != XST_SUCCESS) {
+		Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	Status = XSdPs_CmdTransfer(InstancePtr, ACMD23,
+			BlkCnt & XSDPS_ACMD23_BLKCNT_MASK, 0U);
+	if (Status != XST_SUCCESS) {
+		Status = XST_FAILURE;
+	}
+
+RETURN_PATH:
+	return Status;
+}
+
 /** @} */
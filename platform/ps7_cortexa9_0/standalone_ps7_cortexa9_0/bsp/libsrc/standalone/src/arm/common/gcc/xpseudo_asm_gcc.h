@@ -24,6 +24,7 @@
 * 8.0   mus      02/24/22 Added macro mfcpnotoken and mtcpnotoken.
 * 8.1   asa      02/13/23 Create macros to read ESR, FAR and ELR registers.
 * 9.1   ml       11/15/23 Fix compilation errors reported with -std=c2x compiler flag
+* 9.3   pt       10/19/26 Added wfi, wfe and sev macros for aarch32.
 * </pre>
 *
 ******************************************************************************/
@@ -183,6 +184,15 @@ extern "C" {
 /* Data Memory Barrier */
 #define dmb() __asm__ __volatile__ ("dmb" : : : "memory")
 
+/* Wait For Interrupt */
+#define wfi() __asm__ __volatile__ ("wfi" : : : "memory")
+
+/* Wait For Event */
+#define wfe() __asm__ __volatile__ ("wfe" : : : "memory")
+
+/* Send Event */
+#define sev() __asm__ __volatile__ ("sev" : : : "memory")
+
 /* Memory Operations */
 #define ldr(adr)	({u32 rval; \
 		__asm__ __volatile__(\
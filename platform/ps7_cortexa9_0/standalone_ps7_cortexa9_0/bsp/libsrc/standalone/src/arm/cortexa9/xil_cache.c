@@ -101,6 +101,8 @@
 *                     Changes are made to fix the same.
 * 9.1   asa  31/01/24 Fix overflow issues under corner cases for various
 *                     cache maintenance APIs.
+* 9.3   pt   10/19/26 Added the DMA pool coherent range used by drivers to
+*                     skip cache maintenance, see xil_dmapool.h.
 * </pre>
 *
 ******************************************************************************/
@@ -116,6 +118,7 @@
 #include "xl2cc.h"
 #include "xil_errata.h"
 #include "xil_exception.h"
+#include "xil_dmapool.h"
 
 /************************** Function Prototypes ******************************/
 
@@ -125,6 +128,13 @@
 #define MAX_ADDR 				0xFFFFFFFFU
 #define LAST_CACHELINE_START	0xFFFFFFE0U
 
+/*
+ * Non-cacheable DMA pool arena, set by Xil_DmaPoolInit. Kept here so that
+ * drivers checking Xil_DmaPoolIsCoherent do not pull in the pool itself.
+ */
+UINTPTR XilDmaPoolCoherentBase;
+u32 XilDmaPoolCoherentSize;
+
 #ifdef __GNUC__
 	extern s32  _stack_end;
 	extern s32  __undef_stack;
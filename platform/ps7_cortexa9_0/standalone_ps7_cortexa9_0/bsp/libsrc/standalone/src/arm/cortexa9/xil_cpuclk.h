@@ -0,0 +1,70 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+* @file xil_cpuclk.h
+*
+* @addtogroup a9_cpuclk_apis Cortex A9 CPU Clock APIs
+*
+* Run time control of the CPU clock divisor in the SLCR ARM_CLK_CTRL
+* register, used to trade performance for power or temperature. The clock
+* source (ARM, DDR or IO PLL) is left as configured by ps7_init.
+*
+* xil_clocking.c is only built for ZynqMP, whose clocks are managed through
+* the clock controller driver. On Zynq-7000 the CPU clock is a plain SLCR
+* divider, these APIs write it directly.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- ---------------------------------------------------
+* 9.3   pt   10/19/26 Initial version
+* </pre>
+*
+* @note
+*
+* All the clocks derived from the CPU clock change with the divisor: the
+* L2 cache, OCM and interconnect (CPU_6x4x to CPU_1x) and the private and
+* global timers (CPU_3x2x). Timer based delays and XTime run slower by the
+* same ratio.
+*
+******************************************************************************/
+
+/**
+*@cond nocomments
+*/
+
+#ifndef XIL_CPUCLK_H
+#define XIL_CPUCLK_H
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/************************** Constant Definitions *****************************/
+
+#define XIL_CPUCLK_DIVISOR_MAX		63U	/**< Largest CPU clock divisor */
+
+/**
+*@endcond
+*/
+
+/************************** Function Prototypes ******************************/
+
+s32 Xil_CpuClkSetDivisor(u32 Divisor);
+u32 Xil_CpuClkGetDivisor(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XIL_CPUCLK_H */
+/**
+* @} End of "addtogroup a9_cpuclk_apis".
+*/
@@ -33,11 +33,19 @@
 * 6.8   aru  09/06/18 Removed compilation warnings for ARMCC toolchain.
 *                     It fixes CR#1008309.
 * 9.0   ml   03/03/23 Add description to fix doxygen warnings.
+* 9.3   pt   10/19/26 Added 4 KB page mappings using second level tables from
+*                     a static pool. Translation table updates can be batched
+*                     with Xil_MmuBatchBegin/Xil_MmuBatchEnd so that the TLB
+*                     and branch predictor are invalidated once per batch.
+*                     Xil_MemMap uses a single batch.
 * </pre>
 *
 * @note
 *
-* None.
+* Second level tables are taken from a static pool of XIL_MMU_L2_TABLES
+* tables. A table is returned to the pool when its section is mapped as a
+* whole again, or when all of its pages end up contiguous with the same
+* attributes.
 *
 ******************************************************************************/
 
@@ -48,6 +56,7 @@
 #include "xil_types.h"
 #include "xil_mmu.h"
 #include "xil_errata.h"
+#include "xstatus.h"
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
@@ -60,12 +69,40 @@
 #define	ARM_AR_MEM_TTB_SECT_SIZE_MASK	(~(ARM_AR_MEM_TTB_SECT_SIZE-1UL))
 /**< Mask off lower bits of addr */
 
+#define XIL_MMU_L1_ENTRIES	4096U
+#define XIL_MMU_L2_TABLE_SIZE	(XIL_MMU_L2_ENTRIES * 4U)
+
+#if (XIL_MMU_L2_TABLES > 32U)
+#error "XIL_MMU_L2_TABLES must not exceed 32"
+#endif
+
 /************************** Variable Definitions *****************************/
 
 extern u32 MMUTable;
 
+#ifdef __ICCARM__
+#pragma data_alignment = 1024
+static u32 MmuL2Pool[XIL_MMU_L2_TABLES][XIL_MMU_L2_ENTRIES];
+#else
+static u32 MmuL2Pool[XIL_MMU_L2_TABLES][XIL_MMU_L2_ENTRIES]
+		__attribute__ ((aligned(1024)));
+#endif
+static u32 MmuL2Used;		/* One bit per pool table */
+
+static u32 MmuBatchDepth;
+static u32 MmuDirty;		/* Some descriptor changed in this batch */
+static u32 MmuFullFlush;	/* Flush the whole D-cache at the end */
+static u32 MmuL1Lo = XIL_MMU_L1_ENTRIES;	/* Changed first level entries */
+static u32 MmuL1Hi;
+static u32 MmuDataLo = 0xFFFFFFFFU;	/* Memory with a changed memory type */
+static u32 MmuDataHi;
+
 /************************** Function Prototypes ******************************/
 
+static void MmuWriteSection(u32 Index, u32 Desc);
+static s32 MmuMapRange(u32 VirtAddr, u32 PhysAddr, u32 Size, u32 attrib,
+		u32 KeepPhys);
+
 /*****************************************************************************/
 /**
 * @brief	This function sets the memory attributes for a section covering 1MB
@@ -80,29 +117,25 @@ extern u32 MMUTable;
 * @return	None.
 *
 * @note		The MMU or D-cache does not need to be disabled before changing a
-*			translation table entry.
+*			translation table entry. Inside a Xil_MmuBatchBegin/
+*			Xil_MmuBatchEnd pair the TLB invalidation and cache maintenance
+*			are deferred to the end of the batch. A second level table
+*			previously attached to the section is released.
 *
 ******************************************************************************/
 void Xil_SetTlbAttributes(INTPTR Addr, u32 attrib)
 {
-	u32 *ptr;
 	u32 section;
 
 	section = Addr / 0x100000U;
-	ptr = &MMUTable;
-	ptr += section;
-	if(ptr != NULL) {
-		*ptr = (Addr & 0xFFF00000U) | attrib;
-	}
-
-	Xil_DCacheFlush();
-
-	mtcp(XREG_CP15_INVAL_UTLB_UNLOCKED, 0U);
-	/* Invalidate all branch predictors */
-	mtcp(XREG_CP15_INVAL_BRANCH_ARRAY, 0U);
 
-	dsb(); /* ensure completion of the BP and TLB invalidation */
-    isb(); /* synchronize context on this processor */
+	Xil_MmuBatchBegin();
+	if (MmuBatchDepth == 1U) {
+		/* Not part of a caller batch, keep the complete D-cache flush */
+		MmuFullFlush = 1U;
+	}
+	MmuWriteSection(section, (Addr & 0xFFF00000U) | attrib);
+	Xil_MmuBatchEnd();
 }
 
 /*****************************************************************************/
@@ -195,7 +228,8 @@ void* Xil_MemMap(UINTPTR PhysAddr, size_t size, u32 flags)
    PhysAddr &= ARM_AR_MEM_TTB_SECT_SIZE_MASK;
 
    /* Loop through entire region of memory (one MMU section at a time).
-      Each section requires a TTB entry. */
+      Each section requires a TTB entry. The TLB is invalidated once. */
+   Xil_MmuBatchBegin();
    for (Sectionoffset = 0; Sectionoffset < size;
 		Sectionoffset += ARM_AR_MEM_TTB_SECT_SIZE) {
        /* Calculate translation table entry for this memory section */
@@ -204,5 +238,485 @@ void* Xil_MemMap(UINTPTR PhysAddr, size_t size, u32 flags)
        /* Write translation table entry value to entry address */
        Xil_SetTlbAttributes(Ttbaddr, flags);
    }
+   Xil_MmuBatchEnd();
    return (void*)PhysAddr;
 }
+
+/*****************************************************************************/
+/**
+* @brief	Records a memory range whose memory type changed, it is flushed
+*			from the caches at the end of the batch.
+*
+* @param	Addr is the start address of the range.
+* @param	Len is the length of the range in bytes.
+*
+* @return	None.
+*
+******************************************************************************/
+static void MmuMarkData(u32 Addr, u32 Len)
+{
+	u32 Last = Addr + (Len - 1U);
+
+	if (Addr < MmuDataLo) {
+		MmuDataLo = Addr;
+	}
+	if (Last > MmuDataHi) {
+		MmuDataHi = Last;
+	}
+}
+
+/*****************************************************************************/
+/**
+* @brief	Takes a second level table from the pool.
+*
+* @return	Pointer to the table, NULL if the pool is exhausted.
+*
+******************************************************************************/
+static u32 *MmuL2Alloc(void)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < XIL_MMU_L2_TABLES; Index++) {
+		if ((MmuL2Used & ((u32)1U << Index)) == 0U) {
+			MmuL2Used |= ((u32)1U << Index);
+			return MmuL2Pool[Index];
+		}
+	}
+
+	return NULL;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Returns the second level table referenced by a coarse descriptor
+*			to the pool. Tables outside of the pool are left alone.
+*
+* @param	Desc is the first level coarse page table descriptor.
+*
+* @return	None.
+*
+******************************************************************************/
+static void MmuL2Release(u32 Desc)
+{
+	u32 Base = Desc & XIL_MMU_COARSE_BASE_MASK;
+	u32 Pool = (u32)(UINTPTR)MmuL2Pool;
+	u32 Index;
+
+	if ((Base < Pool) ||
+	    (Base >= (Pool + (XIL_MMU_L2_TABLES * XIL_MMU_L2_TABLE_SIZE)))) {
+		return;
+	}
+
+	Index = (Base - Pool) / XIL_MMU_L2_TABLE_SIZE;
+	MmuL2Used &= ~((u32)1U << Index);
+}
+
+/*****************************************************************************/
+/**
+* @brief	Writes a first level descriptor and records the maintenance
+*			needed at the end of the batch.
+*
+* @param	Index is the first level table index (address bits 31:20).
+* @param	Desc is the new descriptor.
+*
+* @return	None.
+*
+******************************************************************************/
+static void MmuWriteSection(u32 Index, u32 Desc)
+{
+	u32 *Table = &MMUTable;
+	u32 Old = Table[Index];
+	u32 OldType = Old & XIL_MMU_SECT_TYPE_MASK;
+	u32 NewType = Desc & XIL_MMU_SECT_TYPE_MASK;
+	u32 *L2;
+	u32 NewPage;
+	u32 Page;
+
+	if (Old == Desc) {
+		return;
+	}
+
+	if ((OldType == XIL_MMU_SECT_COARSE) && (NewType != XIL_MMU_SECT_COARSE)) {
+		/* Only the pages whose memory type changes need a flush */
+		L2 = (u32 *)(UINTPTR)(Old & XIL_MMU_COARSE_BASE_MASK);
+		NewPage = Xil_MmuPageDescriptor(0U, Desc);
+		for (Page = 0U; Page < XIL_MMU_L2_ENTRIES; Page++) {
+			if (((L2[Page] & 0x2U) != 0U) &&
+			    (((NewPage & 0x2U) == 0U) ||
+			     (((L2[Page] ^ NewPage) & XIL_MMU_PAGE_MEMTYPE) != 0U))) {
+				MmuMarkData((Index << 20) + (Page * XIL_MMU_PAGE_SIZE),
+					    XIL_MMU_PAGE_SIZE);
+			}
+		}
+		MmuL2Release(Old);
+	} else if ((OldType == XIL_MMU_SECT_SECTION) &&
+		   (NewType != XIL_MMU_SECT_COARSE) &&
+		   ((NewType != XIL_MMU_SECT_SECTION) ||
+		    (((Old ^ Desc) & XIL_MMU_SECT_MEMTYPE) != 0U))) {
+		MmuMarkData(Index << 20, XIL_MMU_SECTION_SIZE);
+	}
+
+	Table[Index] = Desc;
+
+	if (Index < MmuL1Lo) {
+		MmuL1Lo = Index;
+	}
+	if (Index >= MmuL1Hi) {
+		MmuL1Hi = Index + 1U;
+	}
+	MmuDirty = 1U;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Converts a small page descriptor back into section attributes.
+*
+* @param	Page is the small page descriptor.
+* @param	Coarse is the first level descriptor of its table.
+*
+* @return	Section attributes without the base address.
+*
+******************************************************************************/
+static u32 MmuPageToSection(u32 Page, u32 Coarse)
+{
+	u32 attrib = XIL_MMU_SECT_SECTION;
+
+	attrib |= Page & 0xCU;				/* C, B */
+	attrib |= (Page & 0x1U) << 4;			/* XN */
+	attrib |= ((Page >> 4) & 0x3U) << 10;		/* AP[1:0] */
+	attrib |= ((Page >> 6) & 0x7U) << 12;		/* TEX */
+	attrib |= ((Page >> 9) & 0x1U) << 15;		/* AP[2] */
+	attrib |= ((Page >> 10) & 0x1U) << 16;		/* S */
+	attrib |= ((Page >> 11) & 0x1U) << 17;		/* nG */
+	attrib |= Coarse & 0x1E0U;			/* Domain */
+	attrib |= ((Coarse >> 3) & 0x1U) << 19;		/* NS */
+
+	return attrib;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Makes sure a section is described by a second level table. A
+*			section descriptor is split into 256 pages with the same
+*			attributes and physical addresses.
+*
+* @param	Index is the first level table index.
+*
+* @return	Pointer to the second level table, NULL if the pool is
+*			exhausted or the entry is a supersection.
+*
+******************************************************************************/
+static u32 *MmuSplit(u32 Index)
+{
+	u32 *Table = &MMUTable;
+	u32 Old = Table[Index];
+	u32 *L2;
+	u32 Page;
+	u32 attrib;
+
+	if ((Old & XIL_MMU_SECT_TYPE_MASK) == XIL_MMU_SECT_COARSE) {
+		return (u32 *)(UINTPTR)(Old & XIL_MMU_COARSE_BASE_MASK);
+	}
+	if (((Old & XIL_MMU_SECT_TYPE_MASK) != XIL_MMU_SECT_FAULT) &&
+	    (((Old & XIL_MMU_SECT_TYPE_MASK) != XIL_MMU_SECT_SECTION) ||
+	     ((Old & XIL_MMU_SECT_SUPER_MASK) != 0U))) {
+		return NULL;
+	}
+
+	L2 = MmuL2Alloc();
+	if (L2 == NULL) {
+		return NULL;
+	}
+
+	for (Page = 0U; Page < XIL_MMU_L2_ENTRIES; Page++) {
+		L2[Page] = Xil_MmuPageDescriptor((Old & XIL_MMU_SECT_BASE_MASK) +
+				(Page * XIL_MMU_PAGE_SIZE), Old);
+	}
+	Xil_DCacheFlushRange((INTPTR)L2, XIL_MMU_L2_TABLE_SIZE);
+
+	/* A fault section has no domain, use the manager domain 15 */
+	attrib = (Old == XIL_MMU_SECT_FAULT) ? 0x1E0U : Old;
+	MmuWriteSection(Index, Xil_MmuCoarseDescriptor((u32)(UINTPTR)L2, attrib));
+
+	return L2;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Replaces a second level table by a section descriptor when all
+*			of its pages map a contiguous, section aligned range with the
+*			same attributes.
+*
+* @param	Index is the first level table index.
+* @param	L2 is the second level table of the section.
+*
+* @return	None.
+*
+******************************************************************************/
+static void MmuTryMerge(u32 Index, const u32 *L2)
+{
+	u32 *Table = &MMUTable;
+	u32 First = L2[0];
+	u32 Base = First & XIL_MMU_PAGE_BASE_MASK;
+	u32 Page;
+
+	if ((First & 0x2U) == 0U) {
+		for (Page = 1U; Page < XIL_MMU_L2_ENTRIES; Page++) {
+			if (L2[Page] != 0U) {
+				return;
+			}
+		}
+		MmuWriteSection(Index, XIL_MMU_SECT_FAULT);
+		return;
+	}
+
+	if ((Base & ~XIL_MMU_SECT_BASE_MASK) != 0U) {
+		return;
+	}
+	for (Page = 1U; Page < XIL_MMU_L2_ENTRIES; Page++) {
+		if (L2[Page] != (First + (Page * XIL_MMU_PAGE_SIZE))) {
+			return;
+		}
+	}
+
+	MmuWriteSection(Index, Base | MmuPageToSection(First, Table[Index]));
+}
+
+/*****************************************************************************/
+/**
+* @brief	Maps a page aligned range, using sections where possible and
+*			second level tables elsewhere.
+*
+* @param	VirtAddr is the start of the virtual range.
+* @param	PhysAddr is the start of the physical range, unused if
+*			KeepPhys is set.
+* @param	Size is the length of the range in bytes.
+* @param	attrib is the section attribute for the range.
+* @param	KeepPhys keeps the current physical address of every page
+*			(flat for unmapped pages) and only changes the attributes.
+*
+* @return	XST_SUCCESS, or XST_FAILURE for an unaligned range or when the
+*			table pool is exhausted. Pages before the failing section
+*			keep the new attributes.
+*
+******************************************************************************/
+static s32 MmuMapRange(u32 VirtAddr, u32 PhysAddr, u32 Size, u32 attrib,
+		u32 KeepPhys)
+{
+	u32 *Table = &MMUTable;
+	u32 *L2;
+	u32 Index;
+	u32 Offset;
+	u32 Chunk;
+	u32 Page;
+	u32 Old;
+	u32 New;
+	u32 Pa;
+	s32 Status = XST_SUCCESS;
+
+	if (Size == 0U) {
+		return XST_SUCCESS;
+	}
+	if ((((VirtAddr | Size) & (XIL_MMU_PAGE_SIZE - 1U)) != 0U) ||
+	    ((PhysAddr & (XIL_MMU_PAGE_SIZE - 1U)) != 0U) ||
+	    ((VirtAddr + (Size - 1U)) < VirtAddr)) {
+		return XST_FAILURE;
+	}
+
+	Xil_MmuBatchBegin();
+	while (Size != 0U) {
+		Index = VirtAddr >> 20;
+		Offset = VirtAddr & (XIL_MMU_SECTION_SIZE - 1U);
+		Chunk = XIL_MMU_SECTION_SIZE - Offset;
+		if (Chunk > Size) {
+			Chunk = Size;
+		}
+		Old = Table[Index];
+
+		if ((Chunk == XIL_MMU_SECTION_SIZE) &&
+		    (((KeepPhys != 0U) &&
+		      ((Old & XIL_MMU_SECT_TYPE_MASK) != XIL_MMU_SECT_COARSE)) ||
+		     ((KeepPhys == 0U) &&
+		      ((PhysAddr & (XIL_MMU_SECTION_SIZE - 1U)) == 0U)))) {
+			if (KeepPhys != 0U) {
+				Pa = ((Old & XIL_MMU_SECT_TYPE_MASK) == XIL_MMU_SECT_SECTION) ?
+					Old : VirtAddr;
+			} else {
+				Pa = PhysAddr;
+			}
+			MmuWriteSection(Index, (Pa & XIL_MMU_SECT_BASE_MASK) | attrib);
+		} else {
+			L2 = MmuSplit(Index);
+			if (L2 == NULL) {
+				Status = XST_FAILURE;
+				break;
+			}
+
+			for (Page = Offset >> 12; Page < ((Offset + Chunk) >> 12); Page++) {
+				Old = L2[Page];
+				if (KeepPhys != 0U) {
+					Pa = ((Old & 0x2U) != 0U) ? Old :
+						((Index << 20) + (Page * XIL_MMU_PAGE_SIZE));
+				} else {
+					Pa = PhysAddr + ((Page * XIL_MMU_PAGE_SIZE) - Offset);
+				}
+				New = Xil_MmuPageDescriptor(Pa, attrib);
+				if (((Old & 0x2U) != 0U) &&
+				    (((New & 0x2U) == 0U) ||
+				     (((Old ^ New) & XIL_MMU_PAGE_MEMTYPE) != 0U))) {
+					MmuMarkData((Index << 20) + (Page * XIL_MMU_PAGE_SIZE),
+						    XIL_MMU_PAGE_SIZE);
+				}
+				L2[Page] = New;
+			}
+			Xil_DCacheFlushRange((INTPTR)&L2[Offset >> 12], (Chunk >> 12) * 4U);
+			MmuDirty = 1U;
+
+			MmuTryMerge(Index, L2);
+		}
+
+		VirtAddr += Chunk;
+		PhysAddr += Chunk;
+		Size -= Chunk;
+	}
+	Xil_MmuBatchEnd();
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Starts a batch of translation table updates. Until the matching
+*			Xil_MmuBatchEnd, Xil_SetTlbAttributes, Xil_SetPageAttributes
+*			and Xil_MmuMap only write the descriptors. Batches may nest.
+*
+* @return	None.
+*
+* @note		Memory whose attributes change in a batch must not be accessed
+*			before the batch ends.
+*
+******************************************************************************/
+void Xil_MmuBatchBegin(void)
+{
+	MmuBatchDepth++;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Ends a batch of translation table updates. The outermost call
+*			cleans the changed descriptors to memory, invalidates the TLB
+*			and branch predictor once and flushes the memory whose type
+*			changed (the whole D-cache above XIL_MMU_RANGE_FLUSH_MAX).
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_MmuBatchEnd(void)
+{
+	u32 *Table = &MMUTable;
+
+	if (MmuBatchDepth == 0U) {
+		return;
+	}
+	MmuBatchDepth--;
+	if (MmuBatchDepth != 0U) {
+		return;
+	}
+	if (MmuDirty == 0U) {
+		/* Nothing changed, drop a full flush requested for this batch */
+		MmuFullFlush = 0U;
+		return;
+	}
+
+	if (MmuL1Hi > MmuL1Lo) {
+		Xil_DCacheFlushRange((INTPTR)&Table[MmuL1Lo],
+				(MmuL1Hi - MmuL1Lo) * 4U);
+	}
+
+	dsb();
+	mtcp(XREG_CP15_INVAL_UTLB_UNLOCKED, 0U);
+	/* Invalidate all branch predictors */
+	mtcp(XREG_CP15_INVAL_BRANCH_ARRAY, 0U);
+	dsb(); /* ensure completion of the BP and TLB invalidation */
+	isb(); /* synchronize context on this processor */
+
+	if ((MmuFullFlush != 0U) ||
+	    ((MmuDataHi >= MmuDataLo) &&
+	     ((MmuDataHi - MmuDataLo) >= XIL_MMU_RANGE_FLUSH_MAX))) {
+		Xil_DCacheFlush();
+	} else if (MmuDataHi >= MmuDataLo) {
+		Xil_DCacheFlushRange((INTPTR)MmuDataLo, (MmuDataHi - MmuDataLo) + 1U);
+	}
+
+	MmuDirty = 0U;
+	MmuFullFlush = 0U;
+	MmuL1Lo = XIL_MMU_L1_ENTRIES;
+	MmuL1Hi = 0U;
+	MmuDataLo = 0xFFFFFFFFU;
+	MmuDataHi = 0U;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Sets the memory attributes of a range at 4 KB granularity,
+*			keeping the current physical addresses.
+*
+* @param	Addr is the page aligned start address.
+* @param	Size is the page aligned length in bytes.
+* @param	attrib is the attribute for the range, same encoding as for
+*			Xil_SetTlbAttributes.
+*
+* @return	XST_SUCCESS, or XST_FAILURE for an unaligned range or when no
+*			second level table is left.
+*
+* @note		Whole sections inside the range are written as sections, only
+*			partially covered sections use a second level table.
+*
+******************************************************************************/
+s32 Xil_SetPageAttributes(UINTPTR Addr, size_t Size, u32 attrib)
+{
+	return MmuMapRange((u32)Addr, 0U, (u32)Size, attrib, 1U);
+}
+
+/*****************************************************************************/
+/**
+* @brief	Maps a virtual range to a physical range with the given memory
+*			attributes, in a single batch.
+*
+* @param	VirtAddr is the page aligned virtual start address.
+* @param	PhysAddr is the page aligned physical start address.
+* @param	Size is the page aligned length in bytes.
+* @param	attrib is the attribute for the range, same encoding as for
+*			Xil_SetTlbAttributes.
+*
+* @return	XST_SUCCESS, or XST_FAILURE for an unaligned range or when no
+*			second level table is left.
+*
+* @note		Sections are used where both addresses are 1 MB aligned.
+*
+******************************************************************************/
+s32 Xil_MmuMap(UINTPTR VirtAddr, UINTPTR PhysAddr, size_t Size, u32 attrib)
+{
+	return MmuMapRange((u32)VirtAddr, (u32)PhysAddr, (u32)Size, attrib, 0U);
+}
+
+/*****************************************************************************/
+/**
+* @brief	Returns the number of unused second level tables in the pool.
+*
+* @return	Number of free tables.
+*
+******************************************************************************/
+u32 Xil_MmuFreeL2Tables(void)
+{
+	u32 Index;
+	u32 Count = 0U;
+
+	for (Index = 0U; Index < XIL_MMU_L2_TABLES; Index++) {
+		if ((MmuL2Used & ((u32)1U << Index)) == 0U) {
+			Count++;
+		}
+	}
+
+	return Count;
+}
@@ -24,6 +24,9 @@
 *					  u32 which resolves issue of CR#805869
 * 5.4	pkp	 23/11/15 Added attribute definitions for Xil_SetTlbAttributes API
 * 6.8   aru  09/06/18 Removed compilation warnings for ARMCC toolchain.
+* 9.3   pt   10/19/26 Added 4 KB page mappings from a static pool of second
+*                     level tables, batched translation table updates and
+*                     DMA buffer attribute APIs.
 * </pre>
 *
 *
@@ -69,6 +72,79 @@ extern "C" {
 /* Execution type */
 #define EXECUTE_NEVER ((0x1 << 4) | (0x1 << 0))
 
+/* Attributes for DMA buffers, see Xil_MmuDmaAlloc */
+#define XIL_MMU_DMA_CACHEABLE		NORM_WB_CACHE	/* ACP/coherent masters only */
+#define XIL_MMU_DMA_WRITE_COMBINE	NORM_NONCACHE	/* Normal memory, bufferable */
+#define XIL_MMU_DMA_STRONGLY_ORDERED	STRONG_ORDERED
+
+#define XIL_MMU_SECTION_SIZE	0x100000U
+#define XIL_MMU_PAGE_SIZE	0x1000U
+#define XIL_MMU_L2_ENTRIES	256U	/* Small pages per second level table */
+
+/* Number of second level tables in the static pool, 1 KB each */
+#ifndef XIL_MMU_L2_TABLES
+#define XIL_MMU_L2_TABLES	8U
+#endif
+
+/*
+ * Above this size a memory type change flushes the whole D-cache instead of
+ * the changed range
+ */
+#ifndef XIL_MMU_RANGE_FLUSH_MAX
+#define XIL_MMU_RANGE_FLUSH_MAX	0x10000U
+#endif
+
+/* Short descriptor fields, section format */
+#define XIL_MMU_SECT_TYPE_MASK	0x3U
+#define XIL_MMU_SECT_FAULT	0x0U
+#define XIL_MMU_SECT_COARSE	0x1U
+#define XIL_MMU_SECT_SECTION	0x2U
+#define XIL_MMU_SECT_SUPER_MASK	0x40000U
+#define XIL_MMU_SECT_BASE_MASK	0xFFF00000U
+#define XIL_MMU_SECT_MEMTYPE	0x700CU		/* TEX, C, B */
+#define XIL_MMU_COARSE_BASE_MASK	0xFFFFFC00U
+
+/* Short descriptor fields, small page format */
+#define XIL_MMU_PAGE_BASE_MASK	0xFFFFF000U
+#define XIL_MMU_PAGE_MEMTYPE	0x1CCU		/* TEX, C, B */
+
+/*
+ * Converts section attributes as used by Xil_SetTlbAttributes (NORM_NONCACHE,
+ * STRONG_ORDERED, ...) into the second level small page descriptor for the
+ * 4 KB page at PhysAddr. A fault section gives a fault page.
+ */
+static inline u32 Xil_MmuPageDescriptor(u32 PhysAddr, u32 attrib)
+{
+	u32 Desc;
+
+	if ((attrib & XIL_MMU_SECT_TYPE_MASK) == XIL_MMU_SECT_FAULT) {
+		return 0U;
+	}
+
+	Desc = (PhysAddr & XIL_MMU_PAGE_BASE_MASK) | 0x2U;
+	Desc |= attrib & 0xCU;				/* C, B */
+	Desc |= (attrib >> 4) & 0x1U;			/* XN */
+	Desc |= ((attrib >> 10) & 0x3U) << 4;		/* AP[1:0] */
+	Desc |= ((attrib >> 12) & 0x7U) << 6;		/* TEX */
+	Desc |= ((attrib >> 15) & 0x1U) << 9;		/* AP[2] */
+	Desc |= ((attrib >> 16) & 0x1U) << 10;		/* S */
+	Desc |= ((attrib >> 17) & 0x1U) << 11;		/* nG */
+
+	return Desc;
+}
+
+/*
+ * First level descriptor pointing to the second level table at TableAddr,
+ * domain and NS bit are taken from the section attributes
+ */
+static inline u32 Xil_MmuCoarseDescriptor(u32 TableAddr, u32 attrib)
+{
+	return (TableAddr & XIL_MMU_COARSE_BASE_MASK) |
+		(attrib & 0x1E0U) |			/* Domain */
+		(((attrib >> 19) & 0x1U) << 3) |	/* NS */
+		XIL_MMU_SECT_COARSE;
+}
+
 /**
 *@endcond
 */
@@ -81,6 +157,13 @@ void Xil_SetTlbAttributes(INTPTR Addr, u32 attrib);
 void Xil_EnableMMU(void);
 void Xil_DisableMMU(void);
 void* Xil_MemMap(UINTPTR PhysAddr, size_t size, u32 flags);
+void Xil_MmuBatchBegin(void);
+void Xil_MmuBatchEnd(void);
+s32 Xil_SetPageAttributes(UINTPTR Addr, size_t Size, u32 attrib);
+s32 Xil_MmuMap(UINTPTR VirtAddr, UINTPTR PhysAddr, size_t Size, u32 attrib);
+u32 Xil_MmuFreeL2Tables(void);
+void *Xil_MmuDmaAlloc(size_t Size, u32 attrib);
+void Xil_MmuDmaFree(void *Buf, size_t Size);
 
 #ifdef __cplusplus
 }
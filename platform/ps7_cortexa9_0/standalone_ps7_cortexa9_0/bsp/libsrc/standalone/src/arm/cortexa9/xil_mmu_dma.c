@@ -0,0 +1,109 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+* @file xil_mmu_dma.c
+*
+* This file provides heap allocation of DMA buffers whose pages are mapped
+* non-cacheable (or cacheable for ACP masters) through the 4 KB page support
+* in xil_mmu.c. It is kept apart from xil_mmu.c so that applications which
+* do not use it do not pull in malloc.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- ---------------------------------------------------
+* 9.3   pt   10/19/26 Initial version
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <stdlib.h>
+#include "xil_types.h"
+#include "xil_mmu.h"
+#include "xstatus.h"
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/**************************** Type Definitions *******************************/
+
+/************************** Constant Definitions *****************************/
+
+/************************** Variable Definitions *****************************/
+
+/************************** Function Prototypes ******************************/
+
+/*****************************************************************************/
+/**
+* @brief	Allocates a DMA buffer from the heap and maps its pages with
+*			the given attributes, so that no cache maintenance is needed
+*			per transfer.
+*
+* @param	Size is the buffer size in bytes, rounded up to whole pages.
+* @param	attrib is XIL_MMU_DMA_WRITE_COMBINE or
+*			XIL_MMU_DMA_STRONGLY_ORDERED for non-coherent masters, or
+*			XIL_MMU_DMA_CACHEABLE for masters on the ACP.
+*
+* @return	Page aligned buffer, NULL if the heap or the table pool is
+*			exhausted.
+*
+* @note		The buffer must be released with Xil_MmuDmaFree. The buffer
+*			pages are not shared with any other heap object.
+*
+******************************************************************************/
+void *Xil_MmuDmaAlloc(size_t Size, u32 attrib)
+{
+	u8 *Raw;
+	UINTPTR Buf;
+
+	Size = (Size + (XIL_MMU_PAGE_SIZE - 1U)) & ~((size_t)XIL_MMU_PAGE_SIZE - 1U);
+	if (Size == 0U) {
+		return NULL;
+	}
+
+	Raw = malloc(Size + XIL_MMU_PAGE_SIZE + sizeof(void *));
+	if (Raw == NULL) {
+		return NULL;
+	}
+
+	/* The word just below the buffer, outside its pages, keeps Raw */
+	Buf = ((UINTPTR)Raw + sizeof(void *) + (XIL_MMU_PAGE_SIZE - 1U)) &
+		~((UINTPTR)XIL_MMU_PAGE_SIZE - 1U);
+	((void **)Buf)[-1] = Raw;
+
+	if (Xil_SetPageAttributes(Buf, Size, attrib) != XST_SUCCESS) {
+		(void)Xil_SetPageAttributes(Buf, Size, NORM_WB_CACHE);
+		free(Raw);
+		return NULL;
+	}
+
+	return (void *)Buf;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Restores the default cacheable attributes of a buffer returned
+*			by Xil_MmuDmaAlloc and releases it.
+*
+* @param	Buf is the buffer returned by Xil_MmuDmaAlloc.
+* @param	Size is the size passed to Xil_MmuDmaAlloc.
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_MmuDmaFree(void *Buf, size_t Size)
+{
+	if (Buf == NULL) {
+		return;
+	}
+
+	Size = (Size + (XIL_MMU_PAGE_SIZE - 1U)) & ~((size_t)XIL_MMU_PAGE_SIZE - 1U);
+	(void)Xil_SetPageAttributes((UINTPTR)Buf, Size, NORM_WB_CACHE);
+	free(((void **)Buf)[-1]);
+}
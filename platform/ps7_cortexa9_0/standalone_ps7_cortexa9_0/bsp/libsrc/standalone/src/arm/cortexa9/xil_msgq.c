@@ -0,0 +1,458 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+* @file xil_msgq.c
+*
+* This file contains the inter-core message queues. For more information
+* see xil_msgq.h.
+*
+* The MPMC queue is the bounded queue with per slot sequence numbers: slot
+* i is free for the producer claiming position p when its sequence equals
+* p and holds a message for the consumer claiming position p when it
+* equals p + 1. The consumer sets it to p + slot count on release.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- ---------------------------------------------------
+* 9.3   pt   10/19/26 Initial version
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#if defined(__GNUC__)
+#include <string.h>
+#include "xil_msgq.h"
+#include "xstatus.h"
+#if defined(XIL_INTERRUPT) && !defined(XIL_MSGQ_HOST)
+#include "xinterrupt_wrap.h"
+#endif
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/**************************** Type Definitions *******************************/
+
+/************************** Constant Definitions *****************************/
+
+/************************** Variable Definitions *****************************/
+
+/************************** Function Prototypes ******************************/
+
+/*****************************************************************************/
+/**
+* @brief	Rings the consumer doorbell if the consumer is waiting for it.
+*
+* @param	Q is the queue.
+*
+* @return	None.
+*
+******************************************************************************/
+static inline void MsgQNotify(Xil_MsgQ *Q)
+{
+	/* Order the published slot before reading the consumer flag */
+	Xil_MsgQFence();
+	if (Xil_MsgQLoad(&Q->Waiting) == 0U) {
+		return;
+	}
+	Xil_MsgQStore(&Q->Waiting, 0U);
+#if defined(XIL_INTERRUPT) && !defined(XIL_MSGQ_HOST)
+	if (Q->DoorbellIntr != 0U) {
+		(void)XTriggerSoftwareIntr(Q->DoorbellIntr, Q->DoorbellIntc,
+					   Q->DoorbellCpu);
+	}
+#endif
+}
+
+/*****************************************************************************/
+/**
+* @brief	Sets up a queue. Called by one of the cores before the other
+*		core uses the queue.
+*
+* @param	Q is the queue header in shared memory.
+* @param	Slots is the slot area in shared memory, cache line aligned
+*			and XIL_MSGQ_SLOTS_SIZE(MsgSize, Count) bytes long.
+* @param	MsgSize is the largest message in bytes.
+* @param	Count is the number of slots, a power of two.
+* @param	Type is XIL_MSGQ_SPSC or XIL_MSGQ_MPMC.
+*
+* @return
+*		- XST_SUCCESS if the queue is ready.
+*		- XST_INVALID_PARAM for a bad size, count, alignment or type.
+*
+******************************************************************************/
+s32 Xil_MsgQInit(Xil_MsgQ *Q, void *Slots, u32 MsgSize, u32 Count, u32 Type)
+{
+	u32 Index;
+
+	if ((Q == NULL) || (Slots == NULL) || (MsgSize == 0U) ||
+	    (Count < 2U) || ((Count & (Count - 1U)) != 0U) ||
+	    (((UINTPTR)Slots & (XIL_MSGQ_LINE_SIZE - 1U)) != 0U) ||
+	    ((Type != XIL_MSGQ_SPSC) && (Type != XIL_MSGQ_MPMC))) {
+		return XST_INVALID_PARAM;
+	}
+
+	Xil_MsgQStore(&Q->Magic, 0U);
+	Q->Type = Type;
+	Q->Mask = Count - 1U;
+	Q->MsgSize = MsgSize;
+	Q->Stride = XIL_MSGQ_SLOT_STRIDE(MsgSize);
+	Q->Slots = (UINTPTR)Slots;
+	Q->DoorbellIntr = 0U;
+	Q->DoorbellCpu = 0U;
+	Q->DoorbellIntc = 0U;
+	for (Index = 0U; Index < Count; Index++) {
+		Xil_MsgQStore(&Xil_MsgQSlotPtr(Q, Index)->Seq, Index);
+		Xil_MsgQSlotPtr(Q, Index)->Len = 0U;
+	}
+	Xil_MsgQStore(&Q->Head, 0U);
+	Xil_MsgQStore(&Q->Tail, 0U);
+	Xil_MsgQStore(&Q->Waiting, 0U);
+
+	Xil_MsgQStore(&Q->Magic, XIL_MSGQ_MAGIC);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Checks whether the other core has set up a queue.
+*
+* @param	Q is the queue header in shared memory.
+*
+* @return	1 if Xil_MsgQInit has completed on Q, 0 otherwise.
+*
+******************************************************************************/
+u32 Xil_MsgQIsReady(Xil_MsgQ *Q)
+{
+	return (Xil_MsgQLoad(&Q->Magic) == XIL_MSGQ_MAGIC) ? 1U : 0U;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Selects the software generated interrupt raised to wake the
+*		consumer. Called by the consumer after it connected a handler
+*		for the SGI.
+*
+* @param	Q is the queue.
+* @param	IntrId is the SGI in the encoded format of xinterrupt_wrap.h,
+*			0 to disable the doorbell.
+* @param	IntcParent is the encoded GIC base address.
+* @param	CpuMask is the mask of CPUs the SGI is sent to.
+*
+* @return
+*		- XST_SUCCESS if the doorbell was set.
+*		- XST_NOT_ENABLED if the BSP has no interrupt wrapper support.
+*
+******************************************************************************/
+s32 Xil_MsgQSetDoorbell(Xil_MsgQ *Q, u32 IntrId, UINTPTR IntcParent,
+			u32 CpuMask)
+{
+#if defined(XIL_INTERRUPT) && !defined(XIL_MSGQ_HOST)
+	Q->DoorbellIntr = 0U;
+	Q->DoorbellIntc = IntcParent;
+	Q->DoorbellCpu = CpuMask;
+	Xil_MsgQFence();
+	Q->DoorbellIntr = IntrId;
+
+	return XST_SUCCESS;
+#else
+	(void)Q;
+	(void)IntrId;
+	(void)IntcParent;
+	(void)CpuMask;
+
+	return XST_NOT_ENABLED;
+#endif
+}
+
+/*****************************************************************************/
+/**
+* @brief	Reserves a free slot for the producer.
+*
+* @param	Q is the queue.
+*
+* @return	Message buffer of Q->MsgSize bytes, NULL if the queue is full.
+*
+* @note		The slot must be published with Xil_MsgQCommit. An SPSC
+*		producer can hold only one reservation at a time.
+*
+******************************************************************************/
+void *Xil_MsgQReserve(Xil_MsgQ *Q)
+{
+	Xil_MsgQSlot *Slot;
+	u32 Pos;
+	u32 Seq;
+	s32 Diff;
+
+	if (Q->Type == XIL_MSGQ_SPSC) {
+		Pos = Q->Head;
+		if ((Pos - Xil_MsgQLoad(&Q->Tail)) > Q->Mask) {
+			return NULL;
+		}
+		return (void *)((UINTPTR)Xil_MsgQSlotPtr(Q, Pos) +
+				XIL_MSGQ_SLOT_HDR_SIZE);
+	}
+
+	Pos = Xil_MsgQLoad(&Q->Head);
+	for (;;) {
+		Slot = Xil_MsgQSlotPtr(Q, Pos);
+		Seq = Xil_MsgQLoad(&Slot->Seq);
+		Diff = (s32)(Seq - Pos);
+		if (Diff == 0) {
+			if (Xil_MsgQCas(&Q->Head, Pos, Pos + 1U) != 0U) {
+				return (void *)((UINTPTR)Slot +
+						XIL_MSGQ_SLOT_HDR_SIZE);
+			}
+			Pos = Xil_MsgQLoad(&Q->Head);
+		} else if (Diff < 0) {
+			/* The consumers have not released this slot yet */
+			return NULL;
+		} else {
+			/* Another producer claimed Pos */
+			Pos = Xil_MsgQLoad(&Q->Head);
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+* @brief	Publishes a slot returned by Xil_MsgQReserve and rings the
+*		doorbell if the consumer is waiting.
+*
+* @param	Q is the queue.
+* @param	Msg is the buffer returned by Xil_MsgQReserve.
+* @param	Len is the message length, at most Q->MsgSize.
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_MsgQCommit(Xil_MsgQ *Q, void *Msg, u32 Len)
+{
+	Xil_MsgQSlot *Slot = (Xil_MsgQSlot *)((UINTPTR)Msg -
+					       XIL_MSGQ_SLOT_HDR_SIZE);
+
+	Slot->Len = Len;
+	if (Q->Type == XIL_MSGQ_SPSC) {
+		Xil_MsgQStore(&Q->Head, Q->Head + 1U);
+	} else {
+		/* Nobody else writes Seq while the slot is reserved */
+		Xil_MsgQStore(&Slot->Seq, Slot->Seq + 1U);
+	}
+
+	MsgQNotify(Q);
+}
+
+/*****************************************************************************/
+/**
+* @brief	Takes the oldest message for the consumer.
+*
+* @param	Q is the queue.
+* @param	Len is set to the message length, may be NULL.
+*
+* @return	Message buffer, NULL if the queue is empty.
+*
+* @note		The slot must be handed back with Xil_MsgQRelease. An SPSC
+*		consumer can hold only one message at a time.
+*
+******************************************************************************/
+void *Xil_MsgQReceive(Xil_MsgQ *Q, u32 *Len)
+{
+	Xil_MsgQSlot *Slot = NULL;
+	u32 Pos;
+	u32 Seq;
+	s32 Diff;
+
+	if (Q->Type == XIL_MSGQ_SPSC) {
+		Pos = Q->Tail;
+		if (Pos == Xil_MsgQLoad(&Q->Head)) {
+			return NULL;
+		}
+		Slot = Xil_MsgQSlotPtr(Q, Pos);
+	} else {
+		Pos = Xil_MsgQLoad(&Q->Tail);
+		while (Slot == NULL) {
+			Slot = Xil_MsgQSlotPtr(Q, Pos);
+			Seq = Xil_MsgQLoad(&Slot->Seq);
+			Diff = (s32)(Seq - (Pos + 1U));
+			if (Diff == 0) {
+				if (Xil_MsgQCas(&Q->Tail, Pos, Pos + 1U) == 0U) {
+					Slot = NULL;
+					Pos = Xil_MsgQLoad(&Q->Tail);
+				}
+			} else if (Diff < 0) {
+				/* Not yet committed */
+				return NULL;
+			} else {
+				/* Another consumer took Pos */
+				Slot = NULL;
+				Pos = Xil_MsgQLoad(&Q->Tail);
+			}
+		}
+	}
+
+	if (Len != NULL) {
+		*Len = Slot->Len;
+	}
+	return (void *)((UINTPTR)Slot + XIL_MSGQ_SLOT_HDR_SIZE);
+}
+
+/*****************************************************************************/
+/**
+* @brief	Hands a slot returned by Xil_MsgQReceive back to the producers.
+*
+* @param	Q is the queue.
+* @param	Msg is the buffer returned by Xil_MsgQReceive.
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_MsgQRelease(Xil_MsgQ *Q, void *Msg)
+{
+	Xil_MsgQSlot *Slot = (Xil_MsgQSlot *)((UINTPTR)Msg -
+					       XIL_MSGQ_SLOT_HDR_SIZE);
+
+	if (Q->Type == XIL_MSGQ_SPSC) {
+		Xil_MsgQStore(&Q->Tail, Q->Tail + 1U);
+	} else {
+		/* Seq is Pos + 1, the next producer lap expects Pos + Count */
+		Xil_MsgQStore(&Slot->Seq, Slot->Seq + Q->Mask);
+	}
+}
+
+/*****************************************************************************/
+/**
+* @brief	Copies a message into the queue.
+*
+* @param	Q is the queue.
+* @param	Buf is the message.
+* @param	Len is the message length, at most Q->MsgSize.
+*
+* @return
+*		- XST_SUCCESS if the message was queued.
+*		- XST_INVALID_PARAM if the message is too long.
+*		- XST_FIFO_NO_ROOM if the queue is full.
+*
+******************************************************************************/
+s32 Xil_MsgQSend(Xil_MsgQ *Q, const void *Buf, u32 Len)
+{
+	void *Msg;
+
+	if (Len > Q->MsgSize) {
+		return XST_INVALID_PARAM;
+	}
+	Msg = Xil_MsgQReserve(Q);
+	if (Msg == NULL) {
+		return XST_FIFO_NO_ROOM;
+	}
+	(void)memcpy(Msg, Buf, Len);
+	Xil_MsgQCommit(Q, Msg, Len);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Copies the oldest message out of the queue.
+*
+* @param	Q is the queue.
+* @param	Buf receives the message.
+* @param	Size is the size of Buf.
+* @param	Len is set to the message length.
+*
+* @return
+*		- XST_SUCCESS if a message was copied.
+*		- XST_NO_DATA if the queue is empty.
+*		- XST_BUFFER_TOO_SMALL if the message did not fit in Buf. The
+*		  message is dropped, Len is set to its length.
+*
+******************************************************************************/
+s32 Xil_MsgQRecv(Xil_MsgQ *Q, void *Buf, u32 Size, u32 *Len)
+{
+	void *Msg;
+	s32 Status = XST_SUCCESS;
+
+	Msg = Xil_MsgQReceive(Q, Len);
+	if (Msg == NULL) {
+		return XST_NO_DATA;
+	}
+	if (*Len > Size) {
+		Status = XST_BUFFER_TOO_SMALL;
+	} else {
+		(void)memcpy(Buf, Msg, *Len);
+	}
+	Xil_MsgQRelease(Q, Msg);
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Announces that the consumer is going to wait for the doorbell.
+*
+* @param	Q is the queue.
+*
+* @return	1 if the queue is empty and the consumer may sleep (for
+*		example with WFI) until the doorbell interrupt, 0 if messages
+*		arrived in the meantime.
+*
+* @note		A typical consumer loop:
+*		while ((Msg = Xil_MsgQReceive(Q, &Len)) == NULL) {
+*			if (Xil_MsgQPrepareWait(Q) != 0U) {
+*				wait for the doorbell;
+*			}
+*		}
+*
+******************************************************************************/
+u32 Xil_MsgQPrepareWait(Xil_MsgQ *Q)
+{
+	Xil_MsgQStore(&Q->Waiting, 1U);
+	/* Order the flag before re-reading the producer side */
+	Xil_MsgQFence();
+
+	if (Xil_MsgQCount(Q) != 0U) {
+		Xil_MsgQCancelWait(Q);
+		return 0U;
+	}
+
+	return 1U;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Withdraws a Xil_MsgQPrepareWait.
+*
+* @param	Q is the queue.
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_MsgQCancelWait(Xil_MsgQ *Q)
+{
+	Xil_MsgQStore(&Q->Waiting, 0U);
+}
+
+/*****************************************************************************/
+/**
+* @brief	Returns the number of messages in the queue.
+*
+* @param	Q is the queue.
+*
+* @return	Messages committed and not yet received. For MPMC queues
+*		reserved slots which are not yet committed are included.
+*
+******************************************************************************/
+u32 Xil_MsgQCount(Xil_MsgQ *Q)
+{
+	u32 Tail = Xil_MsgQLoad(&Q->Tail);
+	u32 Head = Xil_MsgQLoad(&Q->Head);
+
+	return Head - Tail;
+}
+#endif /* __GNUC__ */
@@ -0,0 +1,248 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+* @file xil_msgq.h
+*
+* @addtogroup a9_msgq_apis Cortex A9 Inter-core Message Queues
+*
+* Lock-free message queues for AMP designs where the two A9 cores exchange
+* messages through shared memory. Unlike the spinlock in xil_spinlock.c,
+* a queue never blocks the other core: a producer or consumer that is
+* interrupted or delayed cannot stall its peer.
+*
+* Two queue types are provided:
+* - XIL_MSGQ_SPSC: one producer and one consumer. Head and tail are plain
+*   loads and stores with barriers, no exclusive accesses are needed.
+* - XIL_MSGQ_MPMC: any number of producers and consumers on both cores
+*   (including interrupt handlers). Slots carry a sequence number and the
+*   indices are claimed with LDREX/STREX.
+*
+* Messages are written and read in place: Xil_MsgQReserve returns a slot
+* which the producer fills and publishes with Xil_MsgQCommit, the consumer
+* gets it with Xil_MsgQReceive and hands it back with Xil_MsgQRelease.
+* Xil_MsgQSend and Xil_MsgQRecv are copying wrappers around these.
+*
+* The producer index, the consumer index and the slots are on separate
+* cache lines, so the cores do not write to the same line.
+*
+* Optionally the consumer can be notified through a software generated
+* interrupt (see Xil_MsgQSetDoorbell). The doorbell is only rung when the
+* consumer announced with Xil_MsgQPrepareWait that it is about to sleep,
+* a busy consumer costs the producer no interrupt.
+*
+* The queue header and the slots must be in memory that both cores map
+* strongly ordered or shareable non-cacheable (for example the high OCM
+* with Xil_SetTlbAttributes or Xil_SetPageAttributes), the same
+* requirement as for xil_spinlock.c.
+*
+* Defining XIL_MSGQ_HOST, or building for a non-ARM target, implements the
+* index updates with C11 atomics, so the queue logic can be built and
+* exercised on a host with threads.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- ---------------------------------------------------
+* 9.3   pt   10/19/26 Initial version
+* </pre>
+*
+******************************************************************************/
+
+/**
+*@cond nocomments
+*/
+
+#ifndef XIL_MSGQ_H
+#define XIL_MSGQ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/***************************** Include Files *********************************/
+
+#include "xil_types.h"
+
+#if !defined(XIL_MSGQ_HOST) && !defined(__arm__)
+#define XIL_MSGQ_HOST
+#endif
+
+#ifdef XIL_MSGQ_HOST
+#include <stdatomic.h>
+#else
+#include "xpseudo_asm.h"
+#endif
+
+/************************** Constant Definitions *****************************/
+
+/* Queue types */
+#define XIL_MSGQ_SPSC		0x0U
+#define XIL_MSGQ_MPMC		0x1U
+
+#define XIL_MSGQ_LINE_SIZE	32U
+#define XIL_MSGQ_MAGIC		0x4D534751U	/* "MSGQ" */
+
+/* Bytes in front of the message data in every slot */
+#define XIL_MSGQ_SLOT_HDR_SIZE	8U
+
+/* Slot stride for a given message size, a multiple of the cache line */
+#define XIL_MSGQ_SLOT_STRIDE(MsgSize) \
+	(((MsgSize) + XIL_MSGQ_SLOT_HDR_SIZE + XIL_MSGQ_LINE_SIZE - 1U) & \
+	 ~(XIL_MSGQ_LINE_SIZE - 1U))
+
+/* Size of the slot area for Xil_MsgQInit */
+#define XIL_MSGQ_SLOTS_SIZE(MsgSize, Count) \
+	(XIL_MSGQ_SLOT_STRIDE(MsgSize) * (Count))
+
+/**************************** Type Definitions *******************************/
+
+#ifdef XIL_MSGQ_HOST
+typedef _Atomic u32 Xil_MsgQAtomic;
+#else
+typedef volatile u32 Xil_MsgQAtomic;
+#endif
+
+typedef struct {
+	Xil_MsgQAtomic Seq;	/* MPMC: slot sequence number */
+	u32 Len;		/* Message length in bytes */
+} Xil_MsgQSlot;
+
+/*
+ * Shared between the cores. Every group of fields written by one side has
+ * its own cache line.
+ */
+typedef struct {
+	/* Producer line */
+	Xil_MsgQAtomic Head;
+	u32 ProdPad[(XIL_MSGQ_LINE_SIZE / 4U) - 1U];
+
+	/* Consumer line */
+	Xil_MsgQAtomic Tail;
+	Xil_MsgQAtomic Waiting;		/* Consumer is going to sleep */
+	u32 ConsPad[(XIL_MSGQ_LINE_SIZE / 4U) - 2U];
+
+	/* Written once by Xil_MsgQInit and Xil_MsgQSetDoorbell */
+	Xil_MsgQAtomic Magic;
+	u32 Type;
+	u32 Mask;			/* Slot count - 1 */
+	u32 MsgSize;
+	u32 Stride;
+	UINTPTR Slots;
+	u32 DoorbellIntr;		/* Encoded SGI id, 0 if no doorbell */
+	u32 DoorbellCpu;		/* CPU mask the SGI is sent to */
+	UINTPTR DoorbellIntc;		/* Encoded GIC base address */
+} __attribute__((aligned(XIL_MSGQ_LINE_SIZE))) Xil_MsgQ;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#ifdef XIL_MSGQ_HOST
+static inline u32 Xil_MsgQLoad(Xil_MsgQAtomic *Addr)
+{
+	return atomic_load_explicit(Addr, memory_order_acquire);
+}
+
+static inline void Xil_MsgQStore(Xil_MsgQAtomic *Addr, u32 Val)
+{
+	atomic_store_explicit(Addr, Val, memory_order_release);
+}
+
+static inline void Xil_MsgQFence(void)
+{
+	atomic_thread_fence(memory_order_seq_cst);
+}
+
+/* Returns 1 if *Addr was Old and has been replaced by New */
+static inline u32 Xil_MsgQCas(Xil_MsgQAtomic *Addr, u32 Old, u32 New)
+{
+	return atomic_compare_exchange_strong_explicit(Addr, &Old, New,
+			memory_order_acq_rel, memory_order_acquire) ? 1U : 0U;
+}
+#else
+static inline u32 Xil_MsgQLoad(Xil_MsgQAtomic *Addr)
+{
+	u32 Val = *Addr;
+
+	dmb();
+	return Val;
+}
+
+static inline void Xil_MsgQStore(Xil_MsgQAtomic *Addr, u32 Val)
+{
+	dmb();
+	*Addr = Val;
+}
+
+static inline void Xil_MsgQFence(void)
+{
+	dmb();
+}
+
+/* Returns 1 if *Addr was Old and has been replaced by New */
+static inline u32 Xil_MsgQCas(Xil_MsgQAtomic *Addr, u32 Old, u32 New)
+{
+	u32 Val;
+	u32 Fail;
+
+	__asm__ __volatile__(
+		"1:	ldrex	%0, [%2]	\n"
+		"	cmp	%0, %3		\n"
+		"	bne	2f		\n"
+		"	strex	%1, %4, [%2]	\n"
+		"	cmp	%1, #0		\n"
+		"	bne	1b		\n"
+		"	b	3f		\n"
+		"2:	clrex			\n"
+		"3:				\n"
+		: "=&r" (Val), "=&r" (Fail)
+		: "r" (Addr), "r" (Old), "r" (New)
+		: "cc", "memory");
+	dmb();
+
+	return (Val == Old) ? 1U : 0U;
+}
+#endif
+
+/*
+ * Message data of slot Index
+ */
+static inline Xil_MsgQSlot *Xil_MsgQSlotPtr(const Xil_MsgQ *Q, u32 Index)
+{
+	return (Xil_MsgQSlot *)(Q->Slots + ((UINTPTR)(Index & Q->Mask) * Q->Stride));
+}
+
+/**
+*@endcond
+*/
+
+/************************** Function Prototypes ******************************/
+
+s32 Xil_MsgQInit(Xil_MsgQ *Q, void *Slots, u32 MsgSize, u32 Count, u32 Type);
+u32 Xil_MsgQIsReady(Xil_MsgQ *Q);
+s32 Xil_MsgQSetDoorbell(Xil_MsgQ *Q, u32 IntrId, UINTPTR IntcParent,
+			u32 CpuMask);
+
+void *Xil_MsgQReserve(Xil_MsgQ *Q);
+void Xil_MsgQCommit(Xil_MsgQ *Q, void *Msg, u32 Len);
+void *Xil_MsgQReceive(Xil_MsgQ *Q, u32 *Len);
+void Xil_MsgQRelease(Xil_MsgQ *Q, void *Msg);
+
+s32 Xil_MsgQSend(Xil_MsgQ *Q, const void *Buf, u32 Len);
+s32 Xil_MsgQRecv(Xil_MsgQ *Q, void *Buf, u32 Size, u32 *Len);
+
+u32 Xil_MsgQPrepareWait(Xil_MsgQ *Q);
+void Xil_MsgQCancelWait(Xil_MsgQ *Q);
+u32 Xil_MsgQCount(Xil_MsgQ *Q);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* XIL_MSGQ_H */
+/**
+* @} End of "addtogroup a9_msgq_apis".
+*/
@@ -0,0 +1,172 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+* @file xil_startup.c
+*
+* This file contains the lazy zeroing of .lazy_bss objects and the startup
+* phase times. For more information see xil_startup.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- ---------------------------------------------------
+* 9.3   pt   10/19/26 Initial version
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+#include "xil_startup.h"
+#include "xtime_l.h"
+#include "xil_io.h"
+#include "xparameters.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XIL_STARTUP_GT_CNTL_OFFSET	0x00U
+#define XIL_STARTUP_GT_CNTH_OFFSET	0x04U
+#define XIL_STARTUP_GT_CTRL_OFFSET	0x08U
+#define XIL_STARTUP_GT_CTRL_EN_MASK	0x00000001U
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Variable Definitions *****************************/
+
+#if defined (__GNUC__)
+/* Linker script symbols, 0 if the script has no .lazy_bss section */
+extern u8 __lazy_bss_start[] __attribute__((weak));
+extern u8 __lazy_bss_end[] __attribute__((weak));
+
+/*
+ * Written before .bss is zeroed, so kept in .data
+ */
+static XTime StartupCounts[XIL_STARTUP_PHASES]
+	__attribute__((section(".data")));
+#else
+static XTime StartupCounts[XIL_STARTUP_PHASES];
+#endif
+
+static u32 LazyBssDone;
+
+/************************** Function Prototypes ******************************/
+
+/*****************************************************************************/
+/**
+* @brief	Zeroes a .lazy_bss object on first use.
+*
+* @param	Addr is the start of the object.
+* @param	Size is the size of the object in bytes.
+* @param	InitDone points to a u32 in .bss that tracks the object, 0 until
+*		the object is zeroed.
+*
+* @return	Addr.
+*
+* @note		Not reentrant, call it from one context per object. Does not
+*		zero the object if Xil_LazyBssZero was called before.
+*
+******************************************************************************/
+void *Xil_LazyZero(void *Addr, u32 Size, u32 *InitDone)
+{
+	if ((*InitDone == 0U) && (LazyBssDone == 0U)) {
+		(void)memset(Addr, 0, Size);
+	}
+	*InitDone = 1U;
+
+	return Addr;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Zeroes the whole .lazy_bss section once. Call it before any
+*		.lazy_bss object is used, instead of Xil_LazyZero, for
+*		example after the boot critical work is done.
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_LazyBssZero(void)
+{
+#if defined (__GNUC__)
+	UINTPTR Start = (UINTPTR)__lazy_bss_start;
+	UINTPTR End = (UINTPTR)__lazy_bss_end;
+
+	if ((LazyBssDone == 0U) && (End > Start)) {
+		(void)memset((void *)Start, 0, End - Start);
+	}
+#endif
+	LazyBssDone = 1U;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Samples the global timer for a startup phase. Called from
+*		xil-crt0.S when XIL_STARTUP_TIMES is defined, before .bss is
+*		zeroed and the sleep timer is set up. Starts the global timer
+*		if it is not running yet.
+*
+* @param	Phase is one of XIL_STARTUP_ENTRY ... XIL_STARTUP_MAIN.
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_StartupMark(u32 Phase)
+{
+	UINTPTR Base = XPAR_GLOBAL_TMR_BASEADDR;
+	u32 Ctrl;
+	u32 Low;
+	u32 High;
+
+	if (Phase >= XIL_STARTUP_PHASES) {
+		return;
+	}
+
+	Ctrl = Xil_In32(Base + XIL_STARTUP_GT_CTRL_OFFSET);
+	if ((Ctrl & XIL_STARTUP_GT_CTRL_EN_MASK) == 0U) {
+		Xil_Out32(Base + XIL_STARTUP_GT_CTRL_OFFSET,
+			  Ctrl | XIL_STARTUP_GT_CTRL_EN_MASK);
+	}
+
+	do {
+		High = Xil_In32(Base + XIL_STARTUP_GT_CNTH_OFFSET);
+		Low = Xil_In32(Base + XIL_STARTUP_GT_CNTL_OFFSET);
+	} while (Xil_In32(Base + XIL_STARTUP_GT_CNTH_OFFSET) != High);
+
+	StartupCounts[Phase] = (((XTime)High) << 32U) | (XTime)Low;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Returns the startup phase times.
+*
+* @param	TimesPtr is filled with the phase times. All times are 0 if
+*		the BSP was built without XIL_STARTUP_TIMES.
+*
+* @return	None.
+*
+* @note		The sleep timer setup may reset the global timer, so the time
+*		base changes between XIL_STARTUP_BSS and XIL_STARTUP_TIMER.
+*		TotalCounts is the sum of the phases and leaves out the timer
+*		setup. The time spent in boot.S (MMU, caches and L2 set up) is
+*		before XIL_STARTUP_ENTRY and not included either.
+*
+******************************************************************************/
+void Xil_StartupGetTimes(Xil_StartupTimes *TimesPtr)
+{
+	TimesPtr->CpuInitCounts = StartupCounts[XIL_STARTUP_CPU_INIT] -
+				  StartupCounts[XIL_STARTUP_ENTRY];
+	TimesPtr->BssCounts = StartupCounts[XIL_STARTUP_BSS] -
+			      StartupCounts[XIL_STARTUP_CPU_INIT];
+	TimesPtr->CtorCounts = StartupCounts[XIL_STARTUP_MAIN] -
+			       StartupCounts[XIL_STARTUP_TIMER];
+	TimesPtr->TotalCounts = TimesPtr->CpuInitCounts + TimesPtr->BssCounts +
+				TimesPtr->CtorCounts;
+}
@@ -0,0 +1,123 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+* @file xil_wait.h
+*
+* @addtogroup a9_wait_apis Cortex A9 Low Power Wait APIs
+*
+* Event waits that park the core in WFI instead of spinning on a register.
+*
+* Xil_WaitForEventWfi and Xil_WaitForEventsWfi take the same arguments and
+* return the same status codes as Xil_WaitForEvent and Xil_WaitForEvents,
+* plus the GIC id of the interrupt the peripheral raises for the event. The
+* core sleeps until that interrupt is pending or until the global timer
+* comparator fires for the timeout. Events without an interrupt
+* (XIL_WAIT_NO_INTR) are sampled every XIL_WAIT_POLL_US microseconds with
+* the core asleep in between. Xil_WaitUs sleeps for a fixed time.
+*
+* The interrupts are only used as wake up sources, they are never taken:
+* the wait runs with IRQs masked in the CPSR, which WFI ignores. GIC state
+* the wait has to change (distributor and CPU interface enable, priority
+* mask, the enable, priority and target of the wake up interrupts) is put
+* back before returning. Between two sleeps the IRQ mask of the caller is
+* restored briefly, so interrupts handled by the application are serviced
+* while a wait is in progress.
+*
+* Drivers opt in one at a time:
+* - XIL_WAIT_WFI: Xil_WaitForEvent and Xil_WaitForEvents sleep between
+*   samples instead of calling usleep(1).
+* - XIL_WAIT_WFI_SLEEP: usleep, sleep and the xiltimer sleep APIs on the
+*   global timer sleep in WFI.
+* - XSDPS_WFI_WAIT: sdps waits for transfer complete on the SD interrupt.
+* - FSBL_WFI_WAIT: the FSBL waits for PCAP DMA and PL done on the devcfg
+*   interrupt.
+*
+* Xil_WaitGetStats reports the wake up latency (global timer comparator
+* match to resume) and how much of the wait time the core spent in WFI,
+* where its clock is gated and no instructions execute.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- ---------------------------------------------------
+* 9.3   pt   10/19/26 Initial version
+* </pre>
+*
+* @note
+*
+* The global timer comparator of the calling core is owned by the wait while
+* it runs. The waits must not be used from interrupt handlers.
+*
+******************************************************************************/
+
+/**
+*@cond nocomments
+*/
+
+#ifndef XIL_WAIT_H
+#define XIL_WAIT_H
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/************************** Constant Definitions *****************************/
+
+#define XIL_WAIT_NO_INTR	0xFFFFFFFFU	/**< Event without interrupt */
+
+#ifndef XIL_WAIT_POLL_US
+#define XIL_WAIT_POLL_US	10U	/**< Sampling period for events
+					     without interrupt */
+#endif
+
+#ifndef XIL_WAIT_WAKE_PRIORITY
+#define XIL_WAIT_WAKE_PRIORITY	0xA0U	/**< GIC priority of the wake up
+					     interrupts the wait enables */
+#endif
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * Wait statistics, times are in global timer counts (COUNTS_PER_SECOND)
+ */
+typedef struct {
+	u32 Waits;		/**< Waits that had to sleep */
+	u32 Timeouts;		/**< Waits that timed out */
+	u32 Wakeups;		/**< WFI exits */
+	u32 TimerWakeups;	/**< WFI exits by the comparator */
+	u64 WaitCounts;	/**< Time spent in waits */
+	u64 SleepCounts;	/**< Part of WaitCounts spent in WFI */
+	u64 MaxWakeLatency;	/**< Largest comparator to resume time */
+	u64 SumWakeLatency;	/**< Sum over TimerWakeups */
+} Xil_WaitStats;
+
+/**
+*@endcond
+*/
+
+/************************** Function Prototypes ******************************/
+
+u32 Xil_WaitForEventWfi(UINTPTR RegAddr, u32 EventMask, u32 Event,
+			u32 Timeout, u32 IntrId);
+u32 Xil_WaitForEventsWfi(UINTPTR EventsRegAddr, u32 EventsMask,
+			 u32 WaitEvents, u32 Timeout, u32 *Events,
+			 u32 IntrId);
+void Xil_WaitUs(u64 Useconds);
+void Xil_WaitGetStats(Xil_WaitStats *StatsPtr);
+void Xil_WaitResetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XIL_WAIT_H */
+/**
+* @} End of "addtogroup a9_wait_apis".
+*/
@@ -0,0 +1,419 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xpm_region.c
+*
+* This file contains the named region measurement APIs built on the
+* Cortex-A9 performance monitor and the PL310 event counters. For more
+* information see xpm_region.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 9.3   pt   10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xpm_region.h"
+#include "xpm_counter.h"
+#include "xl2cc_counter.h"
+#include "xl2cc.h"
+#include "xparameters_ps.h"
+#include "xreg_cortexa9.h"
+#include "xpseudo_asm.h"
+#include "xil_io.h"
+#include "xil_printf.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions ****************************/
+
+#define XPM_REGION_PMCR_DIV_MASK	0x8U	/* Cycle counter counts every 64th cycle */
+#define XPM_REGION_PMCR_EN_MASK		0x1U
+
+/**************************** Type Definitions ******************************/
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+#define XPM_REGION_L2_REQ()	Xil_In32(XPS_L2CC_BASEADDR + XPS_L2CC_EVNT_CNT0_VAL_OFFSET)
+#define XPM_REGION_L2_HIT()	Xil_In32(XPS_L2CC_BASEADDR + XPS_L2CC_EVNT_CNT1_VAL_OFFSET)
+
+/************************** Variable Definitions *****************************/
+
+static XPmRegion_Entry Regions[XPM_REGION_MAX];
+static u32 RegionCount;
+static u32 Overhead[XPM_REGION_METRICS];
+static u32 L1DMissCntr = XPM_NO_COUNTERS_AVAILABLE;
+static u32 BrMissCntr = XPM_NO_COUNTERS_AVAILABLE;
+
+static const char *const MetricName[XPM_REGION_METRICS] = {
+	"cycles", "L1D miss", "branch miss", "L2 reads", "L2 miss"
+};
+
+/******************************************************************************/
+
+/****************************************************************************/
+/**
+*
+* @brief	Reads one PMU event counter claimed by XPmRegion_Init.
+*
+* @param	Cntr: Counter index returned by Xpm_SetUpAnEvent.
+*
+* @return	Counter value, 0 if the counter could not be claimed.
+*
+*****************************************************************************/
+static inline u32 XPmRegion_ReadCntr(u32 Cntr)
+{
+	u32 Val = 0U;
+
+	if (Cntr != XPM_NO_COUNTERS_AVAILABLE) {
+#ifdef __GNUC__
+		mtcp(XREG_CP15_EVENT_CNTR_SEL, Cntr);
+		isb();
+		Val = mfcp(XREG_CP15_PERF_MONITOR_COUNT);
+#else
+		(void)Xpm_GetEventCounter(Cntr, &Val);
+#endif
+	}
+
+	return Val;
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	Reads the cycle counter.
+*
+* @return	Cycle counter value.
+*
+*****************************************************************************/
+static inline u32 XPmRegion_ReadCycles(void)
+{
+	u32 Val;
+
+#ifdef __GNUC__
+	Val = Xpm_ReadCycleCounterVal();
+#else
+	Xpm_ReadCycleCounterVal(Val);
+#endif
+
+	return Val;
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	Computes the counter differences since a snapshot, the cycle
+*			counter is read first.
+*
+* @param	Snap: Snapshot filled by XPmRegion_Begin.
+* @param	Delta: Output, one value per metric.
+*
+* @return	None.
+*
+*****************************************************************************/
+static inline void XPmRegion_Delta(const XPmRegion_Snapshot *Snap, u32 *Delta)
+{
+	Delta[XPM_REGION_CYCLES] = XPmRegion_ReadCycles() -
+		Snap->Value[XPM_REGION_CYCLES];
+	Delta[XPM_REGION_L1D_MISS] = XPmRegion_ReadCntr(L1DMissCntr) -
+		Snap->Value[XPM_REGION_L1D_MISS];
+	Delta[XPM_REGION_BR_MISS] = XPmRegion_ReadCntr(BrMissCntr) -
+		Snap->Value[XPM_REGION_BR_MISS];
+	Delta[XPM_REGION_L2_READS] = XPM_REGION_L2_REQ() -
+		Snap->Value[XPM_REGION_L2_READS];
+	Delta[XPM_REGION_L2_MISS] = Delta[XPM_REGION_L2_READS] -
+		(XPM_REGION_L2_HIT() - Snap->Value[XPM_REGION_L2_MISS]);
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	This function sets up the PMU and L2CC counters used by the
+*			region macros and clears the region table.
+*
+* @return
+*		- XST_SUCCESS if all counters could be claimed.
+*		- XST_FAILURE if no PMU event counter was free, regions are still
+*		  timed but the affected metrics read 0.
+*
+* @note		The boot code starts the cycle counter with the divide by 64
+*			bit set, it is cleared here.
+*
+*****************************************************************************/
+u32 XPmRegion_Init(void)
+{
+	u32 Reg;
+	u32 Status = (u32)XST_SUCCESS;
+
+#ifdef __GNUC__
+	Reg = mfcp(XREG_CP15_PERF_MONITOR_CTRL);
+#else
+	mfcp(XREG_CP15_PERF_MONITOR_CTRL, Reg);
+#endif
+	Reg &= ~XPM_REGION_PMCR_DIV_MASK;
+	Reg |= XPM_REGION_PMCR_EN_MASK;
+	mtcp(XREG_CP15_PERF_MONITOR_CTRL, Reg);
+	isb();
+
+	if (L1DMissCntr == XPM_NO_COUNTERS_AVAILABLE) {
+		L1DMissCntr = Xpm_SetUpAnEvent(XPM_EVENT_DATA_CACHEREFILL);
+	}
+	if (BrMissCntr == XPM_NO_COUNTERS_AVAILABLE) {
+		BrMissCntr = Xpm_SetUpAnEvent(XPM_EVENT_BRANCHMISS);
+	}
+	if ((L1DMissCntr == XPM_NO_COUNTERS_AVAILABLE) ||
+	    (BrMissCntr == XPM_NO_COUNTERS_AVAILABLE)) {
+		Status = (u32)XST_FAILURE;
+	}
+
+	/* Counter 0 counts data read requests, counter 1 data read hits */
+	XL2cc_EventCtrInit((s32)XL2CC_DRREQ, (s32)XL2CC_DRHIT);
+	XL2cc_EventCtrStart();
+
+	XPmRegion_Reset();
+
+	return Status;
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	This function measures the cost of an empty region and
+*			subtracts it from every later sample.
+*
+* @return	None.
+*
+* @note		Keeps the minimum of XPM_REGION_CALIB_LOOPS empty regions so
+*			that an interrupt during calibration does not skew the result.
+*
+*****************************************************************************/
+void XPmRegion_Calibrate(void)
+{
+	XPmRegion_Snapshot Snap;
+	u32 Min[XPM_REGION_METRICS];
+	u32 Delta[XPM_REGION_METRICS];
+	u32 Loop;
+	u32 Index;
+
+	for (Index = 0U; Index < XPM_REGION_METRICS; Index++) {
+		Overhead[Index] = 0U;
+		Min[Index] = 0xFFFFFFFFU;
+	}
+
+	for (Loop = 0U; Loop < XPM_REGION_CALIB_LOOPS; Loop++) {
+		XPmRegion_Begin(&Snap);
+		XPmRegion_Delta(&Snap, Delta);
+
+		for (Index = 0U; Index < XPM_REGION_METRICS; Index++) {
+			if (Delta[Index] < Min[Index]) {
+				Min[Index] = Delta[Index];
+			}
+		}
+	}
+
+	for (Index = 0U; Index < XPM_REGION_METRICS; Index++) {
+		Overhead[Index] = Min[Index];
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	This function returns the table index of a region name, a new
+*			entry is allocated the first time a name is seen.
+*
+* @param	Name: Region name, the pointer is stored and must stay valid.
+*
+* @return	Region index or XPM_REGION_INVALID if the table is full.
+*
+*****************************************************************************/
+u32 XPmRegion_Lookup(const char *Name)
+{
+	u32 Index;
+	u32 Metric;
+	const char *A;
+	const char *B;
+
+	for (Index = 0U; Index < RegionCount; Index++) {
+		A = Regions[Index].Name;
+		B = Name;
+		while ((*A != '\0') && (*A == *B)) {
+			A++;
+			B++;
+		}
+		if (*A == *B) {
+			return Index;
+		}
+	}
+
+	if (RegionCount >= XPM_REGION_MAX) {
+		return XPM_REGION_INVALID;
+	}
+
+	Index = RegionCount;
+	Regions[Index].Name = Name;
+	Regions[Index].Count = 0U;
+	for (Metric = 0U; Metric < XPM_REGION_METRICS; Metric++) {
+		Regions[Index].Min[Metric] = 0xFFFFFFFFU;
+		Regions[Index].Max[Metric] = 0U;
+		Regions[Index].Sum[Metric] = 0U;
+	}
+	RegionCount++;
+
+	return Index;
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	This function takes the counter snapshot at the start of a
+*			region.
+*
+* @param	Snap: Snapshot storage, normally on the caller's stack.
+*
+* @return	None.
+*
+* @note		The cycle counter is read last so that the other reads are not
+*			part of the measured window.
+*
+*****************************************************************************/
+void XPmRegion_Begin(XPmRegion_Snapshot *Snap)
+{
+	Snap->Value[XPM_REGION_L2_MISS] = XPM_REGION_L2_HIT();
+	Snap->Value[XPM_REGION_L2_READS] = XPM_REGION_L2_REQ();
+	Snap->Value[XPM_REGION_BR_MISS] = XPmRegion_ReadCntr(BrMissCntr);
+	Snap->Value[XPM_REGION_L1D_MISS] = XPmRegion_ReadCntr(L1DMissCntr);
+	Snap->Value[XPM_REGION_CYCLES] = XPmRegion_ReadCycles();
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	This function closes a region and accumulates the counter
+*			differences into its table entry.
+*
+* @param	Id: Region index returned by XPmRegion_Lookup.
+* @param	Snap: Snapshot filled by XPmRegion_Begin.
+*
+* @return	None.
+*
+*****************************************************************************/
+void XPmRegion_End(u32 Id, const XPmRegion_Snapshot *Snap)
+{
+	u32 Delta[XPM_REGION_METRICS];
+	u32 Index;
+	XPmRegion_Entry *Entry;
+
+	XPmRegion_Delta(Snap, Delta);
+
+	if (Id >= RegionCount) {
+		return;
+	}
+
+	Entry = &Regions[Id];
+	Entry->Count++;
+	for (Index = 0U; Index < XPM_REGION_METRICS; Index++) {
+		if (Delta[Index] > Overhead[Index]) {
+			Delta[Index] -= Overhead[Index];
+		} else {
+			Delta[Index] = 0U;
+		}
+		if (Delta[Index] < Entry->Min[Index]) {
+			Entry->Min[Index] = Delta[Index];
+		}
+		if (Delta[Index] > Entry->Max[Index]) {
+			Entry->Max[Index] = Delta[Index];
+		}
+		Entry->Sum[Index] += Delta[Index];
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	This function returns the accumulated values of a region.
+*
+* @param	Id: Region index returned by XPmRegion_Lookup.
+*
+* @return	Pointer to the region entry or NULL for an invalid index.
+*
+*****************************************************************************/
+const XPmRegion_Entry *XPmRegion_Get(u32 Id)
+{
+	if (Id >= RegionCount) {
+		return NULL;
+	}
+
+	return &Regions[Id];
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	This function clears the accumulated values of all regions.
+*			Region names stay registered so that cached call site indexes
+*			remain valid.
+*
+* @return	None.
+*
+*****************************************************************************/
+void XPmRegion_Reset(void)
+{
+	u32 Index;
+	u32 Metric;
+
+	for (Index = 0U; Index < RegionCount; Index++) {
+		Regions[Index].Count = 0U;
+		for (Metric = 0U; Metric < XPM_REGION_METRICS; Metric++) {
+			Regions[Index].Min[Metric] = 0xFFFFFFFFU;
+			Regions[Index].Max[Metric] = 0U;
+			Regions[Index].Sum[Metric] = 0U;
+		}
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* @brief	This function prints the min/avg/max of every metric for all
+*			regions entered at least once.
+*
+* @return	None.
+*
+*****************************************************************************/
+void XPmRegion_Report(void)
+{
+	u32 Index;
+	u32 Metric;
+	const XPmRegion_Entry *Entry;
+
+	xil_printf("Region counters, probe overhead:");
+	for (Metric = 0U; Metric < XPM_REGION_METRICS; Metric++) {
+		xil_printf(" %s %u", MetricName[Metric], Overhead[Metric]);
+	}
+	xil_printf("\r\n");
+
+	for (Index = 0U; Index < RegionCount; Index++) {
+		Entry = &Regions[Index];
+		if (Entry->Count == 0U) {
+			continue;
+		}
+		xil_printf("%s: %u calls\r\n", Entry->Name, Entry->Count);
+		for (Metric = 0U; Metric < XPM_REGION_METRICS; Metric++) {
+			xil_printf("  %-12s min %10u avg %10u max %10u\r\n",
+				   MetricName[Metric], Entry->Min[Metric],
+				   (u32)(Entry->Sum[Metric] / Entry->Count),
+				   Entry->Max[Metric]);
+		}
+	}
+}
@@ -21,6 +21,7 @@
 * 1.00a hbm  07/14/09 Initial release
 * 6.0   kvn  05/31/16 Make Xil_AsserWait a global variable
 * 9.2   bm   07/08/24 Disable Xil_AssertCallbackRoutine usage for PLM
+* 9.3   pt   10/19/26 Added Xil_AssertLine for the XIL_ASSERT_PROFILE tier
 * </pre>
 *
 ******************************************************************************/
@@ -97,6 +98,26 @@ void Xil_Assert(const char8 *File, s32 Line)
 	}
 }
 
+/*****************************************************************************/
+/**
+*
+* @brief    Implement assert for the XIL_ASSERT_PROFILE tier. Marks the assert
+*           as occurred and calls Xil_Assert with an empty file name.
+*
+* @param    Line: linenumber of the assert
+*
+* @return   None.
+*
+* @note     Kept out of line and marked cold, so that only the compare and
+*           branch of an assert stay in the calling function.
+*
+******************************************************************************/
+void Xil_AssertLine(s32 Line)
+{
+	Xil_AssertStatus = XIL_ASSERT_OCCURRED;
+	Xil_Assert("", Line);
+}
+
 /*****************************************************************************/
 /**
 *
@@ -30,8 +30,24 @@
 * 		      __FILE__ with __FILENAME__ in assert APIs.
 * 9.3   vmt  03/03/25 Fixed compilation warning of strrchr
 *                     [-Wbuiltin-declaration-mismatch]
+*       pt   10/19/26 Added the XIL_ASSERT_PROFILE tier, build time checks
+*                     in the NDEBUG tier and Xil_AssertStatic.
 * </pre>
 *
+* Asserts are built in one of three tiers:
+* - Default: full checks. Every assert updates Xil_AssertStatus and a failing
+*   assert calls Xil_Assert with the file name and line number.
+* - XIL_ASSERT_PROFILE: a failing assert is a cold branch that calls
+*   Xil_AssertLine with the line number only. The passing path is a single
+*   compare and branch, Xil_AssertStatus is only written when an assert
+*   fails.
+* - NDEBUG: asserts generate no code. With GCC, an assert whose expression
+*   the optimizer proves to be false, for example a pin number out of range
+*   passed as a constant to an inlined driver call, fails the build.
+*   Define XIL_ASSERT_NO_BUILD_CHECK to disable this.
+*
+* Xil_AssertStatic checks a constant expression at compile time in all tiers.
+*
 ******************************************************************************/
 
 /**
@@ -63,9 +79,18 @@ extern "C" {
 #define XIL_ASSERT_OCCURRED 1U
 #define XNULL NULL
 
+#if defined (__GNUC__)
+#define XIL_ASSERT_COLD		__attribute__((cold, noinline))
+#define Xil_AssertUnlikely(Expression)	__builtin_expect(!!(Expression), 0)
+#else
+#define XIL_ASSERT_COLD
+#define Xil_AssertUnlikely(Expression)	(Expression)
+#endif
+
 extern u32 Xil_AssertStatus;
 extern s32 Xil_AssertWait;
 extern void Xil_Assert(const char8 *File, s32 Line);
+extern void Xil_AssertLine(s32 Line) XIL_ASSERT_COLD;
 /**
  *@endcond
  */
@@ -79,7 +104,41 @@ typedef void (*Xil_AssertCallback) (const char8 *File, s32 Line);
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
-#ifndef NDEBUG
+#if !defined (NDEBUG) && defined (XIL_ASSERT_PROFILE)
+
+/*
+ * Profile tier, the failing path is moved out of line and reports the line
+ * number only
+ */
+#define Xil_AssertVoid(Expression)                \
+{                                                  \
+    if (Xil_AssertUnlikely(!(Expression))) {       \
+        Xil_AssertLine(__LINE__);                  \
+        return;                                    \
+    }                                              \
+}
+
+#define Xil_AssertNonvoid(Expression)             \
+{                                                  \
+    if (Xil_AssertUnlikely(!(Expression))) {       \
+        Xil_AssertLine(__LINE__);                  \
+        return 0;                                  \
+    }                                              \
+}
+
+#define Xil_AssertVoidAlways()                   \
+{                                                  \
+   Xil_AssertLine(__LINE__);                       \
+   return;                                         \
+}
+
+#define Xil_AssertNonvoidAlways()                \
+{                                                  \
+   Xil_AssertLine(__LINE__);                       \
+   return 0;                                       \
+}
+
+#elif !defined (NDEBUG)
 
 /*****************************************************************************/
 /**
@@ -165,6 +224,29 @@ typedef void (*Xil_AssertCallback) (const char8 *File, s32 Line);
 }
 
 
+#elif defined (__GNUC__) && defined (__OPTIMIZE__) && \
+	!defined (XIL_ASSERT_NO_BUILD_CHECK)
+
+/*
+ * Release tier, no code is generated. An expression the optimizer folds to
+ * false leaves a call to Xil_AssertBuildFailed, which fails the build.
+ */
+extern void Xil_AssertBuildFailed(void)
+	__attribute__((error("assert expression is always false")));
+
+#define Xil_AssertBuildCheck(Expression)          \
+{                                                  \
+    if (__builtin_constant_p(!(Expression)) &&     \
+        !(Expression)) {                           \
+        Xil_AssertBuildFailed();                   \
+    }                                              \
+}
+
+#define Xil_AssertVoid(Expression)	Xil_AssertBuildCheck(Expression)
+#define Xil_AssertVoidAlways()
+#define Xil_AssertNonvoid(Expression)	Xil_AssertBuildCheck(Expression)
+#define Xil_AssertNonvoidAlways()
+
 #else
 
 #define Xil_AssertVoid(Expression)
@@ -174,6 +256,23 @@ typedef void (*Xil_AssertCallback) (const char8 *File, s32 Line);
 
 #endif
 
+/*****************************************************************************/
+/**
+* @brief    Checks a constant expression at compile time. Can be used at file
+*           scope and in functions, in all assert tiers.
+*
+* @param    Expression: constant expression that must be true.
+* @param    Message: identifier that names the check in the error message.
+*
+******************************************************************************/
+#if defined (__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define Xil_AssertStatic(Expression, Message) \
+	_Static_assert((Expression), #Message)
+#else
+#define Xil_AssertStatic(Expression, Message) \
+	typedef char Xil_AssertStatic_##Message[(Expression) ? 1 : -1]
+#endif
+
 /************************** Function Prototypes ******************************/
 
 void Xil_AssertSetCallback(Xil_AssertCallback Routine);
@@ -29,6 +29,9 @@
 *       ng       03/25/25 Prevent compiler optimization by using volatile for status variable,
 *                         add checks for RISC-V MB proc and zeroize memory before return
 *       ng       04/07/25 Prevent overwriting of the status variable in Xil_SReverseData
+*       pt       10/19/26 Xil_WaitForEvent and Xil_WaitForEvents sleep in WFI
+*                         between samples on Zynq when XIL_WAIT_WFI is
+*                         defined.
 *
 * </pre>
 *
@@ -40,6 +43,9 @@
 #ifdef SDT
 #include "bspconfig.h"
 #endif
+#if defined (XIL_WAIT_WFI) && defined (PLATFORM_ZYNQ)
+#include "xil_wait.h"
+#endif
 
 /************************** Constant Definitions ****************************/
 #define MAX_NIBBLES	8U /**< maximum nibbles */
@@ -207,11 +213,16 @@ void Xil_PlmStubHandler(void)
  *          XST_SUCCESS - On occurrence of the event(s).
  *          XST_FAILURE - Event did not occur before counter reaches 0
  *
- * @note    None.
+ * @note    With XIL_WAIT_WFI defined on Zynq the core sleeps in WFI between
+ *          samples, see xil_wait.h.
  *
  *****************************************************************************/
 u32 Xil_WaitForEvent(UINTPTR RegAddr, u32 EventMask, u32 Event, u32 Timeout)
 {
+#if defined (XIL_WAIT_WFI) && defined (PLATFORM_ZYNQ)
+	return Xil_WaitForEventWfi(RegAddr, EventMask, Event, Timeout,
+				   XIL_WAIT_NO_INTR);
+#else
 	u32 EventStatus;
 	u32 PollCount = Timeout;
 	u32 Status = XST_FAILURE;
@@ -230,6 +241,7 @@ u32 Xil_WaitForEvent(UINTPTR RegAddr, u32 EventMask, u32 Event, u32 Timeout)
 	}
 
 	return Status;
+#endif
 }
 
 /******************************************************************************/
@@ -248,10 +260,17 @@ u32 Xil_WaitForEvent(UINTPTR RegAddr, u32 EventMask, u32 Event, u32 Timeout)
  *          XST_SUCCESS - On occurrence of the event(s).
  *          XST_FAILURE - Event did not occur before counter reaches 0
  *
+ * @note    With XIL_WAIT_WFI defined on Zynq the core sleeps in WFI between
+ *          samples, see xil_wait.h.
+ *
  ******************************************************************************/
 u32 Xil_WaitForEvents(UINTPTR EventsRegAddr, u32 EventsMask, u32 WaitEvents,
 		      u32 Timeout, u32 *Events)
 {
+#if defined (XIL_WAIT_WFI) && defined (PLATFORM_ZYNQ)
+	return Xil_WaitForEventsWfi(EventsRegAddr, EventsMask, WaitEvents,
+				    Timeout, Events, XIL_WAIT_NO_INTR);
+#else
 	u32 EventStatus;
 	u32 PollCount = Timeout;
 	u32 Status = XST_TIMEOUT;
@@ -273,6 +292,7 @@ u32 Xil_WaitForEvents(UINTPTR EventsRegAddr, u32 EventsMask, u32 WaitEvents,
 	} while (PollCount > 0U);
 
 	return Status;
+#endif
 }
 
 /****************************************************************************/
@@ -5,6 +5,9 @@
 
 
 #include "profile.h"
+#ifdef PROFILE_FAST
+#include "profile_fast.h"
+#endif
 
 /* XMD Initializes the following Global Variables Value during Program
  *  Download with appropriate values. */
@@ -56,4 +59,8 @@ void _profile_init( void )
 #else
 	(void)cortexa9_init();
 #endif
+
+#ifdef PROFILE_FAST
+	profile_fast_init();
+#endif
 }
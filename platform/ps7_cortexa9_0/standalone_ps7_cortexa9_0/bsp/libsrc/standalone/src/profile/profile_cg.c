@@ -12,9 +12,9 @@
 
 /*
  * The mcount function is excluded from the library, if the user defines
- * PROFILE_NO_GRAPH.
+ * PROFILE_NO_GRAPH. With PROFILE_FAST it comes from profile_fast.c.
  */
-#ifndef PROFILE_NO_GRAPH
+#if !defined(PROFILE_NO_GRAPH) && !defined(PROFILE_FAST)
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -81,7 +81,8 @@ void mcount( u32 frompc, u32 selfpc )
 		}
 	}
 	if( j == n_gmon_sections ) {
-		goto done;
+		/* p is NULL here, there is no section state to update */
+		goto enable_timer_label;
 	}
 
 #ifdef PROFILE_NO_FUNCPTR
@@ -142,4 +143,4 @@ void mcount( u32 frompc, u32 selfpc )
 }
 
 
-#endif		/* PROFILE_NO_GRAPH */
+#endif		/* PROFILE_NO_GRAPH, PROFILE_FAST */
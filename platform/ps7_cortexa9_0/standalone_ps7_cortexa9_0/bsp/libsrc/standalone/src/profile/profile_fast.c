@@ -0,0 +1,285 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+#include "profile.h"
+#include "profile_fast.h"
+#include "_profile_timer_hw.h"
+
+/*
+ * Replaces mcount from profile_cg.c and profile_intr_handler from
+ * profile_hist.c when PROFILE_FAST is defined.
+ */
+#ifdef PROFILE_FAST
+
+#define ARC_HASH_MULT	0x9E3779B1U
+
+struct profile_fast_stats profile_fast_stats;
+
+static struct profile_arc arc_table[PROFILE_ARC_HASH_SIZE];
+
+static u32 sample_buf[2][PROFILE_SAMPLE_BUF_SIZE];
+static volatile u32 sample_active;	/* Half written by the ISR */
+static volatile u32 sample_fill;	/* Samples in the active half */
+static volatile u32 sample_ready[2];	/* Samples handed over to drain, 0 if free */
+
+static u16 section_order[PROFILE_MAX_SECTIONS];	/* Sections sorted by lowpc */
+static s32 section_count;
+static s32 section_last;
+static s32 bin_shift;	/* log2 of the bin width in bytes, -1 if not a power of 2 */
+
+extern u32 binsize ;
+extern u32 prof_pc ;
+
+static inline u32 arc_hash( u32 frompc, u32 selfpc )
+{
+	return (((frompc >> 2) * ARC_HASH_MULT) ^ (selfpc >> 2)) &
+		(PROFILE_ARC_HASH_SIZE - 1U);
+}
+
+/*
+ * Returns the gmon section holding pc or -1.
+ */
+static inline s32 find_section( u32 pc )
+{
+	s32 lo = 0;
+	s32 hi = section_count - 1;
+	s32 mid;
+	struct gmonparam *p;
+
+	if( section_last >= 0 ) {
+		p = &_gmonparam[section_last];
+		if( (pc >= p->lowpc) && (pc < p->highpc) ) {
+			return section_last;
+		}
+	}
+
+	while( lo <= hi ) {
+		mid = (lo + hi) >> 1;
+		p = &_gmonparam[section_order[mid]];
+		if( pc < p->lowpc ) {
+			hi = mid - 1;
+		} else if( pc >= p->highpc ) {
+			lo = mid + 1;
+		} else {
+			section_last = section_order[mid];
+			return section_last;
+		}
+	}
+	return -1;
+}
+
+/*
+ * Sorts the gmon sections by lowpc and prepares the bin index computation,
+ * called from _profile_init before any instrumented code runs.
+ */
+void profile_fast_init( void )
+{
+	s32 i, j;
+	u16 tmp;
+	u32 width = (u32)4 * binsize;
+
+	section_count = n_gmon_sections;
+	if( section_count > (s32)PROFILE_MAX_SECTIONS ) {
+		section_count = (s32)PROFILE_MAX_SECTIONS;
+	}
+	for( i = 0; i < section_count; i++ ) {
+		section_order[i] = (u16)i;
+	}
+	/* Insertion sort, there are only a handful of sections */
+	for( i = 1; i < section_count; i++ ) {
+		tmp = section_order[i];
+		j = i - 1;
+		while( (j >= 0) &&
+		       (_gmonparam[section_order[j]].lowpc > _gmonparam[tmp].lowpc) ) {
+			section_order[j + 1] = section_order[j];
+			j--;
+		}
+		section_order[j + 1] = tmp;
+	}
+	section_last = -1;
+
+	bin_shift = -1;
+	if( (width != 0U) && ((width & (width - 1U)) == 0U) ) {
+		bin_shift = 0;
+		while( (1U << bin_shift) != width ) {
+			bin_shift++;
+		}
+	}
+
+	profile_fast_reset();
+}
+
+/*
+ * Clears the arcs, pending samples and statistics. The histogram counters
+ * in _gmonparam are left alone.
+ */
+void profile_fast_reset( void )
+{
+	u32 i;
+
+	disable_timer();
+	for( i = 0; i < PROFILE_ARC_HASH_SIZE; i++ ) {
+		arc_table[i].frompc = 0;
+		arc_table[i].selfpc = 0;
+		arc_table[i].count = 0;
+	}
+	sample_active = 0;
+	sample_fill = 0;
+	sample_ready[0] = 0;
+	sample_ready[1] = 0;
+	profile_fast_stats.samples = 0;
+	profile_fast_stats.samples_dropped = 0;
+	profile_fast_stats.samples_outside = 0;
+	profile_fast_stats.arcs = 0;
+	profile_fast_stats.arcs_dropped = 0;
+	profile_fast_stats.max_probe = 0;
+	enable_timer();
+}
+
+/*
+ * The timer is left running: the ISR only touches the sample ring, so
+ * there is nothing to protect here. A call arc from an instrumented
+ * interrupt handler racing with the same slot may lose one count.
+ */
+void mcount( u32 frompc, u32 selfpc )
+{
+	s32 sec;
+	u32 slot;
+	u32 probe;
+	struct profile_arc *arc;
+
+	sec = find_section( frompc );
+	if( sec < 0 ) {
+		return;
+	}
+
+	slot = arc_hash( frompc, selfpc );
+	for( probe = 0; probe < PROFILE_ARC_MAX_PROBE; probe++ ) {
+		arc = &arc_table[slot];
+		if( (arc->frompc == frompc) && (arc->selfpc == selfpc) ) {
+			arc->count++;
+			goto done;
+		}
+		if( arc->count == 0U ) {
+			arc->frompc = frompc;
+			arc->selfpc = selfpc;
+			arc->count = 1;
+			profile_fast_stats.arcs++;
+			goto done;
+		}
+		slot = (slot + 1U) & (PROFILE_ARC_HASH_SIZE - 1U);
+	}
+	profile_fast_stats.arcs_dropped++;
+	_gmonparam[sec].state = GMON_PROF_ERROR;
+	return;
+
+ done:
+	if( probe > profile_fast_stats.max_probe ) {
+		profile_fast_stats.max_probe = probe;
+	}
+	_gmonparam[sec].state = GMON_PROF_ON;
+}
+
+void profile_intr_handler( void )
+{
+	u32 buf = sample_active;
+	u32 fill = sample_fill;
+
+	/* for cortexa9, lr is saved in asm interrupt handler */
+	if( fill == PROFILE_SAMPLE_BUF_SIZE ) {
+		if( sample_ready[buf ^ 1U] != 0U ) {
+			profile_fast_stats.samples_dropped++;
+			timer_ack();
+			return;
+		}
+		sample_ready[buf] = fill;
+		buf ^= 1U;
+		fill = 0;
+		sample_active = buf;
+	}
+	sample_buf[buf][fill] = prof_pc;
+	sample_fill = fill + 1U;
+
+	/* Ack the Timer Interrupt */
+	timer_ack();
+}
+
+static void drain_buffer( u32 buf, u32 count )
+{
+	u32 i;
+	u32 pc;
+	u32 bin;
+	s32 sec;
+	struct gmonparam *p;
+
+	for( i = 0; i < count; i++ ) {
+		pc = sample_buf[buf][i];
+		sec = find_section( pc );
+		if( sec < 0 ) {
+			profile_fast_stats.samples_outside++;
+			continue;
+		}
+		p = &_gmonparam[sec];
+		if( bin_shift >= 0 ) {
+			bin = (pc - p->lowpc) >> bin_shift;
+		} else {
+			bin = (pc - p->lowpc) / ((u32)4 * binsize);
+		}
+		if( bin < p->kcountsize ) {
+			p->kcount[bin]++;
+			profile_fast_stats.samples++;
+		}
+	}
+}
+
+/*
+ * Adds the samples of the completed ring halves to the histogram. With
+ * flush set the partially filled active half is handed over as well, the
+ * timer is stopped for the few cycles needed to detach it. If the other
+ * half is still pending then, it is drained first with the timer stopped,
+ * so that no sample is left behind.
+ */
+void profile_fast_drain( u32 flush )
+{
+	u32 buf;
+	u32 count;
+
+	if( flush != 0U ) {
+		disable_timer();
+		buf = sample_active;
+		count = sample_fill;
+		if( count != 0U ) {
+			if( sample_ready[buf ^ 1U] != 0U ) {
+				drain_buffer( buf ^ 1U, sample_ready[buf ^ 1U] );
+				sample_ready[buf ^ 1U] = 0;
+			}
+			sample_ready[buf] = count;
+			sample_active = buf ^ 1U;
+			sample_fill = 0;
+		}
+		enable_timer();
+	}
+
+	for( buf = 0; buf < 2U; buf++ ) {
+		count = sample_ready[buf];
+		if( count != 0U ) {
+			drain_buffer( buf, count );
+			sample_ready[buf] = 0;
+		}
+	}
+}
+
+u32 profile_fast_arc_count( void )
+{
+	return profile_fast_stats.arcs;
+}
+
+const struct profile_arc *profile_fast_arc_table( void )
+{
+	return arc_table;
+}
+
+#endif		/* PROFILE_FAST */
@@ -0,0 +1,85 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*
+ * Low overhead profiling backend, selected by defining PROFILE_FAST when
+ * building the profile library.
+ *
+ * - mcount records call arcs in an open addressed hash table keyed on
+ *   (frompc, selfpc) instead of scanning the froms/tos lists.
+ * - The gmon section of a pc is found with a binary search over the
+ *   sections sorted by lowpc, with the last hit checked first.
+ * - profile_intr_handler only stores the sampled pc in a double buffered
+ *   ring, the histogram is updated by profile_fast_drain() which the
+ *   application calls outside interrupt context (idle loop, before exit).
+ * - profile_fast_write_gmon() emits a gmon.out compatible stream through
+ *   a byte sink, sinks for DCC and the stdout UART are provided.
+ */
+
+#ifndef	PROFILE_FAST_H
+#define	PROFILE_FAST_H	1
+
+#include "xil_types.h"
+#include "profile.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of arc slots, must be a power of 2 */
+#ifndef PROFILE_ARC_HASH_SIZE
+#define PROFILE_ARC_HASH_SIZE	4096U
+#endif
+
+/* Slots probed before an arc is dropped */
+#ifndef PROFILE_ARC_MAX_PROBE
+#define PROFILE_ARC_MAX_PROBE	32U
+#endif
+
+/* Samples per half of the sample ring */
+#ifndef PROFILE_SAMPLE_BUF_SIZE
+#define PROFILE_SAMPLE_BUF_SIZE	1024U
+#endif
+
+/* Maximum number of gmon sections handled by the section search */
+#ifndef PROFILE_MAX_SECTIONS
+#define PROFILE_MAX_SECTIONS	16U
+#endif
+
+struct profile_arc {
+	u32 frompc;
+	u32 selfpc;
+	u32 count;
+};
+
+struct profile_fast_stats {
+	u32 samples;		/* Samples added to the histogram */
+	u32 samples_dropped;	/* Samples lost because both halves were full */
+	u32 samples_outside;	/* Samples outside of every gmon section */
+	u32 arcs;		/* Distinct arcs in the hash table */
+	u32 arcs_dropped;	/* Calls lost because the probe limit was hit */
+	u32 max_probe;		/* Longest probe sequence seen */
+};
+
+/* Byte sink used by the gmon writer */
+typedef void (*profile_putc_t)(u8 c, void *ref);
+
+extern struct profile_fast_stats profile_fast_stats;
+
+void profile_fast_init( void );
+void profile_fast_drain( u32 flush );
+void profile_fast_reset( void );
+u32 profile_fast_arc_count( void );
+const struct profile_arc *profile_fast_arc_table( void );
+void profile_fast_write_gmon( profile_putc_t sink, void *ref );
+
+void profile_gmon_uart_putc( u8 c, void *ref );
+void profile_gmon_dcc_putc( u8 c, void *ref );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif 		/* PROFILE_FAST_H */
@@ -0,0 +1,120 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+#include "profile.h"
+#include "profile_fast.h"
+#include "_profile_timer_hw.h"
+#include "bspconfig.h"
+#include "xparameters.h"
+
+#ifdef PROFILE_FAST
+
+#ifdef XPAR_XCORESIGHTPS_DCC_0_BASEADDR
+#include "xcoresightpsdcc.h"
+#endif
+
+/*
+ * gmon.out layout as read by gprof: a 20 byte header followed by tagged
+ * records, all words in target byte order.
+ */
+#define GMON_MAGIC		"gmon"
+#define GMON_VERSION		1U
+#define GMON_TAG_TIME_HIST	0U
+#define GMON_TAG_CG_ARC		1U
+#define GMON_HIST_DIMEN_LEN	15U
+
+extern u32 sample_freq_hz ;
+
+void outbyte(char c);
+
+static void put_bytes( profile_putc_t sink, void *ref, const u8 *buf, u32 len )
+{
+	u32 i;
+
+	for( i = 0; i < len; i++ ) {
+		sink( buf[i], ref );
+	}
+}
+
+static void put_word( profile_putc_t sink, void *ref, u32 val )
+{
+	put_bytes( sink, ref, (const u8 *)&val, (u32)sizeof(val) );
+}
+
+/*
+ * Writes the histogram of every gmon section and all recorded call arcs.
+ * Pending samples are drained first, the timer is stopped while writing
+ * so the output is a consistent snapshot.
+ */
+void profile_fast_write_gmon( profile_putc_t sink, void *ref )
+{
+	static const char dimen[GMON_HIST_DIMEN_LEN] = "seconds";
+	const struct profile_arc *arcs = profile_fast_arc_table();
+	struct gmonparam *p;
+	s32 j;
+	u32 i;
+
+	profile_fast_drain( 1U );
+	disable_timer();
+
+	put_bytes( sink, ref, (const u8 *)GMON_MAGIC, 4U );
+	put_word( sink, ref, GMON_VERSION );
+	for( i = 0; i < 12U; i++ ) {
+		sink( 0U, ref );
+	}
+
+	for( j = 0; j < n_gmon_sections; j++ ) {
+		p = &_gmonparam[j];
+		sink( (u8)GMON_TAG_TIME_HIST, ref );
+		put_word( sink, ref, p->lowpc );
+		put_word( sink, ref, p->highpc );
+		put_word( sink, ref, p->kcountsize );
+		put_word( sink, ref, sample_freq_hz );
+		put_bytes( sink, ref, (const u8 *)dimen, GMON_HIST_DIMEN_LEN );
+		sink( (u8)'s', ref );
+		put_bytes( sink, ref, (const u8 *)p->kcount,
+			   p->kcountsize * (u32)sizeof(HISTCOUNTER) );
+	}
+
+	for( i = 0; i < PROFILE_ARC_HASH_SIZE; i++ ) {
+		if( arcs[i].count != 0U ) {
+			sink( (u8)GMON_TAG_CG_ARC, ref );
+			put_word( sink, ref, arcs[i].frompc );
+			put_word( sink, ref, arcs[i].selfpc );
+			put_word( sink, ref, arcs[i].count );
+		}
+	}
+
+	enable_timer();
+}
+
+/*
+ * Byte sink for the stdout UART, ref is unused.
+ */
+void profile_gmon_uart_putc( u8 c, void *ref )
+{
+	(void)ref;
+	outbyte( (char)c );
+}
+
+/*
+ * Byte sink for the CoreSight DCC, ref is the DCC base address or NULL
+ * for the first instance.
+ */
+void profile_gmon_dcc_putc( u8 c, void *ref )
+{
+#ifdef XPAR_XCORESIGHTPS_DCC_0_BASEADDR
+	u32 base = (ref != NULL) ? (u32)(UINTPTR)ref :
+		   (u32)XPAR_XCORESIGHTPS_DCC_0_BASEADDR;
+
+	XCoresightPs_DccSendByte( base, c );
+#else
+	(void)c;
+	(void)ref;
+#endif
+}
+
+#endif		/* PROFILE_FAST */
@@ -21,6 +21,8 @@
 extern u32 binsize ;
 u32 prof_pc ;
 
+/* With PROFILE_FAST the handler comes from profile_fast.c */
+#ifndef PROFILE_FAST
 void profile_intr_handler( void )
 {
 
@@ -43,3 +45,4 @@ void profile_intr_handler( void )
 	/* Ack the Timer Interrupt */
 	timer_ack();
 }
+#endif		/* PROFILE_FAST */
@@ -130,6 +130,19 @@
  * function by sending a XUSBPS_EP_EVENT_DATA_TX event.
  *
  *
+ * <h3>Streaming</h3>
+ *
+ * For sustained bulk throughput an endpoint direction can be switched to
+ * streaming mode with XUsbPs_StreamStart(). The caller then submits its own
+ * buffers with XUsbPs_StreamSubmit(). A buffer is split over as many
+ * Transfer Descriptors as needed and several buffers can be queued, the
+ * controller moves from one to the next without software involvement.
+ * Completed buffers are returned through the stream callback from the
+ * interrupt handler, which is also the place to submit the next buffer. Data
+ * is never copied, buffers allocated from the DMA buffer pool
+ * (xil_dmapool.h) also skip the cache maintenance.
+ *
+ *
  * <h2>DMA</h2>
  *
  * The driver uses DMA internally to move data from/to memory. This behaviour
@@ -165,6 +178,7 @@
  * 2.5   pm  02/20/20 Added ISO support for usb 2.0 and ch9 common framework
  * 			calls.
  * 2.8   pm  07/07/23 Added support for system device-tree flow.
+ * 2.9   pt  10/19/26 Added bulk streaming API (xusbps_stream.c).
  * </pre>
  *
  ******************************************************************************/
@@ -307,6 +321,13 @@ extern "C" {
 #define XUSBPS_MAX_PACKET_SIZE		1024
 /**< Maximum value can be put into the queue head */
 /* @} */
+
+/*
+ * Number of buffers that can be queued on a stream
+ */
+#ifndef XUSBPS_STREAM_MAX_XFERS
+#define XUSBPS_STREAM_MAX_XFERS		16
+#endif
 /**************************** Type Definitions *******************************/
 
 /******************************************************************************
@@ -350,6 +371,25 @@ typedef void (*XUsbPs_EpIsoHandlerFunc)(void *CallBackRef,
  */
 typedef void (*XUsbPs_IntrHandlerFunc)(void *CallBackRef, u32 IrqMask);
 
+/******************************************************************************
+ * This data type defines the callback function to be used for streaming
+ * endpoints. It is called from interrupt context once per completed buffer,
+ * in submission order.
+ *
+ * @param	CallBackRef is the Callback reference passed to
+ *		XUsbPs_StreamStart().
+ * @param	BufferPtr is the buffer passed to XUsbPs_StreamSubmit().
+ * @param	BufferLen is the length passed to XUsbPs_StreamSubmit().
+ * @param	BytesTxed is the number of bytes sent or received.
+ * @param	Status is XST_SUCCESS, XST_FAILURE if the controller reported
+ *		a transaction error or XST_DATA_LOST if the stream was
+ *		stopped or the bus was reset before the buffer completed.
+ */
+typedef void (*XUsbPs_StreamHandlerFunc)(void *CallBackRef, u8 *BufferPtr,
+		u32 BufferLen, u32 BytesTxed, s32 Status);
+
+typedef struct XUsbPs_Stream XUsbPs_Stream;
+
 
 /******************************************************************************/
 
@@ -394,6 +434,8 @@ typedef struct {
 	u8	*BufferPtr;		/**< Buffer location */
 	u8 MemAlloted;		/**< Mem alloted and data is not received */
 	u32	Interval;		/**< Data transfer service interval */
+	XUsbPs_Stream	*Stream;	/**< Streaming state, NULL if not
+					  streaming */
 } XUsbPs_EpOut;
 
 
@@ -423,6 +465,8 @@ typedef struct {
 	u32	BytesTxed;		/**< Actual Bytes transferred */
 	u8	*BufferPtr;		/**< Buffer location */
 	u32	Interval;		/**< Data transfer service interval */
+	XUsbPs_Stream	*Stream;	/**< Streaming state, NULL if not
+					  streaming */
 } XUsbPs_EpIn;
 
 
@@ -598,6 +642,46 @@ typedef struct {
 	void *data_ptr;		/* pointer for storing applications data */
 } XUsbPs;
 
+/**
+ * One buffer queued on a stream.
+ */
+typedef struct {
+	u8	*BufferPtr;	/**< Caller buffer */
+	u32	BufferLen;	/**< Requested length */
+	XUsbPs_dTD *dTDFirst;	/**< First descriptor of the buffer */
+	u32	NumdTD;		/**< Descriptors used by the buffer */
+} XUsbPs_StreamXfer;
+
+/**
+ * Streaming state of one endpoint direction. Allocated by the caller and
+ * passed to XUsbPs_StreamStart(). The members MUST NOT be modified by the
+ * upper layers.
+ */
+struct XUsbPs_Stream {
+	XUsbPs	*InstancePtr;
+	u8	EpNum;
+	u8	Direction;		/**< XUSBPS_EP_DIRECTION_IN or _OUT */
+	u32	PrimeMask;		/**< Endpoint bit in the prime register */
+
+	XUsbPs_dTD *dTDs;		/**< Descriptor ring of the endpoint */
+	u32	NumdTD;
+	XUsbPs_dTD *dTDHead;		/**< Next free descriptor */
+	u32	dTDFree;		/**< Free descriptors, one is always
+					  kept as list terminator */
+
+	XUsbPs_StreamXfer Xfer[XUSBPS_STREAM_MAX_XFERS];
+	u32	XferHead;		/**< Next slot to fill */
+	u32	XferTail;		/**< Oldest buffer in flight */
+
+	XUsbPs_StreamHandlerFunc HandlerFunc;
+	void	*HandlerRef;
+
+	u32	BytesDone;		/**< Bytes transferred, wraps */
+	u32	XfersDone;		/**< Buffers completed */
+	u32	Reprimes;		/**< Endpoint primes from the interrupt
+					  handler */
+};
+
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
@@ -1129,6 +1213,19 @@ void XUsbPs_EpGetData(XUsbPs *InstancePtr, u8 EpNum, u32 BufferLen);
 
 s32 XUsbPs_EpDataBufferReceive(XUsbPs *InstancePtr, u8 EpNum,
 			       u8 *BufferPtr, u32 BufferLen);
+
+/*
+ * Bulk streaming functions
+ *
+ * Implemented in file xusbps_stream.c
+ */
+int XUsbPs_StreamStart(XUsbPs *InstancePtr, XUsbPs_Stream *StreamPtr,
+		       u8 EpNum, u8 Direction,
+		       XUsbPs_StreamHandlerFunc CallBackFunc, void *CallBackRef);
+int XUsbPs_StreamSubmit(XUsbPs_Stream *StreamPtr, u8 *BufferPtr,
+			u32 BufferLen);
+void XUsbPs_StreamStop(XUsbPs_Stream *StreamPtr);
+u32 XUsbPs_StreamPending(const XUsbPs_Stream *StreamPtr);
 /*
  * Helper functions for static configuration.
  * Implemented in xusbps_sinit.c
@@ -30,6 +30,9 @@
  *            (moving of dTD Head/Tail Pointers)and CR#873974(invalidate
  *            Caches After Buffer Receive in Endpoint Buffer Handler...)
  * 2.5   pm  02/20/20 Added ISO endpoint support.
+ * 2.9   pt  10/19/26 Skip cache maintenance for DMA pool buffers.
+ *                    Made XUsbPs_dTDAttachBuffer available to the
+ *                    streaming code and cleared the endpoint stream state.
  * </pre>
  ******************************************************************************/
 
@@ -52,8 +55,6 @@
 static void XUsbPs_EpListInit(XUsbPs_DeviceConfig *DevCfgPtr);
 static void XUsbPs_dQHInit(XUsbPs_DeviceConfig *DevCfgPtr);
 static int  XUsbPs_dTDInit(XUsbPs_DeviceConfig *DevCfgPtr);
-static int  XUsbPs_dTDAttachBuffer(XUsbPs_dTD *dTDPtr,
-				   const u8 *BufferPtr, u32 BufferLen);
 
 static void XUsbPs_dQHSetMaxPacketLenISO(XUsbPs_dQH *dQHPtr, u32 Len);
 
@@ -258,7 +259,12 @@ static int XUsbPs_EpQueueRequest(XUsbPs *InstancePtr, u8 EpNum,
 	Ep = &InstancePtr->DeviceConfig.Ep[EpNum].In;
 	EpType = InstancePtr->DeviceConfig.EpCfg[EpNum].In.Type;
 
-	Xil_DCacheFlushRange((unsigned int)BufferPtr, BufferLen);
+	if (XUSBPS_BUF_IS_COHERENT(BufferPtr) == 0U) {
+		Xil_DCacheFlushRange((unsigned int)BufferPtr, BufferLen);
+	} else {
+		/* Order the CPU writes before the dTD is primed */
+		dsb();
+	}
 
 	if (Ep->dTDTail != Ep->dTDHead) {
 		PipeEmpty = 0;
@@ -431,8 +437,10 @@ void XUsbPs_EpGetData(XUsbPs *InstancePtr, u8 EpNum, u32 BufferLen)
 			InavalidateLen = (BufferLen / 32) * 32 + 32;
 		}
 
-		Xil_DCacheInvalidateRange((unsigned int)DataBuff,
-					  InavalidateLen);
+		if (XUSBPS_BUF_IS_COHERENT(DataBuff) == 0U) {
+			Xil_DCacheInvalidateRange((unsigned int)DataBuff,
+						  InavalidateLen);
+		}
 
 		memcpy(Ep->BufferPtr, DataBuff,  BufferLen);
 
@@ -1017,6 +1025,8 @@ static void XUsbPs_EpListInit(XUsbPs_DeviceConfig *DevCfgPtr)
 		Ep[EpNum].In.HandlerFunc  = NULL;
 		Ep[EpNum].Out.HandlerIsoFunc = NULL;
 		Ep[EpNum].In.HandlerIsoFunc  = NULL;
+		Ep[EpNum].Out.Stream = NULL;
+		Ep[EpNum].In.Stream  = NULL;
 	}
 }
 
@@ -1254,8 +1264,8 @@ static int XUsbPs_dTDInit(XUsbPs_DeviceConfig *DevCfgPtr)
  * 		caller of this function.
  *
  ******************************************************************************/
-static int XUsbPs_dTDAttachBuffer(XUsbPs_dTD *dTDPtr,
-				  const u8 *BufferPtr, u32 BufferLen)
+int XUsbPs_dTDAttachBuffer(XUsbPs_dTD *dTDPtr,
+			   const u8 *BufferPtr, u32 BufferLen)
 {
 	u32	BufAddr;
 	u32	BufEnd;
@@ -24,6 +24,8 @@
  * 2.3   bss 01/19/16 Modified XUsbPs_EpQueueRequest function to fix CR#873972
  *            (moving of dTD Head/Tail Pointers properly).
  * 2.5   pm  02/20/20 Added ISO endpoint support.
+ * 2.9   pt  10/19/26 Hand completions and bus resets of streaming endpoints
+ *                    to xusbps_stream.c.
  * </pre>
  ******************************************************************************/
 
@@ -244,6 +246,10 @@ static void XUsbPs_IntrHandleTX(XUsbPs *InstancePtr, u32 EpCompl)
 		 * which ones are completed.
 		 */
 		Ep = &InstancePtr->DeviceConfig.Ep[Index].In;
+		if (Ep->Stream != NULL) {
+			XUsbPs_StreamHandleCompl(Ep->Stream);
+			continue;
+		}
 		do {
 
 			XUsbPs_dTDInvalidateCache(Ep->dTDTail);
@@ -318,6 +324,10 @@ static void XUsbPs_IntrHandleRX(XUsbPs *InstancePtr, u32 EpCompl)
 			continue;
 		}
 		Ep = &InstancePtr->DeviceConfig.Ep[Index].Out;
+		if (Ep->Stream != NULL) {
+			XUsbPs_StreamHandleCompl(Ep->Stream);
+			continue;
+		}
 
 		XUsbPs_dTDInvalidateCache(Ep->dTDCurr);
 
@@ -428,6 +438,19 @@ static void XUsbPs_IntrHandleReset(XUsbPs *InstancePtr, u32 IrqSts)
 	XUsbPs_WriteReg(InstancePtr->Config.BaseAddress,
 			XUSBPS_EPFLUSH_OFFSET, 0xFFFFFFFF);
 
+	/* Queued stream buffers are lost with the flush, hand them back. */
+	for (Index = 0; Index < InstancePtr->DeviceConfig.NumEndpoints;
+	     Index++) {
+		if (InstancePtr->DeviceConfig.Ep[Index].Out.Stream != NULL) {
+			XUsbPs_StreamReset(
+				InstancePtr->DeviceConfig.Ep[Index].Out.Stream);
+		}
+		if (InstancePtr->DeviceConfig.Ep[Index].In.Stream != NULL) {
+			XUsbPs_StreamReset(
+				InstancePtr->DeviceConfig.Ep[Index].In.Stream);
+		}
+	}
+
 	/* Make sure that the reset bit in XUSBPS_PORTSCR1_OFFSET is
 	 * still set at this point. If the code gets to this point and
 	 * the reset bit has already been cleared we are in trouble and
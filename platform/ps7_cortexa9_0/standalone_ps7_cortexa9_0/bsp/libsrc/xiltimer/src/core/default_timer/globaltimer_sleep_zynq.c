@@ -21,6 +21,7 @@
  * ----- ---- -------- -------------------------------------------------------
  * 1.0  adk	 24/11/21 Initial release.
  * 1.1	adk      08/08/22 Added doxygen tags.
+* 2.1	pt       19/10/26 Sleep in WFI when XIL_WAIT_WFI_SLEEP is defined.
  *</pre>
  *
  *@note
@@ -32,6 +33,9 @@
 #ifdef SDT
 #include "xcortexa9_config.h"
 #endif
+#ifdef XIL_WAIT_WFI_SLEEP
+#include "xil_wait.h"
+#endif
 
 /**************************** Type Definitions *******************************/
 /************************** Constant Definitions *****************************/
@@ -120,11 +124,18 @@ static void XGlobalTimer_ModifyInterval(XTimer *InstancePtr, u32 delay,
 		IsSleepTimerStarted = TRUE;
 	}
 
+#ifdef XIL_WAIT_WFI_SLEEP
+	(void)tEnd;
+	(void)tCur;
+	(void)TimerCountsPersec;
+	Xil_WaitUs(((u64)delay * XTIMER_DELAY_USEC) / (u64)DelayType);
+#else
 	XTime_GetTime(&tCur);
 	tEnd = tCur + (((XTime) delay) * (TimerCountsPersec / DelayType));
         do {
 		XTime_GetTime(&tCur);
         } while (tCur < tEnd);
+#endif
 
 }
 
@@ -173,6 +184,7 @@ u32 XilTickTimer_Init(XTimer *InstancePtr)
 	InstancePtr->XTimer_TickInterval = NULL;
 	InstancePtr->XTickTimer_Stop = NULL;
 	InstancePtr->XTickTimer_ClearInterrupt = NULL;
+	InstancePtr->XTickTimer_OneShot = NULL;
 	return XST_SUCCESS;
 }
 #endif
@@ -28,6 +28,8 @@
 *  1.4  ht      09/12/23 Added code for versioning of library.
 *  1.4  mus     15/02/24 Added correct APIs to set/get MB V frequency.
 *  2.0  ml      28/03/24 Added description to fix doxygen warnings.
+*  2.1  pt      19/10/26 Added XTickTimer_OneShot hook and the tickless
+*  			  software timer wheel.
 * </pre>
 ******************************************************************************/
 #ifndef XILTIMER_H
@@ -90,6 +92,7 @@ typedef void (*XTimer_TickHandler) (void *CallBackRef, u32 StatusEvent);
  * @param XSleepTimer_Stop Stops the sleep timer
  * @param XTickTimer_Stop Stops the tick timer
  * @param XTickTimer_ClearInterrupt Clears the Tick timer interrupt status
+ * @param XTickTimer_OneShot Arms the tick timer for a single interrupt
  * @param Handler Tick Handler
  * @param CallBackRef Callback reference for handler
  * @param AxiTimer_SleepInst Sleep Instance for AxiTimer
@@ -112,6 +115,10 @@ typedef struct XTimerTag {
                                             /**< Stops the tick timer */
 	void (*XTickTimer_ClearInterrupt)(struct XTimerTag *InstancePtr);
 	                                    /**< Clears the Tick timer interrupt status */
+	void (*XTickTimer_OneShot)(struct XTimerTag *InstancePtr, u64 Counts);
+	                                    /**< Arms the tick timer to interrupt
+					         once after Counts sleep timer
+					         counts, 0 disarms it */
 	XTimer_TickHandler Handler;         /**< Callback function */
 	void *CallBackRef;                  /**< Callback reference for handler */
 #ifdef  XPM_SUPPORT
@@ -147,6 +154,65 @@ typedef struct XTimerTag {
 typedef u64 XTime;
 extern XTimer TimerInst;
 
+/**
+ * Software timer wheel geometry. The wheel has XTIMER_WHEEL_LEVELS levels of
+ * XTIMER_WHEEL_SLOTS slots, one wheel tick is 2^XTIMER_WHEEL_RES_SHIFT
+ * XTime counts (12.3 us with a 333 MHz global timer by default).
+ */
+#ifndef XTIMER_WHEEL_RES_SHIFT
+#define XTIMER_WHEEL_RES_SHIFT	12U
+#endif
+#define XTIMER_WHEEL_LEVELS	4U
+#define XTIMER_WHEEL_SLOT_BITS	6U
+#define XTIMER_WHEEL_SLOTS	(1U << XTIMER_WHEEL_SLOT_BITS)
+
+typedef void (*XTimer_SwTimerHandler) (void *CallBackRef);
+
+/**
+ * Software timer. The structure is owned by the caller, must be zeroed before
+ * its first use and must stay valid while the timer is pending. All fields
+ * are private to the wheel.
+ */
+typedef struct XTimer_SwTimerTag {
+	struct XTimer_SwTimerTag *Next;	/**< Next timer in the slot */
+	struct XTimer_SwTimerTag *Prev;	/**< Previous timer in the slot */
+	XTime Deadline;			/**< Expiry time in XTime counts */
+	XTime Period;			/**< Reload period, 0 for one shot */
+	u64 Expires;			/**< Expiry time in wheel ticks */
+	XTimer_SwTimerHandler Handler;	/**< Callback function */
+	void *CallBackRef;		/**< Callback reference for handler */
+	u8 Level;			/**< Wheel level holding the timer */
+	u8 Slot;			/**< Slot holding the timer */
+	u8 IsPending;			/**< Timer is on the wheel */
+} XTimer_SwTimer;
+
+/**
+ * Expiry latency statistics, the latency of a timer is the XTime at which
+ * its handler was called minus its deadline.
+ */
+typedef struct {
+	u32 Expired;		/**< Handlers called */
+	XTime MinLatency;	/**< Smallest latency in XTime counts */
+	XTime MaxLatency;	/**< Largest latency in XTime counts */
+	XTime SumLatency;	/**< Sum of all latencies in XTime counts */
+} XTimer_WheelStats;
+
+/**
+ * Hierarchical timing wheel. Level L slot S holds the timers whose expiry
+ * tick has S in bits [6L, 6L + 5] and lies less than 64^(L + 1) ticks ahead.
+ * Pending holds one bit per occupied slot so the next event is found with
+ * a count trailing zeros instead of a slot scan.
+ */
+typedef struct {
+	XTimer_SwTimer *Slot[XTIMER_WHEEL_LEVELS][XTIMER_WHEEL_SLOTS];
+				/**< Slot list heads */
+	u64 Pending[XTIMER_WHEEL_LEVELS]; /**< Occupied slot bitmaps */
+	XTimer_SwTimer *Expiring;	/**< Timers being expired */
+	u64 Now;		/**< Next wheel tick to process */
+	XTimer *TimerPtr;	/**< Tick timer, NULL when driven by hand */
+	XTimer_WheelStats Stats;	/**< Expiry latency statistics */
+} XTimer_Wheel;
+
 /****************** Macros (Inline Functions) Definitions *********************/
 
 /*****************************************************************************/
@@ -179,6 +245,21 @@ void XTimer_SetInterval(unsigned long delay);
 void XTimer_SetHandler(XTimer_TickHandler FuncPtr, void *CallBackRef,
 		       u8 Priority);
 void XTimer_ClearTickInterrupt( void );
+
+/*
+ * Software timer wheel, xtimer_wheel.c
+ */
+void XTimer_WheelInit(XTimer_Wheel *WheelPtr, XTime Now);
+void XTimer_WheelAdd(XTimer_Wheel *WheelPtr, XTimer_SwTimer *TimerPtr,
+		     XTime Deadline, XTime Period,
+		     XTimer_SwTimerHandler FuncPtr, void *CallBackRef);
+void XTimer_WheelCancel(XTimer_Wheel *WheelPtr, XTimer_SwTimer *TimerPtr);
+void XTimer_WheelAdvance(XTimer_Wheel *WheelPtr, XTime Now);
+u32 XTimer_WheelNextDeadline(XTimer_Wheel *WheelPtr, XTime *DeadlinePtr);
+void XTimer_WheelGetStats(XTimer_Wheel *WheelPtr, XTimer_WheelStats *StatsPtr);
+void XTimer_WheelResetStats(XTimer_Wheel *WheelPtr);
+u32 XTimer_WheelStart(XTimer_Wheel *WheelPtr, u8 Priority);
+void XTimer_WheelIntrHandler(void *CallBackRef, u32 StatusEvent);
 #ifdef XTIMER_DEFAULT_TIMER_IS_MB
 u32 Xil_GetMBFrequency(void);
 u32 Xil_SetMBFrequency(u32 Val);
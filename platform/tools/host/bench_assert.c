@@ -0,0 +1,159 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file bench_assert.c
+*
+* Per call cost of the assert tiers of xil_assert.h on the GPIO and UART
+* paths. The Makefile builds this file three times, with the default
+* asserts, with XIL_ASSERT_PROFILE and with NDEBUG, and every build prints
+* one line.
+*
+* - XGpioPs_WritePin and XGpioPs_ReadPin on rotating pins,
+* - XUartPs_Send of a single byte,
+* - a store to the GPIO data register, the floor of a pin write.
+*
+* The drivers are built without XIL_IO_MODEL and their registers are plain
+* memory mapped at the device addresses, so a register access is a load or
+* store and the asserts are a visible part of the call.
+*
+* The cost is the number of host instructions executed per call, counted
+* by single stepping with the trap flag and less an empty loop. It is
+* exact and repeatable, where the time stamp counter of a virtual machine
+* varies more between runs than the tiers differ. It compares the tiers
+* with each other, the Cortex-A9 code and cycle counts need the target
+* toolchain and a board.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <signal.h>
+
+#include "host.h"
+#include "xgpiops.h"
+#include "xuartps.h"
+#include "xstatus.h"
+
+#if defined (NDEBUG)
+#define TIER	"release"
+#elif defined (XIL_ASSERT_PROFILE)
+#define TIER	"profile"
+#else
+#define TIER	"full"
+#endif
+
+#define CALLS		1000U
+#define PINS		54U
+
+#define OP_WRITE_PIN	0U
+#define OP_READ_PIN	1U
+#define OP_SEND		2U
+#define OP_STORE	3U
+#define OP_NONE		4U
+
+static XGpioPs Gpio;
+static XUartPs Uart;
+static volatile u32 Sink;
+static volatile u64 Steps;
+
+static void Step(int Sig)
+{
+	(void)Sig;
+	Steps++;
+}
+
+/* Sets or clears the trap flag, every instruction in between traps */
+static inline void TraceOn(void)
+{
+	__asm__ volatile("pushf; orl $0x100, (%%rsp); popf" : : : "memory", "cc");
+}
+
+static inline void TraceOff(void)
+{
+	__asm__ volatile("pushf; andl $~0x100, (%%rsp); popf" : : : "memory",
+			 "cc");
+}
+
+static u64 Instructions(u32 Op)
+{
+	u8 Byte = 0x55U;
+	u64 Start;
+	u32 Call;
+	u32 Pin = 0U;
+	u32 Sum = 0U;
+
+	Start = Steps;
+	TraceOn();
+	for (Call = 0U; Call < CALLS; Call++) {
+		switch (Op) {
+		case OP_WRITE_PIN:
+			XGpioPs_WritePin(&Gpio, Pin, Call & 1U);
+			break;
+		case OP_READ_PIN:
+			Sum += XGpioPs_ReadPin(&Gpio, Pin);
+			break;
+		case OP_SEND:
+			Sum += XUartPs_Send(&Uart, &Byte, 1U);
+			break;
+		case OP_STORE:
+			Xil_Out32(Gpio.GpioConfig.BaseAddr +
+				  XGPIOPS_DATA_LSW_OFFSET, Call);
+			break;
+		default:
+			break;
+		}
+		Pin = (Pin == (PINS - 1U)) ? 0U : (Pin + 1U);
+	}
+	TraceOff();
+	Sink = Sum;
+	return Steps - Start;
+}
+
+static double PerCall(u32 Op)
+{
+	return (double)(Instructions(Op) - Instructions(OP_NONE)) / CALLS;
+}
+
+static int Run(void *Arg)
+{
+	XGpioPs_Config *GpioConfig;
+	XUartPs_Config *UartConfig;
+
+	(void)Arg;
+	Host_MapLow(XPAR_XGPIOPS_0_BASEADDR, 0x1000U);
+	Host_MapLow(XPAR_XUARTPS_0_BASEADDR, 0x1000U);
+	GpioConfig = XGpioPs_LookupConfig(XPAR_XGPIOPS_0_BASEADDR);
+	UartConfig = XUartPs_LookupConfig(XPAR_XUARTPS_0_BASEADDR);
+	if ((GpioConfig == NULL) || (UartConfig == NULL) ||
+	    (XGpioPs_CfgInitialize(&Gpio, GpioConfig,
+				   GpioConfig->BaseAddr) != XST_SUCCESS) ||
+	    (XUartPs_CfgInitialize(&Uart, UartConfig,
+				   UartConfig->BaseAddress) != XST_SUCCESS)) {
+		printf("assert: driver init failed\n");
+		return 1;
+	}
+
+	signal(SIGTRAP, Step);
+	printf("assert %-7s  host instructions per call: WritePin %5.1f  "
+	       "ReadPin %5.1f  UartPs_Send %5.1f  register store %4.1f\n",
+	       TIER, PerCall(OP_WRITE_PIN), PerCall(OP_READ_PIN),
+	       PerCall(OP_SEND), PerCall(OP_STORE));
+	return 0;
+}
+
+int main(void)
+{
+	Host_Init();
+	return Host_RunLow(Run, NULL);
+}
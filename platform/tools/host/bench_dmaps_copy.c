@@ -0,0 +1,525 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file bench_dmaps_copy.c
+*
+* CPU copy against DMA copy for the CPU threshold of the copy engine of
+* xdmaps_copy.c, against models/dmaps_model.c.
+*
+* - Copies of 64 bytes to 64 KB, aligned to a cache line, once with
+*   Xil_MemCpy and once with XDmaPs_MemCpyAsync and CpuThreshold 0 on an
+*   engine in poll mode, finished by XDmaPs_CopyService. This is done for
+*   cacheable buffers and again with the buffers in the coherent pool of
+*   xil_dmapool.h, which the engine does no cache maintenance for. Every
+*   copy is checked, as are copies of odd lengths and alignments and a
+*   copy split in pieces over the channels, with the default threshold.
+* - For each length: the instructions of Xil_MemCpy, of the DMA submit and
+*   of the completion, the register accesses and the cache lines the DMA
+*   path maintains.
+* - CPU time of each path and latency of each path for a set of assumed
+*   costs, and for each set the crossovers: the length from which the DMA
+*   path costs the CPU less time, which is what CpuThreshold decides, and
+*   the length from which it finishes first.
+*
+* Instructions are host instructions, counted by single stepping with the
+* trap flag, see bench_assert.c. The register accesses, CPSR accesses,
+* barriers and range cache operations of the driver go through wrappers
+* (see the Makefile) that stop counting for the host runtime and the
+* model, each is counted as one instruction. A register access costs its
+* modeled access time, a range cache operation one instruction plus the
+* cache line time for every line it covers.
+*
+* The assumptions are printed with the results:
+* - one host instruction stands for one Cortex-A9 instruction, which
+*   executes in a given time, swept from one instruction per cycle at the
+*   CPU clock of xparameters.h to one per four cycles. Xil_MemCpy is
+*   built without vectorization, one load and one store per word as in
+*   the target build. This is a copy out of the caches, a copy from DDR
+*   takes longer and moves the crossovers down.
+* - the register access time, as in bench_wait.c.
+* - the time to clean or invalidate one line by address, swept.
+*   Xil_DCacheFlushRange does a CP15 operation for L1, a write of the
+*   address to the L2 controller and an L2 sync per line, so a line costs
+*   at least two register accesses of the bus to the L2 controller.
+* - the DMA time per 8 byte beat, swept, for the latency only.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <signal.h>
+#include <string.h>
+
+#include "host.h"
+#include "dmaps_model.h"
+#include "xdmaps.h"
+#include "xil_cache.h"
+#include "xil_mem.h"
+#include "xparameters.h"
+#include "xstatus.h"
+
+/* Assumed, see the file comment */
+#define ACCESS_NS	100U
+
+#define LINE_BYTES	32U
+#define MAX_LEN		0x10000U
+#define SPLIT_LEN	300000U		/* Three pieces */
+#define TIMEOUT_US	100000U
+#define CPU_NS		(1e9 / (double)XPAR_CPU_CORE_CLOCK_FREQ_HZ)
+
+/* Defined in xil_cache.c, whose maintenance host_rt.c replaces */
+UINTPTR XilDmaPoolCoherentBase;
+u32 XilDmaPoolCoherentSize;
+
+typedef struct {
+	u64 Insn;
+	u64 Calls;		/* Of the wrappers */
+	u64 Lines;
+	u64 Ns;			/* Modeled, the register accesses */
+} Cost;
+
+typedef struct {
+	u32 Len;
+	u64 CpuInsn;		/* Xil_MemCpy */
+	Cost Submit;
+	Cost Service;
+	u64 Beats;
+} Sample;
+
+static DmaPsModel Dma;
+static XDmaPs DmaInst;
+static XDmaPs_CopyEngine Engine;
+static u8 *Src;
+static u8 *Dst;
+static Sample Samples[2][32];		/* Cacheable, coherent */
+static u32 SampleCount;
+
+static volatile u64 Steps;
+static u32 Tracing;
+static u64 WrapCalls;
+static u64 WrapLines;
+static u32 Seed = 38U;
+
+u64 BenchIoRead(UINTPTR Addr, u32 Size);
+void BenchIoWrite(UINTPTR Addr, u64 Value, u32 Size);
+u32 BenchCpsrRead(void);
+void BenchCpsrWrite(u32 Value);
+void BenchBarrier(u32 Kind);
+void BenchFlushRange(INTPTR Addr, u32 Len);
+void BenchInvalRange(INTPTR Addr, u32 Len);
+
+static u32 Rand(void)
+{
+	Seed = (Seed * 1103515245U) + 12345U;
+	return Seed >> 8;
+}
+
+static void Step(int Sig)
+{
+	(void)Sig;
+	Steps++;
+}
+
+static inline void TraceOn(void)
+{
+	__asm__ volatile("pushf; orl $0x100, (%%rsp); popf" : : : "memory", "cc");
+}
+
+static inline void TraceOff(void)
+{
+	__asm__ volatile("pushf; andl $~0x100, (%%rsp); popf" : : : "memory",
+			 "cc");
+}
+
+/*
+ * Wrappers of the driver, the host code they call is not counted
+ */
+static void Pause(void)
+{
+	if (Tracing != 0U) {
+		TraceOff();
+	}
+	WrapCalls++;
+}
+
+static void Resume(void)
+{
+	if (Tracing != 0U) {
+		TraceOn();
+	}
+}
+
+static u64 RangeLines(INTPTR Addr, u32 Len)
+{
+	if (Len == 0U) {
+		return 0U;
+	}
+	return (((u64)Addr + Len + LINE_BYTES - 1U) / LINE_BYTES) -
+	       ((u64)Addr / LINE_BYTES);
+}
+
+u64 BenchIoRead(UINTPTR Addr, u32 Size)
+{
+	u64 Value;
+
+	Pause();
+	Value = Xil_IoModelRead(Addr, Size);
+	Resume();
+	return Value;
+}
+
+void BenchIoWrite(UINTPTR Addr, u64 Value, u32 Size)
+{
+	Pause();
+	Xil_IoModelWrite(Addr, Value, Size);
+	Resume();
+}
+
+u32 BenchCpsrRead(void)
+{
+	u32 Value;
+
+	Pause();
+	Value = HostCpsrRead();
+	Resume();
+	return Value;
+}
+
+void BenchCpsrWrite(u32 Value)
+{
+	Pause();
+	HostCpsrWrite(Value);
+	Resume();
+}
+
+void BenchBarrier(u32 Kind)
+{
+	Pause();
+	HostBarrier(Kind);
+	Resume();
+}
+
+void BenchFlushRange(INTPTR Addr, u32 Len)
+{
+	Pause();
+	WrapLines += RangeLines(Addr, Len);
+	Xil_DCacheFlushRange(Addr, Len);
+	Resume();
+}
+
+void BenchInvalRange(INTPTR Addr, u32 Len)
+{
+	Pause();
+	WrapLines += RangeLines(Addr, Len);
+	Xil_DCacheInvalidateRange(Addr, Len);
+	Resume();
+}
+
+static void Begin(Cost *C)
+{
+	C->Insn = Steps;
+	C->Calls = WrapCalls;
+	C->Lines = WrapLines;
+	C->Ns = Host_Now();
+	Tracing = 1U;
+	TraceOn();
+}
+
+static void End(Cost *C)
+{
+	TraceOff();
+	Tracing = 0U;
+	C->Insn = Steps - C->Insn;
+	C->Calls = WrapCalls - C->Calls;
+	C->Lines = WrapLines - C->Lines;
+	C->Ns = Host_Now() - C->Ns;
+}
+
+/* Counted instructions of a loop of N wrapper calls, and of an empty one */
+static double WrapperInsn(void)
+{
+	const u32 Calls = 1000U;
+	Cost Wrapped;
+	Cost Empty;
+	u32 Index;
+
+	Begin(&Wrapped);
+	for (Index = 0U; Index < Calls; Index++) {
+		BenchBarrier(HOST_BARRIER_DMB);
+	}
+	End(&Wrapped);
+	Begin(&Empty);
+	for (Index = 0U; Index < Calls; Index++) {
+		__asm__ volatile("" : : : "memory");
+	}
+	End(&Empty);
+	return (double)(Wrapped.Insn - Empty.Insn) / Calls;
+}
+
+static void Fill(u8 *Buf, u32 Len)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < Len; Index++) {
+		Buf[Index] = (u8)Rand();
+	}
+}
+
+static void Measure(u32 Len, Sample *S)
+{
+	XDmaPs_CopyToken Token;
+	Cost Cpu;
+
+	S->Len = Len;
+	Fill(Src, Len);
+	memset(Dst, 0, Len);
+	Begin(&Cpu);
+	Xil_MemCpy(Dst, Src, Len);
+	End(&Cpu);
+	S->CpuInsn = Cpu.Insn;
+	HOST_CHECK(memcmp(Dst, Src, Len) == 0);
+
+	Fill(Src, Len);
+	memset(Dst, 0, Len);
+	Engine.CpuThreshold = 0U;
+	Begin(&S->Submit);
+	HOST_CHECK_EQ(XDmaPs_MemCpyAsync(&Engine, Dst, Src, Len, &Token),
+		      XST_SUCCESS);
+	End(&S->Submit);
+	HOST_CHECK_EQ(Dma.Chan[0].Running, 1U);
+	S->Beats = Dma.Beats;
+	Host_AdvanceTo(Dma.Chan[0].DoneAt);
+	S->Beats = Dma.Beats - S->Beats;
+	Begin(&S->Service);
+	XDmaPs_CopyService(&Engine);
+	End(&S->Service);
+	HOST_CHECK(XDmaPs_CopyIsDone(&Engine, Token) != 0);
+	HOST_CHECK(memcmp(Dst, Src, Len) == 0);
+	Engine.CpuThreshold = XDMAPS_COPY_CPU_THRESHOLD;
+}
+
+/* Copies through the engine with the default threshold, all checked */
+static void CheckCopies(void)
+{
+	static const u32 Lens[] = { 1U, 7U, 100U, 1000U, 4099U, 8191U,
+				    20000U, 65535U };
+	XDmaPs_CopyToken Token;
+	u32 Index;
+	u32 Offset;
+	u32 Len;
+
+	for (Index = 0U; Index < (sizeof(Lens) / sizeof(Lens[0])); Index++) {
+		for (Offset = 0U; Offset < 16U; Offset += 5U) {
+			Len = Lens[Index];
+			Fill(Src, Len + 16U);
+			memset(Dst, 0, Len + 32U);
+			HOST_CHECK_EQ(XDmaPs_MemCpyAsync(&Engine, Dst + Offset,
+							 Src + Offset, Len,
+							 &Token), XST_SUCCESS);
+			HOST_CHECK_EQ(XDmaPs_CopyWait(&Engine, Token,
+						      TIMEOUT_US), XST_SUCCESS);
+			HOST_CHECK(memcmp(Dst + Offset, Src + Offset, Len) == 0);
+			HOST_CHECK_EQ(Dst[Offset + Len], 0U);
+		}
+	}
+
+	Fill(Src, SPLIT_LEN);
+	memset(Dst, 0, SPLIT_LEN);
+	HOST_CHECK_EQ(XDmaPs_MemCpyAsync(&Engine, Dst, Src, SPLIT_LEN, &Token),
+		      XST_SUCCESS);
+	HOST_CHECK_EQ(XDmaPs_CopyWait(&Engine, Token, TIMEOUT_US), XST_SUCCESS);
+	HOST_CHECK(memcmp(Dst, Src, SPLIT_LEN) == 0);
+	HOST_CHECK_EQ(Dma.Faults, 0U);
+}
+
+/* CPU time in ns of the two paths of sample S */
+static double CpuPathNs(const Sample *S, double InsnNs)
+{
+	return (double)S->CpuInsn * InsnNs;
+}
+
+static double DmaPathNs(const Sample *S, double InsnNs, double LineNs)
+{
+	return ((double)(S->Submit.Insn + S->Service.Insn) * InsnNs) +
+	       (double)(S->Submit.Ns + S->Service.Ns) +
+	       ((double)(S->Submit.Lines + S->Service.Lines) * LineNs);
+}
+
+static double DmaLatencyNs(const Sample *S, double InsnNs, double LineNs,
+			   double BeatNs)
+{
+	return DmaPathNs(S, InsnNs, LineNs) + ((double)S->Beats * BeatNs);
+}
+
+/*
+ * Length from which Diff (DMA less CPU) stays negative, interpolated
+ * between the samples. 0 if the DMA path is always cheaper, MAX_LEN * 2 if
+ * never.
+ */
+static double Crossover(const Sample *Set, const double *Diff)
+{
+	u32 Index = SampleCount;
+
+	while ((Index > 0U) && (Diff[Index - 1U] < 0.0)) {
+		Index--;
+	}
+	if (Index == SampleCount) {
+		return (double)MAX_LEN * 2.0;
+	}
+	if (Index == 0U) {
+		return 0.0;
+	}
+	return Set[Index - 1U].Len +
+	       (((double)(Set[Index].Len - Set[Index - 1U].Len) *
+		 Diff[Index - 1U]) / (Diff[Index - 1U] - Diff[Index]));
+}
+
+static void PrintLen(double Len)
+{
+	if (Len <= 0.0) {
+		printf("      < %5u", Samples[0][0].Len);
+	} else if (Len > MAX_LEN) {
+		printf("      > %5u", MAX_LEN);
+	} else {
+		printf("      %7.0f", Len);
+	}
+}
+
+static void PrintSet(const char *Name, const Sample *Set)
+{
+	static const double InsnCycles[] = { 1.0, 2.0, 4.0 };
+	static const double LineNs[] = { 20.0, 60.0, 200.0 };
+	static const double BeatNs[] = { 10.0, 20.0, 40.0 };
+	double Diff[32];
+	double InsnNs;
+	const Sample *S;
+	u32 Insn;
+	u32 Line;
+	u32 Beat;
+	u32 Index;
+
+	printf(" %s buffers\n", Name);
+	printf("   length  Xil_MemCpy insn  DMA submit insn  complete insn  "
+	       "reg accesses  cache lines  load beats\n");
+	for (Index = 0U; Index < SampleCount; Index++) {
+		S = &Set[Index];
+		printf("  %7u  %15llu  %15llu  %13llu  %12llu  %11llu  %10llu\n",
+		       S->Len, (unsigned long long)S->CpuInsn,
+		       (unsigned long long)S->Submit.Insn,
+		       (unsigned long long)S->Service.Insn,
+		       (unsigned long long)((S->Submit.Ns + S->Service.Ns) /
+					    ACCESS_NS),
+		       (unsigned long long)(S->Submit.Lines + S->Service.Lines),
+		       (unsigned long long)S->Beats);
+	}
+
+	printf("  crossovers in bytes, DMA ahead from there on\n");
+	printf("   insn ns  line ns   CPU time  latency at beat %4.0f %4.0f "
+	       "%4.0f ns\n", BeatNs[0], BeatNs[1], BeatNs[2]);
+	for (Insn = 0U; Insn < (sizeof(InsnCycles) / sizeof(InsnCycles[0]));
+	     Insn++) {
+		InsnNs = InsnCycles[Insn] * CPU_NS;
+		for (Line = 0U; Line < (sizeof(LineNs) / sizeof(LineNs[0]));
+		     Line++) {
+			printf("  %8.2f  %7.0f", InsnNs, LineNs[Line]);
+			for (Index = 0U; Index < SampleCount; Index++) {
+				Diff[Index] = DmaPathNs(&Set[Index], InsnNs,
+							LineNs[Line]) -
+					      CpuPathNs(&Set[Index], InsnNs);
+			}
+			PrintLen(Crossover(Set, Diff));
+			printf("   ");
+			for (Beat = 0U; Beat < (sizeof(BeatNs) / sizeof(BeatNs[0]));
+			     Beat++) {
+				for (Index = 0U; Index < SampleCount; Index++) {
+					Diff[Index] =
+						DmaLatencyNs(&Set[Index], InsnNs,
+							     LineNs[Line],
+							     BeatNs[Beat]) -
+						CpuPathNs(&Set[Index], InsnNs);
+				}
+				PrintLen(Crossover(Set, Diff));
+			}
+			printf("\n");
+		}
+	}
+}
+
+static int Run(void *Arg)
+{
+	XDmaPs_Config *Config;
+	double Wrapper;
+	u32 Pass;
+	u32 Index;
+	u32 Len;
+	u8 *Buf;
+
+	(void)Arg;
+	/* One block, so that the coherent pass can put both in the pool */
+	Buf = Host_AllocLow(2U * (SPLIT_LEN + 64U), LINE_BYTES);
+	Src = Buf;
+	Dst = Buf + SPLIT_LEN + 64U;
+	Config = XDmaPs_LookupConfig(XPAR_XDMAPS_0_BASEADDR);
+	if ((Config == NULL) ||
+	    (XDmaPs_CfgInitialize(&DmaInst, Config, Config->BaseAddress) !=
+	     XST_SUCCESS) ||
+	    (XDmaPs_CopyInitialize(&Engine, &DmaInst, 0xFFU, 1) !=
+	     XST_SUCCESS)) {
+		printf("dmaps copy: driver init failed\n");
+		return 1;
+	}
+
+	signal(SIGTRAP, Step);
+	Wrapper = WrapperInsn();
+	for (Pass = 0U; Pass < 2U; Pass++) {
+		if (Pass == 1U) {
+			XilDmaPoolCoherentBase = (UINTPTR)Buf;
+			XilDmaPoolCoherentSize = 2U * (SPLIT_LEN + 64U);
+		}
+		SampleCount = 0U;
+		for (Len = 64U; Len <= MAX_LEN; Len *= 2U) {
+			Measure(Len, &Samples[Pass][SampleCount++]);
+			if (Len < MAX_LEN) {
+				Measure(Len + (Len / 2U),
+					&Samples[Pass][SampleCount++]);
+			}
+		}
+		/* each wrapper call is one instruction of the driver */
+		for (Index = 0U; Index < SampleCount; Index++) {
+			Samples[Pass][Index].Submit.Insn -=
+				(u64)((Wrapper - 1.0) *
+				      Samples[Pass][Index].Submit.Calls);
+			Samples[Pass][Index].Service.Insn -=
+				(u64)((Wrapper - 1.0) *
+				      Samples[Pass][Index].Service.Calls);
+		}
+		CheckCopies();
+	}
+
+	printf("dmaps copy: modeled, register access %u ns assumed, counted "
+	       "host instructions, a wrapped call counted %.1f, CPU %.2f MHz\n",
+	       ACCESS_NS, Wrapper, 1e3 / CPU_NS);
+	PrintSet("cacheable", Samples[0]);
+	PrintSet("coherent pool", Samples[1]);
+	printf(" XDMAPS_COPY_CPU_THRESHOLD %u\n", XDMAPS_COPY_CPU_THRESHOLD);
+	return 0;
+}
+
+int main(void)
+{
+	Host_Init();
+	DmaPsModel_Init(&Dma, XPAR_XDMAPS_0_BASEADDR, ACCESS_NS, 20000U);
+	Host_RunLow(Run, NULL);
+	return (Host_Failures != 0U) ? 1 : 0;
+}
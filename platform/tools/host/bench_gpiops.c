@@ -0,0 +1,528 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file bench_gpiops.c
+*
+* Edge to handler latency and sustainable edge rate of the GPIO interrupt
+* dispatch, XGpioPs_IntrHandler with a bank handler that decodes the pins
+* as an application does, against XGpioPs_IntrPinHandler with the per pin
+* handler table and the edge ring, on models/gpiops_model.c.
+*
+* - Dispatch cost: one call of the interrupt handler for pins set pending
+*   in the model, for one pin with one bank enabled, one pin with a pin
+*   enabled on every bank, and one and four pins of two quadrature
+*   encoders on EMIO. Counted are the instructions and register accesses
+*   of the whole call and of the part up to the handler of the first pin,
+*   which with the interrupt entry is the edge to handler latency.
+* - Edge rate: two quadrature encoders on EMIO, both edges of their four
+*   pins enabled, with an edge every Gap ns, a pin toggling every four.
+*   The interrupt is taken whenever the line is high and the CPU idle. An
+*   interrupt costs the entry, the instructions of the dispatch for the
+*   pins pending, from the dispatch cost, and the modeled register
+*   accesses. The highest rate at which 20000 edges are all handled, none
+*   merged into a status bit still set, is searched. With the edge ring,
+*   every edge must be in it in order with a time stamp not before the
+*   edge.
+*
+* Instructions are host instructions, counted by single stepping with the
+* trap flag, see bench_assert.c. The register accesses of the driver and
+* of XTime_GetTime go through wrappers (see the Makefile) that stop the
+* counting for the host runtime and the model, each counts as one
+* instruction. The pin handlers count the edges, an application would do
+* more in them. The instruction time of an interrupt in the edge rate
+* search is spent before the dispatch, which delays the clearing of the
+* status a little and makes the search conservative.
+*
+* The assumptions are printed with the results:
+* - one host instruction stands for one Cortex-A9 instruction, swept from
+*   one instruction per cycle at the CPU clock of xparameters.h to one per
+*   four cycles.
+* - the GPIO register access time, as in bench_wait.c, and the interrupt
+*   entry time, exception entry and the GIC acknowledge and end of
+*   interrupt, as in test_xtimer_wheel.c. Global timer reads cost one tick
+*   of the timer of the host runtime.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <signal.h>
+#include <string.h>
+
+#include "host.h"
+#include "gpiops_model.h"
+#include "xgpiops.h"
+#include "xparameters.h"
+#include "xstatus.h"
+
+/* Assumed, see the file comment */
+#define ACCESS_NS	100U
+#define IRQ_NS		500U
+
+#define RING_LEN	0x8000U
+#define SIM_EDGES	20000U
+#define CPU_NS		(1e9 / (double)XPAR_CPU_CORE_CLOCK_FREQ_HZ)
+
+#define MODE_BANK	0U	/* XGpioPs_IntrHandler and a bank handler */
+#define MODE_PIN	1U	/* XGpioPs_IntrPinHandler */
+#define MODES		2U
+
+#define MAX_SCENARIO_PINS	5U
+
+typedef struct {
+	const char *Name;
+	u32 Enabled[MAX_SCENARIO_PINS];
+	u32 EnabledCount;
+	u32 Pending[MAX_SCENARIO_PINS];
+	u32 PendingCount;
+} Scenario;
+
+typedef struct {
+	u64 Insn;
+	u64 Accesses;
+	u64 Ns;			/* Modeled, the register accesses */
+	u64 FirstInsn;		/* Up to the handler of the first pin */
+	u64 FirstAccesses;
+	u64 FirstNs;
+} Cost;
+
+/* First pin of each bank, as an application decodes the bank status */
+static const u32 BankPins[XGPIOPS_MAX_BANKS] = { 0U, 32U, 54U, 86U };
+
+/* Encoder 1 A and B, encoder 2 A and B, in the order they toggle */
+#define ENC_PINS	4U
+static const u32 EncSeq[ENC_PINS] = { 54U, 56U, 55U, 57U };
+
+static const Scenario Scenarios[] = {
+	{ "1 pin, 1 bank enabled", { 10U }, 1U, { 10U }, 1U },
+	{ "1 pin, 4 banks enabled", { 10U, 40U, 60U, 100U }, 4U, { 100U }, 1U },
+	{ "1 encoder pin, 2 banks", { 10U, 54U, 55U, 56U, 57U }, 5U,
+	  { 54U }, 1U },
+	{ "4 encoder pins, 2 banks", { 10U, 54U, 55U, 56U, 57U }, 5U,
+	  { 54U, 55U, 56U, 57U }, 4U },
+};
+#define SCENARIOS	(sizeof(Scenarios) / sizeof(Scenarios[0]))
+#define SCENARIO_ENC1	2U
+#define SCENARIO_ENC4	3U
+
+static const char *const ModeNames[MODES] = { "IntrHandler", "IntrPinHandler" };
+
+static GpioPsModel Model;
+static XGpioPs Gpio;
+static XGpioPs_PinEntry PinTable[XGPIOPS_DEVICE_MAX_PIN_NUM];
+static XGpioPs_Edge *Ring;
+static u32 Counts[XGPIOPS_DEVICE_MAX_PIN_NUM];
+
+static volatile u64 Steps;
+static u32 Tracing;
+static u64 WrapCalls;
+static u32 FirstSeen;
+static Cost *FirstCost;
+static Cost Start;
+
+/* Edge generator of the rate search */
+static u64 GenStart;
+static u64 GenGap;
+static u32 GenCount;
+static u32 GenPinEdges[ENC_PINS];
+
+u64 BenchIoRead(UINTPTR Addr, u32 Size);
+void BenchIoWrite(UINTPTR Addr, u64 Value, u32 Size);
+
+static void Step(int Sig)
+{
+	(void)Sig;
+	Steps++;
+}
+
+static inline void TraceOn(void)
+{
+	__asm__ volatile("pushf; orl $0x100, (%%rsp); popf" : : : "memory", "cc");
+}
+
+static inline void TraceOff(void)
+{
+	__asm__ volatile("pushf; andl $~0x100, (%%rsp); popf" : : : "memory",
+			 "cc");
+}
+
+/*
+ * Wrappers of the register accesses, the host code they call is not counted
+ */
+u64 BenchIoRead(UINTPTR Addr, u32 Size)
+{
+	u64 Value;
+
+	if (Tracing != 0U) {
+		TraceOff();
+	}
+	WrapCalls++;
+	Value = Xil_IoModelRead(Addr, Size);
+	if (Tracing != 0U) {
+		TraceOn();
+	}
+	return Value;
+}
+
+void BenchIoWrite(UINTPTR Addr, u64 Value, u32 Size)
+{
+	if (Tracing != 0U) {
+		TraceOff();
+	}
+	WrapCalls++;
+	Xil_IoModelWrite(Addr, Value, Size);
+	if (Tracing != 0U) {
+		TraceOn();
+	}
+}
+
+static void Begin(Cost *C)
+{
+	memset(C, 0, sizeof(*C));
+	Start.Insn = Steps;
+	Start.Accesses = WrapCalls;
+	Start.Ns = Host_Now();
+	FirstSeen = 0U;
+	FirstCost = C;
+	Tracing = 1U;
+	TraceOn();
+}
+
+static void End(Cost *C)
+{
+	TraceOff();
+	Tracing = 0U;
+	C->Insn = Steps - Start.Insn;
+	C->Accesses = WrapCalls - Start.Accesses;
+	C->Ns = Host_Now() - Start.Ns;
+	if (FirstSeen != 0U) {
+		C->FirstInsn -= Start.Insn;
+		C->FirstAccesses -= Start.Accesses;
+		C->FirstNs -= Start.Ns;
+	}
+	FirstCost = NULL;
+}
+
+static void PinEdge(void *Ref, u32 Pin)
+{
+	(void)Ref;
+	if ((FirstSeen == 0U) && (FirstCost != NULL)) {
+		FirstSeen = 1U;
+		FirstCost->FirstInsn = Steps;
+		FirstCost->FirstAccesses = WrapCalls;
+		FirstCost->FirstNs = Host_Now();
+	}
+	Counts[Pin]++;
+}
+
+static void BankEdge(void *Ref, u32 Bank, u32 Status)
+{
+	u32 Bit;
+
+	for (Bit = 0U; Bit < 32U; Bit++) {
+		if ((Status & ((u32)1 << Bit)) != 0U) {
+			PinEdge(Ref, BankPins[Bank] + Bit);
+		}
+	}
+}
+
+/* Counted instructions of a wrapped register read, less an empty loop */
+static double WrapperInsn(void)
+{
+	const u32 Calls = 1000U;
+	Cost Wrapped;
+	Cost Empty;
+	u32 Index;
+
+	Begin(&Wrapped);
+	for (Index = 0U; Index < Calls; Index++) {
+		(void)BenchIoRead(XPAR_XGPIOPS_0_BASEADDR + XGPIOPS_DATA_OFFSET,
+				  4U);
+	}
+	End(&Wrapped);
+	Begin(&Empty);
+	for (Index = 0U; Index < Calls; Index++) {
+		__asm__ volatile("" : : : "memory");
+	}
+	End(&Empty);
+	return (double)(Wrapped.Insn - Empty.Insn) / Calls;
+}
+
+static void Setup(u32 Mode, const Scenario *S)
+{
+	XGpioPs_Config *Config;
+	u32 Index;
+	u32 Pin;
+
+	Config = XGpioPs_LookupConfig(XPAR_XGPIOPS_0_BASEADDR);
+	HOST_CHECK(Config != NULL);
+	HOST_CHECK_EQ(XGpioPs_CfgInitialize(&Gpio, Config, Config->BaseAddr),
+		      XST_SUCCESS);
+	if (Mode == MODE_PIN) {
+		XGpioPs_SetPinHandlerTable(&Gpio, PinTable);
+		XGpioPs_SetEdgeRing(&Gpio, Ring, RING_LEN);
+	} else {
+		XGpioPs_SetCallbackHandler(&Gpio, NULL, BankEdge);
+	}
+	for (Index = 0U; Index < S->EnabledCount; Index++) {
+		Pin = S->Enabled[Index];
+		XGpioPs_SetDirectionPin(&Gpio, Pin, 0U);
+		XGpioPs_SetIntrTypePin(&Gpio, Pin, XGPIOPS_IRQ_TYPE_EDGE_BOTH);
+		XGpioPs_IntrClearPin(&Gpio, Pin);
+		XGpioPs_IntrEnablePin(&Gpio, Pin);
+		if (Mode == MODE_PIN) {
+			XGpioPs_SetPinHandler(&Gpio, Pin, PinEdge, NULL);
+		}
+	}
+	memset(Counts, 0, sizeof(Counts));
+}
+
+static void Dispatch(u32 Mode)
+{
+	if (Mode == MODE_PIN) {
+		XGpioPs_IntrPinHandler(&Gpio);
+	} else {
+		XGpioPs_IntrHandler(&Gpio);
+	}
+}
+
+static void Toggle(u32 Pin)
+{
+	GpioPsModel_SetPin(&Model, Pin, GpioPsModel_GetPin(&Model, Pin) ^ 1U);
+}
+
+static void Measure(u32 Mode, const Scenario *S, double Wrapper, Cost *C)
+{
+	u32 Index;
+
+	Setup(Mode, S);
+	for (Index = 0U; Index < S->PendingCount; Index++) {
+		Toggle(S->Pending[Index]);
+	}
+	HOST_CHECK_EQ(GpioPsModel_IrqPending(&Model), 1U);
+	Begin(C);
+	Dispatch(Mode);
+	End(C);
+	HOST_CHECK_EQ(GpioPsModel_IrqPending(&Model), 0U);
+	HOST_CHECK_EQ(FirstSeen, 1U);
+	for (Index = 0U; Index < S->PendingCount; Index++) {
+		HOST_CHECK_EQ(Counts[S->Pending[Index]], 1U);
+	}
+
+	/* each wrapper call is one instruction of the driver */
+	C->Insn -= (u64)((Wrapper - 1.0) * C->Accesses);
+	C->FirstInsn -= (u64)((Wrapper - 1.0) * C->FirstAccesses);
+}
+
+static u32 PendingPins(void)
+{
+	u32 Pins = 0U;
+	u32 Bank;
+
+	for (Bank = 0U; Bank < GPIOPS_MODEL_BANKS; Bank++) {
+		Pins += (u32)__builtin_popcount(GpioPsModel_Pending(&Model,
+								    Bank));
+	}
+	return Pins;
+}
+
+static void EdgeEvent(void *Ref)
+{
+	u32 Index = GenCount % ENC_PINS;
+
+	(void)Ref;
+	Toggle(EncSeq[Index]);
+	GenPinEdges[Index]++;
+	GenCount++;
+	if (GenCount < SIM_EDGES) {
+		Host_Schedule(GenStart + ((u64)(GenCount + 1U) * GenGap),
+			      EdgeEvent, NULL);
+	}
+}
+
+/* Edge time of the Nth edge of encoder pin Index */
+static u64 EdgeAt(u32 Index, u32 N)
+{
+	return GenStart + ((u64)((N * ENC_PINS) + Index + 1U) * GenGap);
+}
+
+static u32 RingCheck(void)
+{
+	XGpioPs_Edge Edge;
+	u32 Seen[ENC_PINS] = { 0U };
+	u64 Last = 0U;
+	u32 Good = 1U;
+	u32 Index;
+
+	while (XGpioPs_GetEdge(&Gpio, &Edge) == XST_SUCCESS) {
+		for (Index = 0U; Index < ENC_PINS; Index++) {
+			if (EncSeq[Index] == Edge.Pin) {
+				break;
+			}
+		}
+		if ((Index == ENC_PINS) || (Edge.Time < Last) ||
+		    (Host_GtNs(Edge.Time) < EdgeAt(Index, Seen[Index]))) {
+			Good = 0U;
+		}
+		if (Index < ENC_PINS) {
+			Seen[Index]++;
+		}
+		Last = Edge.Time;
+	}
+	for (Index = 0U; Index < ENC_PINS; Index++) {
+		if (Seen[Index] != GenPinEdges[Index]) {
+			Good = 0U;
+		}
+	}
+	return ((Good != 0U) && (Gpio.EdgeDropped == 0U)) ? 1U : 0U;
+}
+
+/*
+ * Runs SIM_EDGES encoder edges Gap ns apart, 1 if all of them were handled.
+ * Base and PerPin are the instructions of a dispatch.
+ */
+static u32 Simulate(u32 Mode, u64 Gap, double InsnNs, double Base,
+		    double PerPin)
+{
+	u64 Merged;
+	u32 Handled = 0U;
+	u32 Index;
+
+	Setup(Mode, &Scenarios[SCENARIO_ENC4]);
+	Merged = Model.Merged;
+	GenStart = Host_Now();
+	GenGap = Gap;
+	GenCount = 0U;
+	memset(GenPinEdges, 0, sizeof(GenPinEdges));
+	Host_Schedule(GenStart + Gap, EdgeEvent, NULL);
+
+	while ((GenCount < SIM_EDGES) || (GpioPsModel_IrqPending(&Model) != 0U)) {
+		if (GpioPsModel_IrqPending(&Model) != 0U) {
+			Host_Advance((u64)(IRQ_NS + ((Base + (PerPin *
+						     PendingPins())) * InsnNs)));
+			Dispatch(Mode);
+		} else {
+			Host_AdvanceTo(GenStart + ((u64)(GenCount + 1U) * Gap));
+		}
+	}
+	for (Index = 0U; Index < ENC_PINS; Index++) {
+		Handled += Counts[EncSeq[Index]];
+	}
+	if ((Model.Merged != Merged) || (Handled != SIM_EDGES)) {
+		return 0U;
+	}
+	if (Mode == MODE_PIN) {
+		HOST_CHECK_EQ(RingCheck(), 1U);
+	}
+	return 1U;
+}
+
+/* Smallest gap in ns at which every edge is handled */
+static u64 MinGap(u32 Mode, double InsnNs, double Base, double PerPin)
+{
+	u64 Lo = 10U;		/* Edges lost */
+	u64 Hi = 100000U;	/* All handled */
+	u64 Mid;
+
+	HOST_CHECK_EQ(Simulate(Mode, Hi, InsnNs, Base, PerPin), 1U);
+	while ((Hi - Lo) > ((Hi / 200U) + 1U)) {
+		Mid = (Lo + Hi) / 2U;
+		if (Simulate(Mode, Mid, InsnNs, Base, PerPin) != 0U) {
+			Hi = Mid;
+		} else {
+			Lo = Mid;
+		}
+	}
+	return Hi;
+}
+
+static int Run(void *Arg)
+{
+	static const double InsnCycles[] = { 1.0, 2.0, 4.0 };
+	static Cost Costs[SCENARIOS][MODES];
+	const Cost *C;
+	double Wrapper;
+	double InsnNs;
+	double PerPin;
+	double Base;
+	u32 Mode;
+	u32 Index;
+	u32 Insn;
+
+	(void)Arg;
+	Ring = Host_AllocLow(RING_LEN * sizeof(XGpioPs_Edge), 8U);
+	signal(SIGTRAP, Step);
+	Wrapper = WrapperInsn();
+	for (Index = 0U; Index < SCENARIOS; Index++) {
+		for (Mode = 0U; Mode < MODES; Mode++) {
+			Measure(Mode, &Scenarios[Index], Wrapper,
+				&Costs[Index][Mode]);
+		}
+	}
+
+	printf("gpio dispatch: modeled, register access %u ns and interrupt "
+	       "entry %u ns assumed, counted host instructions, a wrapped "
+	       "access counted %.1f, CPU %.2f MHz\n", ACCESS_NS, IRQ_NS,
+	       Wrapper, 1e3 / CPU_NS);
+	printf("  %-24s %-15s %6s %8s  to 1st pin: %5s %8s  latency ns at "
+	       "insn %.2f %.2f %.2f ns\n", "pending", "handler", "insn",
+	       "accesses", "insn", "accesses", InsnCycles[0] * CPU_NS,
+	       InsnCycles[1] * CPU_NS, InsnCycles[2] * CPU_NS);
+	for (Index = 0U; Index < SCENARIOS; Index++) {
+		for (Mode = 0U; Mode < MODES; Mode++) {
+			C = &Costs[Index][Mode];
+			printf("  %-24s %-15s %6llu %8llu              %5llu "
+			       "%8llu               ",
+			       Scenarios[Index].Name, ModeNames[Mode],
+			       (unsigned long long)C->Insn,
+			       (unsigned long long)C->Accesses,
+			       (unsigned long long)C->FirstInsn,
+			       (unsigned long long)C->FirstAccesses);
+			for (Insn = 0U; Insn < (sizeof(InsnCycles) /
+						sizeof(InsnCycles[0])); Insn++) {
+				printf(" %5.0f", IRQ_NS + (double)C->FirstNs +
+				       ((double)C->FirstInsn * InsnCycles[Insn] *
+					CPU_NS));
+			}
+			printf("\n");
+		}
+	}
+
+	printf(" sustained edges/s, two quadrature encoders on EMIO, both "
+	       "edges, %u edges per run, none lost\n", SIM_EDGES);
+	printf("   insn ns  %15s  %15s\n", ModeNames[MODE_BANK],
+	       ModeNames[MODE_PIN]);
+	for (Insn = 0U; Insn < (sizeof(InsnCycles) / sizeof(InsnCycles[0]));
+	     Insn++) {
+		InsnNs = InsnCycles[Insn] * CPU_NS;
+		printf("  %8.2f ", InsnNs);
+		for (Mode = 0U; Mode < MODES; Mode++) {
+			PerPin = ((double)Costs[SCENARIO_ENC4][Mode].Insn -
+				  (double)Costs[SCENARIO_ENC1][Mode].Insn) / 3.0;
+			Base = (double)Costs[SCENARIO_ENC1][Mode].Insn - PerPin;
+			printf("  %15.0f", 1e9 / (double)MinGap(Mode, InsnNs,
+								Base, PerPin));
+		}
+		printf("\n");
+	}
+	return 0;
+}
+
+int main(void)
+{
+	Host_Init();
+	GpioPsModel_Init(&Model, XPAR_XGPIOPS_0_BASEADDR, ACCESS_NS);
+	Host_RunLow(Run, NULL);
+	return (Host_Failures != 0U) ? 1 : 0;
+}
@@ -0,0 +1,218 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file bench_msgq.c
+*
+* Throughput and latency of xil_msgq.c built with XIL_MSGQ_HOST on host
+* threads. The numbers are those of the C11 atomics on the build machine,
+* they show the relative cost of SPSC and MPMC queues and of the message
+* size, not the cost on the Cortex-A9, where the queue header and slots
+* sit in shared OCM or DDR and the barriers are DMBs.
+*
+* - Throughput: one producer and one consumer (SPSC and MPMC) and two of
+*   each (MPMC), 8, 64 and 256 byte messages, 64 slots.
+* - Latency: a ping-pong over two queues, the round trip time is reported
+*   as median, 99th percentile and maximum.
+*
+* With fewer host CPUs than threads every full or empty queue costs a
+* sched_yield, the report gives the CPU count.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "host.h"
+#include "xil_msgq.h"
+#include "xstatus.h"
+
+#define MAX_MSG_SIZE	256U
+#define SLOT_COUNT	64U
+#define MSGS		1000000U
+#define ROUND_TRIPS	100000U
+
+typedef struct {
+	Xil_MsgQ *Q;
+	u32 MsgSize;
+	u32 Msgs;
+} Job;
+
+static Xil_MsgQ Queue;
+static Xil_MsgQ Reply;
+static u8 Slots[XIL_MSGQ_SLOTS_SIZE(MAX_MSG_SIZE, SLOT_COUNT)]
+	__attribute__ ((aligned(XIL_MSGQ_LINE_SIZE)));
+static u8 ReplySlots[XIL_MSGQ_SLOTS_SIZE(MAX_MSG_SIZE, SLOT_COUNT)]
+	__attribute__ ((aligned(XIL_MSGQ_LINE_SIZE)));
+static u64 RoundTrip[ROUND_TRIPS];
+static long Cpus;
+
+static u64 NowNs(void)
+{
+	struct timespec Ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &Ts);
+	return ((u64)Ts.tv_sec * HOST_NS_PER_SEC) + (u64)Ts.tv_nsec;
+}
+
+/* Spins while there are CPUs for every thread, yields otherwise */
+static void Backoff(void)
+{
+	if (Cpus < 2) {
+		sched_yield();
+	}
+}
+
+static void *Producer(void *Arg)
+{
+	Job *J = Arg;
+	u8 Buf[MAX_MSG_SIZE];
+	u32 Index;
+
+	memset(Buf, 0x5A, sizeof(Buf));
+	for (Index = 0U; Index < J->Msgs; Index++) {
+		memcpy(Buf, &Index, sizeof(Index));
+		while (Xil_MsgQSend(J->Q, Buf, J->MsgSize) != XST_SUCCESS) {
+			Backoff();
+		}
+	}
+	return NULL;
+}
+
+static void *Consumer(void *Arg)
+{
+	Job *J = Arg;
+	u8 Buf[MAX_MSG_SIZE];
+	u32 Index;
+	u32 Len;
+
+	for (Index = 0U; Index < J->Msgs; Index++) {
+		while (Xil_MsgQRecv(J->Q, Buf, sizeof(Buf), &Len) != XST_SUCCESS) {
+			Backoff();
+		}
+	}
+	return NULL;
+}
+
+static void Throughput(u32 Type, u32 Pairs, u32 MsgSize)
+{
+	pthread_t Threads[4];
+	Job J;
+	u64 Start;
+	u64 Ns;
+	u32 Index;
+
+	(void)Xil_MsgQInit(&Queue, Slots, MsgSize, SLOT_COUNT, Type);
+	J.Q = &Queue;
+	J.MsgSize = MsgSize;
+	J.Msgs = MSGS / Pairs;
+	Start = NowNs();
+	for (Index = 0U; Index < Pairs; Index++) {
+		pthread_create(&Threads[2U * Index], NULL, Consumer, &J);
+		pthread_create(&Threads[(2U * Index) + 1U], NULL, Producer, &J);
+	}
+	for (Index = 0U; Index < (2U * Pairs); Index++) {
+		pthread_join(Threads[Index], NULL);
+	}
+	Ns = NowNs() - Start;
+	printf("  %s %uP/%uC %4u B  %10.0f msgs/s  %8.1f MB/s  %6.1f ns/msg\n",
+	       (Type == XIL_MSGQ_SPSC) ? "SPSC" : "MPMC", Pairs, Pairs, MsgSize,
+	       (double)(J.Msgs * Pairs) * 1e9 / (double)Ns,
+	       (double)(J.Msgs * Pairs) * MsgSize * 1e3 / (double)Ns,
+	       (double)Ns / (double)(J.Msgs * Pairs));
+}
+
+static void *Echo(void *Arg)
+{
+	u8 Buf[MAX_MSG_SIZE];
+	u32 Index;
+	u32 Len;
+
+	(void)Arg;
+	for (Index = 0U; Index < ROUND_TRIPS; Index++) {
+		while (Xil_MsgQRecv(&Queue, Buf, sizeof(Buf), &Len) != XST_SUCCESS) {
+			Backoff();
+		}
+		while (Xil_MsgQSend(&Reply, Buf, Len) != XST_SUCCESS) {
+			Backoff();
+		}
+	}
+	return NULL;
+}
+
+static int CompareU64(const void *A, const void *B)
+{
+	u64 X = *(const u64 *)A;
+	u64 Y = *(const u64 *)B;
+
+	return (X > Y) - (X < Y);
+}
+
+static void Latency(u32 Type, u32 MsgSize)
+{
+	pthread_t Thread;
+	u8 Buf[MAX_MSG_SIZE];
+	u64 Start;
+	u32 Index;
+	u32 Len;
+
+	(void)Xil_MsgQInit(&Queue, Slots, MsgSize, SLOT_COUNT, Type);
+	(void)Xil_MsgQInit(&Reply, ReplySlots, MsgSize, SLOT_COUNT, Type);
+	memset(Buf, 0xA5, sizeof(Buf));
+	pthread_create(&Thread, NULL, Echo, NULL);
+	for (Index = 0U; Index < ROUND_TRIPS; Index++) {
+		Start = NowNs();
+		while (Xil_MsgQSend(&Queue, Buf, MsgSize) != XST_SUCCESS) {
+			Backoff();
+		}
+		while (Xil_MsgQRecv(&Reply, Buf, sizeof(Buf), &Len) != XST_SUCCESS) {
+			Backoff();
+		}
+		RoundTrip[Index] = NowNs() - Start;
+	}
+	pthread_join(Thread, NULL);
+	qsort(RoundTrip, ROUND_TRIPS, sizeof(RoundTrip[0]), CompareU64);
+	printf("  %s %4u B  round trip median %llu ns, p99 %llu ns, max %llu ns\n",
+	       (Type == XIL_MSGQ_SPSC) ? "SPSC" : "MPMC", MsgSize,
+	       (unsigned long long)RoundTrip[ROUND_TRIPS / 2U],
+	       (unsigned long long)RoundTrip[(ROUND_TRIPS * 99U) / 100U],
+	       (unsigned long long)RoundTrip[ROUND_TRIPS - 1U]);
+}
+
+int main(void)
+{
+	static const u32 Sizes[] = { 8U, 64U, 256U };
+	u32 Index;
+
+	Cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	printf("msgq: host C11 atomics, %ld CPUs, %u slots%s\n", Cpus, SLOT_COUNT,
+	       (Cpus < 2) ? ", threads yield on a full or empty queue" : "");
+	printf("throughput, %u messages:\n", MSGS);
+	for (Index = 0U; Index < (sizeof(Sizes) / sizeof(Sizes[0])); Index++) {
+		Throughput(XIL_MSGQ_SPSC, 1U, Sizes[Index]);
+		Throughput(XIL_MSGQ_MPMC, 1U, Sizes[Index]);
+		Throughput(XIL_MSGQ_MPMC, 2U, Sizes[Index]);
+	}
+	printf("latency, %u round trips:\n", ROUND_TRIPS);
+	Latency(XIL_MSGQ_SPSC, 8U);
+	Latency(XIL_MSGQ_MPMC, 8U);
+	Latency(XIL_MSGQ_SPSC, 256U);
+	return 0;
+}
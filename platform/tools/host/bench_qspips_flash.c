@@ -0,0 +1,504 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file bench_qspips_flash.c
+*
+* Throughput and worst case latency of the queued flash service of
+* xqspips_flash.c against the controller and flash of
+* models/qspips_model.c, in modeled time.
+*
+* The service runs as on the target: the QSPI interrupt is taken whenever
+* the model raises it and XQspiPs_FlashTick() runs from a periodic timer
+* interrupt. The program waits with WFI, interrupts are only taken there.
+*
+* - stream: the log writer appends 64 byte records as fast as the service
+*   takes them, with no sector erased ahead and with two.
+* - paced: the same writer at half the rate of the stream case, records
+*   evenly spaced, with 0, 1 and 2 sectors erased ahead. The erases ahead
+*   run in the idle time of the flash, the question is whether the writer
+*   still stalls when it reaches a new sector.
+* - burst: 32 KB at the rate of the stream case, then nothing for twice
+*   the sector erase time, with 0 and 1 sector erased ahead.
+* - commit: 62 byte records, every 17 records XQspiPs_FlashAppendFlush()
+*   and a wait for its token. Partial pages of odd lengths, completed by
+*   the next page program.
+* - program: XQspiPs_FlashProgram() of one sector, the next page is staged
+*   while the current one programs.
+* - reads: the stream writer and a 4 KB XQspiPs_FlashRead() from another
+*   region every 5 ms, with 0 and 2 sectors erased ahead.
+*
+* Every case checks the flash contents against what was written and the
+* read data against the flash. Reported per case: KB/s, against the serial
+* bound of the flash (the program and erase times plus the time on the
+* bus, with nothing between them), the longest writer stall past the first
+* sector (an append refused until it is taken; the first sector is always
+* erased while the writer waits), the longest submit to done time of the
+* service (MaxLatency, which includes the erases ahead that gave way),
+* read or commit latency where there are reads or commits, status polls
+* per program or erase, interrupts with the ticks and the CPU share
+* of the interrupt handlers and of the calls of the writer. The CPU time is
+* the register accesses and interrupt entries, the instructions of the
+* driver are not counted, see bench_gpiops.c for what they add.
+*
+* The reference clock is XPAR_QSPI_CLOCK_FREQ, divided by 4 for SCLK. The
+* register access time, interrupt entry time and the page program and
+* sector erase times of the flash are not given by the tree; they are
+* assumptions printed with the results, the flash times as two profiles.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <string.h>
+
+#include "host.h"
+#include "qspips_model.h"
+#include "slcr_model.h"
+#include "xparameters.h"
+#include "xqspips.h"
+#include "xstatus.h"
+
+/* Assumed, see the file comment */
+#define ACCESS_NS	100U
+#define IRQ_NS		500U
+
+#define QSPI_BASE	XPAR_QSPI_BASEADDR
+#define FLASH_SIZE	XQSPIPS_FLASH_ADDR_LIMIT
+#define LOG_BASE	0U
+#define LOG_LEN		0x100000U	/* 16 sectors */
+#define DATA_BASE	0x800000U	/* Read by the reads case */
+#define READ_LEN	4096U
+#define READ_EVERY_NS	5000000U
+#define REC_LEN		64U
+#define COMMIT_REC_LEN	62U
+#define BURST_LEN	0x8000U
+#define COMMIT_RECS	17U
+#define PAGE_CMD_BYTES	(XQSPIPS_FLASH_CMD_LEN + XQSPIPS_FLASH_PAGE_SIZE)
+
+#define CASE_STREAM	0U
+#define CASE_PACED	1U
+#define CASE_COMMIT	2U
+#define CASE_PROGRAM	3U
+#define CASE_READS	4U
+#define CASE_BURST	5U
+
+typedef struct {
+	const char *Name;
+	u32 ProgramNs;
+	u32 EraseNs;
+} Profile;
+
+typedef struct {
+	const char *Name;
+	u32 Kind;
+	u32 EraseAhead;
+	u32 TickUs;
+} Case;
+
+typedef struct {
+	u64 Bytes;
+	u64 Ns;
+	u64 BoundNs;
+	u64 MaxStall;
+	u64 MaxWait;		/* Read or commit */
+	u64 SumWait;
+	u64 Waits;
+	u64 Irqs;
+	u64 Ticks;
+	u64 CpuNs;
+} Result;
+
+static QspiPsModel Model;
+static SlcrModel Slcr;
+static XQspiPs Qspi;
+static XQspiPs_Flash Flash;
+static u32 Mapped;
+static u8 *Data;
+static u8 *ReadBuf;
+
+static u64 TickNs;
+static u32 TickDue;
+static u64 Irqs;
+static u64 Ticks;
+static u64 CpuNs;
+
+/* Reads of the reads case */
+static u32 ReadsOn;
+static XQspiPs_FlashToken ReadToken;
+static u64 ReadSubmitted;
+static u64 ReadDue;
+static u32 Reads;
+
+static u8 Pattern(u32 Offset)
+{
+	return (u8)((Offset * 7U) + ((Offset >> 8) * 13U) + 1U);
+}
+
+static void Tick(void *Ref)
+{
+	(void)Ref;
+	TickDue = 1U;
+	Host_Schedule(Host_Now() + TickNs, Tick, NULL);
+}
+
+static void Wake(void *Ref)
+{
+	(void)Ref;
+}
+
+/* Interrupts taken at WFI: the QSPI interrupt first, then the tick */
+static void Interrupt(void *Ref)
+{
+	u64 Start;
+
+	(void)Ref;
+	for (;;) {
+		Start = Host_Now();
+		if (QspiPsModel_IrqPending(&Model) != 0U) {
+			Host_Advance(IRQ_NS);
+			Irqs++;
+			XQspiPs_InterruptHandler(&Qspi);
+		} else if (TickDue != 0U) {
+			TickDue = 0U;
+			Host_Advance(IRQ_NS);
+			Ticks++;
+			XQspiPs_FlashTick(&Flash);
+		} else {
+			return;
+		}
+		CpuNs += Host_Now() - Start;
+	}
+}
+
+static void Setup(const Profile *P, const Case *C)
+{
+	XQspiPs_Config *Config;
+
+	if (Mapped != 0U) {
+		Host_Cancel(Tick, NULL);
+		QspiPsModel_Release(&Model);
+	}
+	QspiPsModel_Init(&Model, QSPI_BASE, ACCESS_NS, XPAR_QSPI_CLOCK_FREQ,
+			 FLASH_SIZE, P->ProgramNs, P->EraseNs);
+	Mapped = 1U;
+
+	Config = XQspiPs_LookupConfig(QSPI_BASE);
+	HOST_CHECK(Config != NULL);
+	memset(&Qspi, 0, sizeof(Qspi));
+	HOST_CHECK_EQ(XQspiPs_CfgInitialize(&Qspi, Config, QSPI_BASE),
+		      XST_SUCCESS);
+	HOST_CHECK_EQ(XQspiPs_SetOptions(&Qspi, XQSPIPS_FORCE_SSELECT_OPTION |
+					 XQSPIPS_HOLD_B_DRIVE_OPTION),
+		      XST_SUCCESS);
+	HOST_CHECK_EQ(XQspiPs_SetClkPrescaler(&Qspi, XQSPIPS_CLK_PRESCALE_4),
+		      XST_SUCCESS);
+	HOST_CHECK_EQ(XQspiPs_FlashInitialize(&Flash, &Qspi), XST_SUCCESS);
+	HOST_CHECK_EQ(XQspiPs_FlashSetAppend(&Flash, LOG_BASE,
+					     LOG_BASE + LOG_LEN, C->EraseAhead),
+		      XST_SUCCESS);
+
+	TickNs = (u64)C->TickUs * 1000U;
+	TickDue = 0U;
+	Host_Schedule(Host_Now() + TickNs, Tick, NULL);
+	Irqs = 0U;
+	Ticks = 0U;
+	CpuNs = 0U;
+}
+
+static void WaitToken(XQspiPs_FlashToken Token)
+{
+	while (XQspiPs_FlashIsDone(&Flash, Token) == 0) {
+		wfi();
+	}
+}
+
+static void WaitUntil(u64 At)
+{
+	if (Host_Now() >= At) {
+		return;
+	}
+	Host_Schedule(At, Wake, NULL);
+	while (Host_Now() < At) {
+		wfi();
+	}
+}
+
+/* Submits a read when it is due and checks the finished one */
+static void PollRead(Result *R)
+{
+	u32 Addr = DATA_BASE + ((Reads % 64U) * READ_LEN);
+	u32 Prev = DATA_BASE + (((Reads + 63U) % 64U) * READ_LEN);
+	u64 Start;
+
+	if (ReadsOn == 0U) {
+		return;
+	}
+	if ((ReadToken != 0U) && (XQspiPs_FlashIsDone(&Flash, ReadToken) != 0)) {
+		R->Waits++;
+		R->SumWait += Host_Now() - ReadSubmitted;
+		if ((Host_Now() - ReadSubmitted) > R->MaxWait) {
+			R->MaxWait = Host_Now() - ReadSubmitted;
+		}
+		HOST_CHECK(memcmp(ReadBuf + XQSPIPS_FLASH_READ_OVERHEAD,
+				  Model.Flash.Mem + Prev, READ_LEN) == 0);
+		ReadToken = 0U;
+	}
+	if ((ReadToken == 0U) && (Host_Now() >= ReadDue)) {
+		Start = Host_Now();
+		HOST_CHECK_EQ(XQspiPs_FlashRead(&Flash, Addr, ReadBuf, READ_LEN,
+						&ReadToken), XST_SUCCESS);
+		CpuNs += Host_Now() - Start;
+		ReadSubmitted = Start;
+		ReadDue += READ_EVERY_NS;
+		Reads++;
+		Host_Schedule(ReadDue, Wake, NULL);
+	}
+}
+
+/* Appends Len bytes of the log, waiting while the service is full */
+static void Append(u32 Offset, u32 Len, Result *R)
+{
+	u64 Stall = 0U;
+	u64 Start;
+	int Status;
+
+	for (;;) {
+		Start = Host_Now();
+		Status = XQspiPs_FlashAppend(&Flash, Data + Offset, Len);
+		CpuNs += Host_Now() - Start;
+		if (Status != XST_DEVICE_BUSY) {
+			break;
+		}
+		Start = Host_Now();
+		wfi();
+		Stall += Host_Now() - Start;
+		PollRead(R);
+	}
+	HOST_CHECK_EQ(Status, XST_SUCCESS);
+	if ((Offset >= XQSPIPS_FLASH_SECTOR_SIZE) && (Stall > R->MaxStall)) {
+		R->MaxStall = Stall;
+	}
+}
+
+static void Flush(Result *R)
+{
+	XQspiPs_FlashToken Token = 0U;
+	u64 Start = Host_Now();
+
+	while (XQspiPs_FlashAppendFlush(&Flash, &Token) == XST_DEVICE_BUSY) {
+		wfi();
+	}
+	WaitToken(Token);
+	R->Waits++;
+	R->SumWait += Host_Now() - Start;
+	if ((Host_Now() - Start) > R->MaxWait) {
+		R->MaxWait = Host_Now() - Start;
+	}
+}
+
+static void RunLog(const Case *C, u64 PacedNs, Result *R)
+{
+	XQspiPs_FlashToken Token = 0U;
+	u32 RecLen = (C->Kind == CASE_COMMIT) ? COMMIT_REC_LEN : REC_LEN;
+	u32 Offset = 0U;
+	u32 Recs = 0U;
+	u32 Len;
+	u64 Start = Host_Now();
+
+	while (Offset < LOG_LEN) {
+		Len = ((LOG_LEN - Offset) < RecLen) ? (LOG_LEN - Offset) : RecLen;
+		if (C->Kind == CASE_PACED) {
+			WaitUntil(Start + (Recs * PacedNs));
+		} else if ((C->Kind == CASE_BURST) && (Offset != 0U) &&
+			   ((Offset % BURST_LEN) == 0U)) {
+			WaitUntil(Host_Now() + PacedNs);
+		}
+		PollRead(R);
+		Append(Offset, Len, R);
+		Offset += Len;
+		Recs++;
+		if ((C->Kind == CASE_COMMIT) && ((Recs % COMMIT_RECS) == 0U)) {
+			Flush(R);
+		}
+	}
+	HOST_CHECK_EQ(XQspiPs_FlashAppendFlush(&Flash, &Token), XST_SUCCESS);
+	WaitToken(Token);
+	while (ReadToken != 0U) {
+		wfi();
+		PollRead(R);
+	}
+	R->Bytes = LOG_LEN;
+	R->Ns = Host_Now() - Start;
+}
+
+static void RunProgram(Result *R)
+{
+	XQspiPs_FlashToken Token;
+	u64 Start = Host_Now();
+	int Status;
+
+	Status = XQspiPs_FlashProgram(&Flash, LOG_BASE, Data,
+				      XQSPIPS_FLASH_SECTOR_SIZE, &Token);
+	CpuNs += Host_Now() - Start;
+	HOST_CHECK_EQ(Status, XST_SUCCESS);
+	WaitToken(Token);
+	R->Bytes = XQSPIPS_FLASH_SECTOR_SIZE;
+	R->Ns = Host_Now() - Start;
+}
+
+static void Measure(const Profile *P, const Case *C, u64 PacedNs, Result *R)
+{
+	u64 ByteNs;
+	u32 Pages;
+	u32 Index;
+	u32 Bad = 0U;
+
+	memset(R, 0, sizeof(*R));
+	Setup(P, C);
+	ReadsOn = (C->Kind == CASE_READS) ? 1U : 0U;
+	ReadToken = 0U;
+	ReadDue = Host_Now();
+	Reads = 0U;
+	if (C->Kind == CASE_READS) {
+		for (Index = 0U; Index < (64U * READ_LEN); Index++) {
+			Model.Flash.Mem[DATA_BASE + Index] = (u8)(Index ^
+								  (Index >> 9));
+		}
+	}
+	if (C->Kind == CASE_PROGRAM) {
+		RunProgram(R);
+	} else {
+		RunLog(C, PacedNs, R);
+	}
+	R->Irqs = Irqs;
+	R->Ticks = Ticks;
+	R->CpuNs = CpuNs;
+
+	for (Index = 0U; Index < R->Bytes; Index++) {
+		if (Model.Flash.Mem[LOG_BASE + Index] != Data[Index]) {
+			Bad++;
+		}
+	}
+	if (Bad != 0U) {
+		printf("  %s: %u bytes differ from the data written\n", C->Name,
+		       Bad);
+	}
+	HOST_CHECK_EQ(Bad, 0U);
+	HOST_CHECK_EQ(Flash.Errors, 0U);
+	HOST_CHECK_EQ(Model.Flash.Refused, 0U);
+	HOST_CHECK_EQ(Model.RxOverruns + Model.TxOverflows +
+		      Model.RxUnderflows, 0U);
+
+	/* Program and erase times and every byte on the bus, back to back */
+	ByteNs = Model.ShiftNs / ((Model.Bytes != 0U) ? Model.Bytes : 1U);
+	Pages = R->Bytes / XQSPIPS_FLASH_PAGE_SIZE;
+	R->BoundNs = ((u64)Pages * (P->ProgramNs + ((PAGE_CMD_BYTES + 1U) *
+						    ByteNs))) +
+		     ((C->Kind == CASE_PROGRAM) ? 0U :
+		      ((u64)(R->Bytes / XQSPIPS_FLASH_SECTOR_SIZE) *
+		       P->EraseNs));
+}
+
+static void Print(const Case *C, const Result *R)
+{
+	double Ms = 1e-6;
+
+	printf("  %-15s %3u us %8.1f %5.1f %% %8.2f %8.2f", C->Name, C->TickUs,
+	       ((double)R->Bytes / 1024.0) / ((double)R->Ns * 1e-9),
+	       (double)R->BoundNs * 100.0 / (double)R->Ns,
+	       (double)R->MaxStall * Ms,
+	       (double)Host_GtNs(Flash.MaxLatency) * Ms);
+	if (R->Waits != 0U) {
+		printf(" %8.2f %8.2f", (double)R->MaxWait * Ms,
+		       (double)R->SumWait * Ms / (double)R->Waits);
+	} else {
+		printf(" %8s %8s", "-", "-");
+	}
+	printf(" %6.1f %8llu %5.2f %%\n",
+	       (double)Flash.WipPolls / (double)(Flash.Pages + Flash.Erases),
+	       (unsigned long long)(R->Irqs + R->Ticks),
+	       (double)R->CpuNs * 100.0 / (double)R->Ns);
+}
+
+static int Run(void *Arg)
+{
+	static const Profile Profiles[] = {
+		{ "A", 250000U, 150000000U },
+		{ "B", 700000U, 500000000U },
+	};
+	static const Case Stream = { "stream ea0", CASE_STREAM, 0U, 20U };
+	static const Case Cases[] = {
+		{ "stream ea2", CASE_STREAM, 2U, 20U },
+		{ "stream ea2", CASE_STREAM, 2U, 100U },
+		{ "paced ea0", CASE_PACED, 0U, 20U },
+		{ "paced ea1", CASE_PACED, 1U, 20U },
+		{ "paced ea2", CASE_PACED, 2U, 20U },
+		{ "burst ea0", CASE_BURST, 0U, 20U },
+		{ "burst ea1", CASE_BURST, 1U, 20U },
+		{ "commit 1K ea2", CASE_COMMIT, 2U, 20U },
+		{ "program 64K", CASE_PROGRAM, 0U, 20U },
+		{ "program 64K", CASE_PROGRAM, 0U, 100U },
+		{ "reads ea0", CASE_READS, 0U, 20U },
+		{ "reads ea2", CASE_READS, 2U, 20U },
+	};
+	const Profile *P;
+	Result R;
+	u64 PacedNs;
+	u32 Index;
+	u32 Prof;
+
+	(void)Arg;
+	Data = Host_AllocLow(LOG_LEN, 4U);
+	ReadBuf = Host_AllocLow(READ_LEN + XQSPIPS_FLASH_READ_OVERHEAD + 4U,
+				4U);
+	for (Index = 0U; Index < LOG_LEN; Index++) {
+		Data[Index] = Pattern(Index);
+	}
+	SlcrModel_Init(&Slcr, ACCESS_NS, 0U);
+	Host_SetWfiHook(Interrupt, NULL);
+
+	printf("qspips flash service: modeled time, %u KB log, SCLK %u MHz, "
+	       "register access %u ns and interrupt entry %u ns assumed\n",
+	       LOG_LEN >> 10, XPAR_QSPI_CLOCK_FREQ / 4000000U, ACCESS_NS,
+	       IRQ_NS);
+	for (Prof = 0U; Prof < (sizeof(Profiles) / sizeof(Profiles[0]));
+	     Prof++) {
+		P = &Profiles[Prof];
+		printf(" flash %s: page program %u us, sector erase %u ms "
+		       "(assumed)\n", P->Name, P->ProgramNs / 1000U,
+		       P->EraseNs / 1000000U);
+		printf("  %-15s %6s %8s %7s %8s %8s %8s %8s %6s %8s %7s\n",
+		       "case", "tick", "KB/s", "bound", "stall ms", "svc ms",
+		       "wait ms", "mean ms", "polls", "irqs", "cpu");
+		Measure(P, &Stream, 0U, &R);
+		Print(&Stream, &R);
+		/* Half the rate of the stream case */
+		PacedNs = (2U * R.Ns * REC_LEN) / R.Bytes;
+		for (Index = 0U; Index < (sizeof(Cases) / sizeof(Cases[0]));
+		     Index++) {
+			Measure(P, &Cases[Index],
+				(Cases[Index].Kind == CASE_PACED) ? PacedNs :
+				(2ULL * P->EraseNs), &R);
+			Print(&Cases[Index], &R);
+		}
+	}
+	return 0;
+}
+
+int main(void)
+{
+	Host_Init();
+	Host_RunLow(Run, NULL);
+	return (Host_Failures != 0U) ? 1 : 0;
+}
@@ -0,0 +1,515 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file bench_qspips_store.c
+*
+* Operations per second, write amplification and mount time of the log
+* store of xqspips_store.c, and its recovery from power cuts, on the QSPI
+* controller and flash of models/qspips_model.c in modeled time.
+*
+* The store runs on the flash service of xqspips_flash.c as on the target:
+* XQspiPs_FlashWait() polls with usleep(1) and the QSPI interrupt is taken
+* through Host_SetIrq whenever IRQs are unmasked.
+*
+* - Workloads on a formatted store of STORE_SECTORS sectors: KEYS keys
+*   with small values, KEYS keys with values of up to
+*   XQSPIPS_STORE_MAX_VALUE bytes, both with one delete in eight, and a
+*   hot and cold load where HOT_KEYS keys take all the writes after every
+*   key is written once. Reported: operations per second, the mean and
+*   longest operation, the write amplification (FlashBytes / UserBytes,
+*   the record and sector headers included), sector erases, collections,
+*   wear leveling moves, the spread of the erase counts and the time of a
+*   mount of the store left behind.
+* - Power cuts: the store with values of up to XQSPIPS_STORE_MAX_VALUE
+*   bytes is cut by QspiPsModel_PowerCut(), half the cuts at a random time
+*   within one sector erase time, which lands in proportion to the time
+*   taken by the erases, the programs and the CPU, half at a random point
+*   of a random flash program or erase among the next CUT_SPREAD, which
+*   also reaches the short header and sequence writes. The program stops
+*   at the cut and the store is mounted again on a fresh controller and
+*   flash service. Every key must then read the last value written
+*   before the cut, or for the key of the operation that was cut, the old
+*   or the new one. Reported: where the cuts landed, how the operations
+*   cut came out, the mount time after a cut and the totals of the run.
+*
+* The reference clock is XPAR_QSPI_CLOCK_FREQ, divided by 4 for SCLK. The
+* register access time, the interrupt entry time and the page program and
+* sector erase times are assumptions printed with the results, the flash
+* times as two profiles as in bench_qspips_flash.c.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <setjmp.h>
+#include <string.h>
+
+#include "host.h"
+#include "qspips_model.h"
+#include "slcr_model.h"
+#include "xparameters.h"
+#include "xpseudo_asm.h"
+#include "xqspips.h"
+#include "xstatus.h"
+
+/* Assumed, see the file comment */
+#define ACCESS_NS	100U
+#define IRQ_NS		500U
+
+#define QSPI_BASE	XPAR_QSPI_BASEADDR
+#define FLASH_SIZE	XQSPIPS_FLASH_ADDR_LIMIT
+#define STORE_BASE	0x100000U
+#define STORE_SECTORS	8U
+#define KEYS		100U
+#define HOT_KEYS	10U
+#define SMALL_LEN	64U
+#define CUTS		300U
+#define CUT_SPREAD	200U
+#define CUT_OPS		60000U	/* Operations of the cut run at most */
+#define PROBE_NS	10000U	/* Search for the flash operation to cut */
+
+#define LOAD_UNIFORM	0U
+#define LOAD_HOT	1U
+
+#define CUT_IDLE	0U
+#define CUT_PROGRAM	1U
+#define CUT_ERASE	2U
+
+typedef struct {
+	const char *Name;
+	u32 ProgramNs;
+	u32 EraseNs;
+} Profile;
+
+typedef struct {
+	const char *Name;
+	u32 Load;
+	u32 MaxLen;
+	u32 Ops;
+} Case;
+
+typedef struct {
+	u64 Ops;
+	u64 Ns;
+	u64 MaxOpNs;
+	u64 UserBytes;
+	u64 FlashBytes;
+	u64 Erases;
+	u64 GcRuns;
+	u64 WearMoves;
+} Result;
+
+static QspiPsModel Model;
+static SlcrModel Slcr;
+static XQspiPs Qspi;
+static XQspiPs_Flash Flash;
+static XQspiPs_Store Store;
+static u8 Value[XQSPIPS_STORE_MAX_VALUE];
+static u32 BootCpsr;
+static u32 Seed = 1U;
+static u64 Irqs;
+static u32 Mapped;
+
+/* Version of each key written last, 0 if deleted, and the one cut */
+static u32 Ver[KEYS];
+static u32 Serial;
+static u32 Pending;
+static u32 PendKey;
+static u32 PendVer;
+
+/* Power cuts */
+static jmp_buf PowerOn;
+static u64 CutOp;
+static u32 CutWhere;
+
+static u32 Rand(void)
+{
+	Seed = (Seed * 1103515245U) + 12345U;
+	return Seed >> 8;
+}
+
+static u32 LenOf(u32 Key, u32 Version, u32 MaxLen)
+{
+	return 1U + (((Key * 17U) + (Version * 29U)) % MaxLen);
+}
+
+static u8 ByteOf(u32 Key, u32 Version, u32 Index)
+{
+	return (u8)((Key * 31U) + (Version * 7U) + (Index * 13U) +
+		    (Index >> 3));
+}
+
+/* The power goes, the program stops between two instructions */
+static void Cut(void *Ref)
+{
+	u64 Torn = Model.Flash.TornWrites;
+	u8 Busy = Model.Flash.Busy;
+
+	(void)Ref;
+	QspiPsModel_PowerCut(&Model);
+	if (Model.Flash.TornWrites == Torn) {
+		CutWhere = CUT_IDLE;
+	} else if (Busy == XQSPIPS_FLASH_OPCODE_SE) {
+		CutWhere = CUT_ERASE;
+	} else {
+		CutWhere = CUT_PROGRAM;
+	}
+	longjmp(PowerOn, 1);
+}
+
+/* Places the cut in the flash operation CutOp once it has started */
+static void Probe(void *Ref)
+{
+	u64 Now = Host_Now();
+
+	(void)Ref;
+	if ((Model.Flash.Busy != 0U) && (Model.Flash.BusyEnd > Now) &&
+	    ((Model.Flash.Programs + Model.Flash.Erases) >= CutOp)) {
+		Host_Schedule(Now + (((u64)Rand() << 8) %
+				     (Model.Flash.BusyEnd - Now)), Cut, NULL);
+		return;
+	}
+	Host_Schedule(Now + PROBE_NS, Probe, NULL);
+}
+
+static u32 IrqLine(void *Ref)
+{
+	(void)Ref;
+	return QspiPsModel_IrqPending(&Model);
+}
+
+static void Irq(void *Ref)
+{
+	(void)Ref;
+	Host_Advance(IRQ_NS);
+	Irqs++;
+	XQspiPs_InterruptHandler(&Qspi);
+}
+
+/* Brings up the controller and the flash service and mounts the store */
+static u64 Boot(void)
+{
+	XQspiPs_Config *Config;
+
+	mtcpsr(BootCpsr);
+	Config = XQspiPs_LookupConfig(QSPI_BASE);
+	HOST_CHECK(Config != NULL);
+	memset(&Qspi, 0, sizeof(Qspi));
+	HOST_CHECK_EQ(XQspiPs_CfgInitialize(&Qspi, Config, QSPI_BASE),
+		      XST_SUCCESS);
+	HOST_CHECK_EQ(XQspiPs_SetOptions(&Qspi, XQSPIPS_FORCE_SSELECT_OPTION |
+					 XQSPIPS_HOLD_B_DRIVE_OPTION),
+		      XST_SUCCESS);
+	HOST_CHECK_EQ(XQspiPs_SetClkPrescaler(&Qspi, XQSPIPS_CLK_PRESCALE_4),
+		      XST_SUCCESS);
+	HOST_CHECK_EQ(XQspiPs_FlashInitialize(&Flash, &Qspi), XST_SUCCESS);
+	HOST_CHECK_EQ(XQspiPs_StoreMount(&Store, &Flash, STORE_BASE,
+					 STORE_SECTORS), XST_SUCCESS);
+	return Host_GtNs(Store.MountCounts);
+}
+
+static void Setup(const Profile *P)
+{
+	u32 Key;
+
+	if (Mapped != 0U) {
+		QspiPsModel_Release(&Model);
+	}
+	Mapped = 1U;
+	QspiPsModel_Init(&Model, QSPI_BASE, ACCESS_NS, XPAR_QSPI_CLOCK_FREQ,
+			 FLASH_SIZE, P->ProgramNs, P->EraseNs);
+	(void)Boot();
+	HOST_CHECK_EQ(XQspiPs_StoreFormat(&Store, &Flash, STORE_BASE,
+					  STORE_SECTORS), XST_SUCCESS);
+	for (Key = 0U; Key < KEYS; Key++) {
+		Ver[Key] = 0U;
+	}
+	Pending = 0U;
+	Irqs = 0U;
+}
+
+/* Adds the counters of the store, they start again at every mount */
+static void Collect(Result *R)
+{
+	R->UserBytes += Store.UserBytes;
+	R->FlashBytes += Store.FlashBytes;
+	R->Erases += Store.Erases;
+	R->GcRuns += Store.GcRuns;
+	R->WearMoves += Store.WearMoves;
+}
+
+/* One put, or a delete one time in eight, of a key of the load */
+static void Operate(const Case *C, u32 Key, Result *R)
+{
+	u64 Start = Host_Now();
+	u32 Len;
+	u32 Index;
+
+	Serial++;
+	PendKey = Key;
+	if ((C->Load == LOAD_UNIFORM) && (Ver[Key] != 0U) &&
+	    ((Rand() % 8U) == 0U)) {
+		PendVer = 0U;
+		Pending = 1U;
+		HOST_CHECK_EQ(XQspiPs_StoreDelete(&Store, Key), XST_SUCCESS);
+	} else {
+		Len = LenOf(Key, Serial, C->MaxLen);
+		for (Index = 0U; Index < Len; Index++) {
+			Value[Index] = ByteOf(Key, Serial, Index);
+		}
+		PendVer = Serial;
+		Pending = 1U;
+		HOST_CHECK_EQ(XQspiPs_StorePut(&Store, Key, Value, Len),
+			      XST_SUCCESS);
+	}
+	Pending = 0U;
+	Ver[Key] = PendVer;
+
+	R->Ops++;
+	R->Ns += Host_Now() - Start;
+	if ((Host_Now() - Start) > R->MaxOpNs) {
+		R->MaxOpNs = Host_Now() - Start;
+	}
+}
+
+static u32 NextKey(const Case *C)
+{
+	if (C->Load == LOAD_HOT) {
+		return Rand() % HOT_KEYS;
+	}
+	return Rand() % KEYS;
+}
+
+/* 1 if Key reads as its version Version */
+static u32 Holds(u32 Key, u32 Version, u32 MaxLen, int Status, u32 Len)
+{
+	u32 Index;
+
+	if (Version == 0U) {
+		return (Status == XST_NO_DATA) ? 1U : 0U;
+	}
+	if ((Status != XST_SUCCESS) || (Len != LenOf(Key, Version, MaxLen))) {
+		return 0U;
+	}
+	for (Index = 0U; Index < Len; Index++) {
+		if (Value[Index] != ByteOf(Key, Version, Index)) {
+			return 0U;
+		}
+	}
+	return 1U;
+}
+
+/*
+ * Reads every key back. Returns 1 if the operation that was cut took
+ * effect, the key then keeps its new version.
+ */
+static u32 Verify(u32 MaxLen)
+{
+	u32 Key;
+	u32 Len;
+	u32 Took = 0U;
+	int Status;
+
+	for (Key = 0U; Key < KEYS; Key++) {
+		Len = 0U;
+		Status = XQspiPs_StoreGet(&Store, Key, Value, sizeof(Value),
+					  &Len);
+		if (Holds(Key, Ver[Key], MaxLen, Status, Len) != 0U) {
+			continue;
+		}
+		if ((Pending != 0U) && (Key == PendKey) &&
+		    (Holds(Key, PendVer, MaxLen, Status, Len) != 0U)) {
+			Ver[Key] = PendVer;
+			Took = 1U;
+			continue;
+		}
+		printf("  key %u: status %d length %u, version %u expected\n",
+		       Key, Status, Len, Ver[Key]);
+		HOST_CHECK(0);
+	}
+	Pending = 0U;
+	return Took;
+}
+
+static u32 Spread(void)
+{
+	u32 Min = ~0U;
+	u32 Max = 0U;
+	u32 Sector;
+
+	for (Sector = 0U; Sector < STORE_SECTORS; Sector++) {
+		if (Store.Sector[Sector].EraseCount < Min) {
+			Min = Store.Sector[Sector].EraseCount;
+		}
+		if (Store.Sector[Sector].EraseCount > Max) {
+			Max = Store.Sector[Sector].EraseCount;
+		}
+	}
+	return Max - Min;
+}
+
+static void Measure(const Profile *P, const Case *C)
+{
+	Result R;
+	u64 MountNs;
+	u32 Key;
+	u32 Op;
+	u32 Wear;
+
+	memset(&R, 0, sizeof(R));
+	Setup(P);
+	if (C->Load == LOAD_HOT) {
+		for (Key = 0U; Key < KEYS; Key++) {
+			Operate(C, Key, &R);
+		}
+	}
+	for (Op = 0U; Op < C->Ops; Op++) {
+		Operate(C, NextKey(C), &R);
+	}
+	Collect(&R);
+	Wear = Spread();
+	HOST_CHECK_EQ(Model.Flash.Refused, 0U);
+	HOST_CHECK_EQ(Model.TxOverflows + Model.RxOverruns +
+		      Model.RxUnderflows, 0U);
+
+	MountNs = Boot();
+	(void)Verify(C->MaxLen);
+
+	printf("  %-14s %6llu %8.0f %8.0f %7.1f %6.2f %6llu %5llu %5llu "
+	       "%6u %8.2f\n", C->Name, (unsigned long long)R.Ops,
+	       (double)R.Ops / ((double)R.Ns * 1e-9),
+	       (double)R.Ns * 1e-3 / (double)R.Ops,
+	       (double)R.MaxOpNs * 1e-6,
+	       (double)R.FlashBytes / (double)R.UserBytes,
+	       (unsigned long long)R.Erases, (unsigned long long)R.GcRuns,
+	       (unsigned long long)R.WearMoves, Wear,
+	       (double)MountNs * 1e-6);
+}
+
+static void MeasureCuts(const Profile *P)
+{
+	static const Case Load = { "cuts", LOAD_UNIFORM,
+				   XQSPIPS_STORE_MAX_VALUE, 0U };
+	static Result R;
+	static u32 Cuts;
+	static u32 Where[3];
+	static u32 Took;
+	static u64 MountNs;
+	static u64 SumMountNs;
+	static u64 MaxMountNs;
+	static u64 Start;
+
+	memset(&R, 0, sizeof(R));
+	Setup(P);
+	Start = Host_Now();
+	for (Cuts = 0U; Cuts < CUTS; Cuts++) {
+		if ((Cuts & 1U) != 0U) {
+			CutOp = Model.Flash.Programs + Model.Flash.Erases + 1U +
+				(Rand() % CUT_SPREAD);
+			Host_Schedule(Host_Now(), Probe, NULL);
+		} else {
+			Host_Schedule(Host_Now() + ((((u64)Rand() << 8) |
+						     (Rand() & 0xFFU)) %
+						    (u64)P->EraseNs),
+				      Cut, NULL);
+		}
+		if (setjmp(PowerOn) == 0) {
+			while (R.Ops < CUT_OPS) {
+				Operate(&Load, NextKey(&Load), &R);
+			}
+			break;
+		}
+
+		Host_Cancel(Probe, NULL);
+		Collect(&R);
+		Where[CutWhere]++;
+		MountNs = Boot();
+		SumMountNs += MountNs;
+		if (MountNs > MaxMountNs) {
+			MaxMountNs = MountNs;
+		}
+		Took += Verify(Load.MaxLen);
+	}
+	Host_Cancel(Cut, NULL);
+	Host_Cancel(Probe, NULL);
+	HOST_CHECK_EQ(Cuts, CUTS);
+	Collect(&R);
+
+	printf(" power cuts (flash %s, values of up to %u bytes): %u cuts, "
+	       "%u in an erase, %u in a program, %u with the flash idle\n",
+	       P->Name, Load.MaxLen, Cuts, Where[CUT_ERASE],
+	       Where[CUT_PROGRAM], Where[CUT_IDLE]);
+	printf("  %u of the operations cut took effect, the others left the "
+	       "old value; %llu operations, %llu erases, %llu collections, "
+	       "write amplification %.2f\n", Took,
+	       (unsigned long long)R.Ops, (unsigned long long)R.Erases,
+	       (unsigned long long)R.GcRuns,
+	       (double)R.FlashBytes / (double)R.UserBytes);
+	printf("  mount after a cut: mean %.2f ms, max %.2f ms; %.1f s "
+	       "modeled, %llu interrupts\n",
+	       (double)SumMountNs * 1e-6 / (double)Cuts,
+	       (double)MaxMountNs * 1e-6,
+	       (double)(Host_Now() - Start) * 1e-9,
+	       (unsigned long long)Irqs);
+}
+
+static int Run(void *Arg)
+{
+	static const Profile Profiles[] = {
+		{ "A", 250000U, 150000000U },
+		{ "B", 700000U, 500000000U },
+	};
+	static const Case Cases[] = {
+		{ "small", LOAD_UNIFORM, SMALL_LEN, 20000U },
+		{ "large", LOAD_UNIFORM, XQSPIPS_STORE_MAX_VALUE, 10000U },
+		{ "hot/cold", LOAD_HOT, XQSPIPS_STORE_MAX_VALUE, 70000U },
+	};
+	const Profile *P;
+	u32 Index;
+	u32 Prof;
+
+	(void)Arg;
+	BootCpsr = mfcpsr() & ~XREG_CPSR_IRQ_ENABLE;
+	SlcrModel_Init(&Slcr, ACCESS_NS, 0U);
+	Host_SetIrq(IrqLine, Irq, NULL);
+
+	printf("qspips store: modeled time, %u sectors, %u keys, SCLK %u MHz, "
+	       "register access %u ns and interrupt entry %u ns assumed\n",
+	       STORE_SECTORS, KEYS, XPAR_QSPI_CLOCK_FREQ / 4000000U,
+	       ACCESS_NS, IRQ_NS);
+	for (Prof = 0U; Prof < (sizeof(Profiles) / sizeof(Profiles[0]));
+	     Prof++) {
+		P = &Profiles[Prof];
+		printf(" flash %s: page program %u us, sector erase %u ms "
+		       "(assumed)\n", P->Name, P->ProgramNs / 1000U,
+		       P->EraseNs / 1000000U);
+		printf("  %-14s %6s %8s %8s %7s %6s %6s %5s %5s %6s %8s\n",
+		       "load", "ops", "ops/s", "mean us", "max ms", "wa",
+		       "erases", "gc", "wear", "spread", "mount ms");
+		for (Index = 0U; Index < (sizeof(Cases) / sizeof(Cases[0]));
+		     Index++) {
+			Measure(P, &Cases[Index]);
+		}
+	}
+	MeasureCuts(&Profiles[0]);
+	QspiPsModel_Release(&Model);
+	return 0;
+}
+
+int main(void)
+{
+	Host_Init();
+	Host_RunLow(Run, NULL);
+	return (Host_Failures != 0U) ? 1 : 0;
+}
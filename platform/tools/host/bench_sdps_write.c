@@ -0,0 +1,338 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file bench_sdps_write.c
+*
+* SD recording throughput and producer stalls of xilffs on the SD host
+* controller and card of models/sdps_model.c, in modeled time.
+*
+* FatFs and diskio.c of the FSBL BSP run on the FSBL sdps driver as on the
+* target: the card is brought up by disk_initialize, formatted FAT32 with
+* 32 KB clusters by f_mkfs and a file of RECORD_BYTES is written with
+* f_write in chunks of 4 KB and 32 KB, then closed, read back and
+* compared. The program is built three times: with the polled writes of
+* diskio.c, with XILFFS_WRITE_PIPELINE and with XILFFS_WRITE_PIPELINE and
+* 128 sectors per buffer.
+*
+* - Full rate: the chunks are written back to back. Reported: MB/s from
+*   the first f_write to the end of f_close, the mean and longest f_write
+*   and the number of f_write calls over 10 ms.
+* - Producer: a producer makes RATE bytes per second and f_write is
+*   called for each chunk once it is complete. Reported: the longest
+*   f_write, the longest lag of a chunk behind the producer and the
+*   producer buffer that covers it (the lag at RATE plus one chunk).
+* - Card: write commands, those announced by ACMD23, stalls and the part
+*   of the run the card was busy programming. The pipelined builds add
+*   XILFFS_GET_WRITE_STATS: transfers, time and longest time disk_write
+*   waited for a buffer.
+*
+* Only the register accesses, the polling of the drivers, the card and bus
+* times of the model and the copy into the pipeline buffers take modeled
+* time. The CPU time of FatFs and of the copies FatFs makes itself is not
+* accounted, so the results are an upper bound of what the CPU side
+* allows. The SD clock is XPAR_XSDPS_0_SDIO_CLK_FREQ_HZ, 50 MHz high speed
+* after the switch. The register access time, the copy rate and the card
+* times are assumptions printed with the results, the card times as two
+* profiles: card A with short programming and a stall every 4 MB, card B
+* slower with a stall every 1 MB. The 250 ms limit of the write busy time
+* of an SDHC card in the SD physical layer specification bounds the
+* stalls of both.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <string.h>
+
+#include "host.h"
+#include "scugic_model.h"
+#include "sdps_model.h"
+#include "xparameters.h"
+#include "ff.h"
+#include "diskio.h"
+#include "xil_sutil.h"
+
+/* Assumed, see the file comment */
+#define ACCESS_NS	100U
+#define COPY_MBPS	400U
+
+#define SD_BASE		XPAR_XSDPS_0_BASEADDR
+#define SD_CLOCK	XPAR_XSDPS_0_SDIO_CLK_FREQ_HZ
+#define CARD_BLOCKS	(4U * 1024U * 1024U * 2U)	/* 4 GB */
+#define RECORD_BYTES	(8U * 1024U * 1024U)
+#define MAX_CHUNK	32768U
+#define RATE		(1024U * 1024U)
+#define SLOW_NS		10000000U
+
+/* Default of diskio.c */
+#ifndef XILFFS_WRITE_PIPELINE_SECTORS
+#define XILFFS_WRITE_PIPELINE_SECTORS	16U
+#endif
+
+typedef struct {
+	const char *Name;
+	SdPsCardTiming Timing;
+} Profile;
+
+typedef struct {
+	u64 Writes;
+	u64 Ns;			/* First f_write to the end of f_close */
+	u64 WriteNs;		/* Time in f_write */
+	u64 MaxWriteNs;
+	u64 Slow;		/* f_write over SLOW_NS */
+	u64 MaxLagNs;
+	u64 CloseNs;
+} Result;
+
+/* Defined in xil_cache.c, no coherent pool: the driver maintains the cache */
+UINTPTR XilDmaPoolCoherentBase;
+u32 XilDmaPoolCoherentSize;
+
+static ScuGicModel Gic;
+static SdPsModel Model;
+static FATFS Fs;
+static FIL File;
+static u8 Chunk[MAX_CHUNK];
+static u8 Work[MAX_CHUNK];
+static u32 Mapped;
+static u64 CopyNs;
+
+/* The copy into the pipeline buffers at COPY_MBPS */
+s32 BenchMemCpy(void *Dest, const u32 DestSize, const void *Src,
+		const u32 SrcSize, const u32 CopyLen)
+{
+	u64 Ns = ((u64)CopyLen * 1000U) / COPY_MBPS;
+
+	Host_Advance(Ns);
+	CopyNs += Ns;
+	return Xil_SMemCpy(Dest, DestSize, Src, SrcSize, CopyLen);
+}
+
+static u8 ByteOf(u32 Offset)
+{
+	return (u8)((Offset * 7U) + ((Offset >> 9) * 13U) + (Offset >> 17));
+}
+
+static void Fill(u32 Offset, u32 Len)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < Len; Index++) {
+		Chunk[Index] = ByteOf(Offset + Index);
+	}
+}
+
+static void Setup(const Profile *P)
+{
+	static const MKFS_PARM Opt = { FM_FAT32, 0U, 0U, 0U, 32768U };
+
+	if (Mapped != 0U) {
+		(void)f_unmount("0:");
+		SdPsModel_Release(&Model);
+	}
+	Mapped = 1U;
+	SdPsModel_Init(&Model, SD_BASE, ACCESS_NS, SD_CLOCK, CARD_BLOCKS,
+		       &P->Timing);
+	HOST_CHECK_EQ(f_mkfs("0:", &Opt, Work, sizeof(Work)), FR_OK);
+	HOST_CHECK_EQ(f_mount(&Fs, "0:", 1U), FR_OK);
+#ifdef XILFFS_WRITE_PIPELINE
+	{
+		XilFfs_WriteStats Stats;
+
+		HOST_CHECK_EQ(disk_ioctl(0U, XILFFS_GET_WRITE_STATS, &Stats),
+			      RES_OK);
+	}
+#endif
+}
+
+static void Verify(void)
+{
+	u32 Offset;
+	u32 Index;
+	UINT Done;
+
+	HOST_CHECK_EQ(f_open(&File, "0:rec.bin", FA_READ), FR_OK);
+	for (Offset = 0U; Offset < RECORD_BYTES; Offset += MAX_CHUNK) {
+		Done = 0U;
+		HOST_CHECK_EQ(f_read(&File, Work, MAX_CHUNK, &Done), FR_OK);
+		HOST_CHECK_EQ(Done, MAX_CHUNK);
+		for (Index = 0U; Index < MAX_CHUNK; Index++) {
+			if (Work[Index] != ByteOf(Offset + Index)) {
+				printf("  offset %u: 0x%02x, 0x%02x expected\n",
+				       Offset + Index, Work[Index],
+				       ByteOf(Offset + Index));
+				HOST_CHECK(0);
+				break;
+			}
+		}
+	}
+	HOST_CHECK_EQ(f_close(&File), FR_OK);
+}
+
+static void Measure(const Profile *P, u32 Len, u32 Rate)
+{
+	SdPsCardModel *Card = &Model.Card;
+	Result R;
+	u64 Start;
+	u64 Ready;
+	u64 Begin;
+	u64 Ns;
+	u64 Busy;
+	u32 Offset;
+	UINT Done;
+
+	memset(&R, 0, sizeof(R));
+	Setup(P);
+	Busy = Card->BusyNs;
+	Card->Writes = 0U;
+	Card->PreErasedWrites = 0U;
+	Card->Stalls = 0U;
+	CopyNs = 0U;
+
+	HOST_CHECK_EQ(f_open(&File, "0:rec.bin", FA_CREATE_ALWAYS | FA_WRITE),
+		      FR_OK);
+	Start = Host_Now();
+	for (Offset = 0U; Offset < RECORD_BYTES; Offset += Len) {
+		Fill(Offset, Len);
+		Ready = Start;
+		if (Rate != 0U) {
+			Ready = Start + ((((u64)Offset + Len) * HOST_NS_PER_SEC) /
+					 Rate);
+			if (Host_Now() < Ready) {
+				Host_AdvanceTo(Ready);
+			}
+		}
+		Begin = Host_Now();
+		Done = 0U;
+		HOST_CHECK_EQ(f_write(&File, Chunk, Len, &Done), FR_OK);
+		HOST_CHECK_EQ(Done, Len);
+		Ns = Host_Now() - Begin;
+		R.Writes++;
+		R.WriteNs += Ns;
+		if (Ns > R.MaxWriteNs) {
+			R.MaxWriteNs = Ns;
+		}
+		if (Ns > SLOW_NS) {
+			R.Slow++;
+		}
+		if ((Rate != 0U) && ((Host_Now() - Ready) > R.MaxLagNs)) {
+			R.MaxLagNs = Host_Now() - Ready;
+		}
+	}
+	Begin = Host_Now();
+	HOST_CHECK_EQ(f_close(&File), FR_OK);
+	R.CloseNs = Host_Now() - Begin;
+	R.Ns = Host_Now() - Start;
+	Busy = Card->BusyNs - Busy;
+
+	if (Rate == 0U) {
+		printf("  %5u KB %8s %7.2f %8.2f %8.2f %5llu", Len / 1024U,
+		       "full", (double)RECORD_BYTES / ((double)R.Ns * 1e-3),
+		       (double)R.WriteNs * 1e-6 / (double)R.Writes,
+		       (double)R.MaxWriteNs * 1e-6,
+		       (unsigned long long)R.Slow);
+		printf(" %8s %9s", "-", "-");
+	} else {
+		printf("  %5u KB %5u KB/s %7s %8.2f %8.2f %5llu", Len / 1024U,
+		       Rate / 1024U, "-",
+		       (double)R.WriteNs * 1e-6 / (double)R.Writes,
+		       (double)R.MaxWriteNs * 1e-6,
+		       (unsigned long long)R.Slow);
+		printf(" %8.2f %9llu", (double)R.MaxLagNs * 1e-6,
+		       (unsigned long long)((((R.MaxLagNs * Rate) /
+					      HOST_NS_PER_SEC) + Len + 1023U) /
+					    1024U));
+	}
+	printf(" %8.2f %6llu %6llu %4llu %5.0f%%\n", (double)R.CloseNs * 1e-6,
+	       (unsigned long long)Card->Writes,
+	       (unsigned long long)Card->PreErasedWrites,
+	       (unsigned long long)Card->Stalls,
+	       100.0 * (double)Busy / (double)R.Ns);
+#ifdef XILFFS_WRITE_PIPELINE
+	{
+		XilFfs_WriteStats Stats;
+
+		HOST_CHECK_EQ(disk_ioctl(0U, XILFFS_GET_WRITE_STATS, &Stats),
+			      RES_OK);
+		HOST_CHECK_EQ(Stats.Errors, 0U);
+		printf("  %8s pipeline: %u transfers, disk_write waited %.2f ms, "
+		       "longest %.2f ms, copies %.2f ms\n", "",
+		       Stats.Transfers,
+		       (double)Host_GtNs(Stats.BlockedTime) * 1e-6,
+		       (double)Host_GtNs(Stats.MaxBlockedTime) * 1e-6,
+		       (double)CopyNs * 1e-6);
+	}
+#endif
+
+	Verify();
+	HOST_CHECK_EQ(Model.Collisions + Model.AdmaErrors, 0U);
+	HOST_CHECK_EQ(Card->BusErrors + Card->AddressErrors, 0U);
+}
+
+static int Run(void *Arg)
+{
+	static const Profile Profiles[] = {
+		{ "A", { 1000000U, 100000U, 1000000U, 300000U, 40000U,
+			 4U * 1024U * 1024U, 60000000U } },
+		{ "B", { 1000000U, 100000U, 3000000U, 1000000U, 150000U,
+			 1024U * 1024U, 150000000U } },
+	};
+	static const u32 Chunks[] = { 4096U, 32768U };
+	const Profile *P;
+	u32 Prof;
+	u32 Index;
+
+	(void)Arg;
+#ifdef XILFFS_WRITE_PIPELINE
+	printf("sdps write: xilffs with XILFFS_WRITE_PIPELINE, %u buffers of "
+	       "%u sectors\n", 2U, XILFFS_WRITE_PIPELINE_SECTORS);
+#else
+	printf("sdps write: xilffs with polled writes\n");
+#endif
+	printf(" modeled time, %u MB file on a 4 GB card, FAT32 with 32 KB "
+	       "clusters, register access %u ns and copy %u MB/s assumed\n",
+	       RECORD_BYTES / (1024U * 1024U), ACCESS_NS, COPY_MBPS);
+	for (Prof = 0U; Prof < (sizeof(Profiles) / sizeof(Profiles[0]));
+	     Prof++) {
+		P = &Profiles[Prof];
+		printf(" card %s: write setup %u us (%u us after ACMD23), block "
+		       "%u us, stall %u ms every %u MB, read access %u us "
+		       "(assumed)\n", P->Name, P->Timing.SetupNs / 1000U,
+		       P->Timing.PreErasedSetupNs / 1000U,
+		       P->Timing.BlockNs / 1000U, P->Timing.StallNs / 1000000U,
+		       P->Timing.StallBytes / (1024U * 1024U),
+		       P->Timing.ReadAccessNs / 1000U);
+		printf("  %8s %10s %7s %8s %8s %5s %8s %9s %8s %6s %6s %4s %6s\n",
+		       "chunk", "rate", "MB/s", "mean ms", "max ms", ">10ms",
+		       "lag ms", "buffer KB", "close ms", "writes", "acmd23",
+		       "stls", "busy");
+		for (Index = 0U; Index < (sizeof(Chunks) / sizeof(Chunks[0]));
+		     Index++) {
+			Measure(P, Chunks[Index], 0U);
+			Measure(P, Chunks[Index], RATE);
+		}
+	}
+	(void)f_unmount("0:");
+	SdPsModel_Release(&Model);
+	return 0;
+}
+
+int main(void)
+{
+	Host_Init();
+	ScuGicModel_Init(&Gic, ACCESS_NS);
+	Host_SetWfiWake(ScuGicModel_WakeUp, &Gic);
+	Host_RunLow(Run, NULL);
+	return (Host_Failures != 0U) ? 1 : 0;
+}
@@ -0,0 +1,298 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file bench_usbps.c
+*
+* Bulk throughput of the usbps driver against the controller model in
+* models/usbps_model.c, in modeled time.
+*
+* - XUsbPs_EpBufferSend with 16 KB buffers, one at a time from the
+*   completion handler and four queued.
+* - Streaming IN with four 16 KB or four 64 KB buffers in flight and
+*   streaming OUT into eight 16 KB buffers, the host always has data.
+*
+* Every case runs with the interrupt threshold (CMD ITC) at 0 and at the
+* reset value of 8 microframes and with two interrupt entry latencies.
+* The register access time, the dTD fetch time and the interrupt entry
+* latency are not given by the hardware documents, they are assumptions
+* printed with the results. The CPU time of the driver is only its
+* register accesses, the buffers come from a non-cacheable DMA buffer pool
+* arena and need no cache maintenance. The ceiling is the USB 2.0 bulk
+* limit of the model, 13 packets of 512 bytes per microframe, 53.248 MB/s.
+*
+* Reported per case: MB/s and its share of the ceiling, the time the
+* endpoint was not ready, interrupts, reprimes from the interrupt handler
+* (stream only) and register accesses per MB.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <string.h>
+
+#include "host.h"
+#include "usbps_model.h"
+#include "xil_dmapool.h"
+#include "xil_mmu.h"
+#include "xpseudo_asm.h"
+#include "xstatus.h"
+#include "xusbps.h"
+#include "xusbps_hw.h"
+
+#define USB_BASE	0xE0002000U
+/* Assumed, see the file comment */
+#define ACCESS_NS	150U
+#define FETCH_NS	1000U
+
+#define IN_DTDS		32U
+#define OUT_DTDS	16U
+#define MAX_PACKET	512U
+#define DTD_MAX		XUSBPS_dTD_BUF_MAX_SIZE
+#define TOTAL_BYTES	(16U * 1024U * 1024U)
+#define AREA_SIZE	(512U * 1024U)
+#define BULK_LIMIT	53.248
+
+#define CASE_LEGACY	0U
+#define CASE_STREAM_IN	1U
+#define CASE_STREAM_OUT	2U
+
+u32 MMUTable[4096] __attribute__ ((aligned(16384)));
+
+/* Defined in xil_cache.c, whose maintenance host_rt.c replaces */
+UINTPTR XilDmaPoolCoherentBase;
+u32 XilDmaPoolCoherentSize;
+
+typedef struct {
+	const char *Name;
+	u32 Kind;
+	u32 BufLen;
+	u32 Depth;
+} Case;
+
+static XUsbPs Usb;
+static UsbPsModel Model;
+static XUsbPs_Stream Stream;
+static u32 Mapped;
+static u8 *DmaMem;
+static u8 *Area;
+static u32 IrqNs;
+
+static const Case *Running;
+static u32 Submitted;
+static u32 Completed;
+static u32 Target;
+static u64 LastDone;
+
+static u32 HostOut(void *Ref, u32 Pipe, u8 *Buf, u32 MaxPacket)
+{
+	(void)Ref;
+	(void)Pipe;
+	(void)Buf;
+	return MaxPacket;
+}
+
+static void Interrupt(void *Ref)
+{
+	(void)Ref;
+	while (UsbPsModel_IrqPending(&Model) != 0U) {
+		Host_Advance(IrqNs);
+		XUsbPs_IntrHandler(&Usb);
+	}
+}
+
+static u8 *Buffer(u32 Index)
+{
+	return Area + ((Index % Running->Depth) * Running->BufLen);
+}
+
+static void Submit(void)
+{
+	u8 *Buf = Buffer(Submitted);
+
+	Submitted++;
+	if (Running->Kind == CASE_LEGACY) {
+		(void)XUsbPs_EpBufferSend(&Usb, 1U, Buf, Running->BufLen);
+	} else {
+		(void)XUsbPs_StreamSubmit(&Stream, Buf, Running->BufLen);
+	}
+}
+
+static void Done(void)
+{
+	Completed++;
+	LastDone = Host_Now();
+	if (Submitted < Target) {
+		Submit();
+	}
+}
+
+static void LegacyDone(void *Ref, u8 EpNum, u8 EventType, void *Data)
+{
+	(void)Ref;
+	(void)EpNum;
+	(void)EventType;
+	(void)Data;
+	Done();
+}
+
+static void StreamDone(void *Ref, u8 *BufferPtr, u32 BufferLen,
+		       u32 BytesTxed, s32 Status)
+{
+	(void)Ref;
+	(void)BufferPtr;
+	(void)BufferLen;
+	(void)BytesTxed;
+	(void)Status;
+	Done();
+}
+
+static void Setup(u32 Itc)
+{
+	static XUsbPs_DeviceConfig Cfg;
+
+	if (Mapped != 0U) {
+		(void)XUsbPs_Reset(&Usb);
+		HostIo_Unmap(USB_BASE);
+	}
+	UsbPsModel_Init(&Model, USB_BASE, ACCESS_NS, FETCH_NS);
+	Mapped = 1U;
+	Model.Out = HostOut;
+
+	(void)XUsbPs_CfgInitialize(&Usb, XUsbPs_LookupConfig(USB_BASE),
+				   USB_BASE);
+	memset(&Cfg, 0, sizeof(Cfg));
+	Cfg.NumEndpoints = 2U;
+	Cfg.EpCfg[0].Out.Type = XUSBPS_EP_TYPE_CONTROL;
+	Cfg.EpCfg[0].Out.NumBufs = 2U;
+	Cfg.EpCfg[0].Out.BufSize = 64U;
+	Cfg.EpCfg[0].Out.MaxPacketSize = 64U;
+	Cfg.EpCfg[0].In.Type = XUSBPS_EP_TYPE_CONTROL;
+	Cfg.EpCfg[0].In.NumBufs = 2U;
+	Cfg.EpCfg[0].In.MaxPacketSize = 64U;
+	Cfg.EpCfg[1].Out.Type = XUSBPS_EP_TYPE_BULK;
+	Cfg.EpCfg[1].Out.NumBufs = OUT_DTDS;
+	Cfg.EpCfg[1].Out.MaxPacketSize = MAX_PACKET;
+	Cfg.EpCfg[1].In.Type = XUSBPS_EP_TYPE_BULK;
+	Cfg.EpCfg[1].In.NumBufs = IN_DTDS;
+	Cfg.EpCfg[1].In.MaxPacketSize = MAX_PACKET;
+	Cfg.DMAMemPhys = (u32)(UINTPTR)DmaMem;
+	(void)XUsbPs_ConfigureDevice(&Usb, &Cfg);
+	XUsbPs_IntrEnable(&Usb, XUSBPS_IXR_UI_MASK | XUSBPS_IXR_UE_MASK);
+	/* XUsbPs_SetIntrThreshold would clear RS */
+	XUsbPs_WriteReg(USB_BASE, XUSBPS_CMD_OFFSET,
+			(Itc << 16) | XUSBPS_CMD_RS_MASK);
+}
+
+static void Measure(const Case *C, u32 Itc)
+{
+	u32 Bit = (C->Kind == CASE_STREAM_OUT) ? 1U : 0x11U;
+	u64 Regs;
+	u64 Start;
+	double Ns;
+	double Mb;
+	u32 Index;
+
+	Setup(Itc);
+	Running = C;
+	Submitted = 0U;
+	Completed = 0U;
+	Target = TOTAL_BYTES / C->BufLen;
+	if (C->Kind == CASE_LEGACY) {
+		(void)XUsbPs_EpSetHandler(&Usb, 1U, XUSBPS_EP_DIRECTION_IN,
+					  LegacyDone, NULL);
+	} else {
+		(void)XUsbPs_StreamStart(&Usb, &Stream, 1U,
+					 (C->Kind == CASE_STREAM_OUT) ?
+					 XUSBPS_EP_DIRECTION_OUT :
+					 XUSBPS_EP_DIRECTION_IN, StreamDone, NULL);
+	}
+
+	Regs = Host_Stats.IoReads + Host_Stats.IoWrites;
+	Start = Host_Now();
+	for (Index = 0U; Index < C->Depth; Index++) {
+		Submit();
+	}
+	while (Completed < Target) {
+		if ((Host_EventsPending() == 0U) &&
+		    (UsbPsModel_IrqPending(&Model) == 0U)) {
+			printf("  %s: stalled after %u buffers\n", C->Name, Completed);
+			return;
+		}
+		wfi();
+	}
+	Ns = (double)(LastDone - Start);
+	Mb = (double)TOTAL_BYTES / 1e6;
+	Regs = Host_Stats.IoReads + Host_Stats.IoWrites - Regs;
+	printf("  %-18s ITC %u  irq %4.1f us  %6.2f MB/s %5.1f %%  idle %5.1f %%"
+	       "  irqs %5llu  reprimes %4u  regs/MB %6.0f\n",
+	       C->Name, Itc, (double)IrqNs / 1e3, Mb * 1e9 / Ns,
+	       (Mb * 1e9 / Ns) * 100.0 / BULK_LIMIT,
+	       (double)UsbPsModel_IdleNs(&Model, Bit) * 100.0 / Ns,
+	       (unsigned long long)Model.Interrupts,
+	       (C->Kind == CASE_LEGACY) ? 0U : Stream.Reprimes,
+	       (double)Regs / Mb);
+	if (C->Kind != CASE_LEGACY) {
+		XUsbPs_StreamStop(&Stream);
+	}
+}
+
+static int Run(void *Arg)
+{
+	static const Case Cases[] = {
+		{ "EpBufferSend 16K", CASE_LEGACY, DTD_MAX, 1U },
+		{ "EpBufferSend 16Kx4", CASE_LEGACY, DTD_MAX, 4U },
+		{ "stream IN 16Kx4", CASE_STREAM_IN, DTD_MAX, 4U },
+		{ "stream IN 64Kx4", CASE_STREAM_IN, 4U * DTD_MAX, 4U },
+		{ "stream OUT 16Kx8", CASE_STREAM_OUT, DTD_MAX, 8U },
+	};
+	static const u32 Irqs[] = { 2000U, 20000U };
+	static const u32 Itcs[] = { 0U, 8U };
+	u32 Index;
+	u32 Irq;
+	u32 Itc;
+
+	(void)Arg;
+	for (Index = 0U; Index < 4096U; Index++) {
+		MMUTable[Index] = (Index << 20) | NORM_WB_CACHE;
+	}
+	DmaMem = Host_AllocLow(64U * 1024U, 4096U);
+	Area = Host_AllocLow(AREA_SIZE, XIL_MMU_PAGE_SIZE);
+	(void)Xil_DmaPoolInit(Area, AREA_SIZE, XIL_DMAPOOL_NONCACHEABLE);
+	Host_SetWfiHook(Interrupt, NULL);
+
+	printf("usbps: modeled time, %u MB per case, register access %u ns "
+	       "and dTD fetch %u ns assumed,\n       bulk limit %.3f MB/s\n",
+	       TOTAL_BYTES >> 20, ACCESS_NS, FETCH_NS, BULK_LIMIT);
+	for (Index = 0U; Index < (sizeof(Cases) / sizeof(Cases[0])); Index++) {
+		for (Itc = 0U; Itc < (sizeof(Itcs) / sizeof(Itcs[0])); Itc++) {
+			for (Irq = 0U; Irq < (sizeof(Irqs) / sizeof(Irqs[0]));
+			     Irq++) {
+				IrqNs = Irqs[Irq];
+				Measure(&Cases[Index], Itcs[Itc]);
+			}
+		}
+	}
+	if (Model.Violations != 0U) {
+		printf("usbps: %llu driver violations\n",
+		       (unsigned long long)Model.Violations);
+	}
+	return 0;
+}
+
+int main(void)
+{
+	Host_Init();
+	Host_RunLow(Run, NULL);
+	return 0;
+}
@@ -0,0 +1,247 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file bench_wait.c
+*
+* Wake up latency and active CPU time of the event waits, in modeled time,
+* against models/scugic_model.c and the global timer of the host runtime.
+* The event is a status bit of a register window at the SDIO 0 address
+* that drives interrupt ID 56.
+*
+* - For events 5 us to 5 ms after the call, with a random phase, three
+*   ways to wait for them:
+*   - Xil_WaitForEvent of xil_sutil.c, which samples the register between
+*     usleep(1) calls, with the busy usleep of globaltimer_sleep_zynq.c,
+*   - Xil_WaitForEventWfi on the interrupt,
+*   - Xil_WaitForEventWfi with XIL_WAIT_NO_INTR, woken every
+*     XIL_WAIT_POLL_US.
+*   For each: the time from the event to the return (mean and max), the
+*   time the core executed per wait and its share of the wait, in
+*   microseconds and in CPU cycles, and the WFI exits per wait.
+* - Xil_WaitUs: how late it returns, early is negative, and the
+*   comparator to resume latency of Xil_WaitGetStats.
+*
+* Executing is everything but WFI, the WFI exit counts as executing. The
+* register access time and the WFI exit time are not given by the
+* hardware documents. They are assumptions printed with the results, the
+* WFI exit time is swept. The polled wait does not enter WFI, its numbers
+* do not depend on it.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include "host.h"
+#include "scugic_model.h"
+#include "xil_wait.h"
+#include "xil_util.h"
+#include "xparameters.h"
+#include "xstatus.h"
+
+#define DEV_BASEADDR		XPS_SDIO0_BASEADDR
+#define DEV_INTR		XPS_SDIO0_INT_ID
+#define DEV_STATUS_OFFSET	0x30U	/* Write one to clear */
+#define DEV_EVENT		0x1U
+
+/* Assumed, see the file comment */
+#define ACCESS_NS		100U
+
+#define WAITS			20U
+#define TIMEOUT_US		20000U
+#define CPU_MHZ			((double)XPAR_CPU_CORE_CLOCK_FREQ_HZ / 1e6)
+
+#define MODE_POLLED		0U
+#define MODE_INTR		1U
+#define MODE_NO_INTR		2U
+
+typedef struct {
+	double MeanLatency;	/* ns */
+	double MaxLatency;
+	double Active;		/* ns per wait */
+	double Share;		/* of the wait */
+	double Wakeups;		/* per wait */
+} Result;
+
+static ScuGicModel Gic;
+static u32 DevStatus;
+static u64 EventNs;
+static u32 WfiExitNs;
+static u32 Seed = 38U;
+
+static u32 Rand(void)
+{
+	Seed = (Seed * 1103515245U) + 12345U;
+	return Seed >> 8;
+}
+
+static u32 DevRead(void *Ref, u32 Offset, u32 Size)
+{
+	(void)Ref;
+	(void)Size;
+	return (Offset == DEV_STATUS_OFFSET) ? DevStatus : 0U;
+}
+
+static void DevWrite(void *Ref, u32 Offset, u32 Value, u32 Size)
+{
+	(void)Ref;
+	(void)Size;
+	if (Offset == DEV_STATUS_OFFSET) {
+		DevStatus &= ~Value;
+	}
+}
+
+static u32 DevLine(void *Ref, u32 IntrId)
+{
+	(void)Ref;
+	return ((IntrId == DEV_INTR) && (DevStatus != 0U)) ? 1U : 0U;
+}
+
+static void DevEvent(void *Ref)
+{
+	(void)Ref;
+	DevStatus |= DEV_EVENT;
+	EventNs = Host_Now();
+}
+
+static void WfiExit(void *Ref)
+{
+	(void)Ref;
+	Host_Advance(WfiExitNs);
+}
+
+static void Measure(u32 Mode, u32 DelayUs, Result *Res)
+{
+	u64 Start;
+	u64 Wfi;
+	u64 WfiNs;
+	u64 Latency;
+	u64 Elapsed = 0U;
+	u64 Asleep = 0U;
+	u64 Exits = 0U;
+	u32 Status;
+	u32 Index;
+
+	Res->MeanLatency = 0.0;
+	Res->MaxLatency = 0.0;
+	for (Index = 0U; Index < WAITS; Index++) {
+		DevStatus = 0U;
+		Start = Host_Now();
+		Host_Schedule(Start + ((u64)DelayUs * 1000U) + (Rand() % 1000U),
+			      DevEvent, NULL);
+		Wfi = Host_Stats.Wfi;
+		WfiNs = Host_Stats.WfiNs;
+		if (Mode == MODE_POLLED) {
+			Status = Xil_WaitForEvent(DEV_BASEADDR + DEV_STATUS_OFFSET,
+						  DEV_EVENT, DEV_EVENT,
+						  TIMEOUT_US);
+		} else {
+			Status = Xil_WaitForEventWfi(DEV_BASEADDR +
+						     DEV_STATUS_OFFSET,
+						     DEV_EVENT, DEV_EVENT,
+						     TIMEOUT_US,
+						     (Mode == MODE_INTR) ?
+						     DEV_INTR : XIL_WAIT_NO_INTR);
+		}
+		if (Status != XST_SUCCESS) {
+			printf("wait: event missed\n");
+			Host_Failures++;
+		}
+		Latency = Host_Now() - EventNs;
+		Res->MeanLatency += (double)Latency / WAITS;
+		if ((double)Latency > Res->MaxLatency) {
+			Res->MaxLatency = (double)Latency;
+		}
+		Elapsed += Host_Now() - Start;
+		Asleep += Host_Stats.WfiNs - WfiNs;
+		Exits += Host_Stats.Wfi - Wfi;
+	}
+	Res->Active = (double)(Elapsed - Asleep) / WAITS;
+	Res->Share = (double)(Elapsed - Asleep) / (double)Elapsed;
+	Res->Wakeups = (double)Exits / WAITS;
+}
+
+static void Print(const char *Name, u32 DelayUs, const Result *Res)
+{
+	printf("  %-9s event %5u us  latency %7.2f us mean %7.2f us max  "
+	       "active %8.1f us %11.0f cycles %5.1f %%  %6.1f WFI exits\n",
+	       Name, DelayUs, Res->MeanLatency / 1e3, Res->MaxLatency / 1e3,
+	       Res->Active / 1e3, (Res->Active / 1e3) * CPU_MHZ,
+	       Res->Share * 100.0, Res->Wakeups);
+}
+
+static void SleepLatency(u32 Us)
+{
+	Xil_WaitStats Stats;
+	u64 Start;
+	s64 Late = 0;
+	u32 Index;
+
+	Xil_WaitResetStats();
+	for (Index = 0U; Index < WAITS; Index++) {
+		Start = Host_Now();
+		Xil_WaitUs(Us);
+		Late += (s64)(Host_Now() - Start) - ((s64)Us * 1000);
+	}
+	Xil_WaitGetStats(&Stats);
+	printf("  Xil_WaitUs %5u us  returns %6.2f us late  comparator to "
+	       "resume %5.2f us mean %5.2f us max  %5.1f %% in WFI\n", Us,
+	       (double)Late / WAITS / 1e3,
+	       (double)Host_GtNs(Stats.SumWakeLatency / Stats.TimerWakeups) /
+	       1e3, (double)Host_GtNs(Stats.MaxWakeLatency) / 1e3,
+	       (100.0 * (double)Stats.SleepCounts) / (double)Stats.WaitCounts);
+}
+
+static int Run(void *Arg)
+{
+	static const u32 DelayUs[] = { 5U, 50U, 500U, 5000U };
+	static const u32 ExitNs[] = { 100U, 1000U, 10000U };
+	Result Res;
+	u32 Exit;
+	u32 Delay;
+
+	(void)Arg;
+	printf("wait: modeled time, register access %u ns assumed, WFI exit "
+	       "swept, CPU %.2f MHz\n", ACCESS_NS, CPU_MHZ);
+	for (Delay = 0U; Delay < (sizeof(DelayUs) / sizeof(DelayUs[0]));
+	     Delay++) {
+		Measure(MODE_POLLED, DelayUs[Delay], &Res);
+		Print("polled", DelayUs[Delay], &Res);
+	}
+	for (Exit = 0U; Exit < (sizeof(ExitNs) / sizeof(ExitNs[0])); Exit++) {
+		WfiExitNs = ExitNs[Exit];
+		printf(" WFI exit %u ns\n", WfiExitNs);
+		for (Delay = 0U; Delay < (sizeof(DelayUs) / sizeof(DelayUs[0]));
+		     Delay++) {
+			Measure(MODE_INTR, DelayUs[Delay], &Res);
+			Print("interrupt", DelayUs[Delay], &Res);
+			Measure(MODE_NO_INTR, DelayUs[Delay], &Res);
+			Print("no intr", DelayUs[Delay], &Res);
+		}
+		SleepLatency(10U);
+		SleepLatency(1000U);
+	}
+	return 0;
+}
+
+int main(void)
+{
+	Host_Init();
+	ScuGicModel_Init(&Gic, ACCESS_NS);
+	Gic.Line = DevLine;
+	HostIo_Map(DEV_BASEADDR, 0x100U, ACCESS_NS, DevRead, DevWrite, NULL);
+	Host_SetWfiWake(ScuGicModel_WakeUp, &Gic);
+	Host_SetWfiHook(WfiExit, NULL);
+	Host_RunLow(Run, NULL);
+	return (Host_Failures != 0U) ? 1 : 0;
+}
@@ -0,0 +1,242 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file bench_xadcps.c
+*
+* Sweep rate and CPU cost of the sampling engine in xadcps_sampler.c
+* against the XADC model in models/xadcps_model.c, in modeled time.
+*
+* - Continuous sweeps from the data FIFO threshold interrupt: sweeps per
+*   second, CPU time per sweep (interrupt entry and handler) and the share
+*   of the CPU it takes at that rate.
+* - Sweeps triggered from a periodic timer interrupt at 1 kHz and 10 kHz:
+*   the share of the CPU (timer interrupt with the trigger, data FIFO
+*   interrupt with the drain). A trigger while a sweep is in flight is
+*   refused, sweeps slower than the timer run at a lower rate.
+* - The loop the engine replaces, XAdcPs_GetAdcData for every channel,
+*   which keeps the CPU waiting on the FIFO for two commands per channel:
+*   CPU time per sweep, all of it busy.
+*
+* The interface time per command, the register access time and the
+* interrupt entry latency are not given by the hardware documents. They
+* are assumptions printed with the results, the command time is swept.
+* Conversions take 1 us, the 1 MSPS of the XADC. Fresh is the share of
+* register reads that returned a conversion newer than the previous read
+* of that channel, the rest repeat a value.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <string.h>
+
+#include "host.h"
+#include "xadcps.h"
+#include "xadcps_model.h"
+#include "xstatus.h"
+
+#define XADC_BASE	0xF8007100U
+/* Assumed, see the file comment */
+#define ACCESS_NS	150U
+#define IRQ_NS		2000U
+#define CONV_NS		1000U
+
+#define SWEEPS		2000U
+
+static XAdcPs Xadc;
+static XAdcPsModel Model;
+static XAdcPs_Sampler Sampler;
+static u32 Mapped;
+static u64 Violations;
+
+static u64 CpuNs;		/* Interrupt entry and handlers */
+static u32 TimerPeriod;		/* 0 when no timer runs */
+static u32 TimerDue;
+
+static u16 Source(void *Ref, u32 Channel, u64 Pass)
+{
+	(void)Ref;
+	return (u16)((Channel << 8) ^ (u32)Pass);
+}
+
+static void Timer(void *Ref)
+{
+	(void)Ref;
+	TimerDue = 1U;
+	Host_Schedule(Host_Now() + TimerPeriod, Timer, NULL);
+}
+
+static void Interrupt(void *Ref)
+{
+	u64 Start;
+
+	(void)Ref;
+	while ((XAdcPsModel_IrqPending(&Model) != 0U) || (TimerDue != 0U)) {
+		Start = Host_Now();
+		Host_Advance(IRQ_NS);
+		if (TimerDue != 0U) {
+			TimerDue = 0U;
+			(void)XAdcPs_SamplerTrigger(&Sampler);
+		} else {
+			XAdcPs_SamplerIntrHandler(&Sampler);
+		}
+		CpuNs += Host_Now() - Start;
+	}
+}
+
+static void Setup(u32 Mask, u32 CmdNs, int Continuous)
+{
+	if (Mapped != 0U) {
+		Violations += Model.Violations;
+		HostIo_Unmap(XADC_BASE);
+	}
+	XAdcPsModel_Init(&Model, XADC_BASE, ACCESS_NS, CmdNs, CONV_NS);
+	Model.Source = Source;
+	Mapped = 1U;
+	(void)XAdcPs_CfgInitialize(&Xadc, XAdcPs_LookupConfig(XADC_BASE),
+				   XADC_BASE);
+	(void)XAdcPs_SamplerStart(&Xadc, &Sampler, Mask, XADCPS_AVG_0_SAMPLES,
+				  Continuous);
+	/* The first conversions of every channel are done */
+	Host_Advance(32U * CONV_NS);
+	Model.StatusReads = 0U;
+	Model.FreshReads = 0U;
+	CpuNs = 0U;
+}
+
+static void Drain(void)
+{
+	u32 Factor;
+
+	Factor = XAdcPs_SamplerAvailable(&Sampler);
+	if (Factor != 0U) {
+		XAdcPs_SamplerStats Stats[XADCPS_SAMPLER_MAX_CH];
+
+		(void)XAdcPs_SamplerDecimate(&Sampler, Factor, Stats, NULL);
+	}
+}
+
+/* Continuous sweeps, returns sweeps/s, CPU ns per sweep in *CpuPtr */
+static double Continuous(u32 Mask, u32 CmdNs, double *CpuPtr,
+			 double *FreshPtr)
+{
+	u64 Start;
+
+	Setup(Mask, CmdNs, TRUE);
+	XAdcPs_IntrEnable(&Xadc, XADCPS_INTX_DFIFO_GTH_MASK);
+	Start = Host_Now();
+	(void)XAdcPs_SamplerTrigger(&Sampler);
+	while (Sampler.Sweeps < SWEEPS) {
+		wfi();
+		Drain();
+	}
+	*CpuPtr = (double)CpuNs / SWEEPS;
+	*FreshPtr = (double)Model.FreshReads * 100.0 / (double)Model.StatusReads;
+	XAdcPs_SamplerStop(&Sampler);
+	return (double)SWEEPS * 1e9 / (double)(Host_Now() - Start);
+}
+
+/* Sweeps from a timer at Hz, returns the CPU share in % */
+static double Triggered(u32 Mask, u32 CmdNs, u32 Hz)
+{
+	u64 Start;
+
+	Setup(Mask, CmdNs, FALSE);
+	XAdcPs_IntrEnable(&Xadc, XADCPS_INTX_DFIFO_GTH_MASK);
+	TimerPeriod = 1000000000U / Hz;
+	Start = Host_Now();
+	Host_Schedule(Start + TimerPeriod, Timer, NULL);
+	while (Sampler.Sweeps < (SWEEPS / 4U)) {
+		wfi();
+		Drain();
+	}
+	Host_Cancel(Timer, NULL);
+	TimerDue = 0U;
+	XAdcPs_SamplerStop(&Sampler);
+	return (double)CpuNs * 100.0 / (double)(Host_Now() - Start);
+}
+
+/* XAdcPs_GetAdcData loop, returns CPU ns per sweep */
+static double Polled(u32 Mask, u32 CmdNs)
+{
+	u64 Start;
+	u32 Sweep;
+	u32 Index;
+	u16 Data[XADCPS_SAMPLER_MAX_CH];
+
+	Setup(Mask, CmdNs, FALSE);
+	Start = Host_Now();
+	for (Sweep = 0U; Sweep < SWEEPS; Sweep++) {
+		for (Index = 0U; Index < Sampler.NumCh; Index++) {
+			Data[Index] = XAdcPs_GetAdcData(&Xadc,
+							Sampler.Channel[Index]);
+		}
+	}
+	(void)Data;
+	return (double)(Host_Now() - Start) / SWEEPS;
+}
+
+static int Run(void *Arg)
+{
+	static const u32 Masks[] = {
+		XADCPS_SEQ_CH_TEMP | XADCPS_SEQ_CH_VCCINT | XADCPS_SEQ_CH_VCCAUX |
+		XADCPS_SEQ_CH_VCCPINT,
+		0x00FF0000U,
+		0xFFFF0000U,
+		0xFFFF7FE0U,
+	};
+	static const u32 CmdNs[] = { 400U, 800U, 1600U, 3200U };
+	double Rate;
+	double Cpu;
+	double Fresh;
+	double Poll;
+	double Khz1;
+	double Khz10;
+	u32 Index;
+	u32 Cmd;
+
+	(void)Arg;
+	Host_SetWfiHook(Interrupt, NULL);
+
+	printf("xadcps: modeled time, register access %u ns and interrupt entry "
+	       "%u ns assumed,\n        command time swept, conversions "
+	       "%u ns\n", ACCESS_NS, IRQ_NS, CONV_NS);
+	for (Index = 0U; Index < (sizeof(Masks) / sizeof(Masks[0])); Index++) {
+		for (Cmd = 0U; Cmd < (sizeof(CmdNs) / sizeof(CmdNs[0])); Cmd++) {
+			Rate = Continuous(Masks[Index], CmdNs[Cmd], &Cpu, &Fresh);
+			Khz1 = Triggered(Masks[Index], CmdNs[Cmd], 1000U);
+			Khz10 = Triggered(Masks[Index], CmdNs[Cmd], 10000U);
+			Poll = Polled(Masks[Index], CmdNs[Cmd]);
+			printf("  %2u ch  cmd %4u ns  continuous %6.0f sweeps/s "
+			       "cpu %5.1f us/sweep %4.1f %%  fresh %3.0f %%  "
+			       "1 kHz %4.1f %%  10 kHz %5.1f %%  GetAdcData "
+			       "%6.1f us/sweep\n",
+			       Sampler.NumCh, CmdNs[Cmd], Rate, Cpu / 1e3,
+			       Rate * Cpu / 1e7, Fresh, Khz1, Khz10, Poll / 1e3);
+		}
+	}
+	Violations += Model.Violations;
+	if (Violations != 0U) {
+		printf("xadcps: %llu driver violations\n",
+		       (unsigned long long)Violations);
+	}
+	return 0;
+}
+
+int main(void)
+{
+	Host_Init();
+	Host_RunLow(Run, NULL);
+	return 0;
+}
@@ -0,0 +1,178 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file host.h
+*
+* Host runtime for building BSP drivers and FSBL code on a 64 bit Linux host
+* and running them against device models.
+*
+* - The code under test is built with XIL_IO_MODEL, every register access
+*   goes through Xil_IoModelRead/Xil_IoModelWrite and is dispatched to the
+*   model window registered with HostIo_Map. An access outside every window
+*   stops the program.
+* - Time is modeled, not measured. It only advances by the access cost of
+*   the model windows, by Host_Advance and by WFI, which skips to the next
+*   scheduled event. Host CPU time is never accounted, so every result is
+*   a statement about the device models and their cost parameters.
+* - The global timer at XPAR_GLOBAL_TMR_BASEADDR is part of the runtime,
+*   its counter is derived from the modeled time and every read of it costs
+*   one timer tick so that polling loops make progress. It counts at
+*   COUNTS_PER_SECOND unless a clock model changes its rate with
+*   Host_GtSetRate. The comparator sets the event flag once the counter
+*   reaches it (a comparator written behind the counter matches at once),
+*   with auto increment it moves on by the increment register.
+*   Host_GtIrqPending is the interrupt line, ID 27, for a GIC model.
+* - WFI returns at the next event, or with Host_SetWfiWake only once the
+*   wake condition holds, skipping from event to event. Host_Stats.WfiNs
+*   adds up the time spent in WFI.
+* - The drivers keep addresses in u32 variables. The binaries are linked
+*   without PIE and the tests run through Host_RunLow on a stack below
+*   4 GB, buffers come from the low heap or from Host_MapLow.
+* - CP15 and CPSR accesses, barriers and cache maintenance are recorded in
+*   Host_Stats and can be observed through hooks.
+* - Host_SetIrq gives CPU 0 an interrupt line. Its handler runs like an
+*   IRQ, with the I bit of the CPSR set, whenever the line is high and the
+*   I bit is clear: after every event, so between two register accesses,
+*   and when a CPSR write clears the I bit. The CPSR starts with IRQs
+*   masked.
+* - Host_StartCpu runs code on a second CPU, a host thread. Every CPU has
+*   its own event register for WFE and SEV. The register windows, the
+*   modeled time and Host_Stats are shared and not locked, code run on two
+*   CPUs should only share memory and the models it locks itself.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef HOST_H
+#define HOST_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HOST_IO_MAX_WINDOWS	32U
+#define HOST_MAX_EVENTS		64U
+#define HOST_CP_MAX_REGS	64U
+
+#define HOST_NS_PER_SEC		1000000000ULL
+
+/* Cache operations passed to the cache hook */
+#define HOST_CACHE_DFLUSH_RANGE	0U
+#define HOST_CACHE_DINVAL_RANGE	1U
+#define HOST_CACHE_DFLUSH_ALL	2U
+#define HOST_CACHE_DINVAL_ALL	3U
+#define HOST_CACHE_IINVAL	4U
+
+typedef u32 (*HostIoRead)(void *Ref, u32 Offset, u32 Size);
+typedef void (*HostIoWrite)(void *Ref, u32 Offset, u32 Value, u32 Size);
+typedef void (*HostEventFn)(void *Ref);
+typedef void (*HostHook)(void *Ref);
+typedef u32 (*HostWake)(void *Ref);
+typedef void (*HostCacheHook)(u32 Op, UINTPTR Addr, u32 Len, void *Ref);
+typedef void (*HostCpHook)(const char *Reg, u32 Value, void *Ref);
+
+typedef struct {
+	u64 IoReads;
+	u64 IoWrites;
+	u64 Isb;
+	u64 Dsb;
+	u64 Dmb;
+	u64 Wfi;
+	u64 WfiNs;
+	u64 Wfe;
+	u64 Sev;
+	u64 CpReads;
+	u64 CpWrites;
+	u64 DCacheFlushRange;
+	u64 DCacheFlushBytes;
+	u64 DCacheInvalRange;
+	u64 DCacheInvalBytes;
+	u64 DCacheFlushAll;
+	u64 DCacheInvalAll;
+	u64 ICacheInval;
+} HostStats;
+
+extern HostStats Host_Stats;
+extern u32 Host_Failures;
+
+/* Test checks, a failed check is reported and counted, the test goes on */
+#define HOST_CHECK(Cond)						\
+	do {								\
+		if (!(Cond)) {						\
+			Host_Fail(__FILE__, __LINE__, #Cond);		\
+		}							\
+	} while (0)
+
+#define HOST_CHECK_EQ(A, B)						\
+	do {								\
+		u64 HostA_ = (u64)(A);					\
+		u64 HostB_ = (u64)(B);					\
+		if (HostA_ != HostB_) {					\
+			Host_FailEq(__FILE__, __LINE__, #A, HostA_, HostB_); \
+		}							\
+	} while (0)
+
+void Host_Init(void);
+void Host_Fail(const char *File, int Line, const char *Cond);
+void Host_FailEq(const char *File, int Line, const char *Expr, u64 Got,
+		 u64 Expected);
+int Host_Result(const char *Name);
+
+/* Register windows */
+void HostIo_Map(UINTPTR Base, u32 Size, u32 AccessNs, HostIoRead Read,
+		HostIoWrite Write, void *Ref);
+void HostIo_Unmap(UINTPTR Base);
+
+/* Modeled time in ns */
+u64 Host_Now(void);
+void Host_Advance(u64 Ns);
+void Host_AdvanceTo(u64 At);
+void Host_Schedule(u64 At, HostEventFn Fn, void *Ref);
+void Host_Cancel(HostEventFn Fn, void *Ref);
+u32 Host_EventsPending(void);
+u64 Host_GtCounts(u64 Ns);
+u64 Host_GtNs(u64 Counts);
+void Host_GtSetRate(u32 Num, u32 Den);
+u32 Host_GtIrqPending(void);
+
+/* Hooks, NULL removes the hook */
+void Host_SetWfiHook(HostHook Hook, void *Ref);
+void Host_SetWfiWake(HostWake Wake, void *Ref);
+void Host_SetCacheHook(HostCacheHook Hook, void *Ref);
+void Host_SetCpHook(HostCpHook Hook, void *Ref);
+void Host_SetIrq(HostWake Line, HostHook Handler, void *Ref);
+
+/* CP15 state */
+void HostCp_Set(const char *Reg, u32 Value);
+u32 HostCp_Writes(const char *Reg);
+
+/* Memory below 4 GB */
+void *Host_MapLow(UINTPTR Addr, size_t Size);
+void *Host_AllocLow(size_t Size, size_t Align);
+int Host_RunLow(int (*Fn)(void *Arg), void *Arg);
+
+/* A second CPU, Fn runs on a stack below 4 GB */
+u32 Host_StartCpu(int (*Fn)(void *Arg), void *Arg);
+void Host_JoinCpu(u32 Cpu);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_H */
@@ -0,0 +1,872 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file host_rt.c
+*
+* Host runtime, see host.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "host.h"
+#include "xil_assert.h"
+#include "xil_cache.h"
+#include "xil_io.h"
+#include "xtime_l.h"
+
+#define HOST_LOW_STACK_SIZE	(8U * 1024U * 1024U)
+#define HOST_GT_WINDOW_SIZE	0x20U
+#define HOST_GT_ISR_OFFSET	0x0CU
+#define HOST_GT_COMPL_OFFSET	0x10U
+#define HOST_GT_COMPH_OFFSET	0x14U
+#define HOST_GT_AUTOINC_OFFSET	0x18U
+#define HOST_GT_CTRL_COMP	0x2U
+#define HOST_GT_CTRL_IRQ	0x4U
+#define HOST_GT_CTRL_AUTOINC	0x8U
+#define HOST_MAX_CPUS		2U
+#define HOST_CPSR_I		0x80U
+/* Real time a CPU may sit in WFE before it counts as a lost wake-up */
+#define HOST_WFE_TIMEOUT_SEC	2
+
+typedef struct {
+	UINTPTR Base;
+	u32 Size;
+	u32 AccessNs;
+	HostIoRead Read;
+	HostIoWrite Write;
+	void *Ref;
+} HostIoWindow;
+
+typedef struct {
+	u64 At;
+	HostEventFn Fn;
+	void *Ref;
+} HostEvent;
+
+typedef struct {
+	const char *Name;
+	u32 Value;
+	u32 Writes;
+} HostCpReg;
+
+HostStats Host_Stats;
+u32 Host_Failures;
+
+static HostIoWindow IoWindows[HOST_IO_MAX_WINDOWS];
+static u32 IoWindowCount;
+static HostEvent Events[HOST_MAX_EVENTS];
+static u32 EventCount;
+static u64 Now;
+
+static u32 Cpsr = 0xDFU;
+static u32 Gpr[16];
+static HostCpReg CpRegs[HOST_CP_MAX_REGS];
+static u32 CpRegCount;
+
+/*
+ * The event register of every CPU: SEV counts up, a CPU has an event
+ * pending while its last seen count differs
+ */
+static pthread_mutex_t SevLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t SevCond = PTHREAD_COND_INITIALIZER;
+static u64 SevCount;
+static __thread u64 SevSeen;
+static pthread_t CpuThreads[HOST_MAX_CPUS];
+static u32 CpuCount = 1U;
+
+/* Counter value at GtBaseNs, rate GtNum/GtDen of COUNTS_PER_SECOND since */
+static u64 GtBase;
+static u64 GtBaseNs;
+static u32 GtNum = 1U;
+static u32 GtDen = 1U;
+static u32 GtRegs[HOST_GT_WINDOW_SIZE / 4U];
+
+static HostHook WfiHook;
+static void *WfiHookRef;
+static HostWake WfiWake;
+static void *WfiWakeRef;
+static HostCacheHook CacheHook;
+static void *CacheHookRef;
+static HostCpHook CpHook;
+static void *CpHookRef;
+static HostWake IrqLine;
+static HostHook IrqHandler;
+static void *IrqRef;
+
+static void HostDie(const char *Msg, UINTPTR Addr)
+{
+	fflush(stdout);
+	fprintf(stderr, "host: %s 0x%08lx at %llu ns\n", Msg,
+		(unsigned long)Addr, (unsigned long long)Now);
+	abort();
+}
+
+/* Takes the interrupt while its line is high and IRQs are unmasked */
+static void HostTakeIrq(void)
+{
+	u32 Saved;
+
+	while ((IrqLine != NULL) && ((Cpsr & HOST_CPSR_I) == 0U) &&
+	       (IrqLine(IrqRef) != 0U)) {
+		Saved = Cpsr;
+		Cpsr |= HOST_CPSR_I;
+		IrqHandler(IrqRef);
+		Cpsr = Saved;
+	}
+}
+
+/*****************************************************************************/
+/*
+ * Checks and results
+ */
+void Host_Fail(const char *File, int Line, const char *Cond)
+{
+	Host_Failures++;
+	printf("%s:%d: check failed: %s\n", File, Line, Cond);
+}
+
+void Host_FailEq(const char *File, int Line, const char *Expr, u64 Got,
+		 u64 Expected)
+{
+	Host_Failures++;
+	printf("%s:%d: %s is 0x%llx, expected 0x%llx\n", File, Line, Expr,
+	       (unsigned long long)Got, (unsigned long long)Expected);
+}
+
+int Host_Result(const char *Name)
+{
+	if (Host_Failures != 0U) {
+		printf("FAIL %s (%u failed checks)\n", Name, Host_Failures);
+		return 1;
+	}
+	printf("PASS %s\n", Name);
+	return 0;
+}
+
+static void HostAssertCallback(const char8 *File, s32 Line)
+{
+	Host_Fail(File, (int)Line, "Xil_Assert");
+}
+
+/*****************************************************************************/
+/*
+ * Modeled time and events
+ */
+u64 Host_GtCounts(u64 Ns)
+{
+	return (u64)(((unsigned __int128)Ns * COUNTS_PER_SECOND) /
+		     HOST_NS_PER_SEC);
+}
+
+u64 Host_GtNs(u64 Counts)
+{
+	return (u64)(((unsigned __int128)Counts * HOST_NS_PER_SEC +
+		      COUNTS_PER_SECOND - 1U) / COUNTS_PER_SECOND);
+}
+
+u64 Host_Now(void)
+{
+	return Now;
+}
+
+static s32 HostNextEvent(u64 Limit)
+{
+	s32 Next = -1;
+	u32 Index;
+
+	for (Index = 0U; Index < EventCount; Index++) {
+		if ((Events[Index].At <= Limit) &&
+		    ((Next < 0) || (Events[Index].At < Events[Next].At))) {
+			Next = (s32)Index;
+		}
+	}
+	return Next;
+}
+
+void Host_AdvanceTo(u64 At)
+{
+	s32 Next;
+	HostEvent Event;
+
+	while ((Next = HostNextEvent(At)) >= 0) {
+		Event = Events[Next];
+		Events[Next] = Events[--EventCount];
+		if (Event.At > Now) {
+			Now = Event.At;
+		}
+		Event.Fn(Event.Ref);
+		HostTakeIrq();
+	}
+	if (At > Now) {
+		Now = At;
+	}
+}
+
+void Host_Advance(u64 Ns)
+{
+	Host_AdvanceTo(Now + Ns);
+}
+
+void Host_Schedule(u64 At, HostEventFn Fn, void *Ref)
+{
+	if (EventCount == HOST_MAX_EVENTS) {
+		HostDie("event queue full", 0U);
+	}
+	Events[EventCount].At = At;
+	Events[EventCount].Fn = Fn;
+	Events[EventCount].Ref = Ref;
+	EventCount++;
+}
+
+void Host_Cancel(HostEventFn Fn, void *Ref)
+{
+	u32 Index = 0U;
+
+	while (Index < EventCount) {
+		if ((Events[Index].Fn == Fn) && (Events[Index].Ref == Ref)) {
+			Events[Index] = Events[--EventCount];
+		} else {
+			Index++;
+		}
+	}
+}
+
+u32 Host_EventsPending(void)
+{
+	return EventCount;
+}
+
+void Host_SetWfiHook(HostHook Hook, void *Ref)
+{
+	WfiHook = Hook;
+	WfiHookRef = Ref;
+}
+
+void Host_SetWfiWake(HostWake Wake, void *Ref)
+{
+	WfiWake = Wake;
+	WfiWakeRef = Ref;
+}
+
+void Host_SetCacheHook(HostCacheHook Hook, void *Ref)
+{
+	CacheHook = Hook;
+	CacheHookRef = Ref;
+}
+
+void Host_SetCpHook(HostCpHook Hook, void *Ref)
+{
+	CpHook = Hook;
+	CpHookRef = Ref;
+}
+
+void Host_SetIrq(HostWake Line, HostHook Handler, void *Ref)
+{
+	IrqLine = Line;
+	IrqHandler = Handler;
+	IrqRef = Ref;
+}
+
+/*****************************************************************************/
+/*
+ * Register windows
+ */
+void HostIo_Map(UINTPTR Base, u32 Size, u32 AccessNs, HostIoRead Read,
+		HostIoWrite Write, void *Ref)
+{
+	HostIoWindow *Window;
+	u32 Index;
+
+	for (Index = 0U; Index < IoWindowCount; Index++) {
+		Window = &IoWindows[Index];
+		if ((Base < (Window->Base + Window->Size)) &&
+		    (Window->Base < (Base + Size))) {
+			HostDie("overlapping register window", Base);
+		}
+	}
+	if (IoWindowCount == HOST_IO_MAX_WINDOWS) {
+		HostDie("too many register windows", Base);
+	}
+	Window = &IoWindows[IoWindowCount++];
+	Window->Base = Base;
+	Window->Size = Size;
+	Window->AccessNs = AccessNs;
+	Window->Read = Read;
+	Window->Write = Write;
+	Window->Ref = Ref;
+}
+
+void HostIo_Unmap(UINTPTR Base)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < IoWindowCount; Index++) {
+		if (IoWindows[Index].Base == Base) {
+			IoWindows[Index] = IoWindows[--IoWindowCount];
+			return;
+		}
+	}
+}
+
+static HostIoWindow *HostIoFind(UINTPTR Addr, u32 Size)
+{
+	HostIoWindow *Window;
+	u32 Index;
+
+	for (Index = 0U; Index < IoWindowCount; Index++) {
+		Window = &IoWindows[Index];
+		if ((Addr >= Window->Base) &&
+		    ((Addr + Size) <= (Window->Base + Window->Size))) {
+			return Window;
+		}
+	}
+	HostDie("access outside every register window", Addr);
+	return NULL;
+}
+
+u64 Xil_IoModelRead(UINTPTR Addr, u32 Size)
+{
+	HostIoWindow *Window = HostIoFind(Addr, Size);
+	u32 Offset = (u32)(Addr - Window->Base);
+	u64 Value;
+
+	Host_Stats.IoReads++;
+	Host_Advance(Window->AccessNs);
+	if (Window->Read == NULL) {
+		HostDie("read of a write only window", Addr);
+	}
+	if (Size == 8U) {
+		Value = Window->Read(Window->Ref, Offset, 4U);
+		Value |= (u64)Window->Read(Window->Ref, Offset + 4U, 4U) << 32;
+		return Value;
+	}
+	return Window->Read(Window->Ref, Offset, Size);
+}
+
+void Xil_IoModelWrite(UINTPTR Addr, u64 Value, u32 Size)
+{
+	HostIoWindow *Window = HostIoFind(Addr, Size);
+	u32 Offset = (u32)(Addr - Window->Base);
+
+	Host_Stats.IoWrites++;
+	Host_Advance(Window->AccessNs);
+	if (Window->Write == NULL) {
+		HostDie("write of a read only window", Addr);
+	}
+	if (Size == 8U) {
+		Window->Write(Window->Ref, Offset, (u32)Value, 4U);
+		Window->Write(Window->Ref, Offset + 4U, (u32)(Value >> 32), 4U);
+		return;
+	}
+	Window->Write(Window->Ref, Offset, (u32)Value, Size);
+}
+
+/*****************************************************************************/
+/*
+ * Global timer, the counter runs from the modeled time
+ */
+static u64 HostGtCounter(void)
+{
+	return GtBase + (u64)(((unsigned __int128)(Now - GtBaseNs) *
+			       COUNTS_PER_SECOND * GtNum) /
+			      ((unsigned __int128)HOST_NS_PER_SEC * GtDen));
+}
+
+static void HostGtSet(u64 Counts)
+{
+	GtBase = Counts;
+	GtBaseNs = Now;
+}
+
+static u64 HostGtComparator(void)
+{
+	return ((u64)GtRegs[HOST_GT_COMPH_OFFSET / 4U] << 32) |
+	       GtRegs[HOST_GT_COMPL_OFFSET / 4U];
+}
+
+static void HostGtCompare(void *Ref);
+
+/* Schedules the comparator match for the current counter rate */
+static void HostGtArm(void)
+{
+	u64 Counts = HostGtCounter();
+	u64 Comp = HostGtComparator();
+
+	Host_Cancel(HostGtCompare, NULL);
+	if ((GtRegs[GTIMER_CONTROL_OFFSET / 4U] & HOST_GT_CTRL_COMP) == 0U) {
+		return;
+	}
+	if (Counts >= Comp) {
+		HostGtCompare(NULL);
+		return;
+	}
+	Host_Schedule(Now + Host_GtNs((((Comp - Counts) * GtDen) + GtNum - 1U) /
+				      GtNum), HostGtCompare, NULL);
+}
+
+static void HostGtCompare(void *Ref)
+{
+	u32 Ctrl = GtRegs[GTIMER_CONTROL_OFFSET / 4U];
+	u64 Comp;
+
+	(void)Ref;
+	if (HostGtCounter() < HostGtComparator()) {
+		/* Rounding of the rate, the match is one tick later */
+		Host_Schedule(Now + 1U, HostGtCompare, NULL);
+		return;
+	}
+	GtRegs[HOST_GT_ISR_OFFSET / 4U] = 1U;
+	if (((Ctrl & HOST_GT_CTRL_AUTOINC) != 0U) &&
+	    (GtRegs[HOST_GT_AUTOINC_OFFSET / 4U] != 0U)) {
+		Comp = HostGtComparator() + GtRegs[HOST_GT_AUTOINC_OFFSET / 4U];
+		GtRegs[HOST_GT_COMPL_OFFSET / 4U] = (u32)Comp;
+		GtRegs[HOST_GT_COMPH_OFFSET / 4U] = (u32)(Comp >> 32);
+		HostGtArm();
+	}
+}
+
+u32 Host_GtIrqPending(void)
+{
+	u32 Ctrl = GtRegs[GTIMER_CONTROL_OFFSET / 4U];
+
+	return ((GtRegs[HOST_GT_ISR_OFFSET / 4U] != 0U) &&
+		((Ctrl & HOST_GT_CTRL_COMP) != 0U) &&
+		((Ctrl & HOST_GT_CTRL_IRQ) != 0U)) ? 1U : 0U;
+}
+
+static u32 HostGtRead(void *Ref, u32 Offset, u32 Size)
+{
+	u64 Counts;
+
+	(void)Ref;
+	(void)Size;
+	/* One tick per read, a polling loop on the counter must progress */
+	Host_Advance(((Host_GtNs(1U) * GtDen) + GtNum - 1U) / GtNum);
+	Counts = HostGtCounter();
+	switch (Offset) {
+	case GTIMER_COUNTER_LOWER_OFFSET:
+		return (u32)Counts;
+	case GTIMER_COUNTER_UPPER_OFFSET:
+		return (u32)(Counts >> 32);
+	default:
+		return GtRegs[Offset / 4U];
+	}
+}
+
+static void HostGtWrite(void *Ref, u32 Offset, u32 Value, u32 Size)
+{
+	u64 Counts = HostGtCounter();
+
+	(void)Ref;
+	(void)Size;
+	switch (Offset) {
+	case GTIMER_COUNTER_LOWER_OFFSET:
+		HostGtSet((Counts & 0xFFFFFFFF00000000ULL) | Value);
+		break;
+	case GTIMER_COUNTER_UPPER_OFFSET:
+		HostGtSet((Counts & 0xFFFFFFFFULL) | ((u64)Value << 32));
+		break;
+	case HOST_GT_ISR_OFFSET:
+		GtRegs[Offset / 4U] &= ~Value;
+		return;
+	default:
+		GtRegs[Offset / 4U] = Value;
+		break;
+	}
+	HostGtArm();
+}
+
+/*
+ * The global timer runs from the CPU clock, a model of the clock control
+ * changes its rate to Num/Den of COUNTS_PER_SECOND
+ */
+void Host_GtSetRate(u32 Num, u32 Den)
+{
+	HostGtSet(HostGtCounter());
+	GtNum = Num;
+	GtDen = Den;
+	HostGtArm();
+}
+
+/*****************************************************************************/
+/*
+ * CPU state
+ */
+u32 HostCpsrRead(void)
+{
+	return Cpsr;
+}
+
+void HostCpsrWrite(u32 Value)
+{
+	Cpsr = Value;
+	HostTakeIrq();
+}
+
+u32 HostGprRead(u32 Reg)
+{
+	return Gpr[Reg & 15U];
+}
+
+void HostGprWrite(u32 Reg, u32 Value)
+{
+	Gpr[Reg & 15U] = Value;
+}
+
+void HostBarrier(u32 Kind)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	if (Kind == HOST_BARRIER_ISB) {
+		Host_Stats.Isb++;
+	} else if (Kind == HOST_BARRIER_DSB) {
+		Host_Stats.Dsb++;
+	} else {
+		Host_Stats.Dmb++;
+	}
+}
+
+/*
+ * Skips to the next event, or from event to event until the wake
+ * condition holds, then lets the hook deliver interrupts. Waiting with
+ * nothing to wake up for is a deadlock of the code under test.
+ */
+void HostWfi(void)
+{
+	u64 Start = Now;
+	s32 Next;
+
+	Host_Stats.Wfi++;
+	if (WfiWake != NULL) {
+		while (WfiWake(WfiWakeRef) == 0U) {
+			Next = HostNextEvent(~0ULL);
+			if (Next < 0) {
+				HostDie("WFI with no wake-up source", 0U);
+			}
+			Host_AdvanceTo(Events[Next].At);
+		}
+	} else {
+		Next = HostNextEvent(~0ULL);
+		if (Next >= 0) {
+			Host_AdvanceTo(Events[Next].At);
+		} else if (WfiHook == NULL) {
+			HostDie("WFI with no event scheduled", 0U);
+		}
+	}
+	Host_Stats.WfiNs += Now - Start;
+	if (WfiHook != NULL) {
+		WfiHook(WfiHookRef);
+	}
+}
+
+/*
+ * With a second CPU running, WFE blocks until another CPU executes SEV.
+ * A CPU still waiting after HOST_WFE_TIMEOUT_SEC missed its wake-up, on
+ * the hardware it would hang.
+ */
+void HostWfe(void)
+{
+	struct timespec Deadline;
+
+	Host_Stats.Wfe++;
+	pthread_mutex_lock(&SevLock);
+	if (SevSeen != SevCount) {
+		SevSeen = SevCount;
+		pthread_mutex_unlock(&SevLock);
+		return;
+	}
+	if (CpuCount == 1U) {
+		pthread_mutex_unlock(&SevLock);
+		HostWfi();
+		return;
+	}
+	clock_gettime(CLOCK_REALTIME, &Deadline);
+	Deadline.tv_sec += HOST_WFE_TIMEOUT_SEC;
+	while (SevSeen == SevCount) {
+		if (pthread_cond_timedwait(&SevCond, &SevLock, &Deadline) ==
+		    ETIMEDOUT) {
+			pthread_mutex_unlock(&SevLock);
+			HostDie("WFE without a wake-up", 0U);
+		}
+	}
+	SevSeen = SevCount;
+	pthread_mutex_unlock(&SevLock);
+}
+
+void HostSev(void)
+{
+	Host_Stats.Sev++;
+	pthread_mutex_lock(&SevLock);
+	SevCount++;
+	pthread_cond_broadcast(&SevCond);
+	pthread_mutex_unlock(&SevLock);
+}
+
+static HostCpReg *HostCpFind(const char *Reg)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < CpRegCount; Index++) {
+		if (strcmp(CpRegs[Index].Name, Reg) == 0) {
+			return &CpRegs[Index];
+		}
+	}
+	if (CpRegCount == HOST_CP_MAX_REGS) {
+		HostDie("too many CP15 registers", 0U);
+	}
+	CpRegs[CpRegCount].Name = Reg;
+	return &CpRegs[CpRegCount++];
+}
+
+u32 HostCpRead(const char *Reg)
+{
+	Host_Stats.CpReads++;
+	return HostCpFind(Reg)->Value;
+}
+
+void HostCpWrite(const char *Reg, u32 Value)
+{
+	HostCpReg *Cp = HostCpFind(Reg);
+
+	Host_Stats.CpWrites++;
+	Cp->Value = Value;
+	Cp->Writes++;
+	if (CpHook != NULL) {
+		CpHook(Reg, Value, CpHookRef);
+	}
+}
+
+void HostCp_Set(const char *Reg, u32 Value)
+{
+	HostCpFind(Reg)->Value = Value;
+}
+
+u32 HostCp_Writes(const char *Reg)
+{
+	return HostCpFind(Reg)->Writes;
+}
+
+/*****************************************************************************/
+/*
+ * Cache maintenance, the host is coherent so only the calls are recorded
+ */
+static void HostCacheOp(u32 Op, UINTPTR Addr, u32 Len)
+{
+	if (CacheHook != NULL) {
+		CacheHook(Op, Addr, Len, CacheHookRef);
+	}
+}
+
+void Xil_DCacheEnable(void)
+{
+}
+
+void Xil_DCacheDisable(void)
+{
+	Host_Stats.DCacheFlushAll++;
+	HostCacheOp(HOST_CACHE_DFLUSH_ALL, 0U, 0U);
+}
+
+void Xil_DCacheInvalidate(void)
+{
+	Host_Stats.DCacheInvalAll++;
+	HostCacheOp(HOST_CACHE_DINVAL_ALL, 0U, 0U);
+}
+
+void Xil_DCacheInvalidateRange(INTPTR adr, u32 len)
+{
+	Host_Stats.DCacheInvalRange++;
+	Host_Stats.DCacheInvalBytes += len;
+	HostCacheOp(HOST_CACHE_DINVAL_RANGE, (UINTPTR)adr, len);
+}
+
+void Xil_DCacheFlush(void)
+{
+	Host_Stats.DCacheFlushAll++;
+	HostCacheOp(HOST_CACHE_DFLUSH_ALL, 0U, 0U);
+}
+
+void Xil_DCacheFlushRange(INTPTR adr, u32 len)
+{
+	Host_Stats.DCacheFlushRange++;
+	Host_Stats.DCacheFlushBytes += len;
+	HostCacheOp(HOST_CACHE_DFLUSH_RANGE, (UINTPTR)adr, len);
+}
+
+void Xil_ICacheEnable(void)
+{
+}
+
+void Xil_ICacheDisable(void)
+{
+}
+
+void Xil_ICacheInvalidate(void)
+{
+	Host_Stats.ICacheInval++;
+	HostCacheOp(HOST_CACHE_IINVAL, 0U, 0U);
+}
+
+void Xil_ICacheInvalidateRange(INTPTR adr, u32 len)
+{
+	Host_Stats.ICacheInval++;
+	HostCacheOp(HOST_CACHE_IINVAL, (UINTPTR)adr, len);
+}
+
+/*****************************************************************************/
+/*
+ * Console
+ */
+void outbyte(char c)
+{
+	putchar(c);
+}
+
+char inbyte(void)
+{
+	return (char)getchar();
+}
+
+/*****************************************************************************/
+/*
+ * Memory below 4 GB
+ */
+void *Host_MapLow(UINTPTR Addr, size_t Size)
+{
+	void *Ptr = mmap((void *)Addr, Size, PROT_READ | PROT_WRITE,
+			 MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE |
+			 MAP_NORESERVE, -1, 0);
+
+	if (Ptr != (void *)Addr) {
+		HostDie("can not map", Addr);
+	}
+	return Ptr;
+}
+
+void *Host_AllocLow(size_t Size, size_t Align)
+{
+	UINTPTR Addr;
+	void *Ptr = mmap(NULL, Size + Align, PROT_READ | PROT_WRITE,
+			 MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+
+	if (Ptr == MAP_FAILED) {
+		HostDie("out of low memory", 0U);
+	}
+	Addr = (UINTPTR)Ptr;
+	if (Align > 1U) {
+		Addr = (Addr + Align - 1U) & ~(UINTPTR)(Align - 1U);
+	}
+	return (void *)Addr;
+}
+
+typedef struct {
+	int (*Fn)(void *Arg);
+	void *Arg;
+	int Result;
+} HostLowRun;
+
+static void *HostLowThread(void *Arg)
+{
+	HostLowRun *Run = Arg;
+
+	Run->Result = Run->Fn(Run->Arg);
+	return NULL;
+}
+
+int Host_RunLow(int (*Fn)(void *Arg), void *Arg)
+{
+	pthread_attr_t Attr;
+	pthread_t Thread;
+	HostLowRun Run = { Fn, Arg, -1 };
+	void *Stack = Host_AllocLow(HOST_LOW_STACK_SIZE, 4096U);
+
+	pthread_attr_init(&Attr);
+	pthread_attr_setstack(&Attr, Stack, HOST_LOW_STACK_SIZE);
+	if (pthread_create(&Thread, &Attr, HostLowThread, &Run) != 0) {
+		HostDie("can not start the test thread", 0U);
+	}
+	pthread_join(Thread, NULL);
+	pthread_attr_destroy(&Attr);
+	return Run.Result;
+}
+
+static void *HostCpuThread(void *Arg)
+{
+	HostLowRun *Run = Arg;
+
+	Run->Fn(Run->Arg);
+	free(Run);
+	return NULL;
+}
+
+u32 Host_StartCpu(int (*Fn)(void *Arg), void *Arg)
+{
+	pthread_attr_t Attr;
+	HostLowRun *Run = malloc(sizeof(*Run));
+	void *Stack = Host_AllocLow(HOST_LOW_STACK_SIZE, 4096U);
+	u32 Cpu;
+
+	pthread_mutex_lock(&SevLock);
+	if ((Run == NULL) || (CpuCount == HOST_MAX_CPUS)) {
+		HostDie("no CPU left to start", 0U);
+	}
+	Cpu = CpuCount++;
+	pthread_mutex_unlock(&SevLock);
+
+	Run->Fn = Fn;
+	Run->Arg = Arg;
+	pthread_attr_init(&Attr);
+	pthread_attr_setstack(&Attr, Stack, HOST_LOW_STACK_SIZE);
+	if (pthread_create(&CpuThreads[Cpu], &Attr, HostCpuThread, Run) != 0) {
+		HostDie("can not start a CPU", Cpu);
+	}
+	pthread_attr_destroy(&Attr);
+	return Cpu;
+}
+
+void Host_JoinCpu(u32 Cpu)
+{
+	pthread_join(CpuThreads[Cpu], NULL);
+	pthread_mutex_lock(&SevLock);
+	CpuCount--;
+	pthread_mutex_unlock(&SevLock);
+}
+
+/*****************************************************************************/
+void Host_Init(void)
+{
+	/*
+	 * Keep malloc on the heap next to the data, below 4 GB, also for the
+	 * Host_RunLow thread, which would otherwise get an mmap'ed arena
+	 */
+	mallopt(M_MMAP_MAX, 0);
+	mallopt(M_ARENA_MAX, 1);
+	setvbuf(stdout, NULL, _IOLBF, 0);
+
+	memset(&Host_Stats, 0, sizeof(Host_Stats));
+	Host_Failures = 0U;
+	Xil_AssertWait = 0;
+	Xil_AssertSetCallback(HostAssertCallback);
+
+	HostIo_Map(GLOBAL_TMR_BASEADDR, HOST_GT_WINDOW_SIZE, 0U, HostGtRead,
+		   HostGtWrite, NULL);
+}
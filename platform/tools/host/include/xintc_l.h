@@ -0,0 +1,15 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*
+ * Empty stand-in for the MicroBlaze interrupt controller header that
+ * profile_config.h pulls in through TIMER_CONNECT_INTC, the A9 profiler
+ * does not use it.
+ */
+
+#ifndef XINTC_L_H
+#define XINTC_L_H
+
+#endif
@@ -0,0 +1,88 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xpseudo_asm_gcc.h
+*
+* Host replacement of the Cortex-A9 pseudo assembler macros. It is found
+* before the BSP copy on the include path of the host builds in
+* platform/tools/host, every instruction is forwarded to the host runtime
+* (host_rt.c), which keeps the CPSR and CP15 state and counts the barriers.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef XPSEUDO_ASM_GCC_H  /* prevent circular inclusions */
+#define XPSEUDO_ASM_GCC_H  /* by using protection macros */
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#define stringify(s)	tostring(s)
+#define tostring(s)	#s
+
+u32 HostCpsrRead(void);
+void HostCpsrWrite(u32 Value);
+u32 HostGprRead(u32 Reg);
+void HostGprWrite(u32 Reg, u32 Value);
+void HostBarrier(u32 Kind);
+void HostWfi(void);
+void HostWfe(void);
+void HostSev(void);
+u32 HostCpRead(const char *Reg);
+void HostCpWrite(const char *Reg, u32 Value);
+
+#define HOST_BARRIER_ISB	0U
+#define HOST_BARRIER_DSB	1U
+#define HOST_BARRIER_DMB	2U
+
+#define mfcpsr()	HostCpsrRead()
+#define mtcpsr(v)	HostCpsrWrite((u32)(v))
+
+#define cpsiei()	HostCpsrWrite(HostCpsrRead() & ~0x80U)
+#define cpsidi()	HostCpsrWrite(HostCpsrRead() | 0x80U)
+
+#define cpsief()	HostCpsrWrite(HostCpsrRead() & ~0x40U)
+#define cpsidf()	HostCpsrWrite(HostCpsrRead() | 0x40U)
+
+#define mtgpr(rn, v)	HostGprWrite((u32)(rn), (u32)(v))
+#define mfgpr(rn)	HostGprRead((u32)(rn))
+
+#define isb()	HostBarrier(HOST_BARRIER_ISB)
+#define dsb()	HostBarrier(HOST_BARRIER_DSB)
+#define dmb()	HostBarrier(HOST_BARRIER_DMB)
+
+#define wfi()	HostWfi()
+#define wfe()	HostWfe()
+#define sev()	HostSev()
+
+#define ldr(adr)	(*(volatile u32 *)(UINTPTR)(adr))
+#define ldrb(adr)	(*(volatile u8 *)(UINTPTR)(adr))
+#define strw(adr, val)	(*(volatile u32 *)(UINTPTR)(adr) = (u32)(val))
+#define strb(adr, val)	(*(volatile u8 *)(UINTPTR)(adr) = (u8)(val))
+
+#define clz(arg)	((u8)(((u32)(arg) == 0U) ? 32 : __builtin_clz((u32)(arg))))
+
+#define mtcp(rn, v)	HostCpWrite((rn), (u32)(v))
+#define mfcp(rn)	HostCpRead(rn)
+#define mtcp2(rn, v)	HostCpWrite((rn), (u32)(v))
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* XPSEUDO_ASM_GCC_H */
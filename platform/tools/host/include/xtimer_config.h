@@ -0,0 +1,26 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*
+ * xiltimer configuration of the host builds. The generated one of the BSP
+ * has no tick timer, the host builds select the SCU timer as a BSP
+ * generated with one would, so that the tickless path of xtimer_wheel.c
+ * runs against models/scutimer_model.c. The sleep timer is the global
+ * timer as in the BSP.
+ */
+
+#ifndef _XTIMER_CONFIG_H
+#define _XTIMER_CONFIG_H
+
+#include "xparameters.h"
+
+#define XSLEEPTIMER_FREQ	XPAR_CPU_CORE_CLOCK_FREQ_HZ/2
+#define COUNTS_PER_SECOND	XSLEEPTIMER_FREQ
+#define XTIMER_IS_DEFAULT_TIMER	1
+
+#define XTICKTIMER_BASEADDRESS	XPAR_XSCUTIMER_0_BASEADDR
+#define XTICKTIMER_IS_SCUTIMER	1
+
+#endif /* _XTIMER_CONFIG_H */
@@ -0,0 +1,392 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file dmaps_model.c
+*
+* PL330 DMA controller model, see dmaps_model.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <string.h>
+
+#include "host.h"
+#include "xdmaps_hw.h"
+#include "dmaps_model.h"
+
+#define MAX_STEPS	(1U << 26)	/* Instructions of one program */
+#define FTC_UNDEF	0x1U		/* Undefined instruction */
+#define CS_EXECUTING	0x1U
+#define CS_FAULTING	0xFU
+
+#define OP_END		0x00U
+#define OP_KILL		0x01U
+#define OP_LD		0x04U
+#define OP_ST		0x08U
+#define OP_RMB		0x12U
+#define OP_WMB		0x13U
+#define OP_NOP		0x18U
+#define OP_SEV		0x34U
+#define OP_MOV		0xBCU
+
+typedef struct {
+	u32 Pc;
+	u32 Sar;
+	u32 Dar;
+	u32 Ccr;
+	u32 Lc[2];
+	u8 Fifo[DMAPS_MODEL_FIFO_LEN];
+	u32 Head;
+	u32 Level;
+	u64 Stored;
+} Thread;
+
+static void ChannelDone(void *Ref);
+
+static u8 ProgByte(u32 Addr)
+{
+	return *(volatile u8 *)(UINTPTR)Addr;
+}
+
+static u32 ProgWord(u32 Addr)
+{
+	return (u32)ProgByte(Addr) | ((u32)ProgByte(Addr + 1U) << 8) |
+	       ((u32)ProgByte(Addr + 2U) << 16) |
+	       ((u32)ProgByte(Addr + 3U) << 24);
+}
+
+/* Beats, beat size and increment of the source (Shift 0) or destination */
+static void Burst(u32 Ccr, u32 Shift, u32 *Len, u32 *Size, u32 *Inc)
+{
+	*Len = ((Ccr >> (Shift + 4U)) & 0xFU) + 1U;
+	*Size = 1U << ((Ccr >> (Shift + 1U)) & 0x7U);
+	*Inc = (Ccr >> Shift) & 1U;
+}
+
+static u32 Load(Thread *Th, u64 *Beats)
+{
+	u32 Len;
+	u32 Size;
+	u32 Inc;
+	u32 Beat;
+	u32 Byte;
+
+	Burst(Th->Ccr, 0U, &Len, &Size, &Inc);
+	if ((Th->Level + (Len * Size)) > DMAPS_MODEL_FIFO_LEN) {
+		return FTC_UNDEF;
+	}
+	for (Beat = 0U; Beat < Len; Beat++) {
+		for (Byte = 0U; Byte < Size; Byte++) {
+			Th->Fifo[(Th->Head + Th->Level) % DMAPS_MODEL_FIFO_LEN] =
+				*(volatile u8 *)(UINTPTR)(Th->Sar + Byte);
+			Th->Level++;
+		}
+		if (Inc != 0U) {
+			Th->Sar += Size;
+		}
+	}
+	*Beats += Len;
+	return 0U;
+}
+
+static u32 Store(Thread *Th, u32 Write)
+{
+	u32 Len;
+	u32 Size;
+	u32 Inc;
+	u32 Beat;
+	u32 Byte;
+
+	Burst(Th->Ccr, 14U, &Len, &Size, &Inc);
+	if (Th->Level < (Len * Size)) {
+		return FTC_UNDEF;
+	}
+	for (Beat = 0U; Beat < Len; Beat++) {
+		for (Byte = 0U; Byte < Size; Byte++) {
+			if (Write != 0U) {
+				*(volatile u8 *)(UINTPTR)(Th->Dar + Byte) =
+					Th->Fifo[Th->Head];
+			}
+			Th->Head = (Th->Head + 1U) % DMAPS_MODEL_FIFO_LEN;
+			Th->Level--;
+		}
+		Th->Stored += Size;
+		if (Inc != 0U) {
+			Th->Dar += Size;
+		}
+	}
+	return 0U;
+}
+
+/*
+ * Runs the program of channel Id to its DMAEND. Only with Write set the
+ * destination is written and DMASEV takes effect. Returns 0 or the FTC
+ * value of the fault, Th holds the state at the end.
+ */
+static u32 Execute(DmaPsModel *Model, u32 Id, Thread *Th, u32 Write,
+		   u64 *Beats)
+{
+	DmaPsModelChannel *Chan = &Model->Chan[Id];
+	u32 Steps;
+	u32 Fault = 0U;
+	u32 Op;
+	u32 Lc;
+
+	memset(Th, 0, sizeof(*Th));
+	Th->Pc = Chan->Pc;
+	Th->Sar = Chan->Sar;
+	Th->Dar = Chan->Dar;
+	Th->Ccr = Chan->Ccr;
+	*Beats = 0U;
+
+	for (Steps = 0U; (Steps < MAX_STEPS) && (Fault == 0U); Steps++) {
+		Op = ProgByte(Th->Pc);
+		if (Op == OP_END) {
+			return 0U;
+		} else if (Op == OP_LD) {
+			Fault = Load(Th, Beats);
+			Th->Pc += 1U;
+		} else if (Op == OP_ST) {
+			Fault = Store(Th, Write);
+			Th->Pc += 1U;
+		} else if ((Op == OP_RMB) || (Op == OP_WMB) || (Op == OP_NOP)) {
+			Th->Pc += 1U;
+		} else if ((Op & 0xFDU) == 0x20U) {		/* DMALP */
+			Th->Lc[(Op >> 1) & 1U] = ProgByte(Th->Pc + 1U);
+			Th->Pc += 2U;
+		} else if ((Op & 0xE8U) == 0x28U) {		/* DMALPEND */
+			Lc = (Op >> 2) & 1U;
+			if (((Op & 0x10U) == 0U) || ((Op & 0x3U) != 0U)) {
+				Fault = FTC_UNDEF;
+			} else if (Th->Lc[Lc] != 0U) {
+				Th->Lc[Lc]--;
+				Th->Pc -= ProgByte(Th->Pc + 1U);
+			} else {
+				Th->Pc += 2U;
+			}
+		} else if ((Op & 0xFDU) == 0x54U) {		/* DMAADDH */
+			if ((Op & 0x2U) != 0U) {
+				Th->Dar += ProgByte(Th->Pc + 1U) |
+					   ((u32)ProgByte(Th->Pc + 2U) << 8);
+			} else {
+				Th->Sar += ProgByte(Th->Pc + 1U) |
+					   ((u32)ProgByte(Th->Pc + 2U) << 8);
+			}
+			Th->Pc += 3U;
+		} else if (Op == OP_MOV) {
+			switch (ProgByte(Th->Pc + 1U) & 0x7U) {
+			case 0U:
+				Th->Sar = ProgWord(Th->Pc + 2U);
+				break;
+			case 1U:
+				Th->Ccr = ProgWord(Th->Pc + 2U);
+				break;
+			case 2U:
+				Th->Dar = ProgWord(Th->Pc + 2U);
+				break;
+			default:
+				Fault = FTC_UNDEF;
+				break;
+			}
+			Th->Pc += 6U;
+		} else if (Op == OP_SEV) {
+			if (Write != 0U) {
+				Model->Ris |= 1U << (ProgByte(Th->Pc + 1U) >> 3);
+			}
+			Th->Pc += 2U;
+		} else {
+			Fault = FTC_UNDEF;
+		}
+	}
+	return (Fault != 0U) ? Fault : FTC_UNDEF;
+}
+
+static void Stop(DmaPsModelChannel *Chan, const Thread *Th, u32 Fault)
+{
+	Chan->Running = 0U;
+	Chan->Pc = Th->Pc;
+	Chan->Sar = Th->Sar;
+	Chan->Dar = Th->Dar;
+	Chan->Ccr = Th->Ccr;
+	Chan->Lc[0] = Th->Lc[0];
+	Chan->Lc[1] = Th->Lc[1];
+	Chan->Fault = Fault;
+}
+
+static void Go(DmaPsModel *Model, u32 Id, u32 Pc)
+{
+	DmaPsModelChannel *Chan = &Model->Chan[Id];
+	static Thread Th;
+	u64 Beats;
+	u32 Fault;
+
+	if (Chan->Running != 0U) {
+		Model->Faults++;
+		return;
+	}
+	Chan->Pc = Pc;
+	Chan->Fault = 0U;
+	Model->Programs++;
+	Fault = Execute(Model, Id, &Th, 0U, &Beats);
+	if (Fault != 0U) {
+		Model->Faults++;
+		Stop(Chan, &Th, Fault);
+		return;
+	}
+	Chan->Running = 1U;
+	Chan->DoneAt = Host_Now() + ((Beats * Model->BeatPs) / 1000U);
+	Host_Schedule(Chan->DoneAt, ChannelDone, Chan);
+}
+
+static void ChannelDone(void *Ref)
+{
+	DmaPsModelChannel *Chan = Ref;
+	DmaPsModel *Model = Chan->Model;
+	static Thread Th;
+	u64 Beats;
+	u32 Fault;
+
+	Fault = Execute(Model, Chan->Id, &Th, 1U, &Beats);
+	Stop(Chan, &Th, Fault);
+	if (Fault != 0U) {
+		Model->Faults++;
+		return;
+	}
+	Model->Beats += Beats;
+	Model->Bytes += Th.Stored;
+}
+
+static void DebugCommand(DmaPsModel *Model)
+{
+	u32 Op = (Model->DbgInst0 >> 16) & 0xFFU;
+	u32 Id;
+
+	if (((Model->DbgInst0 & 1U) == 0U) && ((Op & 0xFDU) == 0xA0U)) {
+		Go(Model, (Model->DbgInst0 >> 24) & 0x7U, Model->DbgInst1);
+	} else if (((Model->DbgInst0 & 1U) != 0U) && (Op == OP_KILL)) {
+		Id = (Model->DbgInst0 >> 8) & 0x7U;
+		Host_Cancel(ChannelDone, &Model->Chan[Id]);
+		Model->Chan[Id].Running = 0U;
+	}
+}
+
+static u32 Read(void *Ref, u32 Offset, u32 Size)
+{
+	DmaPsModel *Model = Ref;
+	DmaPsModelChannel *Chan;
+	u32 Value = 0U;
+	u32 Id;
+
+	(void)Size;
+	if ((Offset >= XDMAPS_CS0_OFFSET) &&
+	    (Offset < (XDMAPS_CS0_OFFSET + (8U * DMAPS_MODEL_CHANNELS)))) {
+		Chan = &Model->Chan[(Offset - XDMAPS_CS0_OFFSET) / 8U];
+		if ((Offset & 0x4U) != 0U) {
+			return Chan->Pc;
+		}
+		return (Chan->Running != 0U) ? CS_EXECUTING :
+		       ((Chan->Fault != 0U) ? CS_FAULTING : 0U);
+	}
+	if ((Offset >= XDMAPS_SA_0_OFFSET) &&
+	    (Offset < (XDMAPS_SA_0_OFFSET + (0x20U * DMAPS_MODEL_CHANNELS)))) {
+		Chan = &Model->Chan[(Offset - XDMAPS_SA_0_OFFSET) / 0x20U];
+		switch ((Offset - XDMAPS_SA_0_OFFSET) % 0x20U) {
+		case 0x0U:
+			return Chan->Sar;
+		case 0x4U:
+			return Chan->Dar;
+		case 0x8U:
+			return Chan->Ccr;
+		case 0xCU:
+			return Chan->Lc[0];
+		case 0x10U:
+			return Chan->Lc[1];
+		default:
+			return 0U;
+		}
+	}
+	if ((Offset >= XDMAPS_FTC0_OFFSET) &&
+	    (Offset < (XDMAPS_FTC0_OFFSET + (4U * DMAPS_MODEL_CHANNELS)))) {
+		return Model->Chan[(Offset - XDMAPS_FTC0_OFFSET) / 4U].Fault;
+	}
+
+	switch (Offset) {
+	case XDMAPS_INTEN_OFFSET:
+		return Model->Inten;
+	case XDMAPS_ES_OFFSET:
+		return Model->Ris;
+	case XDMAPS_INTSTATUS_OFFSET:
+		return Model->Ris & Model->Inten;
+	case XDMAPS_FSC_OFFSET:
+		for (Id = 0U; Id < DMAPS_MODEL_CHANNELS; Id++) {
+			if (Model->Chan[Id].Fault != 0U) {
+				Value |= 1U << Id;
+			}
+		}
+		return Value;
+	case XDMAPS_DBGINST0_OFFSET:
+		return Model->DbgInst0;
+	case XDMAPS_DBGINST1_OFFSET:
+		return Model->DbgInst1;
+	case XDMAPS_CR1_OFFSET:
+		return Model->Cr1;
+	default:
+		return 0U;
+	}
+}
+
+static void Write(void *Ref, u32 Offset, u32 Value, u32 Size)
+{
+	DmaPsModel *Model = Ref;
+
+	(void)Size;
+	switch (Offset) {
+	case XDMAPS_INTEN_OFFSET:
+		Model->Inten = Value;
+		break;
+	case XDMAPS_INTCLR_OFFSET:
+		Model->Ris &= ~(Value & Model->Inten);
+		break;
+	case XDMAPS_DBGINST0_OFFSET:
+		Model->DbgInst0 = Value;
+		break;
+	case XDMAPS_DBGINST1_OFFSET:
+		Model->DbgInst1 = Value;
+		break;
+	case XDMAPS_DBGCMD_OFFSET:
+		if ((Value & 0x3U) == 0U) {
+			DebugCommand(Model);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+/*****************************************************************************/
+void DmaPsModel_Init(DmaPsModel *Model, UINTPTR Base, u32 AccessNs,
+		     u32 BeatPs)
+{
+	u32 Id;
+
+	memset(Model, 0, sizeof(*Model));
+	Model->Base = Base;
+	Model->BeatPs = BeatPs;
+	for (Id = 0U; Id < DMAPS_MODEL_CHANNELS; Id++) {
+		Model->Chan[Id].Model = Model;
+		Model->Chan[Id].Id = Id;
+	}
+	HostIo_Map(Base, DMAPS_MODEL_WINDOW_SIZE, AccessNs, Read, Write, Model);
+}
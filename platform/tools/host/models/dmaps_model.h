@@ -0,0 +1,96 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file dmaps_model.h
+*
+* Model of the PL330 DMA controller for the host builds, covering what the
+* dmaps driver and its copy engine use.
+*
+* - The debug registers run DMAGO on a stopped channel and DMAKILL of a
+*   channel. DBGSTATUS and the manager status read idle.
+* - A channel executes its program from memory: DMAMOV of SAR, DAR and
+*   CCR, DMALP and DMALPEND on both loop counters, unconditional DMALD and
+*   DMAST through a byte FIFO, DMAADDH, DMASEV, DMAEND and the barriers
+*   and DMANOP, which do nothing. Burst size, burst length and address
+*   increment come from CCR. Any other instruction, a forever loop, a
+*   load the FIFO has no room for or a store with too few bytes in it
+*   stops the channel with its bit set in FSC and the undefined
+*   instruction bit in its FTC.
+* - The program is run when DMAGO is issued to count its beats, and again
+*   at its end, when the memory is written. The channel executes for the
+*   beats of its loads times the beat time, the stores overlap them on
+*   the write channel. Program fetch and start up are not counted.
+* - DMASEV sets its bit in INT_EVENT_RIS, INTMIS is RIS masked by INTEN
+*   and INTCLR clears RIS bits. CR1 reads Cr1, 0 after init, which tells
+*   the driver that the instruction cache length is unknown.
+*
+* The register access time and the beat time are parameters of
+* DmaPsModel_Init, the hardware documents give neither.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef DMAPS_MODEL_H
+#define DMAPS_MODEL_H
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DMAPS_MODEL_WINDOW_SIZE		0x1000U
+#define DMAPS_MODEL_CHANNELS		8U
+#define DMAPS_MODEL_FIFO_LEN		1024U	/* Model limit, not the MFIFO depth */
+
+typedef struct {
+	void *Model;
+	u32 Id;
+	u32 Running;
+	u32 Pc;
+	u32 Sar;
+	u32 Dar;
+	u32 Ccr;
+	u32 Lc[2];
+	u32 Fault;		/* FTC value */
+	u64 DoneAt;		/* End of the running program */
+} DmaPsModelChannel;
+
+typedef struct {
+	UINTPTR Base;
+	u32 BeatPs;		/* Time per load beat, in ps */
+	u32 Cr1;
+
+	u32 Inten;
+	u32 Ris;
+	u32 DbgInst0;
+	u32 DbgInst1;
+	DmaPsModelChannel Chan[DMAPS_MODEL_CHANNELS];
+
+	/* Statistics */
+	u64 Programs;		/* Channel programs started */
+	u64 Beats;		/* Load beats of the finished programs */
+	u64 Bytes;		/* Bytes stored by them */
+	u64 Faults;
+} DmaPsModel;
+
+void DmaPsModel_Init(DmaPsModel *Model, UINTPTR Base, u32 AccessNs,
+		     u32 BeatPs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DMAPS_MODEL_H */
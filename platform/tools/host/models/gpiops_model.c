@@ -0,0 +1,232 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file gpiops_model.c
+*
+* Zynq PS GPIO controller model, see gpiops_model.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <string.h>
+
+#include "host.h"
+#include "xgpiops_hw.h"
+#include "gpiops_model.h"
+
+static const u32 BankBase[GPIOPS_MODEL_BANKS + 1U] = { 0U, 32U, 54U, 86U,
+						       GPIOPS_MODEL_PINS };
+
+static u32 BankOf(u32 Pin)
+{
+	u32 Bank = 0U;
+
+	while (Pin >= BankBase[Bank + 1U]) {
+		Bank++;
+	}
+	return Bank;
+}
+
+static u32 BankMask(u32 Bank)
+{
+	u32 Pins = BankBase[Bank + 1U] - BankBase[Bank];
+
+	return (Pins == 32U) ? 0xFFFFFFFFU : ((1U << Pins) - 1U);
+}
+
+/* Status bits of the level interrupts whose level holds */
+static u32 LevelActive(const GpioPsModel *Model, u32 Bank)
+{
+	u32 High = Model->In[Bank] & Model->IntPol[Bank];
+	u32 Low = ~Model->In[Bank] & ~Model->IntPol[Bank];
+
+	return (High | Low) & ~Model->IntType[Bank] & BankMask(Bank);
+}
+
+static u32 Read(void *Ref, u32 Offset, u32 Size)
+{
+	GpioPsModel *Model = Ref;
+	u32 Bank;
+
+	(void)Size;
+	if ((Offset >= XGPIOPS_DATA_OFFSET) &&
+	    (Offset < (XGPIOPS_DATA_OFFSET + (4U * GPIOPS_MODEL_BANKS)))) {
+		return Model->Out[(Offset - XGPIOPS_DATA_OFFSET) / 4U];
+	}
+	if ((Offset >= XGPIOPS_DATA_RO_OFFSET) &&
+	    (Offset < (XGPIOPS_DATA_RO_OFFSET + (4U * GPIOPS_MODEL_BANKS)))) {
+		Bank = (Offset - XGPIOPS_DATA_RO_OFFSET) / 4U;
+		return ((Model->Out[Bank] & Model->Dirm[Bank]) |
+			(Model->In[Bank] & ~Model->Dirm[Bank])) & BankMask(Bank);
+	}
+	if ((Offset < XGPIOPS_DIRM_OFFSET) ||
+	    (Offset >= (XGPIOPS_DIRM_OFFSET +
+			(GPIOPS_MODEL_BANKS * XGPIOPS_REG_MASK_OFFSET)))) {
+		return 0U;
+	}
+	Bank = (Offset - XGPIOPS_DIRM_OFFSET) / XGPIOPS_REG_MASK_OFFSET;
+	switch (Offset - (Bank * XGPIOPS_REG_MASK_OFFSET)) {
+	case XGPIOPS_DIRM_OFFSET:
+		return Model->Dirm[Bank];
+	case XGPIOPS_OUTEN_OFFSET:
+		return Model->Oen[Bank];
+	case XGPIOPS_INTMASK_OFFSET:
+		return Model->IntMask[Bank];
+	case XGPIOPS_INTSTS_OFFSET:
+		return Model->IntStat[Bank];
+	case XGPIOPS_INTTYPE_OFFSET:
+		return Model->IntType[Bank];
+	case XGPIOPS_INTPOL_OFFSET:
+		return Model->IntPol[Bank];
+	case XGPIOPS_INTANY_OFFSET:
+		return Model->IntAny[Bank];
+	default:
+		return 0U;
+	}
+}
+
+static void Write(void *Ref, u32 Offset, u32 Value, u32 Size)
+{
+	GpioPsModel *Model = Ref;
+	u32 Bank;
+	u32 Shift;
+	u32 Keep;
+
+	(void)Size;
+	if (Offset < (XGPIOPS_DATA_MASK_OFFSET * GPIOPS_MODEL_BANKS)) {
+		/* Masked write of 16 pins, a mask bit of 1 keeps the pin */
+		Bank = Offset / XGPIOPS_DATA_MASK_OFFSET;
+		Shift = ((Offset % XGPIOPS_DATA_MASK_OFFSET) != 0U) ? 16U : 0U;
+		Keep = ((Value >> 16) << Shift) | ~(0xFFFFU << Shift);
+		Model->Out[Bank] = ((Model->Out[Bank] & Keep) |
+				    (((Value & 0xFFFFU) << Shift) & ~Keep)) &
+				   BankMask(Bank);
+		return;
+	}
+	if ((Offset >= XGPIOPS_DATA_OFFSET) &&
+	    (Offset < (XGPIOPS_DATA_OFFSET + (4U * GPIOPS_MODEL_BANKS)))) {
+		Bank = (Offset - XGPIOPS_DATA_OFFSET) / 4U;
+		Model->Out[Bank] = Value & BankMask(Bank);
+		return;
+	}
+	if ((Offset < XGPIOPS_DIRM_OFFSET) ||
+	    (Offset >= (XGPIOPS_DIRM_OFFSET +
+			(GPIOPS_MODEL_BANKS * XGPIOPS_REG_MASK_OFFSET)))) {
+		return;
+	}
+	Bank = (Offset - XGPIOPS_DIRM_OFFSET) / XGPIOPS_REG_MASK_OFFSET;
+	Value &= BankMask(Bank);
+	switch (Offset - (Bank * XGPIOPS_REG_MASK_OFFSET)) {
+	case XGPIOPS_DIRM_OFFSET:
+		Model->Dirm[Bank] = Value;
+		break;
+	case XGPIOPS_OUTEN_OFFSET:
+		Model->Oen[Bank] = Value;
+		break;
+	case XGPIOPS_INTEN_OFFSET:
+		Model->IntMask[Bank] &= ~Value;
+		break;
+	case XGPIOPS_INTDIS_OFFSET:
+		Model->IntMask[Bank] |= Value;
+		break;
+	case XGPIOPS_INTSTS_OFFSET:
+		Model->IntStat[Bank] &= ~Value;
+		Model->IntStat[Bank] |= LevelActive(Model, Bank);
+		break;
+	case XGPIOPS_INTTYPE_OFFSET:
+		Model->IntType[Bank] = Value;
+		Model->IntStat[Bank] |= LevelActive(Model, Bank);
+		break;
+	case XGPIOPS_INTPOL_OFFSET:
+		Model->IntPol[Bank] = Value;
+		Model->IntStat[Bank] |= LevelActive(Model, Bank);
+		break;
+	case XGPIOPS_INTANY_OFFSET:
+		Model->IntAny[Bank] = Value;
+		break;
+	default:
+		break;
+	}
+}
+
+/*****************************************************************************/
+void GpioPsModel_Init(GpioPsModel *Model, UINTPTR Base, u32 AccessNs)
+{
+	u32 Bank;
+
+	memset(Model, 0, sizeof(*Model));
+	for (Bank = 0U; Bank < GPIOPS_MODEL_BANKS; Bank++) {
+		Model->IntMask[Bank] = BankMask(Bank);
+	}
+	HostIo_Map(Base, GPIOPS_MODEL_WINDOW_SIZE, AccessNs, Read, Write, Model);
+}
+
+void GpioPsModel_SetPin(GpioPsModel *Model, u32 Pin, u32 Level)
+{
+	u32 Bank = BankOf(Pin);
+	u32 Bit = 1U << (Pin - BankBase[Bank]);
+	u32 Was = Model->In[Bank] & Bit;
+	u32 Edge;
+
+	Model->In[Bank] = (Level != 0U) ? (Model->In[Bank] | Bit) :
+			  (Model->In[Bank] & ~Bit);
+	if ((Model->IntType[Bank] & Bit) == 0U) {
+		Model->IntStat[Bank] |= LevelActive(Model, Bank);
+		return;
+	}
+	if ((Model->In[Bank] & Bit) == Was) {
+		return;
+	}
+	if ((Model->IntAny[Bank] & Bit) != 0U) {
+		Edge = 1U;
+	} else {
+		/* Polarity 1 is the rising edge */
+		Edge = (((Model->IntPol[Bank] & Bit) != 0U) == (Was == 0U)) ?
+		       1U : 0U;
+	}
+	if (Edge == 0U) {
+		return;
+	}
+	if ((Model->IntStat[Bank] & Bit) != 0U) {
+		Model->Merged++;
+	} else {
+		Model->IntStat[Bank] |= Bit;
+		Model->Edges++;
+	}
+}
+
+u32 GpioPsModel_GetPin(const GpioPsModel *Model, u32 Pin)
+{
+	u32 Bank = BankOf(Pin);
+
+	return (Model->In[Bank] >> (Pin - BankBase[Bank])) & 1U;
+}
+
+u32 GpioPsModel_Pending(const GpioPsModel *Model, u32 Bank)
+{
+	return Model->IntStat[Bank] & ~Model->IntMask[Bank];
+}
+
+u32 GpioPsModel_IrqPending(const GpioPsModel *Model)
+{
+	u32 Bank;
+
+	for (Bank = 0U; Bank < GPIOPS_MODEL_BANKS; Bank++) {
+		if (GpioPsModel_Pending(Model, Bank) != 0U) {
+			return 1U;
+		}
+	}
+	return 0U;
+}
@@ -0,0 +1,80 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file gpiops_model.h
+*
+* Model of the Zynq PS GPIO controller for the host builds: four banks of
+* 32, 22, 32 and 32 pins, MIO in banks 0 and 1 and EMIO in banks 2 and 3.
+*
+* - The input level of a pin is set by the test with GpioPsModel_SetPin.
+*   DATA_RO reads the output of the pins set as outputs in DIRM and the
+*   input level of the others. DATA and the masked data writes of
+*   MASK_DATA_LSW/MSW set the outputs.
+* - INT_TYPE, INT_POLARITY and INT_ANY select level or edge, the level or
+*   edge and both edges. An edge sets its bit in INT_STAT, which a write of
+*   1 clears. A level interrupt keeps its bit set while the level holds.
+*   INT_STAT is the raw status, INT_MASK masks only the interrupt line.
+* - INT_EN and INT_DIS clear and set INT_MASK, which starts with every pin
+*   masked.
+* - GpioPsModel_IrqPending is the interrupt line, for a GIC model or a test
+*   that takes the interrupts itself.
+* - An edge on a pin whose status bit is still set is lost, it is counted
+*   in Merged.
+*
+* The register access time is a parameter of GpioPsModel_Init.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef GPIOPS_MODEL_H
+#define GPIOPS_MODEL_H
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GPIOPS_MODEL_WINDOW_SIZE	0x1000U
+#define GPIOPS_MODEL_BANKS		4U
+#define GPIOPS_MODEL_PINS		118U
+
+typedef struct {
+	u32 In[GPIOPS_MODEL_BANKS];	/* Input levels */
+	u32 Out[GPIOPS_MODEL_BANKS];
+	u32 Dirm[GPIOPS_MODEL_BANKS];
+	u32 Oen[GPIOPS_MODEL_BANKS];
+	u32 IntMask[GPIOPS_MODEL_BANKS];
+	u32 IntStat[GPIOPS_MODEL_BANKS];
+	u32 IntType[GPIOPS_MODEL_BANKS];
+	u32 IntPol[GPIOPS_MODEL_BANKS];
+	u32 IntAny[GPIOPS_MODEL_BANKS];
+
+	/* Statistics */
+	u64 Edges;		/* Edges that set a status bit */
+	u64 Merged;		/* Edges lost to a status bit still set */
+} GpioPsModel;
+
+void GpioPsModel_Init(GpioPsModel *Model, UINTPTR Base, u32 AccessNs);
+void GpioPsModel_SetPin(GpioPsModel *Model, u32 Pin, u32 Level);
+u32 GpioPsModel_GetPin(const GpioPsModel *Model, u32 Pin);
+u32 GpioPsModel_Pending(const GpioPsModel *Model, u32 Bank);
+u32 GpioPsModel_IrqPending(const GpioPsModel *Model);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GPIOPS_MODEL_H */
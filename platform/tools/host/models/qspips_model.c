@@ -0,0 +1,473 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file qspips_model.c
+*
+* Zynq PS QSPI controller and serial NOR flash model, see qspips_model.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "host.h"
+#include "xqspips_hw.h"
+#include "xqspips.h"
+#include "qspips_model.h"
+
+#define SR_WIP		0x01U
+#define SR_WEL		0x02U
+
+#define IXR_ALL		(XQSPIPS_IXR_TXUF_MASK | XQSPIPS_IXR_RXFULL_MASK | \
+			 XQSPIPS_IXR_RXNEMPTY_MASK | XQSPIPS_IXR_TXFULL_MASK | \
+			 XQSPIPS_IXR_TXOW_MASK | XQSPIPS_IXR_RXOVR_MASK)
+
+/*****************************************************************************/
+/*
+ * Flash
+ */
+static u32 FlashRandom(QspiPsFlashModel *Flash)
+{
+	Flash->Seed = (Flash->Seed * 1103515245U) + 12345U;
+	return Flash->Seed >> 8;
+}
+
+/* Finishes the program or erase whose time is up */
+static void FlashSettle(QspiPsFlashModel *Flash)
+{
+	u32 Index;
+
+	if ((Flash->Busy == 0U) || (Host_Now() < Flash->BusyEnd)) {
+		return;
+	}
+	if (Flash->Busy == XQSPIPS_FLASH_OPCODE_PP) {
+		for (Index = 0U; Index < QSPIPS_MODEL_PAGE_SIZE; Index++) {
+			Flash->Mem[Flash->BusyAddr + Index] &= Flash->Latch[Index];
+		}
+	} else {
+		memset(Flash->Mem + Flash->BusyAddr, 0xFF,
+		       QSPIPS_MODEL_SECTOR_SIZE);
+	}
+	Flash->BusyNs += Flash->BusyEnd - Flash->BusyStart;
+	Flash->Busy = 0U;
+	Flash->Wel = 0U;
+}
+
+static void FlashStart(QspiPsFlashModel *Flash, u8 Cmd, u32 Addr, u32 Ns)
+{
+	Flash->Busy = Cmd;
+	Flash->BusyAddr = Addr;
+	Flash->BusyStart = Host_Now();
+	Flash->BusyEnd = Flash->BusyStart + Ns;
+}
+
+static void FlashSelect(QspiPsFlashModel *Flash, u32 Selected)
+{
+	u32 Addr = Flash->Addr % Flash->Size;
+
+	if (Selected == Flash->Selected) {
+		return;
+	}
+	Flash->Selected = Selected;
+	FlashSettle(Flash);
+	if (Selected != 0U) {
+		Flash->Count = 0U;
+		Flash->Cmd = 0U;
+		return;
+	}
+
+	/* The writes start when the chip select is released */
+	if ((Flash->Cmd == XQSPIPS_FLASH_OPCODE_WREN) && (Flash->Count == 1U)) {
+		Flash->Wel = 1U;
+	} else if ((Flash->Cmd == XQSPIPS_FLASH_OPCODE_PP) &&
+		   (Flash->Count > 4U)) {
+		if (Flash->Wel == 0U) {
+			Flash->Refused++;
+		} else {
+			Flash->Programs++;
+			Flash->ProgramBytes += (Flash->Count - 4U) <
+					       QSPIPS_MODEL_PAGE_SIZE ?
+					       (Flash->Count - 4U) :
+					       QSPIPS_MODEL_PAGE_SIZE;
+			FlashStart(Flash, Flash->Cmd,
+				   Addr & ~(QSPIPS_MODEL_PAGE_SIZE - 1U),
+				   Flash->ProgramNs);
+		}
+	} else if ((Flash->Cmd == XQSPIPS_FLASH_OPCODE_SE) &&
+		   (Flash->Count >= 4U)) {
+		if (Flash->Wel == 0U) {
+			Flash->Refused++;
+		} else {
+			Flash->Erases++;
+			FlashStart(Flash, Flash->Cmd,
+				   Addr & ~(QSPIPS_MODEL_SECTOR_SIZE - 1U),
+				   Flash->EraseNs);
+		}
+	}
+	Flash->Cmd = 0U;
+}
+
+static u8 FlashXfer(QspiPsFlashModel *Flash, u8 In)
+{
+	u32 Index = Flash->Count++;
+	u8 Out = 0xFFU;
+
+	FlashSettle(Flash);
+	if (Index == 0U) {
+		Flash->Cmd = In;
+		Flash->Addr = 0U;
+		if ((Flash->Busy != 0U) && (In != XQSPIPS_FLASH_OPCODE_RDSR1)) {
+			Flash->Refused++;
+			Flash->Cmd = 0U;
+		}
+		if (In == XQSPIPS_FLASH_OPCODE_PP) {
+			memset(Flash->Latch, 0xFF, sizeof(Flash->Latch));
+		}
+		return Out;
+	}
+
+	switch (Flash->Cmd) {
+	case XQSPIPS_FLASH_OPCODE_RDSR1:
+		if (Index == 1U) {
+			Flash->StatusReads++;
+		}
+		Out = ((Flash->Busy != 0U) ? SR_WIP : 0U) |
+		      ((Flash->Wel != 0U) ? SR_WEL : 0U);
+		break;
+	case XQSPIPS_FLASH_OPCODE_NORM_READ:
+	case XQSPIPS_FLASH_OPCODE_FAST_READ:
+	case XQSPIPS_FLASH_OPCODE_PP:
+	case XQSPIPS_FLASH_OPCODE_SE:
+		if (Index < 4U) {
+			Flash->Addr = (Flash->Addr << 8) | In;
+			break;
+		}
+		if (Flash->Cmd == XQSPIPS_FLASH_OPCODE_PP) {
+			Flash->Latch[(Flash->Addr + Index - 4U) %
+				     QSPIPS_MODEL_PAGE_SIZE] = In;
+			break;
+		}
+		if ((Flash->Cmd == XQSPIPS_FLASH_OPCODE_FAST_READ) &&
+		    (Index == 4U)) {
+			break;
+		}
+		if (Flash->Cmd != XQSPIPS_FLASH_OPCODE_SE) {
+			Out = Flash->Mem[Flash->Addr % Flash->Size];
+			Flash->Addr++;
+			Flash->ReadBytes++;
+		}
+		break;
+	default:
+		break;
+	}
+
+	return Out;
+}
+
+/*****************************************************************************/
+/*
+ * Controller
+ */
+static void ShiftDone(void *Ref);
+
+static u32 ByteNs(const QspiPsModel *Model)
+{
+	u32 Div = 2U << ((Model->Cr & XQSPIPS_CR_PRESC_MASK) >>
+			 XQSPIPS_CR_PRESC_SHIFT);
+
+	return (u32)((8ULL * Div * HOST_NS_PER_SEC) / Model->RefHz);
+}
+
+static u32 ChipSelect(const QspiPsModel *Model)
+{
+	if ((Model->Cr & XQSPIPS_CR_SSFORCE_MASK) != 0U) {
+		return ((Model->Cr & XQSPIPS_CR_SSCTRL_MASK) == 0U) ? 1U : 0U;
+	}
+	return Model->Shifting;
+}
+
+static u32 Status(const QspiPsModel *Model)
+{
+	u32 Sr = Model->Sticky;
+
+	if (Model->TxCount < Model->Txwr) {
+		Sr |= XQSPIPS_IXR_TXOW_MASK;
+	}
+	if (Model->TxCount == QSPIPS_MODEL_FIFO_DEPTH) {
+		Sr |= XQSPIPS_IXR_TXFULL_MASK;
+	}
+	if ((Model->RxCount != 0U) && (Model->RxCount >= Model->Rxwr)) {
+		Sr |= XQSPIPS_IXR_RXNEMPTY_MASK;
+	}
+	if (Model->RxCount == QSPIPS_MODEL_FIFO_DEPTH) {
+		Sr |= XQSPIPS_IXR_RXFULL_MASK;
+	}
+	return Sr;
+}
+
+/* Starts shifting the next TX entry if the controller may */
+static void Kick(QspiPsModel *Model)
+{
+	u32 Ns;
+
+	if ((Model->Shifting != 0U) || (Model->Er == 0U) ||
+	    (Model->TxCount == 0U)) {
+		return;
+	}
+	if (((Model->Cr & XQSPIPS_CR_MANSTRTEN_MASK) != 0U) &&
+	    (Model->Started == 0U)) {
+		return;
+	}
+	Model->Shifting = 1U;
+	FlashSelect(&Model->Flash, ChipSelect(Model));
+	Ns = ByteNs(Model) * Model->TxLen[Model->TxHead];
+	Model->ShiftNs += Ns;
+	Host_Schedule(Host_Now() + Ns, ShiftDone, Model);
+}
+
+static void ShiftDone(void *Ref)
+{
+	QspiPsModel *Model = Ref;
+	u32 Data = Model->Tx[Model->TxHead];
+	u32 Len = Model->TxLen[Model->TxHead];
+	u32 Shift = (Len == 4U) ? 0U : (8U * (4U - Len));
+	u32 Word = 0U;
+	u32 Index;
+	u8 In;
+
+	Model->TxHead = (Model->TxHead + 1U) % QSPIPS_MODEL_FIFO_DEPTH;
+	Model->TxCount--;
+	for (Index = 0U; Index < Len; Index++) {
+		In = 0xFFU;
+		if (Model->Flash.Selected != 0U) {
+			In = FlashXfer(&Model->Flash, (u8)(Data >> (8U * Index)));
+		}
+		Word |= (u32)In << (Shift + (8U * Index));
+	}
+	Model->Bytes += Len;
+
+	if (Model->RxCount == QSPIPS_MODEL_FIFO_DEPTH) {
+		Model->Sticky |= XQSPIPS_IXR_RXOVR_MASK;
+		Model->RxOverruns++;
+	} else {
+		Model->Rx[(Model->RxHead + Model->RxCount) %
+			  QSPIPS_MODEL_FIFO_DEPTH] = Word;
+		Model->RxCount++;
+	}
+
+	Model->Shifting = 0U;
+	if (Model->TxCount == 0U) {
+		Model->Started = 0U;
+		FlashSelect(&Model->Flash, ChipSelect(Model));
+	}
+	Kick(Model);
+}
+
+static void Stop(QspiPsModel *Model)
+{
+	Host_Cancel(ShiftDone, Model);
+	Model->Shifting = 0U;
+	Model->Started = 0U;
+	Model->TxCount = 0U;
+	Model->RxCount = 0U;
+	FlashSelect(&Model->Flash, ChipSelect(Model));
+}
+
+static void Push(QspiPsModel *Model, u32 Value, u32 Len)
+{
+	u32 Slot;
+
+	if (Model->TxCount == QSPIPS_MODEL_FIFO_DEPTH) {
+		Model->TxOverflows++;
+		return;
+	}
+	Slot = (Model->TxHead + Model->TxCount) % QSPIPS_MODEL_FIFO_DEPTH;
+	Model->Tx[Slot] = Value;
+	Model->TxLen[Slot] = (u8)Len;
+	Model->TxCount++;
+	Kick(Model);
+}
+
+static u32 Read(void *Ref, u32 Offset, u32 Size)
+{
+	QspiPsModel *Model = Ref;
+	u32 Word;
+
+	(void)Size;
+	switch (Offset) {
+	case XQSPIPS_CR_OFFSET:
+		return Model->Cr;
+	case XQSPIPS_SR_OFFSET:
+		return Status(Model);
+	case XQSPIPS_IMR_OFFSET:
+		return Model->Imr;
+	case XQSPIPS_ER_OFFSET:
+		return Model->Er;
+	case XQSPIPS_TXWR_OFFSET:
+		return Model->Txwr;
+	case XQSPIPS_RXWR_OFFSET:
+		return Model->Rxwr;
+	case XQSPIPS_RXD_OFFSET:
+		if (Model->RxCount == 0U) {
+			Model->RxUnderflows++;
+			return 0U;
+		}
+		Word = Model->Rx[Model->RxHead];
+		Model->RxHead = (Model->RxHead + 1U) % QSPIPS_MODEL_FIFO_DEPTH;
+		Model->RxCount--;
+		return Word;
+	default:
+		return Model->Other[Offset / 4U];
+	}
+}
+
+static void Write(void *Ref, u32 Offset, u32 Value, u32 Size)
+{
+	QspiPsModel *Model = Ref;
+
+	(void)Size;
+	switch (Offset) {
+	case XQSPIPS_CR_OFFSET:
+		if ((Value & XQSPIPS_CR_MANSTRT_MASK) != 0U) {
+			Model->Started = 1U;
+		}
+		Model->Cr = Value & ~XQSPIPS_CR_MANSTRT_MASK;
+		FlashSelect(&Model->Flash, ChipSelect(Model));
+		Kick(Model);
+		break;
+	case XQSPIPS_SR_OFFSET:
+		Model->Sticky &= ~Value;
+		break;
+	case XQSPIPS_IER_OFFSET:
+		Model->Imr |= Value & IXR_ALL;
+		break;
+	case XQSPIPS_IDR_OFFSET:
+		Model->Imr &= ~Value;
+		break;
+	case XQSPIPS_ER_OFFSET:
+		Model->Er = Value & XQSPIPS_ER_ENABLE_MASK;
+		if (Model->Er == 0U) {
+			Stop(Model);
+		}
+		Kick(Model);
+		break;
+	case XQSPIPS_TXD_00_OFFSET:
+		Push(Model, Value, 4U);
+		break;
+	case XQSPIPS_TXD_01_OFFSET:
+		Push(Model, Value, 1U);
+		break;
+	case XQSPIPS_TXD_10_OFFSET:
+		Push(Model, Value, 2U);
+		break;
+	case XQSPIPS_TXD_11_OFFSET:
+		Push(Model, Value, 3U);
+		break;
+	case XQSPIPS_TXWR_OFFSET:
+		Model->Txwr = Value & XQSPIPS_TXWR_MASK;
+		break;
+	case XQSPIPS_RXWR_OFFSET:
+		Model->Rxwr = Value & XQSPIPS_RXWR_MASK;
+		break;
+	default:
+		Model->Other[Offset / 4U] = Value;
+		break;
+	}
+}
+
+/*****************************************************************************/
+void QspiPsModel_Init(QspiPsModel *Model, UINTPTR Base, u32 AccessNs,
+		      u32 RefHz, u32 FlashSize, u32 ProgramNs, u32 EraseNs)
+{
+	memset(Model, 0, sizeof(*Model));
+	Model->Base = Base;
+	Model->RefHz = RefHz;
+	Model->Txwr = XQSPIPS_TXWR_RESET_VALUE;
+	Model->Rxwr = XQSPIPS_RXWR_RESET_VALUE;
+	Model->Flash.Size = FlashSize;
+	Model->Flash.ProgramNs = ProgramNs;
+	Model->Flash.EraseNs = EraseNs;
+	Model->Flash.Seed = 1U;
+	Model->Flash.Mem = malloc(FlashSize);
+	memset(Model->Flash.Mem, 0xFF, FlashSize);
+	HostIo_Map(Base, QSPIPS_MODEL_WINDOW_SIZE, AccessNs, Read, Write, Model);
+}
+
+u32 QspiPsModel_IrqPending(const QspiPsModel *Model)
+{
+	return ((Status(Model) & Model->Imr) != 0U) ? 1U : 0U;
+}
+
+void QspiPsModel_PowerCut(QspiPsModel *Model)
+{
+	QspiPsFlashModel *Flash = &Model->Flash;
+	u64 Now = Host_Now();
+	u32 Len;
+	u32 Index;
+	u32 Bit;
+	u32 Limit;
+	u8 Old;
+	u8 New;
+
+	FlashSettle(Flash);
+	if (Flash->Busy != 0U) {
+		/* Each bit gets there with the probability of the time done */
+		Limit = (u32)(((Now - Flash->BusyStart) << 16) /
+			      (Flash->BusyEnd - Flash->BusyStart));
+		Len = (Flash->Busy == XQSPIPS_FLASH_OPCODE_PP) ?
+		      QSPIPS_MODEL_PAGE_SIZE : QSPIPS_MODEL_SECTOR_SIZE;
+		for (Index = 0U; Index < Len; Index++) {
+			Old = Flash->Mem[Flash->BusyAddr + Index];
+			New = (Flash->Busy == XQSPIPS_FLASH_OPCODE_PP) ?
+			      (Old & Flash->Latch[Index]) : 0xFFU;
+			for (Bit = 0U; Bit < 8U; Bit++) {
+				if ((((Old ^ New) >> Bit) & 1U) != 0U &&
+				    ((FlashRandom(Flash) & 0xFFFFU) < Limit)) {
+					Old ^= (u8)(1U << Bit);
+				}
+			}
+			Flash->Mem[Flash->BusyAddr + Index] = Old;
+		}
+		Flash->BusyNs += Now - Flash->BusyStart;
+		Flash->TornWrites++;
+		Flash->Busy = 0U;
+	}
+	Flash->Wel = 0U;
+	Flash->Selected = 0U;
+	Flash->Cmd = 0U;
+	Flash->Count = 0U;
+	Flash->PowerCuts++;
+
+	Host_Cancel(ShiftDone, Model);
+	Model->Cr = 0U;
+	Model->Imr = 0U;
+	Model->Er = 0U;
+	Model->Txwr = XQSPIPS_TXWR_RESET_VALUE;
+	Model->Rxwr = XQSPIPS_RXWR_RESET_VALUE;
+	Model->Sticky = 0U;
+	Model->Shifting = 0U;
+	Model->Started = 0U;
+	Model->TxCount = 0U;
+	Model->RxCount = 0U;
+}
+
+void QspiPsModel_Release(QspiPsModel *Model)
+{
+	Host_Cancel(ShiftDone, Model);
+	HostIo_Unmap(Model->Base);
+	free(Model->Flash.Mem);
+	Model->Flash.Mem = NULL;
+}
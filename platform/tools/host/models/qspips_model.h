@@ -0,0 +1,151 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file qspips_model.h
+*
+* Model of the Zynq PS QSPI controller in I/O mode with a serial NOR flash
+* on chip select 0, for the host builds.
+*
+* Controller:
+* - TXD_00 queues 4 bytes, TXD_01, TXD_10 and TXD_11 queue 1, 2 and 3
+*   bytes, the low byte first. The FIFOs hold QSPIPS_MODEL_FIFO_DEPTH
+*   words. A write to a full TX FIFO is lost and counted in TxOverflows.
+* - While the controller is enabled (ER) the TX FIFO is shifted out, one
+*   entry after the other, at 8 SCLK per byte; SCLK is the reference clock
+*   divided by the prescaler of CR. With MANSTRTEN set, shifting only
+*   starts when MANSTRT is written and MANSTRT clears when the FIFO runs
+*   empty. An entry leaves the TX FIFO when its last byte is shifted and
+*   its RX word enters the RX FIFO at that moment, so TXOW with TXWR at 1
+*   means that every RX word is there. The bytes received for a 1, 2 or 3
+*   byte entry are in the top bytes of the RX word. A word for a full RX
+*   FIFO is lost and sets RXOVR.
+* - With SSFORCE the chip select follows the SSCTRL bit of CR, 0 selects
+*   the flash. Without it the flash is selected while the controller
+*   shifts and released when the TX FIFO runs empty.
+* - SR reads TXOW (TX level below TXWR), TXFULL, RXNEMPTY (RX level at or
+*   above RXWR), RXFULL and the sticky RXOVR. TXUF is never set. The
+*   interrupt line is SR masked by IMR, set with IER and cleared with IDR.
+* - Disabling the controller stops the shifting and empties both FIFOs.
+*
+* Flash:
+* - 3 byte addresses, pages of QSPIPS_MODEL_PAGE_SIZE bytes and sectors of
+*   QSPIPS_MODEL_SECTOR_SIZE bytes. The commands are decoded per chip
+*   select: WREN, RDSR1 (status repeated), READ, FAST_READ (one dummy
+*   byte), PP and SE. PP and SE need the write enable latch and start when
+*   the chip select is released; PP programs the latched bytes, wrapping
+*   in the page, and can only clear bits. While the write is in progress
+*   only RDSR1 is accepted, any other command is ignored and counted in
+*   Refused, as are PP and SE without WREN.
+* - The program and erase times are parameters of QspiPsModel_Init, so is
+*   the reference clock. The register access time is a parameter too.
+* - QspiPsModel_PowerCut stops the flash and the controller at once: a
+*   page program or sector erase in progress moves each of its bits to the
+*   new value with a probability equal to the part of its time that has
+*   passed, the other bits keep their old value. The write enable latch,
+*   the chip select and the FIFOs are lost.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef QSPIPS_MODEL_H
+#define QSPIPS_MODEL_H
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define QSPIPS_MODEL_WINDOW_SIZE	0x100U
+#define QSPIPS_MODEL_FIFO_DEPTH		63U
+#define QSPIPS_MODEL_PAGE_SIZE		256U
+#define QSPIPS_MODEL_SECTOR_SIZE	0x10000U
+
+typedef struct {
+	u8 *Mem;
+	u32 Size;
+	u32 ProgramNs;		/* Page program time */
+	u32 EraseNs;		/* Sector erase time */
+
+	u32 Selected;
+	u32 Count;		/* Bytes since the chip select */
+	u8 Cmd;
+	u32 Addr;
+	u32 Wel;
+	u8 Latch[QSPIPS_MODEL_PAGE_SIZE];
+	u32 LatchLen;
+
+	/* Program or erase in progress */
+	u8 Busy;		/* 0, or the instruction */
+	u32 BusyAddr;
+	u64 BusyStart;
+	u64 BusyEnd;
+	u32 Seed;
+
+	/* Statistics */
+	u64 Programs;
+	u64 ProgramBytes;	/* Bytes latched by the page programs */
+	u64 Erases;
+	u64 ReadBytes;
+	u64 StatusReads;
+	u64 Refused;
+	u64 BusyNs;		/* Time spent programming and erasing */
+	u64 PowerCuts;
+	u64 TornWrites;		/* Programs and erases cut */
+} QspiPsFlashModel;
+
+typedef struct {
+	UINTPTR Base;
+	u32 RefHz;
+
+	u32 Cr;
+	u32 Imr;
+	u32 Er;
+	u32 Txwr;
+	u32 Rxwr;
+	u32 Sticky;		/* RXOVR */
+	u32 Other[QSPIPS_MODEL_WINDOW_SIZE / 4U];
+
+	u32 Tx[QSPIPS_MODEL_FIFO_DEPTH];
+	u8 TxLen[QSPIPS_MODEL_FIFO_DEPTH];
+	u32 TxHead;
+	u32 TxCount;
+	u32 Rx[QSPIPS_MODEL_FIFO_DEPTH];
+	u32 RxHead;
+	u32 RxCount;
+	u32 Shifting;		/* An entry is being shifted */
+	u32 Started;		/* MANSTRT seen */
+
+	QspiPsFlashModel Flash;
+
+	/* Statistics */
+	u64 Bytes;		/* Bytes shifted */
+	u64 ShiftNs;		/* Time the bus was busy */
+	u64 TxOverflows;
+	u64 RxOverruns;
+	u64 RxUnderflows;	/* Reads of an empty RX FIFO */
+} QspiPsModel;
+
+void QspiPsModel_Init(QspiPsModel *Model, UINTPTR Base, u32 AccessNs,
+		      u32 RefHz, u32 FlashSize, u32 ProgramNs, u32 EraseNs);
+u32 QspiPsModel_IrqPending(const QspiPsModel *Model);
+void QspiPsModel_PowerCut(QspiPsModel *Model);
+void QspiPsModel_Release(QspiPsModel *Model);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* QSPIPS_MODEL_H */
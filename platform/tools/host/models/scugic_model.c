@@ -0,0 +1,240 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file scugic_model.c
+*
+* Cortex-A9 MPCore interrupt controller model, see scugic_model.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <string.h>
+
+#include "host.h"
+#include "xparameters.h"
+#include "xscugic_hw.h"
+#include "scugic_model.h"
+
+#define PRIORITY_MASK	0xF8U
+
+static u32 Line(const ScuGicModel *Model, u32 IntrId)
+{
+	if (IntrId == XPAR_GLOBAL_TMR_INTR) {
+		return Host_GtIrqPending();
+	}
+	if (Model->Line == NULL) {
+		return 0U;
+	}
+	return Model->Line(Model->LineRef, IntrId);
+}
+
+static u32 PendingWord(const ScuGicModel *Model, u32 Word)
+{
+	u32 Bits = Model->Held[Word];
+	u32 Bit;
+
+	for (Bit = 0U; Bit < 32U; Bit++) {
+		if (Line(Model, (Word * 32U) + Bit) != 0U) {
+			Bits |= 1U << Bit;
+		}
+	}
+	return Bits;
+}
+
+/* Highest priority interrupt CPU 0 would take, SPURIOUS if none */
+static u32 Highest(const ScuGicModel *Model)
+{
+	u32 Best = SCUGIC_MODEL_SPURIOUS;
+	u32 Id;
+
+	if (((Model->DistCtrl & 1U) == 0U) || ((Model->CpuCtrl & 1U) == 0U)) {
+		return SCUGIC_MODEL_SPURIOUS;
+	}
+	for (Id = 0U; Id < SCUGIC_MODEL_IDS; Id++) {
+		if (((Model->Enabled[Id / 32U] >> (Id % 32U)) & 1U) == 0U) {
+			continue;
+		}
+		if ((Id >= 32U) && ((Model->Target[Id] & 1U) == 0U)) {
+			continue;
+		}
+		if (Model->Priority[Id] >= (Model->Pmr & PRIORITY_MASK)) {
+			continue;
+		}
+		if (ScuGicModel_Pending(Model, Id) == 0U) {
+			continue;
+		}
+		if ((Best == SCUGIC_MODEL_SPURIOUS) ||
+		    (Model->Priority[Id] < Model->Priority[Best])) {
+			Best = Id;
+		}
+	}
+	return Best;
+}
+
+static u32 ReadBytes(const u8 *Bytes, u32 Index, u32 Size)
+{
+	u32 Value = 0U;
+	u32 Byte;
+
+	for (Byte = 0U; (Byte < Size) && ((Index + Byte) < SCUGIC_MODEL_IDS);
+	     Byte++) {
+		Value |= (u32)Bytes[Index + Byte] << (8U * Byte);
+	}
+	return Value;
+}
+
+static u32 DistRead(void *Ref, u32 Offset, u32 Size)
+{
+	ScuGicModel *Model = Ref;
+	u32 Word = (Offset & 0x7FU) / 4U;
+	u32 Value;
+	u32 Byte;
+
+	if (Offset == XSCUGIC_DIST_EN_OFFSET) {
+		return Model->DistCtrl;
+	}
+	if ((Offset >= XSCUGIC_ENABLE_SET_OFFSET) &&
+	    (Offset < XSCUGIC_PENDING_SET_OFFSET)) {
+		return (Word < (SCUGIC_MODEL_IDS / 32U)) ? Model->Enabled[Word] :
+		       0U;
+	}
+	if ((Offset >= XSCUGIC_PENDING_SET_OFFSET) &&
+	    (Offset < (XSCUGIC_PENDING_CLR_OFFSET + 0x80U))) {
+		return (Word < (SCUGIC_MODEL_IDS / 32U)) ?
+		       PendingWord(Model, Word) : 0U;
+	}
+	if ((Offset >= XSCUGIC_PRIORITY_OFFSET) &&
+	    (Offset < (XSCUGIC_PRIORITY_OFFSET + SCUGIC_MODEL_IDS))) {
+		return ReadBytes(Model->Priority,
+				 Offset - XSCUGIC_PRIORITY_OFFSET, Size);
+	}
+	if ((Offset >= XSCUGIC_SPI_TARGET_OFFSET) &&
+	    (Offset < (XSCUGIC_SPI_TARGET_OFFSET + SCUGIC_MODEL_IDS))) {
+		Value = ReadBytes(Model->Target,
+				  Offset - XSCUGIC_SPI_TARGET_OFFSET, Size);
+		for (Byte = 0U; Byte < Size; Byte++) {
+			if (((Offset - XSCUGIC_SPI_TARGET_OFFSET) + Byte) < 32U) {
+				Value |= 1U << (8U * Byte);
+			}
+		}
+		return Value;
+	}
+	return 0U;
+}
+
+static void WriteBytes(u8 *Bytes, u32 Index, u32 Value, u32 Size, u8 Mask)
+{
+	u32 Byte;
+
+	for (Byte = 0U; (Byte < Size) && ((Index + Byte) < SCUGIC_MODEL_IDS);
+	     Byte++) {
+		Bytes[Index + Byte] = (u8)(Value >> (8U * Byte)) & Mask;
+	}
+}
+
+static void DistWrite(void *Ref, u32 Offset, u32 Value, u32 Size)
+{
+	ScuGicModel *Model = Ref;
+	u32 Word = (Offset & 0x7FU) / 4U;
+
+	if (Offset == XSCUGIC_DIST_EN_OFFSET) {
+		Model->DistCtrl = Value & 1U;
+	} else if ((Offset >= XSCUGIC_ENABLE_SET_OFFSET) &&
+		   (Offset < XSCUGIC_DISABLE_OFFSET)) {
+		if (Word < (SCUGIC_MODEL_IDS / 32U)) {
+			Model->Enabled[Word] |= Value;
+		}
+	} else if ((Offset >= XSCUGIC_DISABLE_OFFSET) &&
+		   (Offset < XSCUGIC_PENDING_SET_OFFSET)) {
+		if (Word < (SCUGIC_MODEL_IDS / 32U)) {
+			Model->Enabled[Word] &= ~Value;
+		}
+	} else if ((Offset >= XSCUGIC_PENDING_SET_OFFSET) &&
+		   (Offset < XSCUGIC_PENDING_CLR_OFFSET)) {
+		if (Word < (SCUGIC_MODEL_IDS / 32U)) {
+			Model->Held[Word] |= Value;
+		}
+	} else if ((Offset >= XSCUGIC_PENDING_CLR_OFFSET) &&
+		   (Offset < (XSCUGIC_PENDING_CLR_OFFSET + 0x80U))) {
+		if (Word < (SCUGIC_MODEL_IDS / 32U)) {
+			Model->Held[Word] &= ~Value;
+		}
+	} else if ((Offset >= XSCUGIC_PRIORITY_OFFSET) &&
+		   (Offset < (XSCUGIC_PRIORITY_OFFSET + SCUGIC_MODEL_IDS))) {
+		WriteBytes(Model->Priority, Offset - XSCUGIC_PRIORITY_OFFSET,
+			   Value, Size, PRIORITY_MASK);
+	} else if ((Offset >= (XSCUGIC_SPI_TARGET_OFFSET + 32U)) &&
+		   (Offset < (XSCUGIC_SPI_TARGET_OFFSET + SCUGIC_MODEL_IDS))) {
+		WriteBytes(Model->Target, Offset - XSCUGIC_SPI_TARGET_OFFSET,
+			   Value, Size, 0x03U);
+	}
+}
+
+static u32 CpuRead(void *Ref, u32 Offset, u32 Size)
+{
+	ScuGicModel *Model = Ref;
+
+	(void)Size;
+	switch (Offset) {
+	case XSCUGIC_CONTROL_OFFSET:
+		return Model->CpuCtrl;
+	case XSCUGIC_CPU_PRIOR_OFFSET:
+		return Model->Pmr;
+	case XSCUGIC_INT_ACK_OFFSET:
+		return Highest(Model);
+	default:
+		return 0U;
+	}
+}
+
+static void CpuWrite(void *Ref, u32 Offset, u32 Value, u32 Size)
+{
+	ScuGicModel *Model = Ref;
+
+	(void)Size;
+	switch (Offset) {
+	case XSCUGIC_CONTROL_OFFSET:
+		Model->CpuCtrl = Value & 1U;
+		break;
+	case XSCUGIC_CPU_PRIOR_OFFSET:
+		Model->Pmr = Value & 0xFFU;
+		break;
+	default:
+		break;
+	}
+}
+
+/*****************************************************************************/
+void ScuGicModel_Init(ScuGicModel *Model, u32 AccessNs)
+{
+	memset(Model, 0, sizeof(*Model));
+	HostIo_Map(XPAR_SCUGIC_DIST_BASEADDR, SCUGIC_MODEL_DIST_WINDOW, AccessNs,
+		   DistRead, DistWrite, Model);
+	HostIo_Map(XPAR_SCUGIC_CPU_BASEADDR, SCUGIC_MODEL_CPU_WINDOW, AccessNs,
+		   CpuRead, CpuWrite, Model);
+}
+
+u32 ScuGicModel_Pending(const ScuGicModel *Model, u32 IntrId)
+{
+	if (((Model->Held[IntrId / 32U] >> (IntrId % 32U)) & 1U) != 0U) {
+		return 1U;
+	}
+	return Line(Model, IntrId);
+}
+
+u32 ScuGicModel_WakeUp(void *Ref)
+{
+	return (Highest(Ref) != SCUGIC_MODEL_SPURIOUS) ? 1U : 0U;
+}
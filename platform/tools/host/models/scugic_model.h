@@ -0,0 +1,78 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file scugic_model.h
+*
+* Model of the interrupt controller of the Cortex-A9 MPCore (GIC
+* distributor and CPU interface) for the host builds, as seen from CPU 0.
+*
+* - Distributor: control, enable set and clear, pending set and clear,
+*   priority and SPI target registers for interrupt IDs 0 to 95. The
+*   priority fields keep their upper five bits. The targets of SGIs and
+*   PPIs read as CPU 0.
+* - CPU interface: control, priority mask and the acknowledge register,
+*   which returns the highest priority pending interrupt or 1023.
+* - Interrupts are level sensitive. An interrupt is pending while its line
+*   is high or while a write to the pending set register holds it, until
+*   the pending clear register drops that hold. The line of ID 27 is the
+*   global timer comparator of the host runtime, the other lines come
+*   from the Line callback of the test.
+* - ScuGicModel_WakeUp is the condition under which WFI returns on CPU 0:
+*   both enables set and an enabled interrupt targeting CPU 0 pending
+*   above the priority mask. It does not look at the CPSR, a masked IRQ
+*   still wakes the core. It is made for Host_SetWfiWake.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef SCUGIC_MODEL_H
+#define SCUGIC_MODEL_H
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SCUGIC_MODEL_IDS		96U
+#define SCUGIC_MODEL_DIST_WINDOW	0x1000U
+#define SCUGIC_MODEL_CPU_WINDOW		0x100U
+#define SCUGIC_MODEL_SPURIOUS		1023U
+
+/* Level of the interrupt line IntrId (not called for ID 27) */
+typedef u32 (*ScuGicModelLine)(void *Ref, u32 IntrId);
+
+typedef struct {
+	ScuGicModelLine Line;
+	void *LineRef;
+
+	u32 DistCtrl;
+	u32 CpuCtrl;
+	u32 Pmr;
+	u32 Enabled[SCUGIC_MODEL_IDS / 32U];
+	u32 Held[SCUGIC_MODEL_IDS / 32U];	/* Set by the pending set register */
+	u8 Priority[SCUGIC_MODEL_IDS];
+	u8 Target[SCUGIC_MODEL_IDS];
+} ScuGicModel;
+
+void ScuGicModel_Init(ScuGicModel *Model, u32 AccessNs);
+u32 ScuGicModel_Pending(const ScuGicModel *Model, u32 IntrId);
+u32 ScuGicModel_WakeUp(void *Ref);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCUGIC_MODEL_H */
@@ -0,0 +1,153 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file scutimer_model.c
+*
+* Cortex-A9 private timer model, see scutimer_model.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <string.h>
+
+#include "host.h"
+#include "xscutimer_hw.h"
+#include "scutimer_model.h"
+
+static void ScuTimerExpire(void *Ref);
+
+static u32 Enabled(const ScuTimerModel *Model)
+{
+	return Model->Control & XSCUTIMER_CONTROL_ENABLE_MASK;
+}
+
+static u64 Divider(const ScuTimerModel *Model)
+{
+	return (u64)((Model->Control & XSCUTIMER_CONTROL_PRESCALER_MASK) >>
+		     XSCUTIMER_CONTROL_PRESCALER_SHIFT) + 1U;
+}
+
+static u32 IrqLine(const ScuTimerModel *Model)
+{
+	return ((Model->Isr != 0U) &&
+		((Model->Control & XSCUTIMER_CONTROL_IRQ_ENABLE_MASK) != 0U)) ?
+	       1U : 0U;
+}
+
+/* Counter value now, the counter stops at zero until ScuTimerExpire runs */
+static u32 Counter(const ScuTimerModel *Model)
+{
+	u64 Ticks;
+
+	if (Enabled(Model) == 0U) {
+		return Model->Counter;
+	}
+	Ticks = Host_GtCounts(Host_Now() - Model->StartNs) / Divider(Model);
+	return (Ticks >= Model->Counter) ? 0U : (Model->Counter - (u32)Ticks);
+}
+
+/* Freeze the counter, then run it again from now if enabled */
+static void Restart(ScuTimerModel *Model, u32 Value)
+{
+	Host_Cancel(ScuTimerExpire, Model);
+	Model->Counter = Value;
+	Model->StartNs = Host_Now();
+	if ((Enabled(Model) != 0U) && (Value != 0U)) {
+		Host_Schedule(Model->StartNs +
+			      Host_GtNs((u64)Value * Divider(Model)),
+			      ScuTimerExpire, Model);
+	}
+}
+
+static void ScuTimerExpire(void *Ref)
+{
+	ScuTimerModel *Model = Ref;
+	u32 Before = IrqLine(Model);
+
+	Model->Expiries++;
+	Model->Isr = XSCUTIMER_ISR_EVENT_FLAG_MASK;
+	if ((Before == 0U) && (IrqLine(Model) != 0U)) {
+		Model->Interrupts++;
+	}
+	if ((Model->Control & XSCUTIMER_CONTROL_AUTO_RELOAD_MASK) != 0U) {
+		Restart(Model, Model->Load);
+	} else {
+		Model->Counter = 0U;
+		Model->StartNs = Host_Now();
+	}
+}
+
+static u32 ScuTimerRead(void *Ref, u32 Offset, u32 Size)
+{
+	ScuTimerModel *Model = Ref;
+
+	(void)Size;
+	switch (Offset) {
+	case XSCUTIMER_LOAD_OFFSET:
+		return Model->Load;
+	case XSCUTIMER_COUNTER_OFFSET:
+		return Counter(Model);
+	case XSCUTIMER_CONTROL_OFFSET:
+		return Model->Control;
+	case XSCUTIMER_ISR_OFFSET:
+		return Model->Isr;
+	default:
+		return 0U;
+	}
+}
+
+static void ScuTimerWrite(void *Ref, u32 Offset, u32 Value, u32 Size)
+{
+	ScuTimerModel *Model = Ref;
+	u32 Before = IrqLine(Model);
+	u32 Now;
+
+	(void)Size;
+	switch (Offset) {
+	case XSCUTIMER_LOAD_OFFSET:
+		Model->Load = Value;
+		Restart(Model, Value);
+		break;
+	case XSCUTIMER_COUNTER_OFFSET:
+		Restart(Model, Value);
+		break;
+	case XSCUTIMER_CONTROL_OFFSET:
+		Now = Counter(Model);
+		Model->Control = Value;
+		Restart(Model, Now);
+		break;
+	case XSCUTIMER_ISR_OFFSET:
+		Model->Isr &= ~Value;
+		break;
+	default:
+		break;
+	}
+	if ((Before == 0U) && (IrqLine(Model) != 0U)) {
+		Model->Interrupts++;
+	}
+}
+
+/*****************************************************************************/
+void ScuTimerModel_Init(ScuTimerModel *Model, UINTPTR Base, u32 AccessNs)
+{
+	memset(Model, 0, sizeof(*Model));
+	HostIo_Map(Base, SCUTIMER_MODEL_WINDOW_SIZE, AccessNs, ScuTimerRead,
+		   ScuTimerWrite, Model);
+}
+
+u32 ScuTimerModel_IrqPending(const ScuTimerModel *Model)
+{
+	return IrqLine(Model);
+}
@@ -0,0 +1,62 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file scutimer_model.h
+*
+* Model of the Cortex-A9 private timer (SCU timer) for the host builds.
+*
+* - Registers: LOAD, COUNTER, CONTROL (enable, auto reload, IRQ enable,
+*   prescaler) and ISR (event flag, write 1 to clear). A write of LOAD
+*   also loads the counter.
+* - While enabled the counter decrements once every prescaler + 1 ticks
+*   of PERIPHCLK, the clock of the global timer, at COUNTS_PER_SECOND.
+*   Reaching zero sets the event flag, with auto reload the counter
+*   starts again from LOAD, without it stays at zero.
+* - The interrupt line is the event flag with IRQ enable set.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef SCUTIMER_MODEL_H
+#define SCUTIMER_MODEL_H
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SCUTIMER_MODEL_WINDOW_SIZE	0x20U
+
+typedef struct {
+	u32 Load;
+	u32 Counter;		/* Value at StartNs */
+	u32 Control;
+	u32 Isr;
+	u64 StartNs;
+
+	/* Statistics */
+	u64 Expiries;		/* Counter reached zero */
+	u64 Interrupts;		/* Rising edges of the interrupt line */
+} ScuTimerModel;
+
+void ScuTimerModel_Init(ScuTimerModel *Model, UINTPTR Base, u32 AccessNs);
+u32 ScuTimerModel_IrqPending(const ScuTimerModel *Model);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCUTIMER_MODEL_H */
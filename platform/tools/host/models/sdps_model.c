@@ -0,0 +1,765 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file sdps_model.c
+*
+* Zynq PS SD host controller and SD memory card model, see sdps_model.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "host.h"
+#include "xsdps_hw.h"
+#include "sdps_model.h"
+
+/* Card states of the card status, bits 12:9 of R1 */
+#define CARD_IDLE		0U
+#define CARD_READY		1U
+#define CARD_IDENT		2U
+#define CARD_STBY		3U
+#define CARD_TRAN		4U
+
+#define R1_OUT_OF_RANGE		0x80000000U
+#define R1_READY_FOR_DATA	0x00000100U
+#define R1_APP_CMD		0x00000020U
+
+#define OCR_BUSY		0x80000000U	/* Set when ready */
+#define OCR_CCS			0x40000000U
+#define OCR_VDD			0x00FF8000U
+#define ACMD41_HCS		0x40000000U
+
+#define CAPS			(XSDPS_CAP_VOLT_3V3_MASK | XSDPS_CAP_HIGH_SPEED_MASK | \
+				 XSDPS_CAP_ADMA2_MASK)
+
+#define DESC_ACT_MASK		0x30U
+
+/* Transfers of a command, set by the card */
+#define XFER_NONE		0U
+#define XFER_READ		1U	/* Card memory to host */
+#define XFER_REG		2U	/* Reply to host */
+#define XFER_WRITE		3U	/* Host to card memory */
+#define XFER_BUSY		4U	/* R1b busy, no data */
+
+/* Outcome of a command at the card */
+typedef struct {
+	u32 Respond;		/* 0 for no response, a command timeout */
+	u32 Xfer;
+	u32 Blocks;
+	u32 Status;		/* R1 status bits to add */
+	u64 BusyNs;		/* R1b busy time */
+} CardResult;
+
+/*****************************************************************************/
+/*
+ * Registers
+ */
+static u32 Get16(const SdPsModel *Model, u32 Offset)
+{
+	return (u32)Model->Regs[Offset] | ((u32)Model->Regs[Offset + 1U] << 8);
+}
+
+static u32 Get32(const SdPsModel *Model, u32 Offset)
+{
+	return Get16(Model, Offset) | (Get16(Model, Offset + 2U) << 16);
+}
+
+static void Put32(SdPsModel *Model, u32 Offset, u32 Value)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < 4U; Index++) {
+		Model->Regs[Offset + Index] = (u8)(Value >> (8U * Index));
+	}
+}
+
+static void Raise(SdPsModel *Model, u32 Norm, u32 Err)
+{
+	Model->NormSts |= (u16)(Norm & Get16(Model, XSDPS_NORM_INTR_STS_EN_OFFSET));
+	Model->ErrSts |= (u16)(Err & Get16(Model, XSDPS_ERR_INTR_STS_EN_OFFSET));
+}
+
+static u32 NormStatus(const SdPsModel *Model)
+{
+	return (u32)Model->NormSts | ((Model->ErrSts != 0U) ?
+				      XSDPS_INTR_ERR_MASK : 0U);
+}
+
+static u32 ClockHz(const SdPsModel *Model)
+{
+	u32 Clk = Get16(Model, XSDPS_CLK_CTRL_OFFSET);
+	u32 Div = (Clk >> 8) & XSDPS_CC_SDCLK_FREQ_SEL_MASK;
+
+	if ((Clk & (XSDPS_CC_INT_CLK_EN_MASK | XSDPS_CC_SD_CLK_EN_MASK)) !=
+	    (XSDPS_CC_INT_CLK_EN_MASK | XSDPS_CC_SD_CLK_EN_MASK)) {
+		return 0U;
+	}
+	return (Div == 0U) ? Model->RefHz : (Model->RefHz / (2U * Div));
+}
+
+static u32 HostWidth(const SdPsModel *Model)
+{
+	return ((Model->Regs[XSDPS_HOST_CTRL1_OFFSET] & XSDPS_HC_WIDTH_MASK) != 0U) ?
+	       4U : 1U;
+}
+
+static u64 CyclesNs(const SdPsModel *Model, u64 Cycles)
+{
+	return (Cycles * HOST_NS_PER_SEC) / ClockHz(Model);
+}
+
+static u32 Present(const SdPsModel *Model)
+{
+	u32 Psr = XSDPS_PSR_CARD_INSRT_MASK | XSDPS_PSR_CARD_STABLE_MASK |
+		  XSDPS_PSR_CARD_DPL_MASK | XSDPS_PSR_WPS_PL_MASK |
+		  XSDPS_PSR_CMD_SG_LVL_MASK | XSDPS_PSR_DAT30_SG_LVL_MASK;
+
+	if (Model->CmdBusy != 0U) {
+		Psr |= XSDPS_PSR_INHIBIT_CMD_MASK;
+	}
+	if (Model->DatBusy != 0U) {
+		Psr |= XSDPS_PSR_INHIBIT_DAT_MASK | XSDPS_PSR_DAT_ACTIVE_MASK |
+		       ((Model->DatRead != 0U) ? XSDPS_PSR_RD_ACTIVE_MASK :
+			XSDPS_PSR_WR_ACTIVE_MASK);
+	}
+	if (Host_Now() < Model->Card.BusyUntil) {
+		Psr &= ~0x00100000U;	/* DAT0 */
+	}
+	return Psr;
+}
+
+/*****************************************************************************/
+/*
+ * Card
+ */
+static void CardReset(SdPsCardModel *Card)
+{
+	Card->State = CARD_IDLE;
+	Card->AppCmd = 0U;
+	Card->InitStart = 0U;
+	Card->Width = 1U;
+	Card->HighSpeed = 0U;
+	Card->PreErase = 0U;
+}
+
+static u32 CardStatus(const SdPsCardModel *Card)
+{
+	u32 Status = (Card->State << 9) | R1_READY_FOR_DATA;
+
+	if (Card->AppCmd != 0U) {
+		Status |= R1_APP_CMD;
+	}
+	return Status;
+}
+
+/* CSD version 2.0, RESP0..3 hold bits 127:8, the CRC is not reported */
+static void CardCsd(const SdPsCardModel *Card, u32 *Resp)
+{
+	u32 CSize = (Card->Blocks / 1024U) - 1U;
+
+	Resp[3] = (1U << 22) |		/* CSD_STRUCTURE, bits 127:126 */
+		  0x000E0000U |		/* TAAC, bits 119:112 */
+		  0x00000032U;		/* TRAN_SPEED, bits 103:96 */
+	Resp[2] = (0x5B5U << 20) |	/* CCC, bits 95:84 */
+		  (9U << 16);		/* READ_BL_LEN, bits 83:80 */
+	Resp[1] = (CSize << 8) | 0x7FU;	/* C_SIZE, bits 69:48 */
+	Resp[0] = 0x800A4000U;
+}
+
+static void CardCid(u32 *Resp)
+{
+	Resp[3] = 0x00484F53U;		/* MID, OID "HO", bits 127:104 */
+	Resp[2] = 0x544D4F44U;		/* PNM "STMOD" */
+	Resp[1] = 0x45100000U;		/* PRV, PSN */
+	Resp[0] = 0x00001A0AU;		/* MDT */
+}
+
+static u32 CardRange(SdPsModel *Model, u32 Block, u32 Count, CardResult *Res)
+{
+	if (((u64)Block + Count) > Model->Card.Blocks) {
+		Model->Card.AddressErrors++;
+		Res->Status |= R1_OUT_OF_RANGE;
+		return 0U;
+	}
+	return 1U;
+}
+
+/* Decodes a command at the card, fills the response and the transfer */
+static void CardCommand(SdPsModel *Model, u32 Cmd, u32 Arg, u32 Count,
+			CardResult *Res)
+{
+	SdPsCardModel *Card = &Model->Card;
+	u32 App = Card->AppCmd;
+	u32 Rca = Arg >> 16;
+
+	memset(Res, 0, sizeof(*Res));
+	memset(Model->Resp, 0, sizeof(Model->Resp));
+	Card->AppCmd = 0U;
+	Card->Commands++;
+
+	if (App != 0U) {
+		switch (Cmd) {
+		case 6U:
+			if (Card->State == CARD_TRAN) {
+				Card->Width = ((Arg & 3U) == 2U) ? 4U : 1U;
+				Res->Respond = 1U;
+			}
+			return;
+		case 13U:
+			if (Card->State == CARD_TRAN) {
+				memset(Model->Reply, 0, sizeof(Model->Reply));
+				Model->Reply[0] = (Card->Width == 4U) ? 0x80U : 0U;
+				Res->Respond = 1U;
+				Res->Xfer = XFER_REG;
+			}
+			return;
+		case 23U:
+			if (Card->State == CARD_TRAN) {
+				Card->PreErase = Arg & 0x7FFFFFU;
+				Res->Respond = 1U;
+			}
+			return;
+		case 41U:
+			if (Card->State != CARD_IDLE) {
+				return;
+			}
+			if (Card->InitStart == 0U) {
+				Card->InitStart = Host_Now() + 1U;
+			}
+			Model->Resp[0] = OCR_VDD;
+			if (((Arg & ACMD41_HCS) != 0U) &&
+			    (Host_Now() + 1U >= Card->InitStart + Card->Timing.InitNs)) {
+				Model->Resp[0] |= OCR_BUSY | OCR_CCS;
+				Card->State = CARD_READY;
+			}
+			Res->Respond = 2U;
+			return;
+		case 51U:
+			if (Card->State == CARD_TRAN) {
+				/* SD spec 2.00, 1 and 4 bit, CMD23 not supported */
+				memset(Model->Reply, 0, sizeof(Model->Reply));
+				Model->Reply[0] = 0x02U;
+				Model->Reply[1] = 0x05U;
+				Model->Reply[2] = 0x80U;
+				Res->Respond = 1U;
+				Res->Xfer = XFER_REG;
+			}
+			return;
+		default:
+			break;
+		}
+	}
+
+	switch (Cmd) {
+	case 0U:
+		CardReset(Card);
+		Res->Respond = 2U;
+		break;
+	case 2U:
+		if (Card->State == CARD_READY) {
+			CardCid(Model->Resp);
+			Card->State = CARD_IDENT;
+			Res->Respond = 2U;
+		}
+		break;
+	case 3U:
+		if ((Card->State == CARD_IDENT) || (Card->State == CARD_STBY)) {
+			Card->State = CARD_STBY;
+			Model->Resp[0] = (SDPS_MODEL_RCA << 16) | CardStatus(Card);
+			Res->Respond = 2U;
+		}
+		break;
+	case 6U:
+		if (Card->State != CARD_TRAN) {
+			break;
+		}
+		/* Switch status: 100 mA, group 1 default and high speed */
+		memset(Model->Reply, 0, sizeof(Model->Reply));
+		Model->Reply[1] = 0x64U;
+		Model->Reply[12] = 0x80U;
+		Model->Reply[13] = 0x03U;
+		if ((Arg & 0xFU) == 1U) {
+			Model->Reply[16] = 0x01U;
+			if ((Arg & 0x80000000U) != 0U) {
+				Card->HighSpeed = 1U;
+			}
+		}
+		Res->Respond = 1U;
+		Res->Xfer = XFER_REG;
+		break;
+	case 7U:
+		if (Rca == SDPS_MODEL_RCA) {
+			if ((Card->State == CARD_STBY) || (Card->State == CARD_TRAN)) {
+				Card->State = CARD_TRAN;
+				Res->Respond = 1U;
+			}
+		} else if (Card->State == CARD_TRAN) {
+			Card->State = CARD_STBY;
+		}
+		break;
+	case 8U:
+		if (Card->State == CARD_IDLE) {
+			Model->Resp[0] = Arg & 0xFFFU;
+			Res->Respond = 2U;
+		}
+		break;
+	case 9U:
+		if ((Card->State == CARD_STBY) && (Rca == SDPS_MODEL_RCA)) {
+			CardCsd(Card, Model->Resp);
+			Res->Respond = 2U;
+		}
+		break;
+	case 12U:
+		if (Card->State == CARD_TRAN) {
+			Res->Respond = 1U;
+		}
+		break;
+	case 13U:
+		if ((Card->State >= CARD_STBY) && (Rca == SDPS_MODEL_RCA)) {
+			Res->Respond = 1U;
+		}
+		break;
+	case 55U:
+		/* Addressed once the card has its RCA */
+		if ((Card->State < CARD_STBY) || (Rca == SDPS_MODEL_RCA)) {
+			Card->AppCmd = 1U;
+			Res->Respond = 1U;
+		}
+		break;
+	case 16U:
+	case 32U:
+	case 33U:
+		if (Card->State == CARD_TRAN) {
+			if (Cmd == 32U) {
+				Card->EraseStart = Arg;
+			} else if (Cmd == 33U) {
+				Card->EraseEnd = Arg;
+			}
+			Res->Respond = 1U;
+		}
+		break;
+	case 17U:
+	case 18U:
+	case 24U:
+	case 25U:
+		if (Card->State != CARD_TRAN) {
+			break;
+		}
+		Res->Respond = 1U;
+		Res->Blocks = ((Cmd == 17U) || (Cmd == 24U)) ? 1U : Count;
+		Model->DataBlock = Arg;
+		if (CardRange(Model, Arg, Res->Blocks, Res) != 0U) {
+			Res->Xfer = (Cmd < 24U) ? XFER_READ : XFER_WRITE;
+		}
+		break;
+	case 38U:
+		if (Card->State != CARD_TRAN) {
+			break;
+		}
+		Res->Respond = 1U;
+		Res->Xfer = XFER_BUSY;
+		if ((Card->EraseEnd >= Card->EraseStart) &&
+		    (CardRange(Model, Card->EraseStart,
+			       Card->EraseEnd - Card->EraseStart + 1U, Res) != 0U)) {
+			memset(Card->Mem + ((u64)Card->EraseStart * SDPS_MODEL_BLOCK_SIZE),
+			       0, (u64)(Card->EraseEnd - Card->EraseStart + 1U) *
+			       SDPS_MODEL_BLOCK_SIZE);
+			Res->BusyNs = Card->Timing.SetupNs;
+		}
+		break;
+	default:
+		break;
+	}
+
+	if (Res->Respond == 1U) {
+		Model->Resp[0] = CardStatus(Card) | Res->Status;
+	}
+}
+
+/*****************************************************************************/
+/*
+ * Controller
+ */
+static void CmdDone(void *Ref);
+static void DataDone(void *Ref);
+
+/* Walks the ADMA2 table and moves Bytes, 0 on a table error */
+static u32 AdmaMove(SdPsModel *Model, u8 *Card, u32 Bytes, u32 ToHost)
+{
+	UINTPTR Addr = Get32(Model, XSDPS_ADMA_SAR_OFFSET);
+	u32 Done = 0U;
+	u32 Attr;
+	u32 Len;
+	u32 Loops;
+
+	for (Loops = 0U; Loops < 1024U; Loops++) {
+		Attr = *(const volatile u16 *)Addr;
+		Len = *(const volatile u16 *)(Addr + 2U);
+		if (Len == 0U) {
+			Len = XSDPS_DESC_MAX_LENGTH;
+		}
+		if ((Attr & XSDPS_DESC_VALID) == 0U) {
+			return 0U;
+		}
+		if ((Attr & DESC_ACT_MASK) == XSDPS_DESC_TRAN) {
+			if ((Done + Len) > Bytes) {
+				return 0U;
+			}
+			if (ToHost != 0U) {
+				memcpy((void *)(UINTPTR)*(const volatile u32 *)(Addr + 4U),
+				       Card + Done, Len);
+			} else {
+				memcpy(Card + Done,
+				       (const void *)(UINTPTR)*(const volatile u32 *)(Addr + 4U),
+				       Len);
+			}
+			Done += Len;
+		} else if ((Attr & DESC_ACT_MASK) == DESC_ACT_MASK) {
+			Addr = *(const volatile u32 *)(Addr + 4U);
+			continue;
+		}
+		if ((Attr & XSDPS_DESC_END) != 0U) {
+			return (Done == Bytes) ? 1U : 0U;
+		}
+		Addr += 8U;
+	}
+	return 0U;
+}
+
+static void Command(SdPsModel *Model)
+{
+	SdPsCardModel *Card = &Model->Card;
+	u32 Flags = Model->Regs[XSDPS_CMD_OFFSET];
+	u32 Cmd = Model->Regs[XSDPS_CMD_OFFSET + 1U] & 0x3FU;
+	u32 Mode = Get16(Model, XSDPS_XFER_MODE_OFFSET);
+	u32 Data = ((Flags & XSDPS_DAT_PRESENT_SEL_MASK) != 0U) ? 1U : 0U;
+	u32 Resp = Flags & XSDPS_CMD_RESP_SEL_MASK;
+	u32 BlkSize = Get16(Model, XSDPS_BLK_SIZE_OFFSET) & 0xFFFU;
+	u32 Count = ((Mode & XSDPS_TM_BLK_CNT_EN_MASK) != 0U) ?
+		    Get16(Model, XSDPS_BLK_CNT_OFFSET) : 1U;
+	u64 Now = Host_Now();
+	u64 CmdEnd;
+	u64 Start;
+	u64 End;
+	u64 BusNs;
+	u64 Stalls;
+	CardResult Res;
+	u32 Bytes;
+
+	if ((Model->CmdBusy != 0U) || ((Data != 0U) && (Model->DatBusy != 0U)) ||
+	    (Resp == XSDPS_CMD_RESP_L48_BSY_CHK_MASK && Model->DatBusy != 0U)) {
+		Model->Collisions++;
+		return;
+	}
+	Model->CmdBusy = 1U;
+	Model->RespErr = 0U;
+	Model->DataErr = 0U;
+	Model->DataSrc = NULL;
+	Model->DataBytes = 0U;
+
+	if ((ClockHz(Model) == 0U) || (Card->Powered == 0U)) {
+		Model->RespErr = XSDPS_INTR_ERR_CT_MASK;
+		Host_Schedule(Now + 1000U, CmdDone, Model);
+		return;
+	}
+
+	CardCommand(Model, Cmd, Get32(Model, XSDPS_ARGMT_OFFSET), Count, &Res);
+	if ((Res.Respond == 0U) && (Resp != XSDPS_CMD_RESP_NONE_MASK)) {
+		/* No response within 64 clocks */
+		Model->RespErr = XSDPS_INTR_ERR_CT_MASK;
+		Host_Schedule(Now + CyclesNs(Model, 48U + 64U), CmdDone, Model);
+		return;
+	}
+	CmdEnd = Now + CyclesNs(Model, 48U + 8U +
+				((Resp == XSDPS_CMD_RESP_L136_MASK) ? 136U :
+				 ((Resp == XSDPS_CMD_RESP_NONE_MASK) ? 0U : 48U)));
+	Host_Schedule(CmdEnd, CmdDone, Model);
+
+	if ((Data == 0U) && (Res.Xfer != XFER_BUSY)) {
+		return;
+	}
+	Model->DatBusy = 1U;
+	Model->DatRead = ((Mode & XSDPS_TM_DAT_DIR_SEL_MASK) != 0U) ? 1U : 0U;
+	Bytes = BlkSize * Count;
+	Model->DataBytes = Bytes;
+
+	if (Res.Xfer == XFER_BUSY) {
+		Start = (CmdEnd > Card->BusyUntil) ? CmdEnd : Card->BusyUntil;
+		End = Start + Res.BusyNs;
+		Card->BusyUntil = End;
+		Card->BusyNs += End - Start;
+		Host_Schedule(End, DataDone, Model);
+		return;
+	}
+
+	/* Each block: start bit, data, CRC16 and end bit on every line */
+	BusNs = CyclesNs(Model, 1U + ((8U * (u64)BlkSize) / HostWidth(Model)) +
+			 16U + 1U + ((Model->DatRead != 0U) ? 2U : 8U));
+	if ((Res.Xfer == XFER_NONE) || (Data == 0U)) {
+		/* Address error, the card sends no data */
+		Model->DataErr = XSDPS_INTR_ERR_DT_MASK;
+		Host_Schedule(CmdEnd + CyclesNs(Model, 8U * 1024U), DataDone,
+			      Model);
+		return;
+	}
+	if ((HostWidth(Model) != Card->Width) ||
+	    ((ClockHz(Model) > 25000000U) && (Card->HighSpeed == 0U))) {
+		Card->BusErrors++;
+		Model->DataErr = XSDPS_INTR_ERR_DCRC_MASK;
+	}
+	if (((Mode & XSDPS_TM_DMA_EN_MASK) == 0U) ||
+	    ((Model->Regs[XSDPS_HOST_CTRL1_OFFSET] & XSDPS_HC_DMA_MASK) !=
+	     XSDPS_HC_DMA_ADMA2_32_MASK)) {
+		Model->AdmaErrors++;
+		Model->DataErr |= XSDPS_INTR_ERR_ADMA_MASK;
+	}
+
+	switch (Res.Xfer) {
+	case XFER_REG:
+		Model->DataSrc = Model->Reply;
+		End = CmdEnd + (Count * BusNs);
+		break;
+	case XFER_READ:
+		Model->DataSrc = NULL;
+		Card->ReadBlocks += Count;
+		End = CmdEnd + Card->Timing.ReadAccessNs + (Count * BusNs);
+		break;
+	default:
+		/* Write: the card programs while the next blocks arrive */
+		Start = (CmdEnd > Card->BusyUntil) ? CmdEnd : Card->BusyUntil;
+		End = Start + ((Card->PreErase >= Count) ?
+			       Card->Timing.PreErasedSetupNs :
+			       Card->Timing.SetupNs);
+		End += Count * ((BusNs > Card->Timing.BlockNs) ? BusNs :
+				Card->Timing.BlockNs);
+		if ((Mode & XSDPS_TM_AUTO_CMD12_EN_MASK) != 0U) {
+			End += CyclesNs(Model, 48U + 8U + 48U);
+		}
+		if (Card->Timing.StallBytes != 0U) {
+			Stalls = ((Card->Written + Bytes) / Card->Timing.StallBytes) -
+				 (Card->Written / Card->Timing.StallBytes);
+			End += Stalls * Card->Timing.StallNs;
+			Card->Stalls += Stalls;
+		}
+		Card->Written += Bytes;
+		Card->Writes++;
+		Card->WriteBlocks += Count;
+		if (Card->PreErase >= Count) {
+			Card->PreErasedWrites++;
+		}
+		Card->PreErase = 0U;
+		Card->BusyNs += End - Start;
+		Card->BusyUntil = End;
+		break;
+	}
+	if ((Res.Xfer == XFER_READ) &&
+	    ((Mode & XSDPS_TM_AUTO_CMD12_EN_MASK) != 0U)) {
+		End += CyclesNs(Model, 48U + 8U + 48U);
+	}
+	Model->DataNs += End - CmdEnd;
+	Host_Schedule(End, DataDone, Model);
+}
+
+static void CmdDone(void *Ref)
+{
+	SdPsModel *Model = Ref;
+	u32 Index;
+
+	Model->CmdBusy = 0U;
+	if (Model->RespErr != 0U) {
+		Raise(Model, 0U, Model->RespErr);
+		return;
+	}
+	for (Index = 0U; Index < 4U; Index++) {
+		Put32(Model, XSDPS_RESP0_OFFSET + (4U * Index), Model->Resp[Index]);
+	}
+	Raise(Model, XSDPS_INTR_CC_MASK, 0U);
+}
+
+static void DataDone(void *Ref)
+{
+	SdPsModel *Model = Ref;
+	SdPsCardModel *Card = &Model->Card;
+	u8 *Mem = Card->Mem + ((u64)Model->DataBlock * SDPS_MODEL_BLOCK_SIZE);
+	u32 Ok = 1U;
+
+	Model->DatBusy = 0U;
+	if (Model->DataErr != 0U) {
+		Raise(Model, 0U, Model->DataErr);
+		return;
+	}
+	if (Model->DataBytes != 0U) {
+		if (Model->DataSrc != NULL) {
+			Ok = AdmaMove(Model, (u8 *)Model->DataSrc, Model->DataBytes,
+				      1U);
+		} else if (Model->DatRead != 0U) {
+			Ok = AdmaMove(Model, Mem, Model->DataBytes, 1U);
+		} else {
+			Ok = AdmaMove(Model, Mem, Model->DataBytes, 0U);
+		}
+	}
+	if (Ok == 0U) {
+		Model->AdmaErrors++;
+		Raise(Model, 0U, XSDPS_INTR_ERR_ADMA_MASK);
+		return;
+	}
+	Raise(Model, XSDPS_INTR_TC_MASK, 0U);
+}
+
+static void Reset(SdPsModel *Model, u32 Mask)
+{
+	if ((Mask & XSDPS_SWRST_ALL_MASK) != 0U) {
+		Host_Cancel(CmdDone, Model);
+		Host_Cancel(DataDone, Model);
+		memset(Model->Regs, 0, sizeof(Model->Regs));
+		Model->NormSts = 0U;
+		Model->ErrSts = 0U;
+		Model->CmdBusy = 0U;
+		Model->DatBusy = 0U;
+		Model->Card.Powered = 0U;
+		return;
+	}
+	if ((Mask & XSDPS_SWRST_CMD_LINE_MASK) != 0U) {
+		Host_Cancel(CmdDone, Model);
+		Model->CmdBusy = 0U;
+		Model->NormSts &= (u16)~XSDPS_INTR_CC_MASK;
+	}
+	if ((Mask & XSDPS_SWRST_DAT_LINE_MASK) != 0U) {
+		Host_Cancel(DataDone, Model);
+		Model->DatBusy = 0U;
+		Model->NormSts &= (u16)~XSDPS_INTR_TC_MASK;
+	}
+}
+
+static void Power(SdPsModel *Model)
+{
+	u32 On = ((Model->Regs[XSDPS_POWER_CTRL_OFFSET] &
+		   XSDPS_PC_BUS_PWR_MASK) != 0U) ? 1U : 0U;
+
+	if (On == Model->Card.Powered) {
+		return;
+	}
+	Model->Card.Powered = On;
+	CardReset(&Model->Card);
+}
+
+static u32 Read(void *Ref, u32 Offset, u32 Size)
+{
+	SdPsModel *Model = Ref;
+	u32 Value = 0U;
+	u32 Index;
+
+	Put32(Model, XSDPS_PRES_STATE_OFFSET, Present(Model));
+	Put32(Model, XSDPS_NORM_INTR_STS_OFFSET,
+	      NormStatus(Model) | ((u32)Model->ErrSts << 16));
+	Put32(Model, XSDPS_CAPS_OFFSET, CAPS);
+	Model->Regs[XSDPS_HOST_CTRL_VER_OFFSET] = XSDPS_HC_SPEC_V2;
+	Model->Regs[XSDPS_HOST_CTRL_VER_OFFSET + 1U] = 0U;
+	Model->Regs[XSDPS_CLK_CTRL_OFFSET] &= (u8)~XSDPS_CC_INT_CLK_STABLE_MASK;
+	if ((Model->Regs[XSDPS_CLK_CTRL_OFFSET] & XSDPS_CC_INT_CLK_EN_MASK) != 0U) {
+		Model->Regs[XSDPS_CLK_CTRL_OFFSET] |= XSDPS_CC_INT_CLK_STABLE_MASK;
+	}
+
+	for (Index = 0U; Index < Size; Index++) {
+		Value |= (u32)Model->Regs[Offset + Index] << (8U * Index);
+	}
+	return Value;
+}
+
+static void Write(void *Ref, u32 Offset, u32 Value, u32 Size)
+{
+	SdPsModel *Model = Ref;
+	u32 ResetMask = 0U;
+	u32 Index;
+	u32 Reg;
+	u8 Byte;
+
+	for (Index = 0U; Index < Size; Index++) {
+		Reg = Offset + Index;
+		Byte = (u8)(Value >> (8U * Index));
+		switch (Reg) {
+		case XSDPS_NORM_INTR_STS_OFFSET:
+			Model->NormSts &= (u16)~(u32)Byte;
+			break;
+		case XSDPS_NORM_INTR_STS_OFFSET + 1U:
+			Model->NormSts &= (u16)~((u32)Byte << 8);
+			break;
+		case XSDPS_ERR_INTR_STS_OFFSET:
+			Model->ErrSts &= (u16)~(u32)Byte;
+			break;
+		case XSDPS_ERR_INTR_STS_OFFSET + 1U:
+			Model->ErrSts &= (u16)~((u32)Byte << 8);
+			break;
+		case XSDPS_SW_RST_OFFSET:
+			ResetMask = Byte;
+			break;
+		default:
+			if (((Reg >= XSDPS_PRES_STATE_OFFSET) &&
+			     (Reg < XSDPS_HOST_CTRL1_OFFSET)) ||
+			    ((Reg >= XSDPS_CAPS_OFFSET) &&
+			     (Reg < XSDPS_CAPS_OFFSET + 0x10U)) ||
+			    (Reg >= XSDPS_HOST_CTRL_VER_OFFSET)) {
+				break;
+			}
+			Model->Regs[Reg] = Byte;
+			break;
+		}
+	}
+
+	if (ResetMask != 0U) {
+		Reset(Model, ResetMask);
+	}
+	if ((Offset <= XSDPS_POWER_CTRL_OFFSET) &&
+	    ((Offset + Size) > XSDPS_POWER_CTRL_OFFSET)) {
+		Power(Model);
+	}
+	if ((Offset <= (XSDPS_CMD_OFFSET + 1U)) &&
+	    ((Offset + Size) > (XSDPS_CMD_OFFSET + 1U))) {
+		Command(Model);
+	}
+}
+
+/*****************************************************************************/
+void SdPsModel_Init(SdPsModel *Model, UINTPTR Base, u32 AccessNs,
+		    u32 RefHz, u32 Blocks, const SdPsCardTiming *Timing)
+{
+	memset(Model, 0, sizeof(*Model));
+	Model->Base = Base;
+	Model->RefHz = RefHz;
+	Model->Card.Blocks = Blocks;
+	Model->Card.Timing = *Timing;
+	Model->Card.Mem = calloc(Blocks, SDPS_MODEL_BLOCK_SIZE);
+	CardReset(&Model->Card);
+	HostIo_Map(Base, SDPS_MODEL_WINDOW_SIZE, AccessNs, Read, Write, Model);
+}
+
+u32 SdPsModel_IrqPending(const SdPsModel *Model)
+{
+	return (((NormStatus(Model) &
+		  Get16(Model, XSDPS_NORM_INTR_SIG_EN_OFFSET)) != 0U) ||
+		(((u32)Model->ErrSts &
+		  Get16(Model, XSDPS_ERR_INTR_SIG_EN_OFFSET)) != 0U)) ? 1U : 0U;
+}
+
+void SdPsModel_Release(SdPsModel *Model)
+{
+	Host_Cancel(CmdDone, Model);
+	Host_Cancel(DataDone, Model);
+	HostIo_Unmap(Model->Base);
+	free(Model->Card.Mem);
+	Model->Card.Mem = NULL;
+}
@@ -0,0 +1,166 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file sdps_model.h
+*
+* Model of the Zynq PS SD host controller, SD host controller specification
+* version 2.00, with an SDHC memory card in its slot, for the host builds.
+*
+* Controller:
+* - The registers are accessed as bytes, half words or words at their own
+*   offsets. The command is sent when the top byte of the command register
+*   (0x0F) is written, with the argument, the block size and count and the
+*   transfer mode written before. A command written while the CMD line, or
+*   for a command with data the DAT line, is inhibited is lost and counted
+*   in Collisions.
+* - The normal and error interrupt status bits are only set if enabled in
+*   the status enable registers and are cleared by writing 1. The error
+*   bit of the normal status is the OR of the error status. The interrupt
+*   line is the status masked by the signal enable registers.
+* - SDCLK is the reference clock divided by twice the 8 bit divisor of the
+*   clock control register, the reference clock itself for 0. The internal
+*   clock is stable as soon as it is enabled. Without SDCLK or bus power a
+*   command times out.
+* - Data is moved by ADMA2 with 32 bit descriptors from the address in the
+*   ADMA system address register: transfer and link descriptors, the
+*   valid, end and length fields, a length of 0 for 64 KB. The data is
+*   moved when the transfer completes, so a buffer written or reused before
+*   transfer complete shows up as wrong data. A descriptor without the
+*   valid bit, or a table shorter or longer than the transfer, sets the
+*   ADMA error. Only the ADMA2 mode is modeled.
+* - The present state shows the command and data inhibits and the read and
+*   write transfer active bits while a transfer runs, DAT0 low while the
+*   card is busy, the card inserted, stable and detect pin bits and the
+*   write protect pin high (write enabled).
+* - The software resets clear the controller (all) or abort the command or
+*   the transfer (CMD and DAT lines) at once. A card still programming
+*   stays busy.
+*
+* Card:
+* - Commands CMD0, 2, 3, 6 (check and switch high speed), 7, 8, 9, 12,
+*   13, 16, 17, 18, 24, 25, 32, 33, 38 and 55, and the application
+*   commands ACMD6, 13, 23, 41 and 51. CMD1 and any command the card does
+*   not take in its state get no response, a command timeout.
+* - ACMD41 reports the card ready InitNs after the first one. The card is
+*   SDHC, block addressed, with a CSD version 2.0. The SCR reports 1 and
+*   4 bit bus widths and the switch status high speed support.
+* - A data transfer on a bus width other than the one set by ACMD6, or
+*   above 25 MHz without the switch to high speed, fails with a data CRC
+*   error, counted in BusErrors. An access beyond the card gets an address
+*   error in R1 and no data, a data timeout, counted in AddressErrors.
+* - Timing in SDCLK cycles: 48 bits for the command, 48 or 136 for the
+*   response, 8 cycles of turnaround. A block takes 8 * BlkSize / width
+*   cycles plus CRC, start and end bits and for writes the CRC status.
+*   The read access time and the card times of SdPsCardTiming are
+*   parameters: a write takes SetupNs, or PreErasedSetupNs if ACMD23
+*   announced at least its block count, then per block the longer of the
+*   bus time and BlockNs, then the stop command if any. Each time the data
+*   written crosses a multiple of StallBytes the card is busy StallNs
+*   more, like a card cleaning up its allocation units.
+* - The card memory is allocated by SdPsModel_Init and reads as zeros.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef SDPS_MODEL_H
+#define SDPS_MODEL_H
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SDPS_MODEL_WINDOW_SIZE	0x100U
+#define SDPS_MODEL_BLOCK_SIZE	512U
+#define SDPS_MODEL_RCA		0xB368U
+
+/* Card times, all in ns */
+typedef struct {
+	u32 InitNs;		/* First ACMD41 to ready */
+	u32 ReadAccessNs;	/* Command to the first data block */
+	u32 SetupNs;		/* Start of a write */
+	u32 PreErasedSetupNs;	/* Start of a write announced by ACMD23 */
+	u32 BlockNs;		/* Programming of a block */
+	u32 StallBytes;		/* Data between two stalls, 0 for none */
+	u32 StallNs;		/* Busy time of a stall */
+} SdPsCardTiming;
+
+typedef struct {
+	u8 *Mem;
+	u32 Blocks;
+	SdPsCardTiming Timing;
+
+	u32 Powered;
+	u32 State;		/* Current state of the card status */
+	u32 AppCmd;		/* Next command is an application command */
+	u64 InitStart;		/* Time of the first ACMD41, 0 before */
+	u32 Width;		/* 1 or 4, set by ACMD6 */
+	u32 HighSpeed;		/* Switched by CMD6 */
+	u32 PreErase;		/* Block count of ACMD23 */
+	u32 EraseStart;
+	u32 EraseEnd;
+	u64 BusyUntil;		/* End of the last write or erase */
+	u64 Written;		/* Bytes written, for the stalls */
+
+	/* Statistics */
+	u64 Commands;
+	u64 ReadBlocks;
+	u64 WriteBlocks;
+	u64 Writes;		/* Write commands */
+	u64 PreErasedWrites;	/* Writes announced by ACMD23 */
+	u64 BusyNs;		/* Time the card was busy writing */
+	u64 Stalls;
+	u64 AddressErrors;
+	u64 BusErrors;
+} SdPsCardModel;
+
+typedef struct {
+	UINTPTR Base;
+	u32 RefHz;
+	u8 Regs[SDPS_MODEL_WINDOW_SIZE];
+	u16 NormSts;
+	u16 ErrSts;
+
+	/* Running command and transfer */
+	u32 CmdBusy;
+	u32 DatBusy;
+	u32 DatRead;
+	u32 Resp[4];
+	u32 RespErr;		/* Error bits raised with the response */
+	u32 DataErr;		/* Error bits raised at transfer complete */
+	u32 DataBlock;		/* First block of the card, or */
+	const u8 *DataSrc;	/* the register read, or NULL */
+	u32 DataBytes;
+	u8 Reply[64];		/* SCR, SD status or switch status */
+
+	SdPsCardModel Card;
+
+	/* Statistics */
+	u64 Collisions;
+	u64 AdmaErrors;
+	u64 DataNs;		/* Time the DAT line was busy */
+} SdPsModel;
+
+void SdPsModel_Init(SdPsModel *Model, UINTPTR Base, u32 AccessNs,
+		    u32 RefHz, u32 Blocks, const SdPsCardTiming *Timing);
+u32 SdPsModel_IrqPending(const SdPsModel *Model);
+void SdPsModel_Release(SdPsModel *Model);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SDPS_MODEL_H */
@@ -0,0 +1,89 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file slcr_model.c
+*
+* System level control register model, see slcr_model.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <string.h>
+
+#include "host.h"
+#include "xil_misc_psreset_api.h"
+#include "slcr_model.h"
+
+#define LOCK_OFFSET		0x4U	/* SLCR_LOCK */
+#define UNLOCK_OFFSET		(XSLCR_UNLOCK_ADDR - XSLCR_BASEADDR)
+#define ARM_CLK_CTRL_OFFSET	(XSLCR_ARM_CLK_CTRL_ADDR - XSLCR_BASEADDR)
+#define LOCK_KEY		0x767BU
+
+static u32 Divisor(u32 ArmClkCtrl)
+{
+	return (ArmClkCtrl >> 8) & 0x3FU;
+}
+
+static u32 SlcrRead(void *Ref, u32 Offset, u32 Size)
+{
+	SlcrModel *Model = Ref;
+
+	(void)Size;
+	return Model->Regs[Offset / 4U];
+}
+
+static void SlcrWrite(void *Ref, u32 Offset, u32 Value, u32 Size)
+{
+	SlcrModel *Model = Ref;
+
+	(void)Size;
+	if (Offset == LOCK_OFFSET) {
+		Model->Locked |= (Value == LOCK_KEY) ? 1U : 0U;
+		return;
+	}
+	if (Offset == UNLOCK_OFFSET) {
+		Model->Locked &= (Value == XSLCR_UNLOCK_CODE) ? 0U : 1U;
+		return;
+	}
+	if (Model->Locked != 0U) {
+		Model->Violations++;
+		return;
+	}
+	if ((Offset == ARM_CLK_CTRL_OFFSET) &&
+	    (Divisor(Value) != Divisor(Model->Regs[Offset / 4U]))) {
+		if (Divisor(Value) == 0U) {
+			Model->Violations++;
+			return;
+		}
+		Model->ClkChanges++;
+		Host_GtSetRate(Model->NominalDivisor, Divisor(Value));
+	}
+	Model->Regs[Offset / 4U] = Value;
+}
+
+/*****************************************************************************/
+void SlcrModel_Init(SlcrModel *Model, u32 AccessNs, u32 ArmClkCtrl)
+{
+	memset(Model, 0, sizeof(*Model));
+	Model->Regs[ARM_CLK_CTRL_OFFSET / 4U] = ArmClkCtrl;
+	Model->NominalDivisor = Divisor(ArmClkCtrl);
+	HostIo_Map(XSLCR_BASEADDR, SLCR_MODEL_WINDOW_SIZE, AccessNs, SlcrRead,
+		   SlcrWrite, Model);
+}
+
+u32 SlcrModel_CpuDivisor(const SlcrModel *Model)
+{
+	return Divisor(Model->Regs[ARM_CLK_CTRL_OFFSET / 4U]);
+}
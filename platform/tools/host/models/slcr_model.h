@@ -0,0 +1,59 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file slcr_model.h
+*
+* Model of the system level control registers for the host builds.
+*
+* - Registers read back what was written. Writes other than to the lock
+*   registers are refused while the SLCR is locked and count a Violation.
+*   The SLCR starts unlocked, as the FSBL leaves it.
+* - ARM_CLK_CTRL holds the CPU clock divisor in bits 13:8. The value
+*   passed to SlcrModel_Init is the nominal one COUNTS_PER_SECOND refers
+*   to, a new divisor changes the rate of the global timer, which runs
+*   from the CPU clock, with Host_GtSetRate.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef SLCR_MODEL_H
+#define SLCR_MODEL_H
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SLCR_MODEL_WINDOW_SIZE	0xC00U
+
+typedef struct {
+	u32 Regs[SLCR_MODEL_WINDOW_SIZE / 4U];
+	u32 Locked;
+	u32 NominalDivisor;
+
+	/* Statistics */
+	u64 ClkChanges;		/* ARM_CLK_CTRL writes with a new divisor */
+	u64 Violations;
+} SlcrModel;
+
+void SlcrModel_Init(SlcrModel *Model, u32 AccessNs, u32 ArmClkCtrl);
+u32 SlcrModel_CpuDivisor(const SlcrModel *Model);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SLCR_MODEL_H */
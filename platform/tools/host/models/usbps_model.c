@@ -0,0 +1,476 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file usbps_model.c
+*
+* PS USB controller model, see usbps_model.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <string.h>
+
+#include "host.h"
+#include "usbps_model.h"
+#include "xusbps_endpoint.h"
+#include "xusbps_hw.h"
+
+#define REG(Model, Offset)	((Model)->Regs[(Offset) / 4U])
+#define DTD_WORD(Addr, Index)	(((volatile u32 *)(Addr))[Index])
+#define DQH_WORD(Addr, Offset)	(*(volatile u32 *)((Addr) + (Offset)))
+
+#define CMD_RESET_VALUE		(XUSBPS_CMD_ITHRESHOLD_DEFAULT << 16)
+
+static void UsbPsRetire(void *Ref);
+static void UsbPsPrime(void *Ref);
+
+/*****************************************************************************/
+/*
+ * Bus slots, USBPS_MODEL_UFRAME_SLOTS packets per microframe
+ */
+static u64 SlotTime(u64 Slot)
+{
+	return ((Slot / USBPS_MODEL_UFRAME_SLOTS) * USBPS_MODEL_UFRAME_NS) +
+	       (((Slot % USBPS_MODEL_UFRAME_SLOTS) * USBPS_MODEL_UFRAME_NS) /
+		USBPS_MODEL_UFRAME_SLOTS);
+}
+
+static u64 SlotAt(u64 Ns)
+{
+	return ((Ns / USBPS_MODEL_UFRAME_NS) * USBPS_MODEL_UFRAME_SLOTS) +
+	       ((((Ns % USBPS_MODEL_UFRAME_NS) * USBPS_MODEL_UFRAME_SLOTS) +
+		 USBPS_MODEL_UFRAME_NS - 1U) / USBPS_MODEL_UFRAME_NS);
+}
+
+/* Takes the first free slot at or after Earliest, returns the packet end */
+static u64 BusPacket(UsbPsModel *Model, u64 Earliest)
+{
+	u64 Slot = SlotAt(Earliest);
+
+	if (Slot < Model->NextSlot) {
+		Slot = Model->NextSlot;
+	}
+	Model->NextSlot = Slot + 1U;
+	Model->Slots++;
+	return SlotTime(Slot + 1U);
+}
+
+/*****************************************************************************/
+/*
+ * Interrupts
+ */
+static u32 IrqLine(const UsbPsModel *Model)
+{
+	return ((REG(Model, XUSBPS_ISR_OFFSET) &
+		 REG(Model, XUSBPS_IER_OFFSET)) != 0U) ? 1U : 0U;
+}
+
+static void RaiseIsr(UsbPsModel *Model, u32 Bits)
+{
+	u32 Before = IrqLine(Model);
+
+	REG(Model, XUSBPS_ISR_OFFSET) |= Bits;
+	if ((Before == 0U) && (IrqLine(Model) != 0U)) {
+		Model->Interrupts++;
+	}
+}
+
+static void UsbPsTick(void *Ref)
+{
+	UsbPsModel *Model = Ref;
+
+	Model->TickScheduled = 0U;
+	RaiseIsr(Model, Model->IsrPending);
+	Model->IsrPending = 0U;
+}
+
+/* UI and UE wait for the next interrupt threshold boundary */
+static void RaiseUi(UsbPsModel *Model, u32 Bits)
+{
+	u64 Period = (u64)((REG(Model, XUSBPS_CMD_OFFSET) &
+			    XUSBPS_CMD_ITC_MASK) >> 16) * USBPS_MODEL_UFRAME_NS;
+	u64 Now = Host_Now();
+
+	if (Period == 0U) {
+		RaiseIsr(Model, Bits);
+		return;
+	}
+	Model->IsrPending |= Bits;
+	if (Model->TickScheduled == 0U) {
+		Model->TickScheduled = 1U;
+		Host_Schedule(((Now + Period - 1U) / Period) * Period, UsbPsTick,
+			      Model);
+	}
+}
+
+/*****************************************************************************/
+/*
+ * Endpoint engine
+ */
+static UINTPTR PipedQH(const UsbPsModel *Model, u32 Bit)
+{
+	u32 Index = (Bit >= 16U) ? (((Bit - 16U) * 2U) + 1U) : (Bit * 2U);
+
+	return (UINTPTR)REG(Model, XUSBPS_EPLISTADDR_OFFSET) +
+	       ((UINTPTR)Index * XUSBPS_dQH_ALIGN);
+}
+
+static u32 MaxPacket(const UsbPsModelPipe *Pipe)
+{
+	u32 Cfg = DQH_WORD(PipedQH(Pipe->Model, Pipe->Bit), XUSBPS_dQHCFG);
+	u32 Max = (Cfg & XUSBPS_dQHCFG_MPL_MASK) >> XUSBPS_dQHCFG_MPL_SHIFT;
+
+	return (Max == 0U) ? 64U : Max;
+}
+
+/* Address of byte Offset of the dTD buffer, BPTR1-4 are page addresses */
+static u8 *BufByte(const UsbPsModelPipe *Pipe, u32 Offset)
+{
+	u32 Pos = (Pipe->Copy[2] & 0xFFFU) + Offset;
+
+	if (Pos < 4096U) {
+		return (u8 *)(UINTPTR)(Pipe->Copy[2] + Offset);
+	}
+	return (u8 *)(UINTPTR)((Pipe->Copy[2U + (Pos / 4096U)] & ~0xFFFU) +
+			       (Pos & 0xFFFU));
+}
+
+static void CopyBuffer(const UsbPsModelPipe *Pipe, u32 Len, u32 ToBuffer)
+{
+	u32 Offset = 0U;
+	u32 Chunk;
+	u8 *Addr;
+
+	while (Offset < Len) {
+		Addr = BufByte(Pipe, Offset);
+		Chunk = 4096U - ((u32)(UINTPTR)Addr & 0xFFFU);
+		if (Chunk > (Len - Offset)) {
+			Chunk = Len - Offset;
+		}
+		if (ToBuffer != 0U) {
+			memcpy(Addr, (const void *)&Pipe->Data[Offset], Chunk);
+		} else {
+			memcpy((void *)&((UsbPsModelPipe *)Pipe)->Data[Offset],
+			       Addr, Chunk);
+		}
+		Offset += Chunk;
+	}
+}
+
+static void StopPipe(UsbPsModelPipe *Pipe)
+{
+	UsbPsModel *Model = Pipe->Model;
+
+	Host_Cancel(UsbPsRetire, Pipe);
+	Pipe->Busy = 0U;
+	Pipe->Waiting = 0U;
+	if (Pipe->Ready != 0U) {
+		Pipe->Ready = 0U;
+		Pipe->IdleSince = Host_Now();
+	}
+	REG(Model, XUSBPS_EPRDY_OFFSET) &= ~(1U << Pipe->Bit);
+}
+
+/* Takes OUT packets from the host until the dTD is full or short */
+static void FillOut(UsbPsModelPipe *Pipe)
+{
+	UsbPsModel *Model = Pipe->Model;
+	u32 Max = MaxPacket(Pipe);
+	u8 Packet[1024];
+	u32 Len;
+
+	while ((Pipe->Short == 0U) && (Pipe->Filled < Pipe->Len)) {
+		Len = Model->Out(Model->HostRef, Pipe->Bit, Packet, Max);
+		if (Len == USBPS_MODEL_NO_DATA) {
+			Pipe->Waiting = 1U;
+			return;
+		}
+		/* More than the dTD takes is cut off, like a babble */
+		if (Len > (Pipe->Len - Pipe->Filled)) {
+			Len = Pipe->Len - Pipe->Filled;
+			Pipe->Short = 1U;
+		}
+		memcpy(&Pipe->Data[Pipe->Filled], Packet, Len);
+		Pipe->Filled += Len;
+		Pipe->End = BusPacket(Model, Pipe->End);
+		if (Len < Max) {
+			Pipe->Short = 1U;
+		}
+	}
+	Pipe->Waiting = 0U;
+	Pipe->Busy = 1U;
+	Host_Schedule(Pipe->End, UsbPsRetire, Pipe);
+}
+
+static void StartdTD(UsbPsModelPipe *Pipe, UINTPTR dTD)
+{
+	UsbPsModel *Model = Pipe->Model;
+	UINTPTR dQH = PipedQH(Model, Pipe->Bit);
+	u32 Max = MaxPacket(Pipe);
+	u32 Packets;
+	u32 Index;
+
+	Pipe->dTD = dTD;
+	for (Index = 0U; Index < 7U; Index++) {
+		Pipe->Copy[Index] = DTD_WORD(dTD, Index);
+	}
+	Pipe->Len = (Pipe->Copy[1] & XUSBPS_dTDTOKEN_LEN_MASK) >> 16;
+	Pipe->Filled = 0U;
+	Pipe->Short = 0U;
+	Pipe->End = Host_Now() + Model->FetchNs;
+
+	DQH_WORD(dQH, XUSBPS_dQHCPTR) = (u32)dTD;
+	DQH_WORD(dQH, XUSBPS_dQHdTDNLP) = Pipe->Copy[0];
+	DQH_WORD(dQH, XUSBPS_dQHdTDTOKEN) = Pipe->Copy[1];
+	REG(Model, XUSBPS_CMD_OFFSET) &= ~XUSBPS_CMD_ATDTW_MASK;
+
+	if (Pipe->Bit < 16U) {
+		FillOut(Pipe);
+		return;
+	}
+	/* A zero length dTD still sends one packet */
+	Packets = (Pipe->Len == 0U) ? 1U : ((Pipe->Len + Max - 1U) / Max);
+	for (Index = 0U; Index < Packets; Index++) {
+		Pipe->End = BusPacket(Model, Pipe->End);
+	}
+	Pipe->Busy = 1U;
+	Host_Schedule(Pipe->End, UsbPsRetire, Pipe);
+}
+
+/* Continues with the dTD Link points at or stops the endpoint */
+static void NextdTD(UsbPsModelPipe *Pipe, u32 Link)
+{
+	UINTPTR dTD = (UINTPTR)(Link & XUSBPS_dTDNLP_ADDR_MASK);
+
+	if (((Link & XUSBPS_dTDNLP_T_MASK) != 0U) ||
+	    ((DTD_WORD(dTD, 1) & XUSBPS_dTDTOKEN_ACTIVE_MASK) == 0U)) {
+		StopPipe(Pipe);
+		return;
+	}
+	StartdTD(Pipe, dTD);
+}
+
+static void UsbPsRetire(void *Ref)
+{
+	UsbPsModelPipe *Pipe = Ref;
+	UsbPsModel *Model = Pipe->Model;
+	UINTPTR dQH = PipedQH(Model, Pipe->Bit);
+	u32 Remaining = 0U;
+	u32 Token;
+	u32 Index;
+
+	Pipe->Busy = 0U;
+	/* Only the next link pointer of an active dTD may change */
+	for (Index = 1U; Index < 7U; Index++) {
+		if (DTD_WORD(Pipe->dTD, Index) != Pipe->Copy[Index]) {
+			Model->Violations++;
+			break;
+		}
+	}
+
+	if (Pipe->Bit >= 16U) {
+		CopyBuffer(Pipe, Pipe->Len, 0U);
+		if (Model->In != NULL) {
+			Model->In(Model->HostRef, Pipe->Bit, Pipe->Data, Pipe->Len);
+		}
+		Pipe->Bytes += Pipe->Len;
+	} else {
+		CopyBuffer(Pipe, Pipe->Filled, 1U);
+		Remaining = Pipe->Len - Pipe->Filled;
+		Pipe->Bytes += Pipe->Filled;
+	}
+	Pipe->dTDs++;
+
+	Token = (Pipe->Copy[1] & ~(XUSBPS_dTDTOKEN_ACTIVE_MASK |
+				   XUSBPS_dTDTOKEN_LEN_MASK)) | (Remaining << 16);
+	DTD_WORD(Pipe->dTD, 1) = Token;
+	DQH_WORD(dQH, XUSBPS_dQHdTDTOKEN) = Token;
+	DQH_WORD(dQH, XUSBPS_dQHdTDNLP) = DTD_WORD(Pipe->dTD, 0);
+	REG(Model, XUSBPS_CMD_OFFSET) &= ~XUSBPS_CMD_ATDTW_MASK;
+
+	if ((Token & XUSBPS_dTDTOKEN_IOC_MASK) != 0U) {
+		REG(Model, XUSBPS_EPCOMPL_OFFSET) |= 1U << Pipe->Bit;
+		RaiseUi(Model, XUSBPS_IXR_UI_MASK);
+	}
+	NextdTD(Pipe, DTD_WORD(Pipe->dTD, 0));
+}
+
+static void UsbPsPrime(void *Ref)
+{
+	UsbPsModelPipe *Pipe = Ref;
+	UsbPsModel *Model = Pipe->Model;
+	u32 Link = DQH_WORD(PipedQH(Model, Pipe->Bit), XUSBPS_dQHdTDNLP);
+	UINTPTR dTD = (UINTPTR)(Link & XUSBPS_dTDNLP_ADDR_MASK);
+
+	Model->Primes++;
+	REG(Model, XUSBPS_EPPRIME_OFFSET) &= ~(1U << Pipe->Bit);
+	if (((Link & XUSBPS_dTDNLP_T_MASK) != 0U) ||
+	    ((DTD_WORD(dTD, 1) & XUSBPS_dTDTOKEN_ACTIVE_MASK) == 0U)) {
+		Model->EmptyPrimes++;
+		return;
+	}
+	if (Pipe->Primed == 0U) {
+		Pipe->Primed = Host_Now() + 1U;
+	} else {
+		Pipe->IdleNs += Host_Now() - Pipe->IdleSince;
+	}
+	Pipe->Ready = 1U;
+	REG(Model, XUSBPS_EPRDY_OFFSET) |= 1U << Pipe->Bit;
+	/* The fetch time is charged by StartdTD */
+	StartdTD(Pipe, dTD);
+}
+
+/*****************************************************************************/
+/*
+ * Registers
+ */
+static void Reset(UsbPsModel *Model)
+{
+	u32 Bit;
+
+	for (Bit = 0U; Bit < USBPS_MODEL_PIPES; Bit++) {
+		Host_Cancel(UsbPsPrime, &Model->Pipes[Bit]);
+		StopPipe(&Model->Pipes[Bit]);
+	}
+	Host_Cancel(UsbPsTick, Model);
+	Model->TickScheduled = 0U;
+	Model->IsrPending = 0U;
+	memset(Model->Regs, 0, sizeof(Model->Regs));
+	REG(Model, XUSBPS_CMD_OFFSET) = CMD_RESET_VALUE;
+}
+
+static u32 UsbPsRead(void *Ref, u32 Offset, u32 Size)
+{
+	UsbPsModel *Model = Ref;
+
+	(void)Size;
+	if (Offset == XUSBPS_EPFLUSH_OFFSET) {
+		/* A flush completes at once */
+		return 0U;
+	}
+	return REG(Model, Offset & ~3U);
+}
+
+static void UsbPsWrite(void *Ref, u32 Offset, u32 Value, u32 Size)
+{
+	UsbPsModel *Model = Ref;
+	UsbPsModelPipe *Pipe;
+	u32 Bit;
+
+	(void)Size;
+	Offset &= ~3U;
+	switch (Offset) {
+	case XUSBPS_CMD_OFFSET:
+		if ((Value & XUSBPS_CMD_RST_MASK) != 0U) {
+			Reset(Model);
+			return;
+		}
+		REG(Model, Offset) = Value;
+		break;
+	case XUSBPS_ISR_OFFSET:
+	case XUSBPS_EPSTAT_OFFSET:
+	case XUSBPS_EPCOMPL_OFFSET:
+	case XUSBPS_EPNAKISR_OFFSET:
+		REG(Model, Offset) &= ~Value;
+		break;
+	case XUSBPS_EPRDY_OFFSET:
+		break;
+	case XUSBPS_EPPRIME_OFFSET:
+		for (Bit = 0U; Bit < USBPS_MODEL_PIPES; Bit++) {
+			Pipe = &Model->Pipes[Bit];
+			if (((Value & XUSBPS_EP_ALL_MASK & (1U << Bit)) == 0U) ||
+			    ((REG(Model, Offset) & (1U << Bit)) != 0U)) {
+				continue;
+			}
+			if (Pipe->Ready != 0U) {
+				Model->Violations++;
+				continue;
+			}
+			REG(Model, Offset) |= 1U << Bit;
+			Host_Schedule(Host_Now() + Model->FetchNs, UsbPsPrime, Pipe);
+		}
+		break;
+	case XUSBPS_EPFLUSH_OFFSET:
+		for (Bit = 0U; Bit < USBPS_MODEL_PIPES; Bit++) {
+			if ((Value & XUSBPS_EP_ALL_MASK & (1U << Bit)) != 0U) {
+				Host_Cancel(UsbPsPrime, &Model->Pipes[Bit]);
+				REG(Model, XUSBPS_EPPRIME_OFFSET) &= ~(1U << Bit);
+				StopPipe(&Model->Pipes[Bit]);
+			}
+		}
+		break;
+	default:
+		REG(Model, Offset) = Value;
+		break;
+	}
+}
+
+/*****************************************************************************/
+void UsbPsModel_Init(UsbPsModel *Model, UINTPTR Base, u32 AccessNs,
+		     u32 FetchNs)
+{
+	u32 Bit;
+
+	memset(Model, 0, sizeof(*Model));
+	Model->FetchNs = FetchNs;
+	for (Bit = 0U; Bit < USBPS_MODEL_PIPES; Bit++) {
+		Model->Pipes[Bit].Model = Model;
+		Model->Pipes[Bit].Bit = Bit;
+	}
+	REG(Model, XUSBPS_CMD_OFFSET) = CMD_RESET_VALUE;
+	Model->NextSlot = SlotAt(Host_Now());
+	HostIo_Map(Base, USBPS_MODEL_WINDOW_SIZE, AccessNs, UsbPsRead,
+		   UsbPsWrite, Model);
+}
+
+u32 UsbPsModel_IrqPending(const UsbPsModel *Model)
+{
+	return IrqLine(Model);
+}
+
+/* Resumes OUT pipes waiting for host data */
+void UsbPsModel_Kick(UsbPsModel *Model)
+{
+	u32 Bit;
+
+	for (Bit = 0U; Bit < 16U; Bit++) {
+		if (Model->Pipes[Bit].Waiting != 0U) {
+			if (Model->Pipes[Bit].End < Host_Now()) {
+				Model->Pipes[Bit].End = Host_Now();
+			}
+			FillOut(&Model->Pipes[Bit]);
+		}
+	}
+}
+
+/* The host resets the bus, the driver has to flush the endpoints */
+void UsbPsModel_BusReset(UsbPsModel *Model)
+{
+	/* The port stays in reset while the driver handles UR */
+	REG(Model, XUSBPS_PORTSCR1_OFFSET) |= XUSBPS_PORTSCR_PR_MASK;
+	RaiseIsr(Model, XUSBPS_IXR_UR_MASK);
+}
+
+/* Time the endpoint was not ready since it was first primed */
+u64 UsbPsModel_IdleNs(UsbPsModel *Model, u32 Bit)
+{
+	UsbPsModelPipe *Pipe = &Model->Pipes[Bit];
+
+	if (Pipe->Primed == 0U) {
+		return 0U;
+	}
+	return Pipe->IdleNs + ((Pipe->Ready == 0U) ?
+			       (Host_Now() - Pipe->IdleSince) : 0U);
+}
@@ -0,0 +1,130 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file usbps_model.h
+*
+* Model of the device mode of the PS USB controller for the host builds,
+* covering what the usbps driver uses for bulk transfers.
+*
+* - Registers: CMD (RS, RST, ATDTW, ITC), ISR, IER, EPLISTADDR, EPSTAT,
+*   EPPRIME, EPFLUSH, EPRDY and EPCOMPL. Other registers read back what
+*   was written. A bus reset raises UR with the port reset bit of
+*   PORTSCR1 set.
+* - A prime reads the dQH of the endpoint from EPLISTADDR and starts on
+*   the dTD its next link pointer names. A dTD is copied when it is
+*   fetched and written back (Active cleared, remaining length) when it
+*   retires, the dQH overlay follows. The controller stops at a dTD with
+*   the terminate bit in its predecessor or with Active clear, which is
+*   what the driver's inactive terminator relies on, and clears ATDTW
+*   whenever it retires or fetches a dTD.
+* - The high speed bus carries one packet per slot, 13 slots of
+*   512 bytes per 125 us microframe, the bulk limit of USB 2.0 shared by
+*   all endpoints. An IN dTD is sent in packets of the dQH max packet
+*   length, an OUT dTD takes packets from the host source until it is
+*   full or a short packet ends it. A packet waits for the first slot
+*   after its dTD is fetched, the slot before it went to a NAK.
+* - UI is raised when a dTD with IOC retires and reaches ISR at the next
+*   interrupt threshold boundary (CMD ITC, in microframes, 8 after reset
+*   as in EHCI).
+* - Driver errors are counted in Violations: a prime of a ready endpoint
+*   and a change to the token or buffer pointers of a dTD the controller
+*   owns.
+*
+* Parameters the hardware documents do not give, the register access
+* time and the dTD fetch time, are passed to UsbPsModel_Init by the
+* test. Results are statements about those parameters.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef USBPS_MODEL_H
+#define USBPS_MODEL_H
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define USBPS_MODEL_WINDOW_SIZE	0x1000U
+#define USBPS_MODEL_PIPES	32U	/* EPPRIME bit positions */
+#define USBPS_MODEL_UFRAME_NS	125000U
+#define USBPS_MODEL_UFRAME_SLOTS 13U
+#define USBPS_MODEL_DTD_MAX	(5U * 4096U)
+#define USBPS_MODEL_NO_DATA	0xFFFFFFFFU
+
+/*
+ * Host side of an OUT pipe: fills Buf with the next packet of at most
+ * MaxPacket bytes and returns its length, or USBPS_MODEL_NO_DATA if the
+ * host has nothing to send yet (UsbPsModel_Kick resumes the pipe)
+ */
+typedef u32 (*UsbPsModelOut)(void *Ref, u32 Pipe, u8 *Buf, u32 MaxPacket);
+/* Host side of an IN pipe: the data of one retired dTD */
+typedef void (*UsbPsModelIn)(void *Ref, u32 Pipe, const u8 *Buf, u32 Len);
+
+typedef struct UsbPsModel UsbPsModel;
+
+typedef struct {
+	UsbPsModel *Model;
+	u32 Bit;		/* Position in EPPRIME/EPRDY/EPCOMPL */
+	u32 Ready;
+	u32 Busy;		/* A retire event is scheduled */
+	u32 Waiting;		/* OUT dTD waits for host data */
+	UINTPTR dTD;		/* dTD being worked on */
+	u32 Copy[7];		/* Its NLP, token and buffer pointers */
+	u32 Len;		/* dTD length */
+	u32 Filled;		/* OUT bytes taken from the host */
+	u64 End;		/* End of the last packet */
+	u32 Short;		/* OUT ended by a short packet */
+	u8 Data[USBPS_MODEL_DTD_MAX];
+	u64 IdleSince;		/* Time EPRDY last went to 0 */
+	u64 IdleNs;		/* Time with EPRDY 0 since the first prime */
+	u64 Primed;		/* Time of the first prime, 0 if never */
+	u64 Bytes;
+	u64 dTDs;
+} UsbPsModelPipe;
+
+struct UsbPsModel {
+	u32 FetchNs;		/* Prime or dTD fetch to first packet */
+	UsbPsModelOut Out;
+	UsbPsModelIn In;
+	void *HostRef;
+
+	u32 Regs[USBPS_MODEL_WINDOW_SIZE / 4U];
+	u32 IsrPending;		/* UI/UE waiting for the ITC boundary */
+	u32 TickScheduled;
+	u64 NextSlot;		/* First free bus slot */
+	UsbPsModelPipe Pipes[USBPS_MODEL_PIPES];
+
+	/* Statistics */
+	u64 Slots;		/* Bus slots used */
+	u64 Primes;
+	u64 EmptyPrimes;	/* Primes that found no active dTD */
+	u64 Interrupts;		/* Rising edges of the interrupt line */
+	u64 Violations;
+};
+
+void UsbPsModel_Init(UsbPsModel *Model, UINTPTR Base, u32 AccessNs,
+		     u32 FetchNs);
+u32 UsbPsModel_IrqPending(const UsbPsModel *Model);
+void UsbPsModel_Kick(UsbPsModel *Model);
+void UsbPsModel_BusReset(UsbPsModel *Model);
+u64 UsbPsModel_IdleNs(UsbPsModel *Model, u32 Bit);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* USBPS_MODEL_H */
@@ -0,0 +1,493 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xadcps_model.c
+*
+* PS-XADC interface and sequencer model, see xadcps_model.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <string.h>
+
+#include "host.h"
+#include "xadcps.h"
+#include "xadcps_hw.h"
+#include "xadcps_model.h"
+
+#define NO_PASS		0xFFFFFFFFFFFFFFFFULL
+#define CAL_SLOT	0xFFU
+#define RAW_MASK	0xFFF0U	/* 12 bit results and thresholds */
+#define OT_DEFAULT	125.0f	/* Over temperature limit without ENB */
+
+static void XAdcPsCmdDone(void *Ref);
+
+/*****************************************************************************/
+/*
+ * Interrupts
+ */
+static u32 IrqLine(const XAdcPsModel *Model)
+{
+	return ((Model->IntSts & ~Model->IntMask & XADCPS_INTX_ALL_MASK) !=
+		0U) ? 1U : 0U;
+}
+
+static void SetStatus(XAdcPsModel *Model, u32 Bits)
+{
+	u32 Before = IrqLine(Model);
+
+	Model->IntSts |= Bits;
+	if ((Before == 0U) && (IrqLine(Model) != 0U)) {
+		Model->Interrupts++;
+	}
+}
+
+/*****************************************************************************/
+/*
+ * Alarms, ALM0 to ALM6 in bits 0 to 6 of MSTS and INT_STS, OT in bit 7
+ */
+static const struct {
+	u8 Channel;
+	u8 Upper;
+	u8 Lower;
+	u16 Disable;		/* CFR1 */
+} Alarms[] = {
+	{ XADCPS_CH_TEMP, XADCPS_ATR_TEMP_UPPER_OFFSET,
+	  XADCPS_ATR_TEMP_LOWER_OFFSET, XADCPS_CFR1_ALM_TEMP_MASK },
+	{ XADCPS_CH_VCCINT, XADCPS_ATR_VCCINT_UPPER_OFFSET,
+	  XADCPS_ATR_VCCINT_LOWER_OFFSET, XADCPS_CFR1_ALM_VCCINT_MASK },
+	{ XADCPS_CH_VCCAUX, XADCPS_ATR_VCCAUX_UPPER_OFFSET,
+	  XADCPS_ATR_VCCAUX_LOWER_OFFSET, XADCPS_CFR1_ALM_VCCAUX_MASK },
+	{ XADCPS_CH_VBRAM, XADCPS_ATR_VBRAM_UPPER_OFFSET,
+	  XADCPS_ATR_VBRAM_LOWER_OFFSET, XADCPS_CFR1_ALM_VBRAM_MASK },
+	{ XADCPS_CH_VCCPINT, XADCPS_ATR_VCCPINT_UPPER_OFFSET,
+	  XADCPS_ATR_VCCPINT_LOWER_OFFSET, XADCPS_CFR1_ALM_VCCPINT_MASK },
+	{ XADCPS_CH_VCCPAUX, XADCPS_ATR_VCCPAUX_UPPER_OFFSET,
+	  XADCPS_ATR_VCCPAUX_LOWER_OFFSET, XADCPS_CFR1_ALM_VCCPAUX_MASK },
+	{ XADCPS_CH_VCCPDRO, XADCPS_ATR_VCCPDRO_UPPER_OFFSET,
+	  XADCPS_ATR_VCCPDRO_LOWER_OFFSET, XADCPS_CFR1_ALM_VCCPDRO_MASK },
+};
+
+/*
+ * Hysteresis for the temperatures: set above the upper threshold, cleared
+ * below the lower one. A window for the supplies.
+ */
+static u32 Compare(u32 Active, u32 Value, u32 Upper, u32 Lower, u32 Window)
+{
+	if (Value > Upper) {
+		return 1U;
+	}
+	if (Value < Lower) {
+		return (Window != 0U) ? 1U : 0U;
+	}
+	return (Window != 0U) ? 0U : Active;
+}
+
+static void EvalAlarms(XAdcPsModel *Model)
+{
+	u32 Cfr1 = Model->Drp[XADCPS_CFR1_OFFSET];
+	u32 OtUpper = Model->Drp[XADCPS_ATR_OT_UPPER_OFFSET];
+	u32 Out = 0U;
+	u32 Index;
+	u32 Bit;
+
+	for (Index = 0U; Index < (sizeof(Alarms) / sizeof(Alarms[0])); Index++) {
+		Bit = 1U << Index;
+		if ((Cfr1 & Alarms[Index].Disable) == 0U) {
+			Out |= Compare(Model->AlarmOut & Bit,
+				       Model->Drp[Alarms[Index].Channel] & RAW_MASK,
+				       Model->Drp[Alarms[Index].Upper] & RAW_MASK,
+				       Model->Drp[Alarms[Index].Lower] & RAW_MASK,
+				       (Index != 0U) ? 1U : 0U) << Index;
+		}
+	}
+	if ((OtUpper & XADCPS_ATR_OT_UPPER_ENB_MASK) !=
+	    XADCPS_ATR_OT_UPPER_ENB_VAL) {
+		OtUpper = (u32)XAdcPs_TemperatureToRaw(OT_DEFAULT);
+	}
+	if ((Cfr1 & XADCPS_CFR1_OT_MASK) == 0U) {
+		Out |= Compare((Model->AlarmOut & XADCPS_MSTS_OT_MASK) >> 7,
+			       Model->Drp[XADCPS_CH_TEMP] & RAW_MASK,
+			       OtUpper & RAW_MASK,
+			       Model->Drp[XADCPS_ATR_OT_LOWER_OFFSET] & RAW_MASK,
+			       0U) << 7;
+	}
+	SetStatus(Model, Out & ~Model->AlarmOut);
+	Model->AlarmOut = Out;
+}
+
+/*****************************************************************************/
+/*
+ * Sequencer
+ */
+static s32 SeqSlot(const XAdcPsModel *Model, u32 Channel)
+{
+	u32 Slot;
+
+	for (Slot = 0U; Slot < Model->SeqCount; Slot++) {
+		if (Model->SeqChannel[Slot] == Channel) {
+			return (s32)Slot;
+		}
+	}
+	return -1;
+}
+
+/*
+ * Value of the status register of Channel at the current time and the
+ * last pass it reflects, NO_PASS if the sequencer has not updated it
+ */
+static u16 SeqValue(XAdcPsModel *Model, u32 Channel, u64 *PassPtr)
+{
+	s32 Slot = SeqSlot(Model, Channel);
+	u64 PassNs = (u64)Model->SeqCount * Model->ConvNs;
+	u64 Done = Host_Now() - Model->SeqStart;
+	u64 First = ((u64)Slot + 1U) * Model->ConvNs;
+	u64 Pass;
+	u64 Sum;
+	u64 Index;
+
+	*PassPtr = NO_PASS;
+	if ((Slot < 0) || (Done < First)) {
+		return Model->Drp[Channel];
+	}
+	Pass = (Done - First) / PassNs;
+	if ((Model->SeqAvg & (1U << (u32)Slot)) == 0U) {
+		*PassPtr = Pass;
+		return Model->Source(Model->SourceRef, Channel, Pass);
+	}
+
+	if ((Pass + 1U) < Model->AvgPasses) {
+		return Model->Drp[Channel];
+	}
+	Pass = (((Pass + 1U) / Model->AvgPasses) * Model->AvgPasses) - 1U;
+	Sum = 0U;
+	for (Index = 0U; Index < Model->AvgPasses; Index++) {
+		Sum += Model->Source(Model->SourceRef, Channel, Pass - Index);
+	}
+	*PassPtr = Pass;
+	return (u16)(Sum / Model->AvgPasses);
+}
+
+/* The status registers keep the last results when the sequencer stops */
+static void SeqStop(XAdcPsModel *Model)
+{
+	u64 Pass;
+	u32 Slot;
+	u32 Channel;
+
+	for (Slot = 0U; Slot < Model->SeqCount; Slot++) {
+		Channel = Model->SeqChannel[Slot];
+		if (Channel != CAL_SLOT) {
+			Model->Drp[Channel] = SeqValue(Model, Channel, &Pass);
+		}
+	}
+	Model->SeqCount = 0U;
+}
+
+static void SeqStart(XAdcPsModel *Model)
+{
+	static const u32 AvgPasses[] = { 1U, 16U, 64U, 256U };
+	u32 Enables = (u32)Model->Drp[XADCPS_SEQ00_OFFSET] |
+		      ((u32)Model->Drp[XADCPS_SEQ01_OFFSET] << 16);
+	u32 Averaged = (u32)Model->Drp[XADCPS_SEQ02_OFFSET] |
+		       ((u32)Model->Drp[XADCPS_SEQ03_OFFSET] << 16);
+	u32 Bit;
+	u32 Channel;
+
+	Model->SeqCount = 0U;
+	Model->SeqAvg = 0U;
+	Model->AvgPasses = AvgPasses[(Model->Drp[XADCPS_CFR0_OFFSET] &
+				      XADCPS_CFR0_AVG_VALID_MASK) >>
+				     XADCPS_CFR0_AVG_SHIFT];
+	for (Bit = 0U; Bit < 32U; Bit++) {
+		if ((Enables & (1U << Bit)) == 0U) {
+			continue;
+		}
+		if (Bit == 0U) {
+			Channel = CAL_SLOT;
+		} else if ((Bit >= 5U) && (Bit <= 7U)) {
+			Channel = XADCPS_CH_VCCPINT + Bit - 5U;
+		} else if ((Bit >= 8U) && (Bit <= 14U)) {
+			Channel = XADCPS_CH_TEMP + Bit - 8U;
+		} else if (Bit >= 16U) {
+			Channel = Bit;
+		} else {
+			continue;
+		}
+		if (((Averaged & (1U << Bit)) != 0U) && (Model->AvgPasses > 1U)) {
+			Model->SeqAvg |= 1U << Model->SeqCount;
+		}
+		Model->SeqChannel[Model->SeqCount++] = (u8)Channel;
+	}
+	Model->SeqStart = Host_Now();
+}
+
+/*****************************************************************************/
+/*
+ * DRP registers
+ */
+static u32 IsStatus(u32 Reg)
+{
+	return ((Reg <= XADCPS_VBRAM_OFFSET) ||
+		((Reg >= XADCPS_VCCPINT_OFFSET) &&
+		 (Reg <= XADCPS_AUX15_OFFSET))) ? 1U : 0U;
+}
+
+static u16 DrpRead(XAdcPsModel *Model, u32 Reg)
+{
+	u64 Pass;
+	u16 Value;
+
+	if ((IsStatus(Reg) == 0U) || (Model->SeqCount == 0U)) {
+		return Model->Drp[Reg];
+	}
+	Value = SeqValue(Model, Reg, &Pass);
+	Model->StatusReads++;
+	if ((Pass != NO_PASS) && ((Model->LastPass[Reg] == NO_PASS) ||
+				  (Pass > Model->LastPass[Reg]))) {
+		Model->FreshReads++;
+		Model->LastPass[Reg] = Pass;
+	}
+	return Value;
+}
+
+static void DrpWrite(XAdcPsModel *Model, u32 Reg, u16 Value)
+{
+	if (IsStatus(Reg) != 0U) {
+		return;
+	}
+	Model->Drp[Reg] = Value;
+	if (Reg == XADCPS_CFR1_OFFSET) {
+		SeqStop(Model);
+		if (((Value & XADCPS_CFR1_SEQ_VALID_MASK) >>
+		     XADCPS_CFR1_SEQ_SHIFT) == XADCPS_SEQ_MODE_CONTINPASS) {
+			SeqStart(Model);
+		}
+	}
+	if ((Reg == XADCPS_CFR1_OFFSET) ||
+	    ((Reg >= XADCPS_ATR_TEMP_UPPER_OFFSET) &&
+	     (Reg <= XADCPS_ATR_VCCPDRO_LOWER_OFFSET))) {
+		EvalAlarms(Model);
+	}
+}
+
+/*****************************************************************************/
+/*
+ * Interface
+ */
+static u32 Running(const XAdcPsModel *Model)
+{
+	return (((Model->Cfg & XADCPS_CFG_ENABLE_MASK) != 0U) &&
+		((Model->Mctl & XADCPS_MCTL_RESET_MASK) == 0U)) ? 1U : 0U;
+}
+
+static void StartNext(XAdcPsModel *Model)
+{
+	u32 Threshold = (Model->Cfg & XADCPS_CFG_CFIFOTH_MASK) >> 20;
+
+	if ((Model->Busy != 0U) || (Model->CmdLevel == 0U) ||
+	    (Running(Model) == 0U) ||
+	    (Model->DataLevel == XADCPS_FIFO_DEPTH)) {
+		return;
+	}
+	Model->Current = Model->Cmd[Model->CmdHead];
+	Model->CmdHead = (Model->CmdHead + 1U) % 16U;
+	Model->CmdLevel--;
+	Model->Busy = 1U;
+	if (Model->CmdLevel < Threshold) {
+		SetStatus(Model, XADCPS_INTX_CFIFO_LTH_MASK);
+	}
+	Model->DoneAt = Host_Now() + Model->CmdNs;
+	Host_Schedule(Model->DoneAt, XAdcPsCmdDone, Model);
+}
+
+static void XAdcPsCmdDone(void *Ref)
+{
+	XAdcPsModel *Model = Ref;
+	u32 Cmd = Model->Current;
+	u32 Reg = ((Cmd & XADCPS_JTAG_ADDR_MASK) >> XADCPS_JTAG_ADDR_SHIFT) %
+		  XADCPS_MODEL_DRP_REGS;
+	u32 Threshold = (Model->Cfg & XADCPS_CFG_DFIFOTH_MASK) >>
+			XADCPS_CFG_DFIFOTH_SHIFT;
+
+	Model->Busy = 0U;
+	Model->Commands++;
+	Model->Data[(Model->DataHead + Model->DataLevel) % 16U] = Model->Result;
+	Model->DataLevel++;
+	if (Model->DataLevel > Threshold) {
+		SetStatus(Model, XADCPS_INTX_DFIFO_GTH_MASK);
+	}
+
+	switch (Cmd & XADCPS_JTAG_CMD_MASK) {
+	case XADCPS_JTAG_CMD_READ_MASK:
+		Model->Result = DrpRead(Model, Reg);
+		break;
+	case XADCPS_JTAG_CMD_WRITE_MASK:
+		DrpWrite(Model, Reg, (u16)(Cmd & XADCPS_JTAG_DATA_MASK));
+		Model->Result = 0U;
+		break;
+	default:
+		Model->Result = 0U;
+		break;
+	}
+	StartNext(Model);
+}
+
+static void Flush(XAdcPsModel *Model)
+{
+	Host_Cancel(XAdcPsCmdDone, Model);
+	Model->Busy = 0U;
+	Model->CmdLevel = 0U;
+	Model->DataLevel = 0U;
+	Model->Result = 0U;
+}
+
+static u32 ReadData(XAdcPsModel *Model)
+{
+	u64 Start = Host_Now();
+	u32 Value;
+
+	if (Model->DataLevel == 0U) {
+		if (Model->Busy == 0U) {
+			Model->Violations++;
+			return 0U;
+		}
+		while ((Model->DataLevel == 0U) && (Model->Busy != 0U)) {
+			Host_AdvanceTo(Model->DoneAt);
+		}
+		Model->Stalls++;
+		Model->StallNs += Host_Now() - Start;
+	}
+	Value = Model->Data[Model->DataHead];
+	Model->DataHead = (Model->DataHead + 1U) % 16U;
+	Model->DataLevel--;
+	StartNext(Model);
+	return Value;
+}
+
+static u32 XAdcPsRead(void *Ref, u32 Offset, u32 Size)
+{
+	XAdcPsModel *Model = Ref;
+	u32 Value;
+
+	(void)Size;
+	switch (Offset) {
+	case XADCPS_CFG_OFFSET:
+		return Model->Cfg;
+	case XADCPS_INT_STS_OFFSET:
+		return Model->IntSts;
+	case XADCPS_INT_MASK_OFFSET:
+		return Model->IntMask;
+	case XADCPS_MSTS_OFFSET:
+		Value = (Model->CmdLevel << 16) |
+			(Model->DataLevel << XADCPS_MSTS_DFIFO_LVL_SHIFT);
+		Value |= (Model->CmdLevel == XADCPS_FIFO_DEPTH) ?
+			 XADCPS_MSTS_CFIFOF_MASK : 0U;
+		Value |= (Model->CmdLevel == 0U) ? XADCPS_MSTS_CFIFOE_MASK : 0U;
+		Value |= (Model->DataLevel == XADCPS_FIFO_DEPTH) ?
+			 XADCPS_MSTS_DFIFOF_MASK : 0U;
+		Value |= (Model->DataLevel == 0U) ? XADCPS_MSTS_DFIFOE_MASK : 0U;
+		return Value | Model->AlarmOut;
+	case XADCPS_RDFIFO_OFFSET:
+		return ReadData(Model);
+	case XADCPS_MCTL_OFFSET:
+		return Model->Mctl;
+	default:
+		return 0U;
+	}
+}
+
+static void XAdcPsWrite(void *Ref, u32 Offset, u32 Value, u32 Size)
+{
+	XAdcPsModel *Model = Ref;
+	u32 Before;
+
+	(void)Size;
+	switch (Offset) {
+	case XADCPS_CFG_OFFSET:
+		Model->Cfg = Value;
+		StartNext(Model);
+		break;
+	case XADCPS_INT_STS_OFFSET:
+		Model->IntSts &= ~Value;
+		break;
+	case XADCPS_INT_MASK_OFFSET:
+		Before = IrqLine(Model);
+		Model->IntMask = Value;
+		if ((Before == 0U) && (IrqLine(Model) != 0U)) {
+			Model->Interrupts++;
+		}
+		break;
+	case XADCPS_CMDFIFO_OFFSET:
+		if (Model->CmdLevel == XADCPS_FIFO_DEPTH) {
+			Model->Violations++;
+			break;
+		}
+		Model->Cmd[(Model->CmdHead + Model->CmdLevel) % 16U] = Value;
+		Model->CmdLevel++;
+		StartNext(Model);
+		break;
+	case XADCPS_MCTL_OFFSET:
+		if ((Value & XADCPS_MCTL_FLUSH_MASK) != 0U) {
+			Flush(Model);
+		}
+		Model->Mctl = Value;
+		StartNext(Model);
+		break;
+	default:
+		/* UNLK and the read only registers */
+		break;
+	}
+}
+
+/*****************************************************************************/
+void XAdcPsModel_Init(XAdcPsModel *Model, UINTPTR Base, u32 AccessNs,
+		      u32 CmdNs, u32 ConvNs)
+{
+	memset(Model, 0, sizeof(*Model));
+	memset(Model->LastPass, 0xFF, sizeof(Model->LastPass));
+	Model->AccessNs = AccessNs;
+	Model->CmdNs = CmdNs;
+	Model->ConvNs = ConvNs;
+	Model->IntMask = XADCPS_INTX_ALL_MASK;
+	Model->Mctl = XADCPS_MCTL_RESET_MASK;
+	HostIo_Map(Base, XADCPS_MODEL_WINDOW_SIZE, AccessNs, XAdcPsRead,
+		   XAdcPsWrite, Model);
+}
+
+u32 XAdcPsModel_IrqPending(const XAdcPsModel *Model)
+{
+	return IrqLine(Model);
+}
+
+/*
+ * A conversion of the default sequence: the status register of an on chip
+ * sensor takes Raw and the alarms are evaluated
+ */
+void XAdcPsModel_SetInput(XAdcPsModel *Model, u32 Channel, u16 Raw)
+{
+	Model->Drp[Channel] = Raw;
+	EvalAlarms(Model);
+}
+
+/* Current value of a channel status register and the pass it holds */
+u16 XAdcPsModel_Status(XAdcPsModel *Model, u32 Channel, u64 *PassPtr)
+{
+	*PassPtr = NO_PASS;
+	if (Model->SeqCount == 0U) {
+		return Model->Drp[Channel];
+	}
+	return SeqValue(Model, Channel, PassPtr);
+}
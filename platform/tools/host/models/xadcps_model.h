@@ -0,0 +1,132 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xadcps_model.h
+*
+* Model of the PS-XADC interface and of the XADC channel sequencer for the
+* host builds, covering what the xadcps driver and its sampling engine use.
+*
+* - Registers: CFG, INT_STS (write 1 to clear), INT_MASK, MSTS, CMDFIFO,
+*   RDFIFO and MCTL. Both FIFOs hold XADCPS_FIFO_DEPTH words, MCTL FLUSH
+*   empties them and drops the command on the interface.
+* - Commands leave the command FIFO one at a time while CFG ENABLE is set
+*   and MCTL RESET is clear, each one occupies the serial interface for
+*   the command time. A finished command pushes one word into the data
+*   FIFO, the DRP result of the command before it (0 after a flush),
+*   data in bits 15:0 and the upper bits clear. A command only starts when
+*   the data FIFO has room for its word.
+* - A read of RDFIFO while the data FIFO is empty stalls the bus until
+*   the next word arrives. With no command left to produce one the read
+*   returns 0 and counts a Violation, as does a write to a full command
+*   FIFO.
+* - DFIFO_GTH is set by a push that leaves the data FIFO level above the
+*   CFG threshold, CFIFO_LTH when a command leaves the command FIFO below
+*   its threshold. The interrupt line is INT_STS & ~INT_MASK, all masked
+*   after reset.
+* - Alarms: OT and ALM0 (temperature) are set above the upper threshold
+*   and cleared below the lower one, ALM1 to ALM6 are set while their
+*   supply is outside the window. The OT upper threshold is 125 C until
+*   it is written with the enable code. An alarm disabled in CFR1 is
+*   clear. The outputs are live in MSTS bits 7:0, a rising edge sets the
+*   same bit in INT_STS. Alarms are evaluated when a threshold or CFR1 is
+*   written and when the test sets a sensor with XAdcPsModel_SetInput,
+*   which stands for a conversion of the default sequence, not when the
+*   continuous sequencer converts.
+* - DRP registers: writes are stored. In continuous sequence mode (CFR1)
+*   the sequencer converts the channels enabled in SEQ00/SEQ01 in bit
+*   order, calibration included, one conversion time each, and the status
+*   register of a channel takes the value of its last conversion. A
+*   channel with averaging enabled (SEQ02/SEQ03, CFR0 AVG) is updated
+*   every 16, 64 or 256 passes with the mean of those passes. The values
+*   come from the Source callback of the test. Other status registers
+*   read 0.
+*
+* The register access time, the interface time per command and the
+* conversion time are parameters of XAdcPsModel_Init. The hardware
+* documents give the conversion rate but not the first two, results are
+* statements about the values the test passes.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef XADCPS_MODEL_H
+#define XADCPS_MODEL_H
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define XADCPS_MODEL_WINDOW_SIZE	0x40U	/* Up to UNLK at 0x34 */
+#define XADCPS_MODEL_DRP_REGS		0x80U
+#define XADCPS_MODEL_SEQ_MAX		32U
+
+/* Raw value of conversion number Pass of a channel (XADCPS_CH_*) */
+typedef u16 (*XAdcPsModelSource)(void *Ref, u32 Channel, u64 Pass);
+
+typedef struct {
+	u32 AccessNs;
+	u32 CmdNs;		/* Interface time per command */
+	u32 ConvNs;		/* Time per conversion */
+	XAdcPsModelSource Source;
+	void *SourceRef;
+
+	u32 Cfg;
+	u32 IntSts;
+	u32 IntMask;
+	u32 Mctl;
+	u32 Cmd[16];		/* Command FIFO ring */
+	u32 CmdHead;
+	u32 CmdLevel;
+	u32 Data[16];		/* Data FIFO ring */
+	u32 DataHead;
+	u32 DataLevel;
+	u32 Busy;		/* A command is on the interface */
+	u32 Current;		/* That command */
+	u64 DoneAt;		/* Its end */
+	u32 Result;		/* DRP result of the last finished command */
+	u16 Drp[XADCPS_MODEL_DRP_REGS];
+	u32 AlarmOut;		/* MSTS OT and ALM bits */
+
+	/* Sequencer, running since SeqStart when SeqCount != 0 */
+	u64 SeqStart;
+	u32 SeqCount;		/* Conversions per pass */
+	u8  SeqChannel[XADCPS_MODEL_SEQ_MAX]; /* 0xFF for calibration */
+	u32 SeqAvg;		/* Bit mask over SeqChannel of averaged ones */
+	u32 AvgPasses;
+	u64 LastPass[XADCPS_MODEL_DRP_REGS]; /* Pass of the last read */
+
+	/* Statistics */
+	u64 Commands;
+	u64 StatusReads;	/* Read commands of channel status registers */
+	u64 FreshReads;		/* Of those, with a newer result than before */
+	u64 Stalls;		/* RDFIFO reads that waited */
+	u64 StallNs;
+	u64 Interrupts;		/* Rising edges of the interrupt line */
+	u64 Violations;
+} XAdcPsModel;
+
+void XAdcPsModel_Init(XAdcPsModel *Model, UINTPTR Base, u32 AccessNs,
+		      u32 CmdNs, u32 ConvNs);
+u32 XAdcPsModel_IrqPending(const XAdcPsModel *Model);
+u16 XAdcPsModel_Status(XAdcPsModel *Model, u32 Channel, u64 *PassPtr);
+void XAdcPsModel_SetInput(XAdcPsModel *Model, u32 Channel, u16 Raw);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XADCPS_MODEL_H */
@@ -0,0 +1,293 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file test_dmapool.c
+*
+* Tests xil_dmapool.c on top of the 4 KB page support of xil_mmu.c.
+*
+* - The arena pages get the DMA attributes, a non-cacheable arena is
+*   reported coherent and an ACP arena is not.
+* - Random allocations and frees of 1 byte to 16 KB: every buffer is
+*   aligned to its class (at most 4 KB), lies in the arena, does not
+*   overlap a live buffer and keeps its contents until it is freed.
+* - The statistics match the live buffers, exhaustion and bad sizes fail
+*   and are counted, frees of foreign or misaligned pointers are ignored.
+* - Every call leaves the CPSR interrupt mask as it found it.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "host.h"
+#include "xil_dmapool.h"
+#include "xil_mmu.h"
+#include "xpseudo_asm.h"
+#include "xstatus.h"
+
+#define ARENA_PAGES	64U
+#define ARENA_SIZE	(ARENA_PAGES * XIL_MMU_PAGE_SIZE)
+#define LIVE_MAX	512U
+#define RANDOM_OPS	200000U
+
+u32 MMUTable[4096] __attribute__ ((aligned(16384)));
+
+/* Defined in xil_cache.c, whose maintenance host_rt.c replaces */
+UINTPTR XilDmaPoolCoherentBase;
+u32 XilDmaPoolCoherentSize;
+
+typedef struct {
+	u8 *Buf;
+	u32 Size;
+	u32 Class;
+	u8 Fill;
+} Live;
+
+static Live Lives[LIVE_MAX];
+static u32 LiveCount;
+static u8 *Arena;
+static u32 Seed = 11U;
+
+static u32 Rand(void)
+{
+	Seed = Seed * 1103515245U + 12345U;
+	return Seed >> 8;
+}
+
+static u32 ClassOf(u32 Size)
+{
+	u32 Class = 0U;
+
+	while ((XIL_DMAPOOL_MIN_SIZE << Class) < Size) {
+		Class++;
+	}
+	return Class;
+}
+
+static u32 PageDesc(UINTPTR Addr)
+{
+	u32 L1 = MMUTable[Addr >> 20];
+	u32 *L2;
+
+	/* A section is compared as the page it would be split into */
+	if ((L1 & XIL_MMU_SECT_TYPE_MASK) != XIL_MMU_SECT_COARSE) {
+		return Xil_MmuPageDescriptor((L1 & XIL_MMU_SECT_BASE_MASK) |
+					     ((u32)Addr & 0xFF000U), L1);
+	}
+	L2 = (u32 *)(UINTPTR)(L1 & XIL_MMU_COARSE_BASE_MASK);
+	return L2[(Addr >> 12) & 0xFFU];
+}
+
+static void CheckArena(UINTPTR Base, u32 Size, u32 attrib)
+{
+	UINTPTR Addr;
+
+	for (Addr = Base; Addr < (Base + Size); Addr += XIL_MMU_PAGE_SIZE) {
+		HOST_CHECK_EQ(PageDesc(Addr), Xil_MmuPageDescriptor((u32)Addr, attrib));
+	}
+}
+
+static void CheckStats(void)
+{
+	Xil_DmaPoolStats Stats;
+	u32 InUse[XIL_DMAPOOL_CLASSES];
+	u32 Pages = 0U;
+	u32 Index;
+
+	memset(InUse, 0, sizeof(InUse));
+	for (Index = 0U; Index < LiveCount; Index++) {
+		InUse[Lives[Index].Class]++;
+	}
+	Xil_DmaPoolGetStats(&Stats);
+	for (Index = 0U; Index < XIL_DMAPOOL_CLASSES; Index++) {
+		HOST_CHECK_EQ(Stats.InUse[Index], InUse[Index]);
+		HOST_CHECK(Stats.Peak[Index] >= InUse[Index]);
+		Pages += Stats.Pages[Index];
+	}
+	HOST_CHECK_EQ(Stats.Allocs - Stats.Frees, LiveCount);
+	HOST_CHECK_EQ(Pages + Stats.PagesFree, Stats.PagesTotal);
+}
+
+static void FreeLive(u32 Index)
+{
+	Live *L = &Lives[Index];
+	u32 Byte;
+	u32 Bad = 0U;
+
+	for (Byte = 0U; Byte < L->Size; Byte++) {
+		if (L->Buf[Byte] != L->Fill) {
+			Bad++;
+		}
+	}
+	HOST_CHECK_EQ(Bad, 0U);
+	Xil_DmaPoolFree(L->Buf);
+	*L = Lives[--LiveCount];
+}
+
+static void AllocLive(u32 Size)
+{
+	Live *L = &Lives[LiveCount];
+	u32 Align;
+	u32 Index;
+	u8 *Buf;
+
+	Buf = Xil_DmaPoolAlloc(Size);
+	if (Buf == NULL) {
+		return;
+	}
+	L->Class = ClassOf(Size);
+	Align = XIL_DMAPOOL_MIN_SIZE << L->Class;
+	if (Align > XIL_MMU_PAGE_SIZE) {
+		Align = XIL_MMU_PAGE_SIZE;
+	}
+	HOST_CHECK_EQ((UINTPTR)Buf & (Align - 1U), 0U);
+	HOST_CHECK((Buf >= Arena) &&
+		   ((Buf + (XIL_DMAPOOL_MIN_SIZE << L->Class)) <= (Arena + ARENA_SIZE)));
+	HOST_CHECK_EQ(Xil_DmaPoolIsCoherent((UINTPTR)Buf), 1U);
+	for (Index = 0U; Index < LiveCount; Index++) {
+		HOST_CHECK((Buf + Size <= Lives[Index].Buf) ||
+			   (Lives[Index].Buf + Lives[Index].Size <= Buf));
+	}
+	L->Buf = Buf;
+	L->Size = Size;
+	L->Fill = (u8)Rand();
+	memset(Buf, L->Fill, Size);
+	LiveCount++;
+}
+
+static void TestRandom(void)
+{
+	Xil_DmaPoolStats Stats;
+	u32 Op;
+	u32 Size;
+
+	for (Op = 0U; Op < RANDOM_OPS; Op++) {
+		if ((LiveCount != 0U) &&
+		    ((LiveCount == LIVE_MAX) || ((Rand() % 2U) == 0U))) {
+			FreeLive(Rand() % LiveCount);
+		} else {
+			/* Mostly small buffers, some up to the largest class */
+			Size = ((Rand() % 8U) == 0U) ? (1U + (Rand() % XIL_DMAPOOL_MAX_SIZE)) :
+				(1U + (Rand() % 1024U));
+			AllocLive(Size);
+		}
+		HOST_CHECK_EQ(mfcpsr(), 0xDFU);
+		if ((Op % 1000U) == 0U) {
+			CheckStats();
+		}
+		if (Host_Failures != 0U) {
+			printf("dmapool: stopped at operation %u\n", Op);
+			return;
+		}
+	}
+	Xil_DmaPoolGetStats(&Stats);
+	printf("dmapool: %u operations, %u failed allocations, pages free %u/%u\n",
+	       RANDOM_OPS, Stats.Failures, Stats.PagesFree, Stats.PagesTotal);
+	while (LiveCount != 0U) {
+		FreeLive(LiveCount - 1U);
+	}
+	CheckStats();
+}
+
+static void TestLimits(void)
+{
+	Xil_DmaPoolStats Stats;
+	Xil_DmaPoolStats After;
+	u8 *Buf;
+	u32 Count = 0U;
+
+	HOST_CHECK_EQ(Xil_DmaPoolInit(Arena, ARENA_SIZE, XIL_DMAPOOL_NONCACHEABLE),
+		      XST_SUCCESS);
+	Xil_DmaPoolGetStats(&Stats);
+	HOST_CHECK(Xil_DmaPoolAlloc(0U) == NULL);
+	HOST_CHECK(Xil_DmaPoolAlloc(XIL_DMAPOOL_MAX_SIZE + 1U) == NULL);
+	Xil_DmaPoolGetStats(&After);
+	HOST_CHECK_EQ(After.Failures, Stats.Failures + 2U);
+
+	/* Foreign and misaligned pointers are ignored */
+	Buf = Xil_DmaPoolAlloc(64U);
+	Xil_DmaPoolFree(Buf + 32);
+	Xil_DmaPoolFree(Arena + ARENA_SIZE);
+	Xil_DmaPoolFree(Arena - 64);
+	Xil_DmaPoolFree(NULL);
+	Xil_DmaPoolGetStats(&After);
+	HOST_CHECK_EQ(After.Frees, 0U);
+	HOST_CHECK_EQ(After.InUse[1], 1U);
+	Xil_DmaPoolFree(Buf);
+
+	/* 16 KB buffers take four pages each until the arena is gone */
+	while (Xil_DmaPoolAlloc(XIL_DMAPOOL_MAX_SIZE) != NULL) {
+		Count++;
+	}
+	HOST_CHECK_EQ(Count, (ARENA_PAGES - 1U) / 4U);
+	Xil_DmaPoolGetStats(&After);
+	HOST_CHECK_EQ(After.PagesFree, (ARENA_PAGES - 1U) % 4U);
+	/* A freed 64 byte buffer is still reused */
+	HOST_CHECK(Xil_DmaPoolAlloc(50U) == Buf);
+	HOST_CHECK_EQ(mfcpsr(), 0xDFU);
+}
+
+static int Run(void *Arg)
+{
+	u32 Index;
+#ifndef __SANITIZE_ADDRESS__
+	void *Own;
+#endif
+
+	(void)Arg;
+	for (Index = 0U; Index < 4096U; Index++) {
+		MMUTable[Index] = (Index << 20) | NORM_WB_CACHE;
+	}
+	Arena = Host_AllocLow(ARENA_SIZE, XIL_MMU_PAGE_SIZE);
+
+	HOST_CHECK_EQ(Xil_DmaPoolInit(Arena + 64, ARENA_SIZE, XIL_DMAPOOL_ACP),
+		      XST_INVALID_PARAM);
+	HOST_CHECK_EQ(Xil_DmaPoolInit(Arena, ARENA_SIZE + 1U, XIL_DMAPOOL_ACP),
+		      XST_INVALID_PARAM);
+	HOST_CHECK_EQ(Xil_DmaPoolInit(Arena, ARENA_SIZE, 2U), XST_INVALID_PARAM);
+
+	/* ACP arena, cacheable and not coherent for the PS DMA masters */
+	HOST_CHECK_EQ(Xil_DmaPoolInit(Arena, ARENA_SIZE, XIL_DMAPOOL_ACP),
+		      XST_SUCCESS);
+	CheckArena((UINTPTR)Arena, ARENA_SIZE, XIL_MMU_DMA_CACHEABLE);
+	HOST_CHECK_EQ(Xil_DmaPoolIsCoherent((UINTPTR)Xil_DmaPoolAlloc(100U)), 0U);
+
+	HOST_CHECK_EQ(Xil_DmaPoolInit(Arena, ARENA_SIZE, XIL_DMAPOOL_NONCACHEABLE),
+		      XST_SUCCESS);
+	CheckArena((UINTPTR)Arena, ARENA_SIZE, XIL_MMU_DMA_WRITE_COMBINE);
+	HOST_CHECK_EQ(Xil_DmaPoolIsCoherent((UINTPTR)Arena - 1U), 0U);
+	HOST_CHECK_EQ(Xil_DmaPoolIsCoherent((UINTPTR)Arena + ARENA_SIZE), 0U);
+	TestRandom();
+	TestLimits();
+
+#ifndef __SANITIZE_ADDRESS__
+	/* An arena from Xil_MmuDmaAlloc, the sanitizer heap is above 4 GB */
+	HOST_CHECK_EQ(Xil_DmaPoolInit(NULL, 8U * XIL_MMU_PAGE_SIZE,
+				      XIL_DMAPOOL_NONCACHEABLE), XST_SUCCESS);
+	Own = Xil_DmaPoolAlloc(4096U);
+	HOST_CHECK(Own != NULL);
+	CheckArena((UINTPTR)Own, XIL_MMU_PAGE_SIZE, XIL_MMU_DMA_WRITE_COMBINE);
+	HOST_CHECK_EQ(Xil_DmaPoolIsCoherent((UINTPTR)Own), 1U);
+#endif
+	return 0;
+}
+
+int main(void)
+{
+	Host_Init();
+	Host_RunLow(Run, NULL);
+	return Host_Result("dmapool");
+}
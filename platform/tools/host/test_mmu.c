@@ -0,0 +1,707 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file test_mmu.c
+*
+* Tests the 4 KB page support of xil_mmu.c and xil_mmu_dma.c.
+*
+* The translation tables are read back by an independent short descriptor
+* walker. It reads a copy of the tables that is only updated by the cache
+* flushes of xil_mmu.c, i.e. what the table walk of the A9 sees in memory.
+*
+* - Random Xil_SetPageAttributes, Xil_MmuMap and Xil_SetTlbAttributes
+*   calls, alone and in batches, are checked page by page against a model
+*   of the expected mapping. A section and the pages it is split into must
+*   translate the same way.
+* - Every TLB invalidation must find the tables cleaned to memory, there is
+*   one per batch that changed a descriptor and none inside a batch.
+* - Every page whose memory type changed must be flushed.
+* - Splitting and merging back a section must give the original section
+*   descriptor for every attribute, domain and NS setting.
+* - The second level table pool is exhausted cleanly and refilled by the
+*   merges, Xil_MmuDmaAlloc/Xil_MmuDmaFree leave the tables as they were.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "host.h"
+#include "xil_mmu.h"
+#include "xil_cache.h"
+#include "xpseudo_asm.h"
+#include "xstatus.h"
+
+#define L1_ENTRIES	4096U
+#define REGION_SECTION	0x100U		/* Randomly changed sections */
+#define REGION_SECTIONS	8U		/* No more than tables in the pool */
+#define REGION_PAGES	(REGION_SECTIONS * XIL_MMU_L2_ENTRIES)
+#define REGION_BASE	(REGION_SECTION << 20)
+#define POOL_SIZE	(XIL_MMU_L2_TABLES * XIL_MMU_L2_ENTRIES * 4U)
+#define RANDOM_OPS	4000U
+
+u32 MMUTable[L1_ENTRIES] __attribute__ ((aligned(16384)));
+
+typedef struct {
+	u8 Valid;
+	u32 Pa;
+	u32 Attr;
+} PageState;
+
+static u32 L1Image[L1_ENTRIES];
+static u32 L1Initial[L1_ENTRIES];
+static u32 *Pool;
+static u32 PoolImage[POOL_SIZE / 4U];
+static PageState Expected[REGION_PAGES];
+static PageState Before[REGION_PAGES];
+
+static u32 TlbInvals;
+static u32 InBatch;
+static u32 FullFlushes;
+static u32 FlushLo[64];
+static u32 FlushHi[64];
+static u32 FlushCount;
+static u32 Seed = 7U;
+
+static const u32 Attribs[] = {
+	NORM_NONCACHE, STRONG_ORDERED, DEVICE_MEMORY, NORM_WT_CACHE,
+	NORM_WB_CACHE, RESERVED, NORM_WB_CACHE & NON_SHAREABLE,
+	NORM_WB_CACHE | 0x20000U,	/* nG */
+	NORM_WB_CACHE | 0x10U,		/* XN */
+	NORM_WB_CACHE | 0x8000U,	/* AP[2], read only */
+};
+#define ATTRIBS	(sizeof(Attribs) / sizeof(Attribs[0]))
+
+static u32 Rand(void)
+{
+	Seed = Seed * 1103515245U + 12345U;
+	return Seed >> 8;
+}
+
+/*****************************************************************************/
+/*
+ * Memory image of the tables
+ */
+static void ImageUpdate(UINTPTR Addr, u32 Len)
+{
+	UINTPTR Table = (UINTPTR)MMUTable;
+	UINTPTR PoolBase = (UINTPTR)Pool;
+	UINTPTR A;
+
+	for (A = Addr & ~(UINTPTR)3U; A < (Addr + Len); A += 4U) {
+		if ((A >= Table) && (A < (Table + sizeof(MMUTable)))) {
+			L1Image[(A - Table) / 4U] = MMUTable[(A - Table) / 4U];
+		}
+		if ((Pool != NULL) && (A >= PoolBase) && (A < (PoolBase + POOL_SIZE))) {
+			PoolImage[(A - PoolBase) / 4U] = Pool[(A - PoolBase) / 4U];
+		}
+	}
+}
+
+static void ImageSync(void)
+{
+	memcpy(L1Image, MMUTable, sizeof(L1Image));
+	if (Pool != NULL) {
+		memcpy(PoolImage, Pool, sizeof(PoolImage));
+	}
+}
+
+static u32 ImageConsistent(void)
+{
+	if (memcmp(L1Image, MMUTable, sizeof(L1Image)) != 0) {
+		return 0U;
+	}
+	if ((Pool != NULL) && (memcmp(PoolImage, Pool, sizeof(PoolImage)) != 0)) {
+		return 0U;
+	}
+	return 1U;
+}
+
+static void CacheHook(u32 Op, UINTPTR Addr, u32 Len, void *Ref)
+{
+	(void)Ref;
+	if (Op == HOST_CACHE_DFLUSH_ALL) {
+		FullFlushes++;
+		ImageSync();
+	} else if (Op == HOST_CACHE_DFLUSH_RANGE) {
+		ImageUpdate(Addr, Len);
+		if (FlushCount < 64U) {
+			FlushLo[FlushCount] = (u32)Addr;
+			FlushHi[FlushCount] = (u32)Addr + Len;
+			FlushCount++;
+		}
+	}
+}
+
+static void CpHook(const char *Reg, u32 Value, void *Ref)
+{
+	(void)Value;
+	(void)Ref;
+	if (strcmp(Reg, XREG_CP15_INVAL_UTLB_UNLOCKED) == 0) {
+		TlbInvals++;
+		HOST_CHECK(InBatch == 0U);
+		/* The walk after the invalidation must see the new tables */
+		HOST_CHECK(ImageConsistent());
+	}
+}
+
+/*****************************************************************************/
+/*
+ * Short descriptor walker on the memory image
+ */
+static u32 CanonSection(u32 Desc)
+{
+	return ((Desc >> 12) & 0x7U) | (((Desc >> 3) & 1U) << 3) |
+		(((Desc >> 2) & 1U) << 4) | (((Desc >> 4) & 1U) << 5) |
+		(((Desc >> 10) & 3U) << 6) | (((Desc >> 15) & 1U) << 8) |
+		(((Desc >> 16) & 1U) << 9) | (((Desc >> 17) & 1U) << 10);
+}
+
+static u32 CanonPage(u32 Desc)
+{
+	return ((Desc >> 6) & 0x7U) | (((Desc >> 3) & 1U) << 3) |
+		(((Desc >> 2) & 1U) << 4) | ((Desc & 1U) << 5) |
+		(((Desc >> 4) & 3U) << 6) | (((Desc >> 9) & 1U) << 8) |
+		(((Desc >> 10) & 1U) << 9) | (((Desc >> 11) & 1U) << 10);
+}
+
+#define CANON_MEMTYPE	0x1FU	/* TEX, C, B */
+
+static void Walk(u32 Va, PageState *Out)
+{
+	u32 L1 = L1Image[Va >> 20];
+	u32 L2;
+	u32 Table;
+
+	Out->Valid = 0U;
+	Out->Pa = 0U;
+	Out->Attr = 0U;
+	switch (L1 & 0x3U) {
+	case 0x2U:
+	case 0x3U:
+		HOST_CHECK((L1 & XIL_MMU_SECT_SUPER_MASK) == 0U);
+		Out->Valid = 1U;
+		Out->Pa = (L1 & 0xFFF00000U) | (Va & 0x000FF000U);
+		Out->Attr = CanonSection(L1);
+		break;
+	case 0x1U:
+		Table = L1 & XIL_MMU_COARSE_BASE_MASK;
+		HOST_CHECK((Table >= (u32)(UINTPTR)Pool) &&
+			   (Table < ((u32)(UINTPTR)Pool + POOL_SIZE)));
+		L2 = PoolImage[((Table - (u32)(UINTPTR)Pool) / 4U) +
+			       ((Va >> 12) & 0xFFU)];
+		/* Large pages are never written */
+		HOST_CHECK((L2 & 0x3U) != 0x1U);
+		if ((L2 & 0x2U) != 0U) {
+			Out->Valid = 1U;
+			Out->Pa = L2 & 0xFFFFF000U;
+			Out->Attr = CanonPage(L2);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+static void CheckRegion(const char *What)
+{
+	PageState Got;
+	u32 Index;
+	u32 Bad = 0U;
+
+	for (Index = 0U; Index < REGION_PAGES; Index++) {
+		Walk(REGION_BASE + (Index * XIL_MMU_PAGE_SIZE), &Got);
+		if ((Got.Valid != Expected[Index].Valid) ||
+		    ((Got.Valid != 0U) && ((Got.Pa != Expected[Index].Pa) ||
+					   (Got.Attr != Expected[Index].Attr)))) {
+			if (Bad++ == 0U) {
+				printf("%s: page 0x%08x valid %u/%u pa 0x%08x/0x%08x "
+				       "attr 0x%03x/0x%03x\n", What,
+				       REGION_BASE + (Index * XIL_MMU_PAGE_SIZE),
+				       Got.Valid, Expected[Index].Valid, Got.Pa,
+				       Expected[Index].Pa, Got.Attr,
+				       Expected[Index].Attr);
+			}
+		}
+	}
+	HOST_CHECK_EQ(Bad, 0U);
+	/* Nothing outside the region moves */
+	for (Index = 0U; Index < L1_ENTRIES; Index++) {
+		if ((Index < REGION_SECTION) ||
+		    (Index >= (REGION_SECTION + REGION_SECTIONS))) {
+			HOST_CHECK_EQ(MMUTable[Index], L1Initial[Index]);
+		}
+	}
+}
+
+/*****************************************************************************/
+/*
+ * Expected mapping
+ */
+static void ExpectPages(u32 Va, u32 Pa, u32 Size, u32 attrib, u32 KeepPhys)
+{
+	u32 Index;
+	PageState *P;
+
+	for (; Size != 0U; Size -= XIL_MMU_PAGE_SIZE) {
+		Index = (Va - REGION_BASE) / XIL_MMU_PAGE_SIZE;
+		P = &Expected[Index];
+		if ((attrib & 0x3U) == XIL_MMU_SECT_FAULT) {
+			P->Valid = 0U;
+		} else {
+			if (KeepPhys == 0U) {
+				P->Pa = Pa;
+			} else if (P->Valid == 0U) {
+				P->Pa = Va;
+			}
+			P->Valid = 1U;
+			P->Attr = CanonSection(attrib);
+		}
+		Va += XIL_MMU_PAGE_SIZE;
+		Pa += XIL_MMU_PAGE_SIZE;
+	}
+}
+
+static u32 Flushed(u32 Addr)
+{
+	u32 Index;
+
+	if (FullFlushes != 0U) {
+		return 1U;
+	}
+	for (Index = 0U; Index < FlushCount; Index++) {
+		if ((Addr >= FlushLo[Index]) &&
+		    ((Addr + XIL_MMU_PAGE_SIZE) <= FlushHi[Index])) {
+			return 1U;
+		}
+	}
+	return 0U;
+}
+
+static void OpBegin(void)
+{
+	memcpy(Before, Expected, sizeof(Before));
+	TlbInvals = 0U;
+	FullFlushes = 0U;
+	FlushCount = 0U;
+}
+
+/* Checks the maintenance of a completed top level operation */
+static void OpEnd(const char *What)
+{
+	u32 Index;
+	u32 Changed = 0U;
+	u32 Va;
+
+	for (Index = 0U; Index < REGION_PAGES; Index++) {
+		Va = REGION_BASE + (Index * XIL_MMU_PAGE_SIZE);
+		if (memcmp(&Before[Index], &Expected[Index], sizeof(PageState)) != 0) {
+			Changed = 1U;
+		}
+		if ((Before[Index].Valid != 0U) &&
+		    ((Expected[Index].Valid == 0U) ||
+		     (((Before[Index].Attr ^ Expected[Index].Attr) &
+		       CANON_MEMTYPE) != 0U))) {
+			if (Flushed(Va) == 0U) {
+				printf("%s: page 0x%08x changed memory type, "
+				       "not flushed\n", What, Va);
+				HOST_CHECK(0);
+				break;
+			}
+		}
+	}
+	HOST_CHECK(TlbInvals <= 1U);
+	if (Changed != 0U) {
+		HOST_CHECK_EQ(TlbInvals, 1U);
+	}
+	HOST_CHECK(ImageConsistent());
+	CheckRegion(What);
+}
+
+/*****************************************************************************/
+/*
+ * Random operations
+ */
+static void RandomRange(u32 *Va, u32 *Size)
+{
+	u32 Pages = REGION_PAGES;
+	u32 First;
+	u32 Count;
+
+	switch (Rand() % 4U) {
+	case 0U:	/* A few pages */
+		Count = 1U + (Rand() % 8U);
+		break;
+	case 1U:	/* Whole sections */
+		First = (Rand() % REGION_SECTIONS) * XIL_MMU_L2_ENTRIES;
+		Count = XIL_MMU_L2_ENTRIES * (1U + (Rand() % 2U));
+		if ((First + Count) > Pages) {
+			Count = Pages - First;
+		}
+		*Va = REGION_BASE + (First * XIL_MMU_PAGE_SIZE);
+		*Size = Count * XIL_MMU_PAGE_SIZE;
+		return;
+	default:
+		Count = 1U + (Rand() % (3U * XIL_MMU_L2_ENTRIES));
+		break;
+	}
+	First = Rand() % Pages;
+	if ((First + Count) > Pages) {
+		Count = Pages - First;
+	}
+	*Va = REGION_BASE + (First * XIL_MMU_PAGE_SIZE);
+	*Size = Count * XIL_MMU_PAGE_SIZE;
+}
+
+static void RandomOp(void)
+{
+	u32 Va, Pa, Size;
+	u32 attrib = Attribs[Rand() % ATTRIBS];
+	u32 Kind = Rand() % 8U;
+
+	RandomRange(&Va, &Size);
+	if (Kind < 4U) {
+		HOST_CHECK_EQ(Xil_SetPageAttributes(Va, Size, attrib), XST_SUCCESS);
+		ExpectPages(Va, 0U, Size, attrib, 1U);
+	} else if (Kind < 7U) {
+		Pa = (Rand() % 0x400U) << 20;
+		if ((Rand() & 1U) != 0U) {
+			/* Keep the section offset, whole sections stay sections */
+			Pa |= Va & (XIL_MMU_SECTION_SIZE - 1U);
+		} else {
+			Pa |= (Rand() % XIL_MMU_L2_ENTRIES) * XIL_MMU_PAGE_SIZE;
+		}
+		HOST_CHECK_EQ(Xil_MmuMap(Va, Pa, Size, attrib), XST_SUCCESS);
+		ExpectPages(Va, Pa, Size, attrib, 0U);
+	} else {
+		Va &= XIL_MMU_SECT_BASE_MASK;
+		Xil_SetTlbAttributes(Va, attrib);
+		ExpectPages(Va, Va, XIL_MMU_SECTION_SIZE, attrib, 0U);
+	}
+}
+
+static void TestRandom(void)
+{
+	u32 Op;
+	u32 Count;
+	u32 Index;
+
+	for (Op = 0U; Op < RANDOM_OPS; Op++) {
+		OpBegin();
+		if ((Rand() % 8U) == 0U) {
+			Count = 2U + (Rand() % 6U);
+			Xil_MmuBatchBegin();
+			InBatch = 1U;
+			for (Index = 0U; Index < Count; Index++) {
+				RandomOp();
+			}
+			HOST_CHECK_EQ(TlbInvals, 0U);
+			InBatch = 0U;
+			Xil_MmuBatchEnd();
+		} else {
+			RandomOp();
+		}
+		OpEnd("random");
+		if (Host_Failures != 0U) {
+			printf("random: stopped at operation %u\n", Op);
+			return;
+		}
+	}
+}
+
+/*****************************************************************************/
+static void ResetRegion(void)
+{
+	u32 Index;
+
+	Xil_MmuBatchBegin();
+	for (Index = 0U; Index < REGION_SECTIONS; Index++) {
+		Xil_SetTlbAttributes(REGION_BASE + (Index << 20), NORM_WB_CACHE);
+		ExpectPages(REGION_BASE + (Index << 20), REGION_BASE + (Index << 20),
+			    XIL_MMU_SECTION_SIZE, NORM_WB_CACHE, 0U);
+	}
+	Xil_MmuBatchEnd();
+	memcpy(L1Initial, MMUTable, sizeof(L1Initial));
+	HOST_CHECK_EQ(Xil_MmuFreeL2Tables(), XIL_MMU_L2_TABLES);
+}
+
+/*
+ * A section split for one page and restored must come back as the same
+ * section descriptor, for every attribute, domain and NS setting
+ */
+static void TestSplitMerge(void)
+{
+	u32 Section = REGION_BASE + (3U << 20);
+	u32 Page = Section + (0x5AU * XIL_MMU_PAGE_SIZE);
+	u32 Index;
+	u32 Domain;
+	u32 Ns;
+	u32 attrib;
+	u32 Other;
+	u32 Desc;
+
+	for (Index = 0U; Index < ATTRIBS; Index++) {
+		if (Attribs[Index] == RESERVED) {
+			continue;
+		}
+		Other = (Attribs[Index] == STRONG_ORDERED) ? NORM_WB_CACHE :
+			STRONG_ORDERED;
+		for (Domain = 0U; Domain < 16U; Domain += 5U) {
+			for (Ns = 0U; Ns < 2U; Ns++) {
+				attrib = (Attribs[Index] & ~0x1E0U) | (Domain << 5) |
+					 (Ns << 19);
+				Xil_SetTlbAttributes(Section, attrib);
+				Desc = MMUTable[Section >> 20];
+				HOST_CHECK_EQ(Desc, Section | attrib);
+
+				HOST_CHECK_EQ(Xil_SetPageAttributes(Page,
+					XIL_MMU_PAGE_SIZE, Other), XST_SUCCESS);
+				HOST_CHECK_EQ(MMUTable[Section >> 20] & 0x3U,
+					      XIL_MMU_SECT_COARSE);
+				/* The table keeps domain and NS of the section */
+				HOST_CHECK_EQ(MMUTable[Section >> 20] & 0x1E8U,
+					      (Domain << 5) | (Ns << 3));
+				HOST_CHECK_EQ(Xil_MmuFreeL2Tables(),
+					      XIL_MMU_L2_TABLES - 1U);
+
+				HOST_CHECK_EQ(Xil_SetPageAttributes(Page,
+					XIL_MMU_PAGE_SIZE, attrib), XST_SUCCESS);
+				HOST_CHECK_EQ(MMUTable[Section >> 20], Desc);
+				HOST_CHECK_EQ(Xil_MmuFreeL2Tables(),
+					      XIL_MMU_L2_TABLES);
+			}
+		}
+	}
+
+	/* A fault section split and unmapped again becomes a fault section */
+	Xil_SetTlbAttributes(Section, RESERVED);
+	HOST_CHECK_EQ(Xil_SetPageAttributes(Page, XIL_MMU_PAGE_SIZE,
+					    NORM_WB_CACHE), XST_SUCCESS);
+	HOST_CHECK_EQ(MMUTable[Section >> 20] & 0x3U, XIL_MMU_SECT_COARSE);
+	HOST_CHECK_EQ(Xil_SetPageAttributes(Page, XIL_MMU_PAGE_SIZE, RESERVED),
+		      XST_SUCCESS);
+	HOST_CHECK_EQ(MMUTable[Section >> 20], XIL_MMU_SECT_FAULT);
+	HOST_CHECK_EQ(Xil_MmuFreeL2Tables(), XIL_MMU_L2_TABLES);
+
+	/* Unaligned ranges are refused */
+	HOST_CHECK_EQ(Xil_SetPageAttributes(Page + 4U, XIL_MMU_PAGE_SIZE,
+					    NORM_WB_CACHE), XST_FAILURE);
+	HOST_CHECK_EQ(Xil_MmuMap(Page, Page + 0x800U, XIL_MMU_PAGE_SIZE,
+				 NORM_WB_CACHE), XST_FAILURE);
+	HOST_CHECK_EQ(Xil_SetPageAttributes(0xFFFFF000U, 0x2000U,
+					    NORM_WB_CACHE), XST_FAILURE);
+}
+
+static void TestPoolExhaustion(void)
+{
+	u32 Index;
+	u32 Section = 0x200U << 20;
+	u32 Desc;
+
+	OpBegin();
+	for (Index = 0U; Index < XIL_MMU_L2_TABLES; Index++) {
+		HOST_CHECK_EQ(Xil_SetPageAttributes(Section + (Index << 20),
+			XIL_MMU_PAGE_SIZE, NORM_NONCACHE), XST_SUCCESS);
+	}
+	HOST_CHECK_EQ(Xil_MmuFreeL2Tables(), 0U);
+
+	Desc = MMUTable[(Section >> 20) + XIL_MMU_L2_TABLES];
+	HOST_CHECK_EQ(Xil_SetPageAttributes(Section + (XIL_MMU_L2_TABLES << 20),
+		XIL_MMU_PAGE_SIZE, NORM_NONCACHE), XST_FAILURE);
+	HOST_CHECK_EQ(MMUTable[(Section >> 20) + XIL_MMU_L2_TABLES], Desc);
+
+	/* Whole sections still work without a table */
+	Xil_SetTlbAttributes(Section + (XIL_MMU_L2_TABLES << 20), NORM_NONCACHE);
+	Xil_SetTlbAttributes(Section + (XIL_MMU_L2_TABLES << 20),
+			     L1Initial[(Section >> 20) + XIL_MMU_L2_TABLES] &
+			     ~XIL_MMU_SECT_BASE_MASK);
+
+	/* A range failing in its second section keeps the first one */
+	Xil_SetTlbAttributes(Section, L1Initial[Section >> 20] &
+			     ~XIL_MMU_SECT_BASE_MASK);
+	HOST_CHECK_EQ(Xil_MmuFreeL2Tables(), 1U);
+	Desc = MMUTable[(Section >> 20) + XIL_MMU_L2_TABLES + 2U];
+	HOST_CHECK_EQ(Xil_SetPageAttributes(Section +
+		((XIL_MMU_L2_TABLES + 2U) << 20) - XIL_MMU_PAGE_SIZE, 0x2000U,
+		DEVICE_MEMORY), XST_FAILURE);
+	HOST_CHECK_EQ(Xil_MmuFreeL2Tables(), 0U);
+	HOST_CHECK_EQ(MMUTable[(Section >> 20) + XIL_MMU_L2_TABLES + 1U] & 0x3U,
+		      XIL_MMU_SECT_COARSE);
+	HOST_CHECK_EQ(MMUTable[(Section >> 20) + XIL_MMU_L2_TABLES + 2U], Desc);
+
+	for (Index = 0U; Index <= (XIL_MMU_L2_TABLES + 1U); Index++) {
+		Xil_SetTlbAttributes(Section + (Index << 20),
+				     L1Initial[(Section >> 20) + Index] &
+				     ~XIL_MMU_SECT_BASE_MASK);
+	}
+	HOST_CHECK_EQ(Xil_MmuFreeL2Tables(), XIL_MMU_L2_TABLES);
+	for (Index = 0U; Index <= (XIL_MMU_L2_TABLES + 2U); Index++) {
+		HOST_CHECK_EQ(MMUTable[(Section >> 20) + Index],
+			      L1Initial[(Section >> 20) + Index]);
+	}
+}
+
+static void TestBatch(void)
+{
+	u32 Index;
+
+	/* A single section update keeps the full D-cache flush */
+	OpBegin();
+	Xil_SetTlbAttributes(REGION_BASE, NORM_NONCACHE);
+	ExpectPages(REGION_BASE, REGION_BASE, XIL_MMU_SECTION_SIZE,
+		    NORM_NONCACHE, 0U);
+	HOST_CHECK_EQ(FullFlushes, 1U);
+	OpEnd("section");
+
+	/* Nothing changes, no maintenance at all */
+	OpBegin();
+	Xil_SetTlbAttributes(REGION_BASE, NORM_NONCACHE);
+	HOST_CHECK_EQ(TlbInvals, 0U);
+	HOST_CHECK_EQ(FullFlushes, 0U);
+	HOST_CHECK_EQ(FlushCount, 0U);
+
+	/* Nested batches invalidate once at the outermost end */
+	OpBegin();
+	Xil_MmuBatchBegin();
+	Xil_MmuBatchBegin();
+	InBatch = 1U;
+	for (Index = 0U; Index < 8U; Index++) {
+		HOST_CHECK_EQ(Xil_SetPageAttributes(REGION_BASE + (Index * 0x2000U),
+			XIL_MMU_PAGE_SIZE, STRONG_ORDERED), XST_SUCCESS);
+		ExpectPages(REGION_BASE + (Index * 0x2000U), 0U, XIL_MMU_PAGE_SIZE,
+			    STRONG_ORDERED, 1U);
+	}
+	Xil_MmuBatchEnd();
+	HOST_CHECK_EQ(TlbInvals, 0U);
+	InBatch = 0U;
+	Xil_MmuBatchEnd();
+	HOST_CHECK_EQ(TlbInvals, 1U);
+	/* Only the changed pages are flushed, not the whole D-cache */
+	HOST_CHECK_EQ(FullFlushes, 0U);
+	OpEnd("batch");
+
+	/* Xil_MemMap writes whole sections in one batch */
+	OpBegin();
+	HOST_CHECK(Xil_MemMap(REGION_BASE + 0x123456U, 0x280000U, DEVICE_MEMORY) ==
+		   (void *)(UINTPTR)REGION_BASE + 0x100000U);
+	ExpectPages(REGION_BASE + 0x100000U, REGION_BASE + 0x100000U,
+		    0x300000U, DEVICE_MEMORY, 0U);
+	OpEnd("memmap");
+}
+
+static void TestDma(void)
+{
+	u8 *Buf;
+	u32 Section;
+	u32 Page;
+	PageState Got;
+
+	memcpy(L1Initial, MMUTable, sizeof(L1Initial));
+	Buf = Xil_MmuDmaAlloc(10000U, XIL_MMU_DMA_WRITE_COMBINE);
+	HOST_CHECK(Buf != NULL);
+	if (Buf == NULL) {
+		return;
+	}
+	HOST_CHECK_EQ((UINTPTR)Buf & (XIL_MMU_PAGE_SIZE - 1U), 0U);
+	memset(Buf, 0x5A, 10000U);
+
+	Section = (u32)(UINTPTR)Buf >> 20;
+	HOST_CHECK((MMUTable[Section] & 0x3U) == XIL_MMU_SECT_COARSE);
+	for (Page = 0U; Page < 3U; Page++) {
+		Walk((u32)(UINTPTR)Buf + (Page * XIL_MMU_PAGE_SIZE), &Got);
+		HOST_CHECK_EQ(Got.Valid, 1U);
+		HOST_CHECK_EQ(Got.Attr, CanonSection(NORM_NONCACHE));
+		HOST_CHECK_EQ(Got.Pa, (u32)(UINTPTR)Buf + (Page * XIL_MMU_PAGE_SIZE));
+	}
+	Walk((u32)(UINTPTR)Buf + (3U * XIL_MMU_PAGE_SIZE), &Got);
+	HOST_CHECK_EQ(Got.Attr, CanonSection(NORM_WB_CACHE));
+
+	Xil_MmuDmaFree(Buf, 10000U);
+	HOST_CHECK_EQ(Xil_MmuFreeL2Tables(), XIL_MMU_L2_TABLES);
+	HOST_CHECK(memcmp(MMUTable, L1Initial, sizeof(MMUTable)) == 0);
+}
+
+static void SetupTables(void)
+{
+	u32 Index;
+	u32 Sec;
+
+	/* Flat map, cacheable DDR and heap, a mix in the random region */
+	for (Index = 0U; Index < L1_ENTRIES; Index++) {
+		MMUTable[Index] = (Index << 20) | NORM_WB_CACHE;
+	}
+	for (Index = 0xE00U; Index < L1_ENTRIES; Index++) {
+		MMUTable[Index] = (Index << 20) | DEVICE_MEMORY;
+	}
+	for (Index = 0U; Index < REGION_SECTIONS; Index++) {
+		Sec = REGION_SECTION + Index;
+		MMUTable[Sec] = (Sec << 20) | Attribs[Index % ATTRIBS];
+		if (Attribs[Index % ATTRIBS] == RESERVED) {
+			MMUTable[Sec] = XIL_MMU_SECT_FAULT;
+		}
+		ExpectPages(Sec << 20, Sec << 20, XIL_MMU_SECTION_SIZE,
+			    Attribs[Index % ATTRIBS], 0U);
+	}
+	memcpy(L1Initial, MMUTable, sizeof(L1Initial));
+
+	/* The first split takes the first table of the pool */
+	HOST_CHECK_EQ(Xil_MmuFreeL2Tables(), XIL_MMU_L2_TABLES);
+	HOST_CHECK_EQ(Xil_SetPageAttributes(0x300FF000U, XIL_MMU_PAGE_SIZE,
+					    NORM_NONCACHE), XST_SUCCESS);
+	Pool = (u32 *)(UINTPTR)(MMUTable[0x300U] & XIL_MMU_COARSE_BASE_MASK);
+	Xil_SetTlbAttributes(0x30000000U, NORM_WB_CACHE);
+	HOST_CHECK_EQ(MMUTable[0x300U], L1Initial[0x300U]);
+	ImageSync();
+}
+
+static int Run(void *Arg)
+{
+	(void)Arg;
+	SetupTables();
+	Host_SetCacheHook(CacheHook, NULL);
+	Host_SetCpHook(CpHook, NULL);
+
+	OpBegin();
+	OpEnd("initial");
+	TestRandom();
+	ResetRegion();
+	TestSplitMerge();
+	ResetRegion();
+	TestBatch();
+	ResetRegion();
+	TestPoolExhaustion();
+	TestDma();
+
+	HostCp_Set(XREG_CP15_SYS_CONTROL, 0x00C50078U);
+	Xil_EnableMMU();
+	HOST_CHECK_EQ(mfcp(XREG_CP15_SYS_CONTROL), 0x00C5007DU);
+	Xil_DisableMMU();
+	HOST_CHECK_EQ(mfcp(XREG_CP15_SYS_CONTROL) & 0x5U, 0U);
+
+	printf("mmu: %u random operations, %llu TLB invalidations, "
+	       "%llu range flushes, %llu full flushes\n", RANDOM_OPS,
+	       (unsigned long long)HostCp_Writes(XREG_CP15_INVAL_UTLB_UNLOCKED),
+	       (unsigned long long)Host_Stats.DCacheFlushRange,
+	       (unsigned long long)Host_Stats.DCacheFlushAll);
+	return 0;
+}
+
+int main(void)
+{
+	Host_Init();
+	Host_RunLow(Run, NULL);
+	return Host_Result("mmu");
+}
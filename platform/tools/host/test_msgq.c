@@ -0,0 +1,414 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file test_msgq.c
+*
+* Stress test of xil_msgq.c built with XIL_MSGQ_HOST, where the loads,
+* stores and compare and swap are C11 atomics, on host threads.
+*
+* - Xil_MsgQInit rejects bad parameters, full, empty, too long and too
+*   small buffer cases return their status codes, and the 32 bit
+*   positions wrap without losing or duplicating a message.
+* - SPSC: one producer and one consumer thread pass messages of random
+*   length through a small queue with Reserve/Commit/Receive/Release and
+*   Send/Recv. The consumer sees every message once, in order, intact.
+* - The consumer sleeps with Xil_MsgQPrepareWait until a producer clears
+*   the waiting flag, which stands in for the doorbell SGI. A lost
+*   wake-up shows up as a consumer which waits with messages queued.
+* - MPMC: four producers and four consumers. Every message is received
+*   exactly once and every consumer sees the messages of one producer in
+*   the order they were sent.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "host.h"
+#include "xil_msgq.h"
+#include "xstatus.h"
+
+#define MSG_SIZE	64U
+#define SLOT_COUNT	8U
+#define SPSC_MSGS	400000U
+#define MPMC_THREADS	4U
+#define MPMC_MSGS	100000U	/* per producer */
+#define WAIT_TIMEOUT_SEC 5
+
+typedef struct {
+	u32 Producer;
+	u32 Seq;
+	u8 Data[MSG_SIZE - 8U];
+} Msg;
+
+static Xil_MsgQ Queue;
+static u8 Slots[XIL_MSGQ_SLOTS_SIZE(MSG_SIZE, SLOT_COUNT)]
+	__attribute__ ((aligned(XIL_MSGQ_LINE_SIZE)));
+
+static _Atomic u32 Received;
+static _Atomic u8 Seen[MPMC_THREADS][MPMC_MSGS];
+static u32 Sleeps;
+static u32 Wakeups;
+
+static u8 Pattern(u32 Producer, u32 Seq, u32 Index)
+{
+	return (u8)((Seq * 31U) + (Producer * 7U) + Index);
+}
+
+/* Message length from 8 bytes (no payload) to MSG_SIZE */
+static u32 LenOf(u32 Producer, u32 Seq)
+{
+	return 8U + (((Seq * 2654435761U) ^ Producer) % (MSG_SIZE - 7U));
+}
+
+static void Fill(Msg *M, u32 Producer, u32 Seq)
+{
+	u32 Index;
+
+	M->Producer = Producer;
+	M->Seq = Seq;
+	for (Index = 0U; Index < (LenOf(Producer, Seq) - 8U); Index++) {
+		M->Data[Index] = Pattern(Producer, Seq, Index);
+	}
+}
+
+static u32 Intact(const Msg *M, u32 Len)
+{
+	u32 Index;
+
+	if ((Len < 8U) || (Len > sizeof(*M)) || (M->Producer >= MPMC_THREADS) ||
+	    (Len != LenOf(M->Producer, M->Seq))) {
+		return 0U;
+	}
+	for (Index = 0U; Index < (Len - 8U); Index++) {
+		if (M->Data[Index] != Pattern(M->Producer, M->Seq, Index)) {
+			return 0U;
+		}
+	}
+	return 1U;
+}
+
+static double Seconds(void)
+{
+	struct timespec Ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &Ts);
+	return (double)Ts.tv_sec + ((double)Ts.tv_nsec * 1e-9);
+}
+
+/*
+ * The doorbell: MsgQNotify clears Waiting when it would raise the SGI.
+ * Returns 0 if the consumer waited too long with messages in the queue.
+ */
+static u32 WaitDoorbell(Xil_MsgQ *Q)
+{
+	double Start = Seconds();
+
+	if (Xil_MsgQPrepareWait(Q) == 0U) {
+		return 1U;
+	}
+	Sleeps++;
+	while (Xil_MsgQLoad(&Q->Waiting) != 0U) {
+		if ((Seconds() - Start) > WAIT_TIMEOUT_SEC) {
+			printf("msgq: consumer asleep with %u messages queued\n",
+			       Xil_MsgQCount(Q));
+			return 0U;
+		}
+		sched_yield();
+	}
+	Wakeups++;
+	return 1U;
+}
+
+static void *SpscProducer(void *Arg)
+{
+	Msg M;
+	void *Buf;
+	u32 Seq;
+
+	(void)Arg;
+	for (Seq = 0U; Seq < SPSC_MSGS; Seq++) {
+		if ((Seq & 1U) != 0U) {
+			Fill(&M, 0U, Seq);
+			while (Xil_MsgQSend(&Queue, &M, LenOf(0U, Seq)) ==
+			       XST_FIFO_NO_ROOM) {
+				sched_yield();
+			}
+			continue;
+		}
+		while ((Buf = Xil_MsgQReserve(&Queue)) == NULL) {
+			sched_yield();
+		}
+		Fill(Buf, 0U, Seq);
+		Xil_MsgQCommit(&Queue, Buf, LenOf(0U, Seq));
+	}
+	return NULL;
+}
+
+static void TestSpsc(void)
+{
+	pthread_t Thread;
+	Msg M;
+	void *Buf;
+	u32 Len;
+	u32 Seq;
+	u32 Bad = 0U;
+	s32 Status;
+
+	HOST_CHECK_EQ(Xil_MsgQInit(&Queue, Slots, MSG_SIZE, SLOT_COUNT,
+				   XIL_MSGQ_SPSC), XST_SUCCESS);
+	Sleeps = 0U;
+	Wakeups = 0U;
+	pthread_create(&Thread, NULL, SpscProducer, NULL);
+	for (Seq = 0U; Seq < SPSC_MSGS; Seq++) {
+		for (;;) {
+			if ((Seq & 2U) != 0U) {
+				Status = Xil_MsgQRecv(&Queue, &M, sizeof(M), &Len);
+				if (Status == XST_SUCCESS) {
+					break;
+				}
+				HOST_CHECK_EQ(Status, XST_NO_DATA);
+			} else {
+				Buf = Xil_MsgQReceive(&Queue, &Len);
+				if (Buf != NULL) {
+					memcpy(&M, Buf, (Len < sizeof(M)) ? Len : sizeof(M));
+					Xil_MsgQRelease(&Queue, Buf);
+					break;
+				}
+			}
+			if (WaitDoorbell(&Queue) == 0U) {
+				HOST_CHECK(0);
+				pthread_join(Thread, NULL);
+				return;
+			}
+		}
+		if ((M.Seq != Seq) || (Intact(&M, Len) == 0U)) {
+			Bad++;
+		}
+	}
+	pthread_join(Thread, NULL);
+	HOST_CHECK_EQ(Bad, 0U);
+	HOST_CHECK_EQ(Xil_MsgQCount(&Queue), 0U);
+	printf("msgq: SPSC %u messages, consumer slept %u times, woken %u times\n",
+	       SPSC_MSGS, Sleeps, Wakeups);
+}
+
+static void *MpmcProducer(void *Arg)
+{
+	u32 Producer = (u32)(UINTPTR)Arg;
+	Msg M;
+	void *Buf;
+	u32 Seq;
+
+	for (Seq = 0U; Seq < MPMC_MSGS; Seq++) {
+		if (((Seq + Producer) & 1U) != 0U) {
+			Fill(&M, Producer, Seq);
+			while (Xil_MsgQSend(&Queue, &M, LenOf(Producer, Seq)) ==
+			       XST_FIFO_NO_ROOM) {
+				sched_yield();
+			}
+			continue;
+		}
+		while ((Buf = Xil_MsgQReserve(&Queue)) == NULL) {
+			sched_yield();
+		}
+		Fill(Buf, Producer, Seq);
+		Xil_MsgQCommit(&Queue, Buf, LenOf(Producer, Seq));
+	}
+	return NULL;
+}
+
+static void *MpmcConsumer(void *Arg)
+{
+	u32 Next[MPMC_THREADS];
+	u32 Bad = 0U;
+	Msg M;
+	void *Buf;
+	u32 Len;
+
+	(void)Arg;
+	memset(Next, 0, sizeof(Next));
+	while (atomic_load(&Received) < (MPMC_THREADS * MPMC_MSGS)) {
+		Buf = Xil_MsgQReceive(&Queue, &Len);
+		if (Buf == NULL) {
+			sched_yield();
+			continue;
+		}
+		memcpy(&M, Buf, (Len < sizeof(M)) ? Len : sizeof(M));
+		Xil_MsgQRelease(&Queue, Buf);
+		atomic_fetch_add(&Received, 1U);
+		if ((Intact(&M, Len) == 0U) || (M.Seq >= MPMC_MSGS) ||
+		    (M.Seq < Next[M.Producer])) {
+			Bad++;
+			continue;
+		}
+		Next[M.Producer] = M.Seq + 1U;
+		atomic_fetch_add(&Seen[M.Producer][M.Seq], 1U);
+	}
+	return (void *)(UINTPTR)Bad;
+}
+
+static void TestMpmc(void)
+{
+	pthread_t Producers[MPMC_THREADS];
+	pthread_t Consumers[MPMC_THREADS];
+	void *Bad;
+	u32 BadTotal = 0U;
+	u32 Wrong = 0U;
+	u32 Index;
+	u32 Seq;
+
+	HOST_CHECK_EQ(Xil_MsgQInit(&Queue, Slots, MSG_SIZE, SLOT_COUNT,
+				   XIL_MSGQ_MPMC), XST_SUCCESS);
+	atomic_store(&Received, 0U);
+	for (Index = 0U; Index < MPMC_THREADS; Index++) {
+		pthread_create(&Consumers[Index], NULL, MpmcConsumer, NULL);
+		pthread_create(&Producers[Index], NULL, MpmcProducer,
+			       (void *)(UINTPTR)Index);
+	}
+	for (Index = 0U; Index < MPMC_THREADS; Index++) {
+		pthread_join(Producers[Index], NULL);
+	}
+	for (Index = 0U; Index < MPMC_THREADS; Index++) {
+		pthread_join(Consumers[Index], &Bad);
+		BadTotal += (u32)(UINTPTR)Bad;
+	}
+	for (Index = 0U; Index < MPMC_THREADS; Index++) {
+		for (Seq = 0U; Seq < MPMC_MSGS; Seq++) {
+			if (atomic_load(&Seen[Index][Seq]) != 1U) {
+				Wrong++;
+			}
+		}
+	}
+	HOST_CHECK_EQ(BadTotal, 0U);
+	HOST_CHECK_EQ(Wrong, 0U);
+	HOST_CHECK_EQ(Xil_MsgQCount(&Queue), 0U);
+	printf("msgq: MPMC %u producers, %u consumers, %u messages\n",
+	       MPMC_THREADS, MPMC_THREADS, MPMC_THREADS * MPMC_MSGS);
+}
+
+/* Moves both positions to Pos as if Pos messages had passed */
+static void SetPosition(Xil_MsgQ *Q, u32 Pos)
+{
+	u32 Index;
+
+	for (Index = 0U; Index <= Q->Mask; Index++) {
+		Xil_MsgQStore(&Xil_MsgQSlotPtr(Q, Pos + Index)->Seq, Pos + Index);
+	}
+	Xil_MsgQStore(&Q->Head, Pos);
+	Xil_MsgQStore(&Q->Tail, Pos);
+}
+
+static void TestSingle(u32 Type)
+{
+	Msg M;
+	Msg Out;
+	u8 Small[8];
+	u32 Len;
+	u32 Seq;
+	u32 Index;
+
+	HOST_CHECK_EQ(Xil_MsgQInit(&Queue, Slots, MSG_SIZE, SLOT_COUNT, Type),
+		      XST_SUCCESS);
+	HOST_CHECK_EQ(Xil_MsgQIsReady(&Queue), 1U);
+	HOST_CHECK_EQ(Xil_MsgQSetDoorbell(&Queue, 1U, 0U, 1U), XST_NOT_ENABLED);
+	HOST_CHECK_EQ(Xil_MsgQRecv(&Queue, &Out, sizeof(Out), &Len), XST_NO_DATA);
+	HOST_CHECK_EQ(Xil_MsgQSend(&Queue, &M, MSG_SIZE + 1U), XST_INVALID_PARAM);
+
+	/* A full queue, then the positions wrap at 2^32 */
+	SetPosition(&Queue, 0xFFFFFFFCU);
+	for (Seq = 0U; Seq < SLOT_COUNT; Seq++) {
+		Fill(&M, 1U, Seq);
+		HOST_CHECK_EQ(Xil_MsgQSend(&Queue, &M, LenOf(1U, Seq)), XST_SUCCESS);
+	}
+	HOST_CHECK_EQ(Xil_MsgQSend(&Queue, &M, 8U), XST_FIFO_NO_ROOM);
+	HOST_CHECK(Xil_MsgQReserve(&Queue) == NULL);
+	HOST_CHECK_EQ(Xil_MsgQCount(&Queue), SLOT_COUNT);
+	HOST_CHECK_EQ(Xil_MsgQPrepareWait(&Queue), 0U);
+	HOST_CHECK_EQ(Xil_MsgQLoad(&Queue.Waiting), 0U);
+
+	/* A message too long for the buffer is dropped */
+	HOST_CHECK_EQ(Xil_MsgQRecv(&Queue, Small, sizeof(Small), &Len),
+		      XST_BUFFER_TOO_SMALL);
+	HOST_CHECK_EQ(Len, LenOf(1U, 0U));
+	for (Seq = 1U; Seq < (4U * SLOT_COUNT); Seq++) {
+		HOST_CHECK_EQ(Xil_MsgQRecv(&Queue, &Out, sizeof(Out), &Len),
+			      XST_SUCCESS);
+		HOST_CHECK_EQ(Out.Seq, Seq);
+		HOST_CHECK_EQ(Intact(&Out, Len), 1U);
+		Fill(&M, 1U, Seq + SLOT_COUNT - 1U);
+		HOST_CHECK_EQ(Xil_MsgQSend(&Queue, &M, LenOf(1U, M.Seq)),
+			      XST_SUCCESS);
+	}
+	for (Index = 0U; Index < (SLOT_COUNT - 1U); Index++) {
+		HOST_CHECK_EQ(Xil_MsgQRecv(&Queue, &Out, sizeof(Out), &Len),
+			      XST_SUCCESS);
+		HOST_CHECK_EQ(Out.Seq, Seq + Index);
+	}
+	HOST_CHECK_EQ(Xil_MsgQRecv(&Queue, &Out, sizeof(Out), &Len), XST_NO_DATA);
+	HOST_CHECK(Xil_MsgQLoad(&Queue.Head) < (SLOT_COUNT * 5U));
+
+	/* The waiting flag stays set until a commit clears it */
+	HOST_CHECK_EQ(Xil_MsgQPrepareWait(&Queue), 1U);
+	HOST_CHECK_EQ(Xil_MsgQLoad(&Queue.Waiting), 1U);
+	Xil_MsgQCancelWait(&Queue);
+	HOST_CHECK_EQ(Xil_MsgQLoad(&Queue.Waiting), 0U);
+	HOST_CHECK_EQ(Xil_MsgQPrepareWait(&Queue), 1U);
+	HOST_CHECK_EQ(Xil_MsgQSend(&Queue, &M, 8U), XST_SUCCESS);
+	HOST_CHECK_EQ(Xil_MsgQLoad(&Queue.Waiting), 0U);
+}
+
+static void TestParams(void)
+{
+	HOST_CHECK_EQ(Xil_MsgQInit(NULL, Slots, MSG_SIZE, SLOT_COUNT,
+				   XIL_MSGQ_SPSC), XST_INVALID_PARAM);
+	HOST_CHECK_EQ(Xil_MsgQInit(&Queue, NULL, MSG_SIZE, SLOT_COUNT,
+				   XIL_MSGQ_SPSC), XST_INVALID_PARAM);
+	HOST_CHECK_EQ(Xil_MsgQInit(&Queue, Slots, 0U, SLOT_COUNT,
+				   XIL_MSGQ_SPSC), XST_INVALID_PARAM);
+	HOST_CHECK_EQ(Xil_MsgQInit(&Queue, Slots, MSG_SIZE, 1U,
+				   XIL_MSGQ_SPSC), XST_INVALID_PARAM);
+	HOST_CHECK_EQ(Xil_MsgQInit(&Queue, Slots, MSG_SIZE, 6U,
+				   XIL_MSGQ_MPMC), XST_INVALID_PARAM);
+	HOST_CHECK_EQ(Xil_MsgQInit(&Queue, Slots + 8, MSG_SIZE, SLOT_COUNT,
+				   XIL_MSGQ_SPSC), XST_INVALID_PARAM);
+	HOST_CHECK_EQ(Xil_MsgQInit(&Queue, Slots, MSG_SIZE, SLOT_COUNT, 2U),
+		      XST_INVALID_PARAM);
+	HOST_CHECK_EQ(Xil_MsgQIsReady(&Queue), 0U);
+	HOST_CHECK_EQ(XIL_MSGQ_SLOT_STRIDE(MSG_SIZE) % XIL_MSGQ_LINE_SIZE, 0U);
+}
+
+static int Run(void *Arg)
+{
+	(void)Arg;
+	TestParams();
+	TestSingle(XIL_MSGQ_SPSC);
+	TestSingle(XIL_MSGQ_MPMC);
+	TestSpsc();
+	TestMpmc();
+	return 0;
+}
+
+int main(void)
+{
+	Host_Init();
+	Host_RunLow(Run, NULL);
+	return Host_Result("msgq");
+}
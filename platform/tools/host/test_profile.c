@@ -0,0 +1,503 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file test_profile.c
+*
+* Compares the PROFILE_FAST backend (profile_fast.c, profile_gmon.c) with
+* the reference profile_cg.c/profile_hist.c on the same synthetic trace.
+* The reference objects are built with their symbols prefixed by ref_, see
+* the Makefile.
+*
+* - Histogram and call arcs of both backends must be identical, for a bin
+*   width that is a power of 2 and for one that is not.
+* - The gmon stream of profile_fast_write_gmon is parsed back and must
+*   hold the same histogram and arcs.
+* - Overflowing the sample ring and the arc table must be accounted in
+*   profile_fast_stats and mark the section with GMON_PROF_ERROR.
+*
+* The host time per call of both mcount implementations is printed for
+* information, it says nothing about the cycles on the A9.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "host.h"
+#include "profile.h"
+#include "profile_fast.h"
+#include "profile_config.h"
+#include "xscutimer_hw.h"
+#include "xcoresightpsdcc.h"
+#include "xparameters.h"
+
+#define SECTIONS	3
+#define FUNCS		600U
+#define SITES		1500U
+#define CALLS		400000U
+#define SAMPLES		300000U
+#define DRAIN_EVERY	1000U
+#define MAX_FROMS	4096U
+#define MAX_TOS		8192U
+
+/* Reference backend, renamed at build time */
+struct gmonparam *ref_gmonparam;
+s32 ref_n_gmon_sections;
+extern u32 ref_prof_pc;
+void ref_mcount(u32 frompc, u32 selfpc);
+void ref_profile_intr_handler(void);
+
+/* Variables normally defined by _profile_init.c */
+u32 binsize = (u32)BINSIZE;
+u32 sample_freq_hz = (u32)SAMPLE_FREQ_HZ;
+u32 timer_clk_ticks = (u32)TIMER_CLK_TICKS;
+struct gmonparam *_gmonparam;
+s32 n_gmon_sections;
+extern u32 prof_pc;
+
+static const u32 SectionLow[SECTIONS] = { 0x00200000U, 0x00100000U, 0xFFFC0000U };
+static const u32 SectionSize[SECTIONS] = { 0x00008000U, 0x00040000U, 0x00010000U };
+
+static struct gmonparam FastParam[SECTIONS];
+static struct gmonparam RefParam[SECTIONS];
+static struct fromstruct RefFroms[SECTIONS][MAX_FROMS];
+static struct tostruct RefTos[SECTIONS][MAX_TOS];
+
+static u32 Funcs[FUNCS];
+static u32 SiteFrom[SITES];
+static u32 SiteSelf[SITES];
+static u32 TimerCtrl;
+static u32 TimerAcks;
+static u32 TimerToggles;
+static u32 Seed;
+
+static u8 *Gmon;
+static u32 GmonLen;
+static u32 GmonCap;
+static u8 *Dcc;
+static u32 DccLen;
+static u32 DccBase;
+
+static u32 Rand(void)
+{
+	Seed = Seed * 1103515245U + 12345U;
+	return Seed >> 8;
+}
+
+/* Profile timer, only the enable bit and the event flag are modeled */
+static u32 TimerRead(void *Ref, u32 Offset, u32 Size)
+{
+	(void)Ref;
+	(void)Size;
+	return (Offset == XSCUTIMER_CONTROL_OFFSET) ? TimerCtrl : 0U;
+}
+
+static void TimerWrite(void *Ref, u32 Offset, u32 Value, u32 Size)
+{
+	(void)Ref;
+	(void)Size;
+	if (Offset == XSCUTIMER_CONTROL_OFFSET) {
+		if (((Value ^ TimerCtrl) & XSCUTIMER_CONTROL_ENABLE_MASK) != 0U) {
+			TimerToggles++;
+		}
+		TimerCtrl = Value;
+	} else if (Offset == XSCUTIMER_ISR_OFFSET) {
+		TimerAcks++;
+	}
+}
+
+static void SetupSections(u32 Bin)
+{
+	u32 Index;
+	u32 Bins;
+
+	binsize = Bin;
+	for (Index = 0U; Index < SECTIONS; Index++) {
+		Bins = ROUNDUP(SectionSize[Index], 4U * Bin) / (4U * Bin);
+		free(FastParam[Index].kcount);
+		free(RefParam[Index].kcount);
+		memset(&FastParam[Index], 0, sizeof(FastParam[Index]));
+		FastParam[Index].lowpc = SectionLow[Index];
+		FastParam[Index].highpc = SectionLow[Index] + SectionSize[Index];
+		FastParam[Index].textsize = SectionSize[Index];
+		FastParam[Index].kcountsize = Bins;
+		FastParam[Index].kcount = calloc(Bins, sizeof(HISTCOUNTER));
+
+		RefParam[Index] = FastParam[Index];
+		RefParam[Index].kcount = calloc(Bins, sizeof(HISTCOUNTER));
+		RefParam[Index].froms = RefFroms[Index];
+		RefParam[Index].fromssize = 0U;
+		RefParam[Index].tos = &RefTos[Index][MAX_TOS];
+		RefParam[Index].tossize = 0U;
+	}
+	_gmonparam = FastParam;
+	n_gmon_sections = SECTIONS;
+	ref_gmonparam = RefParam;
+	ref_n_gmon_sections = SECTIONS;
+	profile_fast_init();
+}
+
+/*
+ * Every call site calls one function, the arcs are the call sites. A few
+ * sites take most of the calls, like in a real program.
+ */
+static void SetupFuncs(void)
+{
+	u32 Index;
+	u32 Sec;
+
+	for (Index = 0U; Index < FUNCS; Index++) {
+		Sec = Rand() % SECTIONS;
+		Funcs[Index] = SectionLow[Sec] +
+			((Rand() % (SectionSize[Sec] - 256U)) & ~3U);
+	}
+	for (Index = 0U; Index < SITES; Index++) {
+		SiteFrom[Index] = Funcs[Rand() % FUNCS] + ((Rand() % 32U) * 4U);
+		SiteSelf[Index] = Funcs[Rand() % FUNCS];
+	}
+}
+
+static u32 PickSite(void)
+{
+	u32 R = Rand();
+
+	if ((R & 3U) != 0U) {
+		return (R >> 2) % 64U;
+	}
+	return (R >> 2) % SITES;
+}
+
+static void RunTrace(double *FastNs, double *RefNs)
+{
+	static u32 From[CALLS];
+	static u32 Self[CALLS];
+	struct timespec T0, T1, T2;
+	u32 Index;
+	u32 Site;
+
+	for (Index = 0U; Index < CALLS; Index++) {
+		Site = PickSite();
+		From[Index] = SiteFrom[Site];
+		Self[Index] = SiteSelf[Site];
+		/* Calls from outside the sections are ignored by both */
+		if ((Index % 97U) == 0U) {
+			From[Index] = 0x00010000U + (Index & 0xFCU);
+		}
+	}
+
+	TimerToggles = 0U;
+	clock_gettime(CLOCK_MONOTONIC, &T0);
+	for (Index = 0U; Index < CALLS; Index++) {
+		mcount(From[Index], Self[Index]);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &T1);
+	for (Index = 0U; Index < CALLS; Index++) {
+		ref_mcount(From[Index], Self[Index]);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &T2);
+
+	/* Only the reference stops the profile timer around a call */
+	HOST_CHECK_EQ(TimerToggles, 2U * CALLS);
+
+	*FastNs = ((T1.tv_sec - T0.tv_sec) * 1e9 + (T1.tv_nsec - T0.tv_nsec)) /
+		  CALLS;
+	*RefNs = ((T2.tv_sec - T1.tv_sec) * 1e9 + (T2.tv_nsec - T1.tv_nsec)) /
+		 CALLS;
+
+	for (Index = 0U; Index < SAMPLES; Index++) {
+		if ((Index % 53U) == 0U) {
+			prof_pc = 0x40000000U + Index;
+		} else {
+			prof_pc = SiteFrom[PickSite()] + ((Rand() % 64U) * 4U);
+		}
+		ref_prof_pc = prof_pc;
+		profile_intr_handler();
+		ref_profile_intr_handler();
+		if ((Index % DRAIN_EVERY) == (DRAIN_EVERY - 1U)) {
+			profile_fast_drain(0U);
+		}
+	}
+	profile_fast_drain(1U);
+}
+
+static u32 RefArcCount(u32 Sec, u32 From, u32 Self)
+{
+	struct gmonparam *P = &RefParam[Sec];
+	u32 Index;
+	s32 To;
+
+	for (Index = 0U; Index < P->fromssize; Index++) {
+		if (P->froms[Index].frompc != From) {
+			continue;
+		}
+		To = P->froms[Index].link;
+		while (To != -1) {
+			To = ((s32)P->tossize - To) - 1;
+			if (P->tos[To].selfpc == Self) {
+				return (u32)P->tos[To].count;
+			}
+			To = P->tos[To].link;
+		}
+	}
+	return 0U;
+}
+
+static u32 RefArcTotal(void)
+{
+	u32 Sec;
+	u32 Total = 0U;
+
+	for (Sec = 0U; Sec < SECTIONS; Sec++) {
+		Total += RefParam[Sec].tossize;
+	}
+	return Total;
+}
+
+static s32 SectionOf(u32 Pc)
+{
+	s32 Sec;
+
+	for (Sec = 0; Sec < SECTIONS; Sec++) {
+		if ((Pc >= SectionLow[Sec]) &&
+		    (Pc < (SectionLow[Sec] + SectionSize[Sec]))) {
+			return Sec;
+		}
+	}
+	return -1;
+}
+
+static void CheckSame(void)
+{
+	const struct profile_arc *Arcs = profile_fast_arc_table();
+	u32 Index;
+	u32 Arcs1 = 0U;
+	s32 Sec;
+
+	for (Sec = 0; Sec < SECTIONS; Sec++) {
+		HOST_CHECK(memcmp(FastParam[Sec].kcount, RefParam[Sec].kcount,
+				  FastParam[Sec].kcountsize *
+				  sizeof(HISTCOUNTER)) == 0);
+		HOST_CHECK_EQ(FastParam[Sec].state, GMON_PROF_ON);
+	}
+
+	for (Index = 0U; Index < PROFILE_ARC_HASH_SIZE; Index++) {
+		if (Arcs[Index].count == 0U) {
+			continue;
+		}
+		Arcs1++;
+		Sec = SectionOf(Arcs[Index].frompc);
+		HOST_CHECK(Sec >= 0);
+		if (Sec >= 0) {
+			HOST_CHECK_EQ(Arcs[Index].count,
+				      RefArcCount((u32)Sec, Arcs[Index].frompc,
+						  Arcs[Index].selfpc));
+		}
+	}
+	HOST_CHECK_EQ(Arcs1, RefArcTotal());
+	HOST_CHECK_EQ(profile_fast_arc_count(), Arcs1);
+	HOST_CHECK_EQ(profile_fast_stats.arcs_dropped, 0U);
+	HOST_CHECK_EQ(profile_fast_stats.samples_dropped, 0U);
+	HOST_CHECK_EQ(profile_fast_stats.samples +
+		      profile_fast_stats.samples_outside, SAMPLES);
+}
+
+static void GmonPut(u8 C, void *Ref)
+{
+	(void)Ref;
+	if (GmonLen == GmonCap) {
+		GmonCap = (GmonCap != 0U) ? (GmonCap * 2U) : 4096U;
+		Gmon = realloc(Gmon, GmonCap);
+	}
+	Gmon[GmonLen++] = C;
+}
+
+/* DCC driver, records the stream sent by profile_gmon_dcc_putc */
+void XCoresightPs_DccSendByte(u32 BaseAddress, u8 Data)
+{
+	DccBase = BaseAddress;
+	if (DccLen < GmonLen) {
+		Dcc[DccLen] = Data;
+	}
+	DccLen++;
+}
+
+static u32 GetWord(u32 *Pos)
+{
+	u32 Value;
+
+	memcpy(&Value, &Gmon[*Pos], 4U);
+	*Pos += 4U;
+	return Value;
+}
+
+static void CheckGmon(void)
+{
+	const struct profile_arc *Arcs = profile_fast_arc_table();
+	u32 Pos = 20U;
+	u32 Sec = 0U;
+	u32 ArcCount = 0U;
+	u32 Low, High, Bins, From, Self, Count;
+	u32 Index;
+
+	GmonLen = 0U;
+	profile_fast_write_gmon(GmonPut, NULL);
+
+	HOST_CHECK(memcmp(Gmon, "gmon", 4U) == 0);
+	HOST_CHECK_EQ(Gmon[4], 1U);
+	for (Index = 8U; Index < 20U; Index++) {
+		HOST_CHECK_EQ(Gmon[Index], 0U);
+	}
+
+	while (Pos < GmonLen) {
+		if (Gmon[Pos] == 0U) {
+			Pos++;
+			Low = GetWord(&Pos);
+			High = GetWord(&Pos);
+			Bins = GetWord(&Pos);
+			HOST_CHECK_EQ(GetWord(&Pos), sample_freq_hz);
+			HOST_CHECK(memcmp(&Gmon[Pos], "seconds", 8U) == 0);
+			Pos += 15U;
+			HOST_CHECK_EQ(Gmon[Pos], 's');
+			Pos++;
+			HOST_CHECK(Sec < SECTIONS);
+			HOST_CHECK_EQ(Low, FastParam[Sec].lowpc);
+			HOST_CHECK_EQ(High, FastParam[Sec].highpc);
+			HOST_CHECK_EQ(Bins, FastParam[Sec].kcountsize);
+			HOST_CHECK(memcmp(&Gmon[Pos], RefParam[Sec].kcount,
+					  Bins * sizeof(HISTCOUNTER)) == 0);
+			Pos += Bins * (u32)sizeof(HISTCOUNTER);
+			Sec++;
+		} else if (Gmon[Pos] == 1U) {
+			Pos++;
+			From = GetWord(&Pos);
+			Self = GetWord(&Pos);
+			Count = GetWord(&Pos);
+			HOST_CHECK(SectionOf(From) >= 0);
+			if (SectionOf(From) >= 0) {
+				HOST_CHECK_EQ(Count, RefArcCount((u32)SectionOf(From),
+								 From, Self));
+			}
+			ArcCount++;
+		} else {
+			HOST_CHECK(0);
+			break;
+		}
+	}
+	HOST_CHECK_EQ(Pos, GmonLen);
+	HOST_CHECK_EQ(Sec, SECTIONS);
+	HOST_CHECK_EQ(ArcCount, RefArcTotal());
+
+	/* The arcs come out in hash table order */
+	Count = 0U;
+	for (Index = 0U; Index < PROFILE_ARC_HASH_SIZE; Index++) {
+		Count += (Arcs[Index].count != 0U) ? 1U : 0U;
+	}
+	HOST_CHECK_EQ(Count, ArcCount);
+
+	/* The DCC sink sends the same stream */
+	Dcc = malloc(GmonLen);
+	DccLen = 0U;
+	profile_fast_write_gmon(profile_gmon_dcc_putc, NULL);
+	HOST_CHECK_EQ(DccBase, XPAR_XCORESIGHTPS_DCC_0_BASEADDR);
+	HOST_CHECK_EQ(DccLen, GmonLen);
+	HOST_CHECK(memcmp(Dcc, Gmon, GmonLen) == 0);
+	free(Dcc);
+}
+
+static void CheckOverflow(void)
+{
+	const struct profile_arc *Arcs = profile_fast_arc_table();
+	u32 Index;
+	u32 Samples = 2U * PROFILE_SAMPLE_BUF_SIZE + 100U;
+	u32 Distinct = PROFILE_ARC_HASH_SIZE + 512U;
+
+	SetupSections(BINSIZE);
+
+	/* Nothing drains the ring, the first two halves are kept */
+	for (Index = 0U; Index < Samples; Index++) {
+		prof_pc = SectionLow[1] + (Index * 4U) % SectionSize[1];
+		profile_intr_handler();
+	}
+	HOST_CHECK_EQ(profile_fast_stats.samples_dropped, 100U);
+	profile_fast_drain(1U);
+	HOST_CHECK_EQ(profile_fast_stats.samples, 2U * PROFILE_SAMPLE_BUF_SIZE);
+
+	/* More distinct arcs than slots */
+	for (Index = 0U; Index < Distinct; Index++) {
+		mcount(SectionLow[1] + (Index * 4U), SectionLow[0]);
+	}
+	HOST_CHECK(profile_fast_stats.arcs <= PROFILE_ARC_HASH_SIZE);
+	HOST_CHECK(profile_fast_stats.arcs_dropped >= Distinct -
+		   PROFILE_ARC_HASH_SIZE);
+	HOST_CHECK_EQ(profile_fast_stats.arcs + profile_fast_stats.arcs_dropped,
+		      Distinct);
+	HOST_CHECK(profile_fast_stats.max_probe < PROFILE_ARC_MAX_PROBE);
+	HOST_CHECK_EQ(FastParam[1].state, GMON_PROF_ERROR);
+
+	/* A recorded arc keeps counting */
+	for (Index = 0U; Index < PROFILE_ARC_HASH_SIZE; Index++) {
+		if (Arcs[Index].count != 0U) {
+			break;
+		}
+	}
+	Samples = Arcs[Index].count;
+	mcount(Arcs[Index].frompc, Arcs[Index].selfpc);
+	HOST_CHECK_EQ(Arcs[Index].count, Samples + 1U);
+
+	/* Calls from outside every section are not recorded */
+	Samples = profile_fast_stats.arcs;
+	mcount(0x00010000U, SectionLow[0]);
+	HOST_CHECK_EQ(profile_fast_stats.arcs, Samples);
+}
+
+static int Run(void *Arg)
+{
+	static const u32 Bins[] = { 4U, 3U };
+	double FastNs, RefNs;
+	u32 Index;
+
+	(void)Arg;
+	HostIo_Map(PROFILE_TIMER_BASEADDR, 0x20U, 0U, TimerRead, TimerWrite,
+		   NULL);
+	Seed = 1U;
+	SetupFuncs();
+
+	for (Index = 0U; Index < 2U; Index++) {
+		SetupSections(Bins[Index]);
+		TimerAcks = 0U;
+		RunTrace(&FastNs, &RefNs);
+		CheckSame();
+		CheckGmon();
+		HOST_CHECK_EQ(TimerAcks, 2U * SAMPLES);
+		printf("binsize %u: %u arcs, %u samples, %u outside, "
+		       "max probe %u, host ns/call fast %.1f ref %.1f\n",
+		       binsize, profile_fast_stats.arcs,
+		       profile_fast_stats.samples,
+		       profile_fast_stats.samples_outside,
+		       profile_fast_stats.max_probe, FastNs, RefNs);
+	}
+
+	CheckOverflow();
+	return 0;
+}
+
+int main(void)
+{
+	Host_Init();
+	Host_RunLow(Run, NULL);
+	return Host_Result("profile");
+}
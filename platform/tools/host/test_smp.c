@@ -0,0 +1,388 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file test_smp.c
+*
+* Runs the dual core FSBL boot mode of smp.c (FSBL_SMP) on two host CPUs.
+*
+* CPU1 starts in a model of the Boot ROM wait loop: WFE, read 0xFFFFFFF0,
+* jump if it is not zero. FsblSmpEntry and FsblSmpCpu1Exit are assembly
+* on the target, here FsblSmpEntry calls FsblSmpCpu1Main and
+* FsblSmpCpu1Exit does what fsbl_smp.S does in C: clear 0xFFFFFFF0, report
+* parked and go back to the same wait loop.
+*
+* - A single core device and a CPU1 that never comes up fall back to CPU0,
+*   in the second case CPU1 is held in reset.
+* - Checksum jobs through the 8 entry queue, with CPU0 blocking on a full
+*   queue. Every job runs once, in order, after an L1 D-cache flush.
+* - A failed check is reported with its partition, the jobs behind it are
+*   skipped and further queueing fails.
+* - Parking drains the queue, leaves CPU1 with its D-cache off and
+*   0xFFFFFFF0 cleared, and CPU1 then starts the next image the Boot ROM
+*   way.
+* - A WFE that is never followed by an SEV of the other CPU stops the test,
+*   see host.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <string.h>
+
+#include "host.h"
+#include "fsbl.h"
+#include "smp.h"
+#include "md5.h"
+#include "xil_mmu.h"
+#include "xil_spinlock.h"
+
+#define A9_CPU_RST_CTRL_REG	(XPS_SYS_CTRL_BASEADDR + 0x244U)
+#define PARTITIONS		40U
+#define PARTITION_SIZE		0x4000U
+
+u32 MMUTable[4096] __attribute__ ((aligned(16384)));
+
+static u32 Efuse;
+static u32 RstCtrl;
+static volatile u32 StartAddr;
+static volatile u32 Cpu1Entries;
+static volatile u32 Cpu1DCache;
+static volatile u32 Cpu1Flushes;
+static volatile u32 Cpu1Parks;
+static volatile u32 Cpu1Images;
+static u32 Cpu1;
+static u8 *Data[PARTITIONS];
+static u8 Sums[PARTITIONS][FSBL_SMP_CHECKSUM_SIZE];
+static u32 Seed = 3U;
+
+static u32 Rand(void)
+{
+	Seed = Seed * 1103515245U + 12345U;
+	return Seed >> 8;
+}
+
+/*****************************************************************************/
+/*
+ * Device models: eFuse status, SLCR CPU reset control, top of the OCM
+ */
+static u32 EfuseRead(void *Ref, u32 Offset, u32 Size)
+{
+	return Efuse;
+}
+
+static u32 RstRead(void *Ref, u32 Offset, u32 Size)
+{
+	return RstCtrl;
+}
+
+static void RstWrite(void *Ref, u32 Offset, u32 Value, u32 Size)
+{
+	RstCtrl = Value;
+}
+
+static u32 OcmTopRead(void *Ref, u32 Offset, u32 Size)
+{
+	return (Offset == 0U) ? StartAddr : 0U;
+}
+
+static void OcmTopWrite(void *Ref, u32 Offset, u32 Value, u32 Size)
+{
+	if (Offset == 0U) {
+		StartAddr = Value;
+	}
+}
+
+/*****************************************************************************/
+/*
+ * CPU1 side, the parts that are assembly on the target
+ */
+static void RomWaitLoop(void)
+{
+	u32 Start;
+
+	for (;;) {
+		wfe();
+		Start = Xil_In32(FSBL_SMP_CPU1_START_ADDR);
+		if (Start != 0U) {
+			break;
+		}
+	}
+	((void (*)(void))(UINTPTR)Start)();
+}
+
+static int Cpu1Reset(void *Arg)
+{
+	(void)Arg;
+	RomWaitLoop();
+	return 0;
+}
+
+void FsblSmpEntry(void)
+{
+	Cpu1Entries++;
+	FsblSmpCpu1Main();
+}
+
+void FsblSmpCpu1Exit(u32 ParkAddr, volatile u32 *State)
+{
+	HOST_CHECK_EQ(ParkAddr, FSBL_SMP_PARK_ADDR);
+	HOST_CHECK_EQ(Cpu1DCache, 0U);
+	Xil_Out32(FSBL_SMP_CPU1_START_ADDR, 0U);
+	dsb();
+	*State = FSBL_SMP_STATE_PARKED;
+	Cpu1Parks++;
+	RomWaitLoop();
+}
+
+/* The application image CPU0 hands CPU1 after the FSBL */
+static void NextImage(void)
+{
+	Cpu1Images++;
+}
+
+void Xil_L1DCacheEnable(void)
+{
+	Cpu1DCache = 1U;
+}
+
+void Xil_L1DCacheDisable(void)
+{
+	Cpu1DCache = 0U;
+}
+
+void Xil_L1DCacheFlush(void)
+{
+	HOST_CHECK_EQ(Cpu1DCache, 1U);
+	Cpu1Flushes++;
+}
+
+/*
+ * xil_spinlock.c is ARM assembly, the same protocol on the lock word with
+ * host atomics
+ */
+static UINTPTR LockAddr;
+static UINTPTR LockFlagAddr;
+
+u32 Xil_SpinLock(void)
+{
+	u32 Expected;
+
+	if (LockAddr == 0U) {
+		return XST_FAILURE;
+	}
+	do {
+		Expected = XIL_SPINLOCK_RESETVAL;
+	} while (!__atomic_compare_exchange_n((u32 *)LockAddr, &Expected,
+					      XIL_SPINLOCK_LOCKVAL, 0,
+					      __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+	return XST_SUCCESS;
+}
+
+u32 Xil_SpinUnlock(void)
+{
+	if (LockAddr == 0U) {
+		return XST_FAILURE;
+	}
+	HOST_CHECK_EQ(*(volatile u32 *)LockAddr, XIL_SPINLOCK_LOCKVAL);
+	__atomic_store_n((u32 *)LockAddr, XIL_SPINLOCK_RESETVAL, __ATOMIC_RELEASE);
+	return XST_SUCCESS;
+}
+
+u32 Xil_InitializeSpinLock(UINTPTR lockaddr, UINTPTR lockflagaddr, u32 lockflag)
+{
+	if (LockFlagAddr != 0U) {
+		return XST_FAILURE;
+	}
+	LockFlagAddr = lockflagaddr;
+	LockAddr = lockaddr;
+	*(volatile u32 *)LockAddr = XIL_SPINLOCK_RESETVAL;
+	*(volatile u32 *)LockFlagAddr = lockflag;
+	return XST_SUCCESS;
+}
+
+void Xil_ReleaseSpinLock(void)
+{
+	LockAddr = 0U;
+	LockFlagAddr = 0U;
+}
+
+u32 Xil_IsSpinLockEnabled(void)
+{
+	return ((LockFlagAddr != 0U) &&
+		(*(volatile u32 *)LockFlagAddr == XIL_SPINLOCK_ENABLED)) ? 1U : 0U;
+}
+
+/*****************************************************************************/
+/* Pages mapped strongly ordered, only the shared page of smp.c should be */
+static u32 StrongPages(void)
+{
+	u32 Section;
+	u32 Page;
+	u32 *L2;
+	u32 Count = 0U;
+
+	for (Section = 0U; Section < 4096U; Section++) {
+		if ((MMUTable[Section] & XIL_MMU_SECT_TYPE_MASK) !=
+		    XIL_MMU_SECT_COARSE) {
+			continue;
+		}
+		L2 = (u32 *)(UINTPTR)(MMUTable[Section] & XIL_MMU_COARSE_BASE_MASK);
+		for (Page = 0U; Page < XIL_MMU_L2_ENTRIES; Page++) {
+			if ((L2[Page] & ~XIL_MMU_PAGE_BASE_MASK) ==
+			    Xil_MmuPageDescriptor(0U, STRONG_ORDERED)) {
+				Count++;
+			}
+		}
+	}
+	return Count;
+}
+
+static void PowerOnCpu1(void)
+{
+	StartAddr = 0U;
+	Cpu1 = Host_StartCpu(Cpu1Reset, NULL);
+}
+
+static void TestNoCpu1(void)
+{
+	/* Single core device, CPU1 is not touched */
+	Efuse = 0x80U;
+	HOST_CHECK_EQ(FsblSmpStart(), XST_FAILURE);
+	HOST_CHECK_EQ(FsblSmpActive(), 0U);
+	HOST_CHECK_EQ(StartAddr, 0U);
+
+	/* CPU1 does not answer, it is held in reset */
+	Efuse = 0U;
+	HOST_CHECK_EQ(FsblSmpStart(), XST_FAILURE);
+	HOST_CHECK_EQ(FsblSmpActive(), 0U);
+	HOST_CHECK_EQ(RstCtrl & 0x22U, 0x22U);
+	HOST_CHECK_EQ(FsblSmpWaitAll(), XST_SUCCESS);
+	RstCtrl = 0U;
+}
+
+static void TestQueue(void)
+{
+	u32 Index;
+
+	PowerOnCpu1();
+	HOST_CHECK_EQ(FsblSmpStart(), XST_SUCCESS);
+	HOST_CHECK_EQ(FsblSmpActive(), 1U);
+	HOST_CHECK_EQ(Cpu1Entries, 1U);
+	HOST_CHECK_EQ(StrongPages(), 1U);
+
+	/* More jobs than slots, CPU0 waits for CPU1 to take them */
+	for (Index = 0U; Index < PARTITIONS; Index++) {
+		HOST_CHECK_EQ(FsblSmpQueueChecksum((u32)(UINTPTR)Data[Index],
+			PARTITION_SIZE, Sums[Index], Index), XST_SUCCESS);
+		if ((Rand() % 8U) == 0U) {
+			HOST_CHECK_EQ(FsblSmpWaitAll(), XST_SUCCESS);
+		}
+	}
+	HOST_CHECK_EQ(FsblSmpWaitAll(), XST_SUCCESS);
+	HOST_CHECK_EQ(Cpu1Flushes, PARTITIONS);
+	HOST_CHECK_EQ(Cpu1DCache, 1U);
+}
+
+static void TestFailure(void)
+{
+	u32 Flushes = Cpu1Flushes;
+	u32 Bad = 5U;
+	u32 Index;
+	u32 Status;
+	u8 Wrong[FSBL_SMP_CHECKSUM_SIZE];
+
+	memcpy(Wrong, Sums[Bad], sizeof(Wrong));
+	Wrong[3] ^= 0x10U;
+	for (Index = 0U; Index < 12U; Index++) {
+		Status = FsblSmpQueueChecksum((u32)(UINTPTR)Data[Index],
+			PARTITION_SIZE, (Index == Bad) ? Wrong : Sums[Index], Index);
+		if (Status != XST_SUCCESS) {
+			/* Only once CPU1 has seen the failure */
+			HOST_CHECK(Index > Bad);
+			HOST_CHECK_EQ(Status, PARTITION_CHECKSUM_FAIL);
+			break;
+		}
+	}
+	HOST_CHECK_EQ(FsblSmpWaitAll(), PARTITION_CHECKSUM_FAIL);
+	/* The jobs behind the failed one are not run */
+	HOST_CHECK_EQ(Cpu1Flushes - Flushes, Bad + 1U);
+	HOST_CHECK_EQ(FsblSmpQueueChecksum((u32)(UINTPTR)Data[0], PARTITION_SIZE,
+					   Sums[0], 0U), PARTITION_CHECKSUM_FAIL);
+}
+
+static void TestPark(void)
+{
+	FsblSmpPark();
+	HOST_CHECK_EQ(FsblSmpActive(), 0U);
+	HOST_CHECK_EQ(Cpu1Parks, 1U);
+	HOST_CHECK_EQ(StartAddr, 0U);
+	HOST_CHECK_EQ(RstCtrl & 0x22U, 0U);
+	/* Parking twice does nothing */
+	FsblSmpPark();
+	HOST_CHECK_EQ(Cpu1Parks, 1U);
+
+	/* The application starts CPU1 as the Boot ROM protocol says */
+	Xil_Out32(FSBL_SMP_CPU1_START_ADDR, (u32)(UINTPTR)NextImage);
+	dsb();
+	sev();
+	Host_JoinCpu(Cpu1);
+	HOST_CHECK_EQ(Cpu1Images, 1U);
+	HOST_CHECK_EQ(Cpu1Entries, 1U);
+}
+
+static int Run(void *Arg)
+{
+	static const u8 Abc[16] = {
+		0x90, 0x01, 0x50, 0x98, 0x3c, 0xd2, 0x4f, 0xb0,
+		0xd6, 0x96, 0x3f, 0x7d, 0x28, 0xe1, 0x7f, 0x72
+	};
+	u8 Digest[16];
+	u32 Index;
+	u32 Byte;
+
+	(void)Arg;
+	for (Index = 0U; Index < 4096U; Index++) {
+		MMUTable[Index] = (Index << 20) | NORM_WB_CACHE;
+	}
+	HostIo_Map(EFUSE_STATUS_REG, 4U, 0U, EfuseRead, NULL, NULL);
+	HostIo_Map(A9_CPU_RST_CTRL_REG, 4U, 0U, RstRead, RstWrite, NULL);
+	HostIo_Map(FSBL_SMP_CPU1_START_ADDR, 0x10U, 0U, OcmTopRead, OcmTopWrite,
+		   NULL);
+
+	md5((u8 *)"abc", 3U, Digest, 0);
+	HOST_CHECK(memcmp(Digest, Abc, sizeof(Abc)) == 0);
+	for (Index = 0U; Index < PARTITIONS; Index++) {
+		Data[Index] = Host_AllocLow(PARTITION_SIZE, 64U);
+		for (Byte = 0U; Byte < PARTITION_SIZE; Byte++) {
+			Data[Index][Byte] = (u8)Rand();
+		}
+		md5(Data[Index], PARTITION_SIZE, Sums[Index], 0);
+	}
+
+	TestNoCpu1();
+	TestQueue();
+	TestFailure();
+	TestPark();
+	printf("smp: %u checks on CPU1, %llu SEV, %llu WFE\n", Cpu1Flushes,
+	       (unsigned long long)Host_Stats.Sev,
+	       (unsigned long long)Host_Stats.Wfe);
+	return 0;
+}
+
+int main(void)
+{
+	Host_Init();
+	Host_RunLow(Run, NULL);
+	return Host_Result("smp");
+}
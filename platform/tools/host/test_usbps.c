@@ -0,0 +1,629 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file test_usbps.c
+*
+* Tests the bulk paths of the usbps driver against the controller model in
+* models/usbps_model.c. Interrupts are delivered when the driver side
+* waits, a wait with buffers queued and neither a controller event nor an
+* interrupt pending is a stall and fails the test.
+*
+* - Streaming IN: random buffer lengths from 0 to 64 KB (several dTDs per
+*   buffer, zero length packets) reach the host intact and in order, the
+*   callbacks report every buffer once with its length.
+* - Streaming OUT: host transfers of random length, ended by a short
+*   packet, a zero length packet or a full 16 KB dTD, with pauses of the
+*   host, land in the submitted buffers in order with the right length.
+* - Cached buffers get their cache maintenance, buffers of a non-cacheable
+*   DMA buffer pool arena none.
+* - XUsbPs_StreamStop and a bus reset return the queued buffers with
+*   XST_DATA_LOST, the stream works again afterwards.
+* - XUsbPs_EpBufferSend, the ring the stream replaces, still delivers.
+* - The driver never primes a ready endpoint and never changes a dTD the
+*   controller owns (model Violations).
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <string.h>
+
+#include "host.h"
+#include "usbps_model.h"
+#include "xil_dmapool.h"
+#include "xil_mmu.h"
+#include "xpseudo_asm.h"
+#include "xstatus.h"
+#include "xusbps.h"
+#include "xusbps_hw.h"
+
+#define USB_BASE	0xE0002000U
+/* Model parameters, the test does not depend on their values */
+#define ACCESS_NS	100U
+#define FETCH_NS	1000U
+#define IRQ_NS		2000U
+
+#define IN_DTDS		32U
+#define OUT_DTDS	16U
+#define MAX_PACKET	512U
+#define DTD_MAX		XUSBPS_dTD_BUF_MAX_SIZE
+#define IN_MAX		(4U * DTD_MAX)
+#define DEPTH		4U
+#define OUT_BUFS	8U
+
+#define AREA_SIZE	(256U * 1024U)
+#define MAX_XFERS	4096U
+#define IN_XFERS	1500U
+#define OUT_XFERS	2000U
+#define LEGACY_XFERS	300U
+
+u32 MMUTable[4096] __attribute__ ((aligned(16384)));
+
+/* Defined in xil_cache.c, whose maintenance host_rt.c replaces */
+UINTPTR XilDmaPoolCoherentBase;
+u32 XilDmaPoolCoherentSize;
+
+typedef struct {
+	u8 *Buf;
+	u32 Len;
+	u32 Off;		/* Bytes seen by the host */
+} Xfer;
+
+static XUsbPs Usb;
+static UsbPsModel Model;
+static XUsbPs_Stream InStream;
+static XUsbPs_Stream OutStream;
+static u32 Mapped;
+static u8 *DmaMem;
+static u8 *Cached;
+static u8 *Coherent;
+static u8 *Area;		/* Cached or Coherent */
+static u32 Seed = 7U;
+
+/* IN: submitted buffers, the host checks the data against them */
+static Xfer Xfers[MAX_XFERS];
+static u32 Submitted;
+static u32 Completed;
+static u32 HostIndex;
+static u32 Target;
+static u32 Verify;
+static u32 Lost;
+
+/* OUT: the transfers the host sends */
+static u32 TxIndex;
+static u32 Paused;
+static u32 Pauses;
+
+static u32 Resets;
+static u32 AreaFlushes;
+static u32 AreaInvals;
+
+static u32 Rand(void)
+{
+	Seed = Seed * 1103515245U + 12345U;
+	return Seed >> 8;
+}
+
+static u8 Pattern(u32 Index, u32 Offset)
+{
+	return (u8)((Index * 131U) + (Offset * 7U) + (Offset >> 9));
+}
+
+/*****************************************************************************/
+/*
+ * Host side of the bus
+ */
+static void HostIn(void *Ref, u32 Pipe, const u8 *Buf, u32 Len)
+{
+	Xfer *X = &Xfers[HostIndex % MAX_XFERS];
+
+	(void)Ref;
+	(void)Pipe;
+	if (Verify == 0U) {
+		return;
+	}
+	HOST_CHECK(HostIndex < Submitted);
+	HOST_CHECK(X->Off + Len <= X->Len);
+	if ((HostIndex < Submitted) && (X->Off + Len <= X->Len)) {
+		HOST_CHECK(memcmp(Buf, X->Buf + X->Off, Len) == 0);
+	}
+	X->Off += Len;
+	if (X->Off >= X->Len) {
+		HostIndex++;
+	}
+}
+
+static void Resume(void *Ref)
+{
+	(void)Ref;
+	Paused = 0U;
+	UsbPsModel_Kick(&Model);
+}
+
+static u32 HostOut(void *Ref, u32 Pipe, u8 *Buf, u32 MaxPacket)
+{
+	Xfer *X = &Xfers[TxIndex % MAX_XFERS];
+	u32 Len;
+	u32 Index;
+
+	(void)Ref;
+	(void)Pipe;
+	if ((Paused != 0U) || (TxIndex == Target)) {
+		return USBPS_MODEL_NO_DATA;
+	}
+	if ((Rand() % 64U) == 0U) {
+		Paused = 1U;
+		Pauses++;
+		Host_Schedule(Host_Now() + (Rand() % 300000U), Resume, NULL);
+		return USBPS_MODEL_NO_DATA;
+	}
+	Len = X->Len - X->Off;
+	if (Len > MaxPacket) {
+		Len = MaxPacket;
+	}
+	for (Index = 0U; Index < Len; Index++) {
+		Buf[Index] = Pattern(TxIndex, X->Off + Index);
+	}
+	X->Off += Len;
+	/* A short packet or a full dTD ends the transfer */
+	if ((Len < MaxPacket) || (X->Off == DTD_MAX)) {
+		TxIndex++;
+	}
+	return Len;
+}
+
+/*****************************************************************************/
+/*
+ * Driver side
+ */
+static void Interrupt(void *Ref)
+{
+	(void)Ref;
+	while (UsbPsModel_IrqPending(&Model) != 0U) {
+		Host_Advance(IRQ_NS);
+		XUsbPs_IntrHandler(&Usb);
+	}
+}
+
+static void ResetHandler(void *Ref, u32 IrqMask)
+{
+	(void)Ref;
+	if ((IrqMask & XUSBPS_IXR_UR_MASK) != 0U) {
+		Resets++;
+	}
+}
+
+static void CacheOp(u32 Op, UINTPTR Addr, u32 Len, void *Ref)
+{
+	(void)Len;
+	(void)Ref;
+	if ((Addr - (UINTPTR)Area) >= AREA_SIZE) {
+		return;
+	}
+	if (Op == HOST_CACHE_DFLUSH_RANGE) {
+		AreaFlushes++;
+	} else if (Op == HOST_CACHE_DINVAL_RANGE) {
+		AreaInvals++;
+	}
+}
+
+/* Waits until Completed reaches Count, returns 0 on a stall */
+static u32 WaitFor(u32 Count)
+{
+	while (Completed < Count) {
+		if ((Host_EventsPending() == 0U) &&
+		    (UsbPsModel_IrqPending(&Model) == 0U)) {
+			return 0U;
+		}
+		wfi();
+	}
+	return 1U;
+}
+
+static void Setup(void)
+{
+	static XUsbPs_DeviceConfig Cfg;
+
+	if (Mapped != 0U) {
+		/* Drops the events of the old controller */
+		(void)XUsbPs_Reset(&Usb);
+		HostIo_Unmap(USB_BASE);
+	}
+	Host_Cancel(Resume, NULL);
+	UsbPsModel_Init(&Model, USB_BASE, ACCESS_NS, FETCH_NS);
+	Mapped = 1U;
+	Model.In = HostIn;
+	Model.Out = HostOut;
+
+	HOST_CHECK_EQ(XUsbPs_CfgInitialize(&Usb, XUsbPs_LookupConfig(USB_BASE),
+					   USB_BASE), XST_SUCCESS);
+	memset(&Cfg, 0, sizeof(Cfg));
+	Cfg.NumEndpoints = 2U;
+	Cfg.EpCfg[0].Out.Type = XUSBPS_EP_TYPE_CONTROL;
+	Cfg.EpCfg[0].Out.NumBufs = 2U;
+	Cfg.EpCfg[0].Out.BufSize = 64U;
+	Cfg.EpCfg[0].Out.MaxPacketSize = 64U;
+	Cfg.EpCfg[0].In.Type = XUSBPS_EP_TYPE_CONTROL;
+	Cfg.EpCfg[0].In.NumBufs = 2U;
+	Cfg.EpCfg[0].In.MaxPacketSize = 64U;
+	Cfg.EpCfg[1].Out.Type = XUSBPS_EP_TYPE_BULK;
+	Cfg.EpCfg[1].Out.NumBufs = OUT_DTDS;
+	Cfg.EpCfg[1].Out.MaxPacketSize = MAX_PACKET;
+	Cfg.EpCfg[1].In.Type = XUSBPS_EP_TYPE_BULK;
+	Cfg.EpCfg[1].In.NumBufs = IN_DTDS;
+	Cfg.EpCfg[1].In.MaxPacketSize = MAX_PACKET;
+	Cfg.DMAMemPhys = (u32)(UINTPTR)DmaMem;
+	HOST_CHECK_EQ(XUsbPs_ConfigureDevice(&Usb, &Cfg), XST_SUCCESS);
+	(void)XUsbPs_IntrSetHandler(&Usb, ResetHandler, NULL,
+				    XUSBPS_IXR_UR_MASK);
+	XUsbPs_IntrEnable(&Usb, XUSBPS_IXR_UI_MASK | XUSBPS_IXR_UE_MASK |
+			  XUSBPS_IXR_UR_MASK);
+	XUsbPs_Start(&Usb);
+
+	Submitted = 0U;
+	Completed = 0U;
+	HostIndex = 0U;
+	TxIndex = 0U;
+	Paused = 0U;
+	Lost = 0U;
+	Verify = 1U;
+}
+
+/*****************************************************************************/
+/*
+ * Streaming IN
+ */
+static u32 InLength(void)
+{
+	switch (Rand() % 6U) {
+	case 0U:
+		return 0U;
+	case 1U:
+		return (1U + (Rand() % 4U)) * DTD_MAX;
+	case 2U:
+		return (1U + (Rand() % 32U)) * MAX_PACKET;
+	case 3U:
+		return 1U + (Rand() % MAX_PACKET);
+	default:
+		return Rand() % (IN_MAX + 1U);
+	}
+}
+
+static void SubmitIn(void)
+{
+	Xfer *X = &Xfers[Submitted % MAX_XFERS];
+
+	X->Len = InLength();
+	X->Buf = Area + (Rand() % (AREA_SIZE - IN_MAX));
+	X->Off = 0U;
+	Submitted++;
+	HOST_CHECK_EQ(XUsbPs_StreamSubmit(&InStream, X->Buf, X->Len),
+		      XST_SUCCESS);
+}
+
+static void InDone(void *Ref, u8 *BufferPtr, u32 BufferLen, u32 BytesTxed,
+		   s32 Status)
+{
+	Xfer *X = &Xfers[Completed % MAX_XFERS];
+
+	(void)Ref;
+	Completed++;
+	HOST_CHECK(BufferPtr == X->Buf);
+	HOST_CHECK_EQ(BufferLen, X->Len);
+	if (Status == XST_DATA_LOST) {
+		Lost++;
+		return;
+	}
+	HOST_CHECK_EQ(Status, XST_SUCCESS);
+	HOST_CHECK_EQ(BytesTxed, X->Len);
+	if (Submitted < Target) {
+		SubmitIn();
+	}
+}
+
+static void TestIn(u8 *Buffers)
+{
+	u32 Index;
+
+	Area = Buffers;
+	Setup();
+	AreaFlushes = 0U;
+	Target = IN_XFERS;
+	HOST_CHECK_EQ(XUsbPs_StreamStart(&Usb, &InStream, 1U,
+					 XUSBPS_EP_DIRECTION_IN, InDone, NULL),
+		      XST_SUCCESS);
+	HOST_CHECK_EQ(XUsbPs_StreamStart(&Usb, &InStream, 1U,
+					 XUSBPS_EP_DIRECTION_IN, InDone, NULL),
+		      XST_DEVICE_BUSY);
+	HOST_CHECK_EQ(XUsbPs_StreamSubmit(&InStream, Area, IN_DTDS * DTD_MAX),
+		      XST_USB_BUF_TOO_BIG);
+	for (Index = 0U; Index < DEPTH; Index++) {
+		SubmitIn();
+	}
+	HOST_CHECK(WaitFor(Target) != 0U);
+	HOST_CHECK_EQ(HostIndex, Target);
+	HOST_CHECK_EQ(XUsbPs_StreamPending(&InStream), 0U);
+	HOST_CHECK_EQ(InStream.XfersDone, Target);
+	HOST_CHECK_EQ(AreaFlushes, (Buffers == Cached) ? Target : 0U);
+	printf("usbps: IN %s, %u buffers, %u reprimes\n",
+	       (Buffers == Cached) ? "cached" : "coherent", Target,
+	       InStream.Reprimes);
+	XUsbPs_StreamStop(&InStream);
+}
+
+/*****************************************************************************/
+/*
+ * Streaming OUT
+ */
+static void OutDone(void *Ref, u8 *BufferPtr, u32 BufferLen, u32 BytesTxed,
+		    s32 Status)
+{
+	Xfer *X = &Xfers[Completed % MAX_XFERS];
+	u32 Index;
+
+	(void)Ref;
+	HOST_CHECK_EQ(BufferLen, DTD_MAX);
+	HOST_CHECK(BufferPtr == (Area + ((Completed % OUT_BUFS) * DTD_MAX)));
+	if (Status == XST_DATA_LOST) {
+		Completed++;
+		Lost++;
+		return;
+	}
+	HOST_CHECK_EQ(Status, XST_SUCCESS);
+	HOST_CHECK_EQ(BytesTxed, X->Len);
+	for (Index = 0U; Index < BytesTxed; Index++) {
+		if (BufferPtr[Index] != Pattern(Completed, Index)) {
+			HOST_CHECK_EQ(BufferPtr[Index], Pattern(Completed, Index));
+			break;
+		}
+	}
+	Completed++;
+	if (Submitted < Target) {
+		Submitted++;
+		HOST_CHECK_EQ(XUsbPs_StreamSubmit(&OutStream, BufferPtr, DTD_MAX),
+			      XST_SUCCESS);
+	}
+}
+
+static void TestOut(u8 *Buffers)
+{
+	u32 Index;
+
+	Area = Buffers;
+	Setup();
+	AreaInvals = 0U;
+	Pauses = 0U;
+	Target = OUT_XFERS;
+	for (Index = 0U; Index < Target; Index++) {
+		switch (Rand() % 5U) {
+		case 0U:
+			Xfers[Index].Len = (Rand() % 33U) * MAX_PACKET;
+			break;
+		case 1U:
+			Xfers[Index].Len = Rand() % 4U;
+			break;
+		default:
+			Xfers[Index].Len = Rand() % (DTD_MAX + 1U);
+			break;
+		}
+		Xfers[Index].Off = 0U;
+	}
+	HOST_CHECK_EQ(XUsbPs_StreamStart(&Usb, &OutStream, 1U,
+					 XUSBPS_EP_DIRECTION_OUT, OutDone, NULL),
+		      XST_SUCCESS);
+	HOST_CHECK_EQ(XUsbPs_StreamSubmit(&OutStream, Area, DTD_MAX + 1U),
+		      XST_USB_BUF_TOO_BIG);
+	for (Index = 0U; Index < OUT_BUFS; Index++) {
+		Submitted++;
+		HOST_CHECK_EQ(XUsbPs_StreamSubmit(&OutStream,
+						  Area + (Index * DTD_MAX),
+						  DTD_MAX), XST_SUCCESS);
+	}
+	HOST_CHECK(WaitFor(Target) != 0U);
+	HOST_CHECK_EQ(TxIndex, Target);
+	HOST_CHECK(Pauses != 0U);
+	if (Buffers == Cached) {
+		HOST_CHECK(AreaInvals >= Target);
+	} else {
+		HOST_CHECK_EQ(AreaInvals, 0U);
+	}
+	printf("usbps: OUT %s, %u transfers, %u host pauses, %u reprimes\n",
+	       (Buffers == Cached) ? "cached" : "coherent", Target, Pauses,
+	       OutStream.Reprimes);
+	XUsbPs_StreamStop(&OutStream);
+}
+
+/*****************************************************************************/
+/*
+ * Stop and bus reset
+ */
+static void FixedIn(u32 Len)
+{
+	Xfer *X = &Xfers[Submitted % MAX_XFERS];
+
+	X->Len = Len;
+	X->Buf = Area;
+	X->Off = 0U;
+	Submitted++;
+	HOST_CHECK_EQ(XUsbPs_StreamSubmit(&InStream, X->Buf, X->Len),
+		      XST_SUCCESS);
+}
+
+static void ResetDone(void *Ref, u8 *BufferPtr, u32 BufferLen,
+		      u32 BytesTxed, s32 Status)
+{
+	(void)Ref;
+	(void)BufferPtr;
+	(void)BufferLen;
+	(void)BytesTxed;
+	Completed++;
+	if (Status == XST_DATA_LOST) {
+		Lost++;
+	} else {
+		HOST_CHECK_EQ(Status, XST_SUCCESS);
+	}
+}
+
+static void BusReset(void *Ref)
+{
+	(void)Ref;
+	UsbPsModel_BusReset(&Model);
+}
+
+static void TestStop(void)
+{
+	u32 Index;
+
+	Area = Cached;
+	Setup();
+	Target = 0U;
+	(void)XUsbPs_StreamStart(&Usb, &InStream, 1U, XUSBPS_EP_DIRECTION_IN,
+				 InDone, NULL);
+	for (Index = 0U; Index < DEPTH; Index++) {
+		FixedIn(IN_MAX);
+	}
+	HOST_CHECK(WaitFor(1U) != 0U);
+	HOST_CHECK_EQ(Lost, 0U);
+	XUsbPs_StreamStop(&InStream);
+	HOST_CHECK_EQ(Completed, DEPTH);
+	HOST_CHECK_EQ(Lost, DEPTH - 1U);
+	HOST_CHECK_EQ(XUsbPs_StreamPending(&InStream), 0U);
+	HOST_CHECK_EQ(Model.Regs[XUSBPS_EPRDY_OFFSET / 4U] & 0x00020000U, 0U);
+	HOST_CHECK_EQ(Host_EventsPending(), 0U);
+
+	/* Restarted, the host drops what it got of the flushed buffers */
+	HOST_CHECK_EQ(XUsbPs_StreamStart(&Usb, &InStream, 1U,
+					 XUSBPS_EP_DIRECTION_IN, InDone, NULL),
+		      XST_SUCCESS);
+	HostIndex = Submitted;
+	FixedIn(5000U);
+	HOST_CHECK(WaitFor(Completed + 1U) != 0U);
+	HOST_CHECK_EQ(HostIndex, Submitted);
+	HOST_CHECK_EQ(Lost, DEPTH - 1U);
+	XUsbPs_StreamStop(&InStream);
+
+	/* A bus reset while both directions stream, the host sends nothing */
+	Setup();
+	Target = 0U;
+	Verify = 0U;
+	(void)XUsbPs_StreamStart(&Usb, &InStream, 1U, XUSBPS_EP_DIRECTION_IN,
+				 ResetDone, NULL);
+	(void)XUsbPs_StreamStart(&Usb, &OutStream, 1U, XUSBPS_EP_DIRECTION_OUT,
+				 ResetDone, NULL);
+	for (Index = 0U; Index < DEPTH; Index++) {
+		FixedIn(IN_MAX);
+	}
+	HOST_CHECK_EQ(XUsbPs_StreamSubmit(&OutStream, Cached + IN_MAX, DTD_MAX),
+		      XST_SUCCESS);
+	Resets = 0U;
+	Host_Schedule(Host_Now() + 2000000U, BusReset, NULL);
+	HOST_CHECK(WaitFor(DEPTH + 1U) != 0U);
+	HOST_CHECK_EQ(Resets, 1U);
+	HOST_CHECK(Lost >= 2U);
+	HOST_CHECK_EQ(XUsbPs_StreamPending(&InStream), 0U);
+	HOST_CHECK_EQ(XUsbPs_StreamPending(&OutStream), 0U);
+	printf("usbps: stop returned %u buffers lost, bus reset %u\n",
+	       DEPTH - 1U, Lost);
+
+	/* The streams stay registered and take buffers again */
+	Verify = 1U;
+	HostIndex = Submitted;
+	FixedIn(3000U);
+	HOST_CHECK(WaitFor(Completed + 1U) != 0U);
+	HOST_CHECK_EQ(HostIndex, Submitted);
+	XUsbPs_StreamStop(&InStream);
+	XUsbPs_StreamStop(&OutStream);
+}
+
+/*****************************************************************************/
+/*
+ * XUsbPs_EpBufferSend, one buffer at a time
+ */
+static void SendLegacy(void)
+{
+	Xfer *X = &Xfers[Submitted % MAX_XFERS];
+
+	X->Len = Rand() % (DTD_MAX + 1U);
+	X->Buf = Area + (Rand() % (AREA_SIZE - DTD_MAX));
+	X->Off = 0U;
+	Submitted++;
+	HOST_CHECK_EQ(XUsbPs_EpBufferSend(&Usb, 1U, X->Buf, X->Len),
+		      XST_SUCCESS);
+}
+
+static void LegacyDone(void *Ref, u8 EpNum, u8 EventType, void *Data)
+{
+	(void)Ref;
+	HOST_CHECK_EQ(EpNum, 1U);
+	HOST_CHECK_EQ(EventType, XUSBPS_EP_EVENT_DATA_TX);
+	HOST_CHECK(Data == Xfers[Completed % MAX_XFERS].Buf);
+	Completed++;
+	if (Submitted < Target) {
+		SendLegacy();
+	}
+}
+
+static void TestLegacy(void)
+{
+	Area = Cached;
+	Setup();
+	Target = LEGACY_XFERS;
+	HOST_CHECK_EQ(XUsbPs_EpSetHandler(&Usb, 1U, XUSBPS_EP_DIRECTION_IN,
+					  LegacyDone, NULL), XST_SUCCESS);
+	SendLegacy();
+	SendLegacy();
+	HOST_CHECK(WaitFor(Target) != 0U);
+	HOST_CHECK_EQ(HostIndex, Target);
+}
+
+/*****************************************************************************/
+static int Run(void *Arg)
+{
+	u32 Index;
+
+	(void)Arg;
+	for (Index = 0U; Index < 4096U; Index++) {
+		MMUTable[Index] = (Index << 20) | NORM_WB_CACHE;
+	}
+	DmaMem = Host_AllocLow(64U * 1024U, 4096U);
+	Cached = Host_AllocLow(AREA_SIZE, 4096U);
+	Coherent = Host_AllocLow(AREA_SIZE, XIL_MMU_PAGE_SIZE);
+	for (Index = 0U; Index < AREA_SIZE; Index++) {
+		Cached[Index] = (u8)Rand();
+		Coherent[Index] = (u8)Rand();
+	}
+	HOST_CHECK_EQ(Xil_DmaPoolInit(Coherent, AREA_SIZE,
+				      XIL_DMAPOOL_NONCACHEABLE), XST_SUCCESS);
+	Host_SetWfiHook(Interrupt, NULL);
+	Host_SetCacheHook(CacheOp, NULL);
+
+	TestIn(Cached);
+	TestIn(Coherent);
+	HOST_CHECK_EQ(Model.Violations, 0U);
+	TestOut(Cached);
+	TestOut(Coherent);
+	HOST_CHECK_EQ(Model.Violations, 0U);
+	TestStop();
+	HOST_CHECK_EQ(Model.Violations, 0U);
+	TestLegacy();
+	HOST_CHECK_EQ(Model.Violations, 0U);
+	return 0;
+}
+
+int main(void)
+{
+	Host_Init();
+	Host_RunLow(Run, NULL);
+	return Host_Result("usbps");
+}
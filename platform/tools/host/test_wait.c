@@ -0,0 +1,491 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file test_wait.c
+*
+* Tests of the WFI event waits of standalone/src/arm/cortexa9/xil_wait.c
+* against models/scugic_model.c and the global timer of the host runtime.
+* The event comes from a register window at the SDIO 0 address whose
+* status bits are write one to clear and drive interrupt ID 56 while
+* enabled.
+*
+* - Random waits: Xil_WaitForEventWfi or Xil_WaitForEventsWfi, on the
+*   interrupt or XIL_WAIT_NO_INTR, with random timeouts and the event set
+*   before the call, at a random time during or after the timeout, or
+*   never. Xil_WaitForEventWfi sometimes waits for two bits, one of them
+*   set at a random time before the other. The GIC and CPSR state of the caller is random too: enables,
+*   priority mask, IRQs masked or not, and ID 56 sometimes already
+*   enabled by the application, routed to CPU 0 or to CPU 1 only. Every
+*   wait must
+*   - return XST_SUCCESS only after the event and no later than the wake
+*     up bound of its mode: the WFI exit and the loop for an interrupt,
+*     XIL_WAIT_POLL_US without one, XIL_WAIT_GUARD_US when the
+*     application routed the interrupt elsewhere,
+*   - time out only if the event came too late, not before the timeout
+*     and within the same bound after it,
+*   - not enter WFI, and read the register once only, if the event was
+*     already there,
+*   - sleep with IRQs masked in the CPSR,
+*   - leave the GIC, the global timer comparator and the CPSR as it found
+*     them.
+* - The status codes and the event mask are those of Xil_WaitForEvent and
+*   Xil_WaitForEvents from xil_sutil.c for an event that is there, comes
+*   later or never comes.
+* - usleep through xiltimer and globaltimer_sleep_zynq.c built with
+*   XIL_WAIT_WFI_SLEEP sleeps at least the time asked for, at most the
+*   wake up bound more, and in WFI for all but the loop overhead.
+* - Xil_WaitGetStats counts the waits, timeouts and comparator wake ups,
+*   and the wake up latency it reports is the WFI exit time.
+*
+* The timeouts are converted at the integer global timer counts per
+* microsecond, 333 for the 666.67 MHz CPU, so they end 0.1% early.
+* The test takes the timeout as that many counts. The WFI exit time and
+* the register access time are assumptions of the test.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <string.h>
+
+#include "host.h"
+#include "scugic_model.h"
+#include "xil_wait.h"
+#include "xil_util.h"
+#include "xparameters.h"
+#include "xpseudo_asm.h"
+#include "xreg_cortexa9.h"
+#include "xstatus.h"
+#include "sleep.h"
+
+#define DEV_BASEADDR		XPS_SDIO0_BASEADDR
+#define DEV_INTR		XPS_SDIO0_INT_ID
+#define DEV_STATUS_OFFSET	0x30U	/* Write one to clear */
+#define DEV_SIG_EN_OFFSET	0x38U
+#define DEV_EVENT		0x1U
+#define DEV_EVENT2		0x2U
+
+#define GT_CTRL			(XPAR_GLOBAL_TMR_BASEADDR + 0x08U)
+#define GT_COMPL		(XPAR_GLOBAL_TMR_BASEADDR + 0x10U)
+#define GT_COMPH		(XPAR_GLOBAL_TMR_BASEADDR + 0x14U)
+
+/* Assumed, see the file comment */
+#define ACCESS_NS		100U
+#define WFI_EXIT_NS		1000U
+
+/* Register accesses of one loop of Xil_WaitCore and of its exit */
+#define LOOP_NS			(64U * ACCESS_NS)
+#define GUARD_US		1000U
+
+#define RANDOM_WAITS		3000U
+#define SLEEPS			300U
+
+typedef struct {
+	ScuGicModel Gic;
+	u32 GtCtrl;
+	u32 GtCompL;
+	u32 GtCompH;
+	u32 Cpsr;
+} State;
+
+static ScuGicModel Gic;
+static u32 DevStatus;
+static u32 DevSigEn;
+static u64 EventNs;
+static u32 WaitBits;
+static u32 WaitAny;
+static u32 UnmaskedWfi;
+static u32 Seed = 38U;
+
+static u32 Rand(void)
+{
+	Seed = (Seed * 1103515245U) + 12345U;
+	return Seed >> 8;
+}
+
+static u32 DevRead(void *Ref, u32 Offset, u32 Size)
+{
+	(void)Ref;
+	(void)Size;
+	if (Offset == DEV_STATUS_OFFSET) {
+		return DevStatus;
+	}
+	if (Offset == DEV_SIG_EN_OFFSET) {
+		return DevSigEn;
+	}
+	return 0U;
+}
+
+static void DevWrite(void *Ref, u32 Offset, u32 Value, u32 Size)
+{
+	(void)Ref;
+	(void)Size;
+	if (Offset == DEV_STATUS_OFFSET) {
+		DevStatus &= ~Value;
+	} else if (Offset == DEV_SIG_EN_OFFSET) {
+		DevSigEn = Value;
+	}
+}
+
+static u32 DevLine(void *Ref, u32 IntrId)
+{
+	(void)Ref;
+	return ((IntrId == DEV_INTR) && ((DevStatus & DevSigEn) != 0U)) ?
+	       1U : 0U;
+}
+
+/* EventNs is when the status first satisfied the wait */
+static void DevEvent(void *Ref)
+{
+	DevStatus |= (u32)(UINTPTR)Ref;
+	if ((EventNs == ~0ULL) &&
+	    (((WaitAny != 0U) && ((DevStatus & WaitBits) != 0U)) ||
+	     ((DevStatus & WaitBits) == WaitBits))) {
+		EventNs = Host_Now();
+	}
+}
+
+static void WfiExit(void *Ref)
+{
+	(void)Ref;
+	if ((mfcpsr() & XREG_CPSR_IRQ_ENABLE) == 0U) {
+		UnmaskedWfi++;
+	}
+	Host_Advance(WFI_EXIT_NS);
+}
+
+/* Timeout of the waits as converted by xil_wait.c */
+static u64 TimeoutNs(u32 Us)
+{
+	return Host_GtNs((u64)Us * (XPAR_CPU_CORE_CLOCK_FREQ_HZ / 2000000U));
+}
+
+static void Snapshot(State *S)
+{
+	S->Gic = Gic;
+	S->GtCtrl = Xil_In32(GT_CTRL);
+	S->GtCompL = Xil_In32(GT_COMPL);
+	S->GtCompH = Xil_In32(GT_COMPH);
+	S->Cpsr = mfcpsr();
+}
+
+/* Random GIC, comparator and CPSR state of the caller */
+static u32 RandomCaller(void)
+{
+	static const u8 Pmr[] = { 0x00U, 0x80U, 0xA0U, 0xF0U, 0xF8U };
+	u32 Routed = 1U;
+	u32 Bit = 1U << (DEV_INTR % 32U);
+
+	Gic.DistCtrl = Rand() & 1U;
+	Gic.CpuCtrl = Rand() & 1U;
+	Gic.Pmr = Pmr[Rand() % sizeof(Pmr)];
+	Gic.Enabled[DEV_INTR / 32U] &= ~Bit;
+	Gic.Priority[DEV_INTR] = (u8)(Rand() & 0xF8U);
+	Gic.Target[DEV_INTR] = (u8)(Rand() & 0x3U);
+	Gic.Enabled[61U / 32U] ^= (Rand() & 1U) << (61U % 32U);
+	if ((Rand() % 4U) == 0U) {
+		/* The application handles the interrupt itself */
+		Gic.Enabled[DEV_INTR / 32U] |= Bit;
+		Gic.Priority[DEV_INTR] = 0x20U;
+		Gic.Target[DEV_INTR] = ((Rand() % 4U) == 0U) ? 0x2U : 0x1U;
+		Routed = Gic.Target[DEV_INTR] & 1U;
+	}
+
+	Xil_Out32(GT_CTRL, 0x1U);
+	Xil_Out32(GT_COMPL, Rand());
+	Xil_Out32(GT_COMPH, 0x7FFFFFFFU);
+	if ((Rand() & 1U) != 0U) {
+		Xil_Out32(GT_CTRL, 0x1U | 0x2U);
+	}
+	if ((Rand() & 1U) != 0U) {
+		cpsidi();
+	} else {
+		cpsiei();
+	}
+	return Routed;
+}
+
+static void CheckRestored(const State *Before)
+{
+	State After;
+
+	Snapshot(&After);
+	HOST_CHECK(memcmp(&After.Gic, &Before->Gic, sizeof(After.Gic)) == 0);
+	HOST_CHECK_EQ(After.GtCtrl, Before->GtCtrl);
+	HOST_CHECK_EQ(After.GtCompL, Before->GtCompL);
+	HOST_CHECK_EQ(After.GtCompH, Before->GtCompH);
+	HOST_CHECK_EQ(After.Cpsr, Before->Cpsr);
+}
+
+static void TestRandom(void)
+{
+	State Before;
+	u64 Start;
+	u64 End;
+	u64 At;
+	u64 Bound;
+	u64 Wfi;
+	u32 Timeout;
+	u32 IntrId;
+	u32 Routed;
+	u32 Bits;
+	u32 Events;
+	u32 Status;
+	u32 Any;
+	u32 Kind;
+	u32 Index;
+	u32 Success = 0U;
+	u32 Timeouts = 0U;
+	u32 Immediate = 0U;
+
+	for (Index = 0U; Index < RANDOM_WAITS; Index++) {
+		Routed = RandomCaller();
+		Timeout = 20U + (Rand() % 3000U);
+		IntrId = ((Rand() % 3U) == 0U) ? XIL_WAIT_NO_INTR : DEV_INTR;
+		Any = Rand() & 1U;
+		Bits = ((Any != 0U) && ((Rand() & 1U) != 0U)) ? DEV_EVENT2 :
+		       DEV_EVENT;
+		/* Xil_WaitForEventWfi sometimes needs a second bit as well */
+		WaitAny = Any;
+		WaitBits = (Any != 0U) ? (DEV_EVENT | DEV_EVENT2) :
+			   (((Rand() & 1U) != 0U) ? (DEV_EVENT | DEV_EVENT2) :
+			    DEV_EVENT);
+		DevSigEn = DEV_EVENT | DEV_EVENT2;
+		DevStatus = 0U;
+		EventNs = ~0ULL;
+
+		if ((IntrId == XIL_WAIT_NO_INTR) || (Routed == 0U)) {
+			Bound = ((u64)((IntrId == XIL_WAIT_NO_INTR) ?
+				       XIL_WAIT_POLL_US : GUARD_US) * 1000U) +
+				WFI_EXIT_NS + LOOP_NS;
+		} else {
+			Bound = WFI_EXIT_NS + LOOP_NS;
+		}
+
+		Kind = Rand() % 8U;
+		Start = Host_Now();
+		if ((Any == 0U) && (WaitBits != DEV_EVENT)) {
+			if (Kind == 0U) {
+				DevEvent((void *)(UINTPTR)DEV_EVENT2);
+			} else {
+				Host_Schedule(Start + ((u64)(Rand() % Timeout) *
+						       1000U),
+					      DevEvent,
+					      (void *)(UINTPTR)DEV_EVENT2);
+			}
+		}
+		if (Kind == 0U) {
+			DevEvent((void *)(UINTPTR)Bits);
+		} else if (Kind != 1U) {
+			At = Start + ((u64)(Rand() % (2U * Timeout)) * 1000U) +
+			     (Rand() % 1000U);
+			Host_Schedule(At, DevEvent, (void *)(UINTPTR)Bits);
+		}
+
+		Snapshot(&Before);
+		Wfi = Host_Stats.Wfi;
+		Start = Host_Now();
+		if (Any != 0U) {
+			Status = Xil_WaitForEventsWfi(DEV_BASEADDR +
+						      DEV_STATUS_OFFSET,
+						      DEV_EVENT | DEV_EVENT2,
+						      DEV_EVENT | DEV_EVENT2,
+						      Timeout, &Events, IntrId);
+		} else {
+			Status = Xil_WaitForEventWfi(DEV_BASEADDR +
+						     DEV_STATUS_OFFSET,
+						     WaitBits, WaitBits,
+						     Timeout, IntrId);
+		}
+		End = Host_Now();
+		Host_Cancel(DevEvent, (void *)(UINTPTR)DEV_EVENT);
+		Host_Cancel(DevEvent, (void *)(UINTPTR)DEV_EVENT2);
+		CheckRestored(&Before);
+
+		if (Status == XST_SUCCESS) {
+			Success++;
+			HOST_CHECK(EventNs <= End);
+			HOST_CHECK(End - ((EventNs > Start) ? EventNs : Start) <=
+				   Bound);
+			if (Any != 0U) {
+				HOST_CHECK_EQ(Events, Bits);
+			}
+			if (Kind == 0U) {
+				Immediate++;
+				HOST_CHECK_EQ(Host_Stats.Wfi, Wfi);
+				/* One read of the register, like the poll */
+				HOST_CHECK(End - Start <= ACCESS_NS);
+			}
+		} else {
+			Timeouts++;
+			HOST_CHECK_EQ(Status, (Any != 0U) ? XST_TIMEOUT :
+				      XST_FAILURE);
+			HOST_CHECK(End - Start >= TimeoutNs(Timeout));
+			HOST_CHECK(End - Start <= TimeoutNs(Timeout) + Bound);
+			/* The event, if any, came too late to be seen */
+			HOST_CHECK((EventNs == ~0ULL) ||
+				   (EventNs + Bound > Start + TimeoutNs(Timeout)));
+			if (Any != 0U) {
+				HOST_CHECK_EQ(Events, 0U);
+			}
+		}
+	}
+
+	printf("random waits: %u, %u events (%u already there), %u timeouts\n",
+	       RANDOM_WAITS, Success, Immediate, Timeouts);
+}
+
+/* The polled waits of xil_sutil.c and the WFI ones give the same answers */
+static void TestStatusCodes(void)
+{
+	u32 Kind;
+	u32 Wfi = 0U;
+	u32 Any;
+	u32 Polled = 0U;
+	u32 EventsWfi;
+	u32 EventsPolled;
+	u32 Pass;
+
+	DevSigEn = DEV_EVENT | DEV_EVENT2;
+	for (Kind = 0U; Kind < 3U; Kind++) {
+		for (Any = 0U; Any < 2U; Any++) {
+			for (Pass = 0U; Pass < 2U; Pass++) {
+				DevStatus = 0U;
+				if (Kind == 0U) {
+					DevStatus = DEV_EVENT2;
+				} else if (Kind == 1U) {
+					Host_Schedule(Host_Now() + 50000U,
+						      DevEvent,
+						      (void *)(UINTPTR)DEV_EVENT2);
+				}
+				if ((Any != 0U) && (Pass == 0U)) {
+					Wfi = Xil_WaitForEventsWfi(
+						DEV_BASEADDR + DEV_STATUS_OFFSET,
+						0xFFU, DEV_EVENT | DEV_EVENT2,
+						100U, &EventsWfi, DEV_INTR);
+				} else if (Any != 0U) {
+					Polled = Xil_WaitForEvents(
+						DEV_BASEADDR + DEV_STATUS_OFFSET,
+						0xFFU, DEV_EVENT | DEV_EVENT2,
+						100U, &EventsPolled);
+				} else if (Pass == 0U) {
+					Wfi = Xil_WaitForEventWfi(
+						DEV_BASEADDR + DEV_STATUS_OFFSET,
+						0xFFU, DEV_EVENT2, 100U,
+						DEV_INTR);
+				} else {
+					Polled = Xil_WaitForEvent(
+						DEV_BASEADDR + DEV_STATUS_OFFSET,
+						0xFFU, DEV_EVENT2, 100U);
+				}
+				Host_Cancel(DevEvent,
+					    (void *)(UINTPTR)DEV_EVENT2);
+			}
+			HOST_CHECK_EQ(Wfi, Polled);
+			HOST_CHECK_EQ(Wfi, (Kind == 2U) ?
+				      ((Any != 0U) ? XST_TIMEOUT : XST_FAILURE) :
+				      XST_SUCCESS);
+			if (Any != 0U) {
+				HOST_CHECK_EQ(EventsWfi, EventsPolled);
+			}
+		}
+	}
+}
+
+static void TestStats(void)
+{
+	Xil_WaitStats Stats;
+	u32 Index;
+
+	Xil_WaitResetStats();
+	DevStatus = 0U;
+	for (Index = 0U; Index < 10U; Index++) {
+		HOST_CHECK_EQ(Xil_WaitForEventWfi(DEV_BASEADDR +
+						  DEV_STATUS_OFFSET, DEV_EVENT,
+						  DEV_EVENT, 2500U, DEV_INTR),
+			      XST_FAILURE);
+	}
+	Xil_WaitGetStats(&Stats);
+	HOST_CHECK_EQ(Stats.Waits, 10U);
+	HOST_CHECK_EQ(Stats.Timeouts, 10U);
+	/* Two guard wake ups and the timeout per wait */
+	HOST_CHECK_EQ(Stats.Wakeups, 30U);
+	HOST_CHECK_EQ(Stats.TimerWakeups, 30U);
+	HOST_CHECK(Host_GtNs(Stats.MaxWakeLatency) >= WFI_EXIT_NS);
+	HOST_CHECK(Host_GtNs(Stats.MaxWakeLatency) <= WFI_EXIT_NS + LOOP_NS);
+	HOST_CHECK(Stats.SleepCounts <= Stats.WaitCounts);
+	HOST_CHECK(Stats.SleepCounts * 100U >= Stats.WaitCounts * 95U);
+	printf("comparator wake up latency: mean %.2f us, max %.2f us\n",
+	       (double)Host_GtNs(Stats.SumWakeLatency / Stats.TimerWakeups) /
+	       1000.0, (double)Host_GtNs(Stats.MaxWakeLatency) / 1000.0);
+}
+
+static void TestSleep(void)
+{
+	u64 Start;
+	u64 Slept;
+	u64 Wfi;
+	u64 Asleep = 0U;
+	u64 Total = 0U;
+	u32 Us;
+	u32 Index;
+
+	for (Index = 0U; Index < SLEEPS; Index++) {
+		Us = 1U + (Rand() % 5000U);
+		Wfi = Host_Stats.WfiNs;
+		Start = Host_Now();
+		usleep(Us);
+		Slept = Host_Now() - Start;
+		HOST_CHECK(Slept >= TimeoutNs(Us));
+		HOST_CHECK(Slept <= TimeoutNs(Us) + WFI_EXIT_NS + LOOP_NS +
+			   (2U * LOOP_NS));
+		if (Us >= 100U) {
+			HOST_CHECK((Host_Stats.WfiNs - Wfi) * 100U >=
+				   Slept * 90U);
+		}
+		Asleep += Host_Stats.WfiNs - Wfi;
+		Total += Slept;
+	}
+	printf("usleep: %u calls, %.1f%% of the time in WFI\n", SLEEPS,
+	       (100.0 * (double)Asleep) / (double)Total);
+}
+
+static int Run(void *Arg)
+{
+	(void)Arg;
+
+	/* The counts per microsecond are truncated by 0.1% */
+	HOST_CHECK(TimeoutNs(1000000U) >= 998990000ULL);
+	HOST_CHECK(TimeoutNs(1000000U) <= 1000000000ULL);
+
+	/* usleep starts the global timer, which resets the counter */
+	TestSleep();
+	TestStatusCodes();
+	TestRandom();
+	TestStats();
+	HOST_CHECK_EQ(UnmaskedWfi, 0U);
+	return 0;
+}
+
+int main(void)
+{
+	Host_Init();
+	ScuGicModel_Init(&Gic, ACCESS_NS);
+	Gic.Line = DevLine;
+	HostIo_Map(DEV_BASEADDR, 0x100U, ACCESS_NS, DevRead, DevWrite, NULL);
+	Host_SetWfiWake(ScuGicModel_WakeUp, &Gic);
+	Host_SetWfiHook(WfiExit, NULL);
+	Host_RunLow(Run, NULL);
+	return Host_Result("wait");
+}
@@ -0,0 +1,429 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file test_xadcps.c
+*
+* Tests the sequencer sampling engine of xadcps_sampler.c against the XADC
+* model in models/xadcps_model.c. The model source encodes the channel and
+* the conversion number in every raw value and logs the values the model
+* returns, each published sweep must equal the next entries of the log.
+*
+* - Interrupt driven continuous sweeps over fixed and random channel sets:
+*   one channel, a full burst of 14, 15 and all 26 channels (split in two
+*   bursts) and sets with the calibration bit, which has no register. The
+*   sequencer registers are programmed with the set, rows hold the
+*   channels in sweep order without the leading word of a burst, sweep
+*   times do not go back and XAdcPs_SamplerDecimate matches min, max and
+*   mean of the rows it consumes.
+* - Without a reader the ring fills, Head stops at XADCPS_SAMPLER_DEPTH and
+*   the dropped sweeps are counted in Overruns.
+* - Triggered sweeps with XAdcPs_SamplerPoll and no interrupts, a trigger
+*   while busy is refused, XAdcPs_SamplerGetLatest before the first sweep,
+*   for a channel not sampled and for the last sweep.
+* - With 16 sample averaging the values are means of 16 conversions.
+* - The engine never reads an empty data FIFO (no stall on the bus), never
+*   overfills the command FIFO and leaves no command behind after
+*   XAdcPs_SamplerStop.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <string.h>
+
+#include "host.h"
+#include "xadcps.h"
+#include "xadcps_model.h"
+#include "xstatus.h"
+
+#define XADC_BASE	0xF8007100U
+/* Model parameters, the test does not depend on their values */
+#define ACCESS_NS	100U
+#define CMD_NS		1600U
+#define CONV_NS		1000U
+#define IRQ_NS		500U	/* Below CMD_NS, an early interrupt shows */
+
+#define LOG_SIZE	4096U
+#define CH_ALL		0xFFFF7FE0U	/* Every channel with a register */
+
+static XAdcPs Xadc;
+static XAdcPsModel Model;
+static XAdcPs_Sampler Sampler;
+static u32 Mapped;
+static u32 Seed = 0x2545F491U;
+
+/* Values of status register reads, in the order the model returned them */
+static u16 Log[LOG_SIZE];
+static u32 LogHead;
+static u32 LogTail;
+static u32 Logging;
+
+static u32 Checked;		/* Sweeps compared with the log */
+static u32 Published;		/* Head at the last check */
+static u64 LastTime;
+static u32 Total;
+
+static u32 Rand(void)
+{
+	Seed ^= Seed << 13;
+	Seed ^= Seed >> 17;
+	Seed ^= Seed << 5;
+	return Seed;
+}
+
+static u16 Source(void *Ref, u32 Channel, u64 Pass)
+{
+	u16 Value = (u16)((Channel << 11) | (u32)(Pass & 0x7FFU));
+
+	(void)Ref;
+	if (Logging != 0U) {
+		HOST_CHECK((LogHead - LogTail) < LOG_SIZE);
+		Log[LogHead++ % LOG_SIZE] = Value;
+	}
+	return Value;
+}
+
+/* Compares the sweeps completed since the last call with the log */
+static void CheckSweeps(void)
+{
+	u32 Row;
+	u32 Index;
+
+	while (Checked < Sampler.Sweeps) {
+		/* One sweep per drain, the handler finishes at most one */
+		HOST_CHECK_EQ(Sampler.Sweeps - Checked, 1U);
+		if (Sampler.Head != Published) {
+			Row = (Sampler.Head - 1U) & (XADCPS_SAMPLER_DEPTH - 1U);
+			Published = Sampler.Head;
+		} else {
+			Row = XADCPS_SAMPLER_DEPTH;
+		}
+		for (Index = 0U; Index < Sampler.NumCh; Index++) {
+			HOST_CHECK(LogTail != LogHead);
+			HOST_CHECK_EQ(Sampler.Data[Row][Index],
+				      Log[LogTail++ % LOG_SIZE]);
+			HOST_CHECK_EQ(Sampler.Data[Row][Index] >> 11,
+				      Sampler.Channel[Index]);
+		}
+		HOST_CHECK(Sampler.Time[Row] >= LastTime);
+		LastTime = Sampler.Time[Row];
+		Checked++;
+	}
+}
+
+static void Interrupt(void *Ref)
+{
+	u32 Calls = 0U;
+
+	(void)Ref;
+	while (XAdcPsModel_IrqPending(&Model) != 0U) {
+		if (++Calls > 1000U) {
+			/* The handler does not clear the interrupt */
+			HOST_CHECK(0);
+			Model.IntMask = XADCPS_INTX_ALL_MASK;
+			return;
+		}
+		Host_Advance(IRQ_NS);
+		XAdcPs_SamplerIntrHandler(&Sampler);
+		CheckSweeps();
+	}
+}
+
+/* Returns 0 on a stall, no command in flight and no interrupt pending */
+static u32 Wait(void)
+{
+	if ((Host_EventsPending() == 0U) &&
+	    (XAdcPsModel_IrqPending(&Model) == 0U)) {
+		HOST_CHECK(0);
+		return 0U;
+	}
+	wfi();
+	return 1U;
+}
+
+/* Polls until the triggered sweep is done, 0 if it never completes */
+static u32 PollSweep(void)
+{
+	u32 Polls;
+
+	for (Polls = 0U; Polls < 100000U; Polls++) {
+		(void)XAdcPs_SamplerPoll(&Sampler);
+		if (Sampler.Busy == 0U) {
+			return 1U;
+		}
+	}
+	HOST_CHECK(0);
+	return 0U;
+}
+
+static void Setup(void)
+{
+	if (Mapped != 0U) {
+		HostIo_Unmap(XADC_BASE);
+	}
+	XAdcPsModel_Init(&Model, XADC_BASE, ACCESS_NS, CMD_NS, CONV_NS);
+	Model.Source = Source;
+	Mapped = 1U;
+	HOST_CHECK_EQ(XAdcPs_CfgInitialize(&Xadc, XAdcPs_LookupConfig(XADC_BASE),
+					   XADC_BASE), XST_SUCCESS);
+}
+
+static u32 NumChannels(u32 Mask)
+{
+	return (u32)__builtin_popcount(Mask & CH_ALL);
+}
+
+static void Start(u32 Mask, u8 Average, int Continuous)
+{
+	Setup();
+	HOST_CHECK_EQ(XAdcPs_SamplerStart(&Xadc, &Sampler, Mask, Average,
+					  Continuous), XST_SUCCESS);
+	HOST_CHECK_EQ(Sampler.NumCh, NumChannels(Mask));
+	HOST_CHECK_EQ(Model.Drp[XADCPS_SEQ00_OFFSET], Mask & 0xFFFFU);
+	HOST_CHECK_EQ(Model.Drp[XADCPS_SEQ01_OFFSET], Mask >> 16);
+	HOST_CHECK_EQ((Model.Drp[XADCPS_CFR1_OFFSET] &
+		       XADCPS_CFR1_SEQ_VALID_MASK) >> XADCPS_CFR1_SEQ_SHIFT,
+		      XADCPS_SEQ_MODE_CONTINPASS);
+	HOST_CHECK_EQ(Model.DataLevel, 0U);
+	HOST_CHECK_EQ(Model.Busy, 0U);
+
+	LogHead = 0U;
+	LogTail = 0U;
+	Logging = 1U;
+	Checked = 0U;
+	Published = 0U;
+	LastTime = 0U;
+}
+
+static void Stop(void)
+{
+	XAdcPs_SamplerStop(&Sampler);
+	Logging = 0U;
+	Total += Checked;
+	HOST_CHECK_EQ(Host_EventsPending(), 0U);
+	HOST_CHECK_EQ(Model.CmdLevel, 0U);
+	HOST_CHECK_EQ(Model.Violations, 0U);
+}
+
+/* Decimates Factor sweeps and checks the result against the rows */
+static void Consume(u32 Factor)
+{
+	XAdcPs_SamplerStats Stats[XADCPS_SAMPLER_MAX_CH];
+	u32 Tail = Sampler.Tail;
+	u32 Index;
+	u32 Sweep;
+	u32 Sum;
+	u16 Min;
+	u16 Max;
+	u16 Data;
+	u64 Time;
+
+	HOST_CHECK_EQ(XAdcPs_SamplerDecimate(&Sampler, Factor, Stats, &Time),
+		      XST_SUCCESS);
+	for (Index = 0U; Index < Sampler.NumCh; Index++) {
+		Min = 0xFFFFU;
+		Max = 0U;
+		Sum = 0U;
+		for (Sweep = 0U; Sweep < Factor; Sweep++) {
+			Data = Sampler.Data[(Tail + Sweep) &
+					    (XADCPS_SAMPLER_DEPTH - 1U)][Index];
+			Min = (Data < Min) ? Data : Min;
+			Max = (Data > Max) ? Data : Max;
+			Sum += Data;
+		}
+		HOST_CHECK_EQ(Stats[Index].Channel, Sampler.Channel[Index]);
+		HOST_CHECK_EQ(Stats[Index].Min, Min);
+		HOST_CHECK_EQ(Stats[Index].Max, Max);
+		HOST_CHECK_EQ(Stats[Index].Mean, Sum / Factor);
+	}
+	HOST_CHECK_EQ(Time, Sampler.Time[(Tail + Factor - 1U) &
+					 (XADCPS_SAMPLER_DEPTH - 1U)]);
+	HOST_CHECK_EQ(Sampler.Tail, Tail + Factor);
+}
+
+static void TestContinuous(u32 Mask, u32 Sweeps)
+{
+	u64 Stalls;
+	u64 Interrupts;
+	u32 Factor = 1U + (Rand() % 16U);
+
+	Start(Mask, XADCPS_AVG_0_SAMPLES, TRUE);
+	XAdcPs_IntrEnable(&Xadc, XADCPS_INTX_DFIFO_GTH_MASK);
+	Stalls = Model.Stalls;
+	Interrupts = Model.Interrupts;
+
+	HOST_CHECK_EQ(XAdcPs_SamplerTrigger(&Sampler), XST_SUCCESS);
+	HOST_CHECK_EQ(XAdcPs_SamplerTrigger(&Sampler), XST_DEVICE_BUSY);
+	while ((Sampler.Sweeps < Sweeps) && (Wait() != 0U)) {
+		while (XAdcPs_SamplerAvailable(&Sampler) >= Factor) {
+			Consume(Factor);
+		}
+	}
+	HOST_CHECK_EQ(Sampler.Overruns, 0U);
+	HOST_CHECK_EQ(Model.Stalls, Stalls);
+	/* One interrupt per burst */
+	HOST_CHECK_EQ(Model.Interrupts - Interrupts, Sampler.Sweeps *
+		      ((Sampler.NumCh + XADCPS_FIFO_DEPTH - 2U) /
+		       (XADCPS_FIFO_DEPTH - 1U)));
+	CheckSweeps();
+	HOST_CHECK_EQ(Checked, Sampler.Sweeps);
+	Stop();
+}
+
+static void TestOverrun(void)
+{
+	Start(XADCPS_SEQ_CH_TEMP | XADCPS_SEQ_CH_VCCINT | XADCPS_SEQ_CH_AUX03,
+	      XADCPS_AVG_0_SAMPLES, TRUE);
+	XAdcPs_IntrEnable(&Xadc, XADCPS_INTX_DFIFO_GTH_MASK);
+	HOST_CHECK_EQ(XAdcPs_SamplerTrigger(&Sampler), XST_SUCCESS);
+	while (Sampler.Sweeps < (XADCPS_SAMPLER_DEPTH + 50U)) {
+		if (Wait() == 0U) {
+			break;
+		}
+	}
+	HOST_CHECK_EQ(Sampler.Head, XADCPS_SAMPLER_DEPTH);
+	HOST_CHECK_EQ(Sampler.Overruns, 50U);
+	Consume(XADCPS_SAMPLER_DEPTH);
+	/*
+	 * Room again. The sweep in flight already went to the spare row, the
+	 * one after it is published.
+	 */
+	while (Sampler.Head == XADCPS_SAMPLER_DEPTH) {
+		if (Wait() == 0U) {
+			break;
+		}
+	}
+	HOST_CHECK_EQ(Sampler.Overruns, 51U);
+	CheckSweeps();
+	Stop();
+}
+
+static void TestPolled(u32 Mask)
+{
+	u16 Data;
+	u64 Time;
+	u32 Sweep;
+	u32 Index;
+	u32 Row;
+	u64 Stalls;
+
+	Start(Mask, XADCPS_AVG_0_SAMPLES, FALSE);
+	Stalls = Model.Stalls;
+	HOST_CHECK_EQ(XAdcPs_SamplerGetLatest(&Sampler, Sampler.Channel[0],
+					      &Data, NULL), XST_NO_DATA);
+	for (Sweep = 0U; Sweep < 100U; Sweep++) {
+		HOST_CHECK_EQ(XAdcPs_SamplerTrigger(&Sampler), XST_SUCCESS);
+		HOST_CHECK_EQ(XAdcPs_SamplerTrigger(&Sampler), XST_DEVICE_BUSY);
+		if (PollSweep() == 0U) {
+			break;
+		}
+		CheckSweeps();
+		HOST_CHECK_EQ(XAdcPs_SamplerPoll(&Sampler), 0U);
+		Row = (Sampler.Head - 1U) & (XADCPS_SAMPLER_DEPTH - 1U);
+		for (Index = 0U; Index < Sampler.NumCh; Index++) {
+			HOST_CHECK_EQ(XAdcPs_SamplerGetLatest(&Sampler,
+					Sampler.Channel[Index], &Data, &Time),
+				      XST_SUCCESS);
+			HOST_CHECK_EQ(Data, Sampler.Data[Row][Index]);
+			HOST_CHECK_EQ(Time, Sampler.Time[Row]);
+		}
+		Consume(1U);
+	}
+	HOST_CHECK_EQ(XAdcPs_SamplerGetLatest(&Sampler, XADCPS_CH_VPVN, &Data,
+					      NULL),
+		      ((Mask & XADCPS_SEQ_CH_VPVN) != 0U) ? XST_SUCCESS :
+		      XST_INVALID_PARAM);
+	HOST_CHECK_EQ(Model.Stalls, Stalls);
+	Stop();
+}
+
+static void TestAverage(void)
+{
+	u32 Sweep;
+	u32 Index;
+	u16 Data;
+	u16 Last[XADCPS_SAMPLER_MAX_CH];
+
+	Start(XADCPS_SEQ_CH_TEMP | XADCPS_SEQ_CH_VCCPINT | XADCPS_SEQ_CH_AUX00 |
+	      XADCPS_SEQ_CH_AUX15, XADCPS_AVG_16_SAMPLES, FALSE);
+	Logging = 0U;
+	HOST_CHECK_EQ(Model.Drp[XADCPS_SEQ02_OFFSET],
+		      (XADCPS_SEQ_CH_TEMP | XADCPS_SEQ_CH_VCCPINT) & 0xFFFFU);
+	HOST_CHECK_EQ(Model.AvgPasses, 16U);
+	memset(Last, 0, sizeof(Last));
+	for (Sweep = 0U; Sweep < XADCPS_SAMPLER_DEPTH; Sweep++) {
+		Host_Advance(5000U);
+		HOST_CHECK_EQ(XAdcPs_SamplerTrigger(&Sampler), XST_SUCCESS);
+		if (PollSweep() == 0U) {
+			break;
+		}
+		for (Index = 0U; Index < Sampler.NumCh; Index++) {
+			Data = Sampler.Data[Sweep][Index];
+			HOST_CHECK(Data >= Last[Index]);
+			Last[Index] = Data;
+			if (Data == 0U) {
+				continue;
+			}
+			/* Mean of passes P-15..P, P = 15 mod 16 */
+			HOST_CHECK_EQ(Data >> 11, Sampler.Channel[Index]);
+			HOST_CHECK_EQ(Data & 0xFU, 7U);
+		}
+	}
+	for (Index = 0U; Index < Sampler.NumCh; Index++) {
+		HOST_CHECK(Last[Index] != 0U);
+	}
+	Stop();
+}
+
+static int Run(void *Arg)
+{
+	static const u32 Masks[] = {
+		XADCPS_SEQ_CH_TEMP,
+		XADCPS_SEQ_CH_CALIB | XADCPS_SEQ_CH_VCCPINT | XADCPS_SEQ_CH_VPVN,
+		0x0000FFE0U & CH_ALL,			/* 10 on chip */
+		0x0FFF7F00U,				/* 7 + 12 = 19 */
+		0x3FFF0000U,				/* 14, one burst */
+		0x7FFF0000U,				/* 15, two bursts */
+		CH_ALL | XADCPS_SEQ_CH_CALIB,		/* 26 */
+	};
+	u32 Index;
+	u32 Mask;
+
+	(void)Arg;
+	Host_SetWfiHook(Interrupt, NULL);
+
+	for (Index = 0U; Index < (sizeof(Masks) / sizeof(Masks[0])); Index++) {
+		TestContinuous(Masks[Index], 300U);
+	}
+	for (Index = 0U; Index < 20U; Index++) {
+		do {
+			Mask = Rand() & (CH_ALL | XADCPS_SEQ_CH_CALIB);
+		} while (NumChannels(Mask) == 0U);
+		TestContinuous(Mask, 200U);
+	}
+	TestOverrun();
+	TestPolled(CH_ALL);
+	TestPolled(XADCPS_SEQ_CH_VPVN | XADCPS_SEQ_CH_AUX07);
+	TestAverage();
+	printf("xadcps: %u channel sets, %u sweeps compared\n",
+	       (unsigned)((sizeof(Masks) / sizeof(Masks[0])) + 20U), Total);
+	return 0;
+}
+
+int main(void)
+{
+	Host_Init();
+	Host_RunLow(Run, NULL);
+	return Host_Result("xadcps");
+}
@@ -0,0 +1,372 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file test_xadcps_thermal.c
+*
+* Feeds a synthetic temperature and supply trace to the thermal governor
+* of xadcps_thermal.c, running against the alarm logic of the XADC model
+* in models/xadcps_model.c and the CPU clock control of
+* models/slcr_model.c.
+*
+* The trace is a list of segments sampled every millisecond: ramps, noise
+* inside a hysteresis band, a step above the over temperature limit, a
+* supply fault and cooling back to nominal. Every sample is a conversion
+* of the model, the alarm interrupts run the governor's handler and a
+* timer interrupt calls XAdcPs_ThermalTick every 10 ms, out of phase with
+* the samples. At the end of every segment the test checks
+*
+* - the level, the emergency flag, the transitions and the alarms handled
+*   during the segment against the values the trace was written for,
+* - the CPU clock divisor in ARM_CLK_CTRL and the throttle value the
+*   workload callback got last against the level table.
+*
+* Crossing the first level from level 0 must be handled by the ALM0
+* interrupt within two samples (the alarm compares 12 bits), not by the
+* next tick. OT and the supply alarm must reach the hottest level from
+* their interrupt. Noise inside a band must not change the level. The
+* time XAdcPs_ThermalThrottledTime reports must match the modeled time
+* between the callbacks, the global timer slows down with the CPU clock
+* while throttled. Tables the governor must refuse are checked first.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include "host.h"
+#include "xadcps.h"
+#include "xadcps_model.h"
+#include "slcr_model.h"
+#include "xstatus.h"
+
+#define XADC_BASE	0xF8007100U
+/* Model parameters, the test does not depend on their values */
+#define ACCESS_NS	100U
+#define CMD_NS		1600U
+#define CONV_NS		1000U
+#define IRQ_NS		500U
+
+#define SAMPLE_NS	1000000U	/* Trace step */
+#define TICK_NS		10000000U	/* XAdcPs_ThermalTick period */
+#define TICK_PHASE	500000U		/* Ticks between two samples */
+/* Source PLL, divisor 2, the nominal clock of the test */
+#define ARM_CLK_CTRL	0x1F000200U
+#define NOMINAL_DIV	2U
+
+#define RAW(C)		((u16)XAdcPs_TemperatureToRaw(C))
+#define VOLT(V)		((u16)XAdcPs_VoltageToRaw(V))
+
+/* Thresholds of the test */
+#define OT_UPPER	120.0f
+#define OT_LOWER	110.0f
+#define VCCPINT_OK	1.00f
+#define VCCPINT_FAULT	1.10f
+#define VCCPINT_UPPER	1.05f
+#define VCCPINT_LOWER	0.95f
+
+static const XAdcPs_ThermalLevel Levels[] = {
+	{ RAW(85.0f), RAW(80.0f), 4U, 25U },
+	{ RAW(95.0f), RAW(90.0f), 8U, 50U },
+	{ RAW(105.0f), RAW(100.0f), 16U, 100U },
+};
+#define NUM_LEVELS	((u8)(sizeof(Levels) / sizeof(Levels[0])))
+
+typedef struct {
+	const char *Name;
+	float From;		/* C before the segment */
+	float To;		/* C at its last sample, linear in between */
+	float Noise;		/* Uniform +- C on every sample */
+	u32 Ms;
+	u32 SupplyFault;	/* VCCPINT outside its window */
+	/* Expected */
+	u8 Level;		/* At the end */
+	u8 Emergency;
+	u32 Transitions;	/* During the segment */
+	u32 Alarms;
+} Segment;
+
+static const Segment Trace[] = {
+	{ "idle",        50.0f,  50.0f, 0.0f,  500U, 0U, 0U, 0U, 0U, 0U },
+	{ "warm up",     50.0f,  87.0f, 0.0f, 1000U, 0U, 1U, 0U, 1U, 1U },
+	{ "band 1",      87.0f,  87.0f, 2.0f, 1000U, 0U, 1U, 0U, 0U, 0U },
+	{ "ramp",        87.0f, 100.0f, 0.0f,  500U, 0U, 2U, 0U, 1U, 0U },
+	{ "band 2",      93.0f,  93.0f, 1.5f, 1000U, 0U, 2U, 0U, 0U, 0U },
+	{ "ramp",        93.0f, 107.0f, 0.0f,  400U, 0U, 3U, 0U, 1U, 0U },
+	{ "cool",       107.0f,  82.0f, 0.0f, 1000U, 0U, 1U, 0U, 2U, 0U },
+	{ "OT step",    122.0f, 122.0f, 0.0f,  200U, 0U, 3U, 1U, 1U, 1U },
+	{ "OT held",    112.0f, 112.0f, 0.0f,  200U, 0U, 3U, 1U, 0U, 0U },
+	{ "OT cleared",  84.0f,  84.0f, 0.0f,  500U, 0U, 1U, 0U, 1U, 0U },
+	{ "VCCPINT",     84.0f,  84.0f, 0.0f,  200U, 1U, 3U, 1U, 1U, 1U },
+	{ "VCCPINT ok",  84.0f,  84.0f, 0.0f,  300U, 0U, 1U, 0U, 1U, 0U },
+	{ "cool",        84.0f,  60.0f, 0.0f, 1000U, 0U, 0U, 0U, 1U, 0U },
+	{ "idle",        60.0f,  60.0f, 0.0f,  500U, 0U, 0U, 0U, 0U, 0U },
+	{ "warm again",  60.0f,  90.0f, 0.0f, 1000U, 0U, 1U, 0U, 1U, 1U },
+	{ "cool",        90.0f,  50.0f, 0.0f, 1000U, 0U, 0U, 0U, 1U, 0U },
+};
+#define SEGMENTS	(sizeof(Trace) / sizeof(Trace[0]))
+
+static XAdcPs Xadc;
+static XAdcPsModel Model;
+static SlcrModel Slcr;
+static XAdcPs_Thermal Thermal;
+static u32 Seed = 0x2545F491U;
+
+static u32 Seg;			/* Segment of the next sample */
+static u32 Step;		/* Sample within it */
+static u32 TickDue;
+
+static u32 Callbacks;
+static u8 LastThrottle;
+static u64 ThrottledSince;
+static u64 ThrottledNs;		/* Modeled time above level 0 */
+static u64 CrossedAt;		/* First sample above level 1 at level 0 */
+static u64 AlarmLatency;	/* Longest crossing to level 1 */
+static u64 CriticalAt;		/* Sample that raised OT or the supply alarm */
+static u64 CriticalLatency;	/* Longest of those to the hottest level */
+
+static float Noise(float Amplitude)
+{
+	Seed ^= Seed << 13;
+	Seed ^= Seed >> 17;
+	Seed ^= Seed << 5;
+	return Amplitude * (((float)(Seed % 2001U) / 1000.0f) - 1.0f);
+}
+
+static void Workload(void *Ref, u8 Throttle)
+{
+	(void)Ref;
+	Callbacks++;
+	LastThrottle = Throttle;
+	if ((Thermal.Level != 0U) && (ThrottledSince == 0U)) {
+		ThrottledSince = Host_Now();
+	} else if ((Thermal.Level == 0U) && (ThrottledSince != 0U)) {
+		ThrottledNs += Host_Now() - ThrottledSince;
+		ThrottledSince = 0U;
+	}
+	if ((Thermal.Level != 0U) && (CrossedAt != 0U)) {
+		if ((Host_Now() - CrossedAt) > AlarmLatency) {
+			AlarmLatency = Host_Now() - CrossedAt;
+		}
+		CrossedAt = 0U;
+	}
+	if ((Thermal.Emergency != 0U) && (CriticalAt != 0U)) {
+		if ((Host_Now() - CriticalAt) > CriticalLatency) {
+			CriticalLatency = Host_Now() - CriticalAt;
+		}
+		CriticalAt = 0U;
+	}
+}
+
+/* One conversion of the temperature and VCCPINT */
+static void Sample(void *Ref)
+{
+	const Segment *S = &Trace[Seg];
+	float Temp;
+	u16 Raw;
+
+	(void)Ref;
+	Temp = S->From + ((S->To - S->From) * (float)(Step + 1U) /
+			  (float)S->Ms) + Noise(S->Noise);
+	Raw = RAW(Temp);
+	XAdcPsModel_SetInput(&Model, XADCPS_CH_TEMP, Raw);
+	XAdcPsModel_SetInput(&Model, XADCPS_CH_VCCPINT,
+			     VOLT((S->SupplyFault != 0U) ? VCCPINT_FAULT :
+				  VCCPINT_OK));
+	if ((Thermal.Level == 0U) && (CrossedAt == 0U) &&
+	    (Raw >= Levels[0].EnterRaw)) {
+		CrossedAt = Host_Now();
+	}
+	if ((Step == 0U) && (S->Emergency != 0U) && (Thermal.Emergency == 0U)) {
+		CriticalAt = Host_Now();
+	}
+
+	Step++;
+	if (Step == S->Ms) {
+		Step = 0U;
+		Seg++;
+	}
+	if (Seg < SEGMENTS) {
+		Host_Schedule(Host_Now() + SAMPLE_NS, Sample, NULL);
+	}
+}
+
+static void Timer(void *Ref)
+{
+	(void)Ref;
+	TickDue = 1U;
+	Host_Schedule(Host_Now() + TICK_NS, Timer, NULL);
+}
+
+/* The XADC and the timer interrupt, same priority */
+static void Interrupt(void *Ref)
+{
+	u32 Guard = 0U;
+
+	(void)Ref;
+	while ((XAdcPsModel_IrqPending(&Model) != 0U) || (TickDue != 0U)) {
+		if (++Guard > 1000U) {
+			HOST_CHECK(Guard <= 1000U);
+			XAdcPs_IntrDisable(&Xadc, XADCPS_INTX_ALL_MASK);
+			TickDue = 0U;
+			break;
+		}
+		Host_Advance(IRQ_NS);
+		if (XAdcPsModel_IrqPending(&Model) != 0U) {
+			XAdcPs_ThermalIntrHandler(&Thermal);
+		} else {
+			TickDue = 0U;
+			XAdcPs_ThermalTick(&Thermal);
+		}
+	}
+}
+
+static void TestTables(void)
+{
+	static const XAdcPs_ThermalLevel Unsorted[] = {
+		{ RAW(95.0f), RAW(90.0f), 4U, 25U },
+		{ RAW(85.0f), RAW(80.0f), 8U, 50U },
+	};
+	static const XAdcPs_ThermalLevel Inverted[] = {
+		{ RAW(85.0f), RAW(86.0f), 4U, 25U },
+	};
+	static const XAdcPs_ThermalLevel Divisor[] = {
+		{ RAW(85.0f), RAW(80.0f), 64U, 25U },
+	};
+
+	HOST_CHECK_EQ(XAdcPs_ThermalInit(&Thermal, &Xadc, Unsorted, 2U, 0U),
+		      XST_INVALID_PARAM);
+	HOST_CHECK_EQ(XAdcPs_ThermalInit(&Thermal, &Xadc, Inverted, 1U, 0U),
+		      XST_INVALID_PARAM);
+	HOST_CHECK_EQ(XAdcPs_ThermalInit(&Thermal, &Xadc, Divisor, 1U, 0U),
+		      XST_INVALID_PARAM);
+	HOST_CHECK_EQ(XAdcPs_ThermalInit(&Thermal, &Xadc, Levels, 0U, 0U),
+		      XST_INVALID_PARAM);
+	HOST_CHECK_EQ(XAdcPs_ThermalInit(&Thermal, &Xadc, Levels,
+					 XADCPS_THERMAL_MAX_LEVELS + 1U, 0U),
+		      XST_INVALID_PARAM);
+}
+
+static void CheckSegment(const Segment *S, u32 Transitions, u32 Alarms)
+{
+	u32 Divisor = NOMINAL_DIV;
+	u8 Throttle = 0U;
+
+	if (S->Level != 0U) {
+		Divisor = Levels[S->Level - 1U].CpuDivisor;
+		Throttle = Levels[S->Level - 1U].Throttle;
+	}
+	if ((Thermal.Level != S->Level) ||
+	    (Thermal.Emergency != S->Emergency) ||
+	    ((Thermal.Transitions - Transitions) != S->Transitions) ||
+	    ((Thermal.Alarms - Alarms) != S->Alarms)) {
+		printf("thermal: %s: level %u emergency %u transitions %u "
+		       "alarms %u\n", S->Name, Thermal.Level, Thermal.Emergency,
+		       Thermal.Transitions - Transitions,
+		       Thermal.Alarms - Alarms);
+	}
+	HOST_CHECK_EQ(Thermal.Level, S->Level);
+	HOST_CHECK_EQ(Thermal.Emergency, S->Emergency);
+	HOST_CHECK_EQ(Thermal.Transitions - Transitions, S->Transitions);
+	HOST_CHECK_EQ(Thermal.Alarms - Alarms, S->Alarms);
+	HOST_CHECK_EQ(SlcrModel_CpuDivisor(&Slcr), Divisor);
+	HOST_CHECK_EQ(LastThrottle, Throttle);
+}
+
+static int Run(void *Arg)
+{
+	u32 Transitions;
+	u32 Alarms;
+	u32 Index;
+	u64 Reported;
+	u64 Tolerance;
+
+	(void)Arg;
+	SlcrModel_Init(&Slcr, ACCESS_NS, ARM_CLK_CTRL);
+	XAdcPsModel_Init(&Model, XADC_BASE, ACCESS_NS, CMD_NS, CONV_NS);
+	(void)XAdcPs_CfgInitialize(&Xadc, XAdcPs_LookupConfig(XADC_BASE),
+				   XADC_BASE);
+	TestTables();
+
+	/* The sensors convert before the application sets thresholds */
+	XAdcPsModel_SetInput(&Model, XADCPS_CH_TEMP, RAW(Trace[0].From));
+	XAdcPsModel_SetInput(&Model, XADCPS_CH_VCCPINT, VOLT(VCCPINT_OK));
+	XAdcPs_SetAlarmThreshold(&Xadc, XADCPS_ATR_OT_UPPER, RAW(OT_UPPER));
+	XAdcPs_SetAlarmThreshold(&Xadc, XADCPS_ATR_OT_LOWER, RAW(OT_LOWER));
+	XAdcPs_EnableUserOverTemp(&Xadc);
+	XAdcPs_SetAlarmThreshold(&Xadc, XADCPS_ATR_VCCPINT_UPPER,
+				 VOLT(VCCPINT_UPPER));
+	XAdcPs_SetAlarmThreshold(&Xadc, XADCPS_ATR_VCCPINT_LOWER,
+				 VOLT(VCCPINT_LOWER));
+	HOST_CHECK_EQ(XAdcPs_ThermalInit(&Thermal, &Xadc, Levels, NUM_LEVELS,
+					 XADCPS_INTX_ALM4_MASK), XST_SUCCESS);
+	HOST_CHECK_EQ(XAdcPs_ThermalAddHandler(&Thermal, Workload, NULL),
+		      XST_SUCCESS);
+	HOST_CHECK_EQ(Thermal.NominalDivisor, NOMINAL_DIV);
+
+	Host_SetWfiHook(Interrupt, NULL);
+	Host_Schedule(Host_Now() + SAMPLE_NS, Sample, NULL);
+	Host_Schedule(Host_Now() + TICK_PHASE, Timer, NULL);
+	for (Index = 0U; Index < SEGMENTS; Index++) {
+		Transitions = Thermal.Transitions;
+		Alarms = Thermal.Alarms;
+		while (Seg == Index) {
+			wfi();
+		}
+		CheckSegment(&Trace[Index], Transitions, Alarms);
+	}
+	Host_Cancel(Timer, NULL);
+	Host_SetWfiHook(NULL, NULL);
+
+	/*
+	 * Handled by ALM0 at the sample, or the next one as the alarm
+	 * compares 12 bits, a tick would take up to 10 ms
+	 */
+	HOST_CHECK(AlarmLatency != 0U);
+	HOST_CHECK(AlarmLatency < (2U * SAMPLE_NS));
+	HOST_CHECK(CriticalLatency != 0U);
+	HOST_CHECK(CriticalLatency < SAMPLE_NS);
+	HOST_CHECK_EQ(Callbacks, Thermal.Transitions);
+	HOST_CHECK_EQ(Slcr.ClkChanges, Thermal.Transitions);
+	HOST_CHECK_EQ(Slcr.Violations, 0U);
+	HOST_CHECK_EQ(Model.Violations, 0U);
+
+	/*
+	 * A few register accesses between the governor's timer read and the
+	 * callback on every transition
+	 */
+	Reported = Host_GtNs(XAdcPs_ThermalThrottledTime(&Thermal));
+	Tolerance = (u64)Thermal.Transitions * 10U * ACCESS_NS;
+	HOST_CHECK(Reported + Tolerance >= ThrottledNs);
+	HOST_CHECK(Reported <= ThrottledNs + Tolerance);
+
+	printf("thermal: %u segments, %u transitions, %u alarms, ALM0 to "
+	       "level 1 in %llu ns, OT/supply to level %u in %llu ns\n",
+	       (u32)SEGMENTS, Thermal.Transitions, Thermal.Alarms,
+	       (unsigned long long)AlarmLatency, NUM_LEVELS,
+	       (unsigned long long)CriticalLatency);
+	printf("thermal: throttled %.3f s (modeled %.3f s):",
+	       (double)Reported / 1e9, (double)ThrottledNs / 1e9);
+	for (Index = 1U; Index <= NUM_LEVELS; Index++) {
+		printf(" level %u %.3f s", Index,
+		       (double)Host_GtNs(Thermal.LevelTime[Index]) / 1e9);
+	}
+	printf("\n");
+	return 0;
+}
+
+int main(void)
+{
+	Host_Init();
+	Host_RunLow(Run, NULL);
+	return Host_Result("xadcps_thermal");
+}
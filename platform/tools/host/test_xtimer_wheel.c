@@ -0,0 +1,532 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file test_xtimer_wheel.c
+*
+* Tests of the software timer wheel of xiltimer/src/xtimer_wheel.c on a
+* simulated clock.
+*
+* - Random operations on a wheel driven by hand: adds of one shot and
+*   periodic timers with deadlines on every level, beyond the span of the
+*   wheel and in the past, moves of pending timers, cancels, and
+*   XTimer_WheelAdvance either exactly to XTimer_WheelNextDeadline or by a
+*   random jump. Handlers cancel and add timers, their own included. A
+*   reference list of the timers checks that
+*   - a handler runs only for a pending timer whose deadline, rounded up
+*     to the wheel tick, is not after the time passed to Advance,
+*   - no pending timer is left due after Advance,
+*   - handlers of timers added on time run in expiry order, and when the
+*     wheel is advanced exactly to the next deadline less than one wheel
+*     tick after their deadline,
+*   - XTimer_WheelNextDeadline is never after the earliest due timer,
+*     is exactly its tick unless a parked timer has to be cascaded, and
+*     fails only on an empty wheel,
+*   - the statistics count every handler and its latency.
+* - The tickless path: the wheel started on the SCU timer of
+*   scutimer.c, running against models/scutimer_model.c, with XTime from
+*   the global timer of the host runtime. Random timers over a second,
+*   some periodic, are added and cancelled between interrupts. No handler
+*   may run before its deadline or later than one wheel tick and the
+*   interrupt entry after it, every timer due must have run, and an
+*   interrupt that runs no handler is only allowed after a cancel or a
+*   move. The latency and the interrupt count are printed next to the
+*   interrupts a 1 kHz tick would take.
+*
+* The interrupt entry time is an assumption of the test. The TTC backend
+* of the tick timer is not modeled.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 1.0   pt       10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <string.h>
+
+#include "host.h"
+#include "xiltimer.h"
+#include "scutimer_model.h"
+#include "xstatus.h"
+
+#define RES		((XTime)1U << XTIMER_WHEEL_RES_SHIFT)
+#define SPAN_TICKS	((u64)1U << (XTIMER_WHEEL_SLOT_BITS * \
+				     XTIMER_WHEEL_LEVELS))
+
+#define TIMERS		512U
+#define RANDOM_OPS	20000U
+
+/* Assumed, see the file comment */
+#define ACCESS_NS	100U
+#define IRQ_NS		500U
+
+#define TICKLESS_TIMERS	200U
+#define TICKLESS_NS	1000000000ULL
+#define TICKLESS_END_NS	(TICKLESS_NS + 200000000ULL)
+
+typedef struct {
+	XTimer_SwTimer Timer;
+	XTime Deadline;		/* Reference deadline */
+	XTime Period;
+	u64 MustBy;		/* Tick by which Advance must have run it */
+	u32 Pending;
+	u32 Late;		/* Added after its tick, runs on the next one */
+	u32 Parked;		/* Added beyond the span of the wheel */
+	u64 Calls;
+} RefTimer;
+
+static RefTimer Timers[TIMERS];
+static XTimer_Wheel Wheel;
+static u32 Seed = 37U;
+
+/* Hand driven wheel */
+static XTime SimNow;
+static u64 Floor;		/* Tick the wheel processes next */
+static u32 InAdvance;
+static u32 Exact;		/* Advancing to XTimer_WheelNextDeadline */
+static u64 LastDue;		/* Expiry order within one Advance */
+static u64 Calls;
+static XTime SumLatency;
+static u32 Draining;
+static u32 ParkedAdds;		/* Second half of the operations */
+static u64 ExactChecks;
+
+/* Tickless wheel */
+static void *IrqInstance;
+static void (*IrqHandler)(void *CallBackRef);
+static ScuTimerModel Model;
+static u64 Cancels;		/* Cancels and moves */
+static u64 Early;
+static u64 Spurious;		/* Interrupts that ran no handler */
+
+static u32 Rand(void)
+{
+	Seed = Seed * 1103515245U + 12345U;
+	return Seed >> 8;
+}
+
+static u64 Rand64(void)
+{
+	return ((u64)Rand() << 24) ^ Rand();
+}
+
+static u64 DueTick(XTime Deadline)
+{
+	return (Deadline + RES - 1U) >> XTIMER_WHEEL_RES_SHIFT;
+}
+
+/*****************************************************************************/
+/*
+ * xiltimer.c pulls in the sleep timer of the default timer, which would
+ * define XTime_GetTime a second time next to xtime_l.c
+ */
+u32 XilSleepTimer_Init(XTimer *InstancePtr)
+{
+	(void)InstancePtr;
+	return XST_SUCCESS;
+}
+
+/* The interrupt controller, the test delivers the SCU timer interrupt */
+int XSetupInterruptSystem(void *DriverInstance, void *IntrHandler, u32 IntrId,
+			  UINTPTR IntrParent, u16 Priority)
+{
+	(void)IntrId;
+	(void)IntrParent;
+	(void)Priority;
+	IrqInstance = DriverInstance;
+	IrqHandler = (void (*)(void *))IntrHandler;
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/*
+ * Wheel driven by hand
+ */
+static void Track(RefTimer *T, XTime Deadline, XTime Period, u64 Next)
+{
+	u64 Due = DueTick(Deadline);
+
+	T->Deadline = Deadline;
+	T->Period = Period;
+	T->Pending = 1U;
+	T->Late = (Due < Next) ? 1U : 0U;
+	T->MustBy = (Due < Next) ? Next : Due;
+	/* Floor is never ahead of the wheel, also inside Advance */
+	T->Parked = (Due >= (Floor + SPAN_TICKS)) ? 1U : 0U;
+}
+
+static void Handler(void *Ref);
+
+static void AddRandom(RefTimer *T, u64 Next)
+{
+	XTime Deadline;
+	XTime Period = 0U;
+	u32 Kind = Rand() % 16U;
+
+	if (Kind < 4U) {		/* Level 0 */
+		Deadline = SimNow + (Rand64() % (64U * RES));
+	} else if (Kind < 7U) {		/* Level 1 */
+		Deadline = SimNow + (Rand64() % (4096U * RES));
+	} else if (Kind < 9U) {		/* Level 2 */
+		Deadline = SimNow + (Rand64() % (262144U * RES));
+	} else if (Kind < 10U) {	/* Level 3 */
+		Deadline = SimNow + (Rand64() % (SPAN_TICKS * RES));
+	} else if ((Kind < 11U) && (ParkedAdds != 0U)) {
+		/* Parked beyond the span, in the second half only */
+		Deadline = SimNow + (SPAN_TICKS * RES) +
+			   (Rand64() % (3U * SPAN_TICKS * RES));
+	} else if (Kind < 12U) {	/* In the past */
+		Deadline = SimNow - (Rand64() % (SimNow + 1U));
+	} else {			/* Periodic */
+		Deadline = SimNow + (Rand64() % (4096U * RES));
+		Period = RES * (16U + (Rand() % 4096U));
+	}
+	/* Tick aligned deadlines hit the edges of the slots */
+	if ((Rand() % 4U) == 0U) {
+		Deadline &= ~(RES - 1U);
+	}
+	Track(T, Deadline, Period, Next);
+	XTimer_WheelAdd(&Wheel, &T->Timer, Deadline, Period, Handler, T);
+}
+
+static void Handler(void *Ref)
+{
+	RefTimer *T = Ref;
+	RefTimer *Other;
+	u64 Target = SimNow >> XTIMER_WHEEL_RES_SHIFT;
+	u64 Due = DueTick(T->Deadline);
+
+	HOST_CHECK(InAdvance != 0U);
+	HOST_CHECK(T->Pending != 0U);
+	HOST_CHECK(Due <= Target);
+	if (T->Late == 0U) {
+		HOST_CHECK(Due >= LastDue);
+		LastDue = Due;
+		if (Exact != 0U) {
+			HOST_CHECK((SimNow - T->Deadline) < RES);
+		}
+	}
+	Calls++;
+	SumLatency += (SimNow > T->Deadline) ? (SimNow - T->Deadline) : 0U;
+	T->Calls++;
+
+	if (T->Period != 0U) {
+		/* Catching up runs on the following ticks of this Advance */
+		Track(T, T->Deadline + T->Period, T->Period, Target + 1U);
+	} else {
+		T->Pending = 0U;
+	}
+	if (Draining != 0U) {
+		return;
+	}
+
+	switch (Rand() % 16U) {
+	case 0U:
+		Other = &Timers[Rand() % TIMERS];
+		XTimer_WheelCancel(&Wheel, &Other->Timer);
+		Other->Pending = 0U;
+		break;
+	case 1U:
+		Other = ((Rand() % 2U) == 0U) ? T : &Timers[Rand() % TIMERS];
+		AddRandom(Other, Target + 1U);
+		break;
+	default:
+		break;
+	}
+}
+
+static void Advance(XTime Now, u32 IsExact)
+{
+	u64 Target = Now >> XTIMER_WHEEL_RES_SHIFT;
+	u32 Index;
+
+	SimNow = Now;
+	Exact = IsExact;
+	LastDue = 0U;
+	InAdvance = 1U;
+	XTimer_WheelAdvance(&Wheel, Now);
+	InAdvance = 0U;
+	if (Floor <= Target) {
+		Floor = Target + 1U;
+	}
+	for (Index = 0U; Index < TIMERS; Index++) {
+		if (Timers[Index].Pending != 0U) {
+			HOST_CHECK(Timers[Index].MustBy > Target);
+		}
+	}
+}
+
+static void CheckNextDeadline(XTime *NextPtr)
+{
+	XTime Deadline = 0U;
+	u64 Min = ~(u64)0U;
+	u32 Parked = 0U;
+	u32 Index;
+	u32 Status;
+
+	for (Index = 0U; Index < TIMERS; Index++) {
+		if (Timers[Index].Pending == 0U) {
+			continue;
+		}
+		if (Timers[Index].MustBy < Min) {
+			Min = Timers[Index].MustBy;
+		}
+		Parked |= Timers[Index].Parked;
+	}
+	Status = XTimer_WheelNextDeadline(&Wheel, &Deadline);
+	if (Min == ~(u64)0U) {
+		HOST_CHECK_EQ(Status, XST_NO_DATA);
+		*NextPtr = 0U;
+		return;
+	}
+	HOST_CHECK_EQ(Status, XST_SUCCESS);
+	HOST_CHECK(Deadline <= (Min << XTIMER_WHEEL_RES_SHIFT));
+	HOST_CHECK(Deadline >= (Floor << XTIMER_WHEEL_RES_SHIFT));
+	/* Only parked timers wake the wheel up before they are due */
+	if (Parked == 0U) {
+		ExactChecks++;
+		HOST_CHECK_EQ(Deadline, ((Min > Floor) ? Min : Floor) <<
+			      XTIMER_WHEEL_RES_SHIFT);
+	}
+	*NextPtr = Deadline;
+}
+
+static void TestRandom(void)
+{
+	XTimer_WheelStats Stats;
+	RefTimer *T;
+	XTime Next;
+	u32 Op;
+	u32 Kind;
+
+	SimNow = (XTime)0x123456789ULL;
+	XTimer_WheelInit(&Wheel, SimNow);
+	Floor = SimNow >> XTIMER_WHEEL_RES_SHIFT;
+
+	for (Op = 0U; (Op < RANDOM_OPS) && (Host_Failures == 0U); Op++) {
+		ParkedAdds = (Op >= (RANDOM_OPS / 2U)) ? 1U : 0U;
+		Kind = Rand() % 8U;
+		T = &Timers[Rand() % TIMERS];
+		if (Kind < 3U) {
+			AddRandom(T, Floor);
+		} else if (Kind < 4U) {
+			XTimer_WheelCancel(&Wheel, &T->Timer);
+			T->Pending = 0U;
+		} else {
+			CheckNextDeadline(&Next);
+			switch (Rand() % 8U) {
+			case 0U: case 1U: case 2U: case 3U:
+				if (Next > SimNow) {
+					Advance(Next, 1U);
+					break;
+				}
+				Advance(SimNow, 0U);
+				break;
+			case 4U: case 5U:
+				Advance(SimNow + (Rand64() % (4U * RES)), 0U);
+				break;
+			case 6U:
+				Advance(SimNow + (Rand64() % (4096U * RES)), 0U);
+				break;
+			default:
+				Advance(SimNow + (Rand64() % (262144U * RES)), 0U);
+				break;
+			}
+		}
+		if (Host_Failures != 0U) {
+			printf("wheel: stopped at operation %u\n", Op);
+		}
+	}
+
+	/* Run everything off the wheel, periodic timers stopped first */
+	Draining = 1U;
+	for (Op = 0U; Op < TIMERS; Op++) {
+		if (Timers[Op].Period != 0U) {
+			XTimer_WheelCancel(&Wheel, &Timers[Op].Timer);
+			Timers[Op].Pending = 0U;
+		}
+	}
+	for (Op = 0U; Op < 10000U; Op++) {
+		CheckNextDeadline(&Next);
+		if (Next == 0U) {
+			break;
+		}
+		Advance((Next > SimNow) ? Next : SimNow + RES, 1U);
+	}
+	CheckNextDeadline(&Next);
+	HOST_CHECK_EQ(Next, 0U);
+
+	XTimer_WheelGetStats(&Wheel, &Stats);
+	HOST_CHECK_EQ(Stats.Expired, (u32)Calls);
+	HOST_CHECK_EQ(Stats.SumLatency, SumLatency);
+	printf("wheel: %u operations, %llu handlers, %llu exact next deadlines\n",
+	       RANDOM_OPS, (unsigned long long)Calls,
+	       (unsigned long long)ExactChecks);
+}
+
+/*****************************************************************************/
+/*
+ * Tickless wheel on the SCU timer model
+ */
+static void Interrupt(void *Ref)
+{
+	u64 Before;
+
+	(void)Ref;
+	while (ScuTimerModel_IrqPending(&Model) != 0U) {
+		Host_Advance(IRQ_NS);
+		Before = Calls;
+		IrqHandler(IrqInstance);
+		if (Calls == Before) {
+			Spurious++;
+		}
+	}
+}
+
+static void TicklessHandler(void *Ref)
+{
+	RefTimer *T = Ref;
+	XTime Now;
+
+	XTime_GetTime(&Now);
+	if (Now < T->Deadline) {
+		Early++;
+	}
+	Calls++;
+	T->Calls++;
+	if (T->Period != 0U) {
+		T->Deadline += T->Period;
+	} else {
+		T->Pending = 0U;
+	}
+}
+
+static void TicklessAdd(RefTimer *T, XTime Start)
+{
+	XTime Now;
+	XTime Period = 0U;
+	XTime Deadline;
+
+	XTime_GetTime(&Now);
+	Deadline = Now + (Rand64() % Host_GtCounts(TICKLESS_NS - (Host_Now() -
+			  Start)));
+	if ((Rand() % 8U) == 0U) {
+		Period = Host_GtCounts(1000000U + (Rand() % 49000000U));
+	}
+	T->Deadline = Deadline;
+	T->Period = Period;
+	T->Pending = 1U;
+	XTimer_WheelAdd(&Wheel, &T->Timer, Deadline, Period, TicklessHandler,
+			T);
+}
+
+static void TestTickless(void)
+{
+	XTimer_WheelStats Stats;
+	XTime Now;
+	XTime Start;
+	XTime End;
+	XTime Bound;
+	RefTimer *T;
+	u64 StartNs;
+	u32 Index;
+
+	memset(Timers, 0, sizeof(Timers));
+	Calls = 0U;
+	ScuTimerModel_Init(&Model, XPAR_XSCUTIMER_0_BASEADDR, ACCESS_NS);
+	Host_SetWfiHook(Interrupt, NULL);
+
+	XTime_GetTime(&Start);
+	XTimer_WheelInit(&Wheel, Start);
+	HOST_CHECK_EQ(XTimer_WheelStart(&Wheel, 0xA0U), XST_SUCCESS);
+	HOST_CHECK(IrqHandler != NULL);
+	StartNs = Host_Now();
+	for (Index = 0U; Index < TICKLESS_TIMERS; Index++) {
+		TicklessAdd(&Timers[Index], StartNs);
+	}
+
+	while ((Host_Now() - StartNs) < TICKLESS_END_NS) {
+		wfi();
+		/* Some timers are cancelled or moved between interrupts */
+		if ((Host_Now() - StartNs) < (TICKLESS_NS / 2U)) {
+			T = &Timers[Rand() % TICKLESS_TIMERS];
+			switch (Rand() % 8U) {
+			case 0U:
+				XTimer_WheelCancel(&Wheel, &T->Timer);
+				T->Pending = 0U;
+				Cancels++;
+				break;
+			case 1U:
+				TicklessAdd(T, StartNs);
+				Cancels++;
+				break;
+			default:
+				break;
+			}
+		}
+		if (ScuTimerModel_IrqPending(&Model) == 0U) {
+			/* Nothing armed, run the clock to the end */
+			if ((Host_EventsPending() == 0U) &&
+			    ((Host_Now() - StartNs) < TICKLESS_END_NS)) {
+				Host_AdvanceTo(StartNs + TICKLESS_END_NS);
+			}
+		}
+	}
+	XTime_GetTime(&End);
+
+	/*
+	 * Every timer due before the end ran, periodic ones are left with
+	 * their next deadline
+	 */
+	XTimer_WheelGetStats(&Wheel, &Stats);
+	Bound = RES + Host_GtCounts(IRQ_NS + 20000U);
+	for (Index = 0U; Index < TICKLESS_TIMERS; Index++) {
+		T = &Timers[Index];
+		if (T->Pending != 0U) {
+			HOST_CHECK((T->Deadline + Bound) > End);
+		}
+	}
+	HOST_CHECK_EQ(Early, 0U);
+	HOST_CHECK_EQ(Stats.Expired, (u32)Calls);
+	HOST_CHECK(Stats.MaxLatency < Bound);
+	/* A cancel or a move may leave the timer armed for nothing once */
+	HOST_CHECK(Spurious <= Cancels);
+
+	XTime_GetTime(&Now);
+	printf("wheel: tickless %u expiries in %.1f s, %llu interrupts, %llu "
+	       "of them with nothing due, after %llu cancels and moves\n"
+	       "       (a 1 kHz tick takes %llu), latency min %.2f mean %.2f "
+	       "max %.2f us, interrupt entry %u ns assumed\n",
+	       Stats.Expired, (double)Host_GtNs(Now - Start) / 1e9,
+	       (unsigned long long)Model.Interrupts,
+	       (unsigned long long)Spurious, (unsigned long long)Cancels,
+	       (unsigned long long)(Host_GtNs(Now - Start) / 1000000U),
+	       (double)Host_GtNs(Stats.MinLatency) / 1e3,
+	       (double)Host_GtNs(Stats.SumLatency / Stats.Expired) / 1e3,
+	       (double)Host_GtNs(Stats.MaxLatency) / 1e3, IRQ_NS);
+}
+
+static int Run(void *Arg)
+{
+	(void)Arg;
+
+	TestRandom();
+	memset(&Wheel, 0, sizeof(Wheel));
+	TestTickless();
+	return 0;
+}
+
+int main(void)
+{
+	Host_Init();
+	Host_RunLow(Run, NULL);
+	return Host_Result("xtimer_wheel");
+}
@@ -224,6 +224,19 @@
 * 21.3   dd  10/18/23   Updated SDK release year and SDK release quarter
 * 24.2	 prt 09/18/24	Updated SDK_RELEASE_QUARTER
 * 25.1   prt 02/06/25   Updated SDK release year and SDK release quarter
+* 25.2   pt  10/19/26   Added FSBL_FAST_RESUME flag description
+*                       Added FSBL_PERF_REGIONS flag description
+*                       Added FSBL_SMP flag description
+* 25.3   pt  10/19/26   Added FSBL_USB_UPDATE flag description, USB error
+*                       codes and the HeaderChecksum and ImageCheckID
+*                       prototypes
+* 25.4   pt  10/19/26   Added FSBL_WFI_WAIT flag description
+* 25.5   pt  10/19/26   Added FsblPrintStartupTimes prototype, FSBL_PERF
+*                       prints the startup phase times
+* 25.6   pt  10/19/26   Added FSBL_LZ4 flag description and
+*                       DECOMPRESSION_FAIL error code
+* 25.7   pt  10/19/26   FsblPrintStartupTimes no longer depends on
+*                       XIL_STARTUP_TIMES being defined for the FSBL
 *
 * </pre>
 *
@@ -239,6 +252,10 @@
 * measuring the performance of FSBL.That is the time taken to execute is
 * measured.when this flag is set.Execution time with reference to
 * global timer is taken here
+* If the BSP is built with XIL_STARTUP_TIMES, the time from _start to main
+* is printed as well, split into the startup phases. Refer to xil_startup.h
+* in the BSP. The FSBL itself does not need XIL_STARTUP_TIMES, it finds out
+* at run time whether the BSP sampled the phases.
 *
 * Total Execution time is the time taken for executing FSBL till handoff
 * to any application .
@@ -295,6 +312,44 @@
 * Note : Changing the default behaviour is not recommended from
 * Security perspective.
 *
+* FSBL_FAST_RESUME
+* Defining this flag enables the fast resume boot path. After a software
+* reset (SRST) which leaves the previous image intact in DDR, FSBL skips the
+* DDR test, boot device initialization and partition copy and hands off
+* directly to the previous image. Refer to resume.h for the requirements on
+* the application.
+*
+* FSBL_PERF_REGIONS
+* Defining this flag samples the cycle, L1 data cache miss, branch mispredict
+* and L2 read counters around the partition copy and checksum steps. A
+* min/avg/max report per step is printed just before handoff. Refer to
+* xpm_region.h in the BSP for the measured probe overhead.
+*
+* FSBL_SMP
+* Defining this flag wakes CPU1 on dual core devices to run the partition
+* checksum and RSA authentication while CPU0 copies the next partitions.
+* CPU1 is parked in a WFE loop before handoff. Only supported with the GNU
+* toolchain. Refer to smp.h for details.
+*
+* FSBL_USB_UPDATE
+* Defining this flag adds the USB update mode. In JTAG boot mode, or when
+* the application requested it before a software reset, FSBL enumerates as
+* a USB device and receives a boot image from the host into DDR. The image
+* is validated and then booted or programmed to QSPI. JTAG handoff is not
+* available with this flag. Refer to usb.h for the protocol.
+*
+* FSBL_WFI_WAIT
+* Defining this flag makes FSBL sleep in WFI while waiting for PCAP DMA done
+* and PL configuration done instead of polling the devcfg status register.
+* The devcfg interrupt wakes the core, no interrupt handler is installed.
+* Refer to xil_wait.h in the BSP for details.
+*
+* FSBL_LZ4
+* Defining this flag adds support for LZ4 compressed partitions. PS partitions
+* are decompressed to their load address, PL partitions are decompressed and
+* downloaded to PCAP block by block. Refer to lz4.h for the supported format
+* and the checksum and authentication policy.
+*
 *******************************************************************************/
 #ifndef XIL_FSBL_H
 #define XIL_FSBL_H
@@ -310,6 +365,10 @@ extern "C" {
 #include "xil_printf.h"
 #include "pcap.h"
 #include "fsbl_debug.h"
+#ifdef FSBL_PERF_REGIONS
+#define XPM_REGION_ENABLE
+#endif
+#include "xpm_region.h"
 #include "ps7_init.h"
 #ifdef FSBL_PERF
 #ifndef SDT
@@ -318,6 +377,7 @@ extern "C" {
 #include "xiltimer.h"
 #endif
 #include <stdio.h>
+#include "xil_startup.h"
 #endif
 
 
@@ -373,6 +433,10 @@ extern "C" {
 #define RSA_SUPPORT_NOT_ENABLED_FAIL	0xA011 /**< RSA not enabled fail */
 #define PS7_INIT_FAIL			0xA012 /**< ps7 Init Fail */
 #define PARTITION_LOAD_FAIL            0xA013 /**< Partition load fail*/
+#define USB_INIT_FAIL			0xA014 /**< USB init fail */
+#define USB_CMD_FAIL			0xA015 /**< Invalid USB command or transfer */
+#define QSPI_PROGRAM_FAIL		0xA016 /**< QSPI erase or program fail */
+#define DECOMPRESSION_FAIL		0xA017 /**< Partition decompression fail */
 /*
  * FSBL Exception error codes
  */
@@ -434,6 +498,7 @@ extern "C" {
 #define NAND_FLASH_MODE		0x00000004 /**< NAND Boot Mode */
 #define SD_MODE				0x00000005 /**< SD Boot Mode */
 #define MMC_MODE			0x00000006 /**< MMC Boot Device */
+#define USB_UPDATE_MODE		0x00000008 /**< USB update, not a mode pin setting */
 
 #define RESET_REASON_SRST		0x00000020 /**< Reason for reset is SRST */
 #define RESET_REASON_SWDT		0x00000001 /**< Reason for reset is SWDT */
@@ -543,11 +608,14 @@ u32 GetResetReason(void);
 #ifdef FSBL_PERF
 void FsblGetGlobalTime (XTime * tCur);
 void FsblMeasurePerfTime (XTime tCur, XTime tEnd);
+void FsblPrintStartupTimes(void);
 #endif
 void GetSiliconVersion(void);
 void FsblHandoffExit(u32 FsblStartAddr);
 void FsblHandoffJtagExit();
 void FsblPrintArray (u8 *Buf, u32 Len, char *Str);
+u32 HeaderChecksum(u32 FlashOffsetAddress);
+u32 ImageCheckID(u32 FlashOffsetAddress);
 /************************** Variable Definitions *****************************/
 extern int SkipPartition;
 
@@ -55,6 +55,11 @@
 *                       Deleted GetImageHeaderAndSignature() and added
 *                       GetNAuthImageHeader()
 * 21.2  ng  03/09/24   Fix format specifier for 32 bit variables
+* 21.3  pt  10/19/26   Record loaded partitions for the fast resume path
+*                       Added FSBL_PERF_REGIONS counters for partition copy
+*                       and checksum
+* 21.4  pt  10/19/26   Run partition checks on CPU1 under FSBL_SMP
+* 21.5  pt  10/19/26   Load LZ4 compressed partitions under FSBL_LZ4
 *
 * </pre>
 *
@@ -71,6 +76,9 @@
 #include "pcap.h"
 #include "fsbl_hooks.h"
 #include "md5.h"
+#include "resume.h"
+#include "smp.h"
+#include "lz4.h"
 
 #ifdef XPAR_XWDTPS_0_BASEADDR
 #include "xwdtps.h"
@@ -95,6 +103,10 @@
 u32 ValidateParition(u32 StartAddr, u32 Length, u32 ChecksumOffset);
 u32 GetPartitionChecksum(u32 ChecksumOffset, u8 *Checksum);
 u32 CalcPartitionChecksum(u32 SourceAddr, u32 DataLength, u8 *Checksum);
+#ifdef FSBL_SMP
+static u32 QueueValidatePartition(u32 StartAddr, u32 Length,
+		u32 ChecksumOffset, u32 PartitionNum);
+#endif
 
 /************************** Variable Definitions *****************************/
 /*
@@ -105,6 +117,7 @@ u8 PLPartitionFlag;
 u8 PSPartitionFlag;
 u8 SignedPartitionFlag;
 u8 PartitionChecksumFlag;
+u8 CompressedPartitionFlag;
 u8 BitstreamFlag;
 u8 ApplicationFlag;
 
@@ -127,6 +140,13 @@ extern u32 FlashReadBaseAddress;
 extern u8 LinearBootDeviceFlag;
 extern XDcfg *DcfgInstPtr;
 
+#ifdef FSBL_LZ4
+/*
+ * Decompressed length in bytes of the last compressed partition
+ */
+static u32 DecompressedLength;
+#endif
+
 /*****************************************************************************/
 /**
 *
@@ -159,6 +179,9 @@ u32 LoadBootImage(void)
 	u32 Status;
 	PartHeader *HeaderPtr;
 	u32 EfuseStatusRegValue;
+#if defined(FSBL_LZ4) && defined(FSBL_FAST_RESUME)
+	PartHeader LoadedHeader;
+#endif
 #ifdef RSA_SUPPORT
 	u8 Hash[SHA_VALBYTES];
 	u8 *Ac;
@@ -172,6 +195,10 @@ u32 LoadBootImage(void)
 	BitstreamFlag = 0;
 	ApplicationFlag = 0;
 
+#ifdef FSBL_FAST_RESUME
+	FsblResumeInvalidate();
+#endif
+
 	RebootStatusRegister = Xil_In32(REBOOT_STATUS_REG);
 	fsbl_printf(DEBUG_INFO,
 			"Reboot status register: 0x%08x\r\n",RebootStatusRegister);
@@ -277,6 +304,14 @@ u32 LoadBootImage(void)
 	PartitionNum = 1;
 #endif
 
+#ifdef FSBL_SMP
+	/*
+	 * Checksum and authentication run on CPU1 from here on, they stay
+	 * on CPU0 if CPU1 is not available
+	 */
+	(void)FsblSmpStart();
+#endif
+
 	while (PartitionNum < PartitionCount) {
 
 		fsbl_printf(DEBUG_INFO, "Partition Number: %lu\r\n", PartitionNum);
@@ -373,6 +408,27 @@ u32 LoadBootImage(void)
 			FsblFallback();
 		}
 #endif
+		/*
+		 * Compressed partition, refer to lz4.h
+		 */
+		if (PartitionAttr & ATTRIBUTE_COMPRESSED_MASK) {
+			fsbl_printf(DEBUG_INFO, "Compressed\r\n");
+#ifndef FSBL_LZ4
+			fsbl_printf(DEBUG_GENERAL,"FSBL_LZ4 not enabled\r\n");
+			OutputStatus(PARTITION_LOAD_FAIL);
+			FsblFallback();
+#endif
+			if (EncryptedPartitionFlag) {
+				fsbl_printf(DEBUG_GENERAL,"Compressed partition can not"
+						" be encrypted\r\n");
+				OutputStatus(PARTITION_LOAD_FAIL);
+				FsblFallback();
+			}
+			CompressedPartitionFlag = 1;
+		} else {
+			CompressedPartitionFlag = 0;
+		}
+
 		/*
 		 * Check for partition checksum check
 		 */
@@ -440,7 +496,9 @@ u32 LoadBootImage(void)
 		/*
 		 * Move partitions from boot device
 		 */
+		XPM_REGION_BEGIN("PartitionMove")
 		Status = PartitionMove(ImageStartAddress, HeaderPtr);
+		XPM_REGION_END()
 		if (Status != XST_SUCCESS) {
 			fsbl_printf(DEBUG_GENERAL,"PARTITION_MOVE_FAIL\r\n");
 			OutputStatus(PARTITION_MOVE_FAIL);
@@ -454,6 +512,15 @@ u32 LoadBootImage(void)
 				 * for authentication and checksum verification
 				 */
 				PartitionStartAddr = DDR_TEMP_START_ADDR;
+#ifdef FSBL_LZ4
+			} else if (CompressedPartitionFlag) {
+				/*
+				 * Compressed PS partition staged below the
+				 * decompression work area
+				 */
+				PartitionStartAddr = LZ4_STAGE_ADDR(
+						PartitionTotalSize << WORD_LENGTH_SHIFT);
+#endif
 			} else {
 				PartitionStartAddr = PartitionLoadAddr;
 			}
@@ -462,10 +529,21 @@ u32 LoadBootImage(void)
 				/*
 				 * Validate the partition data with checksum
 				 */
+#ifdef FSBL_SMP
+				if (FsblSmpActive() != 0) {
+					Status = QueueValidatePartition(PartitionStartAddr,
+						(PartitionTotalSize << WORD_LENGTH_SHIFT),
+						ImageStartAddress  +
+						(PartitionChecksumOffset << WORD_LENGTH_SHIFT),
+						PartitionNum);
+				} else
+#endif
+				XPM_REGION_BEGIN("ValidatePartition")
 				Status = ValidateParition(PartitionStartAddr,
 						(PartitionTotalSize << WORD_LENGTH_SHIFT),
 						ImageStartAddress  +
 						(PartitionChecksumOffset << WORD_LENGTH_SHIFT));
+				XPM_REGION_END()
 				if (Status != XST_SUCCESS) {
 					fsbl_printf(DEBUG_GENERAL,"PARTITION_CHECKSUM_FAIL\r\n");
 					OutputStatus(PARTITION_CHECKSUM_FAIL);
@@ -480,27 +558,41 @@ u32 LoadBootImage(void)
 			 */
 			if (SignedPartitionFlag == 1 ) {
 #ifdef RSA_SUPPORT
-				Xil_DCacheEnable();
-				sha_256((u8 *)PartitionStartAddr,
-						((PartitionTotalSize << WORD_LENGTH_SHIFT) -
-							RSA_PARTITION_SIGNATURE_SIZE),
-						Hash);
-				FsblPrintArray(Hash, 32,
-						"Partition Hash Calculated");
-				Ac = (u8 *)(PartitionStartAddr +
-						(PartitionTotalSize << WORD_LENGTH_SHIFT) -
-							RSA_SIGNATURE_SIZE);
-				Status = AuthenticatePartition((u8*)Ac, Hash);
-				if (Status != XST_SUCCESS) {
+#ifdef FSBL_SMP
+				if (FsblSmpActive() != 0) {
+					Status = FsblSmpQueueAuth(PartitionStartAddr,
+							(PartitionTotalSize << WORD_LENGTH_SHIFT),
+							PartitionNum);
+					if (Status != XST_SUCCESS) {
+						fsbl_printf(DEBUG_GENERAL,"AUTHENTICATION_FAIL\r\n");
+						OutputStatus(AUTHENTICATION_FAIL);
+						FsblFallback();
+					}
+				} else
+#endif
+				{
+					Xil_DCacheEnable();
+					sha_256((u8 *)PartitionStartAddr,
+							((PartitionTotalSize << WORD_LENGTH_SHIFT) -
+								RSA_PARTITION_SIGNATURE_SIZE),
+							Hash);
+					FsblPrintArray(Hash, 32,
+							"Partition Hash Calculated");
+					Ac = (u8 *)(PartitionStartAddr +
+							(PartitionTotalSize << WORD_LENGTH_SHIFT) -
+								RSA_SIGNATURE_SIZE);
+					Status = AuthenticatePartition((u8*)Ac, Hash);
+					if (Status != XST_SUCCESS) {
+						Xil_DCacheFlush();
+						Xil_DCacheDisable();
+						fsbl_printf(DEBUG_GENERAL,"AUTHENTICATION_FAIL\r\n");
+						OutputStatus(AUTHENTICATION_FAIL);
+						FsblFallback();
+					}
+					fsbl_printf(DEBUG_INFO,"Authentication Done\r\n");
 					Xil_DCacheFlush();
-		        	Xil_DCacheDisable();
-					fsbl_printf(DEBUG_GENERAL,"AUTHENTICATION_FAIL\r\n");
-					OutputStatus(AUTHENTICATION_FAIL);
-					FsblFallback();
+					Xil_DCacheDisable();
 				}
-				fsbl_printf(DEBUG_INFO,"Authentication Done\r\n");
-				Xil_DCacheFlush();
-                Xil_DCacheDisable();
 #else
 				/*
 				 * In case user not enabled RSA authentication feature
@@ -511,6 +603,22 @@ u32 LoadBootImage(void)
 #endif
 			}
 
+#ifdef FSBL_SMP
+			/*
+			 * Decryption, decompression and bitstream download consume
+			 * the partition, its checks on CPU1 have to be complete
+			 */
+			if ((EncryptedPartitionFlag && PSPartitionFlag) ||
+					CompressedPartitionFlag || PLPartitionFlag) {
+				Status = FsblSmpWaitAll();
+				if (Status != XST_SUCCESS) {
+					fsbl_printf(DEBUG_GENERAL,"PARTITION_CHECK_FAIL\r\n");
+					OutputStatus(Status);
+					FsblFallback();
+				}
+			}
+#endif
+
 			/*
 			 * Decrypt PS partition
 			 */
@@ -525,10 +633,28 @@ u32 LoadBootImage(void)
 				}
 			}
 
+#ifdef FSBL_LZ4
+			/*
+			 * Decompress the verified partition to its load address
+			 * or to the fabric
+			 */
+			if (CompressedPartitionFlag) {
+				Status = Lz4LoadPartition(PartitionStartAddr,
+						PartitionImageLength << WORD_LENGTH_SHIFT,
+						1, PartitionLoadAddr, PLPartitionFlag,
+						&DecompressedLength);
+				if (Status != XST_SUCCESS) {
+					fsbl_printf(DEBUG_GENERAL,"DECOMPRESSION_FAIL\r\n");
+					OutputStatus(DECOMPRESSION_FAIL);
+					FsblFallback();
+				}
+			}
+#endif
+
 			/*
 			 * Load Signed PL partition in Fabric
 			 */
-			if (PLPartitionFlag) {
+			if (PLPartitionFlag && (CompressedPartitionFlag == 0)) {
 				Status = PcapLoadPartition((u32*)PartitionStartAddr,
 						(u32*)PartitionLoadAddr,
 						PartitionImageLength,
@@ -554,12 +680,42 @@ u32 LoadBootImage(void)
 				FsblFallback();
 			}
 		}
+
+#ifdef FSBL_FAST_RESUME
+#ifdef FSBL_LZ4
+		/*
+		 * The image in DDR is the decompressed one
+		 */
+		if (CompressedPartitionFlag) {
+			LoadedHeader = *HeaderPtr;
+			LoadedHeader.ImageWordLen = (DecompressedLength + 3) >>
+					WORD_LENGTH_SHIFT;
+			FsblResumeRecordPartition(&LoadedHeader);
+		} else
+#endif
+		FsblResumeRecordPartition(HeaderPtr);
+#endif
+
 		/*
 		 * Increment partition number
 		 */
 		PartitionNum++;
 	}
 
+#ifdef FSBL_SMP
+	/*
+	 * Every partition has to be verified before handoff, CPU1 is
+	 * parked as it has nothing left to do
+	 */
+	Status = FsblSmpWaitAll();
+	FsblSmpPark();
+	if (Status != XST_SUCCESS) {
+		fsbl_printf(DEBUG_GENERAL,"PARTITION_CHECK_FAIL\r\n");
+		OutputStatus(Status);
+		FsblFallback();
+	}
+#endif
+
 	return ExecAddress;
 }
 
@@ -1118,6 +1274,36 @@ u32 PartitionMove(u32 ImageBaseAddress, PartHeader *Header)
 		SecureTransferFlag = 0;
 	}
 
+#ifdef FSBL_LZ4
+	if (CompressedPartitionFlag) {
+		if (!(SignedPartitionFlag || PartitionChecksumFlag)) {
+			/*
+			 * Decompress while reading from the boot device,
+			 * PL partition goes straight to PCAP
+			 */
+			Status = Lz4LoadPartition(SourceAddr,
+						(ImageWordLen << WORD_LENGTH_SHIFT),
+						LinearBootDeviceFlag, LoadAddr,
+						PLPartitionFlag, &DecompressedLength);
+			if(Status != XST_SUCCESS) {
+				fsbl_printf(DEBUG_GENERAL, "Decompression Failed\r\n");
+				return XST_FAILURE;
+			}
+
+			return XST_SUCCESS;
+		}
+
+		/*
+		 * Checksum and signature cover the compressed partition, it is
+		 * checked in DDR and decompressed from there, PS partition
+		 * is staged below the decompression work area
+		 */
+		if (PSPartitionFlag) {
+			LoadAddr = LZ4_STAGE_ADDR(ImageWordLen << WORD_LENGTH_SHIFT);
+		}
+	}
+#endif
+
 	/*
 	 * CPU is used for data transfer in case of non-linear
 	 * boot device
@@ -1309,6 +1495,40 @@ u32 ValidateParition(u32 StartAddr, u32 Length, u32 ChecksumOffset)
 }
 
 
+#ifdef FSBL_SMP
+/******************************************************************************/
+/**
+*
+* This function reads the partition checksum from flash and queues the
+* checksum calculation and compare on CPU1
+*
+* @param	Start address of the partition data
+* @param	Length of the partition data
+* @param	Partition check sum offset
+* @param	Partition number
+* @return
+*		- XST_SUCCESS if the check was queued
+*		- XST_FAILURE or the error code of an earlier failed check
+*
+* @note		The result is collected by FsblSmpWaitAll
+*
+*******************************************************************************/
+static u32 QueueValidatePartition(u32 StartAddr, u32 Length,
+		u32 ChecksumOffset, u32 PartitionNum)
+{
+    u8  Checksum[MD5_CHECKSUM_SIZE];
+    u32 Status;
+
+    Status = GetPartitionChecksum(ChecksumOffset, &Checksum[0]);
+    if(Status != XST_SUCCESS) {
+            return XST_FAILURE;
+    }
+
+    return FsblSmpQueueChecksum(StartAddr, Length, &Checksum[0],
+		    PartitionNum);
+}
+#endif
+
 /******************************************************************************/
 /**
 *
@@ -22,6 +22,8 @@
 * 8.00a kc	01/16/13	Added defines for partition owner attribute
 * 9.0   vns	03/21/22	Deleted GetImageHeaderAndSignature() and added
 *				GetNAuthImageHeader()
+* 9.1   pt	10/19/26	Exported ValidateParition() for the USB update mode
+* 9.2   pt	10/19/26	Added compressed partition attribute
 * </pre>
 *
 * @note
@@ -73,6 +75,7 @@ extern "C" {
 #define ATTRIBUTE_CHECKSUM_TYPE_MASK	0x7000	/* Checksum Type */
 #define ATTRIBUTE_RSA_PRESENT_MASK		0x8000	/* RSA Signature Present */
 #define ATTRIBUTE_PARTITION_OWNER_MASK	0x30000	/* Partition Owner */
+#define ATTRIBUTE_COMPRESSED_MASK		0x01000000	/* LZ4 compressed */
 
 #define ATTRIBUTE_PARTITION_OWNER_FSBL	0x00000	/* FSBL Partition Owner */
 
@@ -121,6 +124,7 @@ u32 IsLastPartition(struct HeaderArray *H);
 void HeaderDump(PartHeader *Header);
 u32 GetPartitionCount(PartHeader *Header);
 u32 ValidateHeader(PartHeader *Header);
+u32 ValidateParition(u32 StartAddr, u32 Length, u32 ChecksumOffset);
 u32 DecryptPartition(u32 StartAddr, u32 DataLength, u32 ImageLength);
 
 /************************** Variable Definitions *****************************/
@@ -0,0 +1,713 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file lz4.c
+*
+* Contains code for loading LZ4 compressed partitions.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00a pt	10/19/26 Initial release
+*       pt	10/19/26 Verify the frame header, block and content checksums
+*
+* </pre>
+*
+* @note
+*	Every block is decoded with bounds checks on both the input and the
+*	output, a corrupted frame fails the load but never writes outside
+*	the partition destination or the work area.
+*	The checksums of the frame are XXH32 hashes, the header checksum is
+*	always verified, block and content checksums when the FLG byte says
+*	they are present.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "fsbl.h"
+#include "image_mover.h"
+#include "pcap.h"
+#include "lz4.h"
+#include <string.h>
+
+#ifdef XPAR_XWDTPS_0_BASEADDR
+#include "xwdtps.h"
+#endif
+
+#ifdef FSBL_PERF
+#ifndef SDT
+#include "xtime_l.h"
+#else
+#include "xiltimer.h"
+#endif
+#endif
+
+#ifdef FSBL_LZ4
+
+/************************** Constant Definitions *****************************/
+/*
+ * Frame descriptor FLG byte
+ */
+#define LZ4_FLG_VERSION_MASK		0xC0
+#define LZ4_FLG_VERSION			0x40
+#define LZ4_FLG_BLOCK_INDEP		0x20
+#define LZ4_FLG_BLOCK_CHECKSUM		0x10
+#define LZ4_FLG_CONTENT_SIZE		0x08
+#define LZ4_FLG_CONTENT_CHECKSUM	0x04
+#define LZ4_FLG_DICT_ID			0x01
+
+/*
+ * Frame descriptor BD byte
+ */
+#define LZ4_BD_BLOCK_MAX_SHIFT		4
+#define LZ4_BD_BLOCK_MAX_MASK		0x7
+#define LZ4_MIN_BLOCK_SIZE		0x10000
+
+/*
+ * Magic, FLG, BD, content size and header checksum
+ */
+#define LZ4_FRAME_HEADER_LEN		15
+#define LZ4_DESCRIPTOR_OFFSET		4
+#define LZ4_DESCRIPTOR_LEN		10
+#define LZ4_BLOCK_SIZE_LEN		4
+#define LZ4_BLOCK_CHECKSUM_LEN		4
+#define LZ4_CONTENT_CHECKSUM_LEN	4
+#define LZ4_BLOCK_UNCOMPRESSED		0x80000000
+
+#define LZ4_MIN_MATCH			4
+#define LZ4_RUN_MASK			0xF
+#define LZ4_TOKEN_LITERAL_SHIFT		4
+
+/*
+ * XXH32, the hash of the frame checksums
+ */
+#define LZ4_XXH_PRIME1			0x9E3779B1U
+#define LZ4_XXH_PRIME2			0x85EBCA77U
+#define LZ4_XXH_PRIME3			0xC2B2AE3DU
+#define LZ4_XXH_PRIME4			0x27D4EB2FU
+#define LZ4_XXH_PRIME5			0x165667B1U
+#define LZ4_XXH_STRIPE_LEN		16
+
+/*
+ * Work area layout, the input buffer has room for a block, its checksum,
+ * the size of the next block and the word alignment of the read
+ */
+#define LZ4_IN_BUF			LZ4_WORK_ADDR
+#define LZ4_OUT_BUF(Index)		(LZ4_WORK_ADDR + 0x41000 + \
+					((Index) * LZ4_MAX_BLOCK_SIZE))
+
+/**************************** Type Definitions *******************************/
+typedef struct {
+	u32 Source;	/* Frame start on the boot device or in memory */
+	u32 Length;	/* Stored frame length in bytes, a word multiple */
+	u32 Linear;	/* Frame is memory mapped and read in place */
+} Lz4Source;
+
+typedef struct {
+	u32 Acc[4];	/* Lane accumulators */
+	u32 Total;	/* Bytes hashed */
+	u32 MemLen;	/* Bytes held in Mem */
+	u8 Mem[LZ4_XXH_STRIPE_LEN];	/* Start of an incomplete stripe */
+} Lz4Xxh32;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+#define Lz4Get32(Ptr)	((u32)(Ptr)[0] | ((u32)(Ptr)[1] << 8) | \
+			((u32)(Ptr)[2] << 16) | ((u32)(Ptr)[3] << 24))
+
+#define Lz4Rotl32(Value, Shift)	(((Value) << (Shift)) | \
+			((Value) >> (32 - (Shift))))
+
+/************************** Function Prototypes ******************************/
+static u8 *Lz4Read(Lz4Source *Src, u32 Offset, u32 Length);
+static u32 Lz4DecodeBlock(const u8 *Src, u32 SrcLength, u8 *Dst,
+		u32 DstLength, const u8 *DstBase, u32 *OutLength);
+static void Lz4XxhInit(Lz4Xxh32 *State);
+static void Lz4XxhStripe(u32 *Acc, const u8 *Data);
+static void Lz4XxhUpdate(Lz4Xxh32 *State, const u8 *Data, u32 Length);
+static u32 Lz4XxhDigest(const Lz4Xxh32 *State);
+static u32 Lz4Xxh(const u8 *Data, u32 Length);
+
+/************************** Variable Definitions *****************************/
+extern ImageMoverType MoveImage;
+
+#ifdef XPAR_XWDTPS_0_BASEADDR
+extern XWdtPs Watchdog;	/* Instance of WatchDog Timer	*/
+#endif
+
+/******************************************************************************/
+/**
+*
+* This function loads an LZ4 compressed partition. The frame is read one
+* block at a time, each read also fetches the size of the next block.
+*
+* @param	SourceAddr is the start of the stored partition, a boot device
+*		address for MoveImage or a memory address if Linear is set
+* @param	SourceLength is the stored partition length in bytes
+* @param	Linear is set if SourceAddr is memory mapped
+* @param	DestAddr is the load address of a PS partition
+* @param	ToPcap is set for a PL partition, the decompressed data is sent
+*		to PCAP and DestAddr is not used
+* @param	LoadedLength returns the decompressed length in bytes
+*
+* @return
+*		- XST_SUCCESS if the partition was decompressed and loaded
+*		- XST_FAILURE if the frame is unsupported or corrupted, or the
+*		  read or the PCAP transfer failed
+*
+* @note		The content checksum covers the whole image, a PL partition
+*		has been sent to PCAP when it is checked. A mismatch fails the
+*		load like any other PL load error.
+*
+****************************************************************************/
+u32 Lz4LoadPartition(u32 SourceAddr, u32 SourceLength, u32 Linear,
+		u32 DestAddr, u32 ToPcap, u32 *LoadedLength)
+{
+	Lz4Source Src;
+	u8 *Ptr;
+	u8 *Dst;
+	u8 *DstBase;
+	u32 Flags;
+	u32 BlockMax;
+	u32 BlockSize;
+	u32 BlockLen;
+	u32 ChecksumLen;
+	u32 ContentSize;
+	u32 Offset;
+	u32 ReadLen;
+	u32 Limit;
+	u32 OutLen;
+	u32 Out = 0;
+	u32 Index = 0;
+	u32 Status;
+	Lz4Xxh32 Content;
+#ifdef FSBL_PERF
+	XTime tCur = 0;
+	XTime tEnd = 0;
+
+	FsblGetGlobalTime(&tCur);
+#endif
+
+	Src.Source = SourceAddr;
+	Src.Length = SourceLength;
+	Src.Linear = Linear;
+
+	/*
+	 * Frame header and the size of the first block
+	 */
+	Ptr = Lz4Read(&Src, 0, LZ4_FRAME_HEADER_LEN + LZ4_BLOCK_SIZE_LEN);
+	if (Ptr == NULL) {
+		return XST_FAILURE;
+	}
+
+	if (Lz4Get32(Ptr) != LZ4_FRAME_MAGIC) {
+		fsbl_printf(DEBUG_GENERAL, "LZ4 frame magic mismatch\r\n");
+		return XST_FAILURE;
+	}
+
+	Flags = Ptr[4];
+	BlockMax = 1U << (8 + (2 * ((Ptr[5] >> LZ4_BD_BLOCK_MAX_SHIFT) &
+			LZ4_BD_BLOCK_MAX_MASK)));
+	if (((Flags & LZ4_FLG_VERSION_MASK) != LZ4_FLG_VERSION) ||
+			(Flags & LZ4_FLG_DICT_ID) ||
+			((Flags & LZ4_FLG_CONTENT_SIZE) == 0) ||
+			(BlockMax < LZ4_MIN_BLOCK_SIZE) ||
+			(BlockMax > LZ4_MAX_BLOCK_SIZE) ||
+			(Lz4Get32(Ptr + 10) != 0)) {
+		fsbl_printf(DEBUG_GENERAL, "LZ4 frame format not supported\r\n");
+		return XST_FAILURE;
+	}
+
+	if (((Lz4Xxh(Ptr + LZ4_DESCRIPTOR_OFFSET, LZ4_DESCRIPTOR_LEN) >> 8) &
+			0xFF) != Ptr[LZ4_FRAME_HEADER_LEN - 1]) {
+		fsbl_printf(DEBUG_GENERAL, "LZ4 frame header checksum mismatch\r\n");
+		return XST_FAILURE;
+	}
+
+	ContentSize = Lz4Get32(Ptr + 6);
+	ChecksumLen = (Flags & LZ4_FLG_BLOCK_CHECKSUM) ?
+			LZ4_BLOCK_CHECKSUM_LEN : 0;
+	BlockSize = Lz4Get32(Ptr + LZ4_FRAME_HEADER_LEN);
+	Offset = LZ4_FRAME_HEADER_LEN + LZ4_BLOCK_SIZE_LEN;
+	Lz4XxhInit(&Content);
+
+	fsbl_printf(DEBUG_INFO, "LZ4 frame: %lu bytes, %lu byte blocks\r\n",
+			ContentSize, BlockMax);
+
+	if (ToPcap) {
+		/*
+		 * Every block is sent to PCAP on its own
+		 */
+		if (((Flags & LZ4_FLG_BLOCK_INDEP) == 0) || (ContentSize == 0) ||
+				((ContentSize & 0x3) != 0)) {
+			fsbl_printf(DEBUG_GENERAL,
+					"LZ4 frame not supported for PL\r\n");
+			return XST_FAILURE;
+		}
+
+		Status = PcapStreamStart();
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+	} else {
+		/*
+		 * The image must fit in DDR and must not overlap the work area
+		 * or the stored partition
+		 */
+		if ((DestAddr < DDR_START_ADDR) ||
+				(ContentSize > (DDR_END_ADDR - DestAddr + 1)) ||
+				((DestAddr < (LZ4_WORK_ADDR + LZ4_WORK_SIZE)) &&
+				 ((DestAddr + ContentSize) > LZ4_WORK_ADDR)) ||
+				(Linear && (DestAddr < (SourceAddr + SourceLength)) &&
+				 ((DestAddr + ContentSize) > SourceAddr))) {
+			fsbl_printf(DEBUG_GENERAL,
+					"LZ4 destination overlaps source or work area\r\n");
+			return XST_FAILURE;
+		}
+	}
+
+	while ((BlockSize & ~LZ4_BLOCK_UNCOMPRESSED) != 0) {
+		BlockLen = BlockSize & ~LZ4_BLOCK_UNCOMPRESSED;
+		if (BlockLen > BlockMax) {
+			fsbl_printf(DEBUG_GENERAL, "LZ4 block too large\r\n");
+			return XST_FAILURE;
+		}
+
+		ReadLen = BlockLen + ChecksumLen + LZ4_BLOCK_SIZE_LEN;
+		Ptr = Lz4Read(&Src, Offset, ReadLen);
+		if (Ptr == NULL) {
+			return XST_FAILURE;
+		}
+
+		if ((ChecksumLen != 0) &&
+				(Lz4Xxh(Ptr, BlockLen) != Lz4Get32(Ptr + BlockLen))) {
+			fsbl_printf(DEBUG_GENERAL,
+					"LZ4 block %lu checksum mismatch\r\n", Index);
+			return XST_FAILURE;
+		}
+
+		Limit = ContentSize - Out;
+		if (ToPcap) {
+			Dst = (u8 *)LZ4_OUT_BUF(Index & 0x1);
+			DstBase = Dst;
+		} else {
+			Dst = (u8 *)(DestAddr + Out);
+			DstBase = (Flags & LZ4_FLG_BLOCK_INDEP) ?
+					Dst : (u8 *)DestAddr;
+		}
+		if (Limit > BlockMax) {
+			Limit = BlockMax;
+		}
+
+		if (BlockSize & LZ4_BLOCK_UNCOMPRESSED) {
+			if (BlockLen > Limit) {
+				return XST_FAILURE;
+			}
+			(void)memcpy(Dst, Ptr, BlockLen);
+			OutLen = BlockLen;
+		} else {
+			Status = Lz4DecodeBlock(Ptr, BlockLen, Dst, Limit, DstBase,
+					&OutLen);
+			if (Status != XST_SUCCESS) {
+				fsbl_printf(DEBUG_GENERAL,
+						"LZ4 block %lu corrupted\r\n", Index);
+				return XST_FAILURE;
+			}
+		}
+		Out += OutLen;
+
+		if (Flags & LZ4_FLG_CONTENT_CHECKSUM) {
+			Lz4XxhUpdate(&Content, Dst, OutLen);
+		}
+
+		/*
+		 * The previous block is still in flight, it is waited for
+		 * before this one is queued
+		 */
+		if (ToPcap && (OutLen != 0)) {
+			if ((OutLen & 0x3) != 0) {
+				return XST_FAILURE;
+			}
+			Status = PcapStreamWrite((u32 *)Dst,
+					OutLen >> WORD_LENGTH_SHIFT,
+					(Out == ContentSize) ? 1 : 0);
+			if (Status != XST_SUCCESS) {
+				return XST_FAILURE;
+			}
+		}
+
+#ifdef XPAR_XWDTPS_0_BASEADDR
+		/*
+		 * Prevent WDT reset
+		 */
+		XWdtPs_RestartWdt(&Watchdog);
+#endif
+
+		BlockSize = Lz4Get32(Ptr + BlockLen + ChecksumLen);
+		Offset += ReadLen;
+		Index++;
+	}
+
+	if (Out != ContentSize) {
+		fsbl_printf(DEBUG_GENERAL, "LZ4 frame truncated\r\n");
+		return XST_FAILURE;
+	}
+
+	if (Flags & LZ4_FLG_CONTENT_CHECKSUM) {
+		Ptr = Lz4Read(&Src, Offset, LZ4_CONTENT_CHECKSUM_LEN);
+		if (Ptr == NULL) {
+			return XST_FAILURE;
+		}
+		if (Lz4XxhDigest(&Content) != Lz4Get32(Ptr)) {
+			fsbl_printf(DEBUG_GENERAL,
+					"LZ4 content checksum mismatch\r\n");
+			return XST_FAILURE;
+		}
+	}
+
+	if (ToPcap) {
+		Status = PcapStreamFinish();
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+	}
+
+	*LoadedLength = Out;
+
+#ifdef FSBL_PERF
+	fsbl_printf(DEBUG_GENERAL, "LZ4 %lu to %lu bytes, time taken is ",
+			Offset, Out);
+	FsblMeasurePerfTime(tCur, tEnd);
+#endif
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function returns a pointer to Length bytes of the stored frame. For a
+* memory mapped frame the data is used in place, otherwise it is read with
+* MoveImage to the input buffer, widened to whole words.
+*
+* @param	Src is the stored frame
+* @param	Offset is the byte offset in the frame
+* @param	Length is the number of bytes
+*
+* @return	Pointer to the data, NULL if the range is outside the frame or
+*		the read failed
+*
+* @note		The returned data is valid until the next call
+*
+****************************************************************************/
+static u8 *Lz4Read(Lz4Source *Src, u32 Offset, u32 Length)
+{
+	u32 Start;
+	u32 End;
+	u32 Status;
+
+	if ((Offset > Src->Length) || (Length > (Src->Length - Offset))) {
+		fsbl_printf(DEBUG_GENERAL, "LZ4 read beyond partition\r\n");
+		return NULL;
+	}
+
+	if (Src->Linear) {
+		return (u8 *)(Src->Source + Offset);
+	}
+
+	Start = Offset & ~0x3U;
+	End = (Offset + Length + 0x3U) & ~0x3U;
+
+	Status = MoveImage(Src->Source + Start, LZ4_IN_BUF, End - Start);
+	if (Status != XST_SUCCESS) {
+		fsbl_printf(DEBUG_GENERAL, "Move Image Failed\r\n");
+		return NULL;
+	}
+
+	return (u8 *)(LZ4_IN_BUF + (Offset - Start));
+}
+
+/******************************************************************************/
+/**
+*
+* This function decodes one LZ4 block.
+*
+* @param	Src is the compressed block
+* @param	SrcLength is the compressed block length in bytes
+* @param	Dst is where the block is decoded to
+* @param	DstLength is the space at Dst in bytes
+* @param	DstBase is the lowest address a match may refer to, Dst for
+*		independent blocks
+* @param	OutLength returns the decoded length in bytes
+*
+* @return
+*		- XST_SUCCESS if the block was decoded
+*		- XST_FAILURE if the block is corrupted or does not fit
+*
+* @note		None
+*
+****************************************************************************/
+static u32 Lz4DecodeBlock(const u8 *Src, u32 SrcLength, u8 *Dst,
+		u32 DstLength, const u8 *DstBase, u32 *OutLength)
+{
+	const u8 *Ip = Src;
+	const u8 *IpEnd = Src + SrcLength;
+	u8 *Op = Dst;
+	u8 *OpEnd = Dst + DstLength;
+	const u8 *Match;
+	u32 Token;
+	u32 Length;
+	u32 MatchOffset;
+	u32 Byte;
+
+	while (Ip < IpEnd) {
+		Token = *Ip++;
+
+		/*
+		 * Literals
+		 */
+		Length = Token >> LZ4_TOKEN_LITERAL_SHIFT;
+		if (Length == LZ4_RUN_MASK) {
+			do {
+				if (Ip >= IpEnd) {
+					return XST_FAILURE;
+				}
+				Byte = *Ip++;
+				Length += Byte;
+			} while (Byte == 0xFF);
+		}
+
+		if ((Length > (u32)(IpEnd - Ip)) || (Length > (u32)(OpEnd - Op))) {
+			return XST_FAILURE;
+		}
+		(void)memcpy(Op, Ip, Length);
+		Ip += Length;
+		Op += Length;
+
+		/*
+		 * The last sequence has no match
+		 */
+		if (Ip == IpEnd) {
+			break;
+		}
+
+		/*
+		 * Match
+		 */
+		if ((IpEnd - Ip) < 2) {
+			return XST_FAILURE;
+		}
+		MatchOffset = (u32)Ip[0] | ((u32)Ip[1] << 8);
+		Ip += 2;
+		if ((MatchOffset == 0) || (MatchOffset > (u32)(Op - DstBase))) {
+			return XST_FAILURE;
+		}
+
+		Length = Token & LZ4_RUN_MASK;
+		if (Length == LZ4_RUN_MASK) {
+			do {
+				if (Ip >= IpEnd) {
+					return XST_FAILURE;
+				}
+				Byte = *Ip++;
+				Length += Byte;
+			} while (Byte == 0xFF);
+		}
+		Length += LZ4_MIN_MATCH;
+
+		if (Length > (u32)(OpEnd - Op)) {
+			return XST_FAILURE;
+		}
+
+		Match = Op - MatchOffset;
+		if (MatchOffset >= Length) {
+			(void)memcpy(Op, Match, Length);
+		} else if (MatchOffset == 1) {
+			/*
+			 * Byte run, the common case in bitstreams
+			 */
+			(void)memset(Op, *Match, Length);
+		} else {
+			for (Byte = 0; Byte < Length; Byte++) {
+				Op[Byte] = Match[Byte];
+			}
+		}
+		Op += Length;
+	}
+
+	*OutLength = (u32)(Op - Dst);
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function starts an XXH32 hash with seed 0, the seed of all LZ4 frame
+* checksums.
+*
+* @param	State is the hash state
+*
+* @return	None
+*
+* @note		None
+*
+****************************************************************************/
+static void Lz4XxhInit(Lz4Xxh32 *State)
+{
+	State->Acc[0] = LZ4_XXH_PRIME1 + LZ4_XXH_PRIME2;
+	State->Acc[1] = LZ4_XXH_PRIME2;
+	State->Acc[2] = 0;
+	State->Acc[3] = 0 - LZ4_XXH_PRIME1;
+	State->Total = 0;
+	State->MemLen = 0;
+}
+
+/******************************************************************************/
+/**
+*
+* This function adds one 16 byte stripe to the lane accumulators.
+*
+* @param	Acc is the lane accumulators
+* @param	Data is the stripe
+*
+* @return	None
+*
+* @note		None
+*
+****************************************************************************/
+static void Lz4XxhStripe(u32 *Acc, const u8 *Data)
+{
+	u32 Lane;
+
+	for (Lane = 0; Lane < 4; Lane++) {
+		Acc[Lane] += Lz4Get32(Data + (Lane * 4)) * LZ4_XXH_PRIME2;
+		Acc[Lane] = Lz4Rotl32(Acc[Lane], 13) * LZ4_XXH_PRIME1;
+	}
+}
+
+/******************************************************************************/
+/**
+*
+* This function adds data to an XXH32 hash. The data may be split at any
+* byte, the block boundaries of the frame are not those of the hash.
+*
+* @param	State is the hash state
+* @param	Data is the data to add
+* @param	Length is the data length in bytes
+*
+* @return	None
+*
+* @note		None
+*
+****************************************************************************/
+static void Lz4XxhUpdate(Lz4Xxh32 *State, const u8 *Data, u32 Length)
+{
+	const u8 *End = Data + Length;
+	u32 Fill;
+
+	State->Total += Length;
+
+	if ((State->MemLen + Length) < LZ4_XXH_STRIPE_LEN) {
+		(void)memcpy(State->Mem + State->MemLen, Data, Length);
+		State->MemLen += Length;
+		return;
+	}
+
+	if (State->MemLen != 0) {
+		Fill = LZ4_XXH_STRIPE_LEN - State->MemLen;
+		(void)memcpy(State->Mem + State->MemLen, Data, Fill);
+		Lz4XxhStripe(State->Acc, State->Mem);
+		Data += Fill;
+	}
+
+	while ((u32)(End - Data) >= LZ4_XXH_STRIPE_LEN) {
+		Lz4XxhStripe(State->Acc, Data);
+		Data += LZ4_XXH_STRIPE_LEN;
+	}
+
+	State->MemLen = (u32)(End - Data);
+	(void)memcpy(State->Mem, Data, State->MemLen);
+}
+
+/******************************************************************************/
+/**
+*
+* This function returns the XXH32 hash of the data added so far.
+*
+* @param	State is the hash state
+*
+* @return	Hash value
+*
+* @note		The content size of a supported frame fits 32 bits, so does
+*		the total length
+*
+****************************************************************************/
+static u32 Lz4XxhDigest(const Lz4Xxh32 *State)
+{
+	const u8 *Ptr = State->Mem;
+	const u8 *End = State->Mem + State->MemLen;
+	u32 Hash;
+
+	if (State->Total >= LZ4_XXH_STRIPE_LEN) {
+		Hash = Lz4Rotl32(State->Acc[0], 1) + Lz4Rotl32(State->Acc[1], 7) +
+				Lz4Rotl32(State->Acc[2], 12) +
+				Lz4Rotl32(State->Acc[3], 18);
+	} else {
+		/*
+		 * No stripe was added, Acc[2] still holds the seed
+		 */
+		Hash = State->Acc[2] + LZ4_XXH_PRIME5;
+	}
+	Hash += State->Total;
+
+	while ((End - Ptr) >= 4) {
+		Hash += Lz4Get32(Ptr) * LZ4_XXH_PRIME3;
+		Hash = Lz4Rotl32(Hash, 17) * LZ4_XXH_PRIME4;
+		Ptr += 4;
+	}
+	while (Ptr < End) {
+		Hash += (u32)(*Ptr) * LZ4_XXH_PRIME5;
+		Hash = Lz4Rotl32(Hash, 11) * LZ4_XXH_PRIME1;
+		Ptr++;
+	}
+
+	Hash ^= Hash >> 15;
+	Hash *= LZ4_XXH_PRIME2;
+	Hash ^= Hash >> 13;
+	Hash *= LZ4_XXH_PRIME3;
+	Hash ^= Hash >> 16;
+
+	return Hash;
+}
+
+/******************************************************************************/
+/**
+*
+* This function returns the XXH32 hash of a buffer.
+*
+* @param	Data is the data to hash
+* @param	Length is the data length in bytes
+*
+* @return	Hash value
+*
+* @note		None
+*
+****************************************************************************/
+static u32 Lz4Xxh(const u8 *Data, u32 Length)
+{
+	Lz4Xxh32 State;
+
+	Lz4XxhInit(&State);
+	Lz4XxhUpdate(&State, Data, Length);
+
+	return Lz4XxhDigest(&State);
+}
+
+#endif /* FSBL_LZ4 */
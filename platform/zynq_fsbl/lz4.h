@@ -0,0 +1,108 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file lz4.h
+*
+* This file contains the interface for LZ4 compressed partitions.
+*
+* A partition with ATTRIBUTE_COMPRESSED_MASK set in its attribute word holds
+* an LZ4 frame instead of the raw image. The FSBL decompresses it block by
+* block while it reads the partition from the boot device: a PS partition is
+* decompressed to its load address, the blocks of a PL partition are sent to
+* PCAP as they are decompressed, two output buffers keep the PCAP DMA running
+* while the next block is read and decompressed.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00a pt	10/19/26 Initial release
+*       pt	10/19/26 Verify the frame checksums
+*
+* </pre>
+*
+* @note
+*
+* FSBL_LZ4 must be defined to enable this feature.
+*
+* Supported frames, as written by "lz4 -B4 --content-size" or
+* "lz4 -B5 --content-size":
+*	- 64 KB or 256 KB maximum block size
+*	- content size present in the frame descriptor
+*	- no dictionary ID
+*	- independent blocks for PL partitions, linked blocks (-BD) are only
+*	  supported for PS partitions
+*	- a word multiple content size for PL partitions
+* The frame header checksum is verified, block and content checksums are
+* verified when the frame has them. lz4 writes a content checksum unless it
+* is given --no-frame-crc, -BX adds block checksums.
+*
+* tools/fsbl_lz4_pack.py compresses partitions of an existing boot image.
+*
+* The partition header lengths describe the stored (compressed) partition.
+* The partition checksum and the RSA signature are calculated over the stored
+* partition as well, so they are verified before anything is decompressed.
+* Such a partition is first copied to DDR, a PL partition to
+* DDR_TEMP_START_ADDR and a PS partition to LZ4_STAGE_ADDR, and decompressed
+* from there after the checks passed. Compressed partitions can not be
+* encrypted.
+*
+* The application must not be loaded over the LZ4_WORK_SIZE bytes at
+* LZ4_WORK_ADDR or, for checked PS partitions, over the staging area below
+* them.
+*
+******************************************************************************/
+#ifndef ___LZ4_H___
+#define ___LZ4_H___
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "fsbl.h"
+
+/************************** Constant Definitions *****************************/
+#define LZ4_FRAME_MAGIC			0x184D2204
+
+/*
+ * Largest supported block size, selects the work area layout
+ */
+#define LZ4_MAX_BLOCK_SIZE		0x40000
+
+/*
+ * Work area for the input buffer and the two PCAP output buffers
+ */
+#define LZ4_WORK_SIZE			0x100000
+
+#ifndef LZ4_WORK_ADDR
+#define LZ4_WORK_ADDR			(DDR_END_ADDR + 1 - 0x200000)
+#endif
+
+/*
+ * Staging address of a checked PS partition of Len bytes
+ */
+#define LZ4_STAGE_ADDR(Len)		((LZ4_WORK_ADDR - (Len)) & ~0xFFFU)
+
+/**************************** Type Definitions *******************************/
+
+/************************** Function Prototypes ******************************/
+#ifdef FSBL_LZ4
+u32 Lz4LoadPartition(u32 SourceAddr, u32 SourceLength, u32 Linear,
+		u32 DestAddr, u32 ToPcap, u32 *LoadedLength);
+#endif
+
+/************************** Variable Definitions *****************************/
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* ___LZ4_H___ */
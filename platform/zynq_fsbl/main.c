@@ -87,6 +87,16 @@
 * 21.2   ng  07/25/23   Fixed DDR, WDT, NAND and QSPI addresses support in SDT
 * 21.3   ng  03/09/24   Fix format specifier for 32 bit variables
 * 21.4   ng  10/03/24   Fix change in macro name for QSPI linear flash
+* 21.5   pt  10/19/26   Added fast resume boot path under FSBL_FAST_RESUME
+*                       Added FSBL_PERF_REGIONS region counter report
+* 21.6   pt  10/19/26   Park CPU1 on fallback under FSBL_SMP
+* 21.7   pt  10/19/26   Added USB update mode under FSBL_USB_UPDATE
+* 21.8   pt  10/19/26   Print the startup phase times under FSBL_PERF if the
+*                       BSP is built with XIL_STARTUP_TIMES
+* 21.9   pt  10/19/26   Calibrate the region counters after the data cache
+*                       is disabled
+* 21.10  pt  10/19/26   Print the startup phase times without depending on
+*                       XIL_STARTUP_TIMES in the FSBL build
 *
 * </pre>
 *
@@ -118,6 +128,9 @@
 #include "xil_exception.h"
 #include "xstatus.h"
 #include "fsbl_hooks.h"
+#include "resume.h"
+#include "smp.h"
+#include "usb.h"
 #ifndef SDT
 #include "xtime_l.h"
 #else
@@ -274,6 +287,15 @@ int main(void)
 	 */
 	Xil_DCacheDisable();
 
+#ifdef FSBL_PERF_REGIONS
+	/*
+	 * Calibrate with the data cache in its final state, the probe
+	 * overhead depends on whether the region table is cached
+	 */
+	(void)XPmRegion_Init();
+	XPmRegion_Calibrate();
+#endif
+
 	/*
 	 * Register the Exception handlers
 	 */
@@ -287,8 +309,32 @@ int main(void)
 			SDK_RELEASE_YEAR, SDK_RELEASE_QUARTER,
 			__DATE__,__TIME__);
 
+#ifdef FSBL_PERF
+	FsblPrintStartupTimes();
+#endif
+
 #if defined(XPAR_PS7_DDR_0_S_AXI_BASEADDR) || defined(XPAR_PS7_DDR_0_BASEADDRESS)
 
+#ifdef FSBL_FAST_RESUME
+	/*
+	 * Software reset with the previous image intact in DDR, hand off
+	 * without the DDR test, boot device init and partition copy.
+	 * DDRInitCheck would overwrite the resumed image, so this check
+	 * has to come first
+	 */
+	if (FsblResumeCheck(&HandoffAddress, &BitstreamFlag) == XST_SUCCESS) {
+		fsbl_printf(DEBUG_GENERAL,"Fast resume, Handoff Address: 0x%08x\r\n",
+				HandoffAddress);
+		MarkFSBLIn();
+#ifdef FSBL_PERF
+		XTime tResumeEnd = 0;
+		fsbl_printf(DEBUG_GENERAL,"Fast resume time is ");
+		FsblMeasurePerfTime(tCur, tResumeEnd);
+#endif
+		FsblHandoff(HandoffAddress);
+	}
+#endif
+
     /*
      * DDR Read/write test 
      */
@@ -376,6 +422,15 @@ int main(void)
 	BootModeRegister = Xil_In32(BOOT_MODE_REG);
 	BootModeRegister &= BOOT_MODES_MASK;
 
+#ifdef FSBL_USB_UPDATE
+	/*
+	 * USB update requested by the application or JTAG boot mode
+	 */
+	if (FsblUsbRequested(BootModeRegister) != 0) {
+		BootModeRegister = USB_UPDATE_MODE;
+	}
+#endif
+
 	/*
 	 * QSPI BOOT MODE
 	 */
@@ -477,6 +532,26 @@ int main(void)
 		fsbl_printf(DEBUG_INFO,"MMC Init Done \r\n");
 	} else
 
+#endif
+
+	/*
+	 * USB UPDATE MODE
+	 */
+#ifdef FSBL_USB_UPDATE
+	if (BootModeRegister == USB_UPDATE_MODE) {
+		fsbl_printf(DEBUG_GENERAL,"Boot mode is USB update\r\n");
+
+		/*
+		 * Returns once the host requests to boot a validated image
+		 */
+		Status = FsblUsbUpdate();
+		if (Status != XST_SUCCESS) {
+			fsbl_printf(DEBUG_GENERAL,"USB_INIT_FAIL\r\n");
+			OutputStatus(USB_INIT_FAIL);
+			FsblFallback();
+		}
+		fsbl_printf(DEBUG_INFO,"USB Update Done \r\n");
+	} else
 #endif
 
 	/*
@@ -531,6 +606,9 @@ int main(void)
 	if ((FlashReadBaseAddress != XPS_QSPI_LINEAR_BASEADDR) &&
 			(FlashReadBaseAddress != XPS_NAND_BASEADDR) &&
 			(FlashReadBaseAddress != XPS_NOR_BASEADDR) &&
+#ifdef FSBL_USB_UPDATE
+			(FlashReadBaseAddress != FSBL_USB_STAGING_ADDR) &&
+#endif
 			(FlashReadBaseAddress != XPS_SDIO0_BASEADDR)) {
 		fsbl_printf(DEBUG_GENERAL,"INVALID_FLASH_ADDRESS \r\n");
 		OutputStatus(INVALID_FLASH_ADDRESS);
@@ -565,6 +643,13 @@ int main(void)
 
 	fsbl_printf(DEBUG_INFO,"Handoff Address: 0x%08x\r\n",HandoffAddress);
 
+#ifdef FSBL_FAST_RESUME
+	/*
+	 * Record the loaded image for the next software reset
+	 */
+	FsblResumeCommit(HandoffAddress, BitstreamFlag);
+#endif
+
 	/*
 	 * For Performance measurement
 	 */
@@ -574,6 +659,10 @@ int main(void)
 	FsblMeasurePerfTime(tCur,tEnd);
 #endif
 
+#ifdef FSBL_PERF_REGIONS
+	XPmRegion_Report();
+#endif
+
 	/*
 	 * FSBL handoff to valid handoff address or
 	 * exit in JTAG
@@ -607,6 +696,13 @@ void FsblFallback(void)
 	u32 HandoffAddr;
 	u32 BootModeRegister;
 
+#ifdef FSBL_SMP
+	/*
+	 * CPU1 must not run FSBL code across a retry or reset
+	 */
+	FsblSmpPark();
+#endif
+
 	/*
 	 * Read bootmode register
 	 */
@@ -773,7 +869,12 @@ void FsblHandoff(u32 FsblStartAddr)
 	}
 
 #ifdef XPAR_XWDTPS_0_BASEADDR
-	XWdtPs_Stop(&Watchdog);
+	/*
+	 * Watchdog is not initialized on the fast resume path
+	 */
+	if (Watchdog.IsReady == XIL_COMPONENT_IS_READY) {
+		XWdtPs_Stop(&Watchdog);
+	}
 #endif
 
 	/*
@@ -1133,6 +1234,42 @@ void FsblMeasurePerfTime (XTime tCur, XTime tEnd)
 #endif
 
 }
+
+/******************************************************************************
+*
+* This function prints the time from _start to main, split into the
+* startup phases sampled by xil-crt0.S
+*
+* @param	None
+*
+* @return
+*			None
+*
+* @note		XIL_STARTUP_TIMES is a BSP build option and is not visible
+*			here, the phases read back as 0 if the BSP did not sample
+*			them
+*
+*******************************************************************************/
+void FsblPrintStartupTimes(void)
+{
+	Xil_StartupTimes Times;
+	u32 CountsPerUs = (u32)(COUNTS_PER_SECOND / 1000000U);
+
+	Xil_StartupGetTimes(&Times);
+
+	if (Times.TotalCounts == 0U) {
+		fsbl_printf(DEBUG_INFO,"Startup times not sampled, build the "
+				"BSP with XIL_STARTUP_TIMES\r\n");
+		return;
+	}
+
+	fsbl_printf(DEBUG_GENERAL,"Time to main %d us: cpu init %d us, "
+			"bss %d us, constructors %d us\r\n",
+			(u32)(Times.TotalCounts / CountsPerUs),
+			(u32)(Times.CpuInitCounts / CountsPerUs),
+			(u32)(Times.BssCounts / CountsPerUs),
+			(u32)(Times.CtorCounts / CountsPerUs));
+}
 #endif
 
 /******************************************************************************
@@ -62,6 +62,10 @@
 * 											3.0 and later versions of silicon.
 * 21.1   ng  07/13/23   Add SDT support
 * 21.2   ng  03/09/24   Fix format specifier for 32 bit variables
+* 21.7   pt  10/19/26   XDcfgPollDone waits in WFI if FSBL_WFI_WAIT is defined
+* 21.8   pt  10/19/26   Added PcapStreamStart, PcapStreamWrite and
+*                       PcapStreamFinish to download a non-secure bitstream
+*                       in chunks
 * </pre>
 *
 * @note
@@ -78,6 +82,7 @@
 #include "xil_exception.h"
 #include "xdevcfg.h"
 #include "sleep.h"
+#include "xil_cache.h"
 #ifndef SDT
 #include "xtime_l.h"
 #else
@@ -86,6 +91,10 @@
 #ifdef XPAR_XWDTPS_0_BASEADDR
 #include "xwdtps.h"
 #endif
+#if defined (FSBL_WFI_WAIT) && defined (__GNUC__)
+#include "xil_wait.h"
+#define FSBL_WAIT_WFI
+#endif
 /************************** Constant Definitions *****************************/
 /*
  * The following constants map to the XPAR parameters created in the
@@ -99,12 +108,21 @@
 #define DCFG_DEVICE_ID		XPAR_XDEVCFG_0_BASEADDR
 #endif
 
+#ifdef FSBL_WAIT_WFI
+/*
+ * Time allowed for one PCAP DMA or PL done event when waiting in WFI,
+ * in microseconds
+ */
+#define PCAP_WFI_TIMEOUT_US	30000000U
+#endif
+
 /**************************** Type Definitions *******************************/
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /************************** Function Prototypes ******************************/
 extern int XDcfgPollDone(u32 MaskValue, u32 MaxCount);
+static u32 PcapStreamWait(void);
 
 /************************** Variable Definitions *****************************/
 /* Devcfg driver instance */
@@ -115,6 +133,11 @@ extern u32 Silicon_Version;
 extern XWdtPs Watchdog;	/* Instance of WatchDog Timer	*/
 #endif
 
+/*
+ * Set while a PcapStreamWrite transfer is in flight
+ */
+static u32 PcapStreamBusy;
+
 /******************************************************************************/
 /**
 *
@@ -361,6 +384,173 @@ u32 PcapLoadPartition(u32 *SourceDataPtr, u32 *DestinationDataPtr,
 	return XST_SUCCESS;
 }
 
+/******************************************************************************/
+/**
+*
+* This function prepares the PL for a bitstream which is downloaded in
+* chunks with PcapStreamWrite
+*
+* @param	None
+*
+* @return
+*		- XST_SUCCESS if the PL is ready for the bitstream
+*		- XST_FAILURE if clearing the status or the fabric init failed
+*
+* @note		Only non-secure bitstreams can be downloaded in chunks
+*
+****************************************************************************/
+u32 PcapStreamStart(void)
+{
+	u32 Status;
+
+	Status = ClearPcapStatus();
+	if (Status != XST_SUCCESS) {
+		fsbl_printf(DEBUG_INFO,"PCAP_CLEAR_STATUS_FAIL \r\n");
+		return XST_FAILURE;
+	}
+
+	Status = FabricInit();
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+#ifdef	XPAR_XWDTPS_0_BASEADDR
+	/*
+	 * Prevent WDT reset
+	 */
+	XWdtPs_RestartWdt(&Watchdog);
+#endif
+
+	PcapStreamBusy = 0;
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function queues one chunk of a bitstream. It waits for the previous
+* chunk, so the caller may fill another buffer while a chunk is in flight.
+*
+* @param 	SourceDataPtr is a pointer to the chunk
+* @param 	WordLength is the length of the chunk in words
+* @param 	LastTransfer is set for the last chunk of the bitstream
+*
+* @return
+*		- XST_SUCCESS if the chunk was queued
+*		- XST_FAILURE if the previous chunk or the transfer failed
+*
+* @note		The buffer of a chunk must not be changed before the next
+*		PcapStreamWrite or PcapStreamFinish returned
+*
+****************************************************************************/
+u32 PcapStreamWrite(u32 *SourceDataPtr, u32 WordLength, u32 LastTransfer)
+{
+	u32 Status;
+	u32 SourceAddr = (u32)SourceDataPtr;
+	u32 DestinationAddr = XDCFG_DMA_INVALID_ADDRESS;
+
+	Status = PcapStreamWait();
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Xil_DCacheFlushRange((INTPTR)SourceDataPtr,
+			WordLength << WORD_LENGTH_SHIFT);
+
+	if (LastTransfer) {
+		SourceAddr |= PCAP_LAST_TRANSFER;
+		DestinationAddr |= PCAP_LAST_TRANSFER;
+	}
+
+	Status = XDcfg_Transfer(DcfgInstPtr, (u8 *)SourceAddr,
+					WordLength,
+					(u8 *)DestinationAddr,
+					WordLength, XDCFG_NON_SECURE_PCAP_WRITE);
+	if (Status != XST_SUCCESS) {
+		fsbl_printf(DEBUG_INFO,"Status of XDcfg_Transfer = %lu \r \n",Status);
+		return XST_FAILURE;
+	}
+
+	PcapStreamBusy = 1;
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function waits for the last chunk and for the PL configuration
+*
+* @param	None
+*
+* @return
+*		- XST_SUCCESS if the PL is configured
+*		- XST_FAILURE if the transfer or the configuration failed
+*
+* @note		None
+*
+****************************************************************************/
+u32 PcapStreamFinish(void)
+{
+	u32 Status;
+	u32 IntrStsReg;
+
+	Status = PcapStreamWait();
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = XDcfgPollDone(XDCFG_IXR_PCFG_DONE_MASK, MAX_COUNT);
+	if (Status != XST_SUCCESS) {
+		fsbl_printf(DEBUG_INFO,"PCAP_FPGA_DONE_FAIL\r\n");
+		return XST_FAILURE;
+	}
+
+	fsbl_printf(DEBUG_INFO,"FPGA Done ! \n\r");
+
+	IntrStsReg = XDcfg_IntrGetStatus(DcfgInstPtr);
+	if (IntrStsReg & FSBL_XDCFG_IXR_ERROR_FLAGS_MASK) {
+		fsbl_printf(DEBUG_INFO,"Errors in PCAP \r\n");
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function waits for the DMA done of the chunk in flight, if any
+*
+* @param	None
+*
+* @return
+*		- XST_SUCCESS if no chunk is in flight any more
+*		- XST_FAILURE if the chunk failed
+*
+* @note		None
+*
+****************************************************************************/
+static u32 PcapStreamWait(void)
+{
+	u32 Status;
+
+	if (PcapStreamBusy == 0) {
+		return XST_SUCCESS;
+	}
+
+	Status = XDcfgPollDone(XDCFG_IXR_DMA_DONE_MASK, MAX_COUNT);
+	if (Status != XST_SUCCESS) {
+		fsbl_printf(DEBUG_INFO,"PCAP_DMA_DONE_FAIL \r\n");
+		return XST_FAILURE;
+	}
+
+	PcapStreamBusy = 0;
+
+	return XST_SUCCESS;
+}
+
 /******************************************************************************/
 /**
 *
@@ -762,6 +952,53 @@ void PcapDumpRegisters (void) {
 * @note		none
 *
 ****************************************************************************/
+#ifdef FSBL_WAIT_WFI
+int XDcfgPollDone(u32 MaskValue, u32 MaxCount)
+{
+	u32 IntrStsReg = 0;
+	u32 WaitMask = MaskValue | FSBL_XDCFG_IXR_ERROR_FLAGS_MASK;
+	u32 Enabled;
+	u32 Status = XST_SUCCESS;
+
+	(void)MaxCount;
+
+	/*
+	 * Unmask the done and error interrupts, so that the devcfg interrupt
+	 * wakes the core, and sleep until all done bits are set or an error
+	 * is flagged
+	 */
+	Enabled = XDcfg_IntrGetEnabled(DcfgInstPtr);
+	XDcfg_IntrEnable(DcfgInstPtr, WaitMask);
+	IntrStsReg = XDcfg_IntrGetStatus(DcfgInstPtr);
+	while (((IntrStsReg & MaskValue) != MaskValue) &&
+		((IntrStsReg & FSBL_XDCFG_IXR_ERROR_FLAGS_MASK) == 0U)) {
+		Status = Xil_WaitForEventsWfi(DcfgInstPtr->Config.BaseAddr +
+				XDCFG_INT_STS_OFFSET, WaitMask,
+				WaitMask & ~IntrStsReg, PCAP_WFI_TIMEOUT_US,
+				&IntrStsReg, XPS_DVC_INT_ID);
+		if (Status != XST_SUCCESS) {
+			break;
+		}
+	}
+	XDcfg_IntrDisable(DcfgInstPtr, WaitMask & ~Enabled);
+
+	if (IntrStsReg & FSBL_XDCFG_IXR_ERROR_FLAGS_MASK) {
+		fsbl_printf(DEBUG_INFO,"FATAL errors in PCAP %lx\r\n",
+				IntrStsReg);
+		PcapDumpRegisters();
+		return XST_FAILURE;
+	}
+
+	if (Status != XST_SUCCESS) {
+		fsbl_printf(DEBUG_GENERAL,"PCAP transfer timed out \r\n");
+		return XST_FAILURE;
+	}
+
+	XDcfg_IntrClear(DcfgInstPtr, IntrStsReg & MaskValue);
+
+	return XST_SUCCESS;
+}
+#else
 int XDcfgPollDone(u32 MaskValue, u32 MaxCount)
 {
 	int Count = MaxCount;
@@ -798,3 +1035,4 @@ int XDcfgPollDone(u32 MaskValue, u32 MaxCount)
 
 	return XST_SUCCESS;
 }
+#endif
@@ -24,6 +24,8 @@
 * 						the PL power before sequence starts and checking INIT_B
 * 						reset status twice in case of failure.
 * 21.2  ng 07/13/23  Add SDT support
+* 21.8  pt 10/19/26  Added the PcapStream functions for chunked bitstream
+*                    download
 * </pre>
 *
 * @note
@@ -79,6 +81,9 @@ u32 PcapLoadPartition(u32 *SourceData, u32 *DestinationData, u32 SourceLength,
 		 	u32 DestinationLength, u32 Flags);
 u32 PcapDataTransfer(u32 *SourceData, u32 *DestinationData, u32 SourceLength,
  			u32 DestinationLength, u32 Flags);
+u32 PcapStreamStart(void);
+u32 PcapStreamWrite(u32 *SourceData, u32 WordLength, u32 LastTransfer);
+u32 PcapStreamFinish(void);
 /************************** Variable Definitions *****************************/
 #ifdef __cplusplus
 }
@@ -41,6 +41,10 @@
 * 21.1  ng 07/13/23  Add SDT support
 * 21.2  ng 07/25/23  Updated QSPI address support in SDT flow
 * 21.4   ng  10/03/24   Fix change in macro name for QSPI linear flash
+* 21.5   pt  10/19/26   Added non-blocking sector erase and page program
+*                       for the USB update mode (FSBL_USB_UPDATE)
+* 21.7   pt  10/19/26   Keep ReadBuffer out of .bss, it is only read after
+*                       a transfer fills it
 * </pre>
 *
 * @note
@@ -55,6 +59,7 @@
 #if defined(XPAR_PS7_QSPI_LINEAR_0_S_AXI_BASEADDR) || defined(XPAR_PS7_QSPI_LINEAR_0_BASEADDRESS)
 #include "xqspips_hw.h"
 #include "xqspips.h"
+#include "xil_startup.h"
 
 /************************** Constant Definitions *****************************/
 
@@ -86,6 +91,11 @@
 /* Bank register is called Extended Address Reg in Micron */
 #define EXTADD_REG_RD		0xC8
 #define EXTADD_REG_WR		0xC5
+#define SECTOR_ERASE_CMD	0xD8
+#define PAGE_PROGRAM_CMD	0x02
+#define READ_STATUS_CMD		0x05
+
+#define FLASH_SR_WIP_MASK	0x01 /* Write or erase in progress */
 
 #define COMMAND_OFFSET		0 /* FLASH instruction */
 #define ADDRESS_1_OFFSET	1 /* MSB byte of address to read or write */
@@ -99,6 +109,7 @@
 #define RD_ID_SIZE			4 /* Read ID command + 3 bytes ID response */
 #define BANK_SEL_SIZE		2 /* BRWR or EARWR command + 1 byte bank value */
 #define WRITE_ENABLE_CMD_SIZE	1 /* WE command */
+#define READ_STATUS_CMD_SIZE	2 /* RDSR command + 1 byte status */
 /*
  * The following constants specify the extra bytes which are sent to the
  * FLASH on the QSPI interface, that are not data, but control information
@@ -189,9 +200,21 @@ extern u8 LinearBootDeviceFlag;
  * The following variables are used to read and write to the eeprom and they
  * are global to avoid having large buffers on the stack
  */
-u8 ReadBuffer[DATA_SIZE + DATA_OFFSET + DUMMY_SIZE];
+XIL_NOINIT u8 ReadBuffer[DATA_SIZE + DATA_OFFSET + DUMMY_SIZE];
 u8 WriteBuffer[DATA_OFFSET + DUMMY_SIZE];
 
+#ifdef FSBL_USB_UPDATE
+/*
+ * Page program command, address and data
+ */
+static u8 ProgramBuffer[OVERHEAD_SIZE + QSPI_PAGE_SIZE];
+
+/*
+ * Bank currently selected for erase/program, 0xFF if unknown
+ */
+static u8 WriteBankSel = 0xFF;
+#endif
+
 /******************************************************************************/
 /**
 *
@@ -867,5 +890,183 @@ u32 SendBankSelect(u8 BankSel)
 
 	return XST_SUCCESS;
 }
-#endif
 
+#ifdef FSBL_USB_UPDATE
+/******************************************************************************
+*
+* This function prepares the QSPI controller for erase and program commands.
+* Linear mode is switched off, the flash is accessed in IO mode from here on.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if the flash can be written
+*			XST_FAILURE for dual stacked or dual parallel connections
+*
+* @note		InitQspi must have been called before.
+*
+******************************************************************************/
+u32 QspiWriteInit(void)
+{
+	u32 Status;
+
+	if (QSPI_CONNECTION_MODE != SINGLE_FLASH_CONNECTION) {
+		fsbl_printf(DEBUG_GENERAL, "QSPI program: single flash only\r\n");
+		return XST_FAILURE;
+	}
+
+	Status = XQspiPs_SetOptions(QspiInstancePtr,
+			XQSPIPS_FORCE_SSELECT_OPTION | XQSPIPS_HOLD_B_DRIVE_OPTION);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	XQspiPs_SetSlaveSelect(QspiInstancePtr);
+
+	LinearBootDeviceFlag = 0;
+	WriteBankSel = 0xFF;
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************
+*
+* This function selects the bank of an erase/program address and sends the
+* write enable command.
+*
+* @param	Address is the flash address of the following command
+*
+* @return	XST_SUCCESS or XST_FAILURE
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 QspiWriteEnable(u32 Address)
+{
+	u32 Status;
+	u8 BankSel;
+
+	BankSel = (u8)(Address / FLASH_SIZE_16MB);
+	if ((QspiFlashSize > FLASH_SIZE_16MB) && (BankSel != WriteBankSel)) {
+		Status = SendBankSelect(BankSel);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+		WriteBankSel = BankSel;
+	}
+
+	WriteBuffer[COMMAND_OFFSET] = WRITE_ENABLE_CMD;
+	Status = XQspiPs_PolledTransfer(QspiInstancePtr, WriteBuffer, NULL,
+			WRITE_ENABLE_CMD_SIZE);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************
+*
+* This function starts the erase of one QSPI_SECTOR_SIZE sector and returns
+* without waiting for the erase to finish.
+*
+* @param	Address is the flash address of the sector
+*
+* @return	XST_SUCCESS if the erase was started, otherwise XST_FAILURE
+*
+* @note		QspiIsBusy must return 0 before the next command.
+*
+******************************************************************************/
+u32 QspiEraseSectorStart(u32 Address)
+{
+	u32 Status;
+
+	Status = QspiWriteEnable(Address);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	WriteBuffer[COMMAND_OFFSET]   = SECTOR_ERASE_CMD;
+	WriteBuffer[ADDRESS_1_OFFSET] = (u8)((Address & 0xFF0000) >> 16);
+	WriteBuffer[ADDRESS_2_OFFSET] = (u8)((Address & 0xFF00) >> 8);
+	WriteBuffer[ADDRESS_3_OFFSET] = (u8)(Address & 0xFF);
+
+	Status = XQspiPs_PolledTransfer(QspiInstancePtr, WriteBuffer, NULL,
+			OVERHEAD_SIZE);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************
+*
+* This function starts programming up to one page and returns without
+* waiting for the program to finish.
+*
+* @param	Address is the flash address, the data must not cross a page
+* @param	Data is the data to program
+* @param	Length is the number of bytes, at most QSPI_PAGE_SIZE
+*
+* @return	XST_SUCCESS if the program was started, otherwise XST_FAILURE
+*
+* @note		QspiIsBusy must return 0 before the next command.
+*
+******************************************************************************/
+u32 QspiProgramPageStart(u32 Address, const u8 *Data, u32 Length)
+{
+	u32 Status;
+
+	if ((Length == 0) || (Length > QSPI_PAGE_SIZE) ||
+			(((Address & (QSPI_PAGE_SIZE - 1)) + Length) > QSPI_PAGE_SIZE)) {
+		return XST_FAILURE;
+	}
+
+	Status = QspiWriteEnable(Address);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	ProgramBuffer[COMMAND_OFFSET]   = PAGE_PROGRAM_CMD;
+	ProgramBuffer[ADDRESS_1_OFFSET] = (u8)((Address & 0xFF0000) >> 16);
+	ProgramBuffer[ADDRESS_2_OFFSET] = (u8)((Address & 0xFF00) >> 8);
+	ProgramBuffer[ADDRESS_3_OFFSET] = (u8)(Address & 0xFF);
+	memcpy(&ProgramBuffer[DATA_OFFSET], Data, Length);
+
+	Status = XQspiPs_PolledTransfer(QspiInstancePtr, ProgramBuffer, NULL,
+			OVERHEAD_SIZE + Length);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************
+*
+* This function reads the flash status register.
+*
+* @param	None
+*
+* @return	1 while an erase or program is in progress, otherwise 0
+*
+* @note		A failed status read is reported as busy.
+*
+******************************************************************************/
+u32 QspiIsBusy(void)
+{
+	u32 Status;
+
+	WriteBuffer[COMMAND_OFFSET] = READ_STATUS_CMD;
+	WriteBuffer[ADDRESS_1_OFFSET] = 0x00;
+
+	Status = XQspiPs_PolledTransfer(QspiInstancePtr, WriteBuffer, ReadBuffer,
+			READ_STATUS_CMD_SIZE);
+	if (Status != XST_SUCCESS) {
+		return 1;
+	}
+
+	return (ReadBuffer[1] & FLASH_SR_WIP_MASK) ? 1 : 0;
+}
+#endif
+#endif
@@ -20,6 +20,7 @@
 * 5.00a sgd	05/17/13 Added Flash Size > 128Mbit support
 * 					 Dual Stack support
 * 6.00a bsv	09/04/20 Added support for 2Gb flash parts
+* 21.5  pt	10/19/26 Added non-blocking erase/program for FSBL_USB_UPDATE
 * </pre>
 *
 * @note
@@ -94,6 +95,12 @@ extern "C" {
 #define FLASH_SIZE_1G			0x8000000
 #define FLASH_SIZE_2G			0x10000000
 
+/*
+ * Erase and program granularity used by the USB update mode
+ */
+#define QSPI_SECTOR_SIZE		0x10000
+#define QSPI_PAGE_SIZE			0x100
+
 /************************** Function Prototypes ******************************/
 u32 InitQspi(void);
 
@@ -103,6 +110,13 @@ u32 QspiAccess( u32 SourceAddress,
 
 u32 FlashReadID(void);
 u32 SendBankSelect(u8 BankSel);
+
+#ifdef FSBL_USB_UPDATE
+u32 QspiWriteInit(void);
+u32 QspiEraseSectorStart(u32 Address);
+u32 QspiProgramPageStart(u32 Address, const u8 *Data, u32 Length);
+u32 QspiIsBusy(void);
+#endif
 /************************** Variable Definitions *****************************/
 
 
@@ -0,0 +1,382 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file resume.c
+*
+* Contains code for the FSBL fast resume boot path.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00a pt	10/19/26 Initial release
+*
+* </pre>
+*
+* @note
+*	Signed and encrypted partitions are never recorded, an image containing
+*	one of them always goes through the full boot flow. The same applies
+*	when the RSA or EFUSE_SEC_EN eFuses are blown.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "fsbl.h"
+#include "image_mover.h"
+#include "resume.h"
+#include "xdevcfg_hw.h"
+#include <stddef.h>
+
+#ifdef FSBL_FAST_RESUME
+
+/************************** Constant Definitions *****************************/
+#define RESUME_SIGNATURE_SEED		0x811C9DC5
+#define RESUME_SIGNATURE_ROTATE		5
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+static u32 ResumeSignature(u32 Signature, const u32 *Buf, u32 WordCount);
+static u32 ResumeDescSignature(FsblResumeDesc *Desc);
+static u32 ResumeDescChecksum(FsblResumeDesc *Desc);
+static u32 ResumeIsSoftReset(void);
+
+/************************** Variable Definitions *****************************/
+extern u8 SignedPartitionFlag;
+extern u8 EncryptedPartitionFlag;
+extern u8 PSPartitionFlag;
+
+/*
+ * Cleared as soon as a partition which can not be resumed is loaded
+ */
+static u8 Resumable;
+
+/******************************************************************************/
+/**
+*
+* This function invalidates the fast resume descriptor, the next software
+* reset then goes through the full boot flow.
+*
+* @param	None
+*
+* @return	None
+*
+* @note		Called at the start of every partition walk
+*
+****************************************************************************/
+void FsblResumeInvalidate(void)
+{
+	FsblResumeDesc *Desc = (FsblResumeDesc *)FSBL_RESUME_DESC_ADDR;
+
+	Desc->Magic = 0;
+	Desc->PartitionCount = 0;
+	Resumable = 1;
+}
+
+/******************************************************************************/
+/**
+*
+* This function records a loaded partition in the fast resume descriptor
+*
+* @param	Header Partition header pointer
+*
+* @return	None
+*
+* @note		Uses the partition flags set by LoadBootImage for the
+*		current partition
+*
+****************************************************************************/
+void FsblResumeRecordPartition(PartHeader *Header)
+{
+	FsblResumeDesc *Desc = (FsblResumeDesc *)FSBL_RESUME_DESC_ADDR;
+
+	if (SignedPartitionFlag || EncryptedPartitionFlag) {
+		Resumable = 0;
+		return;
+	}
+
+	/*
+	 * The fabric keeps PL partitions, only PS partitions are checked
+	 */
+	if (!PSPartitionFlag) {
+		return;
+	}
+
+	if (Desc->PartitionCount >= MAX_PARTITION_NUMBER) {
+		Resumable = 0;
+		return;
+	}
+
+	memcpy_rom(&Desc->Header[Desc->PartitionCount], Header,
+			sizeof(PartHeader));
+	Desc->PartitionCount++;
+}
+
+/******************************************************************************/
+/**
+*
+* This function completes the fast resume descriptor just before handoff
+*
+* @param	ExecAddr Handoff address of the loaded image
+* @param	BitstreamLoaded is set if the image configured the PL
+*
+* @return	None
+*
+* @note		None
+*
+****************************************************************************/
+void FsblResumeCommit(u32 ExecAddr, u8 BitstreamLoaded)
+{
+	FsblResumeDesc *Desc = (FsblResumeDesc *)FSBL_RESUME_DESC_ADDR;
+
+	if ((Resumable == 0) || (Desc->PartitionCount == 0) || (ExecAddr == 0)) {
+		Desc->Magic = 0;
+		fsbl_printf(DEBUG_INFO, "Fast resume not possible for this image\r\n");
+		return;
+	}
+
+	Desc->Version = FSBL_RESUME_VERSION;
+	Desc->ExecAddr = ExecAddr;
+	Desc->Flags = 0;
+	if (BitstreamLoaded) {
+		Desc->Flags |= FSBL_RESUME_FLAG_BITSTREAM;
+	}
+	Desc->Signature = ResumeDescSignature(Desc);
+	Desc->Magic = FSBL_RESUME_MAGIC;
+	Desc->Checksum = ResumeDescChecksum(Desc);
+
+	fsbl_printf(DEBUG_INFO, "Fast resume descriptor at 0x%08x, "
+			"Signature 0x%08x\r\n", (u32)Desc, Desc->Signature);
+}
+
+/******************************************************************************/
+/**
+*
+* This function checks whether the previous image can be resumed without
+* touching the boot device
+*
+* @param	ExecAddr is filled with the handoff address
+* @param	BitstreamLoaded is set if the PL still holds the bitstream
+*
+* @return
+*		- XST_SUCCESS if the image can be resumed
+*		- XST_FAILURE if the full boot flow is required
+*
+* @note		Only the PS registers left valid by ps7_init are accessed,
+*		the devcfg driver is not initialized at this point
+*
+****************************************************************************/
+u32 FsblResumeCheck(u32 *ExecAddr, u8 *BitstreamLoaded)
+{
+	FsblResumeDesc *Desc = (FsblResumeDesc *)FSBL_RESUME_DESC_ADDR;
+	u32 Index;
+	u32 Start;
+	u32 End;
+
+	if (ResumeIsSoftReset() != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	/*
+	 * Secure boot always goes through authentication
+	 */
+	if ((Xil_In32(EFUSE_STATUS_REG) & EFUSE_STATUS_RSA_ENABLE_MASK) ||
+			(Xil_In32(XPS_DEV_CFG_APB_BASEADDR + XDCFG_STATUS_OFFSET) &
+				XDCFG_STATUS_EFUSE_SEC_EN_MASK)) {
+		return XST_FAILURE;
+	}
+
+	if ((Desc->Magic != FSBL_RESUME_MAGIC) ||
+			(Desc->Version != FSBL_RESUME_VERSION) ||
+			(Desc->PartitionCount == 0) ||
+			(Desc->PartitionCount > MAX_PARTITION_NUMBER)) {
+		fsbl_printf(DEBUG_INFO, "No fast resume descriptor\r\n");
+		return XST_FAILURE;
+	}
+
+	if (Desc->Checksum != ResumeDescChecksum(Desc)) {
+		fsbl_printf(DEBUG_GENERAL, "Fast resume descriptor corrupted\r\n");
+		return XST_FAILURE;
+	}
+
+	/*
+	 * Every partition must lie in DDR below the descriptor
+	 */
+	for (Index = 0; Index < Desc->PartitionCount; Index++) {
+		Start = Desc->Header[Index].LoadAddr;
+		End = Start + (Desc->Header[Index].ImageWordLen << WORD_LENGTH_SHIFT);
+		if ((Start < DDR_START_ADDR) || (End < Start) ||
+				(End > FSBL_RESUME_DESC_ADDR)) {
+			fsbl_printf(DEBUG_GENERAL, "Fast resume partition %lu out of "
+					"range\r\n", Index);
+			return XST_FAILURE;
+		}
+	}
+
+	if (Desc->Signature != ResumeDescSignature(Desc)) {
+		fsbl_printf(DEBUG_GENERAL, "Fast resume signature mismatch\r\n");
+		return XST_FAILURE;
+	}
+
+	/*
+	 * PL has to be still configured if the image relies on it
+	 */
+	if ((Desc->Flags & FSBL_RESUME_FLAG_BITSTREAM) &&
+			!(Xil_In32(XPS_DEV_CFG_APB_BASEADDR + XDCFG_INT_STS_OFFSET) &
+				XDCFG_IXR_PCFG_DONE_MASK)) {
+		fsbl_printf(DEBUG_GENERAL, "Fast resume: PL not configured\r\n");
+		return XST_FAILURE;
+	}
+
+	*ExecAddr = Desc->ExecAddr;
+	*BitstreamLoaded = (Desc->Flags & FSBL_RESUME_FLAG_BITSTREAM) ? 1 : 0;
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function checks that the last reset was a software reset issued after
+* the FSBL handed off
+*
+* @param	None
+*
+* @return
+*		- XST_SUCCESS for a software reset after a successful handoff
+*		- XST_FAILURE otherwise
+*
+* @note		None
+*
+****************************************************************************/
+static u32 ResumeIsSoftReset(void)
+{
+	u32 ResetReason;
+	u32 PsVersion;
+
+	/*
+	 * A pending FSBL run or fallback mark means the previous boot failed
+	 */
+	if (Xil_In32(REBOOT_STATUS_REG) & FSBL_FAIL_MASK) {
+		return XST_FAILURE;
+	}
+
+	PsVersion = (Xil_In32(XPS_DEV_CFG_APB_BASEADDR + XDCFG_MCTRL_OFFSET) &
+			XDCFG_MCTRL_PCAP_PS_VERSION_MASK) >>
+			XDCFG_MCTRL_PCAP_PS_VERSION_SHIFT;
+	if (PsVersion == SILICON_VERSION_1) {
+		ResetReason = Xil_In32(RESET_REASON_REG);
+	} else {
+		ResetReason = GetResetReason();
+	}
+
+	if (((ResetReason & RESET_REASON_SRST) != RESET_REASON_SRST) ||
+			(ResetReason & RESET_REASON_SWDT)) {
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function calculates the signature of the recorded headers and of the
+* first FSBL_RESUME_SAMPLE_BYTES of every recorded partition
+*
+* @param	Desc Fast resume descriptor pointer
+*
+* @return	Signature
+*
+* @note		None
+*
+****************************************************************************/
+static u32 ResumeDescSignature(FsblResumeDesc *Desc)
+{
+	u32 Signature = RESUME_SIGNATURE_SEED;
+	u32 Index;
+	u32 Bytes;
+	PartHeader *Header;
+
+	Signature = ResumeSignature(Signature, &Desc->ExecAddr, 1);
+	Signature = ResumeSignature(Signature, &Desc->Flags, 1);
+	Signature = ResumeSignature(Signature, (u32 *)&Desc->Header[0],
+			(Desc->PartitionCount * sizeof(PartHeader)) >> WORD_LENGTH_SHIFT);
+
+	for (Index = 0; Index < Desc->PartitionCount; Index++) {
+		Header = &Desc->Header[Index];
+		Bytes = Header->ImageWordLen << WORD_LENGTH_SHIFT;
+		if (Bytes > FSBL_RESUME_SAMPLE_BYTES) {
+			Bytes = FSBL_RESUME_SAMPLE_BYTES;
+		}
+		Signature = ResumeSignature(Signature, (u32 *)Header->LoadAddr,
+				Bytes >> WORD_LENGTH_SHIFT);
+	}
+
+	return Signature;
+}
+
+/******************************************************************************/
+/**
+*
+* This function calculates the descriptor checksum, same scheme as the
+* partition header checksum
+*
+* @param	Desc Fast resume descriptor pointer
+*
+* @return	Checksum
+*
+* @note		None
+*
+****************************************************************************/
+static u32 ResumeDescChecksum(FsblResumeDesc *Desc)
+{
+	u32 *Word = (u32 *)Desc;
+	u32 Checksum = 0;
+	u32 Count;
+
+	for (Count = 0; Count < (offsetof(FsblResumeDesc, Checksum) >>
+			WORD_LENGTH_SHIFT); Count++) {
+		Checksum += Word[Count];
+	}
+
+	return Checksum ^ 0xFFFFFFFF;
+}
+
+/******************************************************************************/
+/**
+*
+* This function folds a word buffer into a running signature. It only
+* guards against accidental corruption and is not a cryptographic hash.
+*
+* @param	Signature running signature
+* @param	Buf word buffer
+* @param	WordCount number of words in Buf
+*
+* @return	Updated signature
+*
+* @note		None
+*
+****************************************************************************/
+static u32 ResumeSignature(u32 Signature, const u32 *Buf, u32 WordCount)
+{
+	u32 Index;
+
+	for (Index = 0; Index < WordCount; Index++) {
+		Signature = ((Signature << RESUME_SIGNATURE_ROTATE) |
+				(Signature >> (32 - RESUME_SIGNATURE_ROTATE))) ^ Buf[Index];
+		Signature += Index;
+	}
+
+	return Signature;
+}
+
+#endif
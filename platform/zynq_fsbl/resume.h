@@ -0,0 +1,101 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file resume.h
+*
+* This file contains the interface for the FSBL fast resume boot path.
+*
+* On a normal boot the FSBL records every loaded PS partition in a small
+* descriptor kept at the top of DDR. On a later software reset (SRST) the
+* FSBL validates that descriptor with a cheap signature over the recorded
+* partition headers and the first bytes of every partition and, when it
+* matches, hands off to the recorded execution address without initializing
+* the boot device or copying any partition again.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00a pt	10/19/26 Initial release
+*
+* </pre>
+*
+* @note
+*
+* FSBL_FAST_RESUME must be defined to enable this feature.
+*
+* The application must keep the FSBL_RESUME_DESC_SIZE bytes at
+* FSBL_RESUME_DESC_ADDR out of its linker script. An application which
+* wants to force a full boot on its next software reset (for example after
+* a firmware update) calls FsblResumeInvalidate() or clears the first word
+* of the descriptor before resetting.
+*
+* Initialized data (.data) of a resumed application is not reloaded, so
+* only applications which re-initialize their own data are suitable for
+* fast resume.
+*
+******************************************************************************/
+#ifndef ___RESUME_H___
+#define ___RESUME_H___
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "fsbl.h"
+#include "image_mover.h"
+
+/************************** Constant Definitions *****************************/
+#define FSBL_RESUME_MAGIC		0x5253554D	/* "RSUM" */
+#define FSBL_RESUME_VERSION		0x1
+
+/*
+ * Number of bytes from the start of every partition covered by the
+ * signature, this catches the usual vector table/.text overwrite
+ */
+#define FSBL_RESUME_SAMPLE_BYTES	256
+
+#define FSBL_RESUME_DESC_SIZE		0x1000
+
+#ifndef FSBL_RESUME_DESC_ADDR
+#define FSBL_RESUME_DESC_ADDR		(DDR_END_ADDR + 1 - FSBL_RESUME_DESC_SIZE)
+#endif
+
+/* Descriptor flags */
+#define FSBL_RESUME_FLAG_BITSTREAM	0x1	/* PL was configured at boot */
+
+/**************************** Type Definitions *******************************/
+typedef struct {
+	u32 Magic;
+	u32 Version;
+	u32 ExecAddr;		/* Handoff address of the previous boot */
+	u32 Flags;
+	u32 PartitionCount;	/* Number of valid entries in Header */
+	PartHeader Header[MAX_PARTITION_NUMBER];
+	u32 Signature;		/* Signature of headers and partition samples */
+	u32 Checksum;		/* Checksum of all the preceding words */
+} FsblResumeDesc;
+
+/************************** Function Prototypes ******************************/
+#ifdef FSBL_FAST_RESUME
+void FsblResumeInvalidate(void);
+void FsblResumeRecordPartition(PartHeader *Header);
+void FsblResumeCommit(u32 ExecAddr, u8 BitstreamLoaded);
+u32 FsblResumeCheck(u32 *ExecAddr, u8 *BitstreamLoaded);
+#endif
+
+/************************** Variable Definitions *****************************/
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* ___RESUME_H___ */
@@ -18,6 +18,10 @@
 * 1.00a jz	04/28/11 Initial release
 * 7.00a kc  10/18/13 Integrated SD/MMC driver
 * 12.00a ssc 12/11/14 Fix for CR# 839182
+* 21.8   pt  10/19/26 InitSD mounts the volume once and can be called again to
+*                      open another file. f_open is timed under FSBL_PERF. The
+*                      cluster link map is used for seeks if xilffs is built
+*                      with XILFFS_FASTSEEK.
 *
 * </pre>
 *
@@ -42,6 +46,13 @@
 
 /************************** Constant Definitions *****************************/
 
+#if FF_USE_FASTSEEK
+/*
+ * Size of the cluster link map in DWORDs, (SD_CLMT_SIZE - 1) / 2 fragments
+ */
+#define SD_CLMT_SIZE	32U
+#endif
+
 /**************************** Type Definitions *******************************/
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -57,12 +68,19 @@ static FIL fil;		/* File object */
 static FATFS fatfs;
 static char buffer[32];
 static char *boot_file = buffer;
+static u32 SdMounted;
+#if FF_USE_FASTSEEK
+static DWORD ClusterMap[SD_CLMT_SIZE];
+#endif
 
 /******************************************************************************/
 /******************************************************************************/
 /**
 *
 * This function initializes the controller for the SD FLASH interface.
+* The volume is mounted on the first call. Later calls close the current file
+* and open the given one, the file system keeps the directory entries found
+* so far if xilffs is built with XILFFS_DIR_CACHE.
 *
 * @param	filename of the file that is to be used
 *
@@ -78,25 +96,60 @@ u32 InitSD(const char *filename)
 
 	FRESULT rc;
 	TCHAR *path = "0:/"; /* Logical drive number is 0 */
+#ifdef FSBL_PERF
+	XTime tOpenCur = 0;
+	XTime tOpenEnd = 0;
+#endif
 
-	/* Register volume work area, initialize device */
-	rc = f_mount(&fatfs, path, 0);
-	fsbl_printf(DEBUG_INFO,"SD: rc= %.8x\n\r", rc);
-
-	if (rc != FR_OK) {
-		return XST_FAILURE;
+	if (SdMounted == 0U) {
+		/* Register volume work area, initialize device */
+		rc = f_mount(&fatfs, path, 0);
+		fsbl_printf(DEBUG_INFO,"SD: rc= %.8x\n\r", rc);
+
+		if (rc != FR_OK) {
+			return XST_FAILURE;
+		}
+		SdMounted = 1U;
+	} else {
+		(void)f_close(&fil);
 	}
 
 	strcpy_rom(buffer, filename);
 	boot_file = (char *)buffer;
 	FlashReadBaseAddress = XPAR_PS7_SD_0_S_AXI_BASEADDR;
 
+#ifdef FSBL_PERF
+	/*
+	 * The first f_open mounts the volume as well
+	 */
+	FsblGetGlobalTime(&tOpenCur);
+#endif
+
 	rc = f_open(&fil, boot_file, FA_READ);
 	if (rc) {
 		fsbl_printf(DEBUG_GENERAL,"SD: Unable to open file %s: %d\n", boot_file, rc);
 		return XST_FAILURE;
 	}
 
+#ifdef FSBL_PERF
+	fsbl_printf(DEBUG_GENERAL,"SD: f_open %s took ", boot_file);
+	FsblMeasurePerfTime(tOpenCur, tOpenEnd);
+#endif
+
+#if FF_USE_FASTSEEK
+	/*
+	 * Map the cluster chain once so that SDAccess seeks without
+	 * following the FAT
+	 */
+	ClusterMap[0] = SD_CLMT_SIZE;
+	fil.cltbl = ClusterMap;
+	rc = f_lseek(&fil, CREATE_LINKMAP);
+	if (rc != FR_OK) {
+		fsbl_printf(DEBUG_INFO,"SD: No link map for %s: %d\n", boot_file, rc);
+		fil.cltbl = NULL;
+	}
+#endif
+
 	return XST_SUCCESS;
 
 }
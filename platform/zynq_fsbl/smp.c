@@ -0,0 +1,480 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file smp.c
+*
+* Contains the dual core FSBL boot mode: the CPU0 side of the partition
+* check queue and the CPU1 worker loop. Refer to smp.h for an overview.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00a pt	10/19/26 Initial release
+*       pt	10/19/26 Use the BSP sev() and wfe() macros
+*
+* </pre>
+*
+* @note
+*	CPU1 keeps a write back L1 data cache. Code run by CPU1 therefore
+*	must not write FSBL globals in the low OCM, a dirty line evicted by
+*	CPU1 would overwrite the updates CPU0 made to the rest of that line.
+*	md5(), sha_256() and AuthenticatePartition() only write their stack
+*	and CPU1 only writes the queue in the strongly ordered shared page.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "fsbl.h"
+#include "smp.h"
+#include "md5.h"
+#include "xil_cache.h"
+#include "xil_cache_l.h"
+#include "xil_mmu.h"
+#include "xil_spinlock.h"
+
+#ifdef RSA_SUPPORT
+#include "rsa.h"
+#include "xilrsa.h"
+#endif
+
+#ifdef FSBL_SMP
+
+/************************** Constant Definitions *****************************/
+#define EFUSE_STATUS_CPU1_DISABLE_MASK	0x80	/* Single core device */
+
+#define A9_CPU_RST_CTRL_REG		(XPS_SYS_CTRL_BASEADDR + 0x244)
+#define A9_CPU_RST_CTRL_CPU1_MASK	0x22	/* A9_CLKSTOP1 | A9_RST1 */
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+static u32 SmpQueue(u32 Type, u32 Addr, u32 Length, u8 *Checksum,
+		u32 Partition);
+static u32 SmpRunJob(FsblSmpJob *Job);
+static void SmpHoldCpu1(void);
+
+/************************** Variable Definitions *****************************/
+/*
+ * Placed on its own page in the low OCM (ps7_ram_0) by the linker script,
+ * the page is remapped strongly ordered by FsblSmpStart
+ */
+static FsblSmpShared SmpShared
+	__attribute__ ((section (".fsbl_smp"), aligned (FSBL_SMP_SHARED_SIZE)));
+
+static u8 SmpActive;
+
+/******************************************************************************/
+/**
+*
+* This function wakes CPU1 from the Boot ROM wait loop and starts the
+* partition check queue
+*
+* @param	None
+*
+* @return
+*		- XST_SUCCESS if CPU1 is running the queue
+*		- XST_FAILURE on a single core device or if CPU1 did not start,
+*		  the caller then checks the partitions on CPU0
+*
+* @note		Must be called after the MMU table is final, CPU1 keeps
+*		the translations it reads while the queue runs
+*
+****************************************************************************/
+u32 FsblSmpStart(void)
+{
+	FsblSmpShared *Shared = &SmpShared;
+	u32 Timeout;
+
+	if (SmpActive != 0) {
+		return XST_SUCCESS;
+	}
+
+	if ((Xil_In32(EFUSE_STATUS_REG) & EFUSE_STATUS_CPU1_DISABLE_MASK) != 0) {
+		fsbl_printf(DEBUG_INFO, "Single core device, SMP boot disabled\r\n");
+		return XST_FAILURE;
+	}
+
+	if (Xil_SetPageAttributes((UINTPTR)Shared, FSBL_SMP_SHARED_SIZE,
+			STRONG_ORDERED) != XST_SUCCESS) {
+		fsbl_printf(DEBUG_GENERAL, "SMP shared page mapping failed\r\n");
+		return XST_FAILURE;
+	}
+
+	Shared->State = FSBL_SMP_STATE_OFF;
+	Shared->Command = FSBL_SMP_CMD_RUN;
+	Shared->Head = 0;
+	Shared->Tail = 0;
+	Shared->Completed = 0;
+	Shared->Error = 0;
+	Shared->ErrorPartition = 0;
+
+	if (Xil_IsSpinLockEnabled() == 0) {
+		Shared->LockFlag = 0;
+		if (Xil_InitializeSpinLock((UINTPTR)&Shared->Lock,
+				(UINTPTR)&Shared->LockFlag,
+				XIL_SPINLOCK_ENABLE) != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+	}
+
+	/*
+	 * Boot ROM protocol: CPU1 jumps to the address at 0xFFFFFFF0 on SEV
+	 */
+	Xil_Out32(FSBL_SMP_CPU1_START_ADDR, (u32)FsblSmpEntry);
+	dsb();
+	sev();
+
+	for (Timeout = 0; Timeout < FSBL_SMP_TIMEOUT; Timeout++) {
+		if (Shared->State == FSBL_SMP_STATE_RUNNING) {
+			break;
+		}
+	}
+	if (Shared->State != FSBL_SMP_STATE_RUNNING) {
+		fsbl_printf(DEBUG_GENERAL, "CPU1 did not start\r\n");
+		SmpHoldCpu1();
+		return XST_FAILURE;
+	}
+
+	fsbl_printf(DEBUG_INFO, "CPU1 started for partition checks\r\n");
+	SmpActive = 1;
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function tells whether partition checks go to CPU1
+*
+* @param	None
+*
+* @return	1 if the queue is running, 0 otherwise
+*
+* @note		None
+*
+****************************************************************************/
+u32 FsblSmpActive(void)
+{
+	return SmpActive;
+}
+
+/******************************************************************************/
+/**
+*
+* This function queues an MD5 checksum check of a partition in DDR
+*
+* @param	Addr Start of the partition data
+* @param	Length Partition length in bytes
+* @param	Checksum Expected checksum, read from the boot device
+* @param	Partition Partition number
+*
+* @return
+*		- XST_SUCCESS if the check was queued
+*		- PARTITION_CHECKSUM_FAIL or AUTHENTICATION_FAIL if an earlier
+*		  check already failed
+*
+* @note		Blocks while the queue is full
+*
+****************************************************************************/
+u32 FsblSmpQueueChecksum(u32 Addr, u32 Length, u8 *Checksum, u32 Partition)
+{
+	return SmpQueue(FSBL_SMP_JOB_CHECKSUM, Addr, Length, Checksum,
+			Partition);
+}
+
+/******************************************************************************/
+/**
+*
+* This function queues the SHA-256 hash and RSA authentication of a signed
+* partition in DDR
+*
+* @param	Addr Start of the partition data
+* @param	Length Partition length in bytes, including the
+*		authentication certificate
+* @param	Partition Partition number
+*
+* @return
+*		- XST_SUCCESS if the check was queued
+*		- PARTITION_CHECKSUM_FAIL or AUTHENTICATION_FAIL if an earlier
+*		  check already failed
+*
+* @note		Blocks while the queue is full
+*
+****************************************************************************/
+u32 FsblSmpQueueAuth(u32 Addr, u32 Length, u32 Partition)
+{
+	return SmpQueue(FSBL_SMP_JOB_AUTH, Addr, Length, NULL, Partition);
+}
+
+/******************************************************************************/
+/**
+*
+* This function waits until CPU1 has finished every queued check
+*
+* @param	None
+*
+* @return
+*		- XST_SUCCESS if all the checks passed
+*		- PARTITION_CHECKSUM_FAIL or AUTHENTICATION_FAIL for the first
+*		  failed check
+*
+* @note		Returns XST_SUCCESS right away if the queue is not running
+*
+****************************************************************************/
+u32 FsblSmpWaitAll(void)
+{
+	FsblSmpShared *Shared = &SmpShared;
+
+	if (SmpActive == 0) {
+		return XST_SUCCESS;
+	}
+
+	while (Shared->Completed != Shared->Head) {
+		wfe();
+	}
+
+	if (Shared->Error != 0) {
+		fsbl_printf(DEBUG_GENERAL, "Partition %lu check failed on CPU1\r\n",
+				Shared->ErrorPartition);
+		return Shared->Error;
+	}
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function parks CPU1 in the WFE loop at FSBL_SMP_PARK_ADDR. Queued
+* checks are completed first.
+*
+* @param	None
+*
+* @return	None
+*
+* @note		If CPU1 does not park in time it is held in reset
+*
+****************************************************************************/
+void FsblSmpPark(void)
+{
+	FsblSmpShared *Shared = &SmpShared;
+	u32 Timeout;
+
+	if (SmpActive == 0) {
+		return;
+	}
+
+	Xil_SpinLock();
+	Shared->Command = FSBL_SMP_CMD_PARK;
+	Xil_SpinUnlock();
+	sev();
+
+	for (Timeout = 0; Timeout < FSBL_SMP_TIMEOUT; Timeout++) {
+		if (Shared->State == FSBL_SMP_STATE_PARKED) {
+			break;
+		}
+	}
+	if (Shared->State != FSBL_SMP_STATE_PARKED) {
+		fsbl_printf(DEBUG_GENERAL, "CPU1 did not park\r\n");
+		SmpHoldCpu1();
+	}
+
+	SmpActive = 0;
+}
+
+/******************************************************************************/
+/**
+*
+* This function adds a job to the queue and wakes CPU1
+*
+* @param	Type FSBL_SMP_JOB_CHECKSUM or FSBL_SMP_JOB_AUTH
+* @param	Addr Start of the partition data
+* @param	Length Partition length in bytes
+* @param	Checksum Expected MD5 checksum, NULL for other jobs
+* @param	Partition Partition number
+*
+* @return	XST_SUCCESS or the error code of an earlier failed job
+*
+* @note		None
+*
+****************************************************************************/
+static u32 SmpQueue(u32 Type, u32 Addr, u32 Length, u8 *Checksum,
+		u32 Partition)
+{
+	FsblSmpShared *Shared = &SmpShared;
+	FsblSmpJob *Job;
+	u32 Index;
+
+	/*
+	 * A slot is free once CPU1 has taken the job out of it
+	 */
+	while ((Shared->Head - Shared->Tail) >= FSBL_SMP_MAX_JOBS) {
+		wfe();
+	}
+
+	if (Shared->Error != 0) {
+		return Shared->Error;
+	}
+
+	Xil_SpinLock();
+	Job = &Shared->Job[Shared->Head % FSBL_SMP_MAX_JOBS];
+	Job->Type = Type;
+	Job->Addr = Addr;
+	Job->Length = Length;
+	Job->Partition = Partition;
+	if (Checksum != NULL) {
+		for (Index = 0; Index < FSBL_SMP_CHECKSUM_SIZE; Index++) {
+			Job->Checksum[Index] = Checksum[Index];
+		}
+	}
+	Shared->Head++;
+	Xil_SpinUnlock();
+	sev();
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function holds CPU1 in reset with its clock stopped
+*
+* @param	None
+*
+* @return	None
+*
+* @note		SLCR must be unlocked
+*
+****************************************************************************/
+static void SmpHoldCpu1(void)
+{
+	Xil_Out32(A9_CPU_RST_CTRL_REG, Xil_In32(A9_CPU_RST_CTRL_REG) |
+			A9_CPU_RST_CTRL_CPU1_MASK);
+}
+
+/******************************************************************************/
+/**
+*
+* CPU1 worker loop, entered from FsblSmpEntry with the MMU and the
+* instruction cache enabled
+*
+* @param	None
+*
+* @return	Does not return, CPU1 ends in the park loop
+*
+* @note		None
+*
+****************************************************************************/
+void FsblSmpCpu1Main(void)
+{
+	FsblSmpShared *Shared = &SmpShared;
+	FsblSmpJob Job;
+	u32 Status;
+	u32 Taken;
+
+	Xil_L1DCacheEnable();
+
+	Shared->State = FSBL_SMP_STATE_RUNNING;
+	sev();
+
+	for (;;) {
+		Taken = 0;
+		Xil_SpinLock();
+		if (Shared->Tail != Shared->Head) {
+			Job = Shared->Job[Shared->Tail % FSBL_SMP_MAX_JOBS];
+			Shared->Tail++;
+			Taken = 1;
+		} else if (Shared->Command == FSBL_SMP_CMD_PARK) {
+			Xil_SpinUnlock();
+			break;
+		}
+		Xil_SpinUnlock();
+
+		if (Taken == 0) {
+			wfe();
+			continue;
+		}
+
+		/*
+		 * Skip the remaining jobs once one has failed, FSBL falls back
+		 */
+		if (Shared->Error == 0) {
+			Status = SmpRunJob(&Job);
+		} else {
+			Status = XST_FAILURE;
+		}
+
+		Xil_SpinLock();
+		if ((Status != XST_SUCCESS) && (Shared->Error == 0)) {
+			Shared->Error = (Job.Type == FSBL_SMP_JOB_AUTH) ?
+					AUTHENTICATION_FAIL : PARTITION_CHECKSUM_FAIL;
+			Shared->ErrorPartition = Job.Partition;
+		}
+		Shared->Completed++;
+		Xil_SpinUnlock();
+		sev();
+	}
+
+	Xil_L1DCacheDisable();
+	FsblSmpCpu1Exit(FSBL_SMP_PARK_ADDR, &Shared->State);
+}
+
+/******************************************************************************/
+/**
+*
+* This function runs one partition check on CPU1
+*
+* @param	Job Copy of the queued job
+*
+* @return	XST_SUCCESS if the partition data is valid, XST_FAILURE otherwise
+*
+* @note		None
+*
+****************************************************************************/
+static u32 SmpRunJob(FsblSmpJob *Job)
+{
+	u8 Digest[FSBL_SMP_CHECKSUM_SIZE];
+#ifdef RSA_SUPPORT
+	u8 Hash[SHA_VALBYTES];
+	u8 *Ac;
+#endif
+	u32 Index;
+
+	/*
+	 * The partition was written by CPU0 or the boot device DMA with
+	 * caches bypassed, drop whatever CPU1 has cached from earlier jobs
+	 */
+	Xil_L1DCacheFlush();
+
+	if (Job->Type == FSBL_SMP_JOB_CHECKSUM) {
+		md5((u8 *)Job->Addr, Job->Length, Digest, 0);
+		for (Index = 0; Index < FSBL_SMP_CHECKSUM_SIZE; Index++) {
+			if (Digest[Index] != Job->Checksum[Index]) {
+				return XST_FAILURE;
+			}
+		}
+		return XST_SUCCESS;
+	}
+
+#ifdef RSA_SUPPORT
+	if (Job->Type == FSBL_SMP_JOB_AUTH) {
+		sha_256((u8 *)Job->Addr,
+				(Job->Length - RSA_PARTITION_SIGNATURE_SIZE), Hash);
+		Ac = (u8 *)(Job->Addr + Job->Length - RSA_SIGNATURE_SIZE);
+		return AuthenticatePartition(Ac, Hash);
+	}
+#endif
+
+	return XST_FAILURE;
+}
+
+#endif /* FSBL_SMP */
@@ -0,0 +1,140 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file smp.h
+*
+* This file contains the interface for the dual core FSBL boot mode.
+*
+* On a dual core device CPU1 is woken from the Boot ROM wait loop right
+* before the partition walk. It runs a small work queue of partition
+* checks (MD5 checksum, SHA-256 hash and RSA authentication) while CPU0
+* keeps copying the next partitions from the boot device. CPU0 only waits
+* for the outstanding checks when it is about to consume verified data
+* (decryption, bitstream download) and before handoff.
+*
+* The queue lives in a 4 KB page of the low OCM (ps7_ram_0) which is mapped
+* strongly ordered, both CPUs take the BSP spinlock (xil_spinlock.c) kept in
+* the same page around every queue update.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00a pt	10/19/26 Initial release
+*
+* </pre>
+*
+* @note
+*
+* FSBL_SMP must be defined to enable this feature.
+*
+* CPU1 runs with its own L1 data cache enabled and the L2 cache disabled,
+* it cleans and invalidates its L1 data cache before every job so it always
+* reads the partition data written by CPU0 or the boot device DMA.
+*
+* Before handoff CPU1 is parked in a WFE loop at FSBL_SMP_PARK_ADDR, in the
+* range the Boot ROM reserves for the CPU1 wait loop. The loop follows the
+* Boot ROM protocol: the application writes the CPU1 start address to
+* 0xFFFFFFF0 and executes SEV.
+*
+* fsbl_printf output of CPU1 (DEBUG_INFO level of the RSA code) can be
+* interleaved with the output of CPU0.
+*
+******************************************************************************/
+#ifndef ___SMP_H___
+#define ___SMP_H___
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "fsbl.h"
+
+/************************** Constant Definitions *****************************/
+/*
+ * CPU1 jumps to the address written here when woken by SEV
+ */
+#define FSBL_SMP_CPU1_START_ADDR	0xFFFFFFF0
+
+#ifndef FSBL_SMP_PARK_ADDR
+#define FSBL_SMP_PARK_ADDR		0xFFFFFE00
+#endif
+
+#define FSBL_SMP_MAX_JOBS		8
+
+/*
+ * Poll loops to wait for CPU1 to come up or to park
+ */
+#define FSBL_SMP_TIMEOUT		0x1000000
+
+#define FSBL_SMP_SHARED_SIZE		0x1000
+
+/* CPU1 states */
+#define FSBL_SMP_STATE_OFF		0x0
+#define FSBL_SMP_STATE_RUNNING		0x534D5052	/* "SMPR" */
+#define FSBL_SMP_STATE_PARKED		0x534D5050	/* "SMPP" */
+
+/* Commands from CPU0 */
+#define FSBL_SMP_CMD_RUN		0x0
+#define FSBL_SMP_CMD_PARK		0x1
+
+/* Job types */
+#define FSBL_SMP_JOB_CHECKSUM		0x1	/* MD5 over the partition */
+#define FSBL_SMP_JOB_AUTH		0x2	/* SHA-256 and RSA signature */
+
+#define FSBL_SMP_CHECKSUM_SIZE		16
+
+/**************************** Type Definitions *******************************/
+typedef struct {
+	u32 Type;
+	u32 Addr;		/* Partition data in DDR */
+	u32 Length;		/* Partition length in bytes */
+	u32 Partition;		/* Partition number, for the error report */
+	u8 Checksum[FSBL_SMP_CHECKSUM_SIZE];	/* Expected MD5 checksum */
+} FsblSmpJob;
+
+/*
+ * Shared between both CPUs, kept in a strongly ordered page
+ */
+typedef struct {
+	volatile u32 Lock;		/* xil_spinlock lock word */
+	volatile u32 LockFlag;		/* xil_spinlock enable flag */
+	volatile u32 State;		/* Written by CPU1 */
+	volatile u32 Command;		/* Written by CPU0 */
+	volatile u32 Head;		/* Next job to queue, written by CPU0 */
+	volatile u32 Tail;		/* Next job to run, written by CPU1 */
+	volatile u32 Completed;		/* Jobs finished, written by CPU1 */
+	volatile u32 Error;		/* FSBL error code of the first failure */
+	volatile u32 ErrorPartition;	/* Partition of the first failure */
+	FsblSmpJob Job[FSBL_SMP_MAX_JOBS];
+} FsblSmpShared;
+
+/************************** Function Prototypes ******************************/
+#ifdef FSBL_SMP
+u32 FsblSmpStart(void);
+u32 FsblSmpActive(void);
+u32 FsblSmpQueueChecksum(u32 Addr, u32 Length, u8 *Checksum, u32 Partition);
+u32 FsblSmpQueueAuth(u32 Addr, u32 Length, u32 Partition);
+u32 FsblSmpWaitAll(void);
+void FsblSmpPark(void);
+
+void FsblSmpCpu1Main(void);
+void FsblSmpEntry(void);
+void FsblSmpCpu1Exit(u32 ParkAddr, volatile u32 *State);
+#endif
+
+/************************** Variable Definitions *****************************/
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* ___SMP_H___ */
@@ -0,0 +1,220 @@
+#!/usr/bin/env python3
+###############################################################################
+# Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+# SPDX-License-Identifier: MIT
+###############################################################################
+#
+# Compresses partitions of a boot image for an FSBL built with FSBL_LZ4,
+# see lz4.h.
+#
+# Usage:
+#   fsbl_lz4_pack.py BOOT.BIN OUT.BIN [--partition N ...] [--block-size 64|256]
+#                    [--level N] [--block-checksum] [--no-content-checksum]
+#
+# Without --partition every PS and PL partition the FSBL loads is
+# compressed, partition 0 (the FSBL itself) never is. A partition is left
+# as it is if it does not get smaller.
+#
+# Each compressed partition is written at its old start offset, the space
+# it no longer needs is filled with 0xFF. The partition header gets the
+# compressed length and ATTRIBUTE_COMPRESSED_MASK, its checksum is updated
+# and so is the MD5 checksum of the partition if it has one. Encrypted and
+# RSA signed partitions are refused, the FSBL does not load encrypted
+# compressed partitions and a signature can not be updated here.
+#
+# Requires the lz4 command line tool (https://github.com/lz4/lz4).
+#
+###############################################################################
+
+import argparse
+import hashlib
+import os
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+
+IMAGE_PHDR_OFFSET = 0x09C
+PARTITION_HDR_SIZE = 64
+PARTITION_HDR_WORDS = 16
+MAX_PARTITION_NUMBER = 0xE
+
+# Word indices in the partition header, see PartHeader in image_mover.h
+HDR_IMAGE_WORD_LEN = 0
+HDR_DATA_WORD_LEN = 1
+HDR_PARTITION_WORD_LEN = 2
+HDR_LOAD_ADDR = 3
+HDR_PARTITION_START = 5
+HDR_ATTR = 6
+HDR_CHECKSUM_OFFSET = 8
+HDR_CHECKSUM = 15
+
+ATTRIBUTE_PS_IMAGE_MASK = 0x10
+ATTRIBUTE_PL_IMAGE_MASK = 0x20
+ATTRIBUTE_CHECKSUM_TYPE_MASK = 0x7000
+ATTRIBUTE_CHECKSUM_TYPE_MD5 = 0x1000
+ATTRIBUTE_RSA_PRESENT_MASK = 0x8000
+ATTRIBUTE_PARTITION_OWNER_MASK = 0x30000
+ATTRIBUTE_PARTITION_OWNER_FSBL = 0x00000
+ATTRIBUTE_COMPRESSED_MASK = 0x01000000
+
+MD5_CHECKSUM_SIZE = 16
+
+
+class PackError(Exception):
+    pass
+
+
+def header_checksum(words):
+    return (~sum(words[:HDR_CHECKSUM])) & 0xFFFFFFFF
+
+
+def is_last_partition(words):
+    return (words[HDR_CHECKSUM] == 0xFFFFFFFF and
+            not any(words[:HDR_CHECKSUM]))
+
+
+def read_headers(image):
+    table = struct.unpack_from("<I", image, IMAGE_PHDR_OFFSET)[0]
+    headers = []
+    for num in range(MAX_PARTITION_NUMBER):
+        offset = table + num * PARTITION_HDR_SIZE
+        if offset + PARTITION_HDR_SIZE > len(image):
+            raise PackError("partition header %d beyond the image" % num)
+        words = list(struct.unpack_from("<%dI" % PARTITION_HDR_WORDS,
+                                        image, offset))
+        if is_last_partition(words):
+            return headers
+        if header_checksum(words) != words[HDR_CHECKSUM]:
+            raise PackError("partition header %d checksum mismatch" % num)
+        headers.append((offset, words))
+    raise PackError("no last partition header")
+
+
+def default_partition(num, words):
+    attr = words[HDR_ATTR]
+    if num == 0:
+        return False
+    if (attr & ATTRIBUTE_PARTITION_OWNER_MASK) != \
+            ATTRIBUTE_PARTITION_OWNER_FSBL:
+        return False
+    if attr & ATTRIBUTE_PL_IMAGE_MASK:
+        return True
+    # The FSBL stops at a PS partition without load address
+    return bool(attr & ATTRIBUTE_PS_IMAGE_MASK) and words[HDR_LOAD_ADDR] != 0
+
+
+def lz4_compress(lz4, data, args):
+    with tempfile.TemporaryDirectory() as tmp:
+        src = os.path.join(tmp, "in")
+        dst = os.path.join(tmp, "out")
+        with open(src, "wb") as f:
+            f.write(data)
+        cmd = [lz4, "-q", "-f", "-%d" % args.level,
+               "-B4" if args.block_size == 64 else "-B5",
+               "--content-size"]
+        if args.block_checksum:
+            cmd.append("-BX")
+        if not args.content_checksum:
+            cmd.append("--no-frame-crc")
+        subprocess.run(cmd + [src, dst], check=True)
+        with open(dst, "rb") as f:
+            return f.read()
+
+
+def pack_partition(image, num, offset, words, lz4, args):
+    attr = words[HDR_ATTR]
+    length = words[HDR_PARTITION_WORD_LEN] * 4
+    start = words[HDR_PARTITION_START] * 4
+
+    if attr & ATTRIBUTE_COMPRESSED_MASK:
+        raise PackError("partition %d is already compressed" % num)
+    if (words[HDR_IMAGE_WORD_LEN] != words[HDR_DATA_WORD_LEN] or
+            words[HDR_DATA_WORD_LEN] != words[HDR_PARTITION_WORD_LEN]):
+        raise PackError("partition %d is encrypted" % num)
+    if attr & ATTRIBUTE_RSA_PRESENT_MASK:
+        raise PackError("partition %d is RSA signed" % num)
+    checksum_type = attr & ATTRIBUTE_CHECKSUM_TYPE_MASK
+    if checksum_type not in (0, ATTRIBUTE_CHECKSUM_TYPE_MD5):
+        raise PackError("partition %d has an unknown checksum type" % num)
+    if start + length > len(image):
+        raise PackError("partition %d beyond the image" % num)
+
+    frame = lz4_compress(lz4, bytes(image[start:start + length]), args)
+    stored = frame + b"\0" * (-len(frame) % 4)
+    if len(stored) >= length:
+        sys.stderr.write("partition %d: %d bytes, not compressible\n" %
+                         (num, length))
+        return
+
+    image[start:start + length] = stored + b"\xff" * (length - len(stored))
+
+    words[HDR_IMAGE_WORD_LEN] = len(stored) // 4
+    words[HDR_DATA_WORD_LEN] = len(stored) // 4
+    words[HDR_PARTITION_WORD_LEN] = len(stored) // 4
+    words[HDR_ATTR] = attr | ATTRIBUTE_COMPRESSED_MASK
+    words[HDR_CHECKSUM] = header_checksum(words)
+    struct.pack_into("<%dI" % PARTITION_HDR_WORDS, image, offset, *words)
+
+    # ValidateParition hashes the stored partition
+    if checksum_type == ATTRIBUTE_CHECKSUM_TYPE_MD5:
+        md5_offset = words[HDR_CHECKSUM_OFFSET] * 4
+        image[md5_offset:md5_offset + MD5_CHECKSUM_SIZE] = \
+            hashlib.md5(stored).digest()
+
+    sys.stderr.write("partition %d: %d to %d bytes\n" %
+                     (num, length, len(stored)))
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(
+        description="Compress boot image partitions for FSBL_LZ4")
+    parser.add_argument("input")
+    parser.add_argument("output")
+    parser.add_argument("--partition", type=int, action="append",
+                        help="partition number to compress, may be repeated")
+    parser.add_argument("--block-size", type=int, choices=(64, 256),
+                        default=64, help="LZ4 block size in KB (default 64)")
+    parser.add_argument("--level", type=int, default=9,
+                        help="lz4 compression level (default 9)")
+    parser.add_argument("--block-checksum", action="store_true",
+                        help="add a checksum to every block")
+    parser.add_argument("--no-content-checksum", dest="content_checksum",
+                        action="store_false",
+                        help="omit the checksum of the decompressed image")
+    parser.add_argument("--lz4", default="lz4",
+                        help="lz4 command (default lz4)")
+    args = parser.parse_args(argv)
+
+    lz4 = shutil.which(args.lz4)
+    if lz4 is None:
+        parser.error("%s not found" % args.lz4)
+
+    with open(args.input, "rb") as f:
+        image = bytearray(f.read())
+
+    try:
+        headers = read_headers(image)
+        for num in args.partition or []:
+            if num >= len(headers):
+                raise PackError("no partition %d" % num)
+        for num, (offset, words) in enumerate(headers):
+            if args.partition is not None:
+                if num not in args.partition:
+                    continue
+            elif not default_partition(num, words):
+                continue
+            pack_partition(image, num, offset, words, lz4, args)
+    except PackError as e:
+        sys.stderr.write("error: %s\n" % e)
+        return 1
+
+    with open(args.output, "wb") as f:
+        f.write(image)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+###############################################################################
+# Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+# SPDX-License-Identifier: MIT
+###############################################################################
+#
+# Host side of the FSBL USB update mode (FSBL_USB_UPDATE, see usb.h).
+#
+# Usage:
+#   fsbl_usb_update.py download BOOT.BIN [--boot]
+#   fsbl_usb_update.py program BOOT.BIN [--offset N] [--reset]
+#   fsbl_usb_update.py boot
+#   fsbl_usb_update.py reset
+#
+# Requires pyusb (python3 -m pip install pyusb) and access to the device,
+# on Linux a udev rule for the vendor and product ID below.
+#
+###############################################################################
+
+import argparse
+import struct
+import sys
+import time
+
+FSBL_USB_VENDOR_ID = 0x03FD
+FSBL_USB_PRODUCT_ID = 0x0500
+
+FSBL_USB_CMD_MAGIC = 0x44505546
+FSBL_USB_RSP_MAGIC = 0x53505546
+
+FSBL_USB_CMD_DOWNLOAD = 0x1
+FSBL_USB_CMD_PROGRAM = 0x2
+FSBL_USB_CMD_BOOT = 0x3
+FSBL_USB_CMD_RESET = 0x4
+
+EP_OUT = 0x01
+EP_IN = 0x81
+
+# Writes are a multiple of the 512 byte bulk packet size, only the last
+# packet of the image may be short
+CHUNK_SIZE = 1024 * 1024
+
+# Error codes of fsbl.h the update mode answers with
+FSBL_ERRORS = {
+    0xA00D: "INVALID_HEADER_FAIL",
+    0xA00E: "GET_HEADER_INFO_FAIL",
+    0xA010: "PARTITION_CHECKSUM_FAIL",
+    0xA013: "PARTITION_LOAD_FAIL",
+    0xA015: "USB_CMD_FAIL",
+    0xA016: "QSPI_PROGRAM_FAIL",
+}
+
+COMMAND_NAMES = {
+    FSBL_USB_CMD_DOWNLOAD: "download",
+    FSBL_USB_CMD_PROGRAM: "program",
+    FSBL_USB_CMD_BOOT: "boot",
+    FSBL_USB_CMD_RESET: "reset",
+}
+
+
+class UpdateError(Exception):
+    pass
+
+
+def pack_cmd(command, length=0, flash_offset=0):
+    return struct.pack("<4I", FSBL_USB_CMD_MAGIC, command, length,
+                       flash_offset)
+
+
+def unpack_rsp(data, command):
+    if len(data) != 16:
+        raise UpdateError("short response (%d bytes)" % len(data))
+    magic, rsp_command, status, length = struct.unpack("<4I", bytes(data))
+    if magic != FSBL_USB_RSP_MAGIC or rsp_command != command:
+        raise UpdateError("unexpected response %08x %x" %
+                          (magic, rsp_command))
+    return status, length
+
+
+def open_device():
+    import usb.core
+
+    dev = usb.core.find(idVendor=FSBL_USB_VENDOR_ID,
+                        idProduct=FSBL_USB_PRODUCT_ID)
+    if dev is None:
+        raise UpdateError("no FSBL in USB update mode found (%04x:%04x)" %
+                          (FSBL_USB_VENDOR_ID, FSBL_USB_PRODUCT_ID))
+    dev.set_configuration()
+    return dev
+
+
+def run_command(dev, command, image=None, flash_offset=0, timeout_ms=5000):
+    length = len(image) if image is not None else 0
+
+    dev.write(EP_OUT, pack_cmd(command, length, flash_offset), timeout_ms)
+
+    if image is not None:
+        start = time.monotonic()
+        view = memoryview(image)
+        for offset in range(0, length, CHUNK_SIZE):
+            dev.write(EP_OUT, view[offset:offset + CHUNK_SIZE], timeout_ms)
+            sys.stderr.write("\r%s: %d/%d bytes" %
+                             (COMMAND_NAMES[command],
+                              min(offset + CHUNK_SIZE, length), length))
+        elapsed = time.monotonic() - start
+        sys.stderr.write(", %.1f MB/s\n" %
+                         (length / (1024 * 1024) / max(elapsed, 1e-6)))
+
+    # Validation, and for PROGRAM the remaining flash sectors, follow the
+    # last data packet
+    status, received = unpack_rsp(dev.read(EP_IN, 16, 600000), command)
+    if status != 0:
+        raise UpdateError("%s failed: 0x%04x %s (%d bytes received)" %
+                          (COMMAND_NAMES[command], status,
+                           FSBL_ERRORS.get(status, ""), received))
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(
+        description="Send a boot image to an FSBL in USB update mode")
+    sub = parser.add_subparsers(dest="action", required=True)
+
+    p = sub.add_parser("download", help="load and validate an image in DDR")
+    p.add_argument("image")
+    p.add_argument("--boot", action="store_true",
+                   help="boot the image once it validated")
+
+    p = sub.add_parser("program", help="program an image to QSPI")
+    p.add_argument("image")
+    p.add_argument("--offset", type=lambda s: int(s, 0), default=0,
+                   help="QSPI offset, sector aligned (default 0)")
+    p.add_argument("--reset", action="store_true",
+                   help="reset the board once the image is programmed")
+
+    sub.add_parser("boot", help="boot the last validated image")
+    sub.add_parser("reset", help="reset the board")
+
+    args = parser.parse_args(argv)
+
+    image = None
+    if args.action in ("download", "program"):
+        with open(args.image, "rb") as f:
+            image = f.read()
+        if not image:
+            parser.error("%s is empty" % args.image)
+
+    try:
+        dev = open_device()
+        if args.action == "download":
+            run_command(dev, FSBL_USB_CMD_DOWNLOAD, image)
+            if args.boot:
+                run_command(dev, FSBL_USB_CMD_BOOT)
+        elif args.action == "program":
+            run_command(dev, FSBL_USB_CMD_PROGRAM, image, args.offset)
+            if args.reset:
+                run_command(dev, FSBL_USB_CMD_RESET)
+        elif args.action == "boot":
+            run_command(dev, FSBL_USB_CMD_BOOT)
+        else:
+            run_command(dev, FSBL_USB_CMD_RESET)
+    except UpdateError as e:
+        sys.stderr.write("error: %s\n" % e)
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,1165 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file usb.c
+*
+* Contains code for the FSBL USB update mode.
+*
+* The controller is polled, FSBL runs with interrupts disabled. Image data
+* is received with the usbps bulk streaming API directly into the DDR
+* staging buffer, FSBL_USB_RX_DTDS buffers of 16 kB are kept queued so the
+* host can send at the full high speed bulk rate.
+*
+* For FSBL_USB_CMD_PROGRAM the QSPI erase and page program commands are
+* issued without waiting for the flash, the busy flag is polled between
+* USB services. A sector is erased as soon as the previous one is
+* programmed and each page is programmed as soon as its data arrived, so
+* the flash works in parallel with the USB transfer and an update takes
+* about as long as the slower of the two. Pages containing only 0xFF are
+* skipped.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00a pt	10/19/26 Initial release
+*
+* </pre>
+*
+* @note
+*	The device only reports high speed descriptors. The USB PHY and its
+*	MIO pins must be set up by ps7_init.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "fsbl.h"
+#include "image_mover.h"
+#include "qspi.h"
+#include "usb.h"
+#include "xusbps.h"
+#include "xusbps_hw.h"
+#include "xdevcfg.h"
+#include <string.h>
+
+#ifdef XPAR_XWDTPS_0_BASEADDR
+#include "xwdtps.h"
+#endif
+
+#ifdef FSBL_USB_UPDATE
+
+/************************** Constant Definitions *****************************/
+#ifndef SDT
+#define USB_DEVICE_ID		XPAR_XUSBPS_0_DEVICE_ID
+#else
+#define USB_DEVICE_ID		XPAR_XUSBPS_0_BASEADDR
+#endif
+
+#define USB_EP0_MAX_PACKET	64
+#define USB_BULK_MAX_PACKET	512
+#define USB_RX_BUF_SIZE		0x4000	/* One dTD */
+
+/*
+ * Standard requests and descriptor types (USB 2.0 chapter 9)
+ */
+#define USB_REQ_TYPE_MASK		0x60
+#define USB_REQ_TYPE_STANDARD		0x00
+#define USB_REQ_RECIPIENT_MASK		0x1F
+#define USB_REQ_RECIPIENT_ENDPOINT	0x02
+
+#define USB_REQ_GET_STATUS		0x00
+#define USB_REQ_CLEAR_FEATURE		0x01
+#define USB_REQ_SET_ADDRESS		0x05
+#define USB_REQ_GET_DESCRIPTOR		0x06
+#define USB_REQ_GET_CONFIGURATION	0x08
+#define USB_REQ_SET_CONFIGURATION	0x09
+#define USB_REQ_SET_INTERFACE		0x0B
+
+#define USB_DESC_DEVICE			0x01
+#define USB_DESC_CONFIG			0x02
+#define USB_DESC_STRING			0x03
+#define USB_DESC_DEVICE_QUALIFIER	0x06
+
+/*
+ * Main loop states
+ */
+#define USB_STATE_IDLE		0	/* Waiting for a command */
+#define USB_STATE_RECEIVE	1	/* Receiving (and programming) an image */
+#define USB_STATE_BOOT		2	/* Boot reply queued */
+#define USB_STATE_RESET		3	/* Reset reply queued */
+
+/*
+ * Flash programming states
+ */
+#define PROG_ERASE_HEADER	0
+#define PROG_NEXT_SECTOR	1
+#define PROG_PAGES		2
+#define PROG_VALIDATE		3
+#define PROG_HEADER_PAGES	4
+#define PROG_FINISH		5
+#define PROG_DONE		6
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+#define USB_MIN(a, b)		(((a) < (b)) ? (a) : (b))
+
+/************************** Function Prototypes ******************************/
+static u32 UsbInit(void);
+static void UsbPoll(void);
+static void UsbEp0Handler(void *CallBackRef, u8 EpNum, u8 EventType,
+		void *Data);
+static void UsbHandleSetup(XUsbPs_SetupData *Setup);
+static void UsbSendEp0(const u8 *Buffer, u32 Length, u16 RequestLength);
+static u32 UsbStringDesc(u8 Index);
+static void UsbRestartStreams(void);
+static void UsbRxHandler(void *CallBackRef, u8 *BufferPtr, u32 BufferLen,
+		u32 BytesTxed, s32 Status);
+static void UsbTxHandler(void *CallBackRef, u8 *BufferPtr, u32 BufferLen,
+		u32 BytesTxed, s32 Status);
+static void UsbSubmitRx(void);
+static void UsbReply(u32 Status);
+static void UsbCommand(void);
+static u32 UsbValidateImage(u32 Length);
+static void UsbProgramStep(void);
+static u32 UsbPageBlank(const u8 *Data, u32 Length);
+
+/************************** Variable Definitions *****************************/
+extern ImageMoverType MoveImage;
+extern u32 FlashReadBaseAddress;
+extern u8 LinearBootDeviceFlag;
+extern PartHeader PartitionHeader[MAX_PARTITION_NUMBER];
+extern u32 PartitionCount;
+extern XDcfg *DcfgInstPtr;
+#if defined(XPAR_PS7_QSPI_LINEAR_0_S_AXI_BASEADDR) || defined(XPAR_PS7_QSPI_LINEAR_0_BASEADDRESS)
+extern u32 QspiFlashSize;
+#endif
+#ifdef XPAR_XWDTPS_0_BASEADDR
+extern XWdtPs Watchdog;	/* Instance of WatchDog Timer	*/
+#endif
+
+static XUsbPs UsbInstance;
+static XUsbPs_DeviceConfig UsbDeviceConfig;
+static XUsbPs_Stream RxStream;
+static XUsbPs_Stream TxStream;
+
+static u8 CmdBuffer[USB_BULK_MAX_PACKET] __attribute__ ((aligned(32)));
+static FsblUsbRsp RspBuffer __attribute__ ((aligned(32)));
+static u8 Ep0Buffer[USB_EP0_MAX_PACKET] __attribute__ ((aligned(32)));
+
+static FsblUsbCmd Cmd;
+static u8 Configured;
+static u8 State;
+static u8 CmdReceived;
+static u8 TxBusy;
+static u8 Aborted;
+
+static u32 RxLength;		/* Bytes announced by the command */
+static u32 RxSubmitted;		/* Bytes queued on the stream */
+static u32 RxDone;		/* Bytes received */
+static u8 RxError;
+
+static u32 ImageLength;		/* Length of the image in the staging buffer */
+static u8 ImageValid;
+
+static u8 ProgState;
+static u32 ProgOffset;		/* Next image byte to program */
+static u32 ProgSectorEnd;
+static u32 ProgStatus;
+#if defined(XPAR_PS7_QSPI_LINEAR_0_S_AXI_BASEADDR) || defined(XPAR_PS7_QSPI_LINEAR_0_BASEADDRESS)
+static u8 QspiReady;
+#endif
+
+static const u8 DeviceDesc[] __attribute__ ((aligned(32))) = {
+	18, USB_DESC_DEVICE,
+	0x00, 0x02,			/* USB 2.0 */
+	0xFF, 0x00, 0x00,		/* Vendor specific */
+	USB_EP0_MAX_PACKET,
+	(FSBL_USB_VENDOR_ID & 0xFF), (FSBL_USB_VENDOR_ID >> 8),
+	(FSBL_USB_PRODUCT_ID & 0xFF), (FSBL_USB_PRODUCT_ID >> 8),
+	0x00, 0x01,			/* bcdDevice */
+	1, 2, 0,			/* Manufacturer, product, no serial */
+	1				/* Configurations */
+};
+
+static const u8 QualifierDesc[] __attribute__ ((aligned(32))) = {
+	10, USB_DESC_DEVICE_QUALIFIER,
+	0x00, 0x02,
+	0xFF, 0x00, 0x00,
+	USB_EP0_MAX_PACKET,
+	1, 0
+};
+
+static const u8 ConfigDesc[] __attribute__ ((aligned(32))) = {
+	/* Configuration */
+	9, USB_DESC_CONFIG,
+	32, 0,				/* Total length */
+	1, 1, 0,			/* Interfaces, value, no string */
+	0xC0,				/* Self powered */
+	50,				/* 100 mA */
+	/* Interface */
+	9, 0x04,
+	0, 0, 2,			/* Number, alternate, endpoints */
+	0xFF, 0x00, 0x00,		/* Vendor specific */
+	0,
+	/* Bulk OUT endpoint 1 */
+	7, 0x05, 0x01, 0x02,
+	(USB_BULK_MAX_PACKET & 0xFF), (USB_BULK_MAX_PACKET >> 8), 0,
+	/* Bulk IN endpoint 1 */
+	7, 0x05, 0x81, 0x02,
+	(USB_BULK_MAX_PACKET & 0xFF), (USB_BULK_MAX_PACKET >> 8), 0
+};
+
+static const char *const StringTable[] = {
+	"AMD",
+	"Zynq FSBL USB Update"
+};
+
+/******************************************************************************/
+/**
+*
+* This function checks whether the USB update mode is to be entered.
+*
+* @param	BootMode is the boot mode read from the SLCR
+*
+* @return	1 for JTAG boot mode or when an application requested the
+*			update mode, otherwise 0
+*
+* @note		The request bit is cleared, a failed update boots normally
+*			on the next reset.
+*
+****************************************************************************/
+u32 FsblUsbRequested(u32 BootMode)
+{
+	u32 RebootStatus;
+
+	RebootStatus = Xil_In32(REBOOT_STATUS_REG);
+	if ((RebootStatus & FSBL_USB_UPDATE_REQ_MASK) != 0) {
+		Xil_Out32(REBOOT_STATUS_REG,
+				RebootStatus & ~FSBL_USB_UPDATE_REQ_MASK);
+		return 1;
+	}
+
+	return (BootMode == JTAG_MODE) ? 1 : 0;
+}
+
+/******************************************************************************/
+/**
+*
+* This function serves the host until it sends a boot command.
+*
+* @param	None
+*
+* @return
+*		- XST_SUCCESS when a validated image in the staging buffer is
+*		to be booted. MoveImage and FlashReadBaseAddress point to the
+*		staging buffer.
+*		- XST_FAILURE if the controller could not be initialized
+*
+* @note		Does not return for FSBL_USB_CMD_RESET.
+*
+****************************************************************************/
+u32 FsblUsbUpdate(void)
+{
+	u32 Status;
+
+	Status = UsbInit();
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	fsbl_printf(DEBUG_GENERAL, "USB update mode, staging buffer 0x%08x\r\n",
+			FSBL_USB_STAGING_ADDR);
+
+	for (;;) {
+		UsbPoll();
+
+#ifdef XPAR_XWDTPS_0_BASEADDR
+		/*
+		 * Prevent WDT reset while waiting for the host
+		 */
+		XWdtPs_RestartWdt(&Watchdog);
+#endif
+
+		if (Aborted != 0) {
+			/*
+			 * Bus reset or reconfiguration, queued buffers are gone.
+			 * The host starts over with a new command
+			 */
+			Aborted = 0;
+			CmdReceived = 0;
+			TxBusy = 0;
+			State = USB_STATE_IDLE;
+			continue;
+		}
+
+		switch (State) {
+		case USB_STATE_IDLE:
+			if (CmdReceived != 0) {
+				CmdReceived = 0;
+				UsbCommand();
+			}
+			break;
+
+		case USB_STATE_RECEIVE:
+			if (RxError != 0) {
+				fsbl_printf(DEBUG_GENERAL, "USB data error at %lu\r\n",
+						RxDone);
+				UsbRestartStreams();
+				UsbReply(USB_CMD_FAIL);
+				break;
+			}
+
+			if (Cmd.Command == FSBL_USB_CMD_PROGRAM) {
+				UsbProgramStep();
+				if (ProgState == PROG_DONE) {
+					UsbReply(ProgStatus);
+				}
+			} else if (RxDone == RxLength) {
+				Status = UsbValidateImage(RxLength);
+				UsbReply(Status);
+			}
+			break;
+
+		case USB_STATE_BOOT:
+			if (TxBusy == 0) {
+				XUsbPs_Stop(&UsbInstance);
+
+				/*
+				 * The staged image is read at offset 0
+				 */
+				XDcfg_WriteReg(DcfgInstPtr->Config.BaseAddr,
+						XDCFG_MULTIBOOT_ADDR_OFFSET, 0);
+
+				MoveImage = UsbAccess;
+				FlashReadBaseAddress = FSBL_USB_STAGING_ADDR;
+				LinearBootDeviceFlag = 0;
+				return XST_SUCCESS;
+			}
+			break;
+
+		case USB_STATE_RESET:
+			if (TxBusy == 0) {
+				XUsbPs_Stop(&UsbInstance);
+				Xil_Out32(PS_RST_CTRL_REG, PS_RST_MASK);
+				for (;;);
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
+}
+
+/******************************************************************************/
+/**
+*
+* This function provides the staging buffer as boot device.
+*
+* @param	SourceAddress is the offset in the staged image
+* @param	DestinationAddress is the destination address
+* @param	LengthBytes is the length of the data in bytes
+*
+* @return
+*		- XST_SUCCESS if the data lies within the received image
+*		- XST_FAILURE otherwise
+*
+* @note		None
+*
+****************************************************************************/
+u32 UsbAccess(u32 SourceAddress, u32 DestinationAddress, u32 LengthBytes)
+{
+	if ((SourceAddress > ImageLength) ||
+			(LengthBytes > (ImageLength - SourceAddress))) {
+		return XST_FAILURE;
+	}
+
+	memcpy((void *)DestinationAddress,
+			(const void *)(FSBL_USB_STAGING_ADDR + SourceAddress),
+			(size_t)LengthBytes);
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function initializes the USB controller in device mode.
+*
+* @param	None
+*
+* @return	XST_SUCCESS or XST_FAILURE
+*
+* @note		None
+*
+****************************************************************************/
+static u32 UsbInit(void)
+{
+	XUsbPs_Config *UsbConfig;
+	s32 Status;
+
+	UsbConfig = XUsbPs_LookupConfig(USB_DEVICE_ID);
+	if (NULL == UsbConfig) {
+		return XST_FAILURE;
+	}
+
+	Status = XUsbPs_CfgInitialize(&UsbInstance, UsbConfig,
+			UsbConfig->BaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	memset(&UsbDeviceConfig, 0, sizeof(UsbDeviceConfig));
+	UsbDeviceConfig.NumEndpoints = 2;
+
+	UsbDeviceConfig.EpCfg[0].Out.Type = XUSBPS_EP_TYPE_CONTROL;
+	UsbDeviceConfig.EpCfg[0].Out.NumBufs = 2;
+	UsbDeviceConfig.EpCfg[0].Out.BufSize = USB_EP0_MAX_PACKET;
+	UsbDeviceConfig.EpCfg[0].Out.MaxPacketSize = USB_EP0_MAX_PACKET;
+	UsbDeviceConfig.EpCfg[0].In.Type = XUSBPS_EP_TYPE_CONTROL;
+	UsbDeviceConfig.EpCfg[0].In.NumBufs = 2;
+	UsbDeviceConfig.EpCfg[0].In.MaxPacketSize = USB_EP0_MAX_PACKET;
+
+	/*
+	 * Streaming endpoints, the buffers are provided per transfer
+	 */
+	UsbDeviceConfig.EpCfg[1].Out.Type = XUSBPS_EP_TYPE_BULK;
+	UsbDeviceConfig.EpCfg[1].Out.NumBufs = FSBL_USB_RX_DTDS;
+	UsbDeviceConfig.EpCfg[1].Out.BufSize = 0;
+	UsbDeviceConfig.EpCfg[1].Out.MaxPacketSize = USB_BULK_MAX_PACKET;
+	UsbDeviceConfig.EpCfg[1].In.Type = XUSBPS_EP_TYPE_BULK;
+	UsbDeviceConfig.EpCfg[1].In.NumBufs = 2;
+	UsbDeviceConfig.EpCfg[1].In.MaxPacketSize = USB_BULK_MAX_PACKET;
+
+	UsbDeviceConfig.DMAMemPhys = FSBL_USB_DMA_ADDR;
+
+	Status = XUsbPs_ConfigureDevice(&UsbInstance, &UsbDeviceConfig);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = XUsbPs_EpSetHandler(&UsbInstance, 0, XUSBPS_EP_DIRECTION_OUT,
+			UsbEp0Handler, &UsbInstance);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	XUsbPs_IntrEnable(&UsbInstance, XUSBPS_IXR_UR_MASK | XUSBPS_IXR_UI_MASK);
+	XUsbPs_Start(&UsbInstance);
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function runs the driver interrupt handler if the controller has
+* pending events.
+*
+* @param	None
+*
+* @return	None
+*
+* @note		None
+*
+****************************************************************************/
+static void UsbPoll(void)
+{
+	if ((XUsbPs_ReadReg(UsbInstance.Config.BaseAddress, XUSBPS_ISR_OFFSET) &
+			(XUSBPS_IXR_UR_MASK | XUSBPS_IXR_UI_MASK)) != 0) {
+		XUsbPs_IntrHandler(&UsbInstance);
+	}
+}
+
+/******************************************************************************/
+/**
+*
+* This function handles the control endpoint events.
+*
+* @param	CallBackRef is the USB instance
+* @param	EpNum is the endpoint number
+* @param	EventType is the event
+* @param	Data is unused
+*
+* @return	None
+*
+* @note		None
+*
+****************************************************************************/
+static void UsbEp0Handler(void *CallBackRef, u8 EpNum, u8 EventType,
+		void *Data)
+{
+	XUsbPs_SetupData Setup;
+	u8 *BufferPtr;
+	u32 BufferLen;
+	u32 Handle;
+
+	(void)CallBackRef;
+	(void)Data;
+
+	switch (EventType) {
+	case XUSBPS_EP_EVENT_SETUP_DATA_RECEIVED:
+		if (XUsbPs_EpGetSetupData(&UsbInstance, EpNum, &Setup) ==
+				XST_SUCCESS) {
+			UsbHandleSetup(&Setup);
+		}
+		break;
+
+	case XUSBPS_EP_EVENT_DATA_RX:
+		/*
+		 * Status stage of an IN request, nothing to do
+		 */
+		if (XUsbPs_EpBufferReceive(&UsbInstance, EpNum, &BufferPtr,
+				&BufferLen, &Handle) == XST_SUCCESS) {
+			XUsbPs_EpBufferRelease(Handle);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+/******************************************************************************/
+/**
+*
+* This function answers the standard requests needed for enumeration.
+* Everything else is stalled.
+*
+* @param	Setup is the setup packet
+*
+* @return	None
+*
+* @note		None
+*
+****************************************************************************/
+static void UsbHandleSetup(XUsbPs_SetupData *Setup)
+{
+	u32 Length;
+	u8 EpNum;
+
+	if ((Setup->bmRequestType & USB_REQ_TYPE_MASK) != USB_REQ_TYPE_STANDARD) {
+		XUsbPs_EpStall(&UsbInstance, 0,
+				XUSBPS_EP_DIRECTION_IN | XUSBPS_EP_DIRECTION_OUT);
+		return;
+	}
+
+	switch (Setup->bRequest) {
+	case USB_REQ_GET_STATUS:
+		Ep0Buffer[0] = 0;
+		Ep0Buffer[1] = 0;
+		UsbSendEp0(Ep0Buffer, 2, Setup->wLength);
+		break;
+
+	case USB_REQ_SET_ADDRESS:
+		(void)XUsbPs_SetDeviceAddress(&UsbInstance,
+				(u8)(Setup->wValue & 0x7F));
+		UsbSendEp0(NULL, 0, 0);
+		break;
+
+	case USB_REQ_GET_DESCRIPTOR:
+		switch (Setup->wValue >> 8) {
+		case USB_DESC_DEVICE:
+			UsbSendEp0(DeviceDesc, sizeof(DeviceDesc), Setup->wLength);
+			break;
+		case USB_DESC_DEVICE_QUALIFIER:
+			UsbSendEp0(QualifierDesc, sizeof(QualifierDesc),
+					Setup->wLength);
+			break;
+		case USB_DESC_CONFIG:
+			UsbSendEp0(ConfigDesc, sizeof(ConfigDesc), Setup->wLength);
+			break;
+		case USB_DESC_STRING:
+			Length = UsbStringDesc((u8)(Setup->wValue & 0xFF));
+			if (Length == 0) {
+				XUsbPs_EpStall(&UsbInstance, 0, XUSBPS_EP_DIRECTION_IN);
+			} else {
+				UsbSendEp0(Ep0Buffer, Length, Setup->wLength);
+			}
+			break;
+		default:
+			XUsbPs_EpStall(&UsbInstance, 0, XUSBPS_EP_DIRECTION_IN);
+			break;
+		}
+		break;
+
+	case USB_REQ_GET_CONFIGURATION:
+		Ep0Buffer[0] = Configured;
+		UsbSendEp0(Ep0Buffer, 1, Setup->wLength);
+		break;
+
+	case USB_REQ_SET_CONFIGURATION:
+		if ((Setup->wValue & 0xFF) == 1) {
+			XUsbPs_EpEnable(&UsbInstance, 1,
+					XUSBPS_EP_DIRECTION_IN | XUSBPS_EP_DIRECTION_OUT);
+			XUsbPs_SetBits(&UsbInstance, XUSBPS_EPCR1_OFFSET,
+					XUSBPS_EPCR_TXT_BULK_MASK |
+					XUSBPS_EPCR_RXT_BULK_MASK |
+					XUSBPS_EPCR_TXR_MASK |
+					XUSBPS_EPCR_RXR_MASK);
+			UsbRestartStreams();
+			Configured = 1;
+		} else {
+			Configured = 0;
+		}
+		UsbSendEp0(NULL, 0, 0);
+		break;
+
+	case USB_REQ_SET_INTERFACE:
+		UsbSendEp0(NULL, 0, 0);
+		break;
+
+	case USB_REQ_CLEAR_FEATURE:
+		/*
+		 * Endpoint halt, also resets the data toggle
+		 */
+		if ((Setup->bmRequestType & USB_REQ_RECIPIENT_MASK) ==
+				USB_REQ_RECIPIENT_ENDPOINT) {
+			EpNum = (u8)(Setup->wIndex & 0x0F);
+			if (Setup->wIndex & 0x80) {
+				XUsbPs_EpUnStall(&UsbInstance, EpNum,
+						XUSBPS_EP_DIRECTION_IN);
+				XUsbPs_SetBits(&UsbInstance, XUSBPS_EPCRn_OFFSET(EpNum),
+						XUSBPS_EPCR_TXR_MASK);
+			} else {
+				XUsbPs_EpUnStall(&UsbInstance, EpNum,
+						XUSBPS_EP_DIRECTION_OUT);
+				XUsbPs_SetBits(&UsbInstance, XUSBPS_EPCRn_OFFSET(EpNum),
+						XUSBPS_EPCR_RXR_MASK);
+			}
+		}
+		UsbSendEp0(NULL, 0, 0);
+		break;
+
+	default:
+		XUsbPs_EpStall(&UsbInstance, 0,
+				XUSBPS_EP_DIRECTION_IN | XUSBPS_EP_DIRECTION_OUT);
+		break;
+	}
+}
+
+/******************************************************************************/
+/**
+*
+* This function sends the data stage of a control request.
+*
+* @param	Buffer is the data, NULL for the status stage of a request
+*			without data
+* @param	Length is the data length
+* @param	RequestLength is the length requested by the host
+*
+* @return	None
+*
+* @note		None
+*
+****************************************************************************/
+static void UsbSendEp0(const u8 *Buffer, u32 Length, u16 RequestLength)
+{
+	(void)XUsbPs_EpBufferSend(&UsbInstance, 0, Buffer,
+			USB_MIN(Length, (u32)RequestLength));
+}
+
+/******************************************************************************/
+/**
+*
+* This function builds a string descriptor in Ep0Buffer.
+*
+* @param	Index is the string index
+*
+* @return	Descriptor length, 0 for an unknown index
+*
+* @note		None
+*
+****************************************************************************/
+static u32 UsbStringDesc(u8 Index)
+{
+	const char *String;
+	u32 Length = 2;
+
+	if (Index == 0) {
+		/*
+		 * Supported languages, US English
+		 */
+		Ep0Buffer[2] = 0x09;
+		Ep0Buffer[3] = 0x04;
+		Length = 4;
+	} else if (Index <= (sizeof(StringTable) / sizeof(StringTable[0]))) {
+		String = StringTable[Index - 1];
+		while ((*String != '\0') && (Length < (USB_EP0_MAX_PACKET - 1))) {
+			Ep0Buffer[Length++] = (u8)*String++;
+			Ep0Buffer[Length++] = 0;
+		}
+	} else {
+		return 0;
+	}
+
+	Ep0Buffer[0] = (u8)Length;
+	Ep0Buffer[1] = USB_DESC_STRING;
+
+	return Length;
+}
+
+/******************************************************************************/
+/**
+*
+* This function (re)starts streaming on the bulk endpoints and queues the
+* buffer for the next command.
+*
+* @param	None
+*
+* @return	None
+*
+* @note		Buffers still queued are returned with XST_DATA_LOST, which
+*			aborts the command in progress.
+*
+****************************************************************************/
+static void UsbRestartStreams(void)
+{
+	if (UsbInstance.DeviceConfig.Ep[1].Out.Stream != NULL) {
+		XUsbPs_StreamStop(&RxStream);
+	}
+	if (UsbInstance.DeviceConfig.Ep[1].In.Stream != NULL) {
+		XUsbPs_StreamStop(&TxStream);
+	}
+
+	(void)XUsbPs_StreamStart(&UsbInstance, &RxStream, 1,
+			XUSBPS_EP_DIRECTION_OUT, UsbRxHandler, NULL);
+	(void)XUsbPs_StreamStart(&UsbInstance, &TxStream, 1,
+			XUSBPS_EP_DIRECTION_IN, UsbTxHandler, NULL);
+
+	(void)XUsbPs_StreamSubmit(&RxStream, CmdBuffer, sizeof(CmdBuffer));
+}
+
+/******************************************************************************/
+/**
+*
+* This function is called for every completed bulk OUT buffer.
+*
+* @param	CallBackRef is unused
+* @param	BufferPtr is the completed buffer
+* @param	BufferLen is the buffer length
+* @param	BytesTxed is the number of bytes received
+* @param	Status is the completion status
+*
+* @return	None
+*
+* @note		Image buffers are refilled from here so the endpoint never
+*			runs dry while the main loop is busy with the flash.
+*
+****************************************************************************/
+static void UsbRxHandler(void *CallBackRef, u8 *BufferPtr, u32 BufferLen,
+		u32 BytesTxed, s32 Status)
+{
+	(void)CallBackRef;
+
+	if (Status == XST_DATA_LOST) {
+		Aborted = 1;
+		return;
+	}
+
+	if (BufferPtr == CmdBuffer) {
+		if ((Status == XST_SUCCESS) && (BytesTxed == sizeof(FsblUsbCmd))) {
+			memcpy(&Cmd, CmdBuffer, sizeof(Cmd));
+		} else {
+			Cmd.Magic = 0;
+		}
+		CmdReceived = 1;
+		return;
+	}
+
+	/*
+	 * Image data, only the last buffer may be short
+	 */
+	RxDone += BytesTxed;
+	if ((Status != XST_SUCCESS) || (BytesTxed != BufferLen)) {
+		RxError = 1;
+		return;
+	}
+
+	UsbSubmitRx();
+}
+
+/******************************************************************************/
+/**
+*
+* This function is called for every completed bulk IN buffer.
+*
+* @param	CallBackRef is unused
+* @param	BufferPtr is the completed buffer
+* @param	BufferLen is the buffer length
+* @param	BytesTxed is the number of bytes sent
+* @param	Status is the completion status
+*
+* @return	None
+*
+* @note		None
+*
+****************************************************************************/
+static void UsbTxHandler(void *CallBackRef, u8 *BufferPtr, u32 BufferLen,
+		u32 BytesTxed, s32 Status)
+{
+	(void)CallBackRef;
+	(void)BufferPtr;
+	(void)BufferLen;
+	(void)BytesTxed;
+
+	if (Status == XST_DATA_LOST) {
+		Aborted = 1;
+	}
+
+	TxBusy = 0;
+}
+
+/******************************************************************************/
+/**
+*
+* This function queues image buffers until the stream is full or the whole
+* announced length is queued.
+*
+* @param	None
+*
+* @return	None
+*
+* @note		None
+*
+****************************************************************************/
+static void UsbSubmitRx(void)
+{
+	u32 Length;
+
+	while (RxSubmitted < RxLength) {
+		Length = USB_MIN(RxLength - RxSubmitted, USB_RX_BUF_SIZE);
+		if (XUsbPs_StreamSubmit(&RxStream,
+				(u8 *)(FSBL_USB_STAGING_ADDR + RxSubmitted),
+				Length) != XST_SUCCESS) {
+			break;
+		}
+		RxSubmitted += Length;
+	}
+}
+
+/******************************************************************************/
+/**
+*
+* This function sends the response to the current command. In idle state
+* the buffer for the next command is queued.
+*
+* @param	Status is 0 or an FSBL error code
+*
+* @return	None
+*
+* @note		None
+*
+****************************************************************************/
+static void UsbReply(u32 Status)
+{
+	if (Status != XST_SUCCESS) {
+		fsbl_printf(DEBUG_GENERAL, "USB command 0x%lx failed 0x%lx\r\n",
+				Cmd.Command, Status);
+	}
+
+	RspBuffer.Magic = FSBL_USB_RSP_MAGIC;
+	RspBuffer.Command = Cmd.Command;
+	RspBuffer.Status = Status;
+	RspBuffer.Length = RxDone;
+
+	TxBusy = 1;
+	if (XUsbPs_StreamSubmit(&TxStream, (u8 *)&RspBuffer,
+			sizeof(RspBuffer)) != XST_SUCCESS) {
+		TxBusy = 0;
+	}
+
+	if ((Status == XST_SUCCESS) && (Cmd.Command == FSBL_USB_CMD_BOOT)) {
+		State = USB_STATE_BOOT;
+	} else if ((Status == XST_SUCCESS) && (Cmd.Command == FSBL_USB_CMD_RESET)) {
+		State = USB_STATE_RESET;
+	} else {
+		State = USB_STATE_IDLE;
+		(void)XUsbPs_StreamSubmit(&RxStream, CmdBuffer, sizeof(CmdBuffer));
+	}
+}
+
+/******************************************************************************/
+/**
+*
+* This function starts the command in Cmd.
+*
+* @param	None
+*
+* @return	None
+*
+* @note		None
+*
+****************************************************************************/
+static void UsbCommand(void)
+{
+	RxDone = 0;
+
+	if (Cmd.Magic != FSBL_USB_CMD_MAGIC) {
+		UsbReply(USB_CMD_FAIL);
+		return;
+	}
+
+	switch (Cmd.Command) {
+	case FSBL_USB_CMD_DOWNLOAD:
+	case FSBL_USB_CMD_PROGRAM:
+		if ((Cmd.Length == 0) || (Cmd.Length > FSBL_USB_STAGING_SIZE)) {
+			UsbReply(USB_CMD_FAIL);
+			return;
+		}
+
+		if (Cmd.Command == FSBL_USB_CMD_PROGRAM) {
+#if defined(XPAR_PS7_QSPI_LINEAR_0_S_AXI_BASEADDR) || defined(XPAR_PS7_QSPI_LINEAR_0_BASEADDRESS)
+			if (QspiReady == 0) {
+				if ((InitQspi() != XST_SUCCESS) ||
+						(QspiWriteInit() != XST_SUCCESS)) {
+					UsbReply(QSPI_PROGRAM_FAIL);
+					return;
+				}
+				QspiReady = 1;
+			}
+
+			if (((Cmd.FlashOffset & (QSPI_SECTOR_SIZE - 1)) != 0) ||
+					(Cmd.FlashOffset >= QspiFlashSize) ||
+					(Cmd.Length > (QspiFlashSize - Cmd.FlashOffset))) {
+				UsbReply(USB_CMD_FAIL);
+				return;
+			}
+
+			ProgState = PROG_ERASE_HEADER;
+			ProgStatus = XST_SUCCESS;
+#else
+			UsbReply(QSPI_PROGRAM_FAIL);
+			return;
+#endif
+		}
+
+		/*
+		 * The previous image is overwritten
+		 */
+		ImageValid = 0;
+		ImageLength = 0;
+		RxLength = Cmd.Length;
+		RxSubmitted = 0;
+		RxError = 0;
+		State = USB_STATE_RECEIVE;
+		UsbSubmitRx();
+		break;
+
+	case FSBL_USB_CMD_BOOT:
+		UsbReply((ImageValid != 0) ? XST_SUCCESS : INVALID_HEADER_FAIL);
+		break;
+
+	case FSBL_USB_CMD_RESET:
+		UsbReply(XST_SUCCESS);
+		break;
+
+	default:
+		UsbReply(USB_CMD_FAIL);
+		break;
+	}
+}
+
+/******************************************************************************/
+/**
+*
+* This function checks the image in the staging buffer with the boot header
+* checksum, the partition header checksums and the partition checksums.
+*
+* @param	Length is the image length
+*
+* @return	XST_SUCCESS or the FSBL error code of the failed check
+*
+* @note		RSA signatures and encryption are checked when the image is
+*			booted, as for every other boot device.
+*
+****************************************************************************/
+static u32 UsbValidateImage(u32 Length)
+{
+	PartHeader *HeaderPtr;
+	u32 PartitionNum;
+	u32 PartitionEnd;
+
+	ImageLength = Length;
+	MoveImage = UsbAccess;
+
+	if ((ImageCheckID(0) != XST_SUCCESS) ||
+			(HeaderChecksum(0) != XST_SUCCESS)) {
+		return INVALID_HEADER_FAIL;
+	}
+
+	if (GetPartitionHeaderInfo(0) != XST_SUCCESS) {
+		return GET_HEADER_INFO_FAIL;
+	}
+
+#ifdef MMC_SUPPORT
+	PartitionNum = 0;
+#else
+	PartitionNum = 1;
+#endif
+	for (; PartitionNum < PartitionCount; PartitionNum++) {
+		HeaderPtr = &PartitionHeader[PartitionNum];
+
+		if (ValidateHeader(HeaderPtr) != XST_SUCCESS) {
+			return INVALID_HEADER_FAIL;
+		}
+
+		PartitionEnd = (HeaderPtr->PartitionStart +
+				HeaderPtr->PartitionWordLen) << WORD_LENGTH_SHIFT;
+		if (PartitionEnd > Length) {
+			return PARTITION_LOAD_FAIL;
+		}
+
+		if ((HeaderPtr->PartitionAttr & ATTRIBUTE_CHECKSUM_TYPE_MASK) &&
+				(ValidateParition(FSBL_USB_STAGING_ADDR +
+				(HeaderPtr->PartitionStart << WORD_LENGTH_SHIFT),
+				(HeaderPtr->PartitionWordLen << WORD_LENGTH_SHIFT),
+				(HeaderPtr->CheckSumOffset << WORD_LENGTH_SHIFT)) !=
+				XST_SUCCESS)) {
+			return PARTITION_CHECKSUM_FAIL;
+		}
+	}
+
+	fsbl_printf(DEBUG_INFO, "USB image valid, %lu bytes\r\n", Length);
+	ImageValid = 1;
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function advances the QSPI programming by one flash command. It
+* returns right away while the flash is busy or the data of the next page
+* has not arrived yet.
+*
+* @param	None
+*
+* @return	None
+*
+* @note		Sets ProgState to PROG_DONE and ProgStatus once the update
+*			is complete or failed.
+*
+****************************************************************************/
+static void UsbProgramStep(void)
+{
+#if defined(XPAR_PS7_QSPI_LINEAR_0_S_AXI_BASEADDR) || defined(XPAR_PS7_QSPI_LINEAR_0_BASEADDRESS)
+	u32 PageEnd;
+	u32 Status = XST_SUCCESS;
+	u8 *Data;
+
+	if ((ProgState == PROG_DONE) || (QspiIsBusy() != 0)) {
+		return;
+	}
+
+	switch (ProgState) {
+	case PROG_ERASE_HEADER:
+		/*
+		 * Erased first and written last, see usb.h
+		 */
+		Status = QspiEraseSectorStart(Cmd.FlashOffset);
+		ProgOffset = QSPI_SECTOR_SIZE;
+		ProgState = PROG_NEXT_SECTOR;
+		break;
+
+	case PROG_NEXT_SECTOR:
+		if (ProgOffset >= RxLength) {
+			ProgState = PROG_VALIDATE;
+			break;
+		}
+		Status = QspiEraseSectorStart(Cmd.FlashOffset + ProgOffset);
+		ProgSectorEnd = USB_MIN(ProgOffset + QSPI_SECTOR_SIZE, RxLength);
+		ProgState = PROG_PAGES;
+		break;
+
+	case PROG_PAGES:
+	case PROG_HEADER_PAGES:
+		while (ProgOffset < ProgSectorEnd) {
+			PageEnd = USB_MIN(ProgOffset + QSPI_PAGE_SIZE, ProgSectorEnd);
+			if (RxDone < PageEnd) {
+				return;
+			}
+
+			Data = (u8 *)(FSBL_USB_STAGING_ADDR + ProgOffset);
+			if (UsbPageBlank(Data, PageEnd - ProgOffset) == 0) {
+				Status = QspiProgramPageStart(Cmd.FlashOffset + ProgOffset,
+						Data, PageEnd - ProgOffset);
+				ProgOffset = PageEnd;
+				break;
+			}
+			ProgOffset = PageEnd;
+		}
+
+		if ((ProgOffset == ProgSectorEnd) && (Status == XST_SUCCESS)) {
+			ProgState = (ProgState == PROG_PAGES) ?
+					PROG_NEXT_SECTOR : PROG_FINISH;
+		}
+		break;
+
+	case PROG_VALIDATE:
+		if (RxDone != RxLength) {
+			return;
+		}
+		ProgStatus = UsbValidateImage(RxLength);
+		if (ProgStatus != XST_SUCCESS) {
+			ProgState = PROG_DONE;
+			return;
+		}
+		ProgOffset = 0;
+		ProgSectorEnd = USB_MIN(QSPI_SECTOR_SIZE, RxLength);
+		ProgState = PROG_HEADER_PAGES;
+		break;
+
+	case PROG_FINISH:
+		fsbl_printf(DEBUG_GENERAL, "QSPI programmed, %lu bytes at 0x%08lx\r\n",
+				RxLength, Cmd.FlashOffset);
+		ProgState = PROG_DONE;
+		break;
+
+	default:
+		break;
+	}
+
+	if (Status != XST_SUCCESS) {
+		ProgStatus = QSPI_PROGRAM_FAIL;
+		ProgState = PROG_DONE;
+	}
+#else
+	ProgStatus = QSPI_PROGRAM_FAIL;
+	ProgState = PROG_DONE;
+#endif
+}
+
+/******************************************************************************/
+/**
+*
+* This function checks whether a page can be left erased.
+*
+* @param	Data is the page data
+* @param	Length is the page length
+*
+* @return	1 if all bytes are 0xFF, otherwise 0
+*
+* @note		None
+*
+****************************************************************************/
+static u32 UsbPageBlank(const u8 *Data, u32 Length)
+{
+	u32 Index;
+
+	for (Index = 0; Index < Length; Index++) {
+		if (Data[Index] != 0xFF) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+#endif
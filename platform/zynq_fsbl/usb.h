@@ -0,0 +1,148 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file usb.h
+*
+* This file contains the interface for the FSBL USB update mode.
+*
+* In USB update mode the FSBL enumerates as a vendor specific high speed
+* device with one bulk OUT and one bulk IN endpoint (endpoint 1) and waits
+* for commands from the host. A boot image (BOOT.BIN) is streamed straight
+* into a DDR staging buffer, validated with the boot header checksum and
+* the partition checksums and then either booted from DDR or programmed to
+* QSPI.
+*
+* Protocol, all words little endian:
+* - The host sends an FsblUsbCmd block (16 bytes) on bulk OUT.
+* - DOWNLOAD and PROGRAM are followed by Length bytes of image data on bulk
+*   OUT, sent as one bulk transfer.
+* - The FSBL answers every command with an FsblUsbRsp block (16 bytes) on
+*   bulk IN. Status is 0 on success or one of the FSBL error codes of fsbl.h.
+*
+* Commands:
+* - FSBL_USB_CMD_DOWNLOAD: receive an image into DDR and validate it.
+* - FSBL_USB_CMD_PROGRAM: receive an image and program it to QSPI at
+*   FlashOffset. Sectors are erased and programmed while the rest of the
+*   image is still being received. The sector holding the boot header is
+*   erased first and only programmed after the whole image validated, so an
+*   interrupted or invalid update never leaves a bootable header in front
+*   of partial partitions.
+* - FSBL_USB_CMD_BOOT: boot the last validated image from DDR.
+* - FSBL_USB_CMD_RESET: reset the PS.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00a pt	10/19/26 Initial release
+*
+* </pre>
+*
+* @note
+*
+* FSBL_USB_UPDATE must be defined to enable this feature. The update mode
+* is entered in JTAG boot mode and when an application sets
+* FSBL_USB_UPDATE_REQ_MASK in the reboot status register before a software
+* reset.
+*
+* The staging buffer and the USB descriptor memory are taken from the top of
+* DDR, partitions of an image booted over USB must not load there.
+*
+* Only single QSPI flash connections can be programmed.
+*
+* tools/fsbl_usb_update.py is the host side of this protocol.
+*
+******************************************************************************/
+#ifndef ___USB_H___
+#define ___USB_H___
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "fsbl.h"
+
+/************************** Constant Definitions *****************************/
+#ifndef FSBL_USB_VENDOR_ID
+#define FSBL_USB_VENDOR_ID		0x03FD
+#endif
+#ifndef FSBL_USB_PRODUCT_ID
+#define FSBL_USB_PRODUCT_ID		0x0500
+#endif
+
+/*
+ * Reboot status register bit an application sets to request the update
+ * mode on the next software reset, the top bit of the user range
+ */
+#define FSBL_USB_UPDATE_REQ_MASK	0x00800000
+
+/*
+ * Memory used in DDR, the top 1 MB is left free for the fast resume
+ * descriptor
+ */
+#ifndef FSBL_USB_DMA_SIZE
+#define FSBL_USB_DMA_SIZE		0x10000
+#endif
+#ifndef FSBL_USB_DMA_ADDR
+#define FSBL_USB_DMA_ADDR		(DDR_END_ADDR + 1 - 0x100000)
+#endif
+#ifndef FSBL_USB_STAGING_SIZE
+#define FSBL_USB_STAGING_SIZE		0x4000000
+#endif
+#ifndef FSBL_USB_STAGING_ADDR
+#define FSBL_USB_STAGING_ADDR		(FSBL_USB_DMA_ADDR - FSBL_USB_STAGING_SIZE)
+#endif
+
+/*
+ * Receive descriptors on the bulk OUT endpoint, each one carries up to
+ * 16 kB of image data
+ */
+#ifndef FSBL_USB_RX_DTDS
+#define FSBL_USB_RX_DTDS		16
+#endif
+
+#define FSBL_USB_CMD_MAGIC		0x44505546	/* "FUPD" */
+#define FSBL_USB_RSP_MAGIC		0x53505546	/* "FUPS" */
+
+#define FSBL_USB_CMD_DOWNLOAD		0x1
+#define FSBL_USB_CMD_PROGRAM		0x2
+#define FSBL_USB_CMD_BOOT		0x3
+#define FSBL_USB_CMD_RESET		0x4
+
+/**************************** Type Definitions *******************************/
+typedef struct {
+	u32 Magic;		/* FSBL_USB_CMD_MAGIC */
+	u32 Command;
+	u32 Length;		/* Image length in bytes */
+	u32 FlashOffset;	/* PROGRAM: QSPI offset, sector aligned */
+} FsblUsbCmd;
+
+typedef struct {
+	u32 Magic;		/* FSBL_USB_RSP_MAGIC */
+	u32 Command;		/* Command answered */
+	u32 Status;		/* 0 or FSBL error code */
+	u32 Length;		/* Bytes received */
+} FsblUsbRsp;
+
+/************************** Function Prototypes ******************************/
+#ifdef FSBL_USB_UPDATE
+u32 FsblUsbRequested(u32 BootMode);
+u32 FsblUsbUpdate(void);
+u32 UsbAccess(u32 SourceAddress, u32 DestinationAddress, u32 LengthBytes);
+#endif
+
+/************************** Variable Definitions *****************************/
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* ___USB_H___ */
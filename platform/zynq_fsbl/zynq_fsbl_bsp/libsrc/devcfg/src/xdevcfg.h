@@ -49,6 +49,21 @@
 * The Driver implements an interrupt handler to support the interrupts provided
 * by this interface.
 *
+* <b> Partial Reconfiguration </b>
+*
+* xdevcfg_pr.c swaps partial bitstreams through PCAP once the PL holds its
+* full configuration. The application describes the partial bitstreams in a
+* catalog of XDcfg_PrImage entries and supplies a read function for the
+* storage they are kept on (an SD file or a QSPI flash range, for example),
+* plus a DDR area used as a cache of up to XDCFG_PR_MAX_SLOTS bitstreams.
+* XDcfg_PrLoad() downloads a bitstream from the cache, reading it into the
+* cache first on a miss. PROG_B, the level shifters and the PL resets are not
+* touched, so the static region and the PS-PL interface keep running.
+* The service counts the swaps between catalog entries. XDcfg_PrPrefetch(),
+* called when the application has time to spare, reads the most likely
+* next bitstream into the cache; XDcfg_PrPreload() reads a given one.
+* The latency of every swap is kept in XDcfg_PrStats, in XTime counts.
+*
 * <b> Threads </b>
 *
 * This driver is not thread safe. Any needs for threads or thread mutual
@@ -135,6 +150,8 @@
 *                    definitions of devcfg in xparameters.h
 *       ms  08/07/17 Fixed compilation warnings in xdevcfg_sinit.c
 * 3.8  Nava 06/21/23 Added support for system device-tree flow.
+* 3.9   pt  10/19/26 Added the partial reconfiguration service in
+*                    xdevcfg_pr.c
 * </pre>
 *
 ******************************************************************************/
@@ -161,6 +178,12 @@ extern "C" {
 #define XDCFG_CONCURRENT_SECURE_READ_WRITE	4
 #define XDCFG_CONCURRENT_NONSEC_READ_WRITE	5
 
+/* Partial reconfiguration service limits */
+
+#define XDCFG_PR_MAX_IMAGES	16U	/**< Catalog entries */
+#define XDCFG_PR_MAX_SLOTS	8U	/**< Cached bitstreams */
+#define XDCFG_PR_NONE		0xFFFFFFFFU /**< No catalog entry */
+
 
 /**************************** Type Definitions *******************************/
 /**
@@ -207,6 +230,66 @@ typedef struct {
 	void *CallBackRef;	/* Callback reference for event handler */
 } XDcfg;
 
+/**
+* The read function of the partial reconfiguration service, reads ByteCount
+* bytes at Offset of the bitstream storage to BufferPtr.
+*
+* @param	CallBackRef is the reference passed to XDcfg_PrInitialize.
+* @param	Offset is the storage offset, taken from the catalog.
+* @param	BufferPtr is the destination in the DDR cache.
+* @param	ByteCount is the number of bytes to read.
+*
+* @return	XST_SUCCESS if the bytes were read, any other value if not.
+*/
+typedef s32 (*XDcfg_PrReadFn) (void *CallBackRef, u32 Offset,
+			       u8 *BufferPtr, u32 ByteCount);
+
+/**
+ * Catalog entry of a partial bitstream
+ */
+typedef struct {
+	u32 Offset;		/**< Storage offset for the read function */
+	u32 WordLength;		/**< Bitstream length in words */
+} XDcfg_PrImage;
+
+/**
+ * Swap statistics, times are in XTime counts (COUNTS_PER_SECOND)
+ */
+typedef struct {
+	u32 Swaps;		/**< Successful XDcfg_PrLoad calls */
+	u32 Hits;		/**< Swaps served from the cache */
+	u32 PrefetchHits;	/**< Hits on a prefetched bitstream */
+	u32 Misses;		/**< Swaps which read the storage */
+	u32 Prefetches;		/**< Bitstreams read by XDcfg_PrPrefetch */
+	u64 LastCounts;		/**< Latency of the last swap */
+	u64 LastReadCounts;	/**< Storage read of the last swap, 0 on a hit */
+	u64 LastPcapCounts;	/**< PCAP download of the last swap */
+	u64 MaxCounts;		/**< Worst swap latency */
+	u64 TotalCounts;	/**< Sum of all swap latencies */
+} XDcfg_PrStats;
+
+/**
+ * The partial reconfiguration service instance data.
+ */
+typedef struct {
+	XDcfg *DcfgPtr;			/**< Initialized XDcfg instance */
+	const XDcfg_PrImage *Catalog;	/**< Partial bitstreams */
+	u32 ImageCount;			/**< Catalog entries */
+	XDcfg_PrReadFn ReadFn;		/**< Storage read function */
+	void *ReadRef;			/**< Read function reference */
+	UINTPTR CacheAddr;		/**< DDR cache, cache line aligned */
+	u32 SlotSize;			/**< Bytes per cached bitstream */
+	u32 SlotCount;			/**< Cached bitstreams */
+	u32 SlotImage[XDCFG_PR_MAX_SLOTS]; /**< Catalog entry per slot */
+	u32 SlotUse[XDCFG_PR_MAX_SLOTS];   /**< Last use, for LRU */
+	u32 PrefetchMask;		/**< Slots filled by XDcfg_PrPrefetch */
+	u32 UseCount;			/**< LRU clock */
+	u32 Current;			/**< Catalog entry in the PL */
+	u16 Transitions[XDCFG_PR_MAX_IMAGES][XDCFG_PR_MAX_IMAGES];
+					/**< Swap counts, from/to */
+	XDcfg_PrStats Stats;		/**< Swap statistics */
+} XDcfg_Pr;
+
 /****************************************************************************/
 /**
 *
@@ -385,6 +468,25 @@ void XDcfg_InterruptHandler(XDcfg *InstancePtr);
 void XDcfg_SetHandler(XDcfg *InstancePtr, void *CallBackFunc,
 		      void *CallBackRef);
 
+/*
+ * Partial reconfiguration service in xdevcfg_pr.c
+ */
+s32 XDcfg_PrInitialize(XDcfg_Pr *PrPtr, XDcfg *InstancePtr,
+		       const XDcfg_PrImage *Catalog, u32 ImageCount,
+		       XDcfg_PrReadFn ReadFn, void *ReadRef,
+		       UINTPTR CacheAddr, u32 CacheSize);
+
+s32 XDcfg_PrLoad(XDcfg_Pr *PrPtr, u32 ImageId);
+
+s32 XDcfg_PrPreload(XDcfg_Pr *PrPtr, u32 ImageId);
+
+u32 XDcfg_PrPredict(XDcfg_Pr *PrPtr);
+
+s32 XDcfg_PrPrefetch(XDcfg_Pr *PrPtr);
+
+void XDcfg_PrGetStats(XDcfg_Pr *PrPtr, XDcfg_PrStats *StatsPtr,
+		      u32 Clear);
+
 #ifdef __cplusplus
 }
 #endif
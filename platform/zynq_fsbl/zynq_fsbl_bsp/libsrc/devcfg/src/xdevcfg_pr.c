@@ -0,0 +1,528 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/****************************************************************************/
+/**
+*
+* @file xdevcfg_pr.c
+* @addtogroup devcfg Overview
+* @{
+*
+* Contains the partial reconfiguration service of the XDcfg driver: a
+* catalog of partial bitstreams, a DDR cache of recently used and prefetched
+* bitstreams, and the PCAP download of a partial bitstream into a running
+* PL. See xdevcfg.h for an overview.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- ---------------------------------------------
+* 3.9   pt  10/19/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+#include "xdevcfg.h"
+#include "xil_cache.h"
+#include "xtime_l.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XDCFG_PR_SLOT_ALIGN	64U	/**< Cache slot alignment, bytes */
+#define XDCFG_PR_DMA_LAST	0x1U	/**< Last DMA transfer of a command */
+#define XDCFG_PR_POLL_COUNT	100000000U /**< D_P_DONE polls before timeout */
+#define XDCFG_PR_MAX_WORDS	0x3FFFFFFFU /**< Bitstream length limit */
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+static u32 XDcfg_PrFindSlot(XDcfg_Pr *PrPtr, u32 ImageId);
+static s32 XDcfg_PrFill(XDcfg_Pr *PrPtr, u32 ImageId, u32 *SlotPtr);
+static s32 XDcfg_PrDownload(XDcfg *InstancePtr, UINTPTR Addr,
+			    u32 WordLength);
+
+/************************** Variable Definitions *****************************/
+
+/****************************************************************************/
+/**
+*
+* This function initializes a partial reconfiguration service instance. The
+* cache is split into slots of the size of the largest catalog entry.
+*
+* @param	PrPtr is a pointer to the XDcfg_Pr instance.
+* @param	InstancePtr is a pointer to an initialized XDcfg instance.
+* @param	Catalog is the array of partial bitstreams, it must stay valid
+*		while the service is used. The index of an entry is its
+*		ImageId.
+* @param	ImageCount is the number of catalog entries, at most
+*		XDCFG_PR_MAX_IMAGES.
+* @param	ReadFn is the function which reads the bitstream storage.
+* @param	ReadRef is passed to ReadFn.
+* @param	CacheAddr is the DDR cache, aligned to 64 bytes.
+* @param	CacheSize is the size of the cache in bytes.
+*
+* @return
+*		- XST_SUCCESS if the service was initialized.
+*		- XST_INVALID_PARAM if the catalog is empty or too large, an
+*		entry is empty, or the cache is misaligned or can not hold
+*		the largest entry.
+*
+* @note		The PL has to hold its full configuration, with the partial
+*		regions, before the first XDcfg_PrLoad().
+*
+*****************************************************************************/
+s32 XDcfg_PrInitialize(XDcfg_Pr *PrPtr, XDcfg *InstancePtr,
+		       const XDcfg_PrImage *Catalog, u32 ImageCount,
+		       XDcfg_PrReadFn ReadFn, void *ReadRef,
+		       UINTPTR CacheAddr, u32 CacheSize)
+{
+	u32 Index;
+	u32 MaxWords = 0U;
+	u32 SlotSize;
+	u32 SlotCount;
+
+	/*
+	 * Assert the arguments.
+	 */
+	Xil_AssertNonvoid(PrPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Catalog != NULL);
+	Xil_AssertNonvoid(ReadFn != NULL);
+
+	if ((ImageCount == 0U) || (ImageCount > XDCFG_PR_MAX_IMAGES) ||
+	    ((CacheAddr & (XDCFG_PR_SLOT_ALIGN - 1U)) != 0U)) {
+		return XST_INVALID_PARAM;
+	}
+
+	for (Index = 0U; Index < ImageCount; Index++) {
+		if ((Catalog[Index].WordLength == 0U) ||
+		    (Catalog[Index].WordLength > XDCFG_PR_MAX_WORDS)) {
+			return XST_INVALID_PARAM;
+		}
+		if (Catalog[Index].WordLength > MaxWords) {
+			MaxWords = Catalog[Index].WordLength;
+		}
+	}
+
+	SlotSize = ((MaxWords << 2) + XDCFG_PR_SLOT_ALIGN - 1U) &
+		   ~(XDCFG_PR_SLOT_ALIGN - 1U);
+	SlotCount = CacheSize / SlotSize;
+	if (SlotCount == 0U) {
+		return XST_INVALID_PARAM;
+	}
+	if (SlotCount > XDCFG_PR_MAX_SLOTS) {
+		SlotCount = XDCFG_PR_MAX_SLOTS;
+	}
+
+	(void)memset(PrPtr, 0, sizeof(XDcfg_Pr));
+	PrPtr->DcfgPtr = InstancePtr;
+	PrPtr->Catalog = Catalog;
+	PrPtr->ImageCount = ImageCount;
+	PrPtr->ReadFn = ReadFn;
+	PrPtr->ReadRef = ReadRef;
+	PrPtr->CacheAddr = CacheAddr;
+	PrPtr->SlotSize = SlotSize;
+	PrPtr->SlotCount = SlotCount;
+	PrPtr->Current = XDCFG_PR_NONE;
+	for (Index = 0U; Index < XDCFG_PR_MAX_SLOTS; Index++) {
+		PrPtr->SlotImage[Index] = XDCFG_PR_NONE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function downloads a partial bitstream to the PL. The bitstream is
+* read into the cache first if it is not cached. Only the partial region
+* is reconfigured, PROG_B, the level shifters and the PL resets are left as
+* they are.
+*
+* @param	PrPtr is a pointer to the XDcfg_Pr instance.
+* @param	ImageId is the catalog index of the bitstream.
+*
+* @return
+*		- XST_SUCCESS if the partial region was reconfigured.
+*		- XST_DEVICE_BUSY if a PCAP DMA is in progress.
+*		- XST_FAILURE if the storage read failed, or PCAP flagged an
+*		error or timed out. The partial region is then in an
+*		unknown state.
+*
+* @note		Blocks until PCAP reports DMA and PL done. The swap latency,
+*		split into storage read and PCAP download, is added to the
+*		statistics.
+*
+*****************************************************************************/
+s32 XDcfg_PrLoad(XDcfg_Pr *PrPtr, u32 ImageId)
+{
+	XTime StartTime = 0;
+	XTime ReadTime = 0;
+	XTime EndTime = 0;
+	u32 Slot;
+	u32 Prev;
+	u32 Index;
+	u64 Counts;
+	s32 Status;
+
+	/*
+	 * Assert the arguments.
+	 */
+	Xil_AssertNonvoid(PrPtr != NULL);
+	Xil_AssertNonvoid(ImageId < PrPtr->ImageCount);
+
+	XTime_GetTime(&StartTime);
+
+	Slot = XDcfg_PrFindSlot(PrPtr, ImageId);
+	if (Slot == XDCFG_PR_NONE) {
+		Status = XDcfg_PrFill(PrPtr, ImageId, &Slot);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+		PrPtr->Stats.Misses++;
+	} else {
+		PrPtr->Stats.Hits++;
+		if ((PrPtr->PrefetchMask & ((u32)1U << Slot)) != 0U) {
+			PrPtr->Stats.PrefetchHits++;
+		}
+	}
+	PrPtr->PrefetchMask &= ~((u32)1U << Slot);
+	PrPtr->UseCount++;
+	PrPtr->SlotUse[Slot] = PrPtr->UseCount;
+
+	XTime_GetTime(&ReadTime);
+
+	Status = XDcfg_PrDownload(PrPtr->DcfgPtr,
+				  PrPtr->CacheAddr + (Slot * PrPtr->SlotSize),
+				  PrPtr->Catalog[ImageId].WordLength);
+
+	XTime_GetTime(&EndTime);
+
+	Prev = PrPtr->Current;
+	if (Status != XST_SUCCESS) {
+		PrPtr->Current = XDCFG_PR_NONE;
+		return Status;
+	}
+
+	/*
+	 * Count the swap for the prediction, the row is halved when a count
+	 * saturates so that it follows changes of the swap pattern
+	 */
+	if ((Prev != XDCFG_PR_NONE) && (Prev != ImageId)) {
+		if (PrPtr->Transitions[Prev][ImageId] == 0xFFFFU) {
+			for (Index = 0U; Index < PrPtr->ImageCount; Index++) {
+				PrPtr->Transitions[Prev][Index] >>= 1;
+			}
+		}
+		PrPtr->Transitions[Prev][ImageId]++;
+	}
+	PrPtr->Current = ImageId;
+
+	Counts = (u64)(EndTime - StartTime);
+	PrPtr->Stats.Swaps++;
+	PrPtr->Stats.LastCounts = Counts;
+	PrPtr->Stats.LastReadCounts = (u64)(ReadTime - StartTime);
+	PrPtr->Stats.LastPcapCounts = (u64)(EndTime - ReadTime);
+	PrPtr->Stats.TotalCounts += Counts;
+	if (Counts > PrPtr->Stats.MaxCounts) {
+		PrPtr->Stats.MaxCounts = Counts;
+	}
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function reads a partial bitstream into the cache, if it is not
+* cached yet, so that a later XDcfg_PrLoad() does not wait for the storage.
+*
+* @param	PrPtr is a pointer to the XDcfg_Pr instance.
+* @param	ImageId is the catalog index of the bitstream.
+*
+* @return
+*		- XST_SUCCESS if the bitstream is cached.
+*		- XST_FAILURE if the storage read failed.
+*
+* @note		Evicts the least recently used bitstream if the cache is
+*		full.
+*
+*****************************************************************************/
+s32 XDcfg_PrPreload(XDcfg_Pr *PrPtr, u32 ImageId)
+{
+	u32 Slot;
+
+	/*
+	 * Assert the arguments.
+	 */
+	Xil_AssertNonvoid(PrPtr != NULL);
+	Xil_AssertNonvoid(ImageId < PrPtr->ImageCount);
+
+	if (XDcfg_PrFindSlot(PrPtr, ImageId) != XDCFG_PR_NONE) {
+		return XST_SUCCESS;
+	}
+
+	return XDcfg_PrFill(PrPtr, ImageId, &Slot);
+}
+
+/****************************************************************************/
+/**
+*
+* This function returns the most likely next partial bitstream, the one
+* most often swapped in after the bitstream currently in the PL.
+*
+* @param	PrPtr is a pointer to the XDcfg_Pr instance.
+*
+* @return	Catalog index of the bitstream, XDCFG_PR_NONE if no swap
+*		from the current bitstream was seen yet.
+*
+* @note		None.
+*
+*****************************************************************************/
+u32 XDcfg_PrPredict(XDcfg_Pr *PrPtr)
+{
+	u32 Index;
+	u32 Best = XDCFG_PR_NONE;
+	u32 BestCount = 0U;
+
+	/*
+	 * Assert the arguments.
+	 */
+	Xil_AssertNonvoid(PrPtr != NULL);
+
+	if (PrPtr->Current == XDCFG_PR_NONE) {
+		return XDCFG_PR_NONE;
+	}
+
+	for (Index = 0U; Index < PrPtr->ImageCount; Index++) {
+		if (PrPtr->Transitions[PrPtr->Current][Index] > BestCount) {
+			BestCount = PrPtr->Transitions[PrPtr->Current][Index];
+			Best = Index;
+		}
+	}
+
+	return Best;
+}
+
+/****************************************************************************/
+/**
+*
+* This function reads the most likely next partial bitstream into the
+* cache. Call it when the application can spare the storage read time, for
+* example right after a swap while the new accelerator is running.
+*
+* @param	PrPtr is a pointer to the XDcfg_Pr instance.
+*
+* @return
+*		- XST_SUCCESS if the predicted bitstream is cached or there is
+*		no prediction.
+*		- XST_FAILURE if the storage read failed.
+*
+* @note		None.
+*
+*****************************************************************************/
+s32 XDcfg_PrPrefetch(XDcfg_Pr *PrPtr)
+{
+	u32 ImageId;
+	u32 Slot;
+	s32 Status;
+
+	ImageId = XDcfg_PrPredict(PrPtr);
+	if ((ImageId == XDCFG_PR_NONE) ||
+	    (XDcfg_PrFindSlot(PrPtr, ImageId) != XDCFG_PR_NONE)) {
+		return XST_SUCCESS;
+	}
+
+	Status = XDcfg_PrFill(PrPtr, ImageId, &Slot);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	PrPtr->PrefetchMask |= (u32)1U << Slot;
+	PrPtr->Stats.Prefetches++;
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function returns the swap statistics.
+*
+* @param	PrPtr is a pointer to the XDcfg_Pr instance.
+* @param	StatsPtr is filled with the statistics.
+* @param	Clear clears the statistics after they are returned if set.
+*
+* @return	None.
+*
+* @note		Divide the counts by COUNTS_PER_SECOND for seconds.
+*
+*****************************************************************************/
+void XDcfg_PrGetStats(XDcfg_Pr *PrPtr, XDcfg_PrStats *StatsPtr,
+		      u32 Clear)
+{
+	/*
+	 * Assert the arguments.
+	 */
+	Xil_AssertVoid(PrPtr != NULL);
+	Xil_AssertVoid(StatsPtr != NULL);
+
+	*StatsPtr = PrPtr->Stats;
+	if (Clear != 0U) {
+		(void)memset(&PrPtr->Stats, 0, sizeof(XDcfg_PrStats));
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* This function looks up the cache slot of a partial bitstream.
+*
+* @param	PrPtr is a pointer to the XDcfg_Pr instance.
+* @param	ImageId is the catalog index of the bitstream.
+*
+* @return	Slot index, XDCFG_PR_NONE if the bitstream is not cached.
+*
+* @note		None.
+*
+*****************************************************************************/
+static u32 XDcfg_PrFindSlot(XDcfg_Pr *PrPtr, u32 ImageId)
+{
+	u32 Slot;
+
+	for (Slot = 0U; Slot < PrPtr->SlotCount; Slot++) {
+		if (PrPtr->SlotImage[Slot] == ImageId) {
+			return Slot;
+		}
+	}
+
+	return XDCFG_PR_NONE;
+}
+
+/****************************************************************************/
+/**
+*
+* This function reads a partial bitstream into a free or the least recently
+* used cache slot and flushes it from the data cache for the PCAP DMA.
+*
+* @param	PrPtr is a pointer to the XDcfg_Pr instance.
+* @param	ImageId is the catalog index of the bitstream.
+* @param	SlotPtr returns the slot index.
+*
+* @return
+*		- XST_SUCCESS if the bitstream was read.
+*		- XST_FAILURE if the storage read failed, the slot is free
+*		then.
+*
+* @note		None.
+*
+*****************************************************************************/
+static s32 XDcfg_PrFill(XDcfg_Pr *PrPtr, u32 ImageId, u32 *SlotPtr)
+{
+	const XDcfg_PrImage *ImagePtr = &PrPtr->Catalog[ImageId];
+	UINTPTR Addr;
+	u32 Slot;
+	u32 Victim = 0U;
+	u32 Bytes = ImagePtr->WordLength << 2;
+	s32 Status;
+
+	for (Slot = 0U; Slot < PrPtr->SlotCount; Slot++) {
+		if (PrPtr->SlotImage[Slot] == XDCFG_PR_NONE) {
+			Victim = Slot;
+			break;
+		}
+		if (PrPtr->SlotUse[Slot] < PrPtr->SlotUse[Victim]) {
+			Victim = Slot;
+		}
+	}
+
+	Addr = PrPtr->CacheAddr + (Victim * PrPtr->SlotSize);
+	PrPtr->SlotImage[Victim] = XDCFG_PR_NONE;
+	PrPtr->PrefetchMask &= ~((u32)1U << Victim);
+
+	Status = PrPtr->ReadFn(PrPtr->ReadRef, ImagePtr->Offset, (u8 *)Addr,
+			       Bytes);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	Xil_DCacheFlushRange((INTPTR)Addr, Bytes);
+
+	PrPtr->SlotImage[Victim] = ImageId;
+	PrPtr->UseCount++;
+	PrPtr->SlotUse[Victim] = PrPtr->UseCount;
+	*SlotPtr = Victim;
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function downloads a partial bitstream through PCAP and waits for
+* DMA and PL done.
+*
+* @param	InstancePtr is a pointer to the XDcfg instance.
+* @param	Addr is the bitstream in DDR.
+* @param	WordLength is the bitstream length in words.
+*
+* @return
+*		- XST_SUCCESS if the bitstream was downloaded.
+*		- XST_DEVICE_BUSY if a PCAP DMA is in progress.
+*		- XST_FAILURE if PCAP flagged an error or timed out.
+*
+* @note		PCFG_DONE stays set from the full configuration, D_P_DONE
+*		marks the end of a partial bitstream.
+*
+*****************************************************************************/
+static s32 XDcfg_PrDownload(XDcfg *InstancePtr, UINTPTR Addr,
+			    u32 WordLength)
+{
+	u32 IntrStsReg;
+	u32 Count = XDCFG_PR_POLL_COUNT;
+	u32 Status;
+
+	/*
+	 * Select PCAP for the partial reconfiguration, no other control bit
+	 * changes
+	 */
+	XDcfg_SetControlRegister(InstancePtr, XDCFG_CTRL_PCAP_PR_MASK |
+				 XDCFG_CTRL_PCAP_MODE_MASK);
+
+	XDcfg_IntrClear(InstancePtr, XDCFG_IXR_DMA_DONE_MASK |
+			XDCFG_IXR_D_P_DONE_MASK | XDCFG_IXR_ERROR_FLAGS_MASK);
+
+	Status = XDcfg_Transfer(InstancePtr,
+				(void *)(Addr | XDCFG_PR_DMA_LAST), WordLength,
+				(void *)(UINTPTR)XDCFG_DMA_INVALID_ADDRESS,
+				WordLength, XDCFG_NON_SECURE_PCAP_WRITE);
+	if (Status != (u32)XST_SUCCESS) {
+		return (Status == (u32)XST_DEVICE_BUSY) ?
+		       XST_DEVICE_BUSY : XST_FAILURE;
+	}
+
+	do {
+		IntrStsReg = XDcfg_IntrGetStatus(InstancePtr);
+		if ((IntrStsReg & XDCFG_IXR_ERROR_FLAGS_MASK) != 0U) {
+			return XST_FAILURE;
+		}
+		Count--;
+		if (Count == 0U) {
+			return XST_FAILURE;
+		}
+	} while ((IntrStsReg & XDCFG_IXR_D_P_DONE_MASK) == 0U);
+
+	XDcfg_IntrClear(InstancePtr, XDCFG_IXR_DMA_DONE_MASK |
+			XDCFG_IXR_D_P_DONE_MASK);
+
+	return XST_SUCCESS;
+}
+/** @} */
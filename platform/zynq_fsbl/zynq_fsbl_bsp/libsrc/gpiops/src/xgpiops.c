@@ -39,6 +39,8 @@
 * 3.13  gm   03/15/24 Added multi-core interrupt support.
 * 3.14  bkv  02/20/25 Changed data type of effective address from u32 to
 *                     UINTPTR to support both 32-bit and 64-bit platforms.
+* 3.15  pt   10/19/26 Initialize the per pin handler table, the edge ring
+*                     and the first pin of each bank.
 *
 * </pre>
 *
@@ -85,6 +87,9 @@ s32 XGpioPs_CfgInitialize(XGpioPs *InstancePtr, const XGpioPs_Config *ConfigPtr,
 {
 	s32 Status = (s32)0;
 	u8 i;
+	u32 Pin;
+	u8 Bank;
+	u8 PinNumber;
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(ConfigPtr != NULL);
 	Xil_AssertNonvoid(EffectiveAddr != (u32)0);
@@ -99,6 +104,12 @@ s32 XGpioPs_CfgInitialize(XGpioPs *InstancePtr, const XGpioPs_Config *ConfigPtr,
 #endif
 	InstancePtr->Handler = (XGpioPs_Handler)StubHandler;
 	InstancePtr->Platform = XGetPlatform_Info();
+	InstancePtr->PinTable = NULL;
+	InstancePtr->EdgeRing = NULL;
+	InstancePtr->EdgeRingMask = 0U;
+	InstancePtr->EdgeHead = 0U;
+	InstancePtr->EdgeTail = 0U;
+	InstancePtr->EdgeDropped = 0U;
 
 	/* Initialize the Bank data based on platform */
 	if (InstancePtr->Platform == (u32)XPLAT_ZYNQ_ULTRA_MP) {
@@ -186,6 +197,18 @@ s32 XGpioPs_CfgInitialize(XGpioPs *InstancePtr, const XGpioPs_Config *ConfigPtr,
 		InstancePtr->CoreIntrMask[i] = 0;
 	}
 
+	/* First pin of each bank, to turn a status bit into a pin number */
+	for (Pin = 0U; Pin < InstancePtr->MaxPinNum; Pin++) {
+#ifdef versal
+		XGpioPs_GetBankPin(InstancePtr, (u8)Pin, &Bank, &PinNumber);
+#else
+		XGpioPs_GetBankPin((u8)Pin, &Bank, &PinNumber);
+#endif
+		if (PinNumber == (u8)0) {
+			InstancePtr->BankPinBase[Bank] = (u8)Pin;
+		}
+	}
+
 	/* Indicate the component is now ready to use. */
 	InstancePtr->IsReady = XIL_COMPONENT_IS_READY;
 
@@ -102,6 +102,7 @@
 * 4.3   ap     11/29/23 Add support for Sanitize feature.
 * 4.3   ap     12/22/23 Add support to read custom HS400 tap delay value from design for eMMC.
 * 4.4   ht     09/30/24 Fix IAR warnings.
+* 4.6   pt     10/19/26 Added XSdPs_SetWrBlkEraseCount.
 *
 * </pre>
 *
@@ -137,6 +138,7 @@ extern "C" {
 #define XSDPS_ACMD41_3V3	0x00300000U	/**< 3.3 voltage support */
 #define XSDPS_CMD1_HIGH_VOL	0x00FF8000U	/**< CMD1 for High voltage */
 #define XSDPS_CMD1_DUAL_VOL	0x00FF8010U	/**< CMD1 for Dual voltage */
+#define XSDPS_ACMD23_BLKCNT_MASK	0x007FFFFFU	/**< ACMD23 block count */
 #define HIGH_SPEED_SUPPORT	0x2U		/**< High Speed support */
 #define UHS_SDR12_SUPPORT	0x1U		/**< SDR12 support */
 #define UHS_SDR25_SUPPORT	0x2U		/**< SDR25 support */
@@ -340,6 +342,7 @@ s32 XSdPs_StartReadTransfer(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff);
 s32 XSdPs_CheckReadTransfer(XSdPs *InstancePtr);
 s32 XSdPs_StartWriteTransfer(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff);
 s32 XSdPs_CheckWriteTransfer(XSdPs *InstancePtr);
+s32 XSdPs_SetWrBlkEraseCount(XSdPs *InstancePtr, u32 BlkCnt);
 s32 XSdPs_Erase(XSdPs *InstancePtr, u32 StartAddr, u32 EndAddr);
 s32 XSdPs_Sanitize(XSdPs *InstancePtr);
 
@@ -41,12 +41,20 @@
 * 	sa     01/25/23 Use instance structure to store DMA descriptor tables.
 * 4.2   ap     08/09/23 Restructured XSdPs_FrameCmd API
 * 4.3   ap     12/22/23 Add support to read custom HS400 tap delay value from design for eMMC.
+* 4.5   pt     10/19/26 Skip cache maintenance for DMA pool buffers.
+*       pt     10/19/26 Wait for transfer complete in WFI if XSDPS_WFI_WAIT
+*                       is defined.
+* 4.6   pt     10/19/26 CMD23 and ACMD23 have no data phase.
 * </pre>
 *
 ******************************************************************************/
 
 /***************************** Include Files *********************************/
 #include "xsdps_core.h"
+#if defined (XSDPS_WFI_WAIT) && defined (PLATFORM_ZYNQ) && !defined (__aarch64__)
+#include "xil_wait.h"
+#define XSDPS_WAIT_WFI
+#endif
 
 /************************** Constant Definitions *****************************/
 
@@ -56,6 +64,24 @@
 
 /************************** Function Prototypes ******************************/
 
+#ifdef XSDPS_WAIT_WFI
+/*****************************************************************************/
+/**
+* @brief
+* Returns the GIC interrupt id of the controller.
+*
+* @param	InstancePtr Pointer to the instance to be worked on.
+*
+* @return	Interrupt id.
+*
+******************************************************************************/
+static u32 XSdPs_GetIntrId(const XSdPs *InstancePtr)
+{
+	return (InstancePtr->Config.BaseAddress == XPS_SDIO0_BASEADDR) ?
+	       XPS_SDIO0_INT_ID : XPS_SDIO1_INT_ID;
+}
+#endif
+
 #if defined (__aarch64__) && (EL1_NONSECURE == 1)
 void XSdps_Smc(XSdPs *InstancePtr, u32 RegOffset, u32 Mask, u32 Val)
 {
@@ -989,7 +1015,8 @@ void XSdPs_SetupReadDma(XSdPs *InstancePtr, u16 BlkCnt, u16 BlkSize, u8 *Buff)
 		XSdPs_SetupADMA2DescTbl64Bit(InstancePtr, BlkCnt);
 	} else {
 		XSdPs_SetupADMA2DescTbl(InstancePtr, BlkCnt, Buff);
-		if (InstancePtr->Config.IsCacheCoherent == 0U) {
+		if ((InstancePtr->Config.IsCacheCoherent == 0U) &&
+		    (XSDPS_BUF_IS_COHERENT(Buff) == 0U)) {
 			Xil_DCacheInvalidateRange((INTPTR)Buff,
 						  ((INTPTR)BlkCnt * (INTPTR)BlkSize));
 		}
@@ -1033,8 +1060,13 @@ void XSdPs_SetupWriteDma(XSdPs *InstancePtr, u16 BlkCnt, u16 BlkSize, const u8 *
 	} else {
 		XSdPs_SetupADMA2DescTbl(InstancePtr, BlkCnt, Buff);
 		if (InstancePtr->Config.IsCacheCoherent == 0U) {
-			Xil_DCacheFlushRange((INTPTR)Buff,
-					     ((INTPTR)BlkCnt * (INTPTR)BlkSize));
+			if (XSDPS_BUF_IS_COHERENT(Buff) == 0U) {
+				Xil_DCacheFlushRange((INTPTR)Buff,
+						     ((INTPTR)BlkCnt * (INTPTR)BlkSize));
+			} else {
+				/* Order the CPU writes before the DMA start */
+				dsb();
+			}
 		}
 	}
 
@@ -1642,8 +1674,27 @@ s32 XSdps_CheckTransferDone(XSdPs *InstancePtr)
 	 * Polling for response for now
 	 */
 	Mask = XSDPS_INTR_ERR_MASK | XSDPS_INTR_TC_MASK;
+#ifdef XSDPS_WAIT_WFI
+	/*
+	 * Signal transfer complete and errors to the GIC for the duration
+	 * of the wait so that the core sleeps until the transfer is done
+	 */
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			 XSDPS_NORM_INTR_SIG_EN_OFFSET, (u16)Mask);
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			 XSDPS_ERR_INTR_SIG_EN_OFFSET, XSDPS_ERROR_INTR_ALL_MASK);
+	Status = (s32)Xil_WaitForEventsWfi(InstancePtr->Config.BaseAddress +
+					   XSDPS_NORM_INTR_STS_OFFSET, Mask, Mask,
+					   Timeout, &StatusReg,
+					   XSdPs_GetIntrId(InstancePtr));
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			 XSDPS_NORM_INTR_SIG_EN_OFFSET, 0x0U);
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			 XSDPS_ERR_INTR_SIG_EN_OFFSET, 0x0U);
+#else
 	Status = Xil_WaitForEvents(InstancePtr->Config.BaseAddress + XSDPS_NORM_INTR_STS_OFFSET,
 				   Mask, Mask, Timeout, &StatusReg);
+#endif
 	if (Status != XST_SUCCESS) {
 		Status = XST_FAILURE;
 		goto RETURN_PATH;
@@ -1768,6 +1819,8 @@ u32 XSdPs_FrameCmd(XSdPs *InstancePtr, u32 Cmd)
 		case CMD33:
 		case CMD35:
 		case CMD36:
+		case CMD23:
+		case ACMD23:
 		case ACMD42:
 		case CMD52:
 		case CMD55:
@@ -1785,8 +1838,6 @@ u32 XSdPs_FrameCmd(XSdPs *InstancePtr, u32 Cmd)
 		case CMD18:
 		case CMD19:
 		case CMD21:
-		case CMD23:
-		case ACMD23:
 		case CMD24:
 		case CMD25:
 		case ACMD51:
@@ -27,6 +27,7 @@
 *			  implementation. Now sleep routines will use Timer
 *                         specified by the user (i.e. Global timer/TTC timer)
 * 9.0   ml       03/03/23 Added description to fix doxygen warnings.
+* 9.3   pt       10/19/26 Sleep in WFI when XIL_WAIT_WFI_SLEEP is defined.
 * </pre>
 *
 ******************************************************************************/
@@ -38,6 +39,9 @@
 #include "xil_types.h"
 #include "xpseudo_asm.h"
 #include "xreg_cortexa9.h"
+#ifdef XIL_WAIT_WFI_SLEEP
+#include "xil_wait.h"
+#endif
 
 #if defined (SLEEP_TIMER_BASEADDR)
 #include "xil_sleeptimer.h"
@@ -68,6 +72,8 @@ int usleep_A9(unsigned long useconds)
 {
 #if defined (SLEEP_TIMER_BASEADDR)
 	Xil_SleepTTCCommon(useconds, COUNTS_PER_USECOND);
+#elif defined (XIL_WAIT_WFI_SLEEP)
+	Xil_WaitUs((u64)useconds);
 #else
 	XTime tEnd, tCur;
 
@@ -0,0 +1,79 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+* @file xil_cpuclk.c
+*
+* This file contains the CPU clock divisor APIs. For more information see
+* xil_cpuclk.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- ---------------------------------------------------
+* 9.3   pt   10/19/26 Initial version
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xil_cpuclk.h"
+#include "xil_misc_psreset_api.h"
+#include "xil_io.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions *****************************/
+
+/* Divisor field of ARM_CLK_CTRL */
+#define XIL_CPUCLK_DIVISOR_MASK		0x00003F00U
+#define XIL_CPUCLK_DIVISOR_SHIFT	8U
+
+/*****************************************************************************/
+/**
+* @brief	Changes the divisor of the CPU clock. The clock source is not
+*		changed.
+*
+* @param	Divisor: New divisor, 1 to XIL_CPUCLK_DIVISOR_MAX.
+*
+* @return	XST_SUCCESS, or XST_INVALID_PARAM if the divisor is out of
+*		range.
+*
+* @note		The SLCR is left unlocked.
+*
+******************************************************************************/
+s32 Xil_CpuClkSetDivisor(u32 Divisor)
+{
+	u32 RegVal;
+
+	if ((Divisor == 0U) || (Divisor > XIL_CPUCLK_DIVISOR_MAX)) {
+		return XST_INVALID_PARAM;
+	}
+
+	/* Unlock the slcr register access lock */
+	Xil_Out32(XSLCR_UNLOCK_ADDR, XSLCR_UNLOCK_CODE);
+
+	RegVal = Xil_In32(XSLCR_ARM_CLK_CTRL_ADDR);
+	RegVal &= (u32)(~XIL_CPUCLK_DIVISOR_MASK);
+	RegVal |= (Divisor << XIL_CPUCLK_DIVISOR_SHIFT);
+	Xil_Out32(XSLCR_ARM_CLK_CTRL_ADDR, RegVal);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Returns the divisor of the CPU clock.
+*
+* @return	Divisor programmed in ARM_CLK_CTRL.
+*
+******************************************************************************/
+u32 Xil_CpuClkGetDivisor(void)
+{
+	return (Xil_In32(XSLCR_ARM_CLK_CTRL_ADDR) & XIL_CPUCLK_DIVISOR_MASK) >>
+		XIL_CPUCLK_DIVISOR_SHIFT;
+}
@@ -0,0 +1,298 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+* @file xil_dmapool.c
+*
+* This file contains the DMA buffer pool. For more information see
+* xil_dmapool.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- ---------------------------------------------------
+* 9.3   pt   10/19/26 Initial version
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xil_dmapool.h"
+#include "xil_mmu.h"
+#include "xpseudo_asm.h"
+#include "xstatus.h"
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/**************************** Type Definitions *******************************/
+
+/************************** Constant Definitions *****************************/
+
+#define IRQ_FIQ_MASK		0xC0U	/**< Mask IRQ and FIQ interrupts in cpsr */
+#define DMAPOOL_PAGE_SIZE	((u32)1U << XIL_DMAPOOL_PAGE_SHIFT)
+#define DMAPOOL_NO_CLASS	0xFFU
+#define DMAPOOL_CONT_PAGE	0xFEU	/* Second and later page of a buffer */
+
+/************************** Variable Definitions *****************************/
+
+static UINTPTR ArenaBase;
+static u32 ArenaPages;
+static u32 ArenaNext;			/* First page not owned by a class */
+
+static void *FreeList[XIL_DMAPOOL_CLASSES];
+static UINTPTR SlabNext[XIL_DMAPOOL_CLASSES];	/* Uncarved part of the last page */
+static UINTPTR SlabEnd[XIL_DMAPOOL_CLASSES];
+static u8 PageClass[XIL_DMAPOOL_MAX_PAGES];
+
+static Xil_DmaPoolStats PoolStats;
+
+/************************** Function Prototypes ******************************/
+
+/*****************************************************************************/
+/**
+* @brief	Returns the size class of a request.
+*
+* @param	Size is the requested size, 1 to XIL_DMAPOOL_MAX_SIZE.
+*
+* @return	Size class index.
+*
+******************************************************************************/
+static inline u32 DmaPoolClass(u32 Size)
+{
+	u32 Shift;
+
+	if (Size <= XIL_DMAPOOL_MIN_SIZE) {
+		return 0U;
+	}
+#ifdef __GNUC__
+	Shift = 32U - (u32)clz(Size - 1U);
+#else
+	Shift = XIL_DMAPOOL_MIN_SHIFT;
+	while (((u32)1U << Shift) < Size) {
+		Shift++;
+	}
+#endif
+
+	return Shift - XIL_DMAPOOL_MIN_SHIFT;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Sets up the pool on an arena and maps it for DMA.
+*
+* @param	Arena is a 4 KB aligned buffer used for all pool allocations,
+*			or NULL to allocate it with Xil_MmuDmaAlloc.
+* @param	Size is the arena size, a multiple of 4 KB of at most
+*			XIL_DMAPOOL_MAX_PAGES pages.
+* @param	Type is XIL_DMAPOOL_NONCACHEABLE or XIL_DMAPOOL_ACP.
+*
+* @return
+*		- XST_SUCCESS if the pool is ready.
+*		- XST_INVALID_PARAM for a bad arena or type.
+*		- XST_FAILURE if the arena could not be allocated or mapped.
+*
+* @note		Must be called once, before any driver uses pool buffers. The
+*			arena must not be in use by anything else.
+*
+******************************************************************************/
+s32 Xil_DmaPoolInit(void *Arena, u32 Size, u32 Type)
+{
+	u32 attrib;
+	u32 Index;
+
+	if ((Size == 0U) || ((Size & (DMAPOOL_PAGE_SIZE - 1U)) != 0U) ||
+	    ((Size >> XIL_DMAPOOL_PAGE_SHIFT) > XIL_DMAPOOL_MAX_PAGES) ||
+	    (((UINTPTR)Arena & (DMAPOOL_PAGE_SIZE - 1U)) != 0U) ||
+	    ((Type != XIL_DMAPOOL_NONCACHEABLE) && (Type != XIL_DMAPOOL_ACP))) {
+		return XST_INVALID_PARAM;
+	}
+
+	attrib = (Type == XIL_DMAPOOL_NONCACHEABLE) ? XIL_MMU_DMA_WRITE_COMBINE :
+		 XIL_MMU_DMA_CACHEABLE;
+
+	if (Arena == NULL) {
+		Arena = Xil_MmuDmaAlloc(Size, attrib);
+		if (Arena == NULL) {
+			return XST_FAILURE;
+		}
+	} else if (Xil_SetPageAttributes((UINTPTR)Arena, Size, attrib) !=
+		   XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	ArenaBase = (UINTPTR)Arena;
+	ArenaPages = Size >> XIL_DMAPOOL_PAGE_SHIFT;
+	ArenaNext = 0U;
+	for (Index = 0U; Index < XIL_DMAPOOL_MAX_PAGES; Index++) {
+		PageClass[Index] = DMAPOOL_NO_CLASS;
+	}
+	for (Index = 0U; Index < XIL_DMAPOOL_CLASSES; Index++) {
+		FreeList[Index] = NULL;
+		SlabNext[Index] = 0U;
+		SlabEnd[Index] = 0U;
+		PoolStats.InUse[Index] = 0U;
+		PoolStats.Peak[Index] = 0U;
+		PoolStats.Pages[Index] = 0U;
+	}
+	PoolStats.Allocs = 0U;
+	PoolStats.Frees = 0U;
+	PoolStats.Failures = 0U;
+	PoolStats.PagesFree = ArenaPages;
+	PoolStats.PagesTotal = ArenaPages;
+
+	if (Type == XIL_DMAPOOL_NONCACHEABLE) {
+		XilDmaPoolCoherentBase = ArenaBase;
+		XilDmaPoolCoherentSize = Size;
+	} else {
+		XilDmaPoolCoherentBase = 0U;
+		XilDmaPoolCoherentSize = 0U;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Allocates a DMA buffer.
+*
+* @param	Size is the buffer size in bytes, at most XIL_DMAPOOL_MAX_SIZE.
+*
+* @return	Buffer aligned to its class size (at least a cache line, at
+*			most 4 KB), NULL if the size is invalid or the arena is
+*			exhausted.
+*
+* @note		Safe to call from interrupt context.
+*
+******************************************************************************/
+void *Xil_DmaPoolAlloc(u32 Size)
+{
+	u32 Class;
+	u32 ClassSize;
+	u32 Pages;
+	u32 Page;
+	u32 currmask;
+	void *Buf = NULL;
+
+	currmask = mfcpsr();
+	mtcpsr(currmask | IRQ_FIQ_MASK);
+
+	if ((Size == 0U) || (Size > XIL_DMAPOOL_MAX_SIZE)) {
+		PoolStats.Failures++;
+		mtcpsr(currmask);
+		return NULL;
+	}
+	Class = DmaPoolClass(Size);
+	ClassSize = XIL_DMAPOOL_MIN_SIZE << Class;
+
+	if (FreeList[Class] != NULL) {
+		Buf = FreeList[Class];
+		FreeList[Class] = *(void **)Buf;
+	} else {
+		if (SlabNext[Class] == SlabEnd[Class]) {
+			/* Hand the next arena page(s) to this class */
+			Pages = (ClassSize > DMAPOOL_PAGE_SIZE) ?
+				(ClassSize >> XIL_DMAPOOL_PAGE_SHIFT) : 1U;
+			if ((ArenaNext + Pages) <= ArenaPages) {
+				PageClass[ArenaNext] = (u8)Class;
+				for (Page = ArenaNext + 1U; Page < (ArenaNext + Pages); Page++) {
+					PageClass[Page] = DMAPOOL_CONT_PAGE;
+				}
+				SlabNext[Class] = ArenaBase +
+					((UINTPTR)ArenaNext << XIL_DMAPOOL_PAGE_SHIFT);
+				SlabEnd[Class] = SlabNext[Class] +
+					((UINTPTR)Pages << XIL_DMAPOOL_PAGE_SHIFT);
+				ArenaNext += Pages;
+				PoolStats.Pages[Class] += Pages;
+				PoolStats.PagesFree -= Pages;
+			}
+		}
+		if (SlabNext[Class] != SlabEnd[Class]) {
+			Buf = (void *)SlabNext[Class];
+			SlabNext[Class] += ClassSize;
+		}
+	}
+
+	if (Buf != NULL) {
+		PoolStats.Allocs++;
+		PoolStats.InUse[Class]++;
+		if (PoolStats.InUse[Class] > PoolStats.Peak[Class]) {
+			PoolStats.Peak[Class] = PoolStats.InUse[Class];
+		}
+	} else {
+		PoolStats.Failures++;
+	}
+
+	mtcpsr(currmask);
+
+	return Buf;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Returns a buffer to its size class.
+*
+* @param	Buf is a buffer returned by Xil_DmaPoolAlloc. NULL and
+*			addresses outside of the arena are ignored.
+*
+* @return	None.
+*
+* @note		Safe to call from interrupt context.
+*
+******************************************************************************/
+void Xil_DmaPoolFree(void *Buf)
+{
+	UINTPTR Offset = (UINTPTR)Buf - ArenaBase;
+	u32 Page = (u32)(Offset >> XIL_DMAPOOL_PAGE_SHIFT);
+	u32 Class;
+	u32 Align;
+	u32 currmask;
+
+	if ((Buf == NULL) || (Page >= ArenaPages)) {
+		return;
+	}
+	Class = PageClass[Page];
+	if (Class >= XIL_DMAPOOL_CLASSES) {
+		return;
+	}
+	Align = XIL_DMAPOOL_MIN_SIZE << Class;
+	if (Align > DMAPOOL_PAGE_SIZE) {
+		Align = DMAPOOL_PAGE_SIZE;
+	}
+	if ((Offset & (Align - 1U)) != 0U) {
+		return;
+	}
+
+	currmask = mfcpsr();
+	mtcpsr(currmask | IRQ_FIQ_MASK);
+
+	*(void **)Buf = FreeList[Class];
+	FreeList[Class] = Buf;
+	PoolStats.Frees++;
+	PoolStats.InUse[Class]--;
+
+	mtcpsr(currmask);
+}
+
+/*****************************************************************************/
+/**
+* @brief	Returns a copy of the pool usage statistics.
+*
+* @param	Stats is filled with the current statistics.
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_DmaPoolGetStats(Xil_DmaPoolStats *Stats)
+{
+	u32 currmask;
+
+	currmask = mfcpsr();
+	mtcpsr(currmask | IRQ_FIQ_MASK);
+	*Stats = PoolStats;
+	mtcpsr(currmask);
+}
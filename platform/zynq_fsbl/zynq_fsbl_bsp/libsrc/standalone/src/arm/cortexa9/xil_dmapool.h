@@ -0,0 +1,124 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+* @file xil_dmapool.h
+*
+* @addtogroup a9_dmapool_apis Cortex A9 DMA Buffer Pool Functions
+*
+* Size class allocator for DMA buffers. The pool owns one page aligned arena
+* which is mapped either
+* - non-cacheable (XIL_DMAPOOL_NONCACHEABLE): CPU accesses bypass the caches,
+*   so drivers of PS DMA masters (SD, PL330, USB) can skip the D-cache flush
+*   and invalidate around every transfer, or
+* - cacheable (XIL_DMAPOOL_ACP): buffers for PL masters connected to the
+*   ACP, which are coherent with the CPU caches by hardware. PS masters are
+*   not behind the ACP and still need cache maintenance for these buffers.
+*
+* Buffers come in power of two size classes from XIL_DMAPOOL_MIN_SIZE (one
+* cache line) to XIL_DMAPOOL_MAX_SIZE and are aligned to their class size,
+* or to 4 KB for the classes above one page.
+* Every class keeps a free list, allocation and release are O(1). Arena
+* pages are handed to a class on first demand and stay with it.
+*
+* Drivers check Xil_DmaPoolIsCoherent() before their cache maintenance, it
+* costs one subtraction and one compare and works before Xil_DmaPoolInit.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- ---------------------------------------------------
+* 9.3   pt   10/19/26 Initial version
+* </pre>
+*
+******************************************************************************/
+
+/**
+*@cond nocomments
+*/
+
+#ifndef XIL_DMAPOOL_H
+#define XIL_DMAPOOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/***************************** Include Files *********************************/
+
+#include "xil_types.h"
+
+/************************** Constant Definitions *****************************/
+
+/* Arena types */
+#define XIL_DMAPOOL_NONCACHEABLE	0x0U
+#define XIL_DMAPOOL_ACP			0x1U
+
+#define XIL_DMAPOOL_MIN_SHIFT	5U	/* 32 bytes, one cache line */
+#define XIL_DMAPOOL_MAX_SHIFT	14U	/* 16 KB */
+#define XIL_DMAPOOL_MIN_SIZE	((u32)1U << XIL_DMAPOOL_MIN_SHIFT)
+#define XIL_DMAPOOL_MAX_SIZE	((u32)1U << XIL_DMAPOOL_MAX_SHIFT)
+#define XIL_DMAPOOL_CLASSES	(XIL_DMAPOOL_MAX_SHIFT - XIL_DMAPOOL_MIN_SHIFT + 1U)
+
+#define XIL_DMAPOOL_PAGE_SHIFT	12U
+
+/* Largest arena in 4 KB pages */
+#ifndef XIL_DMAPOOL_MAX_PAGES
+#define XIL_DMAPOOL_MAX_PAGES	256U
+#endif
+
+/**************************** Type Definitions *******************************/
+
+typedef struct {
+	u32 Allocs;			/* Successful allocations */
+	u32 Frees;
+	u32 Failures;			/* Allocations which returned NULL */
+	u32 InUse[XIL_DMAPOOL_CLASSES];	/* Buffers currently allocated */
+	u32 Peak[XIL_DMAPOOL_CLASSES];	/* Highest InUse value seen */
+	u32 Pages[XIL_DMAPOOL_CLASSES];	/* Arena pages owned by a class */
+	u32 PagesFree;			/* Arena pages not owned by any class */
+	u32 PagesTotal;
+} Xil_DmaPoolStats;
+
+/************************** Variable Definitions *****************************/
+
+/* Range for which cache maintenance can be skipped, set by Xil_DmaPoolInit */
+extern UINTPTR XilDmaPoolCoherentBase;
+extern u32 XilDmaPoolCoherentSize;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/*
+ * Returns 1 if Addr lies in a non-cacheable pool arena, in which case the
+ * D-cache flush/invalidate before and after a PS DMA transfer is not needed.
+ * A dsb() before starting the transfer is still required.
+ */
+static inline u32 Xil_DmaPoolIsCoherent(UINTPTR Addr)
+{
+	return ((Addr - XilDmaPoolCoherentBase) < XilDmaPoolCoherentSize) ?
+		1U : 0U;
+}
+
+/**
+*@endcond
+*/
+
+/************************** Function Prototypes ******************************/
+
+s32 Xil_DmaPoolInit(void *Arena, u32 Size, u32 Type);
+void *Xil_DmaPoolAlloc(u32 Size);
+void Xil_DmaPoolFree(void *Buf);
+void Xil_DmaPoolGetStats(Xil_DmaPoolStats *Stats);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* XIL_DMAPOOL_H */
+/**
+* @} End of "addtogroup a9_dmapool_apis".
+*/
@@ -0,0 +1,120 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+* @file xil_startup.h
+*
+* @addtogroup a9_startup_apis Cortex A9 Startup APIs
+*
+* Helpers to shorten the time from reset to main.
+*
+* xil-crt0.S zeroes .sbss and .bss with eight register stores, one 32 byte
+* cache line per store. Large zero initialized objects that are not needed
+* before main, such as frame buffers or file system work areas, can be kept
+* out of .bss so that they are not zeroed at startup:
+* - XIL_NOINIT places an object in .noinit, which is never zeroed. The
+*   application initializes it.
+* - XIL_LAZY_BSS places an object in .lazy_bss, which is zeroed on first use
+*   by Xil_LazyZero, or as a whole by Xil_LazyBssZero.
+*
+* The linker script needs the two NOLOAD sections, placed before .bss:
+* <pre>
+* .noinit (NOLOAD) : {
+*    __noinit_start = .;
+*    *(.noinit)
+*    *(.noinit.*)
+*    *(.bss.xil_noinit)
+*    __noinit_end = .;
+* } > ps7_ddr_0_memory_0
+*
+* .lazy_bss (NOLOAD) : {
+*    . = ALIGN(32);
+*    __lazy_bss_start = .;
+*    *(.bss.xil_lazy)
+*    . = ALIGN(32);
+*    __lazy_bss_end = .;
+* } > ps7_ddr_0_memory_0
+* </pre>
+* Without them the objects end up in .bss and are zeroed at startup as
+* before.
+*
+* If XIL_STARTUP_TIMES is defined when the BSP is built, xil-crt0.S samples
+* the global timer at each startup phase, refer to Xil_StartupGetTimes.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- ---------------------------------------------------
+* 9.3   pt   10/19/26 Initial version
+* </pre>
+*
+******************************************************************************/
+
+/**
+*@cond nocomments
+*/
+
+#ifndef XIL_STARTUP_H
+#define XIL_STARTUP_H
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/************************** Constant Definitions *****************************/
+
+/* Startup phases sampled by xil-crt0.S */
+#define XIL_STARTUP_ENTRY	0U	/* _start, boot.S is done */
+#define XIL_STARTUP_CPU_INIT	1U	/* __cpu_init is done */
+#define XIL_STARTUP_BSS		2U	/* .sbss and .bss are zeroed */
+#define XIL_STARTUP_TIMER	3U	/* sleep timer is set up */
+#define XIL_STARTUP_MAIN	4U	/* constructors are done */
+#define XIL_STARTUP_PHASES	5U
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#if defined (__GNUC__)
+#define XIL_NOINIT	__attribute__((section(".bss.xil_noinit")))
+#define XIL_LAZY_BSS	__attribute__((section(".bss.xil_lazy")))
+#else
+#define XIL_NOINIT
+#define XIL_LAZY_BSS
+#endif
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * Startup phase times in global timer counts (COUNTS_PER_SECOND)
+ */
+typedef struct {
+	u64 CpuInitCounts;	/**< __cpu_init */
+	u64 BssCounts;		/**< Zeroing .sbss and .bss */
+	u64 CtorCounts;		/**< Global constructors */
+	u64 TotalCounts;	/**< _start to main */
+} Xil_StartupTimes;
+
+/**
+*@endcond
+*/
+
+/************************** Function Prototypes ******************************/
+
+void *Xil_LazyZero(void *Addr, u32 Size, u32 *InitDone);
+void Xil_LazyBssZero(void);
+void Xil_StartupMark(u32 Phase);
+void Xil_StartupGetTimes(Xil_StartupTimes *TimesPtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XIL_STARTUP_H */
+/**
+* @} End of "addtogroup a9_startup_apis".
+*/
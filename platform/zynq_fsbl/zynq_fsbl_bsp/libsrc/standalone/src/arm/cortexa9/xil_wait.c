@@ -0,0 +1,574 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+* @file xil_wait.c
+*
+* This file contains the low power event waits. For more information see
+* xil_wait.h.
+*
+* A wait first samples the event register and returns at once if the event
+* already occurred, so short waits cost no more than the polling loop. It
+* then masks IRQs, enables the wake up interrupts at the GIC and sleeps in
+* WFI. The event register is sampled with IRQs masked before every WFI: an
+* event that arrives after the sample leaves its interrupt pending, which
+* makes the WFI return at once, so no wake up is lost.
+*
+* The global timer comparator wakes the core on timeout. For events without
+* an interrupt it wakes the core every XIL_WAIT_POLL_US, for events with an
+* interrupt every XIL_WAIT_GUARD_US as a guard against an interrupt that is
+* routed elsewhere by the application.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- ---------------------------------------------------
+* 9.3   pt   10/19/26 Initial version
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#if defined(__GNUC__)
+#include "xil_wait.h"
+#include "xtime_l.h"
+#include "xil_io.h"
+#include "xstatus.h"
+#include "xparameters.h"
+#include "xpseudo_asm.h"
+#include "xreg_cortexa9.h"
+#include "xplatform_info.h"
+#ifdef SDT
+#include "xcortexa9_config.h"
+#endif
+
+/************************** Constant Definitions *****************************/
+
+#ifndef XIL_WAIT_GUARD_US
+#define XIL_WAIT_GUARD_US		1000U
+#endif
+
+/* Global timer, the comparator registers and control bits 1-3 are banked */
+#define XIL_WAIT_GT_BASEADDR		XPAR_GLOBAL_TMR_BASEADDR
+#define XIL_WAIT_GT_CNTL_OFFSET		0x00U
+#define XIL_WAIT_GT_CNTH_OFFSET		0x04U
+#define XIL_WAIT_GT_CTRL_OFFSET		0x08U
+#define XIL_WAIT_GT_ISR_OFFSET		0x0CU
+#define XIL_WAIT_GT_COMPL_OFFSET	0x10U
+#define XIL_WAIT_GT_COMPH_OFFSET	0x14U
+#define XIL_WAIT_GT_CTRL_COMP_MASK	0x00000002U
+#define XIL_WAIT_GT_CTRL_IRQ_MASK	0x00000004U
+#define XIL_WAIT_GT_CTRL_AUTOINC_MASK	0x00000008U
+#define XIL_WAIT_GT_ISR_EVENT_MASK	0x00000001U
+#define XIL_WAIT_GT_INTR		XPAR_GLOBAL_TMR_INTR
+
+/* GIC distributor and CPU interface */
+#define XIL_WAIT_DIST_BASEADDR		XPAR_SCUGIC_DIST_BASEADDR
+#define XIL_WAIT_CPU_BASEADDR		XPAR_SCUGIC_CPU_BASEADDR
+#define XIL_WAIT_DIST_CTRL_OFFSET	0x000U
+#define XIL_WAIT_DIST_ENABLE_OFFSET	0x100U
+#define XIL_WAIT_DIST_DISABLE_OFFSET	0x180U
+#define XIL_WAIT_DIST_PEND_CLR_OFFSET	0x280U
+#define XIL_WAIT_DIST_PRIORITY_OFFSET	0x400U
+#define XIL_WAIT_DIST_TARGET_OFFSET	0x800U
+#define XIL_WAIT_CPU_CTRL_OFFSET	0x000U
+#define XIL_WAIT_CPU_PMR_OFFSET		0x004U
+#define XIL_WAIT_ENABLE_MASK		0x00000001U
+#define XIL_WAIT_PMR_OPEN		0xF0U
+#define XIL_WAIT_FIRST_SPI		32U
+
+#define XIL_WAIT_MAX_INTR		2U
+
+/**************************** Type Definitions *******************************/
+
+/*
+ * State the wait changes and has to put back
+ */
+typedef struct {
+	u32 IntrId[XIL_WAIT_MAX_INTR];	/* Wake up interrupts */
+	u8 Priority[XIL_WAIT_MAX_INTR];	/* Saved priorities */
+	u8 Target[XIL_WAIT_MAX_INTR];	/* Saved SPI targets */
+	u32 Owned;			/* Interrupts enabled by the wait */
+	u32 Count;			/* Number of wake up interrupts */
+	u32 DistCtrl;			/* Saved ICDDCR */
+	u32 CpuCtrl;			/* Saved ICCICR */
+	u32 CpuPmr;			/* Saved ICCPMR */
+	u32 GtCtrl;			/* Saved global timer control */
+	u32 GtCompL;			/* Saved comparator */
+	u32 GtCompH;
+} Xil_WaitCtx;
+
+/************************** Variable Definitions *****************************/
+
+static Xil_WaitStats WaitStats = {
+	0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U
+};
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define Xil_WaitDistBit(Offset, IntrId) \
+	(XIL_WAIT_DIST_BASEADDR + (Offset) + (((IntrId) / 32U) * 4U))
+
+/************************** Function Prototypes ******************************/
+
+/*****************************************************************************/
+/**
+* @brief	Reads the global timer counter.
+*
+* @return	Counter value.
+*
+******************************************************************************/
+static XTime Xil_WaitGetTime(void)
+{
+	u32 Low;
+	u32 High;
+
+	do {
+		High = Xil_In32(XIL_WAIT_GT_BASEADDR + XIL_WAIT_GT_CNTH_OFFSET);
+		Low = Xil_In32(XIL_WAIT_GT_BASEADDR + XIL_WAIT_GT_CNTL_OFFSET);
+	} while (Xil_In32(XIL_WAIT_GT_BASEADDR + XIL_WAIT_GT_CNTH_OFFSET) !=
+		 High);
+
+	return (((XTime)High) << 32U) | (XTime)Low;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Returns the global timer counts per microsecond.
+*
+******************************************************************************/
+static u32 Xil_WaitCountsPerUs(void)
+{
+#ifndef SDT
+	u32 CpuFreq = XPAR_CPU_CORTEXA9_CORE_CLOCK_FREQ_HZ;
+#else
+	u32 CpuFreq = XGet_CpuFreq();
+#endif
+
+	/* Global Timer is always clocked at half of the CPU frequency */
+	return CpuFreq / (2U * 1000000U);
+}
+
+/*****************************************************************************/
+/**
+* @brief	Samples the event register.
+*
+* @param	RegAddr is the register address, 0 for no event.
+* @param	Mask selects the event bits.
+* @param	Value is the value to wait for, or the bits of which any one
+*		ends the wait if Any is TRUE.
+* @param	Any selects the Xil_WaitForEvents semantics.
+* @param	RegPtr is updated with the masked register value.
+*
+* @return	TRUE if the event occurred.
+*
+******************************************************************************/
+static inline u32 Xil_WaitCheck(UINTPTR RegAddr, u32 Mask, u32 Value,
+				u32 Any, u32 *RegPtr)
+{
+	u32 Reg;
+
+	if (RegAddr == 0U) {
+		return FALSE;
+	}
+	Reg = Xil_In32(RegAddr) & Mask;
+	*RegPtr = Reg;
+	if (Any == TRUE) {
+		return ((Reg & Value) != 0U) ? TRUE : FALSE;
+	}
+
+	return (Reg == Value) ? TRUE : FALSE;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Enables or disables the wake up interrupts the wait owns.
+*
+******************************************************************************/
+static void Xil_WaitOwnedEnable(const Xil_WaitCtx *Ctx, u32 Enable)
+{
+	u32 Offset = (Enable == TRUE) ? XIL_WAIT_DIST_ENABLE_OFFSET :
+		     XIL_WAIT_DIST_DISABLE_OFFSET;
+	u32 Index;
+
+	for (Index = 0U; Index < Ctx->Count; Index++) {
+		if ((Ctx->Owned & (1U << Index)) != 0U) {
+			Xil_Out32(Xil_WaitDistBit(Offset, Ctx->IntrId[Index]),
+				  1U << (Ctx->IntrId[Index] % 32U));
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+* @brief	Sets up the GIC and the global timer comparator as wake up
+*		sources. IRQs must be masked.
+*
+******************************************************************************/
+static void Xil_WaitArm(Xil_WaitCtx *Ctx, u32 IntrId)
+{
+	UINTPTR Addr;
+	u32 Bit;
+	u32 Index;
+	u8 CpuMask;
+
+	Ctx->Count = 0U;
+	Ctx->Owned = 0U;
+	Ctx->IntrId[Ctx->Count++] = XIL_WAIT_GT_INTR;
+	if ((IntrId != XIL_WAIT_NO_INTR) && (IntrId != XIL_WAIT_GT_INTR)) {
+		Ctx->IntrId[Ctx->Count++] = IntrId;
+	}
+
+	/*
+	 * Only interrupts the application has not enabled are taken over,
+	 * the others keep their priority and target
+	 */
+	CpuMask = (u8)(1U << XGetCoreId());
+	for (Index = 0U; Index < Ctx->Count; Index++) {
+		Bit = 1U << (Ctx->IntrId[Index] % 32U);
+		Addr = Xil_WaitDistBit(XIL_WAIT_DIST_ENABLE_OFFSET,
+				       Ctx->IntrId[Index]);
+		if ((Xil_In32(Addr) & Bit) != 0U) {
+			continue;
+		}
+		Ctx->Owned |= 1U << Index;
+		Ctx->Priority[Index] = Xil_In8(XIL_WAIT_DIST_BASEADDR +
+					       XIL_WAIT_DIST_PRIORITY_OFFSET +
+					       Ctx->IntrId[Index]);
+		Xil_Out8(XIL_WAIT_DIST_BASEADDR + XIL_WAIT_DIST_PRIORITY_OFFSET +
+			 Ctx->IntrId[Index], (u8)XIL_WAIT_WAKE_PRIORITY);
+		if (Ctx->IntrId[Index] >= XIL_WAIT_FIRST_SPI) {
+			Ctx->Target[Index] = Xil_In8(XIL_WAIT_DIST_BASEADDR +
+						     XIL_WAIT_DIST_TARGET_OFFSET +
+						     Ctx->IntrId[Index]);
+			Xil_Out8(XIL_WAIT_DIST_BASEADDR +
+				 XIL_WAIT_DIST_TARGET_OFFSET +
+				 Ctx->IntrId[Index], CpuMask);
+		}
+	}
+	Xil_WaitOwnedEnable(Ctx, TRUE);
+
+	/* The GIC must forward the interrupts for WFI to see them */
+	Ctx->DistCtrl = Xil_In32(XIL_WAIT_DIST_BASEADDR +
+				 XIL_WAIT_DIST_CTRL_OFFSET);
+	Ctx->CpuCtrl = Xil_In32(XIL_WAIT_CPU_BASEADDR +
+				XIL_WAIT_CPU_CTRL_OFFSET);
+	Ctx->CpuPmr = Xil_In32(XIL_WAIT_CPU_BASEADDR + XIL_WAIT_CPU_PMR_OFFSET);
+	Xil_Out32(XIL_WAIT_DIST_BASEADDR + XIL_WAIT_DIST_CTRL_OFFSET,
+		  Ctx->DistCtrl | XIL_WAIT_ENABLE_MASK);
+	Xil_Out32(XIL_WAIT_CPU_BASEADDR + XIL_WAIT_CPU_CTRL_OFFSET,
+		  Ctx->CpuCtrl | XIL_WAIT_ENABLE_MASK);
+	if (Ctx->CpuPmr <= XIL_WAIT_WAKE_PRIORITY) {
+		Xil_Out32(XIL_WAIT_CPU_BASEADDR + XIL_WAIT_CPU_PMR_OFFSET,
+			  XIL_WAIT_PMR_OPEN);
+	}
+
+	Ctx->GtCtrl = Xil_In32(XIL_WAIT_GT_BASEADDR + XIL_WAIT_GT_CTRL_OFFSET);
+	Ctx->GtCompL = Xil_In32(XIL_WAIT_GT_BASEADDR + XIL_WAIT_GT_COMPL_OFFSET);
+	Ctx->GtCompH = Xil_In32(XIL_WAIT_GT_BASEADDR + XIL_WAIT_GT_COMPH_OFFSET);
+}
+
+/*****************************************************************************/
+/**
+* @brief	Puts back the GIC and global timer state saved by
+*		Xil_WaitArm. IRQs must be masked.
+*
+******************************************************************************/
+static void Xil_WaitDisarm(const Xil_WaitCtx *Ctx)
+{
+	u32 Index;
+
+	Xil_Out32(XIL_WAIT_GT_BASEADDR + XIL_WAIT_GT_CTRL_OFFSET,
+		  Ctx->GtCtrl & ~(XIL_WAIT_GT_CTRL_COMP_MASK |
+				  XIL_WAIT_GT_CTRL_IRQ_MASK));
+	Xil_Out32(XIL_WAIT_GT_BASEADDR + XIL_WAIT_GT_COMPL_OFFSET,
+		  Ctx->GtCompL);
+	Xil_Out32(XIL_WAIT_GT_BASEADDR + XIL_WAIT_GT_COMPH_OFFSET,
+		  Ctx->GtCompH);
+	Xil_Out32(XIL_WAIT_GT_BASEADDR + XIL_WAIT_GT_ISR_OFFSET,
+		  XIL_WAIT_GT_ISR_EVENT_MASK);
+	Xil_Out32(XIL_WAIT_GT_BASEADDR + XIL_WAIT_GT_CTRL_OFFSET, Ctx->GtCtrl);
+
+	Xil_WaitOwnedEnable(Ctx, FALSE);
+	for (Index = 0U; Index < Ctx->Count; Index++) {
+		if ((Ctx->Owned & (1U << Index)) == 0U) {
+			continue;
+		}
+		/* Drop what the wait left pending, nobody handles it */
+		Xil_Out32(Xil_WaitDistBit(XIL_WAIT_DIST_PEND_CLR_OFFSET,
+					  Ctx->IntrId[Index]),
+			  1U << (Ctx->IntrId[Index] % 32U));
+		Xil_Out8(XIL_WAIT_DIST_BASEADDR + XIL_WAIT_DIST_PRIORITY_OFFSET +
+			 Ctx->IntrId[Index], Ctx->Priority[Index]);
+		if (Ctx->IntrId[Index] >= XIL_WAIT_FIRST_SPI) {
+			Xil_Out8(XIL_WAIT_DIST_BASEADDR +
+				 XIL_WAIT_DIST_TARGET_OFFSET +
+				 Ctx->IntrId[Index], Ctx->Target[Index]);
+		}
+	}
+
+	Xil_Out32(XIL_WAIT_CPU_BASEADDR + XIL_WAIT_CPU_PMR_OFFSET, Ctx->CpuPmr);
+	Xil_Out32(XIL_WAIT_CPU_BASEADDR + XIL_WAIT_CPU_CTRL_OFFSET,
+		  Ctx->CpuCtrl);
+	Xil_Out32(XIL_WAIT_DIST_BASEADDR + XIL_WAIT_DIST_CTRL_OFFSET,
+		  Ctx->DistCtrl);
+}
+
+/*****************************************************************************/
+/**
+* @brief	Arms the global timer comparator to fire at Wake.
+*
+******************************************************************************/
+static void Xil_WaitSetComparator(const Xil_WaitCtx *Ctx, XTime Wake)
+{
+	u32 Ctrl = Ctx->GtCtrl & ~(XIL_WAIT_GT_CTRL_COMP_MASK |
+				   XIL_WAIT_GT_CTRL_IRQ_MASK |
+				   XIL_WAIT_GT_CTRL_AUTOINC_MASK);
+
+	Xil_Out32(XIL_WAIT_GT_BASEADDR + XIL_WAIT_GT_CTRL_OFFSET, Ctrl);
+	Xil_Out32(XIL_WAIT_GT_BASEADDR + XIL_WAIT_GT_COMPL_OFFSET, (u32)Wake);
+	Xil_Out32(XIL_WAIT_GT_BASEADDR + XIL_WAIT_GT_COMPH_OFFSET,
+		  (u32)(Wake >> 32U));
+	Xil_Out32(XIL_WAIT_GT_BASEADDR + XIL_WAIT_GT_ISR_OFFSET,
+		  XIL_WAIT_GT_ISR_EVENT_MASK);
+	Xil_Out32(Xil_WaitDistBit(XIL_WAIT_DIST_PEND_CLR_OFFSET,
+				  XIL_WAIT_GT_INTR),
+		  1U << (XIL_WAIT_GT_INTR % 32U));
+	Xil_Out32(XIL_WAIT_GT_BASEADDR + XIL_WAIT_GT_CTRL_OFFSET,
+		  Ctrl | XIL_WAIT_GT_CTRL_COMP_MASK | XIL_WAIT_GT_CTRL_IRQ_MASK);
+}
+
+/*****************************************************************************/
+/**
+* @brief	Sleeps until the event occurs or the timeout expires.
+*
+* @param	RegAddr is the event register, 0 to sleep for Timeout.
+* @param	Mask selects the event bits.
+* @param	Value is the event value or bits, see Xil_WaitCheck.
+* @param	Any selects the Xil_WaitForEvents semantics.
+* @param	Timeout is the timeout in microseconds.
+* @param	IntrId is the GIC id of the event interrupt or
+*		XIL_WAIT_NO_INTR.
+* @param	RegPtr is updated with the last masked register value.
+*
+* @return	XST_SUCCESS if the event occurred, XST_TIMEOUT otherwise.
+*
+******************************************************************************/
+static u32 Xil_WaitCore(UINTPTR RegAddr, u32 Mask, u32 Value, u32 Any,
+			u64 Timeout, u32 IntrId, u32 *RegPtr)
+{
+	Xil_WaitCtx Ctx;
+	XTime Start;
+	XTime End;
+	XTime Now;
+	XTime Wake;
+	XTime Slept;
+	XTime Period;
+	u32 CountsPerUs;
+	u32 Status = XST_TIMEOUT;
+	u32 Cpsr;
+
+	*RegPtr = 0U;
+	if (Xil_WaitCheck(RegAddr, Mask, Value, Any, RegPtr) == TRUE) {
+		return XST_SUCCESS;
+	}
+
+	CountsPerUs = Xil_WaitCountsPerUs();
+	Start = Xil_WaitGetTime();
+	End = Start + (Timeout * CountsPerUs);
+	if ((RegAddr != 0U) && (IntrId == XIL_WAIT_NO_INTR)) {
+		Period = (XTime)XIL_WAIT_POLL_US * CountsPerUs;
+	} else {
+		Period = (XTime)XIL_WAIT_GUARD_US * CountsPerUs;
+	}
+
+	Cpsr = mfcpsr();
+	mtcpsr(Cpsr | XREG_CPSR_IRQ_ENABLE);
+	Xil_WaitArm(&Ctx, IntrId);
+
+	while (1) {
+		if (Xil_WaitCheck(RegAddr, Mask, Value, Any, RegPtr) == TRUE) {
+			Status = XST_SUCCESS;
+			break;
+		}
+		Now = Xil_WaitGetTime();
+		if (Now >= End) {
+			break;
+		}
+		Wake = ((End - Now) > Period) ? (Now + Period) : End;
+		Xil_WaitSetComparator(&Ctx, Wake);
+
+		dsb();
+		wfi();
+
+		Slept = Xil_WaitGetTime();
+		WaitStats.Wakeups++;
+		WaitStats.SleepCounts += Slept - Now;
+		if ((Xil_In32(XIL_WAIT_GT_BASEADDR + XIL_WAIT_GT_ISR_OFFSET) &
+		     XIL_WAIT_GT_ISR_EVENT_MASK) != 0U) {
+			WaitStats.TimerWakeups++;
+			WaitStats.SumWakeLatency += Slept - Wake;
+			if ((Slept - Wake) > WaitStats.MaxWakeLatency) {
+				WaitStats.MaxWakeLatency = Slept - Wake;
+			}
+		}
+
+		/*
+		 * Let pending application interrupts in. The wake up
+		 * interrupts nobody handles stay disabled meanwhile.
+		 */
+		if ((Cpsr & XREG_CPSR_IRQ_ENABLE) == 0U) {
+			Xil_WaitOwnedEnable(&Ctx, FALSE);
+			mtcpsr(Cpsr);
+			isb();
+			mtcpsr(Cpsr | XREG_CPSR_IRQ_ENABLE);
+			Xil_WaitOwnedEnable(&Ctx, TRUE);
+		}
+	}
+
+	Xil_WaitDisarm(&Ctx);
+	mtcpsr(Cpsr);
+
+	WaitStats.Waits++;
+	WaitStats.WaitCounts += Xil_WaitGetTime() - Start;
+	if (Status != XST_SUCCESS) {
+		WaitStats.Timeouts++;
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Waits in WFI for the event.
+*
+* @param	RegAddr is the address of register to be checked for event(s)
+*		occurrence.
+* @param	EventMask is the mask indicating event(s) to be checked.
+* @param	Event is the specific event(s) value to be checked.
+* @param	Timeout is the max number of microseconds to wait for an
+*		event(s).
+* @param	IntrId is the GIC id of the interrupt the peripheral raises
+*		for the event, or XIL_WAIT_NO_INTR to sample the register
+*		every XIL_WAIT_POLL_US.
+*
+* @return
+*		- XST_SUCCESS on occurrence of the event(s).
+*		- XST_FAILURE if the event did not occur before the timeout.
+*
+* @note		Same semantics as Xil_WaitForEvent. The peripheral must
+*		signal the event on its interrupt line, its interrupt enable
+*		or mask register is the caller's responsibility.
+*
+******************************************************************************/
+u32 Xil_WaitForEventWfi(UINTPTR RegAddr, u32 EventMask, u32 Event,
+			u32 Timeout, u32 IntrId)
+{
+	u32 Reg;
+	u32 Status;
+
+	Status = Xil_WaitCore(RegAddr, EventMask, Event, FALSE, Timeout,
+			      IntrId, &Reg);
+
+	return (Status == XST_SUCCESS) ? (u32)XST_SUCCESS : (u32)XST_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Waits in WFI for the events. Returns on occurrence of first
+*		event / timeout.
+*
+* @param	EventsRegAddr is the address of register to be checked for
+*		event(s) occurrence.
+* @param	EventsMask is the mask indicating event(s) to be checked.
+* @param	WaitEvents is the specific event(s) to be checked.
+* @param	Timeout is the max number of microseconds to wait for an
+*		event(s).
+* @param	Events is updated with the mask of events occurred.
+* @param	IntrId is the GIC id of the interrupt the peripheral raises
+*		for the events, or XIL_WAIT_NO_INTR.
+*
+* @return
+*		- XST_SUCCESS on occurrence of the event(s).
+*		- XST_TIMEOUT if no event occurred before the timeout.
+*
+* @note		Same semantics as Xil_WaitForEvents.
+*
+******************************************************************************/
+u32 Xil_WaitForEventsWfi(UINTPTR EventsRegAddr, u32 EventsMask,
+			 u32 WaitEvents, u32 Timeout, u32 *Events,
+			 u32 IntrId)
+{
+	u32 Reg;
+	u32 Status;
+
+	*Events = 0x00U;
+	Status = Xil_WaitCore(EventsRegAddr, EventsMask, WaitEvents, TRUE,
+			      Timeout, IntrId, &Reg);
+	if (Status == XST_SUCCESS) {
+		*Events = Reg;
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Sleeps in WFI for the given time.
+*
+* @param	Useconds is the time in microseconds.
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_WaitUs(u64 Useconds)
+{
+	u32 Reg;
+
+	(void)Xil_WaitCore(0U, 0U, 0U, FALSE, Useconds, XIL_WAIT_NO_INTR,
+			   &Reg);
+}
+
+/*****************************************************************************/
+/**
+* @brief	Returns the wait statistics.
+*
+* @param	StatsPtr is updated with a copy of the statistics.
+*
+* @return	None.
+*
+* @note		The average wake up latency is SumWakeLatency /
+*		TimerWakeups. SleepCounts / WaitCounts is the share of the
+*		wait time the core spent clock gated in WFI, the polling loop
+*		it replaces spends all of it executing.
+*
+******************************************************************************/
+void Xil_WaitGetStats(Xil_WaitStats *StatsPtr)
+{
+	*StatsPtr = WaitStats;
+}
+
+/*****************************************************************************/
+/**
+* @brief	Clears the wait statistics.
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_WaitResetStats(void)
+{
+	WaitStats.Waits = 0U;
+	WaitStats.Timeouts = 0U;
+	WaitStats.Wakeups = 0U;
+	WaitStats.TimerWakeups = 0U;
+	WaitStats.WaitCounts = 0U;
+	WaitStats.SleepCounts = 0U;
+	WaitStats.MaxWakeLatency = 0U;
+	WaitStats.SumWakeLatency = 0U;
+}
+#endif
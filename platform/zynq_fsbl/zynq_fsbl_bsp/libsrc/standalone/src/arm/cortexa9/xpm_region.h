@@ -0,0 +1,155 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xpm_region.h
+*
+* @addtogroup a9_region_counter_apis Cortex A9 Region Counter Functions
+*
+* Named code region measurement built on the Cortex-A9 performance monitor
+* and the PL310 event counters.
+*
+* A region is enclosed in XPM_REGION_BEGIN("name") / XPM_REGION_END(). At
+* both boundaries the cycle counter, the L1 data cache refill and branch
+* mispredict event counters and the two L2CC event counters (data read
+* requests and data read hits) are sampled. The differences are accumulated
+* per region name in a fixed table holding the count, min, max and sum of
+* every metric. XPmRegion_Report() prints the table with xil_printf.
+*
+* The macros expand to nothing unless XPM_REGION_ENABLE is defined in the
+* application, the library functions themselves are always built.
+*
+* Regions may be nested, the begin snapshot lives on the caller's stack.
+* The region name is looked up once per call site and cached in a static.
+*
+* Probe overhead: one begin/end pair costs one cycle counter read, two
+* event counter reads (each a select, isb and mrc) and two PL310 register
+* reads on each side, plus the accumulation in XPmRegion_End. The cost
+* depends on the L2 and interconnect clocks, so it is measured at run time
+* by XPmRegion_Calibrate() which times empty regions and keeps the minimum
+* of every metric. Calibration results are subtracted from every later
+* sample and printed in the report header, that printed figure is the
+* per-probe overhead measured on the running system. Call it once after
+* XPmRegion_Init(), after the caches and the MMU are configured for the
+* measured code and before the first measured region: every probe reads and
+* updates the region table, a calibration taken with a different cache
+* state over- or under-corrects every sample.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 9.3   pt   10/19/26 First release
+* </pre>
+*
+* @note
+*
+* XPmRegion_Init() clears the PMCR cycle counter divider set by the boot
+* code so that cycles are counted one by one, and claims two of the six
+* PMU event counters. The PL310 counters count requests from both CPUs and
+* all AXI masters, the L2 figures are therefore only meaningful while the
+* other master is quiet. 32 bit deltas wrap after 2^32 cycles, regions must
+* be shorter than that (about 6 seconds at 667 MHz).
+*
+******************************************************************************/
+
+/**
+*@cond nocomments
+*/
+
+#ifndef XPM_REGION_H /* prevent circular inclusions */
+#define XPM_REGION_H /* by using protection macros */
+
+/***************************** Include Files ********************************/
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/************************** Constant Definitions ****************************/
+
+/* Number of distinct region names */
+#ifndef XPM_REGION_MAX
+#define XPM_REGION_MAX		16U
+#endif
+
+/* Empty regions timed by XPmRegion_Calibrate */
+#ifndef XPM_REGION_CALIB_LOOPS
+#define XPM_REGION_CALIB_LOOPS	64U
+#endif
+
+#define XPM_REGION_INVALID	0xFFFFFFFFU
+
+/* Sampled metrics */
+#define XPM_REGION_CYCLES	0U
+#define XPM_REGION_L1D_MISS	1U
+#define XPM_REGION_BR_MISS	2U
+#define XPM_REGION_L2_READS	3U
+#define XPM_REGION_L2_MISS	4U
+#define XPM_REGION_METRICS	5U
+
+/**************************** Type Definitions ******************************/
+
+/* Counter snapshot taken at the start of a region */
+typedef struct {
+	u32 Value[XPM_REGION_METRICS];
+} XPmRegion_Snapshot;
+
+typedef struct {
+	const char *Name;
+	u32 Count;
+	u32 Min[XPM_REGION_METRICS];
+	u32 Max[XPM_REGION_METRICS];
+	u64 Sum[XPM_REGION_METRICS];
+} XPmRegion_Entry;
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+#ifdef XPM_REGION_ENABLE
+#define XPM_REGION_BEGIN(Name) \
+	{ \
+		static u32 XPmRegionId_ = XPM_REGION_INVALID; \
+		XPmRegion_Snapshot XPmRegionSnap_; \
+		if (XPmRegionId_ == XPM_REGION_INVALID) { \
+			XPmRegionId_ = XPmRegion_Lookup(Name); \
+		} \
+		XPmRegion_Begin(&XPmRegionSnap_);
+
+#define XPM_REGION_END() \
+		XPmRegion_End(XPmRegionId_, &XPmRegionSnap_); \
+	}
+#else
+#define XPM_REGION_BEGIN(Name)	{
+#define XPM_REGION_END()	}
+#endif
+
+/**
+*@endcond
+*/
+
+/************************** Function Prototypes *****************************/
+
+u32 XPmRegion_Init(void);
+void XPmRegion_Calibrate(void);
+u32 XPmRegion_Lookup(const char *Name);
+void XPmRegion_Begin(XPmRegion_Snapshot *Snap);
+void XPmRegion_End(u32 Id, const XPmRegion_Snapshot *Snap);
+const XPmRegion_Entry *XPmRegion_Get(u32 Id);
+void XPmRegion_Reset(void);
+void XPmRegion_Report(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* XPM_REGION_H */
+/**
+* @} End of "addtogroup a9_region_counter_apis".
+*/
@@ -15,6 +15,14 @@
 * encapsulates the Input/Output functions for the processors that do not
 * require any special I/O handling.
 *
+* If XIL_IO_MODEL is defined, Xil_In* and Xil_Out* call Xil_IoModelRead and
+* Xil_IoModelWrite instead of accessing the bus. This allows to build drivers
+* and FSBL code for a host and run them against device models, which decode
+* the address, emulate the registers and account the modeled access time,
+* for example through the global timer model read by XTime_GetTime. Memory
+* mapped windows that are accessed without these functions, such as linear
+* QSPI or the DDR buffers of a DMA, have to be provided by the host.
+*
 * @{
 * <pre>
 * MODIFICATION HISTORY:
@@ -34,6 +42,8 @@
 *                         when -Werror=conversion compiler flag is enabled
 * 7.5   mus      05/17/21 Update the functions with comments. It fixes CR#1067739.
 * 9.0   ml       03/03/23 Add description and remove comments to fix doxygen warnings.
+* 9.3   pt       10/19/26 Forward register accesses to Xil_IoModelRead and
+*                         Xil_IoModelWrite if XIL_IO_MODEL is defined.
 * </pre>
 ******************************************************************************/
 
@@ -60,6 +70,10 @@ extern "C" {
 #ifdef ENABLE_SAFETY
 extern u32 XStl_RegUpdate(u32 RegAddr, u32 RegVal);
 #endif
+#ifdef XIL_IO_MODEL
+extern u64 Xil_IoModelRead(UINTPTR Addr, u32 Size);
+extern void Xil_IoModelWrite(UINTPTR Addr, u64 Value, u32 Size);
+#endif
 
 /***************** Macros (Inline Functions) Definitions *********************/
 #if defined __GNUC__
@@ -100,7 +114,11 @@ extern u32 XStl_RegUpdate(u32 RegAddr, u32 RegVal);
 ******************************************************************************/
 static INLINE u8 Xil_In8(UINTPTR Addr)
 {
+#ifdef XIL_IO_MODEL
+	return (u8)Xil_IoModelRead(Addr, 1U);
+#else
 	return *(volatile u8 *) Addr;
+#endif
 }
 
 /*****************************************************************************/
@@ -117,7 +135,11 @@ static INLINE u8 Xil_In8(UINTPTR Addr)
 ******************************************************************************/
 static INLINE u16 Xil_In16(UINTPTR Addr)
 {
+#ifdef XIL_IO_MODEL
+	return (u16)Xil_IoModelRead(Addr, 2U);
+#else
 	return *(volatile u16 *) Addr;
+#endif
 }
 
 /*****************************************************************************/
@@ -134,7 +156,11 @@ static INLINE u16 Xil_In16(UINTPTR Addr)
 ******************************************************************************/
 static INLINE u32 Xil_In32(UINTPTR Addr)
 {
+#ifdef XIL_IO_MODEL
+	return (u32)Xil_IoModelRead(Addr, 4U);
+#else
 	return *(volatile u32 *) Addr;
+#endif
 }
 
 /*****************************************************************************/
@@ -151,7 +177,11 @@ static INLINE u32 Xil_In32(UINTPTR Addr)
 ******************************************************************************/
 static INLINE u64 Xil_In64(UINTPTR Addr)
 {
+#ifdef XIL_IO_MODEL
+	return (u64)Xil_IoModelRead(Addr, 8U);
+#else
 	return *(volatile u64 *) Addr;
+#endif
 }
 
 /*****************************************************************************/
@@ -170,8 +200,12 @@ static INLINE u64 Xil_In64(UINTPTR Addr)
 static INLINE void Xil_Out8(UINTPTR Addr, u8 Value)
 {
 	/* write 8 bit value to specified address */
+#ifdef XIL_IO_MODEL
+	Xil_IoModelWrite(Addr, Value, 1U);
+#else
 	volatile u8 *LocalAddr = (volatile u8 *)Addr;
 	*LocalAddr = Value;
+#endif
 }
 
 /*****************************************************************************/
@@ -189,8 +223,12 @@ static INLINE void Xil_Out8(UINTPTR Addr, u8 Value)
 static INLINE void Xil_Out16(UINTPTR Addr, u16 Value)
 {
 	/* write 16 bit value to specified address */
+#ifdef XIL_IO_MODEL
+	Xil_IoModelWrite(Addr, Value, 2U);
+#else
 	volatile u16 *LocalAddr = (volatile u16 *)Addr;
 	*LocalAddr = Value;
+#endif
 }
 
 /*****************************************************************************/
@@ -209,7 +247,9 @@ static INLINE void Xil_Out16(UINTPTR Addr, u16 Value)
 static INLINE void Xil_Out32(UINTPTR Addr, u32 Value)
 {
 	/* write 32 bit value to specified address */
-#ifndef ENABLE_SAFETY
+#if defined (XIL_IO_MODEL)
+	Xil_IoModelWrite(Addr, Value, 4U);
+#elif !defined (ENABLE_SAFETY)
 	volatile u32 *LocalAddr = (volatile u32 *)Addr;
 	*LocalAddr = Value;
 #else
@@ -232,8 +272,12 @@ static INLINE void Xil_Out32(UINTPTR Addr, u32 Value)
 static INLINE void Xil_Out64(UINTPTR Addr, u64 Value)
 {
 	/* write 64 bit value to specified address */
+#ifdef XIL_IO_MODEL
+	Xil_IoModelWrite(Addr, Value, 8U);
+#else
 	volatile u64 *LocalAddr = (volatile u64 *)Addr;
 	*LocalAddr = Value;
+#endif
 }
 
 /*****************************************************************************/
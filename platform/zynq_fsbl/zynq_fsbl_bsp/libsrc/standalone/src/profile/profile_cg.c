@@ -81,7 +81,8 @@ void mcount( u32 frompc, u32 selfpc )
 		}
 	}
 	if( j == n_gmon_sections ) {
-		goto done;
+		/* p is NULL here, there is no section state to update */
+		goto enable_timer_label;
 	}
 
 #ifdef PROFILE_NO_FUNCPTR
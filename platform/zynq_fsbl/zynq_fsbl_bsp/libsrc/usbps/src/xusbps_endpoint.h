@@ -22,6 +22,8 @@
  * ----- ---- -------- --------------------------------------------------------
  * 1.00a wgr  10/10/10 First release
  * 2.5   pm   02/20/20 Added multiplier bit for ISO frame handling.
+ * 2.9   pt   10/19/26 Added XUSBPS_BUF_IS_COHERENT and the internal
+ *                     streaming functions.
  * </pre>
  *
  ******************************************************************************/
@@ -38,6 +40,9 @@ extern "C" {
 #include "xusbps.h"
 #include "xil_types.h"
 
+/* No DMA buffer pool in this BSP, every buffer gets cache maintenance */
+#define XUSBPS_BUF_IS_COHERENT(Buf)	0U
+
 /**************************** Type Definitions *******************************/
 
 /************************** Constant Definitions *****************************/
@@ -498,6 +503,16 @@ extern "C" {
 #define XUsbPs_WritedQH(dQHPtr, Id, Val)	\
 	(*(u32 *) ((u32)(dQHPtr) + (u32)(Id)) = (u32)(Val))
 
+/************************** Function Prototypes ******************************/
+
+int XUsbPs_dTDAttachBuffer(XUsbPs_dTD *dTDPtr,
+			   const u8 *BufferPtr, u32 BufferLen);
+
+/*
+ * Implemented in file xusbps_stream.c, called by the interrupt handler
+ */
+void XUsbPs_StreamHandleCompl(XUsbPs_Stream *StreamPtr);
+void XUsbPs_StreamReset(XUsbPs_Stream *StreamPtr);
 
 
 #ifdef __cplusplus
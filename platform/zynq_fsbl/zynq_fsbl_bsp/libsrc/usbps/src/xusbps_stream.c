@@ -0,0 +1,632 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/******************************************************************************/
+/**
+ * @file xusbps_stream.c
+* @addtogroup usbps Overview
+* @{
+ *
+ * Bulk streaming on top of the endpoint Transfer Descriptor rings.
+ *
+ * A stream owns the descriptor ring of one endpoint direction (NumBufs
+ * descriptors of the endpoint configuration). Every submitted buffer takes
+ * one descriptor per 16 kB, only the last of them interrupts on completion.
+ * Like XUsbPs_EpBufferSend() the ring always keeps one inactive descriptor
+ * after the queued ones as list terminator, so the driver never writes a
+ * descriptor owned by the controller. A new buffer is appended by filling the
+ * terminator and the descriptors after it and activating the terminator
+ * last, the ATDTW tripwire then tells whether the controller is still
+ * running or has to be primed again.
+ *
+ * OUT (receive) buffers are limited to one descriptor, 16 kB. A short packet
+ * retires the descriptor it lands in, so a buffer spread over several
+ * descriptors would leave the rest of them to the next transfer of the host.
+ *
+ * @note
+ * Submissions mask IRQ and FIQ while the ring is updated, so buffers can be
+ * submitted both from the application and from the stream callback.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date     Changes
+ * ----- ---- -------- --------------------------------------------------------
+ * 2.9   pt  10/19/26 First release
+ * </pre>
+ ******************************************************************************/
+
+/***************************** Include Files **********************************/
+
+#include "xusbps.h"
+#include "xusbps_endpoint.h"
+#include "xpseudo_asm.h"
+
+/************************** Constant Definitions ******************************/
+
+#define XUSBPS_STREAM_IRQ_FIQ_MASK	0xC0U	/**< IRQ and FIQ bits in cpsr */
+
+/** Bytes per descriptor, XUSBPS_dTD_BUF_MAX_SIZE is not parenthesized */
+#define XUSBPS_STREAM_dTD_SIZE		(XUSBPS_dTD_BUF_MAX_SIZE)
+
+#define XUSBPS_STREAM_dTD_ERR_MASK	(XUSBPS_dTDTOKEN_XERR_MASK | \
+					 XUSBPS_dTDTOKEN_BUFERR_MASK | \
+					 XUSBPS_dTDTOKEN_HALT_MASK)
+
+/**************************** Type Definitions ********************************/
+
+/***************** Macros (Inline Functions) Definitions **********************/
+
+/************************** Variable Definitions ******************************/
+
+/************************** Function Prototypes ******************************/
+
+static void XUsbPs_StreamResetRing(XUsbPs_Stream *StreamPtr);
+static void XUsbPs_StreamPrime(XUsbPs_Stream *StreamPtr, XUsbPs_dTD *dTDPtr);
+static void XUsbPs_StreamLink(XUsbPs_Stream *StreamPtr, XUsbPs_dTD *dTDPtr);
+static void XUsbPs_StreamRetire(XUsbPs_Stream *StreamPtr, s32 Status);
+
+/******************************* Functions ************************************/
+
+/*****************************************************************************/
+/**
+* This function switches an endpoint direction to streaming mode.
+*
+* Anything queued on the endpoint direction is flushed. From now on the
+* endpoint direction is only served through XUsbPs_StreamSubmit(), the
+* XUsbPs_EpBufferSend() and XUsbPs_EpBufferReceive() functions must not be
+* used on it.
+*
+* @param	InstancePtr is a pointer to the XUsbPs instance of the
+*		controller.
+* @param	StreamPtr is the stream state, it must stay valid until
+*		XUsbPs_StreamStop() is called.
+* @param	EpNum is the number of the endpoint.
+* @param	Direction is XUSBPS_EP_DIRECTION_IN or XUSBPS_EP_DIRECTION_OUT.
+* @param	CallBackFunc is called for every completed buffer.
+* @param	CallBackRef is passed to CallBackFunc.
+*
+* @return
+*		- XST_SUCCESS: The operation completed successfully.
+*		- XST_INVALID_PARAM: The endpoint direction is not a bulk or
+*		interrupt endpoint with at least two descriptors.
+*		- XST_DEVICE_BUSY: The endpoint direction is already streaming.
+*		- XST_FAILURE: The endpoint could not be flushed.
+*
+* @note		For OUT endpoints the endpoint configuration should have a
+*		BufSize of 0, the buffers attached by XUsbPs_ConfigureDevice()
+*		are not used.
+*
+******************************************************************************/
+int XUsbPs_StreamStart(XUsbPs *InstancePtr, XUsbPs_Stream *StreamPtr,
+		       u8 EpNum, u8 Direction,
+		       XUsbPs_StreamHandlerFunc CallBackFunc, void *CallBackRef)
+{
+	XUsbPs_EpSetup	*EpSetup;
+	XUsbPs_Stream	**EpStream;
+	u32		FlushMask;
+	int		Timeout;
+
+	Xil_AssertNonvoid(InstancePtr  != NULL);
+	Xil_AssertNonvoid(StreamPtr    != NULL);
+	Xil_AssertNonvoid(CallBackFunc != NULL);
+	Xil_AssertNonvoid(EpNum < InstancePtr->DeviceConfig.NumEndpoints);
+
+	if (Direction == XUSBPS_EP_DIRECTION_IN) {
+		EpSetup = &InstancePtr->DeviceConfig.EpCfg[EpNum].In;
+		EpStream = &InstancePtr->DeviceConfig.Ep[EpNum].In.Stream;
+		StreamPtr->dTDs = InstancePtr->DeviceConfig.Ep[EpNum].In.dTDs;
+		StreamPtr->PrimeMask = 0x00010000 << EpNum;
+		FlushMask = 1 << (EpNum + XUSBPS_EPFLUSH_TX_SHIFT);
+	} else if (Direction == XUSBPS_EP_DIRECTION_OUT) {
+		EpSetup = &InstancePtr->DeviceConfig.EpCfg[EpNum].Out;
+		EpStream = &InstancePtr->DeviceConfig.Ep[EpNum].Out.Stream;
+		StreamPtr->dTDs = InstancePtr->DeviceConfig.Ep[EpNum].Out.dTDs;
+		StreamPtr->PrimeMask = 0x00000001 << EpNum;
+		FlushMask = 1 << (EpNum + XUSBPS_EPFLUSH_RX_SHIFT);
+	} else {
+		return XST_INVALID_PARAM;
+	}
+
+	if (((EpSetup->Type != XUSBPS_EP_TYPE_BULK) &&
+	     (EpSetup->Type != XUSBPS_EP_TYPE_INTERRUPT)) ||
+	    (EpSetup->NumBufs < 2)) {
+		return XST_INVALID_PARAM;
+	}
+
+	if (*EpStream != NULL) {
+		return XST_DEVICE_BUSY;
+	}
+
+	/* Drop whatever is primed on the endpoint. */
+	XUsbPs_EpFlush(InstancePtr, EpNum, Direction);
+	Timeout = XUSBPS_TIMEOUT_COUNTER;
+	while ((XUsbPs_ReadReg(InstancePtr->Config.BaseAddress,
+			       XUSBPS_EPFLUSH_OFFSET) & FlushMask) && --Timeout) {
+		/* NOP */
+	}
+	if (0 == Timeout) {
+		return XST_FAILURE;
+	}
+
+	StreamPtr->InstancePtr	= InstancePtr;
+	StreamPtr->EpNum	= EpNum;
+	StreamPtr->Direction	= Direction;
+	StreamPtr->NumdTD	= EpSetup->NumBufs;
+	StreamPtr->HandlerFunc	= CallBackFunc;
+	StreamPtr->HandlerRef	= CallBackRef;
+	StreamPtr->BytesDone	= 0;
+	StreamPtr->XfersDone	= 0;
+	StreamPtr->Reprimes	= 0;
+	XUsbPs_StreamResetRing(StreamPtr);
+
+	*EpStream = StreamPtr;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* This function queues a caller buffer on a stream.
+*
+* The buffer is handed to the controller as it is, it must not be touched
+* until the stream callback returns it. Buffers from a non-cacheable DMA
+* buffer pool arena need no cache maintenance, for all other buffers the
+* data cache is flushed (IN) or invalidated (OUT) here and invalidated again
+* on completion (OUT). Cached OUT buffers should be cache line aligned.
+*
+* @param	StreamPtr is the stream.
+* @param	BufferPtr is the buffer to send or to receive into.
+* @param	BufferLen is the buffer length. IN buffers can be up to
+*		(NumBufs - 1) * 16 kB long, 0 sends a zero length packet. OUT
+*		buffers can be up to 16 kB long.
+*
+* @return
+*		- XST_SUCCESS: The buffer is queued.
+*		- XST_USB_BUF_TOO_BIG: The buffer needs more descriptors than
+*		the stream has.
+*		- XST_USB_NO_DESC_AVAILABLE: Not enough free descriptors or
+*		buffer slots at the moment, retry after a completion.
+*		- XST_FAILURE: A descriptor could not be set up.
+*
+* @note		Can be called from the stream callback.
+*
+******************************************************************************/
+int XUsbPs_StreamSubmit(XUsbPs_Stream *StreamPtr, u8 *BufferPtr,
+			u32 BufferLen)
+{
+	XUsbPs_StreamXfer *Xfer;
+	XUsbPs_dTD	*First;
+	XUsbPs_dTD	*dTDPtr;
+	u32		NumdTD;
+	u32		Offset;
+	u32		Length;
+	u32		Index;
+	u32		currmask;
+	int		Status;
+
+	Xil_AssertNonvoid(StreamPtr != NULL);
+	Xil_AssertNonvoid((BufferPtr != NULL) || (BufferLen == 0));
+
+	NumdTD = (BufferLen + XUSBPS_STREAM_dTD_SIZE - 1) /
+		 XUSBPS_STREAM_dTD_SIZE;
+	if (NumdTD == 0) {
+		NumdTD = 1;
+	}
+	if ((NumdTD >= StreamPtr->NumdTD) ||
+	    ((StreamPtr->Direction == XUSBPS_EP_DIRECTION_OUT) &&
+	     (NumdTD > 1))) {
+		return XST_USB_BUF_TOO_BIG;
+	}
+
+	if (XUSBPS_BUF_IS_COHERENT(BufferPtr) != 0U) {
+		/* Order the CPU writes before the dTD is primed */
+		dsb();
+	} else if (StreamPtr->Direction == XUSBPS_EP_DIRECTION_IN) {
+		Xil_DCacheFlushRange((unsigned int)BufferPtr, BufferLen);
+	} else {
+		Xil_DCacheInvalidateRange((unsigned int)BufferPtr, BufferLen);
+	}
+
+	currmask = mfcpsr();
+	mtcpsr(currmask | XUSBPS_STREAM_IRQ_FIQ_MASK);
+
+	if (((StreamPtr->XferHead - StreamPtr->XferTail) >=
+	     XUSBPS_STREAM_MAX_XFERS) || (NumdTD >= StreamPtr->dTDFree)) {
+		mtcpsr(currmask);
+		return XST_USB_NO_DESC_AVAILABLE;
+	}
+
+	/* Fill the terminator and the descriptors after it. All but the
+	 * first one are activated right away, the controller can not reach
+	 * them before the first one is active.
+	 */
+	First = StreamPtr->dTDHead;
+	dTDPtr = First;
+	Offset = 0;
+	for (Index = 0; Index < NumdTD; Index++) {
+		Length = BufferLen - Offset;
+		if (Length > XUSBPS_STREAM_dTD_SIZE) {
+			Length = XUSBPS_STREAM_dTD_SIZE;
+		}
+
+		XUsbPs_dTDInvalidateCache(dTDPtr);
+		XUsbPs_WritedTD(dTDPtr, XUSBPS_dTDTOKEN, 0);
+		Status = XUsbPs_dTDAttachBuffer(dTDPtr, BufferPtr + Offset,
+						Length);
+		if (XST_SUCCESS != Status) {
+			XUsbPs_WritedTD(First, XUSBPS_dTDTOKEN, 0);
+			XUsbPs_dTDSetTerminate(First);
+			XUsbPs_dTDFlushCache(First);
+			mtcpsr(currmask);
+			return XST_FAILURE;
+		}
+		if (Index == (NumdTD - 1)) {
+			XUsbPs_dTDSetIOC(dTDPtr);
+		}
+		if (Index != 0) {
+			XUsbPs_dTDSetActive(dTDPtr);
+		}
+		XUsbPs_dTDClrTerminate(dTDPtr);
+		XUsbPs_dTDFlushCache(dTDPtr);
+
+		Offset += Length;
+		dTDPtr = XUsbPs_dTDGetNLP(dTDPtr);
+	}
+
+	/* dTDPtr is the new terminator. */
+	XUsbPs_dTDInvalidateCache(dTDPtr);
+	XUsbPs_WritedTD(dTDPtr, XUSBPS_dTDTOKEN, 0);
+	XUsbPs_dTDSetTerminate(dTDPtr);
+	XUsbPs_dTDFlushCache(dTDPtr);
+
+	Xfer = &StreamPtr->Xfer[StreamPtr->XferHead % XUSBPS_STREAM_MAX_XFERS];
+	Xfer->BufferPtr = BufferPtr;
+	Xfer->BufferLen = BufferLen;
+	Xfer->dTDFirst = First;
+	Xfer->NumdTD = NumdTD;
+	StreamPtr->XferHead++;
+	StreamPtr->dTDFree -= NumdTD;
+	StreamPtr->dTDHead = dTDPtr;
+
+	XUsbPs_dTDInvalidateCache(First);
+	XUsbPs_dTDSetActive(First);
+	XUsbPs_dTDFlushCache(First);
+
+	if ((StreamPtr->XferHead - StreamPtr->XferTail) == 1) {
+		/* Nothing else in flight, the endpoint is idle. */
+		XUsbPs_StreamPrime(StreamPtr, First);
+	} else {
+		XUsbPs_StreamLink(StreamPtr, First);
+	}
+
+	mtcpsr(currmask);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* This function ends streaming on an endpoint direction. Buffers still
+* queued are returned through the stream callback with XST_DATA_LOST.
+*
+* @param	StreamPtr is the stream.
+*
+* @return	None.
+*
+* @note		The callback must not submit buffers for a XST_DATA_LOST
+*		completion. OUT endpoints need XUsbPs_ReconfigureEp() before
+*		XUsbPs_EpBufferReceive() can be used on them again.
+*
+******************************************************************************/
+void XUsbPs_StreamStop(XUsbPs_Stream *StreamPtr)
+{
+	XUsbPs		*InstancePtr;
+	u32		currmask;
+	int		Timeout;
+
+	Xil_AssertVoid(StreamPtr != NULL);
+
+	InstancePtr = StreamPtr->InstancePtr;
+
+	currmask = mfcpsr();
+	mtcpsr(currmask | XUSBPS_STREAM_IRQ_FIQ_MASK);
+
+	if (StreamPtr->Direction == XUSBPS_EP_DIRECTION_IN) {
+		InstancePtr->DeviceConfig.Ep[StreamPtr->EpNum].In.Stream = NULL;
+	} else {
+		InstancePtr->DeviceConfig.Ep[StreamPtr->EpNum].Out.Stream = NULL;
+	}
+
+	XUsbPs_EpFlush(InstancePtr, StreamPtr->EpNum, StreamPtr->Direction);
+	Timeout = XUSBPS_TIMEOUT_COUNTER;
+	while ((XUsbPs_ReadReg(InstancePtr->Config.BaseAddress,
+			       XUSBPS_EPFLUSH_OFFSET) & XUSBPS_EP_ALL_MASK) &&
+	       --Timeout) {
+		/* NOP */
+	}
+
+	XUsbPs_StreamReset(StreamPtr);
+
+	mtcpsr(currmask);
+}
+
+/*****************************************************************************/
+/**
+* This function returns the number of buffers queued on a stream.
+*
+* @param	StreamPtr is the stream.
+*
+* @return	Buffers submitted and not yet returned through the callback.
+*
+******************************************************************************/
+u32 XUsbPs_StreamPending(const XUsbPs_Stream *StreamPtr)
+{
+	Xil_AssertNonvoid(StreamPtr != NULL);
+
+	return StreamPtr->XferHead - StreamPtr->XferTail;
+}
+
+/*****************************************************************************/
+/**
+* This function completes the finished buffers of a stream and restarts the
+* endpoint if it went idle with buffers queued. It is called by the
+* interrupt handler for the endpoint complete interrupt.
+*
+* @param	StreamPtr is the stream.
+*
+* @return	None.
+*
+******************************************************************************/
+void XUsbPs_StreamHandleCompl(XUsbPs_Stream *StreamPtr)
+{
+	XUsbPs		*InstancePtr = StreamPtr->InstancePtr;
+	XUsbPs_StreamXfer *Xfer;
+	XUsbPs_dTD	*dTDPtr;
+	u32		Index;
+
+	while (StreamPtr->XferTail != StreamPtr->XferHead) {
+		Xfer = &StreamPtr->Xfer[StreamPtr->XferTail %
+					XUSBPS_STREAM_MAX_XFERS];
+
+		/* The controller retires descriptors in order, the buffer is
+		 * done when its last descriptor is.
+		 */
+		dTDPtr = Xfer->dTDFirst;
+		for (Index = 1; Index < Xfer->NumdTD; Index++) {
+			dTDPtr = XUsbPs_dTDGetNLP(dTDPtr);
+		}
+		XUsbPs_dTDInvalidateCache(dTDPtr);
+		if (XUsbPs_dTDIsActive(dTDPtr)) {
+			break;
+		}
+
+		XUsbPs_StreamRetire(StreamPtr, XST_SUCCESS);
+	}
+
+	if (StreamPtr->XferTail == StreamPtr->XferHead) {
+		return;
+	}
+
+	/* Buffers are queued, make sure the controller is working on them. A
+	 * submission racing with the end of the list is caught by the
+	 * tripwire in XUsbPs_StreamLink(), this covers everything else that
+	 * leaves the endpoint unprimed.
+	 */
+	if ((XUsbPs_ReadReg(InstancePtr->Config.BaseAddress,
+			    XUSBPS_EPPRIME_OFFSET) & StreamPtr->PrimeMask) ||
+	    (XUsbPs_ReadReg(InstancePtr->Config.BaseAddress,
+			    XUSBPS_EPRDY_OFFSET) & StreamPtr->PrimeMask)) {
+		return;
+	}
+
+	Xfer = &StreamPtr->Xfer[StreamPtr->XferTail % XUSBPS_STREAM_MAX_XFERS];
+	dTDPtr = Xfer->dTDFirst;
+	for (Index = 0; Index < Xfer->NumdTD; Index++) {
+		XUsbPs_dTDInvalidateCache(dTDPtr);
+		if (XUsbPs_dTDIsActive(dTDPtr)) {
+			XUsbPs_StreamPrime(StreamPtr, dTDPtr);
+			StreamPtr->Reprimes++;
+			break;
+		}
+		dTDPtr = XUsbPs_dTDGetNLP(dTDPtr);
+	}
+}
+
+/*****************************************************************************/
+/**
+* This function returns all queued buffers of a stream with XST_DATA_LOST
+* and empties its descriptor ring. The endpoint must already be flushed. It
+* is called by XUsbPs_StreamStop() and by the interrupt handler on a bus
+* reset.
+*
+* @param	StreamPtr is the stream.
+*
+* @return	None.
+*
+******************************************************************************/
+void XUsbPs_StreamReset(XUsbPs_Stream *StreamPtr)
+{
+	while (StreamPtr->XferTail != StreamPtr->XferHead) {
+		XUsbPs_StreamRetire(StreamPtr, XST_DATA_LOST);
+	}
+
+	XUsbPs_StreamResetRing(StreamPtr);
+}
+
+/*****************************************************************************/
+/**
+* This function marks all descriptors of a stream inactive and terminated
+* and points the Queue Head at an empty list.
+*
+* @param	StreamPtr is the stream.
+*
+* @return	None.
+*
+******************************************************************************/
+static void XUsbPs_StreamResetRing(XUsbPs_Stream *StreamPtr)
+{
+	XUsbPs_dQH	*dQHPtr;
+	u32		Index;
+	u32		Token;
+
+	for (Index = 0; Index < StreamPtr->NumdTD; Index++) {
+		XUsbPs_dTDInvalidateCache(&StreamPtr->dTDs[Index]);
+		XUsbPs_WritedTD(&StreamPtr->dTDs[Index], XUSBPS_dTDTOKEN, 0);
+		XUsbPs_WritedTD(&StreamPtr->dTDs[Index], XUSBPS_dTDUSERDATA, 0);
+		XUsbPs_dTDSetTerminate(&StreamPtr->dTDs[Index]);
+		XUsbPs_dTDFlushCache(&StreamPtr->dTDs[Index]);
+	}
+
+	if (StreamPtr->Direction == XUSBPS_EP_DIRECTION_IN) {
+		dQHPtr = StreamPtr->InstancePtr->DeviceConfig.
+			 Ep[StreamPtr->EpNum].In.dQH;
+	} else {
+		dQHPtr = StreamPtr->InstancePtr->DeviceConfig.
+			 Ep[StreamPtr->EpNum].Out.dQH;
+	}
+	XUsbPs_dQHInvalidateCache(dQHPtr);
+	XUsbPs_WritedQH(dQHPtr, XUSBPS_dQHdTDNLP, XUSBPS_dTDNLP_T_MASK);
+	Token = XUsbPs_ReaddQH(dQHPtr, XUSBPS_dQHdTDTOKEN);
+	Token &= ~(XUSBPS_dTDTOKEN_ACTIVE_MASK | XUSBPS_dTDTOKEN_HALT_MASK);
+	XUsbPs_WritedQH(dQHPtr, XUSBPS_dQHdTDTOKEN, Token);
+	XUsbPs_dQHFlushCache(dQHPtr);
+
+	StreamPtr->dTDHead = &StreamPtr->dTDs[0];
+	StreamPtr->dTDFree = StreamPtr->NumdTD;
+	StreamPtr->XferHead = 0;
+	StreamPtr->XferTail = 0;
+}
+
+/*****************************************************************************/
+/**
+* This function primes the endpoint of a stream with a descriptor list.
+*
+* @param	StreamPtr is the stream.
+* @param	dTDPtr is the first descriptor for the controller.
+*
+* @return	None.
+*
+* @note		The endpoint must not be primed or ready.
+*
+******************************************************************************/
+static void XUsbPs_StreamPrime(XUsbPs_Stream *StreamPtr, XUsbPs_dTD *dTDPtr)
+{
+	XUsbPs_dQH	*dQHPtr;
+	u32		Token;
+
+	if (StreamPtr->Direction == XUSBPS_EP_DIRECTION_IN) {
+		dQHPtr = StreamPtr->InstancePtr->DeviceConfig.
+			 Ep[StreamPtr->EpNum].In.dQH;
+	} else {
+		dQHPtr = StreamPtr->InstancePtr->DeviceConfig.
+			 Ep[StreamPtr->EpNum].Out.dQH;
+	}
+
+	XUsbPs_dQHInvalidateCache(dQHPtr);
+	XUsbPs_WritedQH(dQHPtr, XUSBPS_dQHdTDNLP, dTDPtr);
+	Token = XUsbPs_ReaddQH(dQHPtr, XUSBPS_dQHdTDTOKEN);
+	Token &= ~(XUSBPS_dTDTOKEN_ACTIVE_MASK | XUSBPS_dTDTOKEN_HALT_MASK);
+	XUsbPs_WritedQH(dQHPtr, XUSBPS_dQHdTDTOKEN, Token);
+	XUsbPs_dQHFlushCache(dQHPtr);
+
+	XUsbPs_WriteReg(StreamPtr->InstancePtr->Config.BaseAddress,
+			XUSBPS_EPPRIME_OFFSET, StreamPtr->PrimeMask);
+}
+
+/*****************************************************************************/
+/**
+* This function makes sure the controller picks up a descriptor appended to
+* a list it may still be working on, using the ATDTW tripwire sequence.
+*
+* @param	StreamPtr is the stream.
+* @param	dTDPtr is the first appended descriptor.
+*
+* @return	None.
+*
+******************************************************************************/
+static void XUsbPs_StreamLink(XUsbPs_Stream *StreamPtr, XUsbPs_dTD *dTDPtr)
+{
+	u32	BaseAddress = StreamPtr->InstancePtr->Config.BaseAddress;
+	u32	RegValue;
+	u32	Ready;
+
+	/* A pending prime picks up the new descriptors. */
+	if (XUsbPs_ReadReg(BaseAddress, XUSBPS_EPPRIME_OFFSET) &
+	    StreamPtr->PrimeMask) {
+		return;
+	}
+
+	do {
+		RegValue = XUsbPs_ReadReg(BaseAddress, XUSBPS_CMD_OFFSET);
+		XUsbPs_WriteReg(BaseAddress, XUSBPS_CMD_OFFSET,
+				RegValue | XUSBPS_CMD_ATDTW_MASK);
+		Ready = XUsbPs_ReadReg(BaseAddress, XUSBPS_EPRDY_OFFSET) &
+			StreamPtr->PrimeMask;
+	} while (!(XUsbPs_ReadReg(BaseAddress, XUSBPS_CMD_OFFSET) &
+		   XUSBPS_CMD_ATDTW_MASK));
+
+	RegValue = XUsbPs_ReadReg(BaseAddress, XUSBPS_CMD_OFFSET);
+	XUsbPs_WriteReg(BaseAddress, XUSBPS_CMD_OFFSET,
+			RegValue & ~XUSBPS_CMD_ATDTW_MASK);
+
+	/* The controller already stopped at the old terminator. */
+	if (Ready == 0U) {
+		XUsbPs_StreamPrime(StreamPtr, dTDPtr);
+	}
+}
+
+/*****************************************************************************/
+/**
+* This function returns the oldest queued buffer of a stream to the caller.
+*
+* @param	StreamPtr is the stream.
+* @param	Status is passed to the callback if the descriptors report no
+*		error.
+*
+* @return	None.
+*
+******************************************************************************/
+static void XUsbPs_StreamRetire(XUsbPs_Stream *StreamPtr, s32 Status)
+{
+	XUsbPs_StreamXfer *Xfer;
+	XUsbPs_dTD	*dTDPtr;
+	u32		Remaining = 0;
+	u32		Token;
+	u32		BytesTxed;
+	u32		Index;
+
+	Xfer = &StreamPtr->Xfer[StreamPtr->XferTail % XUSBPS_STREAM_MAX_XFERS];
+
+	dTDPtr = Xfer->dTDFirst;
+	for (Index = 0; Index < Xfer->NumdTD; Index++) {
+		XUsbPs_dTDInvalidateCache(dTDPtr);
+		Token = XUsbPs_ReaddTD(dTDPtr, XUSBPS_dTDTOKEN);
+		Remaining += (Token & XUSBPS_dTDTOKEN_LEN_MASK) >> 16;
+		if ((Token & XUSBPS_STREAM_dTD_ERR_MASK) &&
+		    (Status == XST_SUCCESS)) {
+			Status = XST_FAILURE;
+		}
+		dTDPtr = XUsbPs_dTDGetNLP(dTDPtr);
+	}
+	BytesTxed = (Remaining < Xfer->BufferLen) ?
+		    (Xfer->BufferLen - Remaining) : 0;
+
+	if ((StreamPtr->Direction == XUSBPS_EP_DIRECTION_OUT) &&
+	    (BytesTxed != 0) &&
+	    (XUSBPS_BUF_IS_COHERENT(Xfer->BufferPtr) == 0U)) {
+		Xil_DCacheInvalidateRange((unsigned int)Xfer->BufferPtr,
+					  BytesTxed);
+	}
+
+	StreamPtr->dTDFree += Xfer->NumdTD;
+	StreamPtr->XferTail++;
+	StreamPtr->BytesDone += BytesTxed;
+	StreamPtr->XfersDone++;
+
+	StreamPtr->HandlerFunc(StreamPtr->HandlerRef, Xfer->BufferPtr,
+			       Xfer->BufferLen, BytesTxed, Status);
+}
+/** @} */
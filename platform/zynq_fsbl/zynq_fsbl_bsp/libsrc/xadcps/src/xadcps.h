@@ -91,6 +91,29 @@
 * device in interrupt mode.
 *
 *
+* <b> Sampling Engine </b>
+*
+* XAdcPs_GetAdcData() costs one command FIFO round trip per channel. The
+* sampling engine in xadcps_sampler.c instead runs the channel sequencer in
+* continuous mode and reads all enabled channel registers with one burst of
+* commands. The results are drained from the data FIFO threshold interrupt
+* (or by polling) into a ring of timestamped sweeps, one entry per channel
+* and sweep. XAdcPs_SamplerDecimate() reduces a number of sweeps to min, max
+* and mean per channel. While the engine runs, the application must not
+* call other driver functions that access the XADC registers through the
+* FIFOs.
+*
+*
+* <b> Thermal Governor </b>
+*
+* xadcps_thermal.c throttles the system on temperature and supply alarms.
+* A table of levels gives for every temperature band a CPU clock divisor
+* and a throttle value passed to registered workload callbacks. The alarm
+* interrupt raises the level right away, XAdcPs_ThermalUpdate() steps
+* between levels on measured temperature with hysteresis. The time spent
+* on each level is counted.
+*
+*
 * <b> Virtual Memory </b>
 *
 * This driver supports Virtual Memory. The RTOS is responsible for calculating
@@ -159,6 +182,9 @@
 *       aad    12/17/20 Added missing function declarations and removed
 *			functions with no definitions.
 * 2.7   cog    07/24/23 Added support for SDT flow
+* 2.8   pt     10/19/26 Added the sequencer sampling engine in
+*			xadcps_sampler.c.
+*			Added the thermal governor in xadcps_thermal.c.
 *
 *
 * </pre>
@@ -296,6 +322,24 @@ extern "C" {
 #define XADCPS_PD_MODE_XADC		2U  /**< Power Down ADC A and ADC B */
 /*@}*/
 
+/**
+ * @name Sampling engine
+ * @{
+ */
+#ifndef XADCPS_SAMPLER_DEPTH
+#define XADCPS_SAMPLER_DEPTH	64U /**< Sweeps in the ring, power of 2 */
+#endif
+#define XADCPS_SAMPLER_MAX_CH	26U /**< Channels the sequencer can convert */
+/*@}*/
+
+/**
+ * @name Thermal governor
+ * @{
+ */
+#define XADCPS_THERMAL_MAX_LEVELS	8U /**< Throttle levels in a table */
+#define XADCPS_THERMAL_MAX_HANDLERS	4U /**< Workload callbacks */
+/*@}*/
+
 /**************************** Type Definitions ******************************/
 
 /**
@@ -323,6 +367,81 @@ typedef struct {
 
 } XAdcPs;
 
+/**
+ * Result of XAdcPs_SamplerDecimate() for one channel.
+ */
+typedef struct {
+	u16 Min;		/**< Smallest raw value */
+	u16 Max;		/**< Largest raw value */
+	u16 Mean;		/**< Mean raw value */
+	u8  Channel;		/**< XADCPS_CH_* channel */
+} XAdcPs_SamplerStats;
+
+/**
+ * The sampling engine instance. The user allocates a variable of this type
+ * and passes it to XAdcPs_SamplerStart(). Rows of Data are written by the
+ * interrupt handler, a row becomes visible to the reader when Head moves.
+ */
+typedef struct {
+	XAdcPs *InstancePtr;	/**< Device the engine runs on */
+	u32 ChEnableMask;	/**< XADCPS_SEQ_CH_* channels sampled */
+	u8  NumCh;		/**< Number of channels in a sweep */
+	u8  Channel[XADCPS_SAMPLER_MAX_CH]; /**< XADCPS_CH_* in sweep order */
+	u8  Pos;		/**< First channel of the burst in flight */
+	u8  BurstCh;		/**< Channels read by the burst in flight */
+	u8  Continuous;		/**< Start the next sweep when one completes */
+	volatile u8 Busy;	/**< A sweep is in progress */
+	u32 Row;		/**< Row written by the sweep in progress */
+	volatile u32 Head;	/**< Sweeps published, written by the handler */
+	volatile u32 Tail;	/**< Sweeps consumed, written by the reader */
+	volatile u32 Sweeps;	/**< Completed sweeps */
+	volatile u32 Overruns;	/**< Sweeps dropped because the ring was full */
+	u64 Time[XADCPS_SAMPLER_DEPTH + 1U]; /**< Sweep completion time */
+	u16 Data[XADCPS_SAMPLER_DEPTH + 1U][XADCPS_SAMPLER_MAX_CH];
+				/**< Raw data, the extra row takes dropped sweeps */
+} XAdcPs_Sampler;
+
+/**
+ * One throttle level of the thermal governor. Levels are listed from the
+ * coolest to the hottest, level 0 (not in the table) is full performance.
+ */
+typedef struct {
+	u16 EnterRaw;		/**< Enter at or above this temperature (raw) */
+	u16 ExitRaw;		/**< Leave below this temperature (raw) */
+	u8  CpuDivisor;		/**< CPU clock divisor, 0 keeps the nominal one */
+	u8  Throttle;		/**< Value passed to the workload callbacks */
+} XAdcPs_ThermalLevel;
+
+/**
+ * Workload callback, called on every level change with the throttle value
+ * of the new level (0 at full performance).
+ */
+typedef void (*XAdcPs_ThermalHandler)(void *CallBackRef, u8 Throttle);
+
+/**
+ * The thermal governor instance.
+ */
+typedef struct {
+	XAdcPs *InstancePtr;		/**< XADC raising the alarms */
+	const XAdcPs_ThermalLevel *Levels; /**< Level table */
+	u8  NumLevels;			/**< Entries in Levels */
+	u8  Level;			/**< Current level, 0 is nominal */
+	u8  Emergency;			/**< OT or supply alarm active */
+	u8  NumHandlers;		/**< Registered callbacks */
+	u32 SupplyAlarmMask;		/**< XADCPS_INTX_ALM* supply alarms */
+	u32 NominalDivisor;		/**< CPU divisor at level 0 */
+	u32 Divisor;			/**< CPU divisor programmed */
+	XAdcPs_ThermalHandler Handler[XADCPS_THERMAL_MAX_HANDLERS];
+					/**< Workload callbacks */
+	void *HandlerRef[XADCPS_THERMAL_MAX_HANDLERS];
+					/**< Callback references */
+	u64 LastChange;			/**< XTime of the last accounting */
+	u64 LevelTime[XADCPS_THERMAL_MAX_LEVELS + 1U];
+					/**< Time per level, nominal XTime ticks */
+	u32 Transitions;		/**< Level changes */
+	u32 Alarms;			/**< Alarm interrupts handled */
+} XAdcPs_Thermal;
+
 /***************** Macros (Inline Functions) Definitions ********************/
 
 /****************************************************************************/
@@ -573,6 +692,35 @@ u32 XAdcPs_IntrGetEnabled(XAdcPs *InstancePtr);
 u32 XAdcPs_IntrGetStatus(XAdcPs *InstancePtr);
 void XAdcPs_IntrClear(XAdcPs *InstancePtr, u32 Mask);
 
+/**
+ * Functions in xadcps_sampler.c
+ */
+int XAdcPs_SamplerStart(XAdcPs *InstancePtr, XAdcPs_Sampler *SamplerPtr,
+			u32 ChEnableMask, u8 Average, int Continuous);
+void XAdcPs_SamplerStop(XAdcPs_Sampler *SamplerPtr);
+int XAdcPs_SamplerTrigger(XAdcPs_Sampler *SamplerPtr);
+void XAdcPs_SamplerIntrHandler(void *CallBackRef);
+u32 XAdcPs_SamplerPoll(XAdcPs_Sampler *SamplerPtr);
+u32 XAdcPs_SamplerAvailable(XAdcPs_Sampler *SamplerPtr);
+int XAdcPs_SamplerGetLatest(XAdcPs_Sampler *SamplerPtr, u8 Channel,
+			u16 *DataPtr, u64 *TimePtr);
+int XAdcPs_SamplerDecimate(XAdcPs_Sampler *SamplerPtr, u32 Factor,
+			XAdcPs_SamplerStats *StatsPtr, u64 *TimePtr);
+
+/**
+ * Functions in xadcps_thermal.c
+ */
+int XAdcPs_ThermalInit(XAdcPs_Thermal *ThermalPtr, XAdcPs *InstancePtr,
+			const XAdcPs_ThermalLevel *Levels, u8 NumLevels,
+			u32 SupplyAlarmMask);
+int XAdcPs_ThermalAddHandler(XAdcPs_Thermal *ThermalPtr,
+			XAdcPs_ThermalHandler FuncPtr, void *CallBackRef);
+void XAdcPs_ThermalIntrHandler(void *CallBackRef);
+void XAdcPs_ThermalUpdate(XAdcPs_Thermal *ThermalPtr, u16 TempRaw,
+			u32 AlarmStatus);
+void XAdcPs_ThermalTick(XAdcPs_Thermal *ThermalPtr);
+u64 XAdcPs_ThermalThrottledTime(XAdcPs_Thermal *ThermalPtr);
+
 
 #ifdef __cplusplus
 }
@@ -31,6 +31,8 @@
 * 1.03a bss    11/01/13 Modified macros to use correct Register offsets
 *			CR#749687
 * 2.6   aad    11/02/20 Fix MISRAC Mandatory and Advisory errors.
+* 2.8   pt     10/19/26 Added FIFO depth, threshold and level shifts and the
+*			NOP command for the sampling engine.
 *
 * </pre>
 *
@@ -78,6 +80,7 @@ extern "C" {
 #define XADCPS_CFG_ENABLE_MASK	 0x80000000U /**< Enable access from PS mask */
 #define XADCPS_CFG_CFIFOTH_MASK  0x00F00000U /**< Command FIFO Threshold mask */
 #define XADCPS_CFG_DFIFOTH_MASK  0x000F0000U /**< Data FIFO Threshold mask */
+#define XADCPS_CFG_DFIFOTH_SHIFT 16U	     /**< Data FIFO Threshold shift */
 #define XADCPS_CFG_WEDGE_MASK	 0x00002000U /**< Write Edge Mask */
 #define XADCPS_CFG_REDGE_MASK	 0x00001000U /**< Read Edge Mask */
 #define XADCPS_CFG_TCKRATE_MASK  0x00000300U /**< Clock freq control */
@@ -113,6 +116,7 @@ extern "C" {
  */
 #define XADCPS_MSTS_CFIFO_LVL_MASK  0x000F0000U /**< Command FIFO Level mask */
 #define XADCPS_MSTS_DFIFO_LVL_MASK  0x0000F000U /**< Data FIFO Level Mask  */
+#define XADCPS_MSTS_DFIFO_LVL_SHIFT 12U	 /**< Data FIFO Level shift */
 #define XADCPS_MSTS_CFIFOF_MASK     0x00000800U /**< Command FIFO Full Mask  */
 #define XADCPS_MSTS_CFIFOE_MASK     0x00000400U /**< Command FIFO Empty Mask  */
 #define XADCPS_MSTS_DFIFOF_MASK     0x00000200U /**< Data FIFO Full Mask  */
@@ -387,7 +391,9 @@ extern "C" {
 #define XADCPS_JTAG_CMD_MASK		0x3C000000U /**< Mask for the Cmd */
 #define XADCPS_JTAG_CMD_WRITE_MASK	0x08000000U /**< Mask for CMD Write */
 #define XADCPS_JTAG_CMD_READ_MASK	0x04000000U /**< Mask for CMD Read */
+#define XADCPS_JTAG_CMD_NOP_MASK	0x00000000U /**< Mask for CMD No Op */
 #define XADCPS_JTAG_CMD_SHIFT		26U	   /**< Shift for the Cmd */
+#define XADCPS_FIFO_DEPTH		15U	   /**< Command/Data FIFO depth */
 
 /*@}*/
 
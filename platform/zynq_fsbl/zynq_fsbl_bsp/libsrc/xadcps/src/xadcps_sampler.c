@@ -0,0 +1,594 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xadcps_sampler.c
+* @addtogroup Overview
+* @{
+*
+* This file contains the sequencer sampling engine of the XADC driver.
+*
+* The sequencer converts the enabled channels continuously and updates the
+* channel status registers on its own. The engine reads those registers
+* with bursts of read commands: every command written to the command FIFO
+* returns one word in the data FIFO, which holds the result of the
+* previous command. A burst for N channels is therefore N read commands
+* followed by a NOP, producing N + 1 words of which the first is dropped.
+* The data FIFO threshold is set to N so the DFIFO_GTH interrupt fires once
+* per burst instead of the CPU waiting for each round trip. Sweeps with
+* more channels than fit in the FIFO are split into several bursts.
+*
+* A sweep never reads faster than the FIFO interface allows, with
+* Continuous set the next sweep is started from the interrupt handler as
+* soon as one completes. Channels sampled faster than the sequencer
+* converts them show repeated values.
+*
+* <pre>
+*
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- -----  -------- -----------------------------------------------------
+* 2.8   pt     10/19/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xadcps.h"
+#include "xpseudo_asm.h"
+#include "xtime_l.h"
+
+/************************** Constant Definitions *****************************/
+
+/* Sequencer channel enable bits with a status register */
+#define XADCPS_SEQ_CH_VCCP_SHIFT	5U  /* VCCPINT, VCCPAUX, VCCPDRO */
+#define XADCPS_SEQ_CH_VCCP_MASK		0x000000E0U
+#define XADCPS_SEQ_CH_INT_SHIFT		8U  /* TEMP to VBRAM */
+#define XADCPS_SEQ_CH_INT_MASK		0x00007F00U
+#define XADCPS_SEQ_CH_AUX_MASK		0xFFFF0000U
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+static void XAdcPs_SamplerBeginSweep(XAdcPs_Sampler *SamplerPtr);
+static void XAdcPs_SamplerIssue(XAdcPs_Sampler *SamplerPtr);
+static void XAdcPs_SamplerDrain(XAdcPs_Sampler *SamplerPtr);
+
+/************************** Variable Definitions *****************************/
+
+
+/****************************************************************************/
+/**
+*
+* This function configures the channel sequencer for continuous cycling of
+* the given channels and initializes the sampling engine. No sweep is
+* started, use XAdcPs_SamplerTrigger() for that.
+*
+* To run from interrupts, connect XAdcPs_SamplerIntrHandler() with
+* SamplerPtr as callback reference and enable XADCPS_INTX_DFIFO_GTH_MASK
+* with XAdcPs_IntrEnable(). Otherwise call XAdcPs_SamplerPoll().
+*
+* @param	InstancePtr is a pointer to the XAdcPs instance.
+* @param	SamplerPtr is a pointer to the sampler instance.
+* @param	ChEnableMask is the bit mask of the channels to sample, formed
+*		by OR'ing XADCPS_SEQ_CH_* bits defined in xadcps_hw.h.
+* @param	Average is the hardware averaging applied to all the channels,
+*		one of the XADCPS_AVG_* definitions in xadcps.h.
+* @param	Continuous selects whether a new sweep is started as soon as
+*		one completes (TRUE) or only by XAdcPs_SamplerTrigger()
+*		(FALSE).
+*
+* @return
+*		- XST_SUCCESS if the sequencer was configured.
+*		- XST_INVALID_PARAM if ChEnableMask selects no channel with
+*		data.
+*		- XST_FAILURE if the sequencer registers could not be written.
+*
+* @note		The sequencer is switched to safe mode while it is
+*		configured.
+*
+*****************************************************************************/
+int XAdcPs_SamplerStart(XAdcPs *InstancePtr, XAdcPs_Sampler *SamplerPtr,
+			u32 ChEnableMask, u8 Average, int Continuous)
+{
+	u32 Bit;
+	u32 RegData;
+
+	/*
+	 * Assert the arguments.
+	 */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(SamplerPtr != NULL);
+	Xil_AssertNonvoid(Average <= XADCPS_AVG_256_SAMPLES);
+
+	SamplerPtr->InstancePtr = InstancePtr;
+	SamplerPtr->ChEnableMask = ChEnableMask;
+	SamplerPtr->NumCh = 0U;
+	SamplerPtr->Pos = 0U;
+	SamplerPtr->BurstCh = 0U;
+	SamplerPtr->Continuous = (Continuous != FALSE) ? 1U : 0U;
+	SamplerPtr->Busy = 0U;
+	SamplerPtr->Head = 0U;
+	SamplerPtr->Tail = 0U;
+	SamplerPtr->Sweeps = 0U;
+	SamplerPtr->Overruns = 0U;
+
+	/*
+	 * Sweep order: on chip sensors, PS supplies, auxiliary inputs
+	 */
+	for (Bit = 0U; Bit < 32U; Bit++) {
+		if ((ChEnableMask & ((u32)1U << Bit)) == 0U) {
+			continue;
+		}
+		if ((((u32)1U << Bit) & XADCPS_SEQ_CH_INT_MASK) != 0U) {
+			SamplerPtr->Channel[SamplerPtr->NumCh++] =
+				(u8)(XADCPS_CH_TEMP + Bit - XADCPS_SEQ_CH_INT_SHIFT);
+		} else if ((((u32)1U << Bit) & XADCPS_SEQ_CH_VCCP_MASK) != 0U) {
+			SamplerPtr->Channel[SamplerPtr->NumCh++] =
+				(u8)(XADCPS_CH_VCCPINT + Bit - XADCPS_SEQ_CH_VCCP_SHIFT);
+		} else if ((((u32)1U << Bit) & XADCPS_SEQ_CH_AUX_MASK) != 0U) {
+			SamplerPtr->Channel[SamplerPtr->NumCh++] = (u8)Bit;
+		} else {
+			/* Calibration, no status register */
+		}
+	}
+
+	if (SamplerPtr->NumCh == 0U) {
+		return XST_INVALID_PARAM;
+	}
+
+	/*
+	 * Reprogram the sequencer, it must be in safe mode for this
+	 */
+	XAdcPs_SetSequencerMode(InstancePtr, XADCPS_SEQ_MODE_SAFE);
+	XAdcPs_SetAvg(InstancePtr, Average);
+
+	if (XAdcPs_SetSeqAvgEnables(InstancePtr,
+			(Average != XADCPS_AVG_0_SAMPLES) ? ChEnableMask : 0U) !=
+			XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	if (XAdcPs_SetSeqChEnables(InstancePtr, ChEnableMask) != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	XAdcPs_SetSequencerMode(InstancePtr, XADCPS_SEQ_MODE_CONTINPASS);
+
+	/*
+	 * Start from empty FIFOs
+	 */
+	RegData = XAdcPs_GetMiscCtrlRegister(InstancePtr);
+	XAdcPs_SetMiscCtrlRegister(InstancePtr, RegData | XADCPS_MCTL_FLUSH_MASK);
+	XAdcPs_SetMiscCtrlRegister(InstancePtr, RegData &
+				~XADCPS_MCTL_FLUSH_MASK);
+	XAdcPs_IntrClear(InstancePtr, XADCPS_INTX_DFIFO_GTH_MASK);
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function stops the sampling engine. A burst in flight is discarded.
+* The sequencer keeps converting.
+*
+* @param	SamplerPtr is a pointer to the sampler instance.
+*
+* @return	None.
+*
+* @note		The data FIFO threshold interrupt is disabled, it has to be
+*		enabled again after the next XAdcPs_SamplerStart().
+*
+*****************************************************************************/
+void XAdcPs_SamplerStop(XAdcPs_Sampler *SamplerPtr)
+{
+	XAdcPs *InstancePtr;
+	u32 RegData;
+
+	/*
+	 * Assert the arguments.
+	 */
+	Xil_AssertVoid(SamplerPtr != NULL);
+	Xil_AssertVoid(SamplerPtr->InstancePtr != NULL);
+
+	InstancePtr = SamplerPtr->InstancePtr;
+
+	SamplerPtr->Continuous = 0U;
+	XAdcPs_IntrDisable(InstancePtr, XADCPS_INTX_DFIFO_GTH_MASK);
+
+	RegData = XAdcPs_GetMiscCtrlRegister(InstancePtr);
+	XAdcPs_SetMiscCtrlRegister(InstancePtr, RegData | XADCPS_MCTL_FLUSH_MASK);
+	XAdcPs_SetMiscCtrlRegister(InstancePtr, RegData &
+				~XADCPS_MCTL_FLUSH_MASK);
+	XAdcPs_IntrClear(InstancePtr, XADCPS_INTX_DFIFO_GTH_MASK);
+
+	SamplerPtr->Busy = 0U;
+}
+
+/****************************************************************************/
+/**
+*
+* This function starts a sweep over all the channels of the sampler.
+*
+* @param	SamplerPtr is a pointer to the sampler instance.
+*
+* @return
+*		- XST_SUCCESS if the sweep was started.
+*		- XST_DEVICE_BUSY if a sweep is in progress.
+*
+* @note		Can be called from a timer interrupt to sample at a fixed
+*		rate. In continuous mode it is only needed once.
+*
+*****************************************************************************/
+int XAdcPs_SamplerTrigger(XAdcPs_Sampler *SamplerPtr)
+{
+	/*
+	 * Assert the arguments.
+	 */
+	Xil_AssertNonvoid(SamplerPtr != NULL);
+	Xil_AssertNonvoid(SamplerPtr->NumCh != 0U);
+
+	if (SamplerPtr->Busy != 0U) {
+		return XST_DEVICE_BUSY;
+	}
+
+	SamplerPtr->Busy = 1U;
+	XAdcPs_SamplerBeginSweep(SamplerPtr);
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function is the interrupt handler of the sampling engine. It drains
+* the burst in flight and issues the next one.
+*
+* @param	CallBackRef is a pointer to the sampler instance.
+*
+* @return	None.
+*
+* @note		Alarm interrupts are left pending for the application.
+*
+*****************************************************************************/
+void XAdcPs_SamplerIntrHandler(void *CallBackRef)
+{
+	XAdcPs_Sampler *SamplerPtr = (XAdcPs_Sampler *)CallBackRef;
+	u32 Status;
+
+	Xil_AssertVoid(SamplerPtr != NULL);
+
+	Status = XAdcPs_IntrGetStatus(SamplerPtr->InstancePtr);
+	if ((Status & XADCPS_INTX_DFIFO_GTH_MASK) == 0U) {
+		return;
+	}
+
+	(void)XAdcPs_SamplerPoll(SamplerPtr);
+
+	XAdcPs_IntrClear(SamplerPtr->InstancePtr, XADCPS_INTX_DFIFO_GTH_MASK);
+}
+
+/****************************************************************************/
+/**
+*
+* This function drains the burst in flight if all its results have
+* arrived.
+*
+* @param	SamplerPtr is a pointer to the sampler instance.
+*
+* @return	1 if a burst was drained, 0 otherwise.
+*
+* @note		Used by XAdcPs_SamplerIntrHandler(), and by the application
+*		when the engine runs without interrupts.
+*
+*****************************************************************************/
+u32 XAdcPs_SamplerPoll(XAdcPs_Sampler *SamplerPtr)
+{
+	u32 Level;
+
+	Xil_AssertNonvoid(SamplerPtr != NULL);
+
+	if (SamplerPtr->Busy == 0U) {
+		return 0U;
+	}
+
+	Level = (XAdcPs_GetMiscStatus(SamplerPtr->InstancePtr) &
+			XADCPS_MSTS_DFIFO_LVL_MASK) >> XADCPS_MSTS_DFIFO_LVL_SHIFT;
+	if (Level < ((u32)SamplerPtr->BurstCh + 1U)) {
+		return 0U;
+	}
+
+	XAdcPs_SamplerDrain(SamplerPtr);
+
+	return 1U;
+}
+
+/****************************************************************************/
+/**
+*
+* This function returns the number of sweeps not yet consumed by
+* XAdcPs_SamplerDecimate().
+*
+* @param	SamplerPtr is a pointer to the sampler instance.
+*
+* @return	Number of sweeps in the ring.
+*
+* @note		None.
+*
+*****************************************************************************/
+u32 XAdcPs_SamplerAvailable(XAdcPs_Sampler *SamplerPtr)
+{
+	Xil_AssertNonvoid(SamplerPtr != NULL);
+
+	return SamplerPtr->Head - SamplerPtr->Tail;
+}
+
+/****************************************************************************/
+/**
+*
+* This function returns the most recent sample of a channel without
+* consuming it.
+*
+* @param	SamplerPtr is a pointer to the sampler instance.
+* @param	Channel is the XADCPS_CH_* channel.
+* @param	DataPtr is where the raw data is returned.
+* @param	TimePtr is where the sweep time (XTime) is returned, may be
+*		NULL.
+*
+* @return
+*		- XST_SUCCESS if a sample was returned.
+*		- XST_NO_DATA if no sweep completed yet.
+*		- XST_INVALID_PARAM if the channel is not sampled.
+*
+* @note		None.
+*
+*****************************************************************************/
+int XAdcPs_SamplerGetLatest(XAdcPs_Sampler *SamplerPtr, u8 Channel,
+			u16 *DataPtr, u64 *TimePtr)
+{
+	u32 Index;
+	u32 Row;
+	u32 Head;
+
+	Xil_AssertNonvoid(SamplerPtr != NULL);
+	Xil_AssertNonvoid(DataPtr != NULL);
+
+	Head = SamplerPtr->Head;
+	if (Head == 0U) {
+		return XST_NO_DATA;
+	}
+
+	for (Index = 0U; Index < SamplerPtr->NumCh; Index++) {
+		if (SamplerPtr->Channel[Index] == Channel) {
+			break;
+		}
+	}
+	if (Index == SamplerPtr->NumCh) {
+		return XST_INVALID_PARAM;
+	}
+
+	dmb();
+	Row = (Head - 1U) & (XADCPS_SAMPLER_DEPTH - 1U);
+	*DataPtr = SamplerPtr->Data[Row][Index];
+	if (TimePtr != NULL) {
+		*TimePtr = SamplerPtr->Time[Row];
+	}
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function consumes the oldest Factor sweeps and reduces them to the
+* minimum, maximum and mean of every channel.
+*
+* @param	SamplerPtr is a pointer to the sampler instance.
+* @param	Factor is the number of sweeps to reduce, 1 up to
+*		XADCPS_SAMPLER_DEPTH.
+* @param	StatsPtr points to an array of NumCh entries which receives
+*		the results in sweep order.
+* @param	TimePtr is where the time of the last sweep (XTime) is
+*		returned, may be NULL.
+*
+* @return
+*		- XST_SUCCESS if Factor sweeps were reduced.
+*		- XST_NO_DATA if fewer than Factor sweeps are available,
+*		nothing is consumed.
+*
+* @note		Must not be called concurrently with itself.
+*
+*****************************************************************************/
+int XAdcPs_SamplerDecimate(XAdcPs_Sampler *SamplerPtr, u32 Factor,
+			XAdcPs_SamplerStats *StatsPtr, u64 *TimePtr)
+{
+	u32 Index;
+	u32 Sweep;
+	u32 Row;
+	u32 Tail;
+	u32 Sum;
+	u16 Data;
+	u16 Min;
+	u16 Max;
+
+	Xil_AssertNonvoid(SamplerPtr != NULL);
+	Xil_AssertNonvoid(StatsPtr != NULL);
+	Xil_AssertNonvoid((Factor != 0U) && (Factor <= XADCPS_SAMPLER_DEPTH));
+
+	Tail = SamplerPtr->Tail;
+	if ((SamplerPtr->Head - Tail) < Factor) {
+		return XST_NO_DATA;
+	}
+	dmb();
+
+	for (Index = 0U; Index < SamplerPtr->NumCh; Index++) {
+		Min = 0xFFFFU;
+		Max = 0U;
+		Sum = 0U;
+		for (Sweep = 0U; Sweep < Factor; Sweep++) {
+			Row = (Tail + Sweep) & (XADCPS_SAMPLER_DEPTH - 1U);
+			Data = SamplerPtr->Data[Row][Index];
+			Min = (Data < Min) ? Data : Min;
+			Max = (Data > Max) ? Data : Max;
+			Sum += Data;
+		}
+		StatsPtr[Index].Min = Min;
+		StatsPtr[Index].Max = Max;
+		StatsPtr[Index].Mean = (u16)(Sum / Factor);
+		StatsPtr[Index].Channel = SamplerPtr->Channel[Index];
+	}
+
+	if (TimePtr != NULL) {
+		*TimePtr = SamplerPtr->Time[(Tail + Factor - 1U) &
+				(XADCPS_SAMPLER_DEPTH - 1U)];
+	}
+
+	/*
+	 * Hand the rows back to the handler
+	 */
+	dmb();
+	SamplerPtr->Tail = Tail + Factor;
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function selects the ring row for a new sweep and issues its first
+* burst. When the ring is full the sweep goes to the spare row and is
+* counted as overrun.
+*
+* @param	SamplerPtr is a pointer to the sampler instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+static void XAdcPs_SamplerBeginSweep(XAdcPs_Sampler *SamplerPtr)
+{
+	if ((SamplerPtr->Head - SamplerPtr->Tail) >= XADCPS_SAMPLER_DEPTH) {
+		SamplerPtr->Row = XADCPS_SAMPLER_DEPTH;
+	} else {
+		SamplerPtr->Row = SamplerPtr->Head & (XADCPS_SAMPLER_DEPTH - 1U);
+	}
+
+	SamplerPtr->Pos = 0U;
+	XAdcPs_SamplerIssue(SamplerPtr);
+}
+
+/****************************************************************************/
+/**
+*
+* This function writes the read commands for the next group of channels
+* and a trailing NOP to the command FIFO.
+*
+* @param	SamplerPtr is a pointer to the sampler instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+static void XAdcPs_SamplerIssue(XAdcPs_Sampler *SamplerPtr)
+{
+	XAdcPs *InstancePtr = SamplerPtr->InstancePtr;
+	u32 Count;
+	u32 Index;
+	u32 RegData;
+
+	Count = (u32)SamplerPtr->NumCh - SamplerPtr->Pos;
+	if (Count > (XADCPS_FIFO_DEPTH - 1U)) {
+		Count = XADCPS_FIFO_DEPTH - 1U;
+	}
+	SamplerPtr->BurstCh = (u8)Count;
+
+	/*
+	 * Data FIFO level above Count means the burst is complete
+	 */
+	RegData = XAdcPs_GetConfigRegister(InstancePtr) &
+			~XADCPS_CFG_DFIFOTH_MASK;
+	XAdcPs_SetConfigRegister(InstancePtr, RegData |
+			((Count << XADCPS_CFG_DFIFOTH_SHIFT) &
+			 XADCPS_CFG_DFIFOTH_MASK));
+
+	for (Index = 0U; Index < Count; Index++) {
+		XAdcPs_WriteFifo(InstancePtr, XADCPS_JTAG_CMD_READ_MASK |
+			(((XADCPS_TEMP_OFFSET +
+			   (u32)SamplerPtr->Channel[SamplerPtr->Pos + Index]) <<
+			  XADCPS_JTAG_ADDR_SHIFT) & XADCPS_JTAG_ADDR_MASK));
+	}
+	XAdcPs_WriteFifo(InstancePtr, XADCPS_JTAG_CMD_NOP_MASK);
+}
+
+/****************************************************************************/
+/**
+*
+* This function reads the results of the burst in flight. When the sweep is
+* complete it is timestamped and published, and in continuous mode the next
+* sweep is started. Otherwise the next burst of the sweep is issued.
+*
+* @param	SamplerPtr is a pointer to the sampler instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+static void XAdcPs_SamplerDrain(XAdcPs_Sampler *SamplerPtr)
+{
+	XAdcPs *InstancePtr = SamplerPtr->InstancePtr;
+	u16 *RowPtr = &SamplerPtr->Data[SamplerPtr->Row][SamplerPtr->Pos];
+	u32 Index;
+	u32 RegData;
+	XTime Now;
+
+	/*
+	 * Result of the command before the burst
+	 */
+	(void)XAdcPs_ReadFifo(InstancePtr);
+
+	for (Index = 0U; Index < SamplerPtr->BurstCh; Index++) {
+		RegData = XAdcPs_ReadFifo(InstancePtr);
+		RowPtr[Index] = (u16)(RegData & XADCPS_JTAG_DATA_MASK);
+	}
+	SamplerPtr->Pos += SamplerPtr->BurstCh;
+
+	if (SamplerPtr->Pos < SamplerPtr->NumCh) {
+		XAdcPs_SamplerIssue(SamplerPtr);
+		return;
+	}
+
+	XTime_GetTime(&Now);
+	SamplerPtr->Time[SamplerPtr->Row] = Now;
+	SamplerPtr->Sweeps++;
+
+	if (SamplerPtr->Row == XADCPS_SAMPLER_DEPTH) {
+		SamplerPtr->Overruns++;
+	} else {
+		/*
+		 * Row contents before the index that publishes it
+		 */
+		dmb();
+		SamplerPtr->Head++;
+	}
+
+	if (SamplerPtr->Continuous != 0U) {
+		XAdcPs_SamplerBeginSweep(SamplerPtr);
+	} else {
+		SamplerPtr->Busy = 0U;
+	}
+}
+/** @} */
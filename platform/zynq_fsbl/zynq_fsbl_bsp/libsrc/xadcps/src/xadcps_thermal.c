@@ -0,0 +1,431 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xadcps_thermal.c
+* @addtogroup Overview
+* @{
+*
+* This file contains the thermal governor of the XADC driver.
+*
+* The governor keeps a level between 0 (full performance) and the number of
+* entries in the level table. Every level selects a CPU clock divisor and a
+* throttle value which is passed to the registered workload callbacks.
+*
+* - The temperature alarm (ALM0) is programmed with the thresholds of the
+*   first level. Its interrupt raises the level to at least 1 without
+*   waiting for a temperature reading.
+* - Over temperature and the supply alarms selected at initialization
+*   raise the level to the hottest one until they clear.
+* - XAdcPs_ThermalUpdate() moves between levels on measured temperature. A
+*   level is entered at its EnterRaw temperature and left below its
+*   ExitRaw temperature, the band in between is the hysteresis.
+*
+* XAdcPs_ThermalTick() reads the temperature through the command FIFO. If
+* the sampling engine of xadcps_sampler.c owns the FIFO, pass its latest
+* temperature sample to XAdcPs_ThermalUpdate() instead.
+*
+* The interrupt handler and XAdcPs_ThermalUpdate() must not preempt each
+* other, call the update from a timer interrupt of the same priority or
+* with the XADC interrupt disabled.
+*
+* <pre>
+*
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- -----  -------- -----------------------------------------------------
+* 2.8   pt     10/19/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xadcps.h"
+#include "xil_cpuclk.h"
+#include "xtime_l.h"
+
+/************************** Constant Definitions *****************************/
+
+/* Alarms that force the hottest level, same bits in MSTS and INT_STS */
+#define XADCPS_THERMAL_OT_MASK	XADCPS_INTX_OT_MASK
+#define XADCPS_THERMAL_TEMP_MASK	XADCPS_INTX_ALM0_MASK
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+static void XAdcPs_ThermalAccount(XAdcPs_Thermal *ThermalPtr);
+static void XAdcPs_ThermalSetLevel(XAdcPs_Thermal *ThermalPtr, u8 Level);
+
+/************************** Variable Definitions *****************************/
+
+
+/****************************************************************************/
+/**
+*
+* This function initializes the thermal governor, programs the temperature
+* alarm and enables the alarm interrupts. The governor starts at level 0
+* with the CPU divisor found in ARM_CLK_CTRL.
+*
+* Connect XAdcPs_ThermalIntrHandler() with ThermalPtr as callback reference
+* to the XADC interrupt (XPAR_XADCPS_INT_ID) of the XScuGic.
+*
+* @param	ThermalPtr is a pointer to the governor instance.
+* @param	InstancePtr is a pointer to the XAdcPs instance.
+* @param	Levels is the level table, sorted by ascending EnterRaw. It
+*		is referenced, not copied.
+* @param	NumLevels is the number of entries, 1 to
+*		XADCPS_THERMAL_MAX_LEVELS.
+* @param	SupplyAlarmMask selects the supply alarms which force the
+*		hottest level, formed by OR'ing XADCPS_INTX_ALM1_MASK to
+*		XADCPS_INTX_ALM6_MASK. Their thresholds and enables are left
+*		to the application.
+*
+* @return
+*		- XST_SUCCESS if the governor was initialized.
+*		- XST_INVALID_PARAM if the level table is not valid.
+*
+* @note		Uses the command FIFO, call it before the sampling engine
+*		is started.
+*
+*****************************************************************************/
+int XAdcPs_ThermalInit(XAdcPs_Thermal *ThermalPtr, XAdcPs *InstancePtr,
+			const XAdcPs_ThermalLevel *Levels, u8 NumLevels,
+			u32 SupplyAlarmMask)
+{
+	u32 Index;
+	u32 IntrMask;
+
+	/*
+	 * Assert the arguments.
+	 */
+	Xil_AssertNonvoid(ThermalPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Levels != NULL);
+
+	if ((NumLevels == 0U) || (NumLevels > XADCPS_THERMAL_MAX_LEVELS)) {
+		return XST_INVALID_PARAM;
+	}
+
+	for (Index = 0U; Index < NumLevels; Index++) {
+		if ((Levels[Index].ExitRaw > Levels[Index].EnterRaw) ||
+			(Levels[Index].CpuDivisor >
+			 XIL_CPUCLK_DIVISOR_MAX)) {
+			return XST_INVALID_PARAM;
+		}
+		if ((Index > 0U) &&
+			(Levels[Index].EnterRaw <= Levels[Index - 1U].EnterRaw)) {
+			return XST_INVALID_PARAM;
+		}
+	}
+
+	ThermalPtr->InstancePtr = InstancePtr;
+	ThermalPtr->Levels = Levels;
+	ThermalPtr->NumLevels = NumLevels;
+	ThermalPtr->Level = 0U;
+	ThermalPtr->Emergency = 0U;
+	ThermalPtr->NumHandlers = 0U;
+	ThermalPtr->SupplyAlarmMask = SupplyAlarmMask &
+				~(XADCPS_THERMAL_TEMP_MASK | XADCPS_THERMAL_OT_MASK) &
+				XADCPS_INTX_ALM_ALL_MASK;
+	ThermalPtr->NominalDivisor = Xil_CpuClkGetDivisor();
+	ThermalPtr->Divisor = ThermalPtr->NominalDivisor;
+	ThermalPtr->Transitions = 0U;
+	ThermalPtr->Alarms = 0U;
+	for (Index = 0U; Index <= XADCPS_THERMAL_MAX_LEVELS; Index++) {
+		ThermalPtr->LevelTime[Index] = 0U;
+	}
+	XTime_GetTime(&ThermalPtr->LastChange);
+
+	/*
+	 * ALM0 asserts at the first level and clears below its exit
+	 * temperature
+	 */
+	XAdcPs_SetAlarmThreshold(InstancePtr, XADCPS_ATR_TEMP_UPPER,
+				Levels[0].EnterRaw);
+	XAdcPs_SetAlarmThreshold(InstancePtr, XADCPS_ATR_TEMP_LOWER,
+				Levels[0].ExitRaw);
+	XAdcPs_SetAlarmEnables(InstancePtr, XAdcPs_GetAlarmEnables(InstancePtr) |
+				XADCPS_CFR1_ALM_TEMP_MASK);
+
+	IntrMask = XADCPS_THERMAL_TEMP_MASK | XADCPS_THERMAL_OT_MASK |
+			ThermalPtr->SupplyAlarmMask;
+	XAdcPs_IntrClear(InstancePtr, IntrMask);
+	XAdcPs_IntrEnable(InstancePtr, IntrMask);
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function registers a workload callback. It is called on every level
+* change, possibly from interrupt context, and should only record the new
+* throttle value.
+*
+* @param	ThermalPtr is a pointer to the governor instance.
+* @param	FuncPtr is the callback.
+* @param	CallBackRef is passed to the callback.
+*
+* @return
+*		- XST_SUCCESS if the callback was registered.
+*		- XST_FAILURE if XADCPS_THERMAL_MAX_HANDLERS are registered.
+*
+* @note		None.
+*
+*****************************************************************************/
+int XAdcPs_ThermalAddHandler(XAdcPs_Thermal *ThermalPtr,
+			XAdcPs_ThermalHandler FuncPtr, void *CallBackRef)
+{
+	Xil_AssertNonvoid(ThermalPtr != NULL);
+	Xil_AssertNonvoid(FuncPtr != NULL);
+
+	if (ThermalPtr->NumHandlers >= XADCPS_THERMAL_MAX_HANDLERS) {
+		return XST_FAILURE;
+	}
+
+	ThermalPtr->Handler[ThermalPtr->NumHandlers] = FuncPtr;
+	ThermalPtr->HandlerRef[ThermalPtr->NumHandlers] = CallBackRef;
+	ThermalPtr->NumHandlers++;
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function is the XADC alarm interrupt handler of the governor. It
+* only reads the interrupt and alarm status registers, which are not
+* accessed through the command FIFO.
+*
+* @param	CallBackRef is a pointer to the governor instance.
+*
+* @return	None.
+*
+* @note		Interrupts not owned by the governor are left pending.
+*
+*****************************************************************************/
+void XAdcPs_ThermalIntrHandler(void *CallBackRef)
+{
+	XAdcPs_Thermal *ThermalPtr = (XAdcPs_Thermal *)CallBackRef;
+	u32 Status;
+	u32 Active;
+	u32 Critical;
+
+	Xil_AssertVoid(ThermalPtr != NULL);
+
+	Critical = XADCPS_THERMAL_OT_MASK | ThermalPtr->SupplyAlarmMask;
+
+	Status = XAdcPs_IntrGetStatus(ThermalPtr->InstancePtr) &
+			(XADCPS_THERMAL_TEMP_MASK | Critical);
+	if (Status == 0U) {
+		return;
+	}
+	XAdcPs_IntrClear(ThermalPtr->InstancePtr, Status);
+	ThermalPtr->Alarms++;
+
+	/*
+	 * The alarm outputs are live in the miscellaneous status register
+	 */
+	Active = XAdcPs_GetMiscStatus(ThermalPtr->InstancePtr) &
+			(XADCPS_MSTS_ALM_MASK | XADCPS_MSTS_OT_MASK);
+
+	if ((Active & Critical) != 0U) {
+		ThermalPtr->Emergency = 1U;
+		XAdcPs_ThermalSetLevel(ThermalPtr, ThermalPtr->NumLevels);
+	} else if (((Status & XADCPS_THERMAL_TEMP_MASK) != 0U) &&
+			(ThermalPtr->Level == 0U)) {
+		XAdcPs_ThermalSetLevel(ThermalPtr, 1U);
+	} else {
+		/* Already throttled, the next update decides */
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* This function moves the governor to the level for the given temperature
+* and alarm state.
+*
+* @param	ThermalPtr is a pointer to the governor instance.
+* @param	TempRaw is the raw on chip temperature.
+* @param	AlarmStatus is the live alarm state, XADCPS_MSTS_ALM_MASK and
+*		XADCPS_MSTS_OT_MASK bits of XAdcPs_GetMiscStatus().
+*
+* @return	None.
+*
+* @note		Does not access the XADC.
+*
+*****************************************************************************/
+void XAdcPs_ThermalUpdate(XAdcPs_Thermal *ThermalPtr, u16 TempRaw,
+			u32 AlarmStatus)
+{
+	const XAdcPs_ThermalLevel *Levels;
+	u8 Target;
+
+	Xil_AssertVoid(ThermalPtr != NULL);
+
+	Levels = ThermalPtr->Levels;
+
+	if ((AlarmStatus & (XADCPS_THERMAL_OT_MASK |
+			ThermalPtr->SupplyAlarmMask)) != 0U) {
+		ThermalPtr->Emergency = 1U;
+		XAdcPs_ThermalSetLevel(ThermalPtr, ThermalPtr->NumLevels);
+		return;
+	}
+	ThermalPtr->Emergency = 0U;
+
+	Target = ThermalPtr->Level;
+	while ((Target < ThermalPtr->NumLevels) &&
+			(TempRaw >= Levels[Target].EnterRaw)) {
+		Target++;
+	}
+	while ((Target > 0U) && (TempRaw < Levels[Target - 1U].ExitRaw)) {
+		Target--;
+	}
+
+	XAdcPs_ThermalSetLevel(ThermalPtr, Target);
+}
+
+/****************************************************************************/
+/**
+*
+* This function reads the temperature and the alarm state and updates the
+* governor. Call it periodically, the period bounds how long the governor
+* stays throttled after the board cooled down.
+*
+* @param	ThermalPtr is a pointer to the governor instance.
+*
+* @return	None.
+*
+* @note		Uses the command FIFO, see the file description.
+*
+*****************************************************************************/
+void XAdcPs_ThermalTick(XAdcPs_Thermal *ThermalPtr)
+{
+	u16 TempRaw;
+	u32 AlarmStatus;
+
+	Xil_AssertVoid(ThermalPtr != NULL);
+
+	TempRaw = XAdcPs_GetAdcData(ThermalPtr->InstancePtr, XADCPS_CH_TEMP);
+	AlarmStatus = XAdcPs_GetMiscStatus(ThermalPtr->InstancePtr) &
+			(XADCPS_MSTS_ALM_MASK | XADCPS_MSTS_OT_MASK);
+
+	XAdcPs_ThermalUpdate(ThermalPtr, TempRaw, AlarmStatus);
+}
+
+/****************************************************************************/
+/**
+*
+* This function returns the total time spent above level 0.
+*
+* @param	ThermalPtr is a pointer to the governor instance.
+*
+* @return	Time in XTime ticks at the nominal CPU clock, use
+*		COUNTS_PER_SECOND to convert.
+*
+* @note		LevelTime holds the time of every level.
+*
+*****************************************************************************/
+u64 XAdcPs_ThermalThrottledTime(XAdcPs_Thermal *ThermalPtr)
+{
+	u64 Total = 0U;
+	u32 Index;
+
+	Xil_AssertNonvoid(ThermalPtr != NULL);
+
+	XAdcPs_ThermalAccount(ThermalPtr);
+
+	for (Index = 1U; Index <= ThermalPtr->NumLevels; Index++) {
+		Total += ThermalPtr->LevelTime[Index];
+	}
+
+	return Total;
+}
+
+/****************************************************************************/
+/**
+*
+* This function adds the time since the last call to the current level.
+* The global timer runs from the CPU clock, ticks counted with a larger
+* divisor are scaled to the nominal clock.
+*
+* @param	ThermalPtr is a pointer to the governor instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+static void XAdcPs_ThermalAccount(XAdcPs_Thermal *ThermalPtr)
+{
+	XTime Now;
+	u64 Elapsed;
+
+	XTime_GetTime(&Now);
+	Elapsed = Now - ThermalPtr->LastChange;
+	ThermalPtr->LastChange = Now;
+
+	ThermalPtr->LevelTime[ThermalPtr->Level] +=
+		(Elapsed * ThermalPtr->Divisor) / ThermalPtr->NominalDivisor;
+}
+
+/****************************************************************************/
+/**
+*
+* This function applies a level: CPU clock divisor first, then the
+* workload callbacks.
+*
+* @param	ThermalPtr is a pointer to the governor instance.
+* @param	Level is the new level.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+static void XAdcPs_ThermalSetLevel(XAdcPs_Thermal *ThermalPtr, u8 Level)
+{
+	u32 Divisor = ThermalPtr->NominalDivisor;
+	u8 Throttle = 0U;
+	u32 Index;
+
+	if (Level == ThermalPtr->Level) {
+		return;
+	}
+
+	XAdcPs_ThermalAccount(ThermalPtr);
+
+	if (Level > 0U) {
+		Throttle = ThermalPtr->Levels[Level - 1U].Throttle;
+		if (ThermalPtr->Levels[Level - 1U].CpuDivisor != 0U) {
+			Divisor = ThermalPtr->Levels[Level - 1U].CpuDivisor;
+		}
+	}
+
+	if (Divisor != ThermalPtr->Divisor) {
+		if (Xil_CpuClkSetDivisor(Divisor) == XST_SUCCESS) {
+			ThermalPtr->Divisor = Divisor;
+		}
+	}
+
+	ThermalPtr->Level = Level;
+	ThermalPtr->Transitions++;
+
+	for (Index = 0U; Index < ThermalPtr->NumHandlers; Index++) {
+		ThermalPtr->Handler[Index](ThermalPtr->HandlerRef[Index],
+					Throttle);
+	}
+}
+/** @} */
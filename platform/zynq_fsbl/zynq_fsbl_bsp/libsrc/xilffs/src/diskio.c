@@ -31,6 +31,28 @@
 *		The file system can be used to read from and write to an
 *		SD card that is already formatted as FATFS.
 *
+*		Pipelined writes:
+*		If XILFFS_WRITE_PIPELINE is defined when the library is
+*		built, disk_write copies the data into one of
+*		XILFFS_WRITE_PIPELINE_BUFS buffers and returns while the
+*		SD controller writes the previous buffer with ADMA2.
+*		Writes to consecutive sectors are collected in the same
+*		buffer, up to XILFFS_WRITE_PIPELINE_SECTORS sectors, and
+*		written with one multiple block write. The card is told
+*		the block count with ACMD23 first so that it can erase
+*		ahead. disk_write only blocks when all buffers are full.
+*		disk_read waits for the writes it depends on, CTRL_SYNC
+*		(f_sync, f_close) waits for all of them. A failed write
+*		is reported by the next disk_write or CTRL_SYNC.
+*		XILFFS_GET_WRITE_STATS returns the throughput and the
+*		time disk_write was blocked.
+*		The buffers are static, XILFFS_WRITE_PIPELINE_BUFS *
+*		XILFFS_WRITE_PIPELINE_SECTORS * 512 bytes per controller.
+*		The default of 2 * 16 sectors (16 KB per controller) fits
+*		the OCM of the FSBL, an application in DDR can raise
+*		XILFFS_WRITE_PIPELINE_SECTORS to 128 for longer multiple
+*		block writes.
+*
 * <pre>
 * MODIFICATION HISTORY:
 *
@@ -71,6 +93,8 @@
 * 5.2   ap   12/05/23 Add SDT check to fix bug in disk_initialize.
 *       ap   01/11/24 Fix Doxygen warnings.
 *       sk   07/11/24 Add UFS interface support.
+* 5.5   pt   10/19/26 Add pipelined SD writes, enabled by
+*                     XILFFS_WRITE_PIPELINE.
 *
 * </pre>
 *
@@ -102,6 +126,22 @@
 #define SD_CD_DELAY		10000U		/**< SD card detection delay */
 #endif
 
+#if defined (FILE_SYSTEM_INTERFACE_SD) && defined (XPAR_XSDPS_NUM_INSTANCES) && \
+	defined (XILFFS_WRITE_PIPELINE) && (FF_FS_READONLY == 0)
+#define XILFFS_WP
+#include "xtime_l.h"
+#include "xsdps_core.h"	/* XSdPs_Reset */
+
+#ifndef XILFFS_WRITE_PIPELINE_BUFS
+#define XILFFS_WRITE_PIPELINE_BUFS	2U	/**< Write buffers per drive */
+#endif
+#ifndef XILFFS_WRITE_PIPELINE_SECTORS
+#define XILFFS_WRITE_PIPELINE_SECTORS	16U	/**< Sectors per write buffer */
+#endif
+#define XILFFS_WP_SECTOR_SIZE	512U		/**< SD sector size */
+#define XILFFS_WP_TIMEOUT	5000000U	/**< Write timeout in us */
+#endif
+
 #define XSDPS_NUM_INSTANCES	2		/**< Number of SD instances */
 
 #define XUFSPSXC_START_INDEX	3	/**< Start index of UFS instances */
@@ -152,6 +192,286 @@ static XUfsPsxc UfsInstance;
 #endif
 #endif
 
+#ifdef XILFFS_WP
+/*
+ * Write pipeline of a drive. The buffers are used in ring order, Head is
+ * the oldest one and the one being written when Busy is set.
+ */
+typedef struct {
+	LBA_t Sector[XILFFS_WRITE_PIPELINE_BUFS];	/* First sector */
+	u32 Count[XILFFS_WRITE_PIPELINE_BUFS];		/* Sectors held */
+	u32 Head;		/* Oldest buffer */
+	u32 Queued;		/* Buffers holding data */
+	u32 Busy;		/* Head is being written */
+	DRESULT Error;		/* Error of a write since the last report */
+	XTime StartTime;	/* Start of the running write */
+	XilFfs_WriteStats Stats;
+} XilFfs_WritePipe;
+
+static XilFfs_WritePipe WritePipe[XPAR_XSDPS_NUM_INSTANCES];
+static u8 WriteBuf[XPAR_XSDPS_NUM_INSTANCES][XILFFS_WRITE_PIPELINE_BUFS]
+[XILFFS_WRITE_PIPELINE_SECTORS * XILFFS_WP_SECTOR_SIZE]
+__attribute__((aligned(64)));
+#endif
+
+#ifdef XILFFS_WP
+/*-----------------------------------------------------------------------*/
+/* Write pipeline							*/
+/*-----------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+*
+* Starts the multiple block write of the oldest buffer if the controller
+* is idle.
+*
+* @param	pdrv - Drive number
+*
+* @return	None
+*
+******************************************************************************/
+static void wp_kick (
+	BYTE pdrv
+)
+{
+	XilFfs_WritePipe *Pipe = &WritePipe[pdrv];
+	XSdPs *Sd = &SdInstance[pdrv];
+	u32 Head = Pipe->Head;
+	DWORD Arg = (DWORD)Pipe->Sector[Head];
+	s32 Status;
+
+	if ((Pipe->Busy != 0U) || (Pipe->Queued == 0U)) {
+		return;
+	}
+
+	/* Convert LBA to byte address if needed */
+	if ((Sd->HCS) == 0U) {
+		Arg *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
+	}
+
+	/* Pre-erase is a hint, the write works without it */
+	if (Pipe->Count[Head] > 1U) {
+		(void)XSdPs_SetWrBlkEraseCount(Sd, Pipe->Count[Head]);
+	}
+
+	XTime_GetTime(&Pipe->StartTime);
+	if (Pipe->Stats.Transfers == 0U) {
+		Pipe->Stats.FirstTime = Pipe->StartTime;
+	}
+
+	Status = XSdPs_StartWriteTransfer(Sd, (u32)Arg, Pipe->Count[Head],
+					  WriteBuf[pdrv][Head]);
+	if (Status != XST_SUCCESS) {
+		Pipe->Error = RES_ERROR;
+		Pipe->Stats.Errors++;
+		Pipe->Head = (Head + 1U) % XILFFS_WRITE_PIPELINE_BUFS;
+		Pipe->Queued--;
+		return;
+	}
+
+	Pipe->Busy = 1U;
+	Pipe->Stats.Transfers++;
+}
+
+/*****************************************************************************/
+/**
+*
+* Checks the running write and frees its buffer when it is done.
+*
+* @param	pdrv - Drive number
+* @param	Wait - 1 to wait for the running write, 0 to return at once
+*
+* @return	None
+*
+******************************************************************************/
+static void wp_poll (
+	BYTE pdrv,
+	u32 Wait
+)
+{
+	XilFfs_WritePipe *Pipe = &WritePipe[pdrv];
+	u32 Timeout = XILFFS_WP_TIMEOUT;
+	XTime Now;
+	s32 Status;
+
+	if (Pipe->Busy == 0U) {
+		return;
+	}
+
+	Status = XSdPs_CheckWriteTransfer(&SdInstance[pdrv]);
+	while ((Status == XST_DEVICE_BUSY) && (Wait != 0U) && (Timeout > 0U)) {
+		usleep(1U);
+		Timeout--;
+		Status = XSdPs_CheckWriteTransfer(&SdInstance[pdrv]);
+	}
+	if (Status == XST_DEVICE_BUSY) {
+		if (Wait == 0U) {
+			return;
+		}
+		/*
+		 * The card does not finish the write, abort it with a reset of
+		 * the command and data lines so that the controller takes the
+		 * next command, and report the write as failed
+		 */
+		(void)XSdPs_Reset(&SdInstance[pdrv], (u8)(XSDPS_SWRST_CMD_LINE_MASK |
+				  XSDPS_SWRST_DAT_LINE_MASK));
+		SdInstance[pdrv].IsBusy = FALSE;
+		Status = XST_FAILURE;
+	}
+
+	XTime_GetTime(&Now);
+	Pipe->Stats.LastTime = Now;
+	Pipe->Stats.BusyTime += Now - Pipe->StartTime;
+	if (Status != XST_SUCCESS) {
+		Pipe->Error = RES_ERROR;
+		Pipe->Stats.Errors++;
+	}
+
+	Pipe->Busy = 0U;
+	Pipe->Head = (Pipe->Head + 1U) % XILFFS_WRITE_PIPELINE_BUFS;
+	Pipe->Queued--;
+}
+
+/*****************************************************************************/
+/**
+*
+* Waits until no buffer holds data for the given sectors and the
+* controller is idle, so that it can be used for other commands.
+*
+* @param	pdrv - Drive number
+* @param	sector - Start sector number
+* @param	count - Sector count, 0 to wait for all buffers
+*
+* @return
+*		RES_OK		All writes done so far were successful
+*		RES_ERROR	A write failed since the last report
+*
+******************************************************************************/
+static DRESULT wp_sync (
+	BYTE pdrv,
+	LBA_t sector,
+	UINT count
+)
+{
+	XilFfs_WritePipe *Pipe = &WritePipe[pdrv];
+	DRESULT res;
+	u32 Found;
+	u32 Buf;
+	u32 Index;
+
+	do {
+		wp_poll(pdrv, 1U);
+
+		Found = 0U;
+		for (Index = 0U; Index < Pipe->Queued; Index++) {
+			Buf = (Pipe->Head + Index) % XILFFS_WRITE_PIPELINE_BUFS;
+			if ((count == 0U) ||
+			    ((sector < (Pipe->Sector[Buf] + Pipe->Count[Buf])) &&
+			     (Pipe->Sector[Buf] < (sector + count)))) {
+				Found = 1U;
+			}
+		}
+
+		/* Writes are done in order, so write all up to the last hit */
+		if (Found != 0U) {
+			wp_kick(pdrv);
+		}
+	} while (Found != 0U);
+
+	res = Pipe->Error;
+	Pipe->Error = RES_OK;
+
+	return res;
+}
+
+/*****************************************************************************/
+/**
+*
+* Copies sectors into the write pipeline. Blocks only while all buffers
+* are full.
+*
+* @param	pdrv - Drive number
+* @param	buff - Pointer to the data to be written
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return
+*		RES_OK		Data queued and all writes done so far were
+*				successful
+*		RES_ERROR	A write failed since the last report
+*
+******************************************************************************/
+static DRESULT wp_write (
+	BYTE pdrv,
+	const BYTE *buff,
+	LBA_t sector,
+	UINT count
+)
+{
+	XilFfs_WritePipe *Pipe = &WritePipe[pdrv];
+	const BYTE *Src = buff;
+	LBA_t Sector = sector;
+	UINT Left = count;
+	XTime Start;
+	XTime Now;
+	DRESULT res;
+	u32 Tail;
+	u32 Num;
+
+	wp_poll(pdrv, 0U);
+	wp_kick(pdrv);
+
+	while (Left > 0U) {
+		Tail = (Pipe->Head + Pipe->Queued + XILFFS_WRITE_PIPELINE_BUFS - 1U) %
+		       XILFFS_WRITE_PIPELINE_BUFS;
+
+		/* Append to the last buffer if it is not being written yet */
+		if ((Pipe->Queued == 0U) ||
+		    ((Pipe->Busy != 0U) && (Pipe->Queued == 1U)) ||
+		    ((Pipe->Sector[Tail] + Pipe->Count[Tail]) != Sector) ||
+		    (Pipe->Count[Tail] == XILFFS_WRITE_PIPELINE_SECTORS)) {
+			if (Pipe->Queued == XILFFS_WRITE_PIPELINE_BUFS) {
+				XTime_GetTime(&Start);
+				wp_poll(pdrv, 1U);
+				XTime_GetTime(&Now);
+				Pipe->Stats.BlockedTime += Now - Start;
+				if ((Now - Start) > Pipe->Stats.MaxBlockedTime) {
+					Pipe->Stats.MaxBlockedTime = Now - Start;
+				}
+				wp_kick(pdrv);
+				continue;
+			}
+			Tail = (Pipe->Head + Pipe->Queued) % XILFFS_WRITE_PIPELINE_BUFS;
+			Pipe->Sector[Tail] = Sector;
+			Pipe->Count[Tail] = 0U;
+			Pipe->Queued++;
+		}
+
+		Num = XILFFS_WRITE_PIPELINE_SECTORS - Pipe->Count[Tail];
+		if (Num > Left) {
+			Num = Left;
+		}
+		(void)Xil_SMemCpy(&WriteBuf[pdrv][Tail][Pipe->Count[Tail] *
+					   XILFFS_WP_SECTOR_SIZE],
+				  Num * XILFFS_WP_SECTOR_SIZE, Src,
+				  Num * XILFFS_WP_SECTOR_SIZE,
+				  Num * XILFFS_WP_SECTOR_SIZE);
+		Pipe->Count[Tail] += Num;
+		Pipe->Stats.Bytes += (u64)Num * XILFFS_WP_SECTOR_SIZE;
+		Src += Num * XILFFS_WP_SECTOR_SIZE;
+		Sector += Num;
+		Left -= Num;
+
+		wp_kick(pdrv);
+	}
+
+	res = Pipe->Error;
+	Pipe->Error = RES_OK;
+
+	return res;
+}
+#endif
+
 /*-----------------------------------------------------------------------*/
 /* Get Disk Status							*/
 /*-----------------------------------------------------------------------*/
@@ -354,6 +674,12 @@ DSTATUS disk_initialize (
 		}
 
 		SdInstance[pdrv].IsReady = 0U;
+#ifdef XILFFS_WP
+		if (pdrv < XPAR_XSDPS_NUM_INSTANCES) {
+			(void)Xil_SMemSet(&WritePipe[pdrv], sizeof(WritePipe[pdrv]),
+					  0U, sizeof(WritePipe[pdrv]));
+		}
+#endif
 
 		Status = XSdPs_CfgInitialize(&SdInstance[pdrv], SdConfig,
 						 SdConfig->BaseAddress);
@@ -466,12 +792,23 @@ DRESULT disk_read (
 #ifdef FILE_SYSTEM_INTERFACE_SD
 	if (pdrv < XSDPS_NUM_INSTANCES) {
 #ifdef XPAR_XSDPS_NUM_INSTANCES
+#ifdef XILFFS_WP
+		/* Write errors are reported by disk_write and CTRL_SYNC */
+		if (pdrv < XPAR_XSDPS_NUM_INSTANCES) {
+			WritePipe[pdrv].Error |= wp_sync(pdrv, sector, count);
+		}
+#endif
 		/* Convert LBA to byte address if needed */
 		if ((SdInstance[pdrv].HCS) == 0U) {
 			LocSector *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
 		}
 
 		Status  = XSdPs_ReadPolled(&SdInstance[pdrv], (u32)LocSector, count, buff);
+#ifdef XILFFS_WP
+		if (pdrv < XPAR_XSDPS_NUM_INSTANCES) {
+			wp_kick(pdrv);
+		}
+#endif
 		if (Status != XST_SUCCESS) {
 			return RES_ERROR;
 		}
@@ -551,6 +888,11 @@ DRESULT disk_ioctl (
 	switch (cmd) {
 		case (BYTE)CTRL_SYNC :	/* Make sure that no pending write process */
 			res = RES_OK;
+#ifdef XILFFS_WP
+			if (pdrv < XPAR_XSDPS_NUM_INSTANCES) {
+				res = wp_sync(pdrv, 0U, 0U);
+			}
+#endif
 			break;
 
 		case (BYTE)GET_SECTOR_COUNT : /* Get number of sectors on the disk (DWORD) */
@@ -586,6 +928,11 @@ DRESULT disk_ioctl (
 		case (BYTE)CTRL_TRIM :	/* Erase the data */
 			if (pdrv < XSDPS_NUM_INSTANCES) {
 #ifdef XPAR_XSDPS_NUM_INSTANCES
+#ifdef XILFFS_WP
+				if (pdrv < XPAR_XSDPS_NUM_INSTANCES) {
+					WritePipe[pdrv].Error |= wp_sync(pdrv, 0U, 0U);
+				}
+#endif
 				if ((SdInstance[pdrv].HCS) == 0U) {
 					SendBuff[0] *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
 					SendBuff[1] *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
@@ -621,6 +968,20 @@ DRESULT disk_ioctl (
 			res = RES_OK;
 			break;
 
+#ifdef XILFFS_WP
+		case (BYTE)XILFFS_GET_WRITE_STATS :	/* Get and clear write statistics */
+			if (pdrv < XPAR_XSDPS_NUM_INSTANCES) {
+				*((XilFfs_WriteStats *)buff) = WritePipe[pdrv].Stats;
+				(void)Xil_SMemSet(&WritePipe[pdrv].Stats,
+						  sizeof(WritePipe[pdrv].Stats), 0U,
+						  sizeof(WritePipe[pdrv].Stats));
+				res = RES_OK;
+			} else {
+				res = RES_PARERR;
+			}
+			break;
+#endif
+
 #ifdef XPAR_XUFSPSXC_NUM_INSTANCES
 		case (BYTE)XUFSPSXC_SWITCH_BLUN :
 			Status = XUfsPsxc_SwitchBootLUN(&UfsInstance);
@@ -750,6 +1111,11 @@ DRESULT disk_write (
 #ifdef FILE_SYSTEM_INTERFACE_SD
 	if (pdrv < XSDPS_NUM_INSTANCES) {
 #ifdef XPAR_XSDPS_NUM_INSTANCES
+#ifdef XILFFS_WP
+		if (pdrv < XPAR_XSDPS_NUM_INSTANCES) {
+			return wp_write(pdrv, buff, sector, count);
+		}
+#endif
 		/* Convert LBA to byte address if needed */
 		if ((SdInstance[pdrv].HCS) == 0U) {
 			LocSector *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
@@ -35,6 +35,8 @@
 * 5.2   sk   07/11/24 Add f_ioctl interface to perform UFS specific configs.
 *       sk   07/11/24 Update drive number calculation logic to support multiple
 *                     digit drive numbers.
+* 5.5   pt   10/19/26 Add the directory entry cache, enabled by
+*                     XILFFS_DIR_CACHE.
 ******************************************************************************/
 #include "xparameters.h"
 #include "xstatus.h"
@@ -495,6 +497,20 @@ typedef struct {	/* Open object identifier with status */
 static FATFS *FatFs[FF_VOLUMES];	/* Pointer to the filesystem objects (logical drives) */
 static WORD Fsid;					/* Filesystem mount ID */
 
+#if FF_DIR_CACHE
+typedef struct {
+	WORD	id;		/* Hosting volume's mount ID (0:unused) */
+	BYTE	n_ent;	/* Number of entries in the entry block */
+	DWORD	dclust;	/* Start cluster of the directory (0:root) */
+	DWORD	hash;	/* Hash value of the name */
+	DWORD	clust;	/* Cluster, sector and offset of the top of the entry block */
+	LBA_t	sect;
+	DWORD	dptr;
+} DIRCACHE;
+static DIRCACHE DirCache[FF_DIR_CACHE];	/* Directory entry cache */
+static UINT DirCacheIdx;				/* Next cache item to be replaced */
+#endif
+
 #if FF_FS_RPATH != 0
 static BYTE CurrVol;				/* Current drive number set by f_chdrive() */
 #endif
@@ -3006,6 +3022,193 @@ static FRESULT dir_read (
 
 
 
+#if FF_DIR_CACHE
+/*-----------------------------------------------------------------------*/
+/* Directory entry cache - Hash of the name                              */
+/*-----------------------------------------------------------------------*/
+/* The hash value of a name is the sum of a hash of each character and its
+/  position, so that the LFN entries can be summed up in any order. */
+
+static DWORD dc_mix (	/* Hash value of a character at a position */
+	UINT pos,			/* Position in the name */
+	DWORD chr			/* Up-case character (0:terminator) */
+)
+{
+	DWORD h = (chr + 1) * 0x9E3779B1 + (DWORD)pos * 0x85EBCA6B;
+
+
+	h ^= h >> 15;
+	h *= 0x2C1B3C6D;
+	h ^= h >> 12;
+	return h;
+}
+
+
+static DWORD dc_name_sum (	/* Hash value of the name to be found */
+	DIR *dp
+)
+{
+	DWORD h = 0;
+	UINT i;
+#if FF_USE_LFN
+	const WCHAR *lfn = dp->obj.fs->lfnbuf;
+
+
+	for (i = 0; lfn[i]; i++) {
+		h += dc_mix(i, ff_wtoupper(lfn[i]));
+	}
+	h += dc_mix(i, 0);
+#else
+	for (i = 0; i < 11; i++) {
+		h += dc_mix(i, dp->fn[i]);
+	}
+#endif
+	return h;
+}
+
+
+static DWORD dc_sfn_sum (	/* Hash value of the name in an SFN entry (0:not hashed) */
+	const BYTE *dir			/* Pointer to the SFN entry */
+)
+{
+	DWORD h = 0;
+	UINT i;
+#if FF_USE_LFN
+	UINT n = 0;
+	BYTE c, dot = 0;
+
+
+	for (i = 0; i < 11; i++) {	/* Hash it as the name "BODY.EXT" */
+		c = dir[i];
+		if (c >= 0x80) {
+			return 0;        /* Not an ASCII name */
+		}
+		if (c == ' ') {
+			continue;
+		}
+		if (i >= 8 && !dot) {
+			h += dc_mix(n++, '.');	/* Put a dot in front of the extension */
+			dot = 1;
+		}
+		h += dc_mix(n++, ff_wtoupper(c));
+	}
+	h += dc_mix(n, 0);
+#else
+	for (i = 0; i < 11; i++) {
+		h += dc_mix(i, dir[i]);
+	}
+#endif
+	return h;
+}
+
+
+#if FF_USE_LFN
+static DWORD dc_lfn_sum (	/* Hash value of the name part in an LFN entry */
+	const BYTE *dir			/* Pointer to the LFN entry */
+)
+{
+	UINT ni, di;
+	WCHAR chr;
+	DWORD h = 0;
+
+
+	ni = (UINT)((dir[LDIR_Ord] & 0x3F) - 1) * 13;
+	for (di = 0; di < 13; di++, ni++) {
+		chr = ld_word(dir + LfnOfs[di]);
+		if (chr == 0) {
+			break;
+		}
+		h += dc_mix(ni, ff_wtoupper(chr));
+	}
+	if (dir[LDIR_Ord] & LLEF) {
+		h += dc_mix(ni, 0);	/* Terminator */
+	}
+	return h;
+}
+#endif
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Directory entry cache - Look up, store and flush                      */
+/*-----------------------------------------------------------------------*/
+
+static UINT dc_seek (	/* Number of entries to be checked at the cached location (0:not cached) */
+	DIR *dp,			/* Directory object to be moved to the cached location */
+	DWORD hash			/* Hash value of the name */
+)
+{
+	FATFS *fs = dp->obj.fs;
+	DIRCACHE *ce;
+	UINT i;
+
+
+	for (i = 0; i < FF_DIR_CACHE; i++) {
+		ce = &DirCache[i];
+		if (ce->id == fs->id && ce->hash == hash && ce->dclust == dp->obj.sclust) {
+			dp->clust = ce->clust;
+			dp->sect = ce->sect;
+			dp->dptr = ce->dptr;
+			dp->dir = fs->win + ce->dptr % SS(fs);
+			return ce->n_ent;
+		}
+	}
+	return 0;
+}
+
+
+static void dc_store (
+	DIR *dp,			/* Directory object pointing the SFN entry */
+	DWORD hash,			/* Hash value of the name */
+	DWORD clust,		/* Location of the top of the entry block */
+	LBA_t sect,
+	DWORD dptr
+)
+{
+	FATFS *fs = dp->obj.fs;
+	DIRCACHE *ce;
+	UINT i;
+
+
+	for (i = 0; i < FF_DIR_CACHE; i++) {	/* Update the item if the entry block is in the cache */
+		ce = &DirCache[i];
+		if (ce->id == fs->id && ce->dclust == dp->obj.sclust && ce->dptr == dptr) {
+			break;
+		}
+	}
+	if (i == FF_DIR_CACHE) {	/* Replace the oldest item */
+		ce = &DirCache[DirCacheIdx];
+		DirCacheIdx = (DirCacheIdx + 1) % FF_DIR_CACHE;
+	}
+	ce->id = fs->id;
+	ce->n_ent = (BYTE)((dp->dptr - dptr) / SZDIRE + 1);
+	ce->dclust = dp->obj.sclust;
+	ce->hash = hash;
+	ce->clust = clust;
+	ce->sect = sect;
+	ce->dptr = dptr;
+}
+
+
+#if !FF_FS_READONLY
+static void dc_flush (
+	FATFS *fs			/* Volume to be flushed */
+)
+{
+	UINT i;
+
+
+	for (i = 0; i < FF_DIR_CACHE; i++) {
+		if (DirCache[i].id == fs->id) {
+			DirCache[i].id = 0;
+		}
+	}
+}
+#endif
+#endif	/* FF_DIR_CACHE */
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Directory handling - Find an object in the directory                  */
 /*-----------------------------------------------------------------------*/
@@ -3019,6 +3222,15 @@ static FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
 	BYTE c;
 #if FF_USE_LFN
 	BYTE a, ord, sum;
+#endif
+#if FF_DIR_CACHE
+	DWORD hash = 0;
+	UINT n_chk = 0, cached = 0, fill = 0;
+#if FF_USE_LFN
+	DWORD bh = 0, bclust = 0;
+	LBA_t bsect = 0;
+	BYTE bord = 0xFF;
+#endif
 #endif
 
 	res = dir_sdi(dp, 0);			/* Rewind directory object */
@@ -3056,6 +3268,17 @@ static FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
 	}
 #endif
 	/* On the FAT/FAT32 volume */
+#if FF_DIR_CACHE
+#if FF_USE_LFN
+	if (!(dp->fn[NSFLAG] & NS_NOLFN))	/* Not an SFN collision check? */
+#endif
+	{
+		hash = dc_name_sum(dp);
+		cached = n_chk = dc_seek(dp, hash);	/* Go to the cached entry block if the name is in the cache */
+		fill = (n_chk == 0);		/* Cache the entries on the full scan */
+	}
+	for (;;) {
+#endif
 #if FF_USE_LFN
 	ord = sum = 0xFF;
 	dp->blk_ofs = 0xFFFFFFFF;	/* Reset LFN sequence */
@@ -3075,6 +3298,9 @@ static FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
 		if (c == DDEM || ((a & AM_VOL) && a != AM_LFN)) {	/* An entry without valid data */
 			ord = 0xFF;
 			dp->blk_ofs = 0xFFFFFFFF;	/* Reset LFN sequence */
+#if FF_DIR_CACHE
+			bord = 0xFF;
+#endif
 		}
 		else {
 			if (a == AM_LFN) {			/* Is it an LFN entry? */
@@ -3084,12 +3310,44 @@ static FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
 						ord = c;	/* Number of LFN entries */
 						dp->blk_ofs = dp->dptr;	/* Start offset of LFN */
 						sum = dp->dir[LDIR_Chksum];	/* Sum of the SFN */
+#if FF_DIR_CACHE
+						bord = c;
+						bh = 0;
+						bclust = dp->clust;
+						bsect = dp->sect;
+#endif
+					}
+#if FF_DIR_CACHE
+					if (fill) {		/* Sum up the hash value of the LFN */
+						if (c == bord && sum == dp->dir[LDIR_Chksum]) {
+							bh += dc_lfn_sum(dp->dir);
+							bord--;
+						}
+						else {
+							bord = 0xFF;
+						}
 					}
+#endif
 					/* Check validity of the LFN entry and compare it with given name */
 					ord = (c == ord && sum == dp->dir[LDIR_Chksum] && cmp_lfn(fs->lfnbuf, dp->dir)) ? ord - 1 : 0xFF;
 				}
 			}
 			else {					/* SFN entry */
+#if FF_DIR_CACHE
+				if (fill) {		/* Cache the entry block by its LFN, or by its SFN if no LFN */
+					if (dp->blk_ofs == 0xFFFFFFFF) {
+						bclust = dp->clust;
+						bsect = dp->sect;
+					}
+					if (bord != 0 || sum != sum_sfn(dp->dir)) {
+						bh = dc_sfn_sum(dp->dir);
+					}
+					if (bh != 0) {
+						dc_store(dp, bh, bclust, bsect, (dp->blk_ofs == 0xFFFFFFFF) ? dp->dptr : dp->blk_ofs);
+					}
+					bord = 0xFF;
+				}
+#endif
 				if (ord == 0 && sum == sum_sfn(dp->dir)) {
 					break;        /* LFN matched? */
 				}
@@ -3102,13 +3360,47 @@ static FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
 		}
 #else		/* Non LFN configuration */
 		dp->obj.attr = dp->dir[DIR_Attr] & AM_MASK;
+#if FF_DIR_CACHE
+		if (fill && c != DDEM && !(dp->dir[DIR_Attr] & AM_VOL)) {
+			dc_store(dp, dc_sfn_sum(dp->dir), dp->clust, dp->sect, dp->dptr);
+		}
+#endif
 		if (!(dp->dir[DIR_Attr] & AM_VOL) && !memcmp(dp->dir, dp->fn, 11)) {
 			break;        /* Is it a valid entry? */
 		}
+#endif
+#if FF_DIR_CACHE
+		if (n_chk != 0 && --n_chk == 0) {
+			res = FR_NO_FILE;	/* Not found in the cached entry block */
+			break;
+		}
 #endif
 		res = dir_next(dp, 0);	/* Next entry */
 	}
 	while (res == FR_OK);
+#if FF_DIR_CACHE
+	if (res == FR_OK || !cached) {
+		break;
+	}
+	cached = 0;		/* Not found in the cached entry block, scan the directory */
+	fill = 1;
+	res = dir_sdi(dp, 0);
+	if (res != FR_OK) {
+		break;
+	}
+	}
+	if (res == FR_OK && fill) {	/* Cache the found entry block by the name */
+#if FF_USE_LFN
+		if (dp->blk_ofs != 0xFFFFFFFF) {
+			dc_store(dp, hash, bclust, bsect, dp->blk_ofs);
+		}
+		else
+#endif
+		{
+			dc_store(dp, hash, dp->clust, dp->sect, dp->dptr);
+		}
+	}
+#endif
 
 	return res;
 }
@@ -3222,6 +3514,9 @@ dir_register (	/* FR_OK:succeeded, FR_DENIED:no free entry or too many SFN colli
 #else	/* Non LFN configuration */
 	res = dir_alloc(dp, 1);		/* Allocate an entry for SFN */
 
+#endif
+#if FF_DIR_CACHE
+	dc_flush(fs);	/* The entries may have been reallocated */
 #endif
 
 	/* Set SFN entry */
@@ -3257,7 +3552,12 @@ static FRESULT dir_remove (	/* FR_OK:Succeeded, FR_DISK_ERR:A disk error */
 	FATFS *fs = dp->obj.fs;
 #if FF_USE_LFN		/* LFN configuration */
 	DWORD last = dp->dptr;
+#endif
 
+#if FF_DIR_CACHE
+	dc_flush(fs);	/* The directory clusters may be reused */
+#endif
+#if FF_USE_LFN
 	res = (dp->blk_ofs == 0xFFFFFFFF) ? FR_OK : dir_sdi(dp, dp->blk_ofs);	/* Goto top of the entry block if LFN is exist */
 	if (res == FR_OK) {
 		do {
@@ -30,6 +30,7 @@
 #define MERGE2(a, b) a ## b
 #define CVTBL(tbl, cp) MERGE2(tbl, cp)
 
+#if !FF_LFN_ASCII	/* The tables and conversions are left out in ASCII only configuration */
 
 /*------------------------------------------------------------------------*/
 /* Code Conversion Tables                                                 */
@@ -15455,6 +15456,34 @@ WCHAR ff_oem2uni (	/* Returns Unicode character in UTF-16, zero on error */
 }
 #endif
 
+#else	/* FF_LFN_ASCII */
+
+
+
+/*------------------------------------------------------------------------*/
+/* OEM <==> Unicode Conversions for ASCII Only Configuration              */
+/*------------------------------------------------------------------------*/
+
+WCHAR ff_uni2oem (	/* Returns OEM code character, zero on error */
+	DWORD	uni,	/* UTF-16 encoded character to be converted */
+	WORD	cp		/* Code page for the conversion (not used) */
+)
+{
+	(void)cp;
+	return (uni < 0x80) ? (WCHAR)uni : 0;
+}
+
+WCHAR ff_oem2uni (	/* Returns Unicode character in UTF-16, zero on error */
+	WCHAR	oem,	/* OEM code to be converted */
+	WORD	cp		/* Code page for the conversion (not used) */
+)
+{
+	(void)cp;
+	return (oem < 0x80) ? oem : 0;
+}
+
+#endif	/* FF_LFN_ASCII */
+
 
 
 /*------------------------------------------------------------------------*/
@@ -15465,6 +15494,9 @@ DWORD ff_wtoupper (	/* Returns up-converted code point */
 	DWORD uni		/* Unicode code point to be up-converted */
 )
 {
+#if FF_LFN_ASCII
+	return (uni >= 'a' && uni <= 'z') ? uni - 0x20 : uni;
+#else
 	const WORD* p;
 	WORD uc, bc, nc, cmd;
 	static const WORD cvt1[] = {	/* Compressed up conversion table for U+0000 - U+0FFF */
@@ -15560,6 +15592,9 @@ DWORD ff_wtoupper (	/* Returns up-converted code point */
 	};
 
 
+	if (uni < 0x80) {	/* ASCII? */
+		return (uni >= 'a' && uni <= 'z') ? uni - 0x20 : uni;
+	}
 	if (uni < 0x10000) {	/* Is it in BMP? */
 		uc = (WORD)uni;
 		p = uc < 0x1000 ? cvt1 : cvt2;
@@ -15587,6 +15622,7 @@ DWORD ff_wtoupper (	/* Returns up-converted code point */
 	}
 
 	return uni;
+#endif
 }
 
 
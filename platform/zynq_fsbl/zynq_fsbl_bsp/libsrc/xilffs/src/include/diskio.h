@@ -28,6 +28,19 @@ typedef enum {
 } DRESULT;
 
 
+/* Statistics of the pipelined SD writes, times in XTime counts */
+typedef struct {
+	u64 Bytes;		/**< Bytes passed to disk_write */
+	u64 FirstTime;		/**< Start of the first write */
+	u64 LastTime;		/**< End of the last write */
+	u64 BusyTime;		/**< Time the card was writing */
+	u64 BlockedTime;	/**< Time disk_write waited for a buffer */
+	u64 MaxBlockedTime;	/**< Longest wait of disk_write */
+	u32 Transfers;		/**< Multiple block writes */
+	u32 Errors;		/**< Failed writes */
+} XilFfs_WriteStats;
+
+
 /*---------------------------------------*/
 /* Prototypes for disk control functions */
 
@@ -71,6 +84,9 @@ DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff);
 #define ISDIO_WRITE			56	/**< Write data to SD iSDIO register */
 #define ISDIO_MRITE			57	/**< Masked write data to SD iSDIO register */
 
+/* Xilinx specific ioctl command */
+#define XILFFS_GET_WRITE_STATS		60U	/**< Get and clear XilFfs_WriteStats (needs XILFFS_WRITE_PIPELINE) */
+
 /* ATA/CF specific ioctl command */
 #define ATA_GET_REV			20U	/**< Get F/W revision */
 #define ATA_GET_MODEL		21U	/**< Get model name */
@@ -68,7 +68,11 @@ extern "C" {
 /* This option switches f_mkfs(). (0:Disable or 1:Enable) */
 
 
-#define FF_USE_FASTSEEK	0
+#ifdef XILFFS_FASTSEEK
+#define FF_USE_FASTSEEK	1	/* 1:Enable */
+#else
+#define FF_USE_FASTSEEK	0	/* 0:Disable */
+#endif
 /* This option switches fast seek feature. (0:Disable or 1:Enable) */
 
 
@@ -193,6 +197,32 @@ extern "C" {
 /  the file names to read. The maximum possible length of the read file name depends
 /  on character encoding. When LFN is not enabled, these options have no effect. */
 
+
+#ifdef XILFFS_LFN_ASCII
+#define FF_LFN_ASCII	1	/* 1:ASCII only */
+#else
+#define FF_LFN_ASCII	0	/* 0:Full Unicode */
+#endif
+/* FF_LFN_ASCII = 1 limits the LFN support to 7-bit ASCII names. The code
+/  conversion tables of ffunicode.c are left out and the name compare folds
+/  ASCII case only. Names with other characters are rejected on the API and
+/  read out as '?'. Do not use it with f_mkfs() on exFAT volumes, the up-case
+/  table would be ASCII only. When LFN is not enabled, it has no effect. */
+
+
+#ifdef XILFFS_DIR_CACHE
+#define FF_DIR_CACHE	XILFFS_DIR_CACHE	/* Number of cached entries */
+#else
+#define FF_DIR_CACHE	0	/* 0:Disable */
+#endif
+/* FF_DIR_CACHE > 0 keeps the location of the last FF_DIR_CACHE directory
+/  entries found on FAT/FAT32 volumes, keyed by a hash of the name, so that
+/  opening a file again, or a file seen while an earlier lookup scanned its
+/  directory, reads the entry directly instead of scanning the directory.
+/  The cache is shared by all volumes and flushed when a directory entry is
+/  created or removed, or the volume is mounted again. It takes 24 bytes per
+/  entry. exFAT volumes are not cached. */
+
 #ifdef FILE_SYSTEM_SET_FS_RPATH
 #if FILE_SYSTEM_SET_FS_RPATH == 0
 #define FF_FS_RPATH		0U
@@ -20,6 +20,9 @@
  * Ver   Who  Date        Changes
  * ----- ---- -------- -------------------------------------------------------
  * 5.2   ht   10/10/23    Added code for versioning of library.
+ * 5.5   pt   10/19/26    Added pipelined SD writes.
+ *                       Added the ASCII only LFN profile, the directory
+ *                       entry cache and the fast seek option.
  *
  *</pre>
  *
@@ -40,7 +43,7 @@ extern "C" {
 /************************** Constant Definitions *****************************/
 /* Library version info */
 #define XILFFS_MAJOR_VERSION	5U
-#define XILFFS_MINOR_VERSION	4U
+#define XILFFS_MINOR_VERSION	5U
 
 /****************** Macros (Inline Functions) Definitions *********************/
 
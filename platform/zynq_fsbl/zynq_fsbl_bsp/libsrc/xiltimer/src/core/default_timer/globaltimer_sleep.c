@@ -213,6 +213,7 @@ u32 XilTickTimer_Init(XTimer *InstancePtr)
 	InstancePtr->XTimer_TickInterval = NULL;
 	InstancePtr->XTickTimer_Stop = NULL;
 	InstancePtr->XTickTimer_ClearInterrupt = NULL;
+	InstancePtr->XTickTimer_OneShot = NULL;
 	return XST_SUCCESS;
 }
 #endif
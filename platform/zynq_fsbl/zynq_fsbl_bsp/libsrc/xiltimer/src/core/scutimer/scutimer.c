@@ -28,6 +28,8 @@
  *                      Update XTimer_ScutimerTickInterval to add support for SDT
  *                      flow.
  *  2.0  ml    28/03/24 Added description to fix doxygen warnings
+ *  2.1  pt    19/10/26 Added XTimer_ScutimerOneShot for the tickless
+ *                      software timer wheel.
  *</pre>
  *
  *@note
@@ -56,7 +58,9 @@ static void XSleepTimer_ScutimerStop(XTimer *InstancePtr);
 
 #ifdef XTICKTIMER_IS_SCUTIMER
 void XScutimer_CallbackHandler(void *CallBackRef);
+static void XTimer_ScutimerTickStart(XTimer *InstancePtr);
 static void XTimer_ScutimerTickInterval(XTimer *InstancePtr, u32 Delay);
+static void XTimer_ScutimerOneShot(XTimer *InstancePtr, u64 Counts);
 static void XTimer_ScutimerSetIntrHandler(XTimer *InstancePtr, u8 Priority);
 static void XTickTimer_ScutimerStop(XTimer *InstancePtr);
 static void XTickTimer_ClearScutimerInterrupt(XTimer *InstancePtr);
@@ -96,6 +100,7 @@ u32 XilTickTimer_Init(XTimer *InstancePtr)
 	InstancePtr->XTimer_TickInterval = XTimer_ScutimerTickInterval;
 	InstancePtr->XTickTimer_Stop = XTickTimer_ScutimerStop;
 	InstancePtr->XTickTimer_ClearInterrupt = XTickTimer_ClearScutimerInterrupt;
+	InstancePtr->XTickTimer_OneShot = XTimer_ScutimerOneShot;
 	return XST_SUCCESS;
 }
 #endif
@@ -154,24 +159,16 @@ void XScutimer_CallbackHandler(void *CallBackRef)
 
 /*****************************************************************************/
 /**
- * This function configures the scutimer tick interval
+ * This function initializes the scutimer tick instance on first use
  *
  * @param  InstancePtr is Pointer to the XTimer instance
- * @param  Delay is the delay interval
  *
  * @return	None
  *
  ****************************************************************************/
-static void XTimer_ScutimerTickInterval(XTimer *InstancePtr, u32 Delay)
+static void XTimer_ScutimerTickStart(XTimer *InstancePtr)
 {
-	XScuTimer *ScuTimerInstPtr = &InstancePtr->ScuTimer_TickInst;
-	u32 Freq;
 	static u32 IsTickTimerStarted = FALSE;
-#ifdef SDT
-	u32 ScuTimerFreq = XSLEEPTIMER_FREQ;
-#else
-	u32 ScuTimerFreq = XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ  / 2U;
-#endif
 
 	if (FALSE == IsTickTimerStarted) {
 #ifdef SDT
@@ -183,6 +180,29 @@ static void XTimer_ScutimerTickInterval(XTimer *InstancePtr, u32 Delay)
 #endif
 		IsTickTimerStarted = TRUE;
 	}
+}
+
+/*****************************************************************************/
+/**
+ * This function configures the scutimer tick interval
+ *
+ * @param  InstancePtr is Pointer to the XTimer instance
+ * @param  Delay is the delay interval
+ *
+ * @return	None
+ *
+ ****************************************************************************/
+static void XTimer_ScutimerTickInterval(XTimer *InstancePtr, u32 Delay)
+{
+	XScuTimer *ScuTimerInstPtr = &InstancePtr->ScuTimer_TickInst;
+	u32 Freq;
+#ifdef SDT
+	u32 ScuTimerFreq = XSLEEPTIMER_FREQ;
+#else
+	u32 ScuTimerFreq = XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ  / 2U;
+#endif
+
+	XTimer_ScutimerTickStart(InstancePtr);
 	Freq = XTIMER_DELAY_MSEC / Delay;
 	XScuTimer_Stop(ScuTimerInstPtr);
 	XScuTimer_EnableAutoReload(ScuTimerInstPtr);
@@ -192,6 +212,42 @@ static void XTimer_ScutimerTickInterval(XTimer *InstancePtr, u32 Delay)
 	XScuTimer_Start(ScuTimerInstPtr);
 }
 
+/*****************************************************************************/
+/**
+ * This function arms the scutimer for a single interrupt
+ *
+ * @param  InstancePtr is Pointer to the XTimer instance
+ * @param  Counts is the delay in sleep timer counts, 0 disarms the timer
+ *
+ * @return	None
+ *
+ * @note	The scutimer runs from the same PERIPHCLK as the global timer,
+ *		so Counts is loaded unscaled. Delays beyond the 32-bit counter
+ *		are cut short, the caller re-arms for the remainder.
+ *
+ ****************************************************************************/
+static void XTimer_ScutimerOneShot(XTimer *InstancePtr, u64 Counts)
+{
+	XScuTimer *ScuTimerInstPtr = &InstancePtr->ScuTimer_TickInst;
+
+	XTimer_ScutimerTickStart(InstancePtr);
+	XScuTimer_Stop(ScuTimerInstPtr);
+	XScuTimer_DisableInterrupt(ScuTimerInstPtr);
+	XScuTimer_ClearInterruptStatus(ScuTimerInstPtr);
+	if (Counts == 0U) {
+		return;
+	}
+
+	if (Counts > MAX_COUNT) {
+		Counts = MAX_COUNT;
+	}
+	XScuTimer_DisableAutoReload(ScuTimerInstPtr);
+	XScuTimer_SetPrescaler(ScuTimerInstPtr, 0U);
+	XScuTimer_LoadTimer(ScuTimerInstPtr, (u32)Counts);
+	XScuTimer_EnableInterrupt(ScuTimerInstPtr);
+	XScuTimer_Start(ScuTimerInstPtr);
+}
+
 /*****************************************************************************/
 /**
  * This function implements the tick interrupt handler
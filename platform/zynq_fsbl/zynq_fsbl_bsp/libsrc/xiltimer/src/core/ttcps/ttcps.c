@@ -26,6 +26,8 @@
  * 1.3   asa   08/09/23 Added macros to ensure that for Zynq/CortexA9
  *                      16 bit TTC counters are used.
  * 2.0   ml    29/03/24 Added description to fix doxygen warnings.
+ * 2.1   pt    19/10/26 Added XTimer_TtcOneShot for the tickless software
+ *                      timer wheel.
  *</pre>
  *
  *@note
@@ -81,7 +83,9 @@ static void XSleepTimer_TtcStop(XTimer *InstancePtr);
 
 #ifdef XTICKTIMER_IS_TTCPS
 void XTtc_CallbackHandler(void *CallBackRef, u32 StatusEvent);
+static void XTimer_TtcTickStart(XTimer *InstancePtr);
 static void XTimer_TtcTickInterval(XTimer *InstancePtr, u32 Delay);
+static void XTimer_TtcOneShot(XTimer *InstancePtr, u64 Counts);
 static void XTimer_TtcSetIntrHandler(XTimer *InstancePtr, u8 Priority);
 static void XTickTimer_TtcStop(XTimer *InstancePtr);
 static void XTickTimer_ClearTtcInterrupt(XTimer *InstancePtr);
@@ -124,6 +128,7 @@ u32 XilTickTimer_Init(XTimer *InstancePtr)
 	InstancePtr->XTimer_TickInterval = XTimer_TtcTickInterval;
 	InstancePtr->XTickTimer_Stop = XTickTimer_TtcStop;
 	InstancePtr->XTickTimer_ClearInterrupt = XTickTimer_ClearTtcInterrupt;
+	InstancePtr->XTickTimer_OneShot = XTimer_TtcOneShot;
 #if defined  (XPM_SUPPORT)
 	InstancePtr->XTickTimer_ReleaseTickTimer = XTickTimer_ReleaseTickTimer;
 #endif
@@ -187,20 +192,15 @@ void XTtc_CallbackHandler(void *CallBackRef, u32 StatusEvent)
 
 /*****************************************************************************/
 /**
- * This function configures the scutimer tick interval
+ * This function initializes the ttcps tick instance on first use
  *
  * @param  InstancePtr is Pointer to the XTimer instance
- * @param  Delay is the delay interval
  *
  * @return	None
  *
  ****************************************************************************/
-static void XTimer_TtcTickInterval(XTimer *InstancePtr, u32 Delay)
+static void XTimer_TtcTickStart(XTimer *InstancePtr)
 {
-	XTtcPs *TtcPsInstPtr = &InstancePtr->TtcPs_TickInst;
-	static XInterval Interval;
-	static u8 Prescaler;
-	u32 Freq;
 	static u32 IsTickTimerStarted = FALSE;
 
 	if (FALSE == IsTickTimerStarted) {
@@ -213,6 +213,26 @@ static void XTimer_TtcTickInterval(XTimer *InstancePtr, u32 Delay)
 #endif
 		IsTickTimerStarted = TRUE;
 	}
+}
+
+/*****************************************************************************/
+/**
+ * This function configures the scutimer tick interval
+ *
+ * @param  InstancePtr is Pointer to the XTimer instance
+ * @param  Delay is the delay interval
+ *
+ * @return	None
+ *
+ ****************************************************************************/
+static void XTimer_TtcTickInterval(XTimer *InstancePtr, u32 Delay)
+{
+	XTtcPs *TtcPsInstPtr = &InstancePtr->TtcPs_TickInst;
+	static XInterval Interval;
+	static u8 Prescaler;
+	u32 Freq;
+
+	XTimer_TtcTickStart(InstancePtr);
 	Freq = XTIMER_DELAY_MSEC / Delay;
 	XTtcPs_SetOptions(TtcPsInstPtr, XTTCPS_OPTION_INTERVAL_MODE |
 			  XTTCPS_OPTION_WAVE_DISABLE);
@@ -223,6 +243,67 @@ static void XTimer_TtcTickInterval(XTimer *InstancePtr, u32 Delay)
 	XTtcPs_Start(TtcPsInstPtr);
 }
 
+/*****************************************************************************/
+/**
+ * This function arms the ttcps for a single interrupt
+ *
+ * @param  InstancePtr is Pointer to the XTimer instance
+ * @param  Counts is the delay in sleep timer counts, 0 disarms the timer
+ *
+ * @return	None
+ *
+ * @note	Counts is scaled to the TTC input clock and the smallest
+ *		prescaler that fits the interval counter is used. The counter
+ *		keeps running in interval mode after the interrupt, the caller
+ *		re-arms or disarms it from the handler. Delays beyond the
+ *		largest prescaler are cut short.
+ *
+ ****************************************************************************/
+static void XTimer_TtcOneShot(XTimer *InstancePtr, u64 Counts)
+{
+	XTtcPs *TtcPsInstPtr = &InstancePtr->TtcPs_TickInst;
+	u64 MaxInterval = ((u64)1U << REG_SHIFT) - 1U;
+	u64 Interval;
+	u8 Prescaler = XTTCPS_CLK_CNTRL_PS_DISABLE;
+
+	XTimer_TtcTickStart(InstancePtr);
+	XTtcPs_Stop(TtcPsInstPtr);
+	XTtcPs_DisableInterrupts(TtcPsInstPtr, XTTCPS_IXR_INTERVAL_MASK);
+	XTtcPs_ClearInterruptStatus(TtcPsInstPtr,
+				    XTtcPs_GetInterruptStatus(TtcPsInstPtr));
+	if (Counts == 0U) {
+		return;
+	}
+
+	/* Keep the scaling below 64 bits, longer delays are re-armed */
+	if (Counts > 0xFFFFFFFFU) {
+		Counts = 0xFFFFFFFFU;
+	}
+	Interval = (Counts * TtcPsInstPtr->Config.InputClockHz) /
+		   (u64)(COUNTS_PER_SECOND);
+	while ((Interval > MaxInterval) &&
+	       (Prescaler != (XTTCPS_CLK_CNTRL_PS_DISABLE - 1U))) {
+		/* Prescaler n divides the input clock by 2^(n + 1) */
+		Prescaler = (Prescaler == XTTCPS_CLK_CNTRL_PS_DISABLE) ?
+			    0U : (u8)(Prescaler + 1U);
+		Interval >>= 1U;
+	}
+	if (Interval > MaxInterval) {
+		Interval = MaxInterval;
+	}
+	if (Interval == 0U) {
+		Interval = 1U;
+	}
+
+	XTtcPs_SetOptions(TtcPsInstPtr, XTTCPS_OPTION_INTERVAL_MODE |
+			  XTTCPS_OPTION_WAVE_DISABLE);
+	XTtcPs_SetPrescaler(TtcPsInstPtr, Prescaler);
+	XTtcPs_SetInterval(TtcPsInstPtr, (XInterval)Interval);
+	XTtcPs_ResetCounterValue(TtcPsInstPtr);
+	XTtcPs_EnableInterrupts(TtcPsInstPtr, XTTCPS_IXR_INTERVAL_MASK);
+	XTtcPs_Start(TtcPsInstPtr);
+}
+
 /*****************************************************************************/
 /**
  * This function implements the tick interrupt handler
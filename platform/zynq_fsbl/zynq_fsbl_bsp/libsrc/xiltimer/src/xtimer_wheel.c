@@ -0,0 +1,737 @@
+/******************************************************************************
+* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xtimer_wheel.c
+* @addtogroup xiltimer_api XilTimer APIs
+* @{
+* @details
+*
+* This file contains the tickless software timer service.
+*
+* Any number of one shot and periodic software timers are kept on a
+* hierarchical timing wheel of XTIMER_WHEEL_LEVELS levels with
+* XTIMER_WHEEL_SLOTS slots each. Adding and cancelling a timer is O(1), a
+* timer is linked into the slot selected by how far ahead its expiry lies.
+* Timers on the upper levels are cascaded to the lower levels as the wheel
+* turns. Timers further ahead than the wheel spans are parked in the last
+* level and cascaded again until they are in reach.
+*
+* The wheel never needs a periodic tick. XTimer_WheelAdvance() jumps
+* straight from one wheel event to the next, and after every change the
+* tick timer (SCU timer or TTC, through the XTickTimer_OneShot hook) is armed
+* for the earliest deadline only. Between deadlines no interrupt is taken, so
+* the CPU can stay in WFI.
+*
+* The wheel core only works on XTime values passed by the caller:
+* XTimer_WheelInit(), XTimer_WheelAdvance() and XTimer_WheelNextDeadline()
+* with TimerPtr left NULL can be driven from a simulated clock. Calling
+* XTimer_WheelStart() hands the wheel to the tick timer interrupt.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 2.1   pt   19/10/26 Initial release.
+* </pre>
+*
+* @note
+*
+* Timer handlers run in the tick timer interrupt. A handler may add or
+* cancel any timer, including its own.
+*
+* The wheel uses XTime_GetTime() as its time base, so the sleep timer must
+* be the free running default timer (global timer on the Cortex-A9) and a
+* tick timer with one shot support must be selected.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xiltimer.h"
+#if defined (__arm__) || defined (__aarch64__) || defined (XIL_IO_MODEL)
+#include "xil_exception.h"
+#include "xpseudo_asm.h"
+#endif
+
+/************************** Constant Definitions *****************************/
+#define XTIMER_WHEEL_SLOT_MASK	((u64)XTIMER_WHEEL_SLOTS - 1U)
+#define XTIMER_WHEEL_RES	((XTime)1U << XTIMER_WHEEL_RES_SHIFT)
+
+/* Furthest expiry the wheel can hold, in wheel ticks */
+#define XTIMER_WHEEL_SPAN	(((u64)1U << (XTIMER_WHEEL_SLOT_BITS * \
+					XTIMER_WHEEL_LEVELS)) - 1U)
+
+#define XTIMER_WHEEL_NO_EVENT	(~(u64)0U)
+
+/* XIL_IO_MODEL builds run the Cortex-A9 code against device models */
+#if defined (XTIMER_IS_DEFAULT_TIMER) && !defined (XTIMER_NO_TICK_TIMER) && \
+	(defined (__arm__) || defined (__aarch64__) || defined (XIL_IO_MODEL))
+#define XTIMER_WHEEL_TICKLESS
+#endif
+
+/************************** Function Prototypes ******************************/
+static void XTimer_WheelLink(XTimer_Wheel *WheelPtr, XTimer_SwTimer *TimerPtr);
+static void XTimer_WheelUnlink(XTimer_Wheel *WheelPtr,
+			       XTimer_SwTimer *TimerPtr);
+static void XTimer_WheelCascade(XTimer_Wheel *WheelPtr, u32 Level);
+static void XTimer_WheelExpire(XTimer_Wheel *WheelPtr, XTime Now);
+static u64 XTimer_WheelNextEvent(XTimer_Wheel *WheelPtr);
+static void XTimer_WheelProgram(XTimer_Wheel *WheelPtr);
+
+/************************** Variable Definitions *****************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/*
+ * Interrupt masking around wheel updates. Only the tick timer interrupt
+ * touches the wheel, so a wheel driven by hand needs no masking.
+ */
+#ifdef XTIMER_WHEEL_TICKLESS
+#define XTimer_WheelLock(WheelPtr, Saved) \
+	do { \
+		(Saved) = mfcpsr(); \
+		if ((WheelPtr)->TimerPtr != NULL) { \
+			Xil_ExceptionDisableMask(XIL_EXCEPTION_IRQ); \
+		} \
+	} while (0)
+
+#define XTimer_WheelUnlock(WheelPtr, Saved) \
+	do { \
+		if ((WheelPtr)->TimerPtr != NULL) { \
+			mtcpsr(Saved); \
+		} \
+	} while (0)
+#else
+#define XTimer_WheelLock(WheelPtr, Saved)	((void)(Saved))
+#define XTimer_WheelUnlock(WheelPtr, Saved)	((void)(Saved))
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Rotate a slot bitmap right so that bit 0 is slot Start.
+*
+******************************************************************************/
+static inline u64 XTimer_WheelRotate(u64 Bitmap, u32 Start)
+{
+	Start &= (u32)XTIMER_WHEEL_SLOT_MASK;
+	if (Start == 0U) {
+		return Bitmap;
+	}
+	return (Bitmap >> Start) | (Bitmap << (XTIMER_WHEEL_SLOTS - Start));
+}
+
+/****************************************************************************/
+/**
+*
+* This function initializes a software timer wheel.
+*
+* @param	WheelPtr is a pointer to the wheel.
+* @param	Now is the current time in XTime counts.
+*
+* @return	None.
+*
+* @note		The wheel is driven by hand until XTimer_WheelStart() is
+*		called.
+*
+*****************************************************************************/
+void XTimer_WheelInit(XTimer_Wheel *WheelPtr, XTime Now)
+{
+	u32 Level;
+	u32 Slot;
+
+	Xil_AssertVoid(WheelPtr != NULL);
+
+	for (Level = 0U; Level < XTIMER_WHEEL_LEVELS; Level++) {
+		for (Slot = 0U; Slot < XTIMER_WHEEL_SLOTS; Slot++) {
+			WheelPtr->Slot[Level][Slot] = NULL;
+		}
+		WheelPtr->Pending[Level] = 0U;
+	}
+	WheelPtr->Expiring = NULL;
+	WheelPtr->Now = Now >> XTIMER_WHEEL_RES_SHIFT;
+	WheelPtr->TimerPtr = NULL;
+	XTimer_WheelResetStats(WheelPtr);
+}
+
+/****************************************************************************/
+/**
+*
+* This function adds a software timer to the wheel. A timer that is already
+* pending is moved to the new deadline.
+*
+* @param	WheelPtr is a pointer to the wheel.
+* @param	TimerPtr is a pointer to the caller owned timer.
+* @param	Deadline is the absolute expiry time in XTime counts. A
+*		deadline in the past expires on the next wheel tick.
+* @param	Period is the reload period in XTime counts, 0 for a one
+*		shot timer. Periodic deadlines advance by Period from the
+*		previous deadline, so they do not drift with the latency.
+* @param	FuncPtr is the handler called on expiry.
+* @param	CallBackRef is passed to the handler.
+*
+* @return	None.
+*
+* @note		A handler is never called before its deadline, and at most
+*		one wheel tick plus the interrupt latency after it.
+*
+*****************************************************************************/
+void XTimer_WheelAdd(XTimer_Wheel *WheelPtr, XTimer_SwTimer *TimerPtr,
+		     XTime Deadline, XTime Period,
+		     XTimer_SwTimerHandler FuncPtr, void *CallBackRef)
+{
+	u32 Saved = 0U;
+
+	Xil_AssertVoid(WheelPtr != NULL);
+	Xil_AssertVoid(TimerPtr != NULL);
+	Xil_AssertVoid(FuncPtr != NULL);
+
+	XTimer_WheelLock(WheelPtr, Saved);
+
+	if (TimerPtr->IsPending == (u8)TRUE) {
+		XTimer_WheelUnlink(WheelPtr, TimerPtr);
+	}
+	TimerPtr->Deadline = Deadline;
+	TimerPtr->Period = Period;
+	TimerPtr->Handler = FuncPtr;
+	TimerPtr->CallBackRef = CallBackRef;
+	TimerPtr->Expires = (Deadline + XTIMER_WHEEL_RES - 1U) >>
+			    XTIMER_WHEEL_RES_SHIFT;
+	XTimer_WheelLink(WheelPtr, TimerPtr);
+	if (WheelPtr->Expiring == NULL) {
+		/* Handlers re-adding timers are covered by the interrupt */
+		XTimer_WheelProgram(WheelPtr);
+	}
+
+	XTimer_WheelUnlock(WheelPtr, Saved);
+}
+
+/****************************************************************************/
+/**
+*
+* This function cancels a software timer. Cancelling a timer that is not
+* pending does nothing.
+*
+* @param	WheelPtr is a pointer to the wheel.
+* @param	TimerPtr is a pointer to the timer.
+*
+* @return	None.
+*
+*****************************************************************************/
+void XTimer_WheelCancel(XTimer_Wheel *WheelPtr, XTimer_SwTimer *TimerPtr)
+{
+	u32 Saved = 0U;
+
+	Xil_AssertVoid(WheelPtr != NULL);
+	Xil_AssertVoid(TimerPtr != NULL);
+
+	XTimer_WheelLock(WheelPtr, Saved);
+
+	if (TimerPtr->IsPending == (u8)TRUE) {
+		XTimer_WheelUnlink(WheelPtr, TimerPtr);
+		/*
+		 * The tick timer is left armed, an early wake up finds
+		 * nothing due and re-arms for the new earliest deadline.
+		 */
+	}
+
+	XTimer_WheelUnlock(WheelPtr, Saved);
+}
+
+/****************************************************************************/
+/**
+*
+* This function turns the wheel up to Now and calls the handlers of all
+* timers whose deadline is at or before Now.
+*
+* @param	WheelPtr is a pointer to the wheel.
+* @param	Now is the current time in XTime counts.
+*
+* @return	None.
+*
+* @note		Wheel ticks without an event are skipped, the cost depends on
+*		the number of events and not on the time elapsed.
+*
+*****************************************************************************/
+void XTimer_WheelAdvance(XTimer_Wheel *WheelPtr, XTime Now)
+{
+	XTimer_SwTimer *TimerPtr;
+	u64 Target;
+	u64 Event;
+	u32 Level;
+	u32 Slot;
+	u32 Saved = 0U;
+
+	Xil_AssertVoid(WheelPtr != NULL);
+
+	Target = Now >> XTIMER_WHEEL_RES_SHIFT;
+
+	XTimer_WheelLock(WheelPtr, Saved);
+
+	while (WheelPtr->Now <= Target) {
+		Event = XTimer_WheelNextEvent(WheelPtr);
+		if ((Event == XTIMER_WHEEL_NO_EVENT) || (Event > Target)) {
+			WheelPtr->Now = Target + 1U;
+			break;
+		}
+		WheelPtr->Now = Event;
+
+		/*
+		 * Cascade from the top so that every timer lands in its
+		 * final slot before level 0 expires
+		 */
+		for (Level = XTIMER_WHEEL_LEVELS - 1U; Level > 0U; Level--) {
+			if ((Event & (((u64)1U << (Level *
+				XTIMER_WHEEL_SLOT_BITS)) - 1U)) == 0U) {
+				XTimer_WheelCascade(WheelPtr, Level);
+			}
+		}
+
+		/*
+		 * Move the due slot aside, handlers may add and cancel
+		 * timers while it is expired
+		 */
+		Slot = (u32)(Event & XTIMER_WHEEL_SLOT_MASK);
+		WheelPtr->Expiring = WheelPtr->Slot[0][Slot];
+		WheelPtr->Slot[0][Slot] = NULL;
+		WheelPtr->Pending[0] &= ~((u64)1U << Slot);
+		for (TimerPtr = WheelPtr->Expiring; TimerPtr != NULL;
+		     TimerPtr = TimerPtr->Next) {
+			TimerPtr->Level = (u8)XTIMER_WHEEL_LEVELS;
+		}
+		WheelPtr->Now = Event + 1U;
+
+		XTimer_WheelExpire(WheelPtr, Now);
+	}
+
+	XTimer_WheelUnlock(WheelPtr, Saved);
+}
+
+/****************************************************************************/
+/**
+*
+* This function returns the earliest deadline on the wheel.
+*
+* @param	WheelPtr is a pointer to the wheel.
+* @param	DeadlinePtr is updated with the time in XTime counts at which
+*		XTimer_WheelAdvance() must be called next.
+*
+* @return	XST_SUCCESS if a timer is pending, XST_NO_DATA if the wheel is
+*		empty.
+*
+*****************************************************************************/
+u32 XTimer_WheelNextDeadline(XTimer_Wheel *WheelPtr, XTime *DeadlinePtr)
+{
+	XTimer_SwTimer *TimerPtr;
+	u64 Next = XTIMER_WHEEL_NO_EVENT;
+	u64 Rotated;
+	u64 Block;
+	u64 Base;
+	u64 Event;
+	u32 Level;
+	u32 Shift;
+	u32 Slot;
+
+	Xil_AssertNonvoid(WheelPtr != NULL);
+	Xil_AssertNonvoid(DeadlinePtr != NULL);
+
+	/* Level 0 timers expire exactly on their slot */
+	if (WheelPtr->Pending[0] != 0U) {
+		Rotated = XTimer_WheelRotate(WheelPtr->Pending[0],
+					     (u32)WheelPtr->Now);
+		Next = WheelPtr->Now + (u64)__builtin_ctzll(Rotated);
+	}
+
+	/*
+	 * Upper level slots are ordered by expiry starting at the slot of
+	 * the next block boundary, the first occupied one holds the level's
+	 * earliest timers
+	 */
+	for (Level = 1U; Level < XTIMER_WHEEL_LEVELS; Level++) {
+		if (WheelPtr->Pending[Level] == 0U) {
+			continue;
+		}
+		Shift = Level * XTIMER_WHEEL_SLOT_BITS;
+		Block = (u64)1U << Shift;
+		Base = (WheelPtr->Now + Block - 1U) >> Shift;
+		Rotated = XTimer_WheelRotate(WheelPtr->Pending[Level],
+					     (u32)Base);
+		Event = Base + (u64)__builtin_ctzll(Rotated);
+		Slot = (u32)(Event & XTIMER_WHEEL_SLOT_MASK);
+		Event <<= Shift;
+		/*
+		 * Parked timers expire beyond the slot's block, the wheel has
+		 * to wake up to cascade them further
+		 */
+		for (TimerPtr = WheelPtr->Slot[Level][Slot]; TimerPtr != NULL;
+		     TimerPtr = TimerPtr->Next) {
+			if (TimerPtr->Expires >= (Event + Block)) {
+				Next = (Event < Next) ? Event : Next;
+			} else if (TimerPtr->Expires < Next) {
+				Next = TimerPtr->Expires;
+			}
+		}
+	}
+
+	if (Next == XTIMER_WHEEL_NO_EVENT) {
+		return XST_NO_DATA;
+	}
+	if (Next < WheelPtr->Now) {
+		Next = WheelPtr->Now;
+	}
+	*DeadlinePtr = (XTime)Next << XTIMER_WHEEL_RES_SHIFT;
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function returns the expiry latency statistics.
+*
+* @param	WheelPtr is a pointer to the wheel.
+* @param	StatsPtr is updated with a copy of the statistics.
+*
+* @return	None.
+*
+*****************************************************************************/
+void XTimer_WheelGetStats(XTimer_Wheel *WheelPtr, XTimer_WheelStats *StatsPtr)
+{
+	u32 Saved = 0U;
+
+	Xil_AssertVoid(WheelPtr != NULL);
+	Xil_AssertVoid(StatsPtr != NULL);
+
+	XTimer_WheelLock(WheelPtr, Saved);
+	*StatsPtr = WheelPtr->Stats;
+	XTimer_WheelUnlock(WheelPtr, Saved);
+}
+
+/****************************************************************************/
+/**
+*
+* This function clears the expiry latency statistics.
+*
+* @param	WheelPtr is a pointer to the wheel.
+*
+* @return	None.
+*
+*****************************************************************************/
+void XTimer_WheelResetStats(XTimer_Wheel *WheelPtr)
+{
+	u32 Saved = 0U;
+
+	Xil_AssertVoid(WheelPtr != NULL);
+
+	XTimer_WheelLock(WheelPtr, Saved);
+	WheelPtr->Stats.Expired = 0U;
+	WheelPtr->Stats.MinLatency = ~(XTime)0U;
+	WheelPtr->Stats.MaxLatency = 0U;
+	WheelPtr->Stats.SumLatency = 0U;
+	XTimer_WheelUnlock(WheelPtr, Saved);
+}
+
+#ifdef XTIMER_WHEEL_TICKLESS
+/****************************************************************************/
+/**
+*
+* This function hands the wheel to the tick timer. From here on the wheel is
+* turned from the tick timer interrupt and the tick timer is armed for the
+* earliest deadline after every change.
+*
+* @param	WheelPtr is a pointer to an initialized wheel.
+* @param	Priority is the tick timer interrupt priority.
+*
+* @return	XST_SUCCESS if the tick timer was set up, XST_FAILURE if the
+*		selected tick timer has no one shot support.
+*
+* @note		The tick timer callback of XTimer_SetHandler() is taken over
+*		by the wheel.
+*
+*****************************************************************************/
+u32 XTimer_WheelStart(XTimer_Wheel *WheelPtr, u8 Priority)
+{
+	XTimer *InstancePtr = &TimerInst;
+	u32 Saved;
+
+	Xil_AssertNonvoid(WheelPtr != NULL);
+
+	if (InstancePtr->XTickTimer_OneShot == NULL) {
+		return XST_FAILURE;
+	}
+
+	/* Initializes the tick timer and leaves it disarmed */
+	InstancePtr->XTickTimer_OneShot(InstancePtr, 0U);
+	XTimer_SetHandler(XTimer_WheelIntrHandler, WheelPtr, Priority);
+
+	WheelPtr->TimerPtr = InstancePtr;
+	XTimer_WheelLock(WheelPtr, Saved);
+	XTimer_WheelProgram(WheelPtr);
+	XTimer_WheelUnlock(WheelPtr, Saved);
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function is the tick timer callback of a started wheel. It expires
+* the due timers and arms the tick timer for the next deadline.
+*
+* @param	CallBackRef is a pointer to the wheel.
+* @param	StatusEvent is unused.
+*
+* @return	None.
+*
+*****************************************************************************/
+void XTimer_WheelIntrHandler(void *CallBackRef, u32 StatusEvent)
+{
+	XTimer_Wheel *WheelPtr = (XTimer_Wheel *)CallBackRef;
+	XTime Now;
+
+	(void)StatusEvent;
+
+	XTime_GetTime(&Now);
+	XTimer_WheelAdvance(WheelPtr, Now);
+	XTimer_WheelProgram(WheelPtr);
+}
+#else
+u32 XTimer_WheelStart(XTimer_Wheel *WheelPtr, u8 Priority)
+{
+	(void)WheelPtr;
+	(void)Priority;
+
+	return XST_FAILURE;
+}
+
+void XTimer_WheelIntrHandler(void *CallBackRef, u32 StatusEvent)
+{
+	(void)CallBackRef;
+	(void)StatusEvent;
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Link a timer into the slot for its expiry relative to the wheel position.
+*
+******************************************************************************/
+static void XTimer_WheelLink(XTimer_Wheel *WheelPtr, XTimer_SwTimer *TimerPtr)
+{
+	XTimer_SwTimer **HeadPtr;
+	u64 Expires = TimerPtr->Expires;
+	u64 Delta;
+	u32 Level;
+	u32 Slot;
+
+	if (Expires < WheelPtr->Now) {
+		Expires = WheelPtr->Now;
+	}
+	Delta = Expires - WheelPtr->Now;
+	if (Delta > XTIMER_WHEEL_SPAN) {
+		/* Parked on the last level, cascaded again when reached */
+		Expires = WheelPtr->Now + XTIMER_WHEEL_SPAN;
+		Delta = XTIMER_WHEEL_SPAN;
+	}
+
+	Level = 0U;
+	while ((Level < (XTIMER_WHEEL_LEVELS - 1U)) &&
+	       ((Delta >> ((Level + 1U) * XTIMER_WHEEL_SLOT_BITS)) != 0U)) {
+		Level++;
+	}
+	Slot = (u32)((Expires >> (Level * XTIMER_WHEEL_SLOT_BITS)) &
+		     XTIMER_WHEEL_SLOT_MASK);
+
+	HeadPtr = &WheelPtr->Slot[Level][Slot];
+	TimerPtr->Prev = NULL;
+	TimerPtr->Next = *HeadPtr;
+	if (*HeadPtr != NULL) {
+		(*HeadPtr)->Prev = TimerPtr;
+	}
+	*HeadPtr = TimerPtr;
+	WheelPtr->Pending[Level] |= (u64)1U << Slot;
+
+	TimerPtr->Level = (u8)Level;
+	TimerPtr->Slot = (u8)Slot;
+	TimerPtr->IsPending = (u8)TRUE;
+}
+
+/*****************************************************************************/
+/**
+*
+* Unlink a pending timer from its slot or from the expiring list.
+*
+******************************************************************************/
+static void XTimer_WheelUnlink(XTimer_Wheel *WheelPtr,
+			       XTimer_SwTimer *TimerPtr)
+{
+	XTimer_SwTimer **HeadPtr;
+
+	if (TimerPtr->Level == (u8)XTIMER_WHEEL_LEVELS) {
+		HeadPtr = &WheelPtr->Expiring;
+	} else {
+		HeadPtr = &WheelPtr->Slot[TimerPtr->Level][TimerPtr->Slot];
+	}
+
+	if (TimerPtr->Prev != NULL) {
+		TimerPtr->Prev->Next = TimerPtr->Next;
+	} else {
+		*HeadPtr = TimerPtr->Next;
+	}
+	if (TimerPtr->Next != NULL) {
+		TimerPtr->Next->Prev = TimerPtr->Prev;
+	}
+	if ((TimerPtr->Level != (u8)XTIMER_WHEEL_LEVELS) &&
+	    (*HeadPtr == NULL)) {
+		WheelPtr->Pending[TimerPtr->Level] &=
+			~((u64)1U << TimerPtr->Slot);
+	}
+
+	TimerPtr->Next = NULL;
+	TimerPtr->Prev = NULL;
+	TimerPtr->IsPending = (u8)FALSE;
+}
+
+/*****************************************************************************/
+/**
+*
+* Redistribute the current slot of an upper level over the lower levels.
+*
+******************************************************************************/
+static void XTimer_WheelCascade(XTimer_Wheel *WheelPtr, u32 Level)
+{
+	XTimer_SwTimer *TimerPtr;
+	XTimer_SwTimer *NextPtr;
+	u32 Slot;
+
+	Slot = (u32)((WheelPtr->Now >> (Level * XTIMER_WHEEL_SLOT_BITS)) &
+		     XTIMER_WHEEL_SLOT_MASK);
+	TimerPtr = WheelPtr->Slot[Level][Slot];
+	WheelPtr->Slot[Level][Slot] = NULL;
+	WheelPtr->Pending[Level] &= ~((u64)1U << Slot);
+
+	while (TimerPtr != NULL) {
+		NextPtr = TimerPtr->Next;
+		XTimer_WheelLink(WheelPtr, TimerPtr);
+		TimerPtr = NextPtr;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Call the handlers of the timers on the expiring list. Now is the simulated
+* time of a wheel driven by hand, a started wheel reads the time before each
+* handler so that the latency includes the time spent in earlier handlers.
+*
+******************************************************************************/
+static void XTimer_WheelExpire(XTimer_Wheel *WheelPtr, XTime Now)
+{
+	XTimer_SwTimer *TimerPtr;
+	XTimer_WheelStats *StatsPtr = &WheelPtr->Stats;
+	XTime Latency;
+
+	while (WheelPtr->Expiring != NULL) {
+		TimerPtr = WheelPtr->Expiring;
+		XTimer_WheelUnlink(WheelPtr, TimerPtr);
+
+#ifdef XTIMER_WHEEL_TICKLESS
+		if (WheelPtr->TimerPtr != NULL) {
+			XTime_GetTime(&Now);
+		}
+#endif
+
+		Latency = (Now > TimerPtr->Deadline) ?
+			  (Now - TimerPtr->Deadline) : 0U;
+		StatsPtr->Expired++;
+		StatsPtr->SumLatency += Latency;
+		if (Latency < StatsPtr->MinLatency) {
+			StatsPtr->MinLatency = Latency;
+		}
+		if (Latency > StatsPtr->MaxLatency) {
+			StatsPtr->MaxLatency = Latency;
+		}
+
+		if (TimerPtr->Period != 0U) {
+			TimerPtr->Deadline += TimerPtr->Period;
+			TimerPtr->Expires = (TimerPtr->Deadline +
+					     XTIMER_WHEEL_RES - 1U) >>
+					    XTIMER_WHEEL_RES_SHIFT;
+			XTimer_WheelLink(WheelPtr, TimerPtr);
+		}
+
+		TimerPtr->Handler(TimerPtr->CallBackRef);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Return the next wheel tick at which a slot expires or cascades.
+*
+******************************************************************************/
+static u64 XTimer_WheelNextEvent(XTimer_Wheel *WheelPtr)
+{
+	u64 Next = XTIMER_WHEEL_NO_EVENT;
+	u64 Event;
+	u64 Block;
+	u64 Base;
+	u32 Level;
+	u32 Shift;
+
+	for (Level = 0U; Level < XTIMER_WHEEL_LEVELS; Level++) {
+		if (WheelPtr->Pending[Level] == 0U) {
+			continue;
+		}
+		Shift = Level * XTIMER_WHEEL_SLOT_BITS;
+		Block = (u64)1U << Shift;
+		Base = (WheelPtr->Now + Block - 1U) >> Shift;
+		Event = (Base + (u64)__builtin_ctzll(XTimer_WheelRotate(
+				WheelPtr->Pending[Level], (u32)Base))) << Shift;
+		if (Event < Next) {
+			Next = Event;
+		}
+	}
+
+	return Next;
+}
+
+/*****************************************************************************/
+/**
+*
+* Arm the tick timer for the earliest deadline, or disarm it when the wheel
+* is empty. Deadlines already passed are expired first.
+*
+******************************************************************************/
+static void XTimer_WheelProgram(XTimer_Wheel *WheelPtr)
+{
+#ifdef XTIMER_WHEEL_TICKLESS
+	XTimer *InstancePtr = WheelPtr->TimerPtr;
+	XTime Deadline;
+	XTime Now;
+
+	if (InstancePtr == NULL) {
+		return;
+	}
+
+	while (XTimer_WheelNextDeadline(WheelPtr, &Deadline) == XST_SUCCESS) {
+		XTime_GetTime(&Now);
+		if (Deadline > Now) {
+			InstancePtr->XTickTimer_OneShot(InstancePtr,
+							Deadline - Now);
+			return;
+		}
+		XTimer_WheelAdvance(WheelPtr, Now);
+	}
+	InstancePtr->XTickTimer_OneShot(InstancePtr, 0U);
+#else
+	(void)WheelPtr;
+#endif
+}
+/*@}*/
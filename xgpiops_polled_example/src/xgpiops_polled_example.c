@@ -5,6 +5,12 @@
 #include "xstatus.h"
 #include "xplatform_info.h"
 #include <xil_printf.h>
+#include "xil_startup.h"
+#ifndef SDT
+#include "xtime_l.h"
+#else
+#include "xiltimer.h"
+#endif
 
 /************************** Constant Definitions ****************************/
 
@@ -70,6 +76,27 @@ int main(void)
 	u32 InputData; // 用于示例中的输入部分
 
 	printf("GPIO轮询模式示例 (已修改为MIO0和MIO13 LED交替闪烁)\r\n");
+	{
+		/*
+		 * 打印从 _start 到 main 的启动时间。XIL_STARTUP_TIMES 是 BSP 的
+		 * 编译选项, 在这里不可见, BSP 未采样时各阶段读回 0。
+		 */
+		Xil_StartupTimes Times;
+		u32 CountsPerUs = (u32)(COUNTS_PER_SECOND / 1000000U);
+
+		Xil_StartupGetTimes(&Times);
+		if (Times.TotalCounts == 0U) {
+			printf("Startup times not sampled, build the BSP with "
+			       "XIL_STARTUP_TIMES\r\n");
+		} else {
+			printf("Time to main %lu us: cpu init %lu us, bss %lu us, "
+			       "constructors %lu us\r\n",
+			       (unsigned long)(Times.TotalCounts / CountsPerUs),
+			       (unsigned long)(Times.CpuInitCounts / CountsPerUs),
+			       (unsigned long)(Times.BssCounts / CountsPerUs),
+			       (unsigned long)(Times.CtorCounts / CountsPerUs));
+		}
+	}
 #ifndef SDT
 	Status = GpioPolledExample(GPIO_DEVICE_ID, &InputData);
 #else